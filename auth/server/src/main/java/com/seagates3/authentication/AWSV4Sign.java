@@ -103,9 +103,8 @@ public class AWSV4Sign implements AWSSign {
         LOGGER.debug("Request signature- " + clientRequestToken.getSignature());
         LOGGER.debug("Calculated signature- " + signature);
 
-        return (signature != null)
-                   ? signature.equals(clientRequestToken.getSignature())
-                   : false;
+        return verifyAndShareSigningKey(clientRequestToken, signature,
+                                        signingKey);
     }
 
     /**
@@ -137,9 +136,8 @@ public class AWSV4Sign implements AWSSign {
         LOGGER.debug("Request signature- " + clientRequestToken.getSignature());
         LOGGER.debug("Calculated signature- " + signature);
 
-        return (signature != null)
-                   ? signature.equals(clientRequestToken.getSignature())
-                   : false;
+        return verifyAndShareSigningKey(clientRequestToken, signature,
+                                        signingKey);
     }
 
     /**
@@ -172,6 +170,27 @@ public class AWSV4Sign implements AWSSign {
         return (signature != null) ? signature.equals(currentSign) : false;
     }
 
+    /**
+     * Compare calculated signature with the request one. On match hand out
+     * the signing key if s3server asked for it on its trusted channel, so
+     * that s3server verifies further requests of the same credential scope
+     * itself. Request headers are set by the S3 client and are never used
+     * to decide this.
+     */
+    private Boolean verifyAndShareSigningKey(
+            ClientRequestToken clientRequestToken, String signature,
+            byte[] signingKey) {
+        if (signature == null
+                || !signature.equals(clientRequestToken.getSignature())) {
+            return false;
+        }
+
+        if (signingKey != null && clientRequestToken.isSigningKeyRequested()) {
+            clientRequestToken.setSigningKey(BinaryUtil.toHex(signingKey));
+        }
+        return true;
+    }
+
     /**
      * Canonical Request is in the following format.
      *
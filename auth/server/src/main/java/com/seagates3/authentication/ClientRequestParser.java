@@ -20,6 +20,7 @@
 
 package com.seagates3.authentication;
 
+import com.seagates3.authserver.AuthServerConfig;
 import com.seagates3.exception.InvalidTokenException;
 import com.seagates3.exception.InvalidArgumentException;
 import com.seagates3.util.IEMUtil;
@@ -28,6 +29,8 @@ import com.seagates3.response.ServerResponse;
 import com.seagates3.response.generator.ResponseGenerator;
 import com.seagates3.exception.InvalidAccessKeyException;
 
+import java.nio.charset.StandardCharsets;
+import java.security.MessageDigest;
 import java.util.Map;
 import org.slf4j.Logger;
 import java.util.regex.Pattern;
@@ -49,6 +52,11 @@ public class ClientRequestParser {
     private static final Pattern ACCESS_KEY_PATTERN  = Pattern.compile("[\\w-]+");
     private static final Pattern V2_PATTERN = Pattern.compile("^AWS ");
     private static final Pattern V4_PATTERN = Pattern.compile("^AWS4-HMAC-SHA256");
+    private static final String SIGNING_KEY_SECRET_HEADER
+            = "X-S3Server-Signing-Key-Secret";
+    private static final Pattern QUERY_AUTH_PATTERN = Pattern.compile(
+            "(^|&)(X-Amz-Signature|X-Amz-Credential|Signature|AWSAccessKeyId)=",
+            Pattern.CASE_INSENSITIVE);
 
 
 
@@ -129,6 +137,12 @@ public class ClientRequestParser {
             catch (InvalidTokenException ex) {
                 LOGGER.error("Error while parsing request : "+ ex.getMessage());
             }
+            if (clientrequesttoken != null &&
+                requestAction.equals("AuthenticateUser") &&
+                awsSigningVersion == ClientRequestToken.AWSSigningVersion.V4) {
+              clientrequesttoken.setSigningKeyRequested(
+                  isSigningKeyRequestTrusted(httpRequest, requestBody));
+            }
         } else {
 
             try {
@@ -142,6 +156,41 @@ public class ClientRequestParser {
         return clientrequesttoken;
     }
 
+    /**
+     * s3server asks for the signing key of the request it authenticates by
+     * sending the secret it shares with the auth server in a header of its
+     * own request. Headers of the S3 client are forwarded in the request
+     * body, so the client can't set it. Keys of query string (presigned)
+     * signatures are never handed out, such signatures are given to third
+     * parties.
+     */
+    static boolean isSigningKeyRequestTrusted(FullHttpRequest httpRequest,
+            Map<String, String> requestBody) {
+        String secret = AuthServerConfig.getS3ServerSigningKeySecret();
+        if (secret == null || secret.isEmpty()) {
+            return false;
+        }
+
+        String queryParams = requestBody.get("ClientQueryParams");
+        if (queryParams != null
+                && QUERY_AUTH_PATTERN.matcher(queryParams).find()) {
+            return false;
+        }
+
+        String requestSecret
+                = httpRequest.headers().get(SIGNING_KEY_SECRET_HEADER);
+        if (requestSecret == null) {
+            return false;
+        }
+        if (!MessageDigest.isEqual(
+                 secret.getBytes(StandardCharsets.UTF_8),
+                 requestSecret.getBytes(StandardCharsets.UTF_8))) {
+            LOGGER.warn("Signing key requested with wrong s3server secret");
+            return false;
+        }
+        return true;
+    }
+
     private static AWSRequestParser getAWSRequestParser(
             ClientRequestToken.AWSSigningVersion awsSigningVersion) {
 
@@ -117,6 +117,18 @@ public class ClientRequestToken {
      */
     String bucketName;
 
+    /*
+     * True if s3server asked for the signing key of this request on its
+     * trusted channel, see ClientRequestParser.
+     */
+    boolean signingKeyRequested;
+
+    /*
+     * Hex encoded AWS V4 signing key, set after successful authentication
+     * if it was requested.
+     */
+    String signingKey;
+
     /*
      * Return the Access Key Id of the requestor.
      */
@@ -349,4 +361,20 @@ public class ClientRequestToken {
     public void setBucketName(String bucketName) {
         this.bucketName = bucketName;
     }
+
+    public boolean isSigningKeyRequested() {
+        return signingKeyRequested;
+    }
+
+    public void setSigningKeyRequested(boolean signingKeyRequested) {
+        this.signingKeyRequested = signingKeyRequested;
+    }
+
+    public String getSigningKey() {
+        return signingKey;
+    }
+
+    public void setSigningKey(String signingKey) {
+        this.signingKey = signingKey;
+    }
 }
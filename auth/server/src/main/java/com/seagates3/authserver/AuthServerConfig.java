@@ -373,6 +373,16 @@ public class AuthServerConfig {
        return Boolean.valueOf(authServerConfig.getProperty("enableHttpsToS3"));
     }
 
+    /**
+     * Secret s3server sends to be given SigV4 signing keys, empty if signing
+     * keys are not handed out.
+     */
+    public static String getS3ServerSigningKeySecret() {
+        String secret =
+            authServerConfig.getProperty("s3ServerSigningKeySecret");
+        return (secret != null) ? secret : "";
+    }
+
     /**
      * Set Request ID
      */
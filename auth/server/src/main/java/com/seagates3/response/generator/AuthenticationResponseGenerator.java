@@ -41,6 +41,12 @@ public class AuthenticationResponseGenerator extends AbstractResponseGenerator {
         responseElements.put("CanonicalId",
                              requestor.getAccount().getCanonicalId());
         responseElements.put("Email", requestor.getAccount().getEmail());
+        // Only s3server which proved itself gets the key, see
+        // ClientRequestParser
+        if (requestToken.isSigningKeyRequested() &&
+            requestToken.getSigningKey() != null) {
+          responseElements.put("SigningKey", requestToken.getSigningKey());
+        }
 
         return (ServerResponse) new AuthenticationResponseFormatter()
             .formatAuthenticatedResponse(responseElements,
@@ -21,8 +21,10 @@
 package com.seagates3.authentication;
 
 import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
 import static org.junit.Assert.assertNotNull;
 import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
 import static org.mockito.Mockito.mock;
 import static org.powermock.api.mockito.PowerMockito.mockStatic;
 import static org.powermock.api.mockito.PowerMockito.when;
@@ -50,7 +52,9 @@ import com.seagates3.response.ServerResponse;
 import com.seagates3.response.generator.ResponseGenerator;
 
 import io.netty.handler.codec.http.DefaultFullHttpRequest;
+import io.netty.handler.codec.http.DefaultHttpHeaders;
 import io.netty.handler.codec.http.FullHttpRequest;
+import io.netty.handler.codec.http.HttpHeaders;
 import io.netty.handler.codec.http.HttpMethod;
 import io.netty.handler.codec.http.HttpResponseStatus;
 import io.netty.handler.codec.http.HttpVersion;
@@ -181,4 +185,65 @@ import io.netty.handler.codec.http.HttpVersion;
 
         assertNull(ClientRequestParser.parse(httpRequest, requestBody));
     }
+
+    private ClientRequestToken parseWithSigningKeySecret(String secret)
+            throws InvalidAccessKeyException, InvalidArgumentException {
+        when(AuthServerConfig.getS3ServerSigningKeySecret())
+            .thenReturn("s3secret");
+        HttpHeaders headers = new DefaultHttpHeaders();
+        if (secret != null) {
+            headers.add("X-S3Server-Signing-Key-Secret", secret);
+        }
+        when(httpRequest.headers()).thenReturn(headers);
+
+        ClientRequestToken token
+                = ClientRequestParser.parse(httpRequest, requestBody);
+        assertNotNull(token);
+        return token;
+    }
+
+    @Test
+    public void parseTest_SigningKeyRequestedWithSecret() throws Exception {
+        requestBody = AWSV4RequestHelper.getRequestHeadersVirtualHostStyle();
+
+        assertTrue(parseWithSigningKeySecret("s3secret")
+                       .isSigningKeyRequested());
+    }
+
+    @Test
+    public void parseTest_SigningKeyNotRequestedWithoutSecret()
+            throws Exception {
+        requestBody = AWSV4RequestHelper.getRequestHeadersVirtualHostStyle();
+        // S3 client headers are forwarded in the body and are not trusted
+        requestBody.put("X-S3Server-Signing-Key-Secret", "s3secret");
+        requestBody.put("Request-Signing-Key", "true");
+
+        assertFalse(parseWithSigningKeySecret(null).isSigningKeyRequested());
+        assertFalse(parseWithSigningKeySecret("wrong").isSigningKeyRequested());
+    }
+
+    @Test
+    public void parseTest_SigningKeyNotRequestedIfSecretNotConfigured()
+            throws Exception {
+        requestBody = AWSV4RequestHelper.getRequestHeadersVirtualHostStyle();
+        when(AuthServerConfig.getS3ServerSigningKeySecret()).thenReturn("");
+        HttpHeaders headers = new DefaultHttpHeaders();
+        headers.add("X-S3Server-Signing-Key-Secret", "");
+        when(httpRequest.headers()).thenReturn(headers);
+
+        ClientRequestToken token
+                = ClientRequestParser.parse(httpRequest, requestBody);
+        assertFalse(token.isSigningKeyRequested());
+    }
+
+    @Test
+    public void parseTest_SigningKeyNotRequestedForQueryAuth()
+            throws Exception {
+        requestBody = AWSV4RequestHelper.getRequestHeadersVirtualHostStyle();
+        requestBody.put("ClientQueryParams",
+                        "delimiter=/&X-Amz-Signature=b0024ea6f4b7ea025c890e");
+
+        assertFalse(parseWithSigningKeySecret("s3secret")
+                        .isSigningKeyRequested());
+    }
 }
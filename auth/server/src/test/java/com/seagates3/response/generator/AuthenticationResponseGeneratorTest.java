@@ -68,5 +68,59 @@ public class AuthenticationResponseGeneratorTest {
         Assert.assertEquals(expectedResponseBody, response.getResponseBody());
         Assert.assertEquals(HttpResponseStatus.OK, response.getResponseStatus());
     }
+
+    @Test
+    public void testCreateResponseWithSigningKey() {
+        ClientRequestToken requestToken = new ClientRequestToken();
+        requestToken.setSignature("testsign");
+        requestToken.setSigningKeyRequested(true);
+        requestToken.setSigningKey("0a1b2c");
+
+        Account account = new Account();
+        account.setId("12345");
+        account.setName("s3test");
+        account.setCanonicalId("dsfhgsjhsdgfQW23cdjbjb");
+        account.setEmail("abc@sjsj.com");
+
+        Requestor requestor = new Requestor();
+        requestor.setId("123");
+        requestor.setName("s3test");
+        requestor.setAccount(account);
+
+        AuthenticationResponseGenerator responseGenerator
+                = new AuthenticationResponseGenerator();
+        ServerResponse response = responseGenerator.
+                generateAuthenticatedResponse(requestor, requestToken);
+
+        Assert.assertTrue(response.getResponseBody().contains(
+            "<Email>abc@sjsj.com</Email><SigningKey>0a1b2c</SigningKey>"));
+        Assert.assertEquals(HttpResponseStatus.OK, response.getResponseStatus());
+    }
+
+    @Test
+    public void testCreateResponseWithUnrequestedSigningKey() {
+        ClientRequestToken requestToken = new ClientRequestToken();
+        requestToken.setSignature("testsign");
+        requestToken.setSigningKey("0a1b2c");
+
+        Account account = new Account();
+        account.setId("12345");
+        account.setName("s3test");
+        account.setCanonicalId("dsfhgsjhsdgfQW23cdjbjb");
+        account.setEmail("abc@sjsj.com");
+
+        Requestor requestor = new Requestor();
+        requestor.setId("123");
+        requestor.setName("s3test");
+        requestor.setAccount(account);
+
+        AuthenticationResponseGenerator responseGenerator
+                = new AuthenticationResponseGenerator();
+        ServerResponse response = responseGenerator.
+                generateAuthenticatedResponse(requestor, requestToken);
+
+        Assert.assertFalse(response.getResponseBody().contains("SigningKey"));
+        Assert.assertEquals(HttpResponseStatus.OK, response.getResponseStatus());
+    }
 }
 
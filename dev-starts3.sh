@@ -20,7 +20,7 @@
 
 # Script to start S3 server in dev environment.
 #   Usage: sudo ./dev-starts3.sh [<Number of S3 sever instances>]
-#                                [--fake_obj] [--fake_kvs | --redis_kvs]
+#                                [--fake_obj | --fake_obj_store] [--fake_kvs | --redis_kvs]
 #                                [--callgraph /path/to/graph | --valgrind_memcheck [/path/to/memcheck/log]]
 #               Optional argument is:
 #                   Number of S3 server instances to start.
@@ -53,6 +53,7 @@ set -e
 
 num_instances=1
 fake_obj=0
+fake_obj_store=0
 fake_kvs=0
 redis_kvs=0
 
@@ -73,6 +74,10 @@ while [ "$1" != "" ]; do
         --fake_obj ) fake_obj=1;
                      echo "Stubs for motr object read/write ops";
                      ;;
+        --fake_obj_store ) fake_obj=1;
+                           fake_obj_store=1;
+                           echo "In-memory store for motr object ops";
+                           ;;
         --fake_kvs ) fake_kvs=1;
                      echo "Stubs for motr kvs put/get/delete/create idx/remove idx";
                      ;;
@@ -184,6 +189,9 @@ counter=0
 # --fake_motr_getkv - stub for motr get key-value - read from memory hash map
 # --fake_motr_putkv - stub for motr put kye-value - stores in memory hash map
 # --fake_motr_deletekv - stub for motr delete key-value - deletes from memory hash map
+# --fake_motr_obj_store - keep data of faked object ops in memory, so it reads back
+# --fake_motr_obj_store_dir - same, in files of the given directory
+# --fake_motr_latency_us - delay completion of faked ops
 # for proper KV mocking one should use following combination
 #    --fake_motr_createidx true --fake_motr_deleteidx true --fake_motr_getkv true --fake_motr_putkv true --fake_motr_deletekv true
 
@@ -203,6 +211,11 @@ then
     fake_params+=" --fake_motr_writeobj true --fake_motr_readobj true --fake_motr_openobj true --fake_motr_createobj true --fake_motr_deleteobj true"
 fi
 
+if [ $fake_obj_store -eq 1 ]
+then
+    fake_params+=" --fake_motr_obj_store true"
+fi
+
 valgrind_cmd=""
 if [ $callgraph_mode -eq 1 ]
 then
@@ -18,17 +18,50 @@
  *
  */
 
+#include <limits.h>
 #include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/mman.h>
+#include <unistd.h>
 
 #include "s3_memory_pool.h"
 
+/* Per thread cache holds at most THREAD_CACHE_MAX_BYTES, but not more than
+   THREAD_CACHE_MAX_ITEMS; if less than THREAD_CACHE_MIN_ITEMS fit, the pool
+   doesn't use thread caches. */
+#define THREAD_CACHE_MAX_BYTES (1024 * 1024)
+#define THREAD_CACHE_MAX_ITEMS 64
+#define THREAD_CACHE_MIN_ITEMS 4
+
+/* Size of transparent hugepages. Items of USE_HUGEPAGES pools are carved
+   from slabs of multiple of this size, aligned to it so that they can be
+   backed by hugepages. */
+#define THP_SIZE (2 * 1024 * 1024)
+/* Used when default hugepage size can't be read from /proc/meminfo */
+#define DEFAULT_HUGEPAGE_SIZE (2 * 1024 * 1024)
+
 struct memory_pool_element {
   struct memory_pool_element *next;
 };
 
+/* Hugepage backed memory of USE_HUGEPAGES pool, carved into items */
+struct hugepage_slab {
+  char *addr;
+  int items_carved; /* Items put to the pool so far, from the start */
+  struct hugepage_slab *next;
+};
+
+struct mempool;
+
+struct thread_cache {
+  struct mempool *pool;
+  struct memory_pool_element *free_list; /* Accessed by owner thread only */
+  int free_bufs; /* Written by owner thread only, read by mempool_getinfo */
+  struct thread_cache *next; /* List of caches of the pool, under pool lock */
+};
+
 struct mempool {
   int flags;                 /* Buffer Bitflags */
   int free_bufs_in_pool;     /* Number of items on free list */
@@ -58,8 +91,298 @@ struct mempool {
   pthread_mutex_t lock;     /* lock, in case of synchronous operation */
   struct memory_pool_element *free_list; /* list of free items available for
                                             reuse */
+  int thread_cache_size; /* Max items in a thread cache, 0 if not used */
+  pthread_key_t thread_cache_key;
+  struct thread_cache *thread_caches; /* Caches of all threads */
+  /* USE_HUGEPAGES only */
+  size_t slot_size;   /* Item size rounded up to page size */
+  size_t slab_size;   /* Length of slabs, 0 if items are not carved from them */
+  int items_per_slab;
+  struct hugepage_slab *slabs; /* Only the first one can be partially carved */
+  int try_hugetlb; /* Slab size is a multiple of hugepage size, cleared once
+                      MAP_HUGETLB fails */
 };
 
+/**
+ * Returns the default hugepage size of the system, the one MAP_HUGETLB
+ * uses.
+ */
+static size_t get_default_hugepage_size(void) {
+  static size_t hugepage_size = 0;
+  char line[128];
+  size_t size_kb;
+  FILE *fp;
+
+  if (hugepage_size != 0) {
+    return hugepage_size;
+  }
+  size_kb = 0;
+  fp = fopen("/proc/meminfo", "r");
+  if (fp != NULL) {
+    while (fgets(line, sizeof(line), fp) != NULL) {
+      if (sscanf(line, "Hugepagesize: %zu kB", &size_kb) == 1) {
+        break;
+      }
+    }
+    fclose(fp);
+  }
+  hugepage_size = size_kb != 0 ? size_kb * 1024 : DEFAULT_HUGEPAGE_SIZE;
+  return hugepage_size;
+}
+
+/**
+ * mmap's 'length' bytes aligned to 'align', trimming the excess of a larger
+ * mapping.
+ */
+static void *mmap_aligned(size_t length, size_t align) {
+  char *addr;
+  size_t head;
+
+  addr = (char *)mmap(NULL, length + align, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (addr == MAP_FAILED) {
+    return NULL;
+  }
+  head = (align - (uintptr_t)addr % align) % align;
+  if (head > 0) {
+    munmap(addr, head);
+  }
+  munmap(addr + head + length, align - head);
+  return addr + head;
+}
+
+/**
+ * mmap's a new slab of USE_HUGEPAGES pool, returns NULL on failure.
+ */
+static struct hugepage_slab *hugepage_slab_allocate(struct mempool *pool) {
+  struct hugepage_slab *slab;
+  void *addr = NULL;
+  char log_msg[200];
+
+  slab = (struct hugepage_slab *)calloc(1, sizeof(struct hugepage_slab));
+  if (slab == NULL) {
+    return NULL;
+  }
+  if (pool->try_hugetlb) {
+    addr = mmap(NULL, pool->slab_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (addr == MAP_FAILED) {
+      addr = NULL;
+      /* Hugepages are not reserved or are used up, don't retry every time */
+      pool->try_hugetlb = 0;
+      if (pool->log_callback_func) {
+        snprintf(log_msg, sizeof(log_msg),
+                 "mempool(%p): MAP_HUGETLB failed for size(%zu), falling back "
+                 "to transparent hugepages",
+                 (void *)pool, pool->slab_size);
+        pool->log_callback_func(MEMPOOL_LOG_INFO, log_msg);
+      }
+    }
+  }
+  if (addr == NULL) {
+    addr = mmap_aligned(pool->slab_size, THP_SIZE);
+    if (addr == NULL) {
+      free(slab);
+      return NULL;
+    }
+    madvise(addr, pool->slab_size, MADV_HUGEPAGE);
+  }
+  /* Whole slab at once, madvise() of single items would split the mapping
+     and so its hugepages */
+  madvise(addr, pool->slab_size, MADV_DONTDUMP);
+
+  slab->addr = (char *)addr;
+  slab->next = pool->slabs;
+  pool->slabs = slab;
+  return slab;
+}
+
+/**
+ * Carves an item of USE_HUGEPAGES pool from its current slab, maps a new slab
+ * when it's used up. Returns NULL on failure.
+ */
+static void *hugepage_item_allocate(struct mempool *pool) {
+  struct hugepage_slab *slab = pool->slabs;
+
+  if (slab == NULL || slab->items_carved == pool->items_per_slab) {
+    slab = hugepage_slab_allocate(pool);
+    if (slab == NULL) {
+      return NULL;
+    }
+  }
+  return slab->addr + pool->slot_size * slab->items_carved++;
+}
+
+/**
+ * Unmaps slabs of USE_HUGEPAGES pool whose items are all on the free list,
+ * until at least 'bufs_to_free' items are freed. Returns the number of freed
+ * items. Called under pool lock.
+ */
+static int hugepage_slabs_free(struct mempool *pool, int bufs_to_free) {
+  struct hugepage_slab **p_slab = &pool->slabs;
+  struct memory_pool_element **p_item;
+  int freed_bufs = 0;
+
+  while (*p_slab != NULL && freed_bufs < bufs_to_free) {
+    struct hugepage_slab *slab = *p_slab;
+    const char *slab_end = slab->addr + pool->slot_size * slab->items_carved;
+    int free_bufs = 0;
+
+    for (p_item = &pool->free_list; *p_item != NULL;
+         p_item = &(*p_item)->next) {
+      if ((char *)*p_item >= slab->addr && (char *)*p_item < slab_end) {
+        free_bufs++;
+      }
+    }
+    if (free_bufs < slab->items_carved) {
+      /* Some items are in use */
+      p_slab = &slab->next;
+      continue;
+    }
+    p_item = &pool->free_list;
+    while (*p_item != NULL) {
+      if ((char *)*p_item >= slab->addr && (char *)*p_item < slab_end) {
+        *p_item = (*p_item)->next;
+      } else {
+        p_item = &(*p_item)->next;
+      }
+    }
+    pool->free_bufs_in_pool -= free_bufs;
+    pool->total_bufs_allocated_by_pool -= free_bufs;
+    freed_bufs += free_bufs;
+
+    *p_slab = slab->next;
+    munmap(slab->addr, pool->slab_size);
+    free(slab);
+  }
+  return freed_bufs;
+}
+
+/**
+ * Writes to every page of the item, so that it is faulted in by the calling
+ * thread, and placed on its NUMA node by the first touch policy.
+ */
+static void item_prefault(struct mempool *pool, void *buf) {
+  const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+  volatile char *p = (volatile char *)buf;
+  size_t offset;
+
+  for (offset = 0; offset < pool->mempool_item_size; offset += page_size) {
+    p[offset] = 0;
+  }
+}
+
+/**
+ * Moves items from thread cache to pool's free list, so that 'bufs_to_keep'
+ * items are left in the cache. Called under pool lock.
+ */
+static void thread_cache_flush(struct mempool *pool,
+                               struct thread_cache *cache, int bufs_to_keep) {
+  struct memory_pool_element *pool_item;
+  int free_bufs = cache->free_bufs;
+
+  while (free_bufs > bufs_to_keep) {
+    pool_item = cache->free_list;
+    cache->free_list = pool_item->next;
+    pool_item->next = pool->free_list;
+    pool->free_list = pool_item;
+    free_bufs--;
+
+    pool->free_bufs_in_pool++;
+    pool->number_of_bufs_shared--;
+  }
+  __atomic_store_n(&cache->free_bufs, free_bufs, __ATOMIC_RELAXED);
+}
+
+/**
+ * Moves items from pool's free list to thread cache, until it has
+ * 'bufs_to_have' items or the free list is empty. Called under pool lock.
+ */
+static void thread_cache_refill(struct mempool *pool,
+                                struct thread_cache *cache, int bufs_to_have) {
+  struct memory_pool_element *pool_item;
+  int free_bufs = cache->free_bufs;
+
+  while (free_bufs < bufs_to_have && pool->free_list != NULL) {
+    pool_item = pool->free_list;
+    pool->free_list = pool_item->next;
+    pool_item->next = cache->free_list;
+    cache->free_list = pool_item;
+    free_bufs++;
+
+    pool->free_bufs_in_pool--;
+    pool->number_of_bufs_shared++;
+  }
+  __atomic_store_n(&cache->free_bufs, free_bufs, __ATOMIC_RELAXED);
+}
+
+/**
+ * Returns items of exiting thread to the pool.
+ */
+static void thread_cache_destructor(void *arg) {
+  struct thread_cache *cache = (struct thread_cache *)arg;
+  struct mempool *pool = cache->pool;
+  struct thread_cache **p_cache;
+
+  pthread_mutex_lock(&pool->lock);
+
+  thread_cache_flush(pool, cache, 0);
+
+  for (p_cache = &pool->thread_caches; *p_cache != NULL;
+       p_cache = &(*p_cache)->next) {
+    if (*p_cache == cache) {
+      *p_cache = cache->next;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+  free(cache);
+}
+
+/**
+ * Returns the cache of calling thread, creates it on first use.
+ * NULL if the pool doesn't use thread caches.
+ */
+static struct thread_cache *get_thread_cache(struct mempool *pool) {
+  struct thread_cache *cache;
+
+  if (pool->thread_cache_size == 0) {
+    return NULL;
+  }
+  cache = (struct thread_cache *)pthread_getspecific(pool->thread_cache_key);
+
+  if (cache == NULL) {
+    cache = (struct thread_cache *)calloc(1, sizeof(struct thread_cache));
+    if (cache == NULL) {
+      return NULL;
+    }
+    cache->pool = pool;
+
+    if (pthread_setspecific(pool->thread_cache_key, cache) != 0) {
+      free(cache);
+      return NULL;
+    }
+    pthread_mutex_lock(&pool->lock);
+    cache->next = pool->thread_caches;
+    pool->thread_caches = cache;
+    pthread_mutex_unlock(&pool->lock);
+  }
+  return cache;
+}
+
+/**
+ * Number of free items in all thread caches. Called under pool lock.
+ */
+static int thread_caches_free_bufs(struct mempool *pool) {
+  struct thread_cache *cache;
+  int free_bufs = 0;
+
+  for (cache = pool->thread_caches; cache != NULL; cache = cache->next) {
+    free_bufs += __atomic_load_n(&cache->free_bufs, __ATOMIC_RELAXED);
+  }
+  return free_bufs;
+}
+
 /**
  * Return the number of buffers we can allocate w.r.t max threshold and
  * available memory space.
@@ -110,7 +433,9 @@ int freelist_allocate(struct mempool *pool, int items_count_to_allocate) {
   }
 
   for (i = 0; i < items_count_to_allocate; i++) {
-    if (pool->flags & CREATE_ALIGNED_MEMORY) {
+    if (pool->flags & USE_HUGEPAGES) {
+      buf = hugepage_item_allocate(pool);
+    } else if (pool->flags & CREATE_ALIGNED_MEMORY) {
       buf = NULL;
       rc = posix_memalign((void **)&buf, pool->alignment,
                           pool->mempool_item_size);
@@ -118,7 +443,11 @@ int freelist_allocate(struct mempool *pool, int items_count_to_allocate) {
       buf = malloc(pool->mempool_item_size);
     }
     if (pool->log_callback_func) {
-      if (pool->flags & CREATE_ALIGNED_MEMORY) {
+      if (pool->flags & USE_HUGEPAGES) {
+        snprintf(log_msg, sizeof(log_msg), log_msg_fmt, (void *)pool,
+                 "hugepage slab", pool->slab_size, buf, rc, pool->alignment,
+                 pool->mempool_item_size);
+      } else if (pool->flags & CREATE_ALIGNED_MEMORY) {
         snprintf(log_msg, sizeof(log_msg), log_msg_fmt, (void *)pool,
                  "posix_memalign", pool->mempool_item_size, buf, rc,
                  pool->alignment, pool->mempool_item_size);
@@ -134,10 +463,14 @@ int freelist_allocate(struct mempool *pool, int items_count_to_allocate) {
     }
 
     /* exclude this buffer while geneating core dump*/
-    madvise(buf, pool->mempool_item_size, MADV_DONTDUMP);
+    if ((pool->flags & USE_HUGEPAGES) == 0) {
+      madvise(buf, pool->mempool_item_size, MADV_DONTDUMP);
+    }
 
     if ((pool->flags & ZEROED_BUFFER) != 0) {
       memset(buf, 0, pool->mempool_item_size);
+    } else if ((pool->flags & PREFAULT_MEMORY) != 0) {
+      item_prefault(pool, buf);
     }
 
     pool->total_bufs_allocated_by_pool++;
@@ -188,6 +521,17 @@ int mempool_create(size_t pool_item_size, size_t pool_initial_size,
   if (flags & CREATE_ALIGNED_MEMORY) {
     pool->alignment = MEMORY_ALIGNMENT;
   }
+  if (flags & USE_HUGEPAGES) {
+    /* Items are carved from slabs at page aligned offsets */
+    pool->alignment = (size_t)sysconf(_SC_PAGESIZE);
+    pool->slot_size = (pool_item_size + pool->alignment - 1) /
+                      pool->alignment * pool->alignment;
+    pool->slab_size =
+        (pool->slot_size + THP_SIZE - 1) / THP_SIZE * THP_SIZE;
+    pool->items_per_slab = pool->slab_size / pool->slot_size;
+    pool->try_hugetlb =
+        (pool->slab_size % get_default_hugepage_size()) == 0 ? 1 : 0;
+  }
 
   if ((pool->flags & ENABLE_LOCKING) != 0) {
     rc = pthread_mutex_init(&pool->lock, NULL);
@@ -195,6 +539,17 @@ int mempool_create(size_t pool_item_size, size_t pool_initial_size,
       free(pool);
       return S3_MEMPOOL_ERROR;
     }
+    if ((pool->flags & ENABLE_THREAD_CACHE) != 0) {
+      pool->thread_cache_size = THREAD_CACHE_MAX_BYTES / pool_item_size;
+      if (pool->thread_cache_size > THREAD_CACHE_MAX_ITEMS) {
+        pool->thread_cache_size = THREAD_CACHE_MAX_ITEMS;
+      }
+      if (pool->thread_cache_size < THREAD_CACHE_MIN_ITEMS ||
+          pthread_key_create(&pool->thread_cache_key,
+                             thread_cache_destructor) != 0) {
+        pool->thread_cache_size = 0;
+      }
+    }
   }
 
   *handle = (MemoryPoolHandle)pool;
@@ -259,12 +614,55 @@ int mempool_create_with_shared_mem(
   return 0;
 }
 
+int mempool_reserve_for_thread(MemoryPoolHandle handle,
+                               size_t mem_to_reserve) {
+  int rc = 0;
+  int bufs_to_allocate;
+  int bufs_that_can_be_allocated;
+  struct mempool *pool = (struct mempool *)handle;
+  struct thread_cache *cache = NULL;
+
+  if (pool == NULL || (mem_to_reserve % pool->mempool_item_size > 0)) {
+    return S3_MEMPOOL_INVALID_ARG;
+  }
+
+  cache = get_thread_cache(pool);
+
+  if ((pool->flags & ENABLE_LOCKING) != 0) {
+    pthread_mutex_lock(&pool->lock);
+  }
+
+  bufs_to_allocate = mem_to_reserve / pool->mempool_item_size;
+  bufs_that_can_be_allocated = pool_can_expand_by(pool);
+  if (bufs_to_allocate > bufs_that_can_be_allocated) {
+    bufs_to_allocate = bufs_that_can_be_allocated;
+    rc = S3_MEMPOOL_THRESHOLD_EXCEEDED;
+  }
+  if (bufs_to_allocate > 0) {
+    if (freelist_allocate(pool, bufs_to_allocate) != 0) {
+      rc = S3_MEMPOOL_ERROR;
+    } else if (cache != NULL) {
+      /* New items are on top of the free list */
+      thread_cache_refill(pool, cache,
+                          bufs_to_allocate < pool->thread_cache_size
+                              ? bufs_to_allocate
+                              : pool->thread_cache_size);
+    }
+  }
+
+  if ((pool->flags & ENABLE_LOCKING) != 0) {
+    pthread_mutex_unlock(&pool->lock);
+  }
+  return rc;
+}
+
 void *mempool_getbuffer(MemoryPoolHandle handle, size_t expected_buffer_size) {
   int rc;
   int bufs_to_allocate;
   int bufs_that_can_be_allocated = 0;
   struct memory_pool_element *pool_item = NULL;
   struct mempool *pool = (struct mempool *)handle;
+  struct thread_cache *cache = NULL;
   char *log_msg_fmt =
       "mempool(%p): mempool_getbuffer called for invalid "
       "expected_buffer_size(%zu), current pool manages only "
@@ -285,6 +683,17 @@ void *mempool_getbuffer(MemoryPoolHandle handle, size_t expected_buffer_size) {
     }
   }
 
+  cache = get_thread_cache(pool);
+
+  if (cache != NULL && cache->free_list != NULL) {
+    pool_item = cache->free_list;
+    cache->free_list = pool_item->next;
+    pool_item->next = (struct memory_pool_element *)NULL;
+    __atomic_store_n(&cache->free_bufs, cache->free_bufs - 1,
+                     __ATOMIC_RELAXED);
+    return (void *)pool_item;
+  }
+
   if ((pool->flags & ENABLE_LOCKING) != 0) {
     pthread_mutex_lock(&pool->lock);
   }
@@ -331,6 +740,11 @@ void *mempool_getbuffer(MemoryPoolHandle handle, size_t expected_buffer_size) {
     pool->number_of_bufs_shared++;
   }
 
+  /* Refill the thread cache up to half of its size */
+  if (pool_item && cache != NULL) {
+    thread_cache_refill(pool, cache, pool->thread_cache_size / 2);
+  }
+
   if (pool->log_callback_func) {
     char log_mem_stats[1024];
     char *log_memool_stats =
@@ -356,6 +770,7 @@ int mempool_releasebuffer(MemoryPoolHandle handle, void *buf,
                           size_t released_buffer_size) {
   struct mempool *pool = (struct mempool *)handle;
   struct memory_pool_element *pool_item = (struct memory_pool_element *)buf;
+  struct thread_cache *cache = NULL;
   char *log_msg_fmt =
       "mempool(%p): mempool_releasebuffer called for invalid "
       "released_buffer_size(%zu), current pool manages only "
@@ -376,23 +791,41 @@ int mempool_releasebuffer(MemoryPoolHandle handle, void *buf,
     }
   }
 
-  if ((pool->flags & ENABLE_LOCKING) != 0) {
-    pthread_mutex_lock(&pool->lock);
-  }
-
   /* Clean up the buffer so that we get it 'clean' when we allocate it next
    * time*/
   if ((pool->flags & ZEROED_BUFFER) != 0) {
     memset(pool_item, 0, pool->mempool_item_size);
   }
 
-  // Add the buffer back to pool
-  pool_item->next = pool->free_list;
-  pool->free_list = pool_item;
-  pool->free_bufs_in_pool++;
-  pool_item = NULL;
+  cache = get_thread_cache(pool);
+
+  if (cache != NULL) {
+    pool_item->next = cache->free_list;
+    cache->free_list = pool_item;
+    __atomic_store_n(&cache->free_bufs, cache->free_bufs + 1,
+                     __ATOMIC_RELAXED);
+
+    if (cache->free_bufs <= pool->thread_cache_size) {
+      return 0;
+    }
+  }
+
+  if ((pool->flags & ENABLE_LOCKING) != 0) {
+    pthread_mutex_lock(&pool->lock);
+  }
+
+  if (cache != NULL) {
+    /* Overfull, give half of the cache back to pool */
+    thread_cache_flush(pool, cache, pool->thread_cache_size / 2);
+  } else {
+    // Add the buffer back to pool
+    pool_item->next = pool->free_list;
+    pool->free_list = pool_item;
+    pool->free_bufs_in_pool++;
 
-  pool->number_of_bufs_shared--;
+    pool->number_of_bufs_shared--;
+  }
+  pool_item = NULL;
 
   if (pool->log_callback_func) {
     char log_mem_stats[1024];
@@ -425,9 +858,12 @@ int mempool_getinfo(MemoryPoolHandle handle, struct pool_info *poolinfo) {
     pthread_mutex_lock(&pool->lock);
   }
 
+  poolinfo->free_bufs_in_thread_caches = thread_caches_free_bufs(pool);
   poolinfo->mempool_item_size = pool->mempool_item_size;
-  poolinfo->free_bufs_in_pool = pool->free_bufs_in_pool;
-  poolinfo->number_of_bufs_shared = pool->number_of_bufs_shared;
+  poolinfo->free_bufs_in_pool =
+      pool->free_bufs_in_pool + poolinfo->free_bufs_in_thread_caches;
+  poolinfo->number_of_bufs_shared =
+      pool->number_of_bufs_shared - poolinfo->free_bufs_in_thread_caches;
   poolinfo->expandable_size = pool->expandable_size;
   poolinfo->total_bufs_allocated_by_pool = pool->total_bufs_allocated_by_pool;
   poolinfo->flags = pool->flags;
@@ -466,7 +902,8 @@ int mempool_available_space(MemoryPoolHandle p_pool, size_t *p_avail_bytes) {
     pthread_mutex_lock(&p_pool->lock);
   }
   const size_t used_space =
-      p_pool->number_of_bufs_shared * p_pool->mempool_item_size;
+      (p_pool->number_of_bufs_shared - thread_caches_free_bufs(p_pool)) *
+      p_pool->mempool_item_size;
   const size_t max_memory_threshold = p_pool->max_memory_threshold;
 
   *p_avail_bytes =
@@ -518,8 +955,14 @@ int mempool_downsize(MemoryPoolHandle handle, size_t mem_to_free) {
     bufs_to_free = pool->free_bufs_in_pool;
   }
 
-  /* Free the items in free list */
-  if (bufs_to_free > 0) {
+  if (bufs_to_free > 0 && pool->slab_size > 0) {
+    /* Items can be freed by whole slabs only */
+    bufs_to_free = hugepage_slabs_free(pool, bufs_to_free);
+    if (bufs_to_free > 0 && pool->mem_mark_free_space_func) {
+      pool->mem_mark_free_space_func(bufs_to_free * pool->mempool_item_size);
+    }
+  } else if (bufs_to_free > 0) {
+    /* Free the items in free list */
     pool_item = pool->free_list;
     count = 0;
     while (count < bufs_to_free && pool_item != NULL) {
@@ -575,6 +1018,32 @@ int mempool_destroy(MemoryPoolHandle *handle) {
 
   /* reset the handle */
   *handle = NULL;
+
+  /* Items in thread caches go back to the free list, caches of live threads
+     are freed as well as the key is deleted and thread_cache_destructor won't
+     be called */
+  while (pool->thread_caches != NULL) {
+    struct thread_cache *cache = pool->thread_caches;
+    pool->thread_caches = cache->next;
+
+    thread_cache_flush(pool, cache, 0);
+    free(cache);
+  }
+  if (pool->thread_cache_size > 0) {
+    pthread_key_delete(pool->thread_cache_key);
+  }
+
+  if (pool->slab_size > 0) {
+    /* Slabs with items still in use are left mapped */
+    hugepage_slabs_free(pool, INT_MAX);
+    while (pool->slabs != NULL) {
+      struct hugepage_slab *slab = pool->slabs;
+      pool->slabs = slab->next;
+      free(slab);
+    }
+    pool->free_list = NULL;
+  }
+
   /* Free the items in free list */
   pool_item = pool->free_list;
   while (pool_item != NULL) {
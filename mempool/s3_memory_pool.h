@@ -34,6 +34,12 @@ extern "C" {
 #define CREATE_ALIGNED_MEMORY 0x0001
 #define ENABLE_LOCKING 0x0002
 #define ZEROED_BUFFER 0x0004
+/* With ENABLE_LOCKING: keep per thread caches of free buffers */
+#define ENABLE_THREAD_CACHE 0x0008
+/* Carve items from hugepage backed slabs */
+#define USE_HUGEPAGES 0x0010
+/* Touch every page of newly allocated items */
+#define PREFAULT_MEMORY 0x0020
 
 #define MEMORY_ALIGNMENT 4096
 #define S3_MEMPOOL_ERROR -1
@@ -61,9 +67,10 @@ typedef void (*func_log_callback_type)(int log_level, const char *);
 
 struct pool_info {
   int flags;
-  int free_bufs_in_pool;
+  int free_bufs_in_pool; /* Including the ones in per thread caches */
   int number_of_bufs_shared;
   int total_bufs_allocated_by_pool;
+  int free_bufs_in_thread_caches;
   size_t mempool_item_size;
   size_t expandable_size;
 };
@@ -107,6 +114,25 @@ struct pool_info {
  *
  *     mempool_create() --> mempool_getbuffer() --> mempool_releasebuffer() -->
  *     mempool_destroy()
+ *
+ * Example 3: Memory pool shared by several threads
+ * 1) Create the pool with flags ENABLE_LOCKING | ENABLE_THREAD_CACHE.
+ * 2) Every thread using the pool gets a small cache of free items, items are
+ *    taken from and released to the cache without locking. Empty cache is
+ *    refilled from the pool's free list, and overfull cache returns items to
+ *    it, half of the cache size at once, under the pool's lock.
+ * 3) Items in the cache of a thread are returned to the pool's free list when
+ *    the thread exits. mempool_downsize() can only free items on the pool's
+ *    free list.
+ * 4) Thread caches are not used for items larger than 256KB, lock overhead is
+ *    negligible for them.
+ *
+ * Example 4: Memory pool of hugepage backed items on NUMA system
+ * 1) Create the pool with flags USE_HUGEPAGES | PREFAULT_MEMORY and initial
+ *    size 0.
+ * 2) Every thread using the pool calls mempool_reserve_for_thread() for its
+ *    share of items. Pages of the items are faulted in by that thread, so they
+ *    are placed on its NUMA node.
  */
 
 /**
@@ -122,7 +148,13 @@ struct pool_info {
  * pool_max_threshold_size (in) maximum allowed memory utilization(Consumed by
  * app. + free list in pool)
  * when done via the pool
- * flags (in) if ENABLE_LOCKING then pool synchronization with lock
+ * flags (in) if ENABLE_LOCKING then pool synchronization with lock,
+ * ENABLE_THREAD_CACHE (with ENABLE_LOCKING) per thread caches of free items,
+ * USE_HUGEPAGES items are carved at page aligned offsets from slabs of
+ * multiple of 2MB, which are mmap'ed with MAP_HUGETLB when hugepages are
+ * available, otherwise 2MB aligned with MADV_HUGEPAGE,
+ * PREFAULT_MEMORY pages of new items are touched by the allocating thread, so
+ * that they are faulted in (and placed on its NUMA node) up front
  * p_handle (out) On success pool handle is returned here
  * returns:
  * 0 on success, otherwise an error
@@ -140,6 +172,20 @@ int mempool_create_with_shared_mem(
     func_log_callback_type log_callback_func, int flags,
     MemoryPoolHandle *p_handle);
 
+/**
+ * Allocate 'mem_to_reserve' bytes more of items by the calling thread, and put
+ * them to its cache as far as they fit (ENABLE_THREAD_CACHE), the rest to the
+ * pool's free list. With PREFAULT_MEMORY the items are faulted in by this
+ * thread.
+ * args:
+ * handle (in) Pool handle as returned by mempool_create
+ * mem_to_reserve (in) Bytes to allocate, MUST be multiple of pool_item_size
+ * returns:
+ * 0 on success, S3_MEMPOOL_THRESHOLD_EXCEEDED if only part of it could be
+ * allocated w.r.t max threshold, otherwise an error
+ */
+int mempool_reserve_for_thread(MemoryPoolHandle handle, size_t mem_to_reserve);
+
 /**
  * Allocate some buffer memory via memory pool
  * args:
@@ -210,6 +256,8 @@ int mempool_getbuffer_size(MemoryPoolHandle handle, size_t *buffer_size);
  * args:
  * handle (in) Pool handle as returned by mempool_create
  * mem_to_free (in) Bytes to free, MUST be multiple of pool_item_size
+ * With USE_HUGEPAGES only whole slabs, with all their items free in the pool,
+ * are freed. So it may free more than asked, or nothing.
  * returns:
  * 0 on success, otherwise an error
  */
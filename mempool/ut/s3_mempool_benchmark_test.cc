@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "s3_memory_pool.h"
+
+// Multithreaded get/release throughput of a shared pool, with and without
+// per thread caches.  Each thread keeps a small working set of buffers,
+// similar to a reactor serving several requests at once.
+// Takes seconds, so it's disabled; run it with
+//   s3mempoolut --gtest_also_run_disabled_tests
+//   --gtest_filter='MempoolBenchmark.*'
+
+#define BENCH_ITEM_SIZE (16 * 1024)
+#define BENCH_WORKING_SET 4
+#define BENCH_ITERATIONS 100000
+
+static double run_mempool_benchmark(int flags, unsigned n_threads) {
+  MemoryPoolHandle handle = NULL;
+  const size_t max_bytes =
+      (size_t)BENCH_ITEM_SIZE * (BENCH_WORKING_SET + 128) * n_threads;
+
+  EXPECT_EQ(0, mempool_create(BENCH_ITEM_SIZE, 0, 16 * BENCH_ITEM_SIZE,
+                              max_bytes, (func_log_callback_type)NULL, flags,
+                              &handle));
+  std::vector<std::thread> workers;
+  const auto start = std::chrono::steady_clock::now();
+
+  for (unsigned i = 0; i < n_threads; ++i) {
+    workers.emplace_back([handle]() {
+      void *bufs[BENCH_WORKING_SET];
+      for (int iter = 0; iter < BENCH_ITERATIONS; ++iter) {
+        for (int j = 0; j < BENCH_WORKING_SET; ++j) {
+          bufs[j] = mempool_getbuffer(handle, BENCH_ITEM_SIZE);
+          ASSERT_TRUE(bufs[j] != NULL);
+        }
+        for (int j = 0; j < BENCH_WORKING_SET; ++j) {
+          mempool_releasebuffer(handle, bufs[j], BENCH_ITEM_SIZE);
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  struct pool_info info;
+  EXPECT_EQ(0, mempool_getinfo(handle, &info));
+  EXPECT_EQ(0, info.number_of_bufs_shared);
+  EXPECT_EQ(0, info.free_bufs_in_thread_caches);
+  mempool_destroy(&handle);
+
+  const double ops = 2.0 * BENCH_WORKING_SET * BENCH_ITERATIONS * n_threads;
+  return ops / elapsed.count();
+}
+
+TEST(MempoolBenchmark, DISABLED_GetReleaseThroughput) {
+  static const unsigned thread_counts[] = {1, 2, 4, 8};
+
+  printf("%8s %20s %20s\n", "threads", "locked ops/sec", "cached ops/sec");
+  for (unsigned n_threads : thread_counts) {
+    const double locked = run_mempool_benchmark(ENABLE_LOCKING, n_threads);
+    const double cached =
+        run_mempool_benchmark(ENABLE_LOCKING | ENABLE_THREAD_CACHE, n_threads);
+    printf("%8u %20.0f %20.0f\n", n_threads, locked, cached);
+  }
+}
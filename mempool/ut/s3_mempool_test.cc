@@ -18,6 +18,11 @@
  *
  */
 
+#include <stdint.h>
+#include <string.h>
+
+#include <thread>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -293,6 +298,221 @@ TEST_F(MempoolTestSuite, AllocateMemMemoryPoolTest) {
   EXPECT_TRUE(((uint64_t)buf & 4095) == 0);
 }
 
+TEST_F(MempoolSelfCreateTestSuite, ThreadCacheTest) {
+  void *buf;
+
+  // 16 items per expansion, thread cache of 4KB items holds up to 64
+  EXPECT_EQ(0, mempool_create(FOUR_KB, 0, 16 * FOUR_KB, 64 * SIXTEEN_KB,
+                              (func_log_callback_type)NULL,
+                              ENABLE_LOCKING | ENABLE_THREAD_CACHE,
+                              &first_handle));
+  buf = mempool_getbuffer(first_handle, FOUR_KB);
+  EXPECT_TRUE(buf != NULL);
+
+  // The rest of expansion went to the cache of this thread
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+  EXPECT_EQ(16, firstpass_pool_details.total_bufs_allocated_by_pool);
+  EXPECT_EQ(15, firstpass_pool_details.free_bufs_in_thread_caches);
+  EXPECT_EQ(15, firstpass_pool_details.free_bufs_in_pool);
+  EXPECT_EQ(1, firstpass_pool_details.number_of_bufs_shared);
+
+  EXPECT_EQ(0, mempool_releasebuffer(first_handle, buf, FOUR_KB));
+
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &secondpass_pool_details));
+  EXPECT_EQ(16, secondpass_pool_details.free_bufs_in_thread_caches);
+  EXPECT_EQ(16, secondpass_pool_details.free_bufs_in_pool);
+  EXPECT_EQ(0, secondpass_pool_details.number_of_bufs_shared);
+
+  mempool_destroy(&first_handle);
+}
+
+TEST_F(MempoolSelfCreateTestSuite, ThreadCacheOverflowTest) {
+  void *bufs[100];
+  int i;
+
+  EXPECT_EQ(0, mempool_create(FOUR_KB, 0, 16 * FOUR_KB, 64 * SIXTEEN_KB,
+                              (func_log_callback_type)NULL,
+                              ENABLE_LOCKING | ENABLE_THREAD_CACHE,
+                              &first_handle));
+  for (i = 0; i < 100; i++) {
+    bufs[i] = mempool_getbuffer(first_handle, FOUR_KB);
+    EXPECT_TRUE(bufs[i] != NULL);
+  }
+  for (i = 0; i < 100; i++) {
+    EXPECT_EQ(0, mempool_releasebuffer(first_handle, bufs[i], FOUR_KB));
+  }
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+  EXPECT_GE(64, firstpass_pool_details.free_bufs_in_thread_caches);
+  EXPECT_EQ(firstpass_pool_details.total_bufs_allocated_by_pool,
+            firstpass_pool_details.free_bufs_in_pool);
+  EXPECT_EQ(0, firstpass_pool_details.number_of_bufs_shared);
+
+  // Only the items on pool's free list can be freed
+  size_t reserved = 0;
+  EXPECT_EQ(0, mempool_reserved_space(first_handle, &reserved));
+  EXPECT_EQ((size_t)(firstpass_pool_details.free_bufs_in_pool -
+                     firstpass_pool_details.free_bufs_in_thread_caches) *
+                FOUR_KB,
+            reserved);
+
+  mempool_destroy(&first_handle);
+}
+
+TEST_F(MempoolSelfCreateTestSuite, ThreadCacheReleasedOnThreadExitTest) {
+  EXPECT_EQ(0, mempool_create(FOUR_KB, 0, 16 * FOUR_KB, 64 * SIXTEEN_KB,
+                              (func_log_callback_type)NULL,
+                              ENABLE_LOCKING | ENABLE_THREAD_CACHE,
+                              &first_handle));
+  std::thread worker([this]() {
+    void *buf = mempool_getbuffer(first_handle, FOUR_KB);
+    EXPECT_TRUE(buf != NULL);
+    EXPECT_EQ(0, mempool_releasebuffer(first_handle, buf, FOUR_KB));
+  });
+  worker.join();
+
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+  EXPECT_EQ(0, firstpass_pool_details.free_bufs_in_thread_caches);
+  EXPECT_EQ(16, firstpass_pool_details.free_bufs_in_pool);
+  EXPECT_EQ(0, firstpass_pool_details.number_of_bufs_shared);
+
+  size_t reserved = 0;
+  EXPECT_EQ(0, mempool_reserved_space(first_handle, &reserved));
+  EXPECT_EQ(16u * FOUR_KB, reserved);
+
+  mempool_destroy(&first_handle);
+}
+
+TEST_F(MempoolSelfCreateTestSuite, NoThreadCacheForLargeItemsTest) {
+  void *buf;
+
+  EXPECT_EQ(0, mempool_create(1024 * 1024, 0, 1024 * 1024, 4 * 1024 * 1024,
+                              (func_log_callback_type)NULL,
+                              ENABLE_LOCKING | ENABLE_THREAD_CACHE,
+                              &first_handle));
+  buf = mempool_getbuffer(first_handle, 1024 * 1024);
+  EXPECT_TRUE(buf != NULL);
+  EXPECT_EQ(0, mempool_releasebuffer(first_handle, buf, 1024 * 1024));
+
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+  EXPECT_EQ(0, firstpass_pool_details.free_bufs_in_thread_caches);
+  EXPECT_EQ(1, firstpass_pool_details.free_bufs_in_pool);
+
+  mempool_destroy(&first_handle);
+}
+
+TEST_F(MempoolSelfCreateTestSuite, HugepagesTest) {
+  const size_t item_size = 2 * 1024 * 1024;
+  void *buf;
+
+  EXPECT_EQ(0, mempool_create(item_size, 2 * item_size, item_size,
+                              4 * item_size, (func_log_callback_type)NULL,
+                              CREATE_ALIGNED_MEMORY | USE_HUGEPAGES |
+                                  PREFAULT_MEMORY,
+                              &first_handle));
+  buf = mempool_getbuffer(first_handle, item_size);
+  ASSERT_TRUE(buf != NULL);
+  // Either hugetlb or transparent hugepage backed item is 2MB aligned
+  EXPECT_EQ(0u, (uintptr_t)buf % item_size);
+  memset(buf, 1, item_size);
+  EXPECT_EQ(0, mempool_releasebuffer(first_handle, buf, item_size));
+
+  EXPECT_EQ(0, mempool_downsize(first_handle, item_size));
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+  EXPECT_EQ(1, firstpass_pool_details.total_bufs_allocated_by_pool);
+  EXPECT_EQ(1, firstpass_pool_details.free_bufs_in_pool);
+
+  mempool_destroy(&first_handle);
+}
+
+TEST_F(MempoolSelfCreateTestSuite, HugepagesSmallItemsTest) {
+  void *bufs[4];
+  int i;
+
+  EXPECT_EQ(0, mempool_create(TWELVE_KB, TWENTYFOUR_KB, TWELVE_KB,
+                              4 * TWELVE_KB, (func_log_callback_type)NULL,
+                              CREATE_ALIGNED_MEMORY | USE_HUGEPAGES |
+                                  ZEROED_BUFFER,
+                              &first_handle));
+  for (i = 0; i < 4; i++) {
+    bufs[i] = mempool_getbuffer(first_handle, TWELVE_KB);
+    ASSERT_TRUE(bufs[i] != NULL);
+    EXPECT_EQ(0u, (uintptr_t)bufs[i] % FOUR_KB);
+    EXPECT_EQ(0, ((char *)bufs[i])[TWELVE_KB - 1]);
+  }
+  EXPECT_TRUE(mempool_getbuffer(first_handle, TWELVE_KB) == NULL);
+  for (i = 0; i < 4; i++) {
+    EXPECT_EQ(0, mempool_releasebuffer(first_handle, bufs[i], TWELVE_KB));
+  }
+  EXPECT_EQ(0, mempool_downsize(first_handle, 4 * TWELVE_KB));
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+  EXPECT_EQ(0, firstpass_pool_details.total_bufs_allocated_by_pool);
+
+  mempool_destroy(&first_handle);
+}
+
+TEST_F(MempoolSelfCreateTestSuite, HugepagesSlabTest) {
+  const size_t item_size = 1024 * 1024;
+  void *bufs[2];
+
+  EXPECT_EQ(0, mempool_create(item_size, 0, 2 * item_size, 4 * item_size,
+                              (func_log_callback_type)NULL,
+                              CREATE_ALIGNED_MEMORY | USE_HUGEPAGES,
+                              &first_handle));
+  bufs[0] = mempool_getbuffer(first_handle, item_size);
+  bufs[1] = mempool_getbuffer(first_handle, item_size);
+  ASSERT_TRUE(bufs[0] != NULL);
+  ASSERT_TRUE(bufs[1] != NULL);
+  // Both items are carved from one 2MB slab
+  EXPECT_EQ((uintptr_t)bufs[0] & ~(uintptr_t)(2 * item_size - 1),
+            (uintptr_t)bufs[1] & ~(uintptr_t)(2 * item_size - 1));
+  EXPECT_NE(bufs[0], bufs[1]);
+
+  // Slab can't be freed while one of its items is in use
+  EXPECT_EQ(0, mempool_releasebuffer(first_handle, bufs[0], item_size));
+  EXPECT_EQ(0, mempool_downsize(first_handle, item_size));
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+  EXPECT_EQ(2, firstpass_pool_details.total_bufs_allocated_by_pool);
+
+  EXPECT_EQ(0, mempool_releasebuffer(first_handle, bufs[1], item_size));
+  EXPECT_EQ(0, mempool_downsize(first_handle, item_size));
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+  EXPECT_EQ(0, firstpass_pool_details.total_bufs_allocated_by_pool);
+  EXPECT_EQ(0, firstpass_pool_details.free_bufs_in_pool);
+
+  mempool_destroy(&first_handle);
+}
+
+TEST_F(MempoolSelfCreateTestSuite, ReserveForThreadTest) {
+  EXPECT_EQ(0, mempool_create(FOUR_KB, 0, FOUR_KB, 16 * FOUR_KB,
+                              (func_log_callback_type)NULL,
+                              CREATE_ALIGNED_MEMORY | ENABLE_LOCKING |
+                                  ENABLE_THREAD_CACHE | PREFAULT_MEMORY,
+                              &first_handle));
+  EXPECT_EQ(S3_MEMPOOL_INVALID_ARG,
+            mempool_reserve_for_thread(first_handle, FOUR_KB + 1));
+
+  std::thread reactor([this]() {
+    EXPECT_EQ(0, mempool_reserve_for_thread(first_handle, 8 * FOUR_KB));
+    EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+    EXPECT_EQ(8, firstpass_pool_details.total_bufs_allocated_by_pool);
+    EXPECT_EQ(8, firstpass_pool_details.free_bufs_in_thread_caches);
+
+    // Only what fits under the threshold
+    EXPECT_EQ(S3_MEMPOOL_THRESHOLD_EXCEEDED,
+              mempool_reserve_for_thread(first_handle, 16 * FOUR_KB));
+    EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+    EXPECT_EQ(16, firstpass_pool_details.total_bufs_allocated_by_pool);
+  });
+  reactor.join();
+
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &secondpass_pool_details));
+  EXPECT_EQ(16, secondpass_pool_details.free_bufs_in_pool);
+  EXPECT_EQ(0, secondpass_pool_details.free_bufs_in_thread_caches);
+  EXPECT_EQ(0, secondpass_pool_details.number_of_bufs_shared);
+
+  mempool_destroy(&first_handle);
+}
+
 int main(int argc, char **argv) {
   int rc;
 
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+/*
+   Compares aggregate MD5 throughput of concurrent streams hashed one by one
+   with OpenSSL against the multi-buffer engines supported by the CPU.
+
+   Usage example:
+   # 64 streams, each updated in 1 MB units, 4 GB hashed per engine
+   ./s3md5bench -streams 64 -unit_size_kb 1024 -total_mb 4096
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include "s3_md5_multibuffer.h"
+
+DEFINE_int32(streams, 64, "Number of concurrent streams (uploads)");
+DEFINE_int32(unit_size_kb, 1024, "Size of one update of a stream in KB");
+DEFINE_int64(total_mb, 4096, "Data hashed per engine in MB");
+
+typedef S3MD5MultiBuffer::Engine Engine;
+
+// Runs rounds of one unit per stream until total_mb is hashed, returns
+// digests of all streams so that engines can be cross checked
+static std::vector<std::string> run(Engine engine,
+                                    const std::vector<unsigned char> &data,
+                                    double *gb_per_sec) {
+  const size_t streams = FLAGS_streams;
+  const size_t unit_size = (size_t)FLAGS_unit_size_kb * 1024;
+  const size_t rounds =
+      std::max<size_t>(1, (size_t)FLAGS_total_mb * 1024 * 1024 /
+                              (unit_size * streams));
+
+  std::vector<MD5_CTX> ctxs(streams);
+  std::vector<MD5_CTX *> ctx_ptrs(streams);
+  std::vector<const void *> units(streams);
+  std::vector<size_t> lens(streams, unit_size);
+  for (size_t i = 0; i < streams; ++i) {
+    MD5_Init(&ctxs[i]);
+    ctx_ptrs[i] = &ctxs[i];
+    // Streams don't share data, as different uploads wouldn't
+    units[i] = data.data() + i * unit_size;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t round = 0; round < rounds; ++round) {
+    S3MD5MultiBuffer::update(ctx_ptrs.data(), units.data(), lens.data(),
+                             streams, engine);
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  *gb_per_sec = (double)rounds * streams * unit_size / elapsed.count() / 1e9;
+
+  std::vector<std::string> digests;
+  for (auto &ctx : ctxs) {
+    unsigned char md[MD5_DIGEST_LENGTH];
+    MD5_Final(md, &ctx);
+    digests.emplace_back((const char *)md, sizeof(md));
+  }
+  return digests;
+}
+
+int main(int argc, char **argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  if (FLAGS_streams <= 0 || FLAGS_unit_size_kb <= 0 || FLAGS_total_mb <= 0) {
+    fprintf(stderr, "streams, unit_size_kb and total_mb must be positive\n");
+    return 1;
+  }
+
+  std::vector<unsigned char> data((size_t)FLAGS_streams * FLAGS_unit_size_kb *
+                                  1024);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = (unsigned char)(i * 2654435761u >> 13);
+  }
+
+  printf("streams=%d unit_size_kb=%d total_mb=%ld\n", FLAGS_streams,
+         FLAGS_unit_size_kb, (long)FLAGS_total_mb);
+
+  double scalar_gbps = 0;
+  const std::vector<std::string> expected =
+      run(Engine::scalar, data, &scalar_gbps);
+  printf("%-8s lanes=%-2u %8.2f GB/s\n",
+         S3MD5MultiBuffer::get_engine_name(Engine::scalar), 1u, scalar_gbps);
+
+  int rc = 0;
+  for (Engine engine : {Engine::sse2, Engine::avx2, Engine::avx512}) {
+    if (!S3MD5MultiBuffer::is_engine_supported(engine)) {
+      printf("%-8s not supported by CPU\n",
+             S3MD5MultiBuffer::get_engine_name(engine));
+      continue;
+    }
+    double gbps = 0;
+    const bool same = run(engine, data, &gbps) == expected;
+    printf("%-8s lanes=%-2u %8.2f GB/s  x%.2f%s\n",
+           S3MD5MultiBuffer::get_engine_name(engine),
+           S3MD5MultiBuffer::get_lane_count(engine), gbps, gbps / scalar_gbps,
+           same ? "" : "  DIGEST MISMATCH");
+    if (!same) {
+      rc = 1;
+    }
+  }
+  return rc;
+}
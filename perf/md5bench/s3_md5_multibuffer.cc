@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "s3_md5_multibuffer.h"
+
+// AVX-512 intrinsics need GCC 5 or newer
+#if defined(__x86_64__) && (__GNUC__ >= 5 || defined(__clang__))
+#define S3_MD5_HAVE_AVX512
+#endif
+
+#define S3_MD5_BLOCK_SIZE 64
+#define S3_MD5_MAX_LANES 16
+
+namespace {
+
+// One stream while its whole blocks are hashed
+struct md5_lane {
+  MD5_CTX *ctx;
+  const unsigned char *data;
+  size_t blocks;
+};
+
+// Rest of a stream shorter than a block
+struct md5_tail {
+  MD5_CTX *ctx;
+  const unsigned char *data;
+  size_t len;
+};
+
+// Accounts hashed blocks in the bit length the same way MD5_Update() does
+void add_length(MD5_CTX *ctx, size_t blocks) {
+  const size_t len = blocks * S3_MD5_BLOCK_SIZE;
+  const MD5_LONG l = (ctx->Nl + (((MD5_LONG)len) << 3)) & 0xffffffffUL;
+  if (l < ctx->Nl) {
+    ++ctx->Nh;
+  }
+  ctx->Nh += (MD5_LONG)((uint64_t)len >> 29);
+  ctx->Nl = l;
+}
+
+#if defined(__x86_64__)
+
+// Message words of one block of every lane, word-major, so that word 'k' of
+// all lanes is one vector load
+template <unsigned LANES>
+inline void transpose_block(uint32_t *words, const unsigned char *const *data,
+                            size_t block) {
+  for (unsigned lane = 0; lane < LANES; ++lane) {
+    const unsigned char *src = data[lane] + block * S3_MD5_BLOCK_SIZE;
+    for (unsigned k = 0; k < 16; ++k) {
+      uint32_t word;
+      memcpy(&word, src + 4 * k, sizeof(word));
+      words[k * LANES + lane] = word;
+    }
+  }
+}
+
+// Expands to the 64 steps of RFC 1321, given vector ops ADD, ROTL, SET1
+// and round functions F, G, H, I defined by the engine
+#define S3_MD5_STEP(FN, a, b, c, d, k, s, t) \
+  a = ADD(b, ROTL(ADD(ADD(a, FN(b, c, d)), ADD(w[k], SET1(t))), s))
+
+#define S3_MD5_ROUNDS                                  \
+  S3_MD5_STEP(F, a, b, c, d, 0, 7, 0xd76aa478);        \
+  S3_MD5_STEP(F, d, a, b, c, 1, 12, 0xe8c7b756);       \
+  S3_MD5_STEP(F, c, d, a, b, 2, 17, 0x242070db);       \
+  S3_MD5_STEP(F, b, c, d, a, 3, 22, 0xc1bdceee);       \
+  S3_MD5_STEP(F, a, b, c, d, 4, 7, 0xf57c0faf);        \
+  S3_MD5_STEP(F, d, a, b, c, 5, 12, 0x4787c62a);       \
+  S3_MD5_STEP(F, c, d, a, b, 6, 17, 0xa8304613);       \
+  S3_MD5_STEP(F, b, c, d, a, 7, 22, 0xfd469501);       \
+  S3_MD5_STEP(F, a, b, c, d, 8, 7, 0x698098d8);        \
+  S3_MD5_STEP(F, d, a, b, c, 9, 12, 0x8b44f7af);       \
+  S3_MD5_STEP(F, c, d, a, b, 10, 17, 0xffff5bb1);      \
+  S3_MD5_STEP(F, b, c, d, a, 11, 22, 0x895cd7be);      \
+  S3_MD5_STEP(F, a, b, c, d, 12, 7, 0x6b901122);       \
+  S3_MD5_STEP(F, d, a, b, c, 13, 12, 0xfd987193);      \
+  S3_MD5_STEP(F, c, d, a, b, 14, 17, 0xa679438e);      \
+  S3_MD5_STEP(F, b, c, d, a, 15, 22, 0x49b40821);      \
+  S3_MD5_STEP(G, a, b, c, d, 1, 5, 0xf61e2562);        \
+  S3_MD5_STEP(G, d, a, b, c, 6, 9, 0xc040b340);        \
+  S3_MD5_STEP(G, c, d, a, b, 11, 14, 0x265e5a51);      \
+  S3_MD5_STEP(G, b, c, d, a, 0, 20, 0xe9b6c7aa);       \
+  S3_MD5_STEP(G, a, b, c, d, 5, 5, 0xd62f105d);        \
+  S3_MD5_STEP(G, d, a, b, c, 10, 9, 0x02441453);       \
+  S3_MD5_STEP(G, c, d, a, b, 15, 14, 0xd8a1e681);      \
+  S3_MD5_STEP(G, b, c, d, a, 4, 20, 0xe7d3fbc8);       \
+  S3_MD5_STEP(G, a, b, c, d, 9, 5, 0x21e1cde6);        \
+  S3_MD5_STEP(G, d, a, b, c, 14, 9, 0xc33707d6);       \
+  S3_MD5_STEP(G, c, d, a, b, 3, 14, 0xf4d50d87);       \
+  S3_MD5_STEP(G, b, c, d, a, 8, 20, 0x455a14ed);       \
+  S3_MD5_STEP(G, a, b, c, d, 13, 5, 0xa9e3e905);       \
+  S3_MD5_STEP(G, d, a, b, c, 2, 9, 0xfcefa3f8);        \
+  S3_MD5_STEP(G, c, d, a, b, 7, 14, 0x676f02d9);       \
+  S3_MD5_STEP(G, b, c, d, a, 12, 20, 0x8d2a4c8a);      \
+  S3_MD5_STEP(H, a, b, c, d, 5, 4, 0xfffa3942);        \
+  S3_MD5_STEP(H, d, a, b, c, 8, 11, 0x8771f681);       \
+  S3_MD5_STEP(H, c, d, a, b, 11, 16, 0x6d9d6122);      \
+  S3_MD5_STEP(H, b, c, d, a, 14, 23, 0xfde5380c);      \
+  S3_MD5_STEP(H, a, b, c, d, 1, 4, 0xa4beea44);        \
+  S3_MD5_STEP(H, d, a, b, c, 4, 11, 0x4bdecfa9);       \
+  S3_MD5_STEP(H, c, d, a, b, 7, 16, 0xf6bb4b60);       \
+  S3_MD5_STEP(H, b, c, d, a, 10, 23, 0xbebfbc70);      \
+  S3_MD5_STEP(H, a, b, c, d, 13, 4, 0x289b7ec6);       \
+  S3_MD5_STEP(H, d, a, b, c, 0, 11, 0xeaa127fa);       \
+  S3_MD5_STEP(H, c, d, a, b, 3, 16, 0xd4ef3085);       \
+  S3_MD5_STEP(H, b, c, d, a, 6, 23, 0x04881d05);       \
+  S3_MD5_STEP(H, a, b, c, d, 9, 4, 0xd9d4d039);        \
+  S3_MD5_STEP(H, d, a, b, c, 12, 11, 0xe6db99e5);      \
+  S3_MD5_STEP(H, c, d, a, b, 15, 16, 0x1fa27cf8);      \
+  S3_MD5_STEP(H, b, c, d, a, 2, 23, 0xc4ac5665);       \
+  S3_MD5_STEP(I, a, b, c, d, 0, 6, 0xf4292244);        \
+  S3_MD5_STEP(I, d, a, b, c, 7, 10, 0x432aff97);       \
+  S3_MD5_STEP(I, c, d, a, b, 14, 15, 0xab9423a7);      \
+  S3_MD5_STEP(I, b, c, d, a, 5, 21, 0xfc93a039);       \
+  S3_MD5_STEP(I, a, b, c, d, 12, 6, 0x655b59c3);       \
+  S3_MD5_STEP(I, d, a, b, c, 3, 10, 0x8f0ccc92);       \
+  S3_MD5_STEP(I, c, d, a, b, 10, 15, 0xffeff47d);      \
+  S3_MD5_STEP(I, b, c, d, a, 1, 21, 0x85845dd1);       \
+  S3_MD5_STEP(I, a, b, c, d, 8, 6, 0x6fa87e4f);        \
+  S3_MD5_STEP(I, d, a, b, c, 15, 10, 0xfe2ce6e0);      \
+  S3_MD5_STEP(I, c, d, a, b, 6, 15, 0xa3014314);       \
+  S3_MD5_STEP(I, b, c, d, a, 13, 21, 0x4e0811a1);      \
+  S3_MD5_STEP(I, a, b, c, d, 4, 6, 0xf7537e82);        \
+  S3_MD5_STEP(I, d, a, b, c, 11, 10, 0xbd3af235);      \
+  S3_MD5_STEP(I, c, d, a, b, 2, 15, 0x2ad7d2bb);       \
+  S3_MD5_STEP(I, b, c, d, a, 9, 21, 0xeb86d391)
+
+// Body of an engine: hashes 'blocks' blocks of every lane. Expects vector
+// type V, lane count LANES and ops LOAD, STORE besides the ones above.
+#define S3_MD5_LANES_BODY                                               \
+  alignas(64) uint32_t words[16 * LANES];                               \
+  alignas(64) uint32_t state[4][LANES];                                 \
+  for (unsigned lane = 0; lane < LANES; ++lane) {                       \
+    state[0][lane] = ctx[lane]->A;                                      \
+    state[1][lane] = ctx[lane]->B;                                      \
+    state[2][lane] = ctx[lane]->C;                                      \
+    state[3][lane] = ctx[lane]->D;                                      \
+  }                                                                     \
+  V a = LOAD(state[0]), b = LOAD(state[1]);                             \
+  V c = LOAD(state[2]), d = LOAD(state[3]);                             \
+  for (size_t block = 0; block < blocks; ++block) {                     \
+    transpose_block<LANES>(words, data, block);                         \
+    V w[16];                                                            \
+    for (unsigned k = 0; k < 16; ++k) {                                 \
+      w[k] = LOAD(words + k * LANES);                                   \
+    }                                                                   \
+    const V a0 = a, b0 = b, c0 = c, d0 = d;                             \
+    S3_MD5_ROUNDS;                                                      \
+    a = ADD(a, a0);                                                     \
+    b = ADD(b, b0);                                                     \
+    c = ADD(c, c0);                                                     \
+    d = ADD(d, d0);                                                     \
+  }                                                                     \
+  STORE(state[0], a);                                                   \
+  STORE(state[1], b);                                                   \
+  STORE(state[2], c);                                                   \
+  STORE(state[3], d);                                                   \
+  for (unsigned lane = 0; lane < LANES; ++lane) {                       \
+    ctx[lane]->A = state[0][lane];                                      \
+    ctx[lane]->B = state[1][lane];                                      \
+    ctx[lane]->C = state[2][lane];                                      \
+    ctx[lane]->D = state[3][lane];                                      \
+  }
+
+#define F(b, c, d) XOR(d, AND(b, XOR(c, d)))
+#define G(b, c, d) XOR(c, AND(d, XOR(b, c)))
+#define H(b, c, d) XOR(XOR(b, c), d)
+#define I(b, c, d) XOR(c, OR(b, XOR(d, SET1(0xffffffff))))
+
+#define LANES 4
+#define V __m128i
+#define LOAD(p) _mm_load_si128((const __m128i *)(p))
+#define STORE(p, x) _mm_store_si128((__m128i *)(p), x)
+#define ADD _mm_add_epi32
+#define AND _mm_and_si128
+#define OR _mm_or_si128
+#define XOR _mm_xor_si128
+#define SET1(t) _mm_set1_epi32((int)(t))
+#define ROTL(x, s) OR(_mm_slli_epi32(x, s), _mm_srli_epi32(x, 32 - (s)))
+
+__attribute__((target("sse2"))) void md5_blocks_sse2(
+    MD5_CTX *const *ctx, const unsigned char *const *data, size_t blocks) {
+  S3_MD5_LANES_BODY
+}
+
+#undef LANES
+#undef V
+#undef LOAD
+#undef STORE
+#undef ADD
+#undef AND
+#undef OR
+#undef XOR
+#undef SET1
+#undef ROTL
+
+#define LANES 8
+#define V __m256i
+#define LOAD(p) _mm256_load_si256((const __m256i *)(p))
+#define STORE(p, x) _mm256_store_si256((__m256i *)(p), x)
+#define ADD _mm256_add_epi32
+#define AND _mm256_and_si256
+#define OR _mm256_or_si256
+#define XOR _mm256_xor_si256
+#define SET1(t) _mm256_set1_epi32((int)(t))
+#define ROTL(x, s) OR(_mm256_slli_epi32(x, s), _mm256_srli_epi32(x, 32 - (s)))
+
+__attribute__((target("avx2"))) void md5_blocks_avx2(
+    MD5_CTX *const *ctx, const unsigned char *const *data, size_t blocks) {
+  S3_MD5_LANES_BODY
+}
+
+#undef LANES
+#undef V
+#undef LOAD
+#undef STORE
+#undef ADD
+#undef AND
+#undef OR
+#undef XOR
+#undef SET1
+#undef ROTL
+#undef F
+#undef G
+#undef H
+#undef I
+
+#ifdef S3_MD5_HAVE_AVX512
+
+// AVX-512 has rotates, and each round function is a single ternary logic op
+#define F(b, c, d) _mm512_ternarylogic_epi32(b, c, d, 0xca)
+#define G(b, c, d) _mm512_ternarylogic_epi32(b, c, d, 0xe4)
+#define H(b, c, d) _mm512_ternarylogic_epi32(b, c, d, 0x96)
+#define I(b, c, d) _mm512_ternarylogic_epi32(b, c, d, 0x39)
+
+#define LANES 16
+#define V __m512i
+#define LOAD(p) _mm512_load_si512((const void *)(p))
+#define STORE(p, x) _mm512_store_si512((void *)(p), x)
+#define ADD _mm512_add_epi32
+#define SET1(t) _mm512_set1_epi32((int)(t))
+// Masked form, since the plain one trips -Wmaybe-uninitialized in GCC 12
+#define ROTL(x, s) _mm512_mask_rol_epi32(x, 0xffff, x, s)
+
+__attribute__((target("avx512f"))) void md5_blocks_avx512(
+    MD5_CTX *const *ctx, const unsigned char *const *data, size_t blocks) {
+  S3_MD5_LANES_BODY
+}
+
+#undef LANES
+#undef V
+#undef LOAD
+#undef STORE
+#undef ADD
+#undef SET1
+#undef ROTL
+#undef F
+#undef G
+#undef H
+#undef I
+
+#endif  // S3_MD5_HAVE_AVX512
+#undef S3_MD5_LANES_BODY
+#undef S3_MD5_ROUNDS
+#undef S3_MD5_STEP
+
+#endif  // __x86_64__
+
+typedef void (*md5_blocks_fn)(MD5_CTX *const *, const unsigned char *const *,
+                              size_t);
+
+md5_blocks_fn get_blocks_fn(S3MD5MultiBuffer::Engine engine) {
+  switch (engine) {
+#if defined(__x86_64__)
+    case S3MD5MultiBuffer::Engine::sse2:
+      return md5_blocks_sse2;
+    case S3MD5MultiBuffer::Engine::avx2:
+      return md5_blocks_avx2;
+#endif
+#ifdef S3_MD5_HAVE_AVX512
+    case S3MD5MultiBuffer::Engine::avx512:
+      return md5_blocks_avx512;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+S3MD5MultiBuffer::Engine S3MD5MultiBuffer::get_best_engine() {
+  static const Engine best = []() {
+    for (Engine engine : {Engine::avx512, Engine::avx2, Engine::sse2}) {
+      if (is_engine_supported(engine)) {
+        return engine;
+      }
+    }
+    return Engine::scalar;
+  }();
+  return best;
+}
+
+bool S3MD5MultiBuffer::is_engine_supported(Engine engine) {
+  switch (engine) {
+    case Engine::scalar:
+      return true;
+#if defined(__x86_64__)
+    case Engine::sse2:
+      return __builtin_cpu_supports("sse2");
+    case Engine::avx2:
+      return __builtin_cpu_supports("avx2");
+#endif
+#ifdef S3_MD5_HAVE_AVX512
+    case Engine::avx512:
+      return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+      return false;
+  }
+}
+
+unsigned S3MD5MultiBuffer::get_lane_count(Engine engine) {
+  switch (engine) {
+    case Engine::sse2:
+      return 4;
+    case Engine::avx2:
+      return 8;
+    case Engine::avx512:
+      return 16;
+    default:
+      return 1;
+  }
+}
+
+const char *S3MD5MultiBuffer::get_engine_name(Engine engine) {
+  switch (engine) {
+    case Engine::sse2:
+      return "sse2";
+    case Engine::avx2:
+      return "avx2";
+    case Engine::avx512:
+      return "avx512";
+    default:
+      return "scalar";
+  }
+}
+
+void S3MD5MultiBuffer::update(MD5_CTX *const ctx[], const void *const data[],
+                              const size_t len[], size_t count,
+                              Engine engine) {
+  md5_blocks_fn blocks_fn =
+      is_engine_supported(engine) ? get_blocks_fn(engine) : nullptr;
+  if (!blocks_fn || count < 2) {
+    for (size_t i = 0; i < count; ++i) {
+      MD5_Update(ctx[i], data[i], len[i]);
+    }
+    return;
+  }
+  const unsigned lane_count = get_lane_count(engine);
+
+  // Bytes buffered in a context from the previous update are completed to a
+  // whole block first, the remainder shorter than a block is left buffered
+  // at the end
+  std::vector<md5_lane> pending;
+  std::vector<md5_tail> tails;
+  pending.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const unsigned char *p = (const unsigned char *)data[i];
+    size_t n = len[i];
+    if (ctx[i]->num != 0) {
+      const size_t head =
+          std::min(n, (size_t)(S3_MD5_BLOCK_SIZE - ctx[i]->num));
+      MD5_Update(ctx[i], p, head);
+      p += head;
+      n -= head;
+    }
+    const size_t blocks = n / S3_MD5_BLOCK_SIZE;
+    if (blocks != 0) {
+      pending.push_back({ctx[i], p, blocks});
+    }
+    if (n % S3_MD5_BLOCK_SIZE != 0) {
+      tails.push_back(
+          {ctx[i], p + blocks * S3_MD5_BLOCK_SIZE, n % S3_MD5_BLOCK_SIZE});
+    }
+  }
+
+  // Streams enter free lanes as others finish. Unused lanes repeat lane 0
+  // into a scratch context.
+  md5_lane lanes[S3_MD5_MAX_LANES];
+  unsigned active = 0;
+  size_t next = 0;
+  MD5_CTX scratch[S3_MD5_MAX_LANES];
+  MD5_CTX *lane_ctx[S3_MD5_MAX_LANES];
+  const unsigned char *lane_data[S3_MD5_MAX_LANES];
+
+  for (;;) {
+    while (active < lane_count && next < pending.size()) {
+      lanes[active++] = pending[next++];
+    }
+    if (active == 0) {
+      break;
+    }
+    if (active == 1) {
+      // A single stream is faster without SIMD
+      MD5_Update(lanes[0].ctx, lanes[0].data,
+                 lanes[0].blocks * S3_MD5_BLOCK_SIZE);
+      active = 0;
+      continue;
+    }
+    size_t blocks = lanes[0].blocks;
+    for (unsigned lane = 1; lane < active; ++lane) {
+      blocks = std::min(blocks, lanes[lane].blocks);
+    }
+    for (unsigned lane = 0; lane < lane_count; ++lane) {
+      if (lane < active) {
+        lane_ctx[lane] = lanes[lane].ctx;
+        lane_data[lane] = lanes[lane].data;
+      } else {
+        scratch[lane] = *lanes[0].ctx;
+        lane_ctx[lane] = &scratch[lane];
+        lane_data[lane] = lanes[0].data;
+      }
+    }
+    blocks_fn(lane_ctx, lane_data, blocks);
+
+    unsigned kept = 0;
+    for (unsigned lane = 0; lane < active; ++lane) {
+      md5_lane &stream = lanes[lane];
+      add_length(stream.ctx, blocks);
+      stream.data += blocks * S3_MD5_BLOCK_SIZE;
+      stream.blocks -= blocks;
+      if (stream.blocks != 0) {
+        lanes[kept++] = stream;
+      }
+    }
+    active = kept;
+  }
+
+  for (const md5_tail &tail : tails) {
+    MD5_Update(tail.ctx, tail.data, tail.len);
+  }
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_PERF_S3_MD5_MULTIBUFFER_H__
+#define __S3_PERF_S3_MD5_MULTIBUFFER_H__
+
+#include <cstddef>
+#include <openssl/md5.h>
+
+// MD5 of one stream can't be parallelized, but independent streams can be
+// hashed together, one stream per SIMD lane. States are plain OpenSSL
+// MD5_CTX, so a stream can be continued or finalized with MD5_Update() and
+// MD5_Final(), and the result is bit exact with them.
+// Not used by s3server: its MD5 runs inside Motr's PI calculation, which owns
+// the running state (see MD5hash). Measured by s3md5bench.
+class S3MD5MultiBuffer {
+ public:
+  enum class Engine {
+    scalar,  // OpenSSL MD5_Update()
+    sse2,    // 4 lanes
+    avx2,    // 8 lanes
+    avx512   // 16 lanes
+  };
+
+  // Widest engine supported by the CPU
+  static Engine get_best_engine();
+  static bool is_engine_supported(Engine engine);
+  static unsigned get_lane_count(Engine engine);
+  static const char* get_engine_name(Engine engine);
+
+  // Same as MD5_Update(ctx[i], data[i], len[i]) for every i < count.
+  // Contexts must be distinct.
+  static void update(MD5_CTX* const ctx[], const void* const data[],
+                     const size_t len[], size_t count,
+                     Engine engine = get_best_engine());
+};
+
+#endif  // __S3_PERF_S3_MD5_MULTIBUFFER_H__
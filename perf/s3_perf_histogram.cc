@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "s3_perf_histogram.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+
+S3PerfHistogram::S3PerfHistogram(int64_t highest_trackable_value,
+                                 int significant_digits)
+    : highest_trackable_value(std::max<int64_t>(highest_trackable_value, 2)),
+      significant_digits(std::min(std::max(significant_digits, 1), 5)) {
+  // Smallest power of two that keeps the requested precision
+  int64_t largest_single_unit_value =
+      2 * (int64_t)std::pow(10, this->significant_digits);
+  int sub_bucket_count_magnitude =
+      (int)std::ceil(std::log2((double)largest_single_unit_value));
+  sub_bucket_half_count_magnitude = sub_bucket_count_magnitude - 1;
+  sub_bucket_count = 1 << sub_bucket_count_magnitude;
+  sub_bucket_half_count = sub_bucket_count / 2;
+  sub_bucket_mask = (int64_t)sub_bucket_count - 1;
+
+  int64_t smallest_untrackable_value = sub_bucket_count;
+  bucket_count = 1;
+  while (smallest_untrackable_value <= this->highest_trackable_value) {
+    if (smallest_untrackable_value > INT64_MAX / 2) {
+      ++bucket_count;
+      break;
+    }
+    smallest_untrackable_value <<= 1;
+    ++bucket_count;
+  }
+  counts.resize((size_t)(bucket_count + 1) * sub_bucket_half_count);
+}
+
+int32_t S3PerfHistogram::get_bucket_index(int64_t value) const {
+  int pow2_ceiling = 64 - __builtin_clzll(value | sub_bucket_mask);
+  return pow2_ceiling - (sub_bucket_half_count_magnitude + 1);
+}
+
+size_t S3PerfHistogram::get_counts_index(int64_t value) const {
+  int32_t bucket_index = get_bucket_index(value);
+  int32_t sub_bucket_index = (int32_t)(value >> bucket_index);
+  size_t bucket_base_index = (size_t)(bucket_index + 1)
+                             << sub_bucket_half_count_magnitude;
+  return bucket_base_index + sub_bucket_index - sub_bucket_half_count;
+}
+
+int64_t S3PerfHistogram::get_value_from_index(size_t index) const {
+  int32_t bucket_index = (int32_t)(index >> sub_bucket_half_count_magnitude) - 1;
+  int32_t sub_bucket_index =
+      (int32_t)(index & (sub_bucket_half_count - 1)) + sub_bucket_half_count;
+  if (bucket_index < 0) {
+    sub_bucket_index -= sub_bucket_half_count;
+    bucket_index = 0;
+  }
+  return (int64_t)sub_bucket_index << bucket_index;
+}
+
+int64_t S3PerfHistogram::get_highest_equivalent_value(int64_t value) const {
+  int32_t bucket_index = get_bucket_index(value);
+  int32_t sub_bucket_index = (int32_t)(value >> bucket_index);
+  int64_t lowest_equivalent_value = (int64_t)sub_bucket_index << bucket_index;
+  int32_t adjusted_bucket =
+      sub_bucket_index >= sub_bucket_count ? bucket_index + 1 : bucket_index;
+  return lowest_equivalent_value + ((int64_t)1 << adjusted_bucket) - 1;
+}
+
+void S3PerfHistogram::record(int64_t value) {
+  value = std::min(std::max<int64_t>(value, 0), highest_trackable_value);
+  ++counts[get_counts_index(value)];
+  ++total_count;
+  min_value = std::min(min_value, value);
+  max_value = std::max(max_value, value);
+  sum += value;
+}
+
+void S3PerfHistogram::add(const S3PerfHistogram& other) {
+  if (other.counts.size() == counts.size() &&
+      other.sub_bucket_count == sub_bucket_count) {
+    for (size_t i = 0; i < counts.size(); ++i) {
+      counts[i] += other.counts[i];
+    }
+  } else {
+    // Different layout, values are re-recorded at their bucket
+    for (size_t i = 0; i < other.counts.size(); ++i) {
+      if (other.counts[i]) {
+        int64_t value = std::min(other.get_value_from_index(i),
+                                 highest_trackable_value);
+        counts[get_counts_index(value)] += other.counts[i];
+      }
+    }
+  }
+  total_count += other.total_count;
+  if (other.total_count) {
+    min_value = std::min(min_value, other.min_value);
+    max_value = std::max(max_value, other.max_value);
+  }
+  sum += other.sum;
+}
+
+void S3PerfHistogram::reset() {
+  std::fill(counts.begin(), counts.end(), 0);
+  total_count = 0;
+  min_value = INT64_MAX;
+  max_value = 0;
+  sum = 0;
+}
+
+double S3PerfHistogram::get_stddev() const {
+  if (!total_count) {
+    return 0;
+  }
+  double mean = get_mean();
+  double deviation_sum = 0;
+  for (size_t i = 0; i < counts.size(); ++i) {
+    if (counts[i]) {
+      double deviation =
+          get_highest_equivalent_value(get_value_from_index(i)) - mean;
+      deviation_sum += deviation * deviation * counts[i];
+    }
+  }
+  return std::sqrt(deviation_sum / total_count);
+}
+
+int64_t S3PerfHistogram::get_value_at_percentile(double percentile) const {
+  if (!total_count) {
+    return 0;
+  }
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  int64_t count_at_percentile =
+      (int64_t)(percentile / 100 * total_count + 0.5);
+  count_at_percentile = std::max<int64_t>(count_at_percentile, 1);
+  int64_t running_count = 0;
+  for (size_t i = 0; i < counts.size(); ++i) {
+    running_count += counts[i];
+    if (running_count >= count_at_percentile) {
+      return std::min(get_highest_equivalent_value(get_value_from_index(i)),
+                      max_value);
+    }
+  }
+  return max_value;
+}
+
+void S3PerfHistogram::write_percentile_distribution(FILE* out,
+                                                    double value_scale) const {
+  fprintf(out, "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount",
+          "1/(1-Percentile)");
+  // Reporting steps get finer towards the tail, as in HdrHistogram
+  const int ticks_per_half_distance = 5;
+  double percentile = 0;
+  size_t index = 0;
+  int64_t running_count = 0;
+  while (total_count) {
+    int64_t count_at_percentile = std::max<int64_t>(
+        (int64_t)(percentile / 100 * total_count + 0.5), 1);
+    while (running_count < count_at_percentile && index < counts.size()) {
+      running_count += counts[index++];
+    }
+    int64_t value =
+        index ? std::min(get_highest_equivalent_value(
+                             get_value_from_index(index - 1)),
+                         max_value)
+              : 0;
+    double reported = (double)running_count / total_count;
+    if (running_count >= total_count) {
+      fprintf(out, "%12.3f %1.12f %10" PRId64 "\n", value / value_scale, 1.0,
+              running_count);
+      break;
+    }
+    fprintf(out, "%12.3f %1.12f %10" PRId64 " %14.2f\n", value / value_scale,
+            reported, running_count, 1 / (1 - reported));
+    double half_distance =
+        std::pow(2, std::floor(std::log2(100 / (100 - percentile))) + 1);
+    percentile += 100 / (ticks_per_half_distance * half_distance);
+    if (percentile < reported * 100) {
+      // Skip steps inside one bucket
+      percentile = reported * 100 + 100.0 / total_count / 2;
+    }
+  }
+  fprintf(out, "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n",
+          get_mean() / value_scale, get_stddev() / value_scale);
+  fprintf(out, "#[Max     = %12.3f, Total count    = %12" PRId64 "]\n",
+          get_max() / value_scale, total_count);
+  fprintf(out, "#[Buckets = %12d, SubBuckets     = %12d]\n", bucket_count,
+          sub_bucket_count);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_PERF_S3_PERF_HISTOGRAM_H__
+#define __S3_PERF_S3_PERF_HISTOGRAM_H__
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Latency histogram with the bucket layout of HdrHistogram: values are
+// kept with a fixed number of significant decimal digits over the whole
+// range, so high percentiles stay exact at any latency.
+class S3PerfHistogram {
+  int64_t highest_trackable_value;
+  int significant_digits;
+  int sub_bucket_half_count_magnitude;
+  int32_t sub_bucket_half_count;
+  int32_t sub_bucket_count;
+  int64_t sub_bucket_mask;
+  int32_t bucket_count;
+  std::vector<int64_t> counts;
+
+  int64_t total_count = 0;
+  int64_t min_value = INT64_MAX;
+  int64_t max_value = 0;
+  double sum = 0;
+
+  int32_t get_bucket_index(int64_t value) const;
+  size_t get_counts_index(int64_t value) const;
+  int64_t get_value_from_index(size_t index) const;
+  int64_t get_highest_equivalent_value(int64_t value) const;
+
+ public:
+  // Values above highest_trackable_value are recorded as that value
+  S3PerfHistogram(int64_t highest_trackable_value = 3600LL * 1000 * 1000,
+                  int significant_digits = 3);
+
+  void record(int64_t value);
+  void add(const S3PerfHistogram& other);
+  void reset();
+
+  int64_t get_total_count() const { return total_count; }
+  int64_t get_min() const { return total_count ? min_value : 0; }
+  int64_t get_max() const { return max_value; }
+  double get_mean() const { return total_count ? sum / total_count : 0; }
+  double get_stddev() const;
+  // percentile is 0..100
+  int64_t get_value_at_percentile(double percentile) const;
+
+  // Percentile distribution in the .hgrm format of HdrHistogram tools,
+  // values divided by value_scale
+  void write_percentile_distribution(FILE* out, double value_scale) const;
+};
+
+#endif  // __S3_PERF_S3_PERF_HISTOGRAM_H__
@@ -0,0 +1,676 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "s3_perf_load.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+// The server is expected to run with authentication disabled
+static const char* const AUTHORIZATION =
+    "AWS4-HMAC-SHA256 "
+    "Credential=v_accessKeyId/20160523/US/s3/aws4_request,SignedHeaders="
+    "content-length;content-type;host;x-amz-content-sha256;x-amz-date,"
+    "Signature="
+    "329ba550642531735976b2c19b7d49d7e084877a199e78ffb98f08f4ce61a3ba";
+static const char* const CHUNK_SIGNATURE =
+    "0000000000000000000000000000000000000000000000000000000000000000";
+
+typedef std::vector<std::pair<std::string, std::string>> Headers;
+
+static double to_ms(int64_t us) { return us / 1000.0; }
+
+S3PerfLoadGenerator::S3PerfLoadGenerator(evbase_t* evbase,
+                                         const S3PerfLoadConfig& config,
+                                         const S3PerfKeySpace& key_space)
+    : evbase(evbase),
+      config(config),
+      key_space(key_space),
+      rng(config.seed),
+      slots(std::max(config.concurrency, 1u)) {
+  for (auto& slot : slots) {
+    slot.generator = this;
+  }
+  if (this->config.body_pattern.empty()) {
+    // Incompressible data, at most 16 MB of it repeated in bodies
+    uint64_t pattern_size = std::min<uint64_t>(
+        std::max<uint64_t>(
+            std::max(config.sizes.get_max(), config.part_size), 1),
+        16ULL << 20);
+    this->config.body_pattern.resize(pattern_size);
+    std::mt19937_64 pattern_rng(config.seed);
+    for (auto& ch : this->config.body_pattern) {
+      ch = (char)pattern_rng();
+    }
+  }
+  if (!config.timeseries_csv.empty()) {
+    timeseries = fopen(config.timeseries_csv.c_str(), "w");
+    if (timeseries) {
+      fprintf(timeseries,
+              "time_sec,op,ops,ops_per_sec,mb_per_sec,errors,p50_ms,p99_ms,"
+              "max_ms\n");
+    } else {
+      fprintf(stderr, "Cannot open %s: %s\n", config.timeseries_csv.c_str(),
+              strerror(errno));
+    }
+  }
+  dispatch_event = event_new(evbase, -1, 0, on_dispatch, this);
+  arrival_timer = event_new(evbase, -1, EV_PERSIST, on_arrival_tick, this);
+  interval_timer = event_new(evbase, -1, EV_PERSIST, on_interval, this);
+}
+
+S3PerfLoadGenerator::~S3PerfLoadGenerator() {
+  for (auto& slot : slots) {
+    release_connection(slot);
+  }
+  event_free(dispatch_event);
+  event_free(arrival_timer);
+  event_free(interval_timer);
+  if (timeseries) {
+    fclose(timeseries);
+  }
+}
+
+uint64_t S3PerfLoadGenerator::run() {
+  start_phase(Phase::create_buckets);
+  event_base_loop(evbase, 0);
+  print_report();
+
+  uint64_t errors = 0;
+  for (const auto& op_stats : stats) {
+    errors += op_stats.second.errors;
+  }
+  return errors;
+}
+
+void S3PerfLoadGenerator::start_phase(Phase next_phase) {
+  Clock::time_point now = Clock::now();
+  if (phase == Phase::create_buckets || phase == Phase::prefill) {
+    if (phase_issued) {
+      printf("%s: %" PRIu64 " ops in %.3f s, %" PRIu64 " errors\n",
+             phase == Phase::create_buckets ? "create buckets" : "prefill",
+             phase_issued,
+             std::chrono::duration<double>(now - phase_start).count(),
+             phase_errors);
+    }
+  }
+  phase = next_phase;
+  phase_issued = 0;
+  phase_errors = 0;
+  phase_start = now;
+
+  if (phase == Phase::create_buckets && !config.create_buckets) {
+    start_phase(Phase::prefill);
+    return;
+  }
+  if (phase == Phase::prefill && !config.prefill) {
+    start_phase(Phase::run);
+    return;
+  }
+  if (phase == Phase::run) {
+    run_start = last_interval = now;
+    if (config.rate > 0) {
+      // Arrivals are checked every millisecond
+      struct timeval tick = {0, 1000};
+      evtimer_add(arrival_timer, &tick);
+      on_arrival_tick(-1, 0, this);
+    }
+    if (config.interval_sec > 0) {
+      struct timeval interval = {
+          (time_t)config.interval_sec,
+          (suseconds_t)((config.interval_sec - (time_t)config.interval_sec) *
+                        1000000)};
+      evtimer_add(interval_timer, &interval);
+    }
+  } else if (phase == Phase::done) {
+    run_end = now;
+    evtimer_del(arrival_timer);
+    evtimer_del(interval_timer);
+    event_base_loopbreak(evbase);
+    return;
+  }
+  event_active(dispatch_event, EV_TIMEOUT, 0);
+}
+
+bool S3PerfLoadGenerator::may_issue() const {
+  switch (phase) {
+    case Phase::create_buckets:
+      return phase_issued < key_space.get_bucket_count();
+    case Phase::prefill:
+      return phase_issued < key_space.get_key_count();
+    case Phase::run:
+      if (config.ops && phase_issued >= config.ops) {
+        return false;
+      }
+      return !config.duration_sec ||
+             std::chrono::duration<double>(Clock::now() - run_start).count() <
+                 config.duration_sec;
+    default:
+      return false;
+  }
+}
+
+void S3PerfLoadGenerator::dispatch() {
+  for (auto& slot : slots) {
+    if (slot.busy && slot.pending_step) {
+      slot.pending_step = false;
+      send_step(slot);
+    }
+  }
+  if (phase == Phase::done) {
+    return;
+  }
+  bool open_loop = phase == Phase::run && config.rate > 0;
+  for (auto& slot : slots) {
+    if (slot.busy) {
+      continue;
+    }
+    if (open_loop) {
+      if (backlog.empty()) {
+        break;
+      }
+      Clock::time_point intended_start = backlog.front();
+      backlog.pop_front();
+      start_op(slot, intended_start);
+    } else {
+      if (!may_issue()) {
+        break;
+      }
+      start_op(slot, Clock::now());
+    }
+  }
+
+  for (const auto& slot : slots) {
+    if (slot.busy) {
+      return;
+    }
+  }
+  if (may_issue() || (open_loop && !backlog.empty())) {
+    return;
+  }
+  start_phase(phase == Phase::create_buckets
+                  ? Phase::prefill
+                  : phase == Phase::prefill ? Phase::run : Phase::done);
+}
+
+void S3PerfLoadGenerator::start_op(Slot& slot,
+                                   Clock::time_point intended_start) {
+  Op op;
+  op.intended_start = intended_start;
+  uint64_t index;
+  if (phase == Phase::run && config.rate > 0) {
+    // Open loop counts its ops on arrival, this one was the oldest left
+    index = phase_issued - backlog.size() - 1;
+  } else {
+    index = phase_issued++;
+  }
+  switch (phase) {
+    case Phase::create_buckets:
+      op.type = S3PerfOpType::create_bucket;
+      op.key_index = index;
+      break;
+    case Phase::prefill:
+      op.type = S3PerfOpType::put;
+      op.key_index = index;
+      op.size = config.sizes.pick(rng);
+      break;
+    default:
+      op.type = config.mix.pick(rng);
+      op.key_index = config.sequential_keys ? index % key_space.get_key_count()
+                                            : key_space.pick(rng);
+      if (op.type == S3PerfOpType::put ||
+          op.type == S3PerfOpType::multipart) {
+        op.size = config.sizes.pick(rng);
+      }
+      break;
+  }
+  if (op.type == S3PerfOpType::put && config.multipart_threshold &&
+      op.size >= config.multipart_threshold && config.part_size) {
+    op.type = S3PerfOpType::multipart;
+  }
+  if (op.type == S3PerfOpType::multipart) {
+    op.step = Step::multipart_initiate;
+    // An empty object is still uploaded as one part
+    op.part_count = std::max<unsigned>(
+        1, (unsigned)((op.size + config.part_size - 1) / config.part_size));
+  }
+  slot.op = std::move(op);
+  slot.busy = true;
+  send_step(slot);
+}
+
+struct evbuffer* S3PerfLoadGenerator::make_body(uint64_t offset,
+                                                uint64_t size,
+                                                Headers& headers) {
+  struct evbuffer* body = evbuffer_new();
+  const std::string& pattern = config.body_pattern;
+  auto add_data = [&](uint64_t data_offset, uint64_t data_size) {
+    while (data_size) {
+      uint64_t pos = data_offset % pattern.size();
+      uint64_t len = std::min<uint64_t>(data_size, pattern.size() - pos);
+      evbuffer_add_reference(body, pattern.data() + pos, len, NULL, NULL);
+      data_offset += len;
+      data_size -= len;
+    }
+  };
+  if (config.chunked) {
+    // Chunk signatures are not checked with authentication disabled
+    for (uint64_t done = 0; done < size;) {
+      uint64_t len = std::min(config.chunk_size, size - done);
+      evbuffer_add_printf(body, "%" PRIx64 ";chunk-signature=%s\r\n", len,
+                          CHUNK_SIGNATURE);
+      add_data(offset + done, len);
+      evbuffer_add(body, "\r\n", 2);
+      done += len;
+    }
+    evbuffer_add_printf(body, "0;chunk-signature=%s\r\n\r\n", CHUNK_SIGNATURE);
+    headers.emplace_back("Content-Encoding", "aws-chunked");
+    headers.emplace_back("x-amz-content-sha256",
+                         "STREAMING-AWS4-HMAC-SHA256-PAYLOAD");
+    headers.emplace_back("x-amz-decoded-content-length",
+                         std::to_string(size));
+  } else {
+    add_data(offset, size);
+    headers.emplace_back("x-amz-content-sha256", "UNSIGNED-PAYLOAD");
+  }
+  headers.emplace_back("Content-Type", "application/octet-stream");
+  return body;
+}
+
+void S3PerfLoadGenerator::send_step(Slot& slot) {
+  Op& op = slot.op;
+  Headers headers;
+  struct evbuffer* body = nullptr;
+  htp_method method = htp_method_GET;
+  std::string uri = key_space.get_uri(op.key_index);
+
+  switch (op.type) {
+    case S3PerfOpType::create_bucket:
+      method = htp_method_PUT;
+      uri = "/" + key_space.get_bucket((unsigned)op.key_index);
+      break;
+    case S3PerfOpType::put:
+      method = htp_method_PUT;
+      body = make_body(0, op.size, headers);
+      break;
+    case S3PerfOpType::get:
+      break;
+    case S3PerfOpType::head:
+      method = htp_method_HEAD;
+      break;
+    case S3PerfOpType::del:
+      method = htp_method_DELETE;
+      break;
+    case S3PerfOpType::list:
+      uri = "/" + key_space.get_bucket_of(op.key_index) + "?prefix=" +
+            key_space.get_key_prefix() + "&max-keys=" +
+            std::to_string(config.list_max_keys);
+      break;
+    case S3PerfOpType::multipart:
+      if (op.step == Step::multipart_initiate) {
+        method = htp_method_POST;
+        uri += "?uploads";
+      } else if (op.step == Step::multipart_part) {
+        uint64_t offset = (uint64_t)(op.part_number - 1) * config.part_size;
+        method = htp_method_PUT;
+        uri += "?partNumber=" + std::to_string(op.part_number) +
+               "&uploadId=" + op.upload_id;
+        body = make_body(offset, std::min(config.part_size, op.size - offset),
+                         headers);
+      } else {
+        method = htp_method_POST;
+        uri += "?uploadId=" + op.upload_id;
+        body = evbuffer_new();
+        evbuffer_add_printf(body, "<CompleteMultipartUpload>");
+        for (size_t i = 0; i < op.etags.size(); ++i) {
+          evbuffer_add_printf(body,
+                              "<Part><PartNumber>%zu</PartNumber>"
+                              "<ETag>%s</ETag></Part>",
+                              i + 1, op.etags[i].c_str());
+        }
+        evbuffer_add_printf(body, "</CompleteMultipartUpload>");
+        headers.emplace_back("Content-Type", "application/xml");
+      }
+      break;
+    default:
+      break;
+  }
+  send_request(slot, method, uri, headers, body);
+}
+
+void S3PerfLoadGenerator::send_request(Slot& slot, htp_method method,
+                                       const std::string& uri,
+                                       const Headers& headers,
+                                       struct evbuffer* body) {
+  if (slot.drop_conn) {
+    release_connection(slot);
+  }
+  if (!slot.conn) {
+    slot.conn =
+        evhtp_connection_new(evbase, config.host.c_str(), config.port);
+    if (!slot.conn) {
+      fprintf(stderr, "Cannot connect to %s:%d\n", config.host.c_str(),
+              config.port);
+      if (body) {
+        evbuffer_free(body);
+      }
+      step_done(slot, 0);
+      return;
+    }
+    evhtp_set_hook(&slot.conn->hooks, evhtp_hook_on_conn_error,
+                   (evhtp_hook)on_conn_error, &slot);
+  }
+  // Previous response on the connection is done with
+  if (slot.conn->request) {
+    evhtp_request_free(slot.conn->request);
+    slot.conn->request = NULL;
+  }
+  evhtp_request_t* req = evhtp_request_new(on_request_done, &slot);
+  evhtp_set_hook(&req->hooks, evhtp_hook_on_headers,
+                 (evhtp_hook)on_response_headers, &slot);
+  evhtp_set_hook(&req->hooks, evhtp_hook_on_read,
+                 (evhtp_hook)on_response_data, &slot);
+
+  auto add_header = [req](const std::string& key, const std::string& val) {
+    evhtp_headers_add_header(req->headers_out,
+                             evhtp_header_new(key.c_str(), val.c_str(), 1, 1));
+  };
+  add_header("Host", config.host_header);
+  add_header("Authorization", AUTHORIZATION);
+  add_header("x-amz-date", "20160523T055836Z");
+  add_header("Accept-Encoding", "identity");
+  if (!config.keepalive) {
+    add_header("Connection", "close");
+  }
+  for (const auto& header : headers) {
+    add_header(header.first, header.second);
+  }
+  if (body || method == htp_method_PUT || method == htp_method_POST) {
+    add_header("Content-Length",
+               std::to_string(body ? evbuffer_get_length(body) : 0));
+  }
+
+  slot.request = req;
+  slot.op.response_body.clear();
+  evhtp_make_request(slot.conn, req, method, uri.c_str());
+  if (body) {
+    evhtp_send_reply_body(req, body);
+    evbuffer_free(body);
+  }
+}
+
+void S3PerfLoadGenerator::release_connection(Slot& slot) {
+  if (slot.conn) {
+    evhtp_unset_all_hooks(&slot.conn->hooks);
+    if (slot.conn->request) {
+      evhtp_unset_all_hooks(&slot.conn->request->hooks);
+    }
+    evhtp_connection_free(slot.conn);
+    slot.conn = nullptr;
+  }
+  slot.request = nullptr;
+  slot.drop_conn = false;
+}
+
+void S3PerfLoadGenerator::step_done(Slot& slot, int status) {
+  Op& op = slot.op;
+  slot.request = nullptr;
+  if (!config.keepalive) {
+    slot.drop_conn = true;
+  }
+  if (op.type != S3PerfOpType::multipart || status / 100 != 2 ||
+      op.step == Step::multipart_complete) {
+    op_done(slot, status);
+    return;
+  }
+  if (op.step == Step::multipart_initiate) {
+    const std::string& xml = op.response_body;
+    size_t begin = xml.find("<UploadId>");
+    size_t end = xml.find("</UploadId>");
+    if (begin == std::string::npos || end == std::string::npos) {
+      fprintf(stderr, "No UploadId in the reply to %s\n",
+              key_space.get_uri(op.key_index).c_str());
+      op_done(slot, 0);
+      return;
+    }
+    begin += strlen("<UploadId>");
+    op.upload_id = xml.substr(begin, end - begin);
+    op.step = Step::multipart_part;
+    op.part_number = 1;
+  } else {
+    op.etags.push_back(op.last_etag);
+    if (op.part_number < op.part_count) {
+      ++op.part_number;
+    } else {
+      op.step = Step::multipart_complete;
+    }
+  }
+  // Not from within the callbacks of the connection
+  slot.pending_step = true;
+  event_active(dispatch_event, EV_TIMEOUT, 0);
+}
+
+void S3PerfLoadGenerator::op_done(Slot& slot, int status) {
+  Op& op = slot.op;
+  int64_t latency_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                           Clock::now() - op.intended_start).count();
+  bool failed = status < 200 || status >= 300;
+
+  if (phase == Phase::run) {
+    OpStats& op_stats = stats[op.type];
+    op_stats.latency.record(latency_us);
+    op_stats.interval_latency.record(latency_us);
+    uint64_t bytes =
+        op.type == S3PerfOpType::put || op.type == S3PerfOpType::multipart
+            ? op.size
+            : op.bytes_received;
+    ++op_stats.ops;
+    ++op_stats.interval_ops;
+    op_stats.bytes += bytes;
+    op_stats.interval_bytes += bytes;
+    if (failed) {
+      ++op_stats.errors;
+      ++op_stats.interval_errors;
+    }
+    ++op_stats.status_classes[std::min(std::max(status / 100, 0), 5)];
+  } else if (failed) {
+    ++phase_errors;
+  }
+  if (config.print_each_op) {
+    printf("%s %s status = %d, response_time_ms = %.3f\n",
+           s3_perf_op_name(op.type), key_space.get_uri(op.key_index).c_str(),
+           status, to_ms(latency_us));
+  }
+  slot.busy = false;
+  event_active(dispatch_event, EV_TIMEOUT, 0);
+}
+
+void S3PerfLoadGenerator::on_request_done(evhtp_request_t* req, void* arg) {
+  Slot* slot = (Slot*)arg;
+  if (slot->request != req) {
+    // Already done at its headers
+    return;
+  }
+  if (slot->op.type == S3PerfOpType::multipart) {
+    const char* etag = evhtp_header_find(req->headers_in, "ETag");
+    slot->op.last_etag = etag ? etag : "";
+  }
+  slot->generator->step_done(*slot, evhtp_request_status(req));
+}
+
+evhtp_res S3PerfLoadGenerator::on_response_headers(evhtp_request_t* req,
+                                                   evhtp_headers_t* hdrs,
+                                                   void* arg) {
+  Slot* slot = (Slot*)arg;
+  if (slot->request == req && slot->op.type == S3PerfOpType::head) {
+    // The reply has Content-Length but no body, so the parser of the
+    // connection is left waiting for it
+    slot->drop_conn = true;
+    slot->generator->step_done(*slot, evhtp_request_status(req));
+  }
+  return EVHTP_RES_OK;
+}
+
+evhtp_res S3PerfLoadGenerator::on_response_data(evhtp_request_t* req,
+                                                evbuf_t* buf, void* arg) {
+  Slot* slot = (Slot*)arg;
+  size_t len = evbuffer_get_length(buf);
+  if (slot->request == req) {
+    slot->op.bytes_received += len;
+    if (slot->op.type == S3PerfOpType::multipart) {
+      size_t old_size = slot->op.response_body.size();
+      slot->op.response_body.resize(old_size + len);
+      evbuffer_copyout(buf, &slot->op.response_body[old_size], len);
+    }
+  }
+  // Bodies are not kept
+  evbuffer_drain(buf, len);
+  return EVHTP_RES_OK;
+}
+
+evhtp_res S3PerfLoadGenerator::on_conn_error(evhtp_connection_t* conn,
+                                             evhtp_error_flags errtype,
+                                             void* arg) {
+  Slot* slot = (Slot*)arg;
+  if (slot->conn != conn) {
+    return EVHTP_RES_OK;
+  }
+  // evhtp frees the connection
+  slot->conn = nullptr;
+  slot->drop_conn = false;
+  if (slot->request) {
+    fprintf(stderr, "Connection error %d on %s\n", (int)errtype,
+            s3_perf_op_name(slot->op.type));
+    slot->generator->step_done(*slot, 0);
+  }
+  return EVHTP_RES_OK;
+}
+
+void S3PerfLoadGenerator::on_dispatch(evutil_socket_t, short, void* arg) {
+  ((S3PerfLoadGenerator*)arg)->dispatch();
+}
+
+void S3PerfLoadGenerator::on_arrival_tick(evutil_socket_t, short, void* arg) {
+  S3PerfLoadGenerator* generator = (S3PerfLoadGenerator*)arg;
+  if (generator->phase != Phase::run) {
+    return;
+  }
+  double elapsed =
+      std::chrono::duration<double>(Clock::now() - generator->run_start)
+          .count();
+  uint64_t due = (uint64_t)(elapsed * generator->config.rate) + 1;
+  while (generator->arrivals < due && generator->may_issue()) {
+    auto offset = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(generator->arrivals /
+                                      generator->config.rate));
+    generator->backlog.push_back(generator->run_start + offset);
+    ++generator->arrivals;
+    ++generator->phase_issued;
+  }
+  generator->dispatch();
+}
+
+void S3PerfLoadGenerator::on_interval(evutil_socket_t, short, void* arg) {
+  ((S3PerfLoadGenerator*)arg)->print_interval();
+}
+
+void S3PerfLoadGenerator::print_interval() {
+  Clock::time_point now = Clock::now();
+  double seconds = std::chrono::duration<double>(now - last_interval).count();
+  double elapsed = std::chrono::duration<double>(now - run_start).count();
+  last_interval = now;
+  if (seconds <= 0) {
+    return;
+  }
+  for (auto& op_stats : stats) {
+    OpStats& st = op_stats.second;
+    const char* name = s3_perf_op_name(op_stats.first);
+    double ops_per_sec = st.interval_ops / seconds;
+    double mb_per_sec = st.interval_bytes / seconds / (1 << 20);
+    double p50 = to_ms(st.interval_latency.get_value_at_percentile(50));
+    double p99 = to_ms(st.interval_latency.get_value_at_percentile(99));
+    double max_ms = to_ms(st.interval_latency.get_max());
+    printf(
+        "[%8.1fs] %-9s %9.1f ops/s %9.2f MB/s p50 %9.3f ms p99 %9.3f ms "
+        "max %9.3f ms errors %" PRIu64 "%s\n",
+        elapsed, name, ops_per_sec, mb_per_sec, p50, p99, max_ms,
+        st.interval_errors,
+        backlog.empty() ? "" : (" backlog " + std::to_string(backlog.size()))
+                                   .c_str());
+    if (timeseries) {
+      fprintf(timeseries,
+              "%.3f,%s,%" PRIu64 ",%.3f,%.3f,%" PRIu64 ",%.3f,%.3f,%.3f\n",
+              elapsed, name, st.interval_ops, ops_per_sec, mb_per_sec,
+              st.interval_errors, p50, p99, max_ms);
+    }
+    st.interval_latency.reset();
+    st.interval_ops = st.interval_bytes = st.interval_errors = 0;
+  }
+  if (timeseries) {
+    fflush(timeseries);
+  }
+  fflush(stdout);
+}
+
+void S3PerfLoadGenerator::print_report() {
+  if (phase != Phase::done) {
+    return;
+  }
+  if (config.interval_sec > 0) {
+    print_interval();
+  }
+  double seconds = std::chrono::duration<double>(run_end - run_start).count();
+  printf("\nRun of %.3f s, %s loop with %zu connections\n", seconds,
+         config.rate > 0 ? "open" : "closed", slots.size());
+  for (const auto& op_stats : stats) {
+    const OpStats& st = op_stats.second;
+    const S3PerfHistogram& latency = st.latency;
+    const char* name = s3_perf_op_name(op_stats.first);
+    printf(
+        "%-9s ops %" PRIu64 ", errors %" PRIu64 ", %.1f ops/s, %.2f MB/s\n"
+        "          latency ms: min %.3f mean %.3f p50 %.3f p90 %.3f "
+        "p99 %.3f p99.9 %.3f max %.3f\n"
+        "          replies: 2xx %" PRIu64 " 3xx %" PRIu64 " 4xx %" PRIu64
+        " 5xx %" PRIu64 " failed %" PRIu64 "\n",
+        name, st.ops, st.errors, seconds > 0 ? st.ops / seconds : 0,
+        seconds > 0 ? st.bytes / seconds / (1 << 20) : 0,
+        to_ms(latency.get_min()), latency.get_mean() / 1000,
+        to_ms(latency.get_value_at_percentile(50)),
+        to_ms(latency.get_value_at_percentile(90)),
+        to_ms(latency.get_value_at_percentile(99)),
+        to_ms(latency.get_value_at_percentile(99.9)),
+        to_ms(latency.get_max()), st.status_classes[2], st.status_classes[3],
+        st.status_classes[4], st.status_classes[5],
+        st.status_classes[0] + st.status_classes[1]);
+    if (!config.hgrm_prefix.empty()) {
+      std::string path = config.hgrm_prefix + name + ".hgrm";
+      FILE* out = fopen(path.c_str(), "w");
+      if (out) {
+        // Milliseconds, as HdrHistogram plotters expect
+        latency.write_percentile_distribution(out, 1000.0);
+        fclose(out);
+      } else {
+        fprintf(stderr, "Cannot open %s: %s\n", path.c_str(),
+                strerror(errno));
+      }
+    }
+  }
+}
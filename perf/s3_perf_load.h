@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_PERF_S3_PERF_LOAD_H__
+#define __S3_PERF_S3_PERF_LOAD_H__
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <evhtp.h>
+
+#include "s3_perf_histogram.h"
+#include "s3_perf_workload.h"
+
+struct S3PerfLoadConfig {
+  std::string host = "127.0.0.1";
+  int port = 80;
+  std::string host_header = "s3.seagate.com";
+
+  S3PerfOpMix mix;
+  S3PerfSizeDist sizes;
+  // Request bodies are made of this data, repeated
+  std::string body_pattern;
+
+  // Requests in flight at most; each has its own connection
+  unsigned concurrency = 1;
+  // Open loop arrivals per second, 0 for closed loop
+  double rate = 0;
+  // Stop after this many ops or seconds, 0 for no limit
+  uint64_t ops = 0;
+  double duration_sec = 0;
+
+  // PUTs of at least this size are multipart uploads, 0 to disable
+  uint64_t multipart_threshold = 0;
+  uint64_t part_size = 5ULL << 20;
+  // PUT bodies in aws-chunked encoding with chunks of chunk_size
+  bool chunked = false;
+  uint64_t chunk_size = 64ULL << 10;
+  unsigned list_max_keys = 1000;
+
+  // Keys in order instead of random picks
+  bool sequential_keys = false;
+  bool keepalive = true;
+  bool create_buckets = false;
+  // PUT every key of the key space before the measured run
+  bool prefill = false;
+  bool print_each_op = false;
+
+  double interval_sec = 1;
+  std::string timeseries_csv;
+  std::string hgrm_prefix;
+  uint64_t seed = 1;
+};
+
+// Load generator over evhtp client connections. Closed loop keeps every
+// connection busy; open loop starts ops at the given rate and measures
+// latency from the intended start, so a slow server cannot hide its queue
+// from the histograms.
+class S3PerfLoadGenerator {
+  typedef std::chrono::steady_clock Clock;
+
+  enum class Phase {
+    create_buckets,
+    prefill,
+    run,
+    done
+  };
+
+  enum class Step {
+    single,
+    multipart_initiate,
+    multipart_part,
+    multipart_complete
+  };
+
+  struct OpStats {
+    S3PerfHistogram latency;
+    S3PerfHistogram interval_latency;
+    uint64_t ops = 0;
+    uint64_t bytes = 0;
+    uint64_t errors = 0;
+    uint64_t interval_ops = 0;
+    uint64_t interval_bytes = 0;
+    uint64_t interval_errors = 0;
+    // 1xx..5xx replies, [0] for connection errors
+    uint64_t status_classes[6] = {};
+  };
+
+  struct Op {
+    S3PerfOpType type;
+    uint64_t key_index = 0;
+    uint64_t size = 0;
+    Clock::time_point intended_start;
+    Step step = Step::single;
+    std::string upload_id;
+    unsigned part_count = 0;
+    unsigned part_number = 0;
+    std::vector<std::string> etags;
+    std::string last_etag;
+    std::string response_body;
+    uint64_t bytes_received = 0;
+  };
+
+  struct Slot {
+    S3PerfLoadGenerator* generator;
+    evhtp_connection_t* conn = nullptr;
+    // Request of the op step in flight
+    evhtp_request_t* request = nullptr;
+    bool busy = false;
+    // Connection cannot take another request, freed before the next one
+    bool drop_conn = false;
+    // Next step of a multipart upload is sent from the dispatcher
+    bool pending_step = false;
+    Op op;
+  };
+
+  evbase_t* evbase;
+  S3PerfLoadConfig config;
+  S3PerfKeySpace key_space;
+  std::mt19937_64 rng;
+
+  std::vector<Slot> slots;
+  Phase phase = Phase::create_buckets;
+  uint64_t phase_issued = 0;
+  uint64_t phase_errors = 0;
+  Clock::time_point phase_start;
+  Clock::time_point run_start;
+  Clock::time_point run_end;
+  Clock::time_point last_interval;
+
+  // Open loop: intended starts of ops waiting for a connection
+  std::deque<Clock::time_point> backlog;
+  uint64_t arrivals = 0;
+
+  std::map<S3PerfOpType, OpStats> stats;
+  FILE* timeseries = nullptr;
+
+  struct event* dispatch_event = nullptr;
+  struct event* arrival_timer = nullptr;
+  struct event* interval_timer = nullptr;
+
+  void start_phase(Phase next_phase);
+  bool may_issue() const;
+  void dispatch();
+  void start_op(Slot& slot, Clock::time_point intended_start);
+  void send_step(Slot& slot);
+  void send_request(Slot& slot, htp_method method, const std::string& uri,
+                    const std::vector<std::pair<std::string, std::string>>&
+                        headers,
+                    struct evbuffer* body);
+  struct evbuffer* make_body(uint64_t offset, uint64_t size,
+                             std::vector<std::pair<std::string, std::string>>&
+                                 headers);
+  void step_done(Slot& slot, int status);
+  void op_done(Slot& slot, int status);
+  void release_connection(Slot& slot);
+
+  void print_interval();
+  void print_report();
+
+  static void on_request_done(evhtp_request_t* req, void* arg);
+  static evhtp_res on_response_headers(evhtp_request_t* req,
+                                       evhtp_headers_t* hdrs, void* arg);
+  static evhtp_res on_response_data(evhtp_request_t* req, evbuf_t* buf,
+                                    void* arg);
+  static evhtp_res on_conn_error(evhtp_connection_t* conn,
+                                 evhtp_error_flags errtype, void* arg);
+  static void on_dispatch(evutil_socket_t, short, void* arg);
+  static void on_arrival_tick(evutil_socket_t, short, void* arg);
+  static void on_interval(evutil_socket_t, short, void* arg);
+
+ public:
+  S3PerfLoadGenerator(evbase_t* evbase, const S3PerfLoadConfig& config,
+                      const S3PerfKeySpace& key_space);
+  ~S3PerfLoadGenerator();
+
+  S3PerfLoadGenerator(const S3PerfLoadGenerator&) = delete;
+  S3PerfLoadGenerator& operator=(const S3PerfLoadGenerator&) = delete;
+
+  // Runs the event loop until the load is done, returns the number of
+  // failed ops of the measured run
+  uint64_t run();
+};
+
+#endif  // __S3_PERF_S3_PERF_LOAD_H__
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "s3_perf_workload.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+const char* s3_perf_op_name(S3PerfOpType op) {
+  switch (op) {
+    case S3PerfOpType::put:
+      return "put";
+    case S3PerfOpType::get:
+      return "get";
+    case S3PerfOpType::head:
+      return "head";
+    case S3PerfOpType::del:
+      return "delete";
+    case S3PerfOpType::list:
+      return "list";
+    case S3PerfOpType::multipart:
+      return "multipart";
+    case S3PerfOpType::create_bucket:
+      return "create_bucket";
+    default:
+      return "unknown";
+  }
+}
+
+static std::vector<std::string> split(const std::string& text, char sep) {
+  std::vector<std::string> parts;
+  std::istringstream in(text);
+  std::string part;
+  while (std::getline(in, part, sep)) {
+    if (!part.empty()) {
+      parts.push_back(part);
+    }
+  }
+  return parts;
+}
+
+// "<item>:<weight>", weight is 1 if not given
+static bool split_weight(const std::string& text, std::string& item,
+                         unsigned& weight) {
+  size_t colon = text.find(':');
+  item = text.substr(0, colon);
+  weight = 1;
+  if (colon != std::string::npos) {
+    char* end = nullptr;
+    unsigned long value = strtoul(text.c_str() + colon + 1, &end, 10);
+    if (*end != '\0' || colon + 1 == text.size()) {
+      return false;
+    }
+    weight = (unsigned)value;
+  }
+  return !item.empty();
+}
+
+bool S3PerfOpMix::parse(const std::string& spec, std::string& error) {
+  weights.clear();
+  total_weight = 0;
+  for (const auto& part : split(spec, ',')) {
+    std::string name;
+    unsigned weight;
+    if (!split_weight(part, name, weight)) {
+      error = "bad op weight '" + part + "'";
+      return false;
+    }
+    S3PerfOpType op = S3PerfOpType::count;
+    for (int i = 0; i < (int)S3PerfOpType::count; ++i) {
+      if (name == s3_perf_op_name((S3PerfOpType)i)) {
+        op = (S3PerfOpType)i;
+      }
+    }
+    if (op == S3PerfOpType::count || op == S3PerfOpType::create_bucket) {
+      error = "unknown op '" + name + "'";
+      return false;
+    }
+    if (weight) {
+      weights.emplace_back(op, weight);
+      total_weight += weight;
+    }
+  }
+  if (!total_weight) {
+    error = "no ops in '" + spec + "'";
+    return false;
+  }
+  return true;
+}
+
+S3PerfOpType S3PerfOpMix::pick(std::mt19937_64& rng) const {
+  unsigned point = std::uniform_int_distribution<unsigned>(
+      0, total_weight - 1)(rng);
+  for (const auto& weight : weights) {
+    if (point < weight.second) {
+      return weight.first;
+    }
+    point -= weight.second;
+  }
+  return weights.back().first;
+}
+
+bool S3PerfOpMix::has(S3PerfOpType op) const {
+  for (const auto& weight : weights) {
+    if (weight.first == op) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool s3_perf_parse_size(const std::string& text, uint64_t& size) {
+  char* end = nullptr;
+  double value = strtod(text.c_str(), &end);
+  if (end == text.c_str() || value < 0) {
+    return false;
+  }
+  uint64_t unit = 1;
+  std::string suffix(end);
+  if (suffix == "k" || suffix == "K" || suffix == "kb" || suffix == "KB") {
+    unit = 1ULL << 10;
+  } else if (suffix == "m" || suffix == "M" || suffix == "mb" ||
+             suffix == "MB") {
+    unit = 1ULL << 20;
+  } else if (suffix == "g" || suffix == "G" || suffix == "gb" ||
+             suffix == "GB") {
+    unit = 1ULL << 30;
+  } else if (!suffix.empty() && suffix != "b" && suffix != "B") {
+    return false;
+  }
+  size = (uint64_t)(value * unit);
+  return true;
+}
+
+bool S3PerfSizeDist::parse(const std::string& spec, std::string& error) {
+  weights.clear();
+  total_weight = 0;
+  range_min = range_max = 0;
+  size_t dash = spec.find('-');
+  if (dash != std::string::npos && spec.find(',') == std::string::npos) {
+    if (!s3_perf_parse_size(spec.substr(0, dash), range_min) ||
+        !s3_perf_parse_size(spec.substr(dash + 1), range_max) ||
+        range_min > range_max) {
+      error = "bad size range '" + spec + "'";
+      return false;
+    }
+    return true;
+  }
+  for (const auto& part : split(spec, ',')) {
+    std::string text;
+    unsigned weight;
+    uint64_t size;
+    if (!split_weight(part, text, weight) || !s3_perf_parse_size(text, size)) {
+      error = "bad size '" + part + "'";
+      return false;
+    }
+    if (weight) {
+      weights.emplace_back(size, weight);
+      total_weight += weight;
+    }
+  }
+  if (!total_weight) {
+    error = "no sizes in '" + spec + "'";
+    return false;
+  }
+  return true;
+}
+
+uint64_t S3PerfSizeDist::pick(std::mt19937_64& rng) const {
+  if (!total_weight) {
+    return std::uniform_int_distribution<uint64_t>(range_min, range_max)(rng);
+  }
+  unsigned point = std::uniform_int_distribution<unsigned>(
+      0, total_weight - 1)(rng);
+  for (const auto& weight : weights) {
+    if (point < weight.second) {
+      return weight.first;
+    }
+    point -= weight.second;
+  }
+  return weights.back().first;
+}
+
+uint64_t S3PerfSizeDist::get_max() const {
+  uint64_t max_size = range_max;
+  for (const auto& weight : weights) {
+    max_size = std::max(max_size, weight.first);
+  }
+  return max_size;
+}
+
+S3PerfKeySpace::S3PerfKeySpace(const std::string& bucket,
+                               unsigned bucket_count,
+                               const std::string& key_prefix,
+                               uint64_t key_count)
+    : bucket(bucket),
+      bucket_count(bucket_count ? bucket_count : 1),
+      key_prefix(key_prefix),
+      key_count(key_count ? key_count : 1) {}
+
+std::string S3PerfKeySpace::get_bucket(unsigned index) const {
+  if (bucket_count == 1) {
+    return bucket;
+  }
+  return bucket + "-" + std::to_string(index);
+}
+
+std::string S3PerfKeySpace::get_bucket_of(uint64_t key_index) const {
+  return get_bucket((unsigned)(key_index % bucket_count));
+}
+
+std::string S3PerfKeySpace::get_key(uint64_t key_index) const {
+  return key_prefix + std::to_string(key_index);
+}
+
+std::string S3PerfKeySpace::get_uri(uint64_t key_index) const {
+  return "/" + get_bucket_of(key_index) + "/" + get_key(key_index);
+}
+
+uint64_t S3PerfKeySpace::pick(std::mt19937_64& rng) const {
+  return std::uniform_int_distribution<uint64_t>(0, key_count - 1)(rng);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_PERF_S3_PERF_WORKLOAD_H__
+#define __S3_PERF_S3_PERF_WORKLOAD_H__
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum class S3PerfOpType {
+  put,
+  get,
+  head,
+  del,
+  list,
+  // Whole multipart upload, initiate to complete
+  multipart,
+  create_bucket,
+  count
+};
+
+const char* s3_perf_op_name(S3PerfOpType op);
+
+// Weighted choice of ops, from "put:50,get:40,delete:10"
+class S3PerfOpMix {
+  std::vector<std::pair<S3PerfOpType, unsigned>> weights;
+  unsigned total_weight = 0;
+
+ public:
+  // Returns false and sets error on a bad spec
+  bool parse(const std::string& spec, std::string& error);
+  S3PerfOpType pick(std::mt19937_64& rng) const;
+  bool empty() const { return total_weight == 0; }
+  bool has(S3PerfOpType op) const;
+};
+
+// Object sizes: "1m" fixed, "4k-1m" uniform or "4k:70,1m:25,64m:5" weighted
+class S3PerfSizeDist {
+  std::vector<std::pair<uint64_t, unsigned>> weights;
+  unsigned total_weight = 0;
+  uint64_t range_min = 0;
+  uint64_t range_max = 0;
+
+ public:
+  bool parse(const std::string& spec, std::string& error);
+  uint64_t pick(std::mt19937_64& rng) const;
+  uint64_t get_max() const;
+};
+
+// "64", "4k", "16m", "1g" in bytes, units are powers of 1024
+bool s3_perf_parse_size(const std::string& text, uint64_t& size);
+
+// Keys "<key_prefix><n>" spread over buckets "<bucket>" or
+// "<bucket>-<n % bucket_count>"
+class S3PerfKeySpace {
+  std::string bucket;
+  unsigned bucket_count;
+  std::string key_prefix;
+  uint64_t key_count;
+
+ public:
+  S3PerfKeySpace(const std::string& bucket, unsigned bucket_count,
+                 const std::string& key_prefix, uint64_t key_count);
+
+  uint64_t get_key_count() const { return key_count; }
+  unsigned get_bucket_count() const { return bucket_count; }
+
+  std::string get_bucket(unsigned index) const;
+  std::string get_bucket_of(uint64_t key_index) const;
+  std::string get_key(uint64_t key_index) const;
+  std::string get_key_prefix() const { return key_prefix; }
+  // "/<bucket>/<key>"
+  std::string get_uri(uint64_t key_index) const;
+  uint64_t pick(std::mt19937_64& rng) const;
+};
+
+#endif  // __S3_PERF_S3_PERF_WORKLOAD_H__
@@ -19,30 +19,42 @@
  */
 
 /*
+   The server must run with authentication disabled, requests carry a fixed
+   Authorization header.
+
    Usage examples:
    # Below example tries to upload 10 objects of size 1 GB each to s3 host
    # Uploads are triggered in parallel.
    ./s3perfclient -s3host '192.168.2.128' -upload_size_mb=1024 -uploadurl "/seagatebucket1/OneGBfile0" -s3port 80 -uploadcount 10
 
+   # Fill 10000 keys of 4k..1m, then 60 s of a mixed load over 64
+   # connections, with latency histograms per op type.
+   ./s3perfclient -s3host 127.0.0.1 -bucket perfbucket -create_buckets \
+     -key_count 10000 -sizes 4k-1m -prefill -mix put:30,get:60,head:5,list:5 \
+     -concurrency 64 -duration_sec 60 -hgrm_prefix /tmp/s3perf-
+
+   # Open loop of 500 GETs/s; latency is measured from the intended start of
+   # each op, so queueing in the server shows up in the percentiles.
+   ./s3perfclient -bucket perfbucket -key_count 10000 -mix get:100 \
+     -rate 500 -concurrency 256 -duration_sec 120 -timeseries_csv get.csv
+
+   # 256 MB multipart uploads with 16 MB parts in aws-chunked encoding.
+   ./s3perfclient -bucket perfbucket -mix multipart:100 -sizes 256m \
+     -part_size 16m -chunked -ops 20 -concurrency 4
  */
 
 #include <stdio.h>
 #include <stdlib.h>
-// #include <string.h>
-#include <stdint.h>
-#include <errno.h>
 
 #include <fstream>
+#include <iterator>
 #include <string>
-#include <vector>
-
-#define __STDC_FORMAT_MACROS
-#include <inttypes.h>
 
 #include <evhtp.h>
 #include <gflags/gflags.h>
 
-#include "s3_timer.h"
+#include "s3_perf_load.h"
+#include "s3_perf_workload.h"
 
 // CLI args
 
@@ -50,156 +62,155 @@ DEFINE_string(s3host, "127.0.0.1",
                  "s3 server host ip");
 DEFINE_int32(s3port, 80,
                 "s3 server port numnber");
+DEFINE_string(host_header, "s3.seagate.com", "Host header of the requests");
 DEFINE_string(uploadfile, "/tmp/OneMBfile",
-                "File to upload to s3 server");
+                "File with the data of request bodies, random data if "
+                "it cannot be read");
 DEFINE_string(uploadurl, "/seagatebucket/OneMBfile",
-                "URL for upload");
+                "URL for upload, used when -mix is not given");
 DEFINE_int64(upload_size_mb, 1,
-                "upload size in mb");
+                "upload size in mb, used when -mix is not given");
 DEFINE_int64(uploadcount, 1,
-                "Number of uploads");
-
-class S3ClientRequest {
-public:
-  evhtp_connection_t *conn;
-  evhtp_request_t    *request;
-  struct evbuffer* body_buffer;
-  S3Timer timer;
-};
-
-/*
-static void
-request_cb(evhtp_request_t * req, void * arg) {
-    printf("hi %zu\n", evbuffer_get_length(req->buffer_in));
-}
-
-static int
-output_header(evhtp_header_t * header, void * arg) {
-    printf("print_response_headers() key = '%s', val = '%s'\n",
-                        header->key, header->val);
-    return 0;
-}
-*/
-
-static evhtp_res
-print_response_headers(evhtp_request_t * req, evhtp_headers_t * hdrs, void * arg ) {
-  S3ClientRequest* client_request = (S3ClientRequest*)req->cbarg;
-  client_request->timer.stop();
-
-  printf("put_request_response_time_ms = %zu,", client_request->timer.elapsed_time_in_millisec());
-
-  unsigned int resp_status = evhtp_request_status(req);
-  printf("response status = %u\n", resp_status);
-
-  // evhtp_headers_for_each(hdrs, output_header, NULL);
-  return EVHTP_RES_OK;
-}
-
-void setup_request_headers(evhtp_request_t* request, struct evbuffer* buf) {
-  evhtp_headers_add_header(request->headers_out,
-                           evhtp_header_new("Accept-Encoding", "identity", 0, 0));
-  evhtp_headers_add_header(request->headers_out,
-                           evhtp_header_new("Authorization", "AWS4-HMAC-SHA256 Credential=v_accessKeyId/20160523/US/s3/aws4_request,SignedHeaders=content-length;content-type;host;x-amz-content-sha256;x-amz-date;x-amz-meta-s3cmd-attrs;x-amz-storage-class,Signature=329ba550642531735976b2c19b7d49d7e084877a199e78ffb98f08f4ce61a3ba", 0, 0));
-  evhtp_headers_add_header(request->headers_out,
-                           evhtp_header_new("Connection", "close", 0, 0));
-
-  size_t out_len = evbuffer_get_length(buf);
-  char sz_size[100] = {0};
-  sprintf(sz_size, "%zu", out_len);
-
-  printf("Sending Content-Length = %s bytes\n", sz_size);
-  evhtp_headers_add_header(request->headers_out,
-                          evhtp_header_new("Content-Length", sz_size, 1, 1));
-  evhtp_headers_add_header(request->headers_out,
-                          evhtp_header_new("Host", "s3.seagate.com", 0, 0));
-  evhtp_headers_add_header(request->headers_out,
-                          evhtp_header_new("Host", "s3.seagate.com", 0, 0));
-  evhtp_headers_add_header(request->headers_out,
-                          evhtp_header_new("content-type", "application/octet-stream", 0, 0));
-  evhtp_headers_add_header(request->headers_out,
-                          evhtp_header_new("x-amz-content-sha256", "30e14955ebf1352266dc2ff8067e68104607e750abb9d3b36582b8af909fcb58", 0, 0));
-  evhtp_headers_add_header(request->headers_out,
-                          evhtp_header_new("x-amz-date", "20160523T055836Z", 0, 0));
-  evhtp_headers_add_header(request->headers_out,
-                          evhtp_header_new("x-amz-meta-s3cmd-attrs", "uid:1000/gname:seagate/uname:seagate/gid:1000/mode:33188/mtime:1435603529/atime:1463983116/md5:b6d81b360a5672d80c27430f39153e2c/ctime:1435603529", 0, 0));
-  evhtp_headers_add_header(request->headers_out,
-                          evhtp_header_new("x-amz-storage-class", "STANDARD", 0, 0));
-}
-
-void setup_test_by_file(evhtp_request_t* request, struct evbuffer* buf, std::string filename) {
-  // read content from file.
-  std::ifstream ifs(filename.c_str());
-  std::string request_body( (std::istreambuf_iterator<char>(ifs) ),
-                       (std::istreambuf_iterator<char>()    ) );
-  evbuffer_add(buf, request_body.c_str(), request_body.length());
-  setup_request_headers(request, buf);
-}
-
-void my_evbuffer_cleanup(const void *data,
-    size_t datalen, void *extra) {
-  printf("my_evbuffer_cleanup called...\n");
-  free((void*)data);
-}
-
-void setup_data_to_upload(struct evbuffer* buf, void* data, size_t s_bytes) {
-  // printf("setup_data_to_upload called...\n");
-  evbuffer_add_reference(buf, data, s_bytes, NULL, NULL);
-}
-
-// void setup_test_by_size(evhtp_request_t* request, struct evbuffer* buf, size_t s_bytes) {
-//   void *data = malloc(s_bytes);
-//   evbuffer_add_reference(buf, data, s_bytes, my_evbuffer_cleanup, NULL);
-//   setup_request_headers(request, buf);
-// }
-
-void send_request(evhtp_connection_t * conn, evhtp_request_t* request, std::string uri, struct evbuffer* req_body_buffer) {
-  // printf("send_request called...\n");
-  S3ClientRequest* client_request = (S3ClientRequest*)request->cbarg;
-  client_request->timer.start();
-  evhtp_make_request(conn, request, htp_method_PUT, uri.c_str());
-  evhtp_send_reply_body(request, req_body_buffer);
-}
-
-void tead_down_test() {
-  return;
+                "Number of uploads, used when -mix is not given");
+
+DEFINE_string(mix, "",
+              "Weighted ops, e.g. put:50,get:40,delete:10; ops are put, get, "
+              "head, delete, list, multipart (whole uploads with parts of "
+              "-part_size)");
+DEFINE_string(sizes, "1m",
+              "Object sizes: 1m fixed, 4k-1m uniform or 4k:70,1m:30 weighted");
+DEFINE_string(bucket, "seagatebucket", "Bucket name");
+DEFINE_int32(bucket_count, 1, "Buckets <bucket>-<n> used when above 1");
+DEFINE_string(key_prefix, "obj", "Prefix of object keys");
+DEFINE_int64(key_count, 1000, "Number of keys in the key space");
+DEFINE_int32(concurrency, 1, "Number of connections");
+DEFINE_double(rate, 0, "Open loop ops per second, 0 for closed loop");
+DEFINE_int64(ops, 0, "Number of ops of the run, 0 for no limit");
+DEFINE_double(duration_sec, 0, "Duration of the run, 0 for no limit");
+DEFINE_string(multipart_threshold, "0",
+              "PUTs of at least this size are multipart uploads");
+DEFINE_string(part_size, "5m", "Part size of multipart uploads");
+DEFINE_bool(chunked, false, "Send bodies in aws-chunked encoding");
+DEFINE_string(chunk_size, "64k", "Chunk size of aws-chunked bodies");
+DEFINE_int32(list_max_keys, 1000, "max-keys of list ops");
+DEFINE_bool(sequential_keys, false, "Use keys in order, not random ones");
+DEFINE_bool(keepalive, true, "Reuse connections between requests");
+DEFINE_bool(create_buckets, false, "Create the buckets before the run");
+DEFINE_bool(prefill, false, "PUT every key before the run");
+DEFINE_bool(print_each_op, false, "Print status and latency of every op");
+DEFINE_double(interval_sec, 1, "Interval of progress lines, 0 to disable");
+DEFINE_string(timeseries_csv, "", "CSV file for the progress lines");
+DEFINE_string(hgrm_prefix, "",
+              "Write latency histograms to <prefix><op>.hgrm files");
+DEFINE_int64(seed, 1, "Seed of the random choices");
+
+static bool parse_size_flag(const char* name, const std::string& text,
+                            uint64_t& size) {
+  if (!s3_perf_parse_size(text, size)) {
+    fprintf(stderr, "Bad -%s: %s\n", name, text.c_str());
+    return false;
+  }
+  return true;
 }
 
 int
 main(int argc, char ** argv) {
-    evbase_t           * evbase;
-
-    gflags::ParseCommandLineFlags(&argc, &argv, true);
-
-    evbase  = event_base_new();
-    size_t s_bytes = FLAGS_upload_size_mb * 1024 * 1024;
-    void *data = malloc(s_bytes);
-
-    std::vector<S3ClientRequest> reqs(FLAGS_uploadcount);
-    for (int i = 0; i < FLAGS_uploadcount; ++i) {
-      reqs[i].conn    = evhtp_connection_new(evbase, FLAGS_s3host.c_str(), FLAGS_s3port);
-      reqs[i].request = evhtp_request_new(NULL, evbase);
-      reqs[i].body_buffer = evbuffer_new();
-      setup_data_to_upload(reqs[i].body_buffer, data, s_bytes);
-
-      reqs[i].request->cbarg = (void*)&reqs[i];
-
-      evhtp_set_hook(&reqs[i].conn->hooks, evhtp_hook_on_headers, (evhtp_hook)print_response_headers, NULL);
-      setup_request_headers(reqs[i].request, reqs[i].body_buffer);
-    }
-
-    for (int i = 0; i < FLAGS_uploadcount; ++i) {
-      char cnt[100] = {0};
-      sprintf(cnt, "%d", i);
-      send_request(reqs[i].conn, reqs[i].request, FLAGS_uploadurl + cnt, reqs[i].body_buffer);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  S3PerfLoadConfig config;
+  config.host = FLAGS_s3host;
+  config.port = FLAGS_s3port;
+  config.host_header = FLAGS_host_header;
+  config.concurrency = FLAGS_concurrency;
+  config.rate = FLAGS_rate;
+  config.ops = FLAGS_ops;
+  config.duration_sec = FLAGS_duration_sec;
+  config.chunked = FLAGS_chunked;
+  config.list_max_keys = FLAGS_list_max_keys;
+  config.sequential_keys = FLAGS_sequential_keys;
+  config.keepalive = FLAGS_keepalive;
+  config.create_buckets = FLAGS_create_buckets;
+  config.prefill = FLAGS_prefill;
+  config.print_each_op = FLAGS_print_each_op;
+  config.interval_sec = FLAGS_interval_sec;
+  config.timeseries_csv = FLAGS_timeseries_csv;
+  config.hgrm_prefix = FLAGS_hgrm_prefix;
+  config.seed = FLAGS_seed;
+
+  if (!parse_size_flag("multipart_threshold", FLAGS_multipart_threshold,
+                       config.multipart_threshold) ||
+      !parse_size_flag("part_size", FLAGS_part_size, config.part_size) ||
+      !parse_size_flag("chunk_size", FLAGS_chunk_size, config.chunk_size)) {
+    return 1;
+  }
+  if (!config.chunk_size) {
+    fprintf(stderr, "-chunk_size must not be 0\n");
+    return 1;
+  }
+
+  std::string error;
+  std::string bucket = FLAGS_bucket;
+  std::string key_prefix = FLAGS_key_prefix;
+  uint64_t key_count = FLAGS_key_count;
+  std::string mix = FLAGS_mix;
+  std::string sizes = FLAGS_sizes;
+
+  if (mix.empty()) {
+    // Parallel uploads of <uploadurl><n>, as the tool always did
+    std::string url = FLAGS_uploadurl;
+    size_t slash = url.find('/', 1);
+    if (url.empty() || url[0] != '/' || slash == std::string::npos) {
+      fprintf(stderr, "Bad -uploadurl: %s\n", url.c_str());
+      return 1;
     }
-
-    event_base_loop(evbase, 0);
-
-    for (int i = 0; i < FLAGS_uploadcount; ++i) {
-      evbuffer_free(reqs[i].body_buffer);
-    }
-    free(data);
-    event_base_free(evbase);
-
-    return 0;
+    bucket = url.substr(1, slash - 1);
+    key_prefix = url.substr(slash + 1);
+    key_count = FLAGS_uploadcount;
+    mix = "put:1";
+    sizes = std::to_string(FLAGS_upload_size_mb) + "m";
+    config.ops = key_count;
+    config.concurrency = (unsigned)key_count;
+    config.sequential_keys = true;
+    config.print_each_op = true;
+  }
+  if (!config.mix.parse(mix, error)) {
+    fprintf(stderr, "Bad -mix: %s\n", error.c_str());
+    return 1;
+  }
+  if (!config.sizes.parse(sizes, error)) {
+    fprintf(stderr, "Bad -sizes: %s\n", error.c_str());
+    return 1;
+  }
+  if (config.mix.has(S3PerfOpType::multipart) && !config.part_size) {
+    fprintf(stderr, "-part_size must not be 0 with multipart ops\n");
+    return 1;
+  }
+  if (FLAGS_bucket_count < 1 || key_count < 1 || config.concurrency < 1) {
+    fprintf(stderr,
+            "-bucket_count, -key_count and -concurrency must be positive\n");
+    return 1;
+  }
+  if (!config.ops && config.duration_sec <= 0) {
+    fprintf(stderr, "One of -ops and -duration_sec must be given\n");
+    return 1;
+  }
+
+  std::ifstream ifs(FLAGS_uploadfile.c_str());
+  if (ifs) {
+    config.body_pattern.assign(std::istreambuf_iterator<char>(ifs),
+                               std::istreambuf_iterator<char>());
+  }
+
+  S3PerfKeySpace key_space(bucket, (unsigned)FLAGS_bucket_count, key_prefix,
+                           key_count);
+  evbase_t* evbase = event_base_new();
+  uint64_t errors = 0;
+  {
+    S3PerfLoadGenerator generator(evbase, config, key_space);
+    errors = generator.run();
+  }
+  event_base_free(evbase);
+
+  gflags::ShutDownCommandLineFlags();
+  return errors ? 1 : 0;
 }
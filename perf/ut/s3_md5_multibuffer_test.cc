@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "s3_md5_multibuffer.h"
+
+typedef S3MD5MultiBuffer::Engine Engine;
+
+class S3MD5MultiBufferTest : public testing::TestWithParam<Engine> {
+ protected:
+  void SetUp() override {
+    // Engines the CPU lacks fall back to OpenSSL, so they are checked too
+    srand(1);
+  }
+
+  static std::string random_data(size_t len) {
+    std::string data(len, '\0');
+    for (auto &ch : data) {
+      ch = (char)rand();
+    }
+    return data;
+  }
+
+  static std::string digest(MD5_CTX ctx) {
+    unsigned char md[MD5_DIGEST_LENGTH];
+    MD5_Final(md, &ctx);
+    return std::string((const char *)md, sizeof(md));
+  }
+
+  // Updates 'count' streams with the engine and with OpenSSL, 'rounds'
+  // times, each with random lengths up to 'max_len'
+  void check_streams(size_t count, size_t max_len, unsigned rounds) {
+    std::vector<MD5_CTX> ctxs(count), expected(count);
+    for (size_t i = 0; i < count; ++i) {
+      MD5_Init(&ctxs[i]);
+      MD5_Init(&expected[i]);
+    }
+    for (unsigned round = 0; round < rounds; ++round) {
+      std::vector<std::string> data;
+      std::vector<MD5_CTX *> ctx_ptrs;
+      std::vector<const void *> ptrs;
+      std::vector<size_t> lens;
+      for (size_t i = 0; i < count; ++i) {
+        data.push_back(random_data(rand() % (max_len + 1)));
+      }
+      for (size_t i = 0; i < count; ++i) {
+        ctx_ptrs.push_back(&ctxs[i]);
+        ptrs.push_back(data[i].data());
+        lens.push_back(data[i].size());
+        MD5_Update(&expected[i], data[i].data(), data[i].size());
+      }
+      S3MD5MultiBuffer::update(ctx_ptrs.data(), ptrs.data(), lens.data(),
+                               count, GetParam());
+    }
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(digest(expected[i]), digest(ctxs[i])) << "stream " << i;
+    }
+  }
+};
+
+TEST_P(S3MD5MultiBufferTest, SameLengthStreams) {
+  const size_t lanes = S3MD5MultiBuffer::get_lane_count(GetParam());
+  std::vector<MD5_CTX> ctxs(lanes);
+  std::vector<MD5_CTX *> ctx_ptrs;
+  std::vector<const void *> ptrs;
+  std::vector<size_t> lens;
+  std::vector<std::string> data;
+  for (size_t i = 0; i < lanes; ++i) {
+    data.push_back(random_data(64 * 1024));
+  }
+  for (size_t i = 0; i < lanes; ++i) {
+    MD5_Init(&ctxs[i]);
+    ctx_ptrs.push_back(&ctxs[i]);
+    ptrs.push_back(data[i].data());
+    lens.push_back(data[i].size());
+  }
+  S3MD5MultiBuffer::update(ctx_ptrs.data(), ptrs.data(), lens.data(), lanes,
+                           GetParam());
+
+  for (size_t i = 0; i < lanes; ++i) {
+    unsigned char md[MD5_DIGEST_LENGTH];
+    MD5((const unsigned char *)data[i].data(), data[i].size(), md);
+    EXPECT_EQ(std::string((const char *)md, sizeof(md)), digest(ctxs[i]));
+  }
+}
+
+TEST_P(S3MD5MultiBufferTest, KnownDigest) {
+  // MD5 value from RFC 1321, in every lane
+  const std::string input =
+      "12345678901234567890123456789012345678901234567890123456789012345678901"
+      "234567890";
+  const size_t lanes = S3MD5MultiBuffer::get_lane_count(GetParam());
+  std::vector<MD5_CTX> ctxs(lanes);
+  std::vector<MD5_CTX *> ctx_ptrs;
+  std::vector<const void *> ptrs(lanes, input.data());
+  std::vector<size_t> lens(lanes, input.size());
+  for (auto &ctx : ctxs) {
+    MD5_Init(&ctx);
+    ctx_ptrs.push_back(&ctx);
+  }
+  S3MD5MultiBuffer::update(ctx_ptrs.data(), ptrs.data(), lens.data(), lanes,
+                           GetParam());
+  for (auto &ctx : ctxs) {
+    unsigned char md[MD5_DIGEST_LENGTH];
+    MD5_Final(md, &ctx);
+    char hex[MD5_DIGEST_LENGTH * 2 + 1];
+    for (int i = 0; i < MD5_DIGEST_LENGTH; ++i) {
+      snprintf(hex + 2 * i, 3, "%02x", md[i]);
+    }
+    EXPECT_STREQ("57edf4a22be3c955ac49da2e2107b67a", hex);
+  }
+}
+
+TEST_P(S3MD5MultiBufferTest, UnalignedLengthsAcrossUpdates) {
+  // Partial blocks stay buffered in contexts between updates
+  check_streams(S3MD5MultiBuffer::get_lane_count(GetParam()), 1000, 20);
+}
+
+TEST_P(S3MD5MultiBufferTest, MoreStreamsThanLanes) {
+  check_streams(3 * S3MD5MultiBuffer::get_lane_count(GetParam()) + 1, 20000,
+                4);
+}
+
+TEST_P(S3MD5MultiBufferTest, FewerStreamsThanLanes) {
+  check_streams(2, 20000, 4);
+  check_streams(1, 20000, 4);
+}
+
+TEST_P(S3MD5MultiBufferTest, EmptyInput) {
+  check_streams(5, 0, 2);
+  S3MD5MultiBuffer::update(nullptr, nullptr, nullptr, 0, GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(Engines, S3MD5MultiBufferTest,
+                        testing::Values(Engine::scalar, Engine::sse2,
+                                        Engine::avx2, Engine::avx512));
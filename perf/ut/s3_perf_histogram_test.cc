@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "s3_perf_histogram.h"
+
+TEST(S3PerfHistogramTest, EmptyHistogram) {
+  S3PerfHistogram histogram;
+  EXPECT_EQ(0, histogram.get_total_count());
+  EXPECT_EQ(0, histogram.get_min());
+  EXPECT_EQ(0, histogram.get_max());
+  EXPECT_EQ(0, histogram.get_mean());
+  EXPECT_EQ(0, histogram.get_stddev());
+  EXPECT_EQ(0, histogram.get_value_at_percentile(99));
+}
+
+TEST(S3PerfHistogramTest, SmallValuesAreExact) {
+  S3PerfHistogram histogram;
+  for (int64_t value = 1; value <= 100; ++value) {
+    histogram.record(value);
+  }
+  EXPECT_EQ(100, histogram.get_total_count());
+  EXPECT_EQ(1, histogram.get_min());
+  EXPECT_EQ(100, histogram.get_max());
+  EXPECT_DOUBLE_EQ(50.5, histogram.get_mean());
+  EXPECT_EQ(50, histogram.get_value_at_percentile(50));
+  EXPECT_EQ(90, histogram.get_value_at_percentile(90));
+  EXPECT_EQ(99, histogram.get_value_at_percentile(99));
+  EXPECT_EQ(100, histogram.get_value_at_percentile(100));
+  EXPECT_EQ(1, histogram.get_value_at_percentile(0));
+}
+
+TEST(S3PerfHistogramTest, KeepsSignificantDigits) {
+  const int64_t values[] = {1234, 56789, 1234567, 987654321};
+  for (int64_t value : values) {
+    S3PerfHistogram one(3600LL * 1000 * 1000, 3);
+    one.record(value);
+    one.record(value + 1000000000);  // keeps max above the value
+    int64_t reported = one.get_value_at_percentile(50);
+    EXPECT_GE(reported, value);
+    // 3 significant digits: within 1/1000 of the value
+    EXPECT_LE(reported - value, value / 1000 + 1) << value;
+  }
+}
+
+TEST(S3PerfHistogramTest, ClampsToTrackableRange) {
+  S3PerfHistogram histogram(1000, 3);
+  histogram.record(-5);
+  histogram.record(5000);
+  EXPECT_EQ(2, histogram.get_total_count());
+  EXPECT_EQ(0, histogram.get_min());
+  EXPECT_EQ(1000, histogram.get_max());
+  EXPECT_EQ(1000, histogram.get_value_at_percentile(100));
+}
+
+TEST(S3PerfHistogramTest, AddAndReset) {
+  S3PerfHistogram first;
+  S3PerfHistogram second;
+  for (int64_t value = 1; value <= 50; ++value) {
+    first.record(value);
+    second.record(value + 50);
+  }
+  first.add(second);
+  EXPECT_EQ(100, first.get_total_count());
+  EXPECT_EQ(1, first.get_min());
+  EXPECT_EQ(100, first.get_max());
+  EXPECT_EQ(75, first.get_value_at_percentile(75));
+
+  // Histograms of another layout are merged at their bucket values
+  S3PerfHistogram coarse(1000, 1);
+  coarse.record(7);
+  first.add(coarse);
+  EXPECT_EQ(101, first.get_total_count());
+
+  first.reset();
+  EXPECT_EQ(0, first.get_total_count());
+  EXPECT_EQ(0, first.get_max());
+  EXPECT_EQ(0, first.get_value_at_percentile(50));
+}
+
+TEST(S3PerfHistogramTest, StdDeviation) {
+  S3PerfHistogram histogram;
+  histogram.record(10);
+  histogram.record(30);
+  EXPECT_DOUBLE_EQ(20, histogram.get_mean());
+  EXPECT_NEAR(10, histogram.get_stddev(), 0.01);
+}
+
+TEST(S3PerfHistogramTest, WritesPercentileDistribution) {
+  S3PerfHistogram histogram;
+  for (int64_t value = 1; value <= 1000; ++value) {
+    histogram.record(value * 1000);
+  }
+  char* text = nullptr;
+  size_t text_size = 0;
+  FILE* out = open_memstream(&text, &text_size);
+  ASSERT_TRUE(out != nullptr);
+  histogram.write_percentile_distribution(out, 1000.0);
+  fclose(out);
+  std::string hgrm(text, text_size);
+  free(text);
+
+  EXPECT_EQ(0, hgrm.find("       Value     Percentile TotalCount"));
+  // Last line of the distribution is the whole count at percentile 1
+  EXPECT_NE(std::string::npos,
+            hgrm.find("1.000000000000       1000\n"));
+  EXPECT_NE(std::string::npos, hgrm.find("#[Mean    =      500.500"));
+  EXPECT_NE(std::string::npos, hgrm.find("Total count    =         1000]"));
+}
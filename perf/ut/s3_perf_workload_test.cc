@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <map>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "s3_perf_workload.h"
+
+TEST(S3PerfOpMixTest, ParsesWeights) {
+  S3PerfOpMix mix;
+  std::string error;
+  ASSERT_TRUE(mix.parse("put:50,get:40,delete:10", error));
+  EXPECT_TRUE(mix.has(S3PerfOpType::put));
+  EXPECT_TRUE(mix.has(S3PerfOpType::get));
+  EXPECT_TRUE(mix.has(S3PerfOpType::del));
+  EXPECT_FALSE(mix.has(S3PerfOpType::head));
+  EXPECT_FALSE(mix.empty());
+}
+
+TEST(S3PerfOpMixTest, AcceptsMultipart) {
+  S3PerfOpMix mix;
+  std::string error;
+  ASSERT_TRUE(mix.parse("multipart:100", error));
+  EXPECT_TRUE(mix.has(S3PerfOpType::multipart));
+
+  std::mt19937_64 rng(1);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(S3PerfOpType::multipart, mix.pick(rng));
+  }
+}
+
+TEST(S3PerfOpMixTest, WeightDefaultsToOne) {
+  S3PerfOpMix mix;
+  std::string error;
+  ASSERT_TRUE(mix.parse("head,list", error));
+  EXPECT_TRUE(mix.has(S3PerfOpType::head));
+  EXPECT_TRUE(mix.has(S3PerfOpType::list));
+}
+
+TEST(S3PerfOpMixTest, ZeroWeightIsDropped) {
+  S3PerfOpMix mix;
+  std::string error;
+  ASSERT_TRUE(mix.parse("put:1,get:0", error));
+  EXPECT_FALSE(mix.has(S3PerfOpType::get));
+
+  EXPECT_FALSE(mix.parse("get:0", error));
+  EXPECT_EQ("no ops in 'get:0'", error);
+}
+
+TEST(S3PerfOpMixTest, RejectsBadSpecs) {
+  S3PerfOpMix mix;
+  std::string error;
+  EXPECT_FALSE(mix.parse("copy:10", error));
+  EXPECT_EQ("unknown op 'copy'", error);
+  // Buckets are created by -create_buckets, not by the mix
+  EXPECT_FALSE(mix.parse("create_bucket:1", error));
+  EXPECT_FALSE(mix.parse("put:x", error));
+  EXPECT_EQ("bad op weight 'put:x'", error);
+  EXPECT_FALSE(mix.parse("put:", error));
+  EXPECT_FALSE(mix.parse(":5", error));
+  EXPECT_FALSE(mix.parse("", error));
+}
+
+TEST(S3PerfOpMixTest, PicksByWeight) {
+  S3PerfOpMix mix;
+  std::string error;
+  ASSERT_TRUE(mix.parse("put:75,get:25", error));
+
+  std::mt19937_64 rng(42);
+  std::map<S3PerfOpType, int> picked;
+  const int rounds = 100000;
+  for (int i = 0; i < rounds; ++i) {
+    ++picked[mix.pick(rng)];
+  }
+  EXPECT_EQ(2, picked.size());
+  EXPECT_NEAR(0.75, (double)picked[S3PerfOpType::put] / rounds, 0.01);
+  EXPECT_NEAR(0.25, (double)picked[S3PerfOpType::get] / rounds, 0.01);
+}
+
+TEST(S3PerfParseSizeTest, Units) {
+  uint64_t size = 0;
+  EXPECT_TRUE(s3_perf_parse_size("64", size));
+  EXPECT_EQ(64, size);
+  EXPECT_TRUE(s3_perf_parse_size("4k", size));
+  EXPECT_EQ(4096, size);
+  EXPECT_TRUE(s3_perf_parse_size("16M", size));
+  EXPECT_EQ(16ULL << 20, size);
+  EXPECT_TRUE(s3_perf_parse_size("1g", size));
+  EXPECT_EQ(1ULL << 30, size);
+  EXPECT_FALSE(s3_perf_parse_size("1t", size));
+  EXPECT_FALSE(s3_perf_parse_size("k", size));
+  EXPECT_FALSE(s3_perf_parse_size("-1", size));
+}
+
+TEST(S3PerfSizeDistTest, FixedRangeAndWeighted) {
+  S3PerfSizeDist sizes;
+  std::string error;
+  std::mt19937_64 rng(7);
+
+  ASSERT_TRUE(sizes.parse("1m", error));
+  EXPECT_EQ(1ULL << 20, sizes.pick(rng));
+  EXPECT_EQ(1ULL << 20, sizes.get_max());
+
+  ASSERT_TRUE(sizes.parse("4k-8k", error));
+  for (int i = 0; i < 1000; ++i) {
+    uint64_t size = sizes.pick(rng);
+    EXPECT_GE(size, 4096);
+    EXPECT_LE(size, 8192);
+  }
+  EXPECT_EQ(8192, sizes.get_max());
+
+  ASSERT_TRUE(sizes.parse("4k:70,1m:30", error));
+  for (int i = 0; i < 1000; ++i) {
+    uint64_t size = sizes.pick(rng);
+    EXPECT_TRUE(size == 4096 || size == (1ULL << 20));
+  }
+  EXPECT_EQ(1ULL << 20, sizes.get_max());
+
+  EXPECT_FALSE(sizes.parse("8k-4k", error));
+}
+
+TEST(S3PerfKeySpaceTest, SpreadsKeysOverBuckets) {
+  S3PerfKeySpace one_bucket("perfbucket", 1, "obj", 10);
+  EXPECT_EQ("/perfbucket/obj3", one_bucket.get_uri(3));
+
+  S3PerfKeySpace key_space("perfbucket", 4, "obj", 10);
+  EXPECT_EQ("perfbucket-1", key_space.get_bucket_of(5));
+  EXPECT_EQ("/perfbucket-3/obj7", key_space.get_uri(7));
+
+  std::mt19937_64 rng(3);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_LT(key_space.pick(rng), 10);
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+/*
+   Measures CPU time and heap allocations of serializing one page of
+   ListObjects response, as built before with format_xml_string() per element
+   and with S3XmlWriter.
+
+   Usage example:
+   # 1000 keys per page, 2000 pages per method
+   ./s3xmlbench -keys 1000 -pages 2000
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <gflags/gflags.h>
+#include <libxml/parser.h>
+
+#include "s3_xml_writer.h"
+
+DEFINE_int32(keys, 1000, "Number of keys in a listing page");
+DEFINE_int32(pages, 2000, "Number of pages serialized per method");
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+  ++allocations;
+  void* p = malloc(size ? size : 1);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+
+struct Entry {
+  std::string key, last_modified, md5, size, storage_class, owner_id,
+      owner_name;
+};
+
+// Former S3CommonUtilities::format_xml_string(), escaping through libxml2
+static std::string format_xml_string(const std::string& tag,
+                                     const std::string& value,
+                                     bool append_quotes = false) {
+  xmlChar* output = xmlEncodeSpecialChars(NULL, BAD_CAST value.c_str());
+  std::string format_string;
+  if (output) {
+    format_string = reinterpret_cast<char*>(output);
+    xmlFree(output);
+  }
+  if (format_string.empty()) {
+    return "<" + tag + "/>";
+  }
+  if (append_quotes) {
+    format_string = "\"" + format_string + "\"";
+  }
+  return "<" + tag + ">" + format_string + "</" + tag + ">";
+}
+
+static void build_concat(const std::vector<Entry>& entries, std::string& xml) {
+  xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
+  xml += "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">";
+  xml += format_xml_string("Name", "bucket");
+  xml += format_xml_string("Prefix", "");
+  xml += format_xml_string("Marker", "");
+  xml += format_xml_string("MaxKeys", "1000");
+  xml += format_xml_string("IsTruncated", "true");
+  for (auto& e : entries) {
+    xml += "<Contents>";
+    xml += format_xml_string("Key", e.key);
+    xml += format_xml_string("LastModified", e.last_modified);
+    xml += format_xml_string("ETag", e.md5, true);
+    xml += format_xml_string("Size", e.size);
+    xml += format_xml_string("StorageClass", e.storage_class);
+    xml += "<Owner>";
+    xml += format_xml_string("ID", e.owner_id);
+    xml += format_xml_string("DisplayName", e.owner_name);
+    xml += "</Owner>";
+    xml += "</Contents>";
+  }
+  xml += "</ListBucketResult>";
+}
+
+static void build_writer(const std::vector<Entry>& entries, std::string& out) {
+  out.clear();
+  S3XmlWriter xml(out);
+  // Same estimate as S3ObjectListResponse
+  xml.reserve(1024 + entries.size() * 384);
+  xml.add_raw("<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
+  xml.add_raw(
+      "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">");
+  xml.add_element("Name", "bucket");
+  xml.add_element("Prefix", "");
+  xml.add_element("Marker", "");
+  xml.add_element("MaxKeys", "1000");
+  xml.add_element("IsTruncated", "true");
+  for (auto& e : entries) {
+    xml.open_element("Contents");
+    xml.add_element("Key", e.key);
+    xml.add_element("LastModified", e.last_modified);
+    xml.add_element("ETag", e.md5, true);
+    xml.add_element("Size", e.size);
+    xml.add_element("StorageClass", e.storage_class);
+    xml.open_element("Owner");
+    xml.add_element("ID", e.owner_id);
+    xml.add_element("DisplayName", e.owner_name);
+    xml.close_element("Owner");
+    xml.close_element("Contents");
+  }
+  xml.add_raw("</ListBucketResult>");
+}
+
+typedef void (*BuildFn)(const std::vector<Entry>&, std::string&);
+
+// Every page starts with a new response string, as every request does
+static std::string run(const char* name, BuildFn build,
+                       const std::vector<Entry>& entries) {
+  std::string last;
+  size_t allocs_before = allocations;
+  auto start = std::chrono::steady_clock::now();
+  for (int page = 0; page < FLAGS_pages; ++page) {
+    std::string xml;
+    build(entries, xml);
+    if (page == FLAGS_pages - 1) {
+      last.swap(xml);
+    }
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  printf("%-8s %9.1f us/page %9.1f allocations/page %8zu bytes\n", name,
+         elapsed.count() * 1e6 / FLAGS_pages,
+         (double)(allocations - allocs_before) / FLAGS_pages, last.size());
+  return last;
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  if (FLAGS_keys <= 0 || FLAGS_pages <= 0) {
+    fprintf(stderr, "keys and pages must be positive\n");
+    return 1;
+  }
+
+  std::vector<Entry> entries(FLAGS_keys);
+  for (int i = 0; i < FLAGS_keys; ++i) {
+    Entry& e = entries[i];
+    e.key = "dir" + std::to_string(i % 37) + "/photo&video_" +
+            std::to_string(i) + ".jpg";
+    e.last_modified = "2020-11-20T09:30:00.000Z";
+    e.md5 = "2a2cd3bd9eb2ab7e3ef1e0e8e8e1e9b8";
+    e.size = std::to_string(1048576 + i);
+    e.storage_class = "STANDARD";
+    e.owner_id = "qWwZGnGYTga8gbpcuY79SA";
+    e.owner_name = "s3user";
+  }
+  printf("keys=%d pages=%d\n", FLAGS_keys, FLAGS_pages);
+
+  const std::string expected = run("concat", build_concat, entries);
+  const std::string got = run("writer", build_writer, entries);
+  if (expected != got) {
+    printf("XML MISMATCH\n");
+    return 1;
+  }
+  return 0;
+}
@@ -407,6 +407,9 @@ if [ $no_s3mempoolut_build -eq 0 ]
 then
   bazel build //:s3mempoolut --cxxopt="-std=c++11" --spawn_strategy=standalone \
                              --strip=never "$cpu_resource_limit_param" "$ram_resource_limit_param"
+  # Load generator UT, like the mempool one it needs no motr
+  bazel build //:s3perfut --cxxopt="-std=c++11" --spawn_strategy=standalone \
+                          --strip=never "$cpu_resource_limit_param" "$ram_resource_limit_param"
 fi
 
 if [ $no_s3mempoolmgrut_build -eq 0 ]
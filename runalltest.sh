@@ -118,6 +118,7 @@ then
   UT_BIN=./bazel-bin/s3ut
   UT_DEATHTESTS_BIN=./bazel-bin/s3utdeathtests
   UT_MEMPOOL_BIN=./bazel-bin/s3mempoolut
+  UT_PERF_BIN=./bazel-bin/s3perfut
   UT_MEMPOOLMGR_BIN=./bazel-bin/s3mempoolmgrut
   UT_S3BACKGROUNDDELETE=./s3backgrounddelete/scripts/run_all_ut.sh
   UT_S3CONFSTORE=./s3cortxutils/s3confstore/scripts/run_all_ut.sh
@@ -146,6 +147,12 @@ then
 
   $UT_MEMPOOL_BIN 2>&1
 
+  printf "\nCheck s3perfut..."
+  type $UT_PERF_BIN >/dev/null
+  printf "OK \n"
+
+  $UT_PERF_BIN 2>&1
+
   printf "\nCheck s3backgrounddeleteut..."
   type $UT_S3BACKGROUNDDELETE >/dev/null
   printf "OK \n"
@@ -43,6 +43,8 @@ Action::Action(std::shared_ptr<RequestObject> req, bool check_shutdown,
                std::shared_ptr<S3AuthClientFactory> auth_factory,
                bool skip_auth, bool skip_authorization)
     : base_request(req),
+      task_list(S3ArenaAllocator<std::function<void()>>(req->get_arena())),
+      task_addb_id_list(S3ArenaAllocator<uint64_t>(req->get_arena())),
       check_shutdown_signal(check_shutdown),
       is_response_scheduled(false),
       is_fi_hit(false),
@@ -273,6 +275,8 @@ void Action::check_authentication_successful() {
   const auto mss = auth_timer.elapsed_time_in_millisec();
   LOG_PERF("check_authentication_ms", request_id.c_str(), mss);
   s3_stats_timing("check_authentication", mss);
+  base_request->add_phase_time(S3RequestPhase::auth,
+                               auth_timer.elapsed_time_in_nanosec() / 1000);
 
   next();
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
@@ -280,6 +284,9 @@ void Action::check_authentication_successful() {
 
 void Action::check_authentication_failed() {
   s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+  auth_timer.stop();
+  base_request->add_phase_time(S3RequestPhase::auth,
+                               auth_timer.elapsed_time_in_nanosec() / 1000);
   if (base_request->client_connected()) {
     std::string error_code = auth_client->get_error_code();
     std::string error_message = auth_client->get_error_message();
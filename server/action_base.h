@@ -65,10 +65,14 @@
 #endif  // ENABLE_FAULT_INJECTION
 
 /* All tasks should be added with the following macro to be sure
- * that proper furntion idx is used */
-#define ACTION_TASK_ADD(task_name, obj)                 \
-  do {                                                  \
-    add_task(std::bind(&task_name, (obj)), #task_name); \
+ * that proper furntion idx is used.
+ * The task captures only the object pointer, so std::function keeps it
+ * inline instead of allocating it */
+#define ACTION_TASK_ADD(task_name, obj)                       \
+  do {                                                        \
+    auto task_obj = (obj);                                    \
+    add_task([task_obj]() { ((*task_obj).*(&task_name))(); }, \
+             #task_name);                                     \
   } while (0)
 
 /* All tasks should be added with the following macro to be sure
@@ -76,9 +80,11 @@
  * This macro is used in case add_task func needs to be called outside
  * action class via pointer to corresponding obj.
  * Used in tests*/
-#define ACTION_TASK_ADD_OBJPTR(ptr, task_name, obj)            \
-  do {                                                         \
-    (ptr)->add_task(std::bind(&task_name, (obj)), #task_name); \
+#define ACTION_TASK_ADD_OBJPTR(ptr, task_name, obj)                  \
+  do {                                                               \
+    auto task_obj = (obj);                                           \
+    (ptr)->add_task([task_obj]() { ((*task_obj).*(&task_name))(); }, \
+                    #task_name);                                     \
   } while (0)
 
 // Derived Action Objects will have steps (member functions)
@@ -98,9 +104,11 @@ class Action {
 
   // Holds the member functions that will process the request.
   // member function signature should be void fn();
-  std::vector<std::function<void()>> task_list;
+  // Both lists live in the arena of the request.
+  std::vector<std::function<void()>,
+              S3ArenaAllocator<std::function<void()>>> task_list;
   // Holds task's addb index
-  std::vector<uint64_t> task_addb_id_list;
+  std::vector<uint64_t, S3ArenaAllocator<uint64_t>> task_addb_id_list;
   size_t task_iteration_index;
 
   // Hold member functions that will rollback
@@ -32,15 +32,18 @@ std::shared_ptr<MotrAPIHandler> MotrAPIHandlerFactory::create_api_handler(
   switch (api_type) {
     case MotrApiType::index:
       s3_log(S3_LOG_DEBUG, request_id, "api_type = MotrApiType::index\n");
-      handler = std::make_shared<MotrIndexAPIHandler>(request, op_code);
+      handler = s3_arena_make_shared<MotrIndexAPIHandler>(
+          request->get_arena(), request, op_code);
       break;
     case MotrApiType::keyval:
       s3_log(S3_LOG_DEBUG, request_id, "api_type = MotrApiType::keyval\n");
-      handler = std::make_shared<MotrKeyValueAPIHandler>(request, op_code);
+      handler = s3_arena_make_shared<MotrKeyValueAPIHandler>(
+          request->get_arena(), request, op_code);
       break;
     case MotrApiType::object:
       s3_log(S3_LOG_DEBUG, request_id, "api_type = MotrApiType::object\n");
-      handler = std::make_shared<MotrObjectAPIHandler>(request, op_code);
+      handler = s3_arena_make_shared<MotrObjectAPIHandler>(
+          request->get_arena(), request, op_code);
       break;
     case MotrApiType::faultinjection:
       s3_log(S3_LOG_DEBUG, request_id,
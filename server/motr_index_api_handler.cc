@@ -34,21 +34,24 @@ void MotrIndexAPIHandler::create_action() {
       // Perform operation on Object.
       switch (request->http_verb()) {
         case S3HttpVerb::GET:
-          action = std::make_shared<MotrKVSListingAction>(request);
+          action = s3_arena_make_shared<MotrKVSListingAction>(
+              request->get_arena(), request);
           s3_stats_inc("motr_http_kvs_list_count");
           break;
         case S3HttpVerb::DELETE:
           if (!request->get_index_id_lo().empty() ||
               !request->get_index_id_hi().empty()) {
             // Index id must be present in request /indexes/123-456
-            action = std::make_shared<MotrDeleteIndexAction>(request);
+            action = s3_arena_make_shared<MotrDeleteIndexAction>(
+                request->get_arena(), request);
             s3_stats_inc("motr_http_index_delete_count");
           }  // else we dont support delete all indexes DEL /indexes/
           break;
         case S3HttpVerb::HEAD:
           if (!request->get_index_id_lo().empty() ||
               !request->get_index_id_hi().empty()) {
-            action = std::make_shared<MotrHeadIndexAction>(request);
+            action = s3_arena_make_shared<MotrHeadIndexAction>(
+                request->get_arena(), request);
             s3_stats_inc("motr_http_index_head_count");
           }
           break;
@@ -34,15 +34,18 @@ void MotrKeyValueAPIHandler::create_action() {
       // Perform operation on Object.
       switch (request->http_verb()) {
         case S3HttpVerb::GET:
-          action = std::make_shared<MotrGetKeyValueAction>(request);
+          action = s3_arena_make_shared<MotrGetKeyValueAction>(
+              request->get_arena(), request);
           s3_stats_inc("motr_http_get_keyvalue_request_count");
           break;
         case S3HttpVerb::PUT:
-          action = std::make_shared<MotrPutKeyValueAction>(request);
+          action = s3_arena_make_shared<MotrPutKeyValueAction>(
+              request->get_arena(), request);
           s3_stats_inc("motr_http_put_keyvalue_request_count");
           break;
         case S3HttpVerb::DELETE:
-          action = std::make_shared<MotrDeleteKeyValueAction>(request);
+          action = s3_arena_make_shared<MotrDeleteKeyValueAction>(
+              request->get_arena(), request);
           s3_stats_inc("motr_http_delete_keyvalue_request_count");
           break;
         default:
@@ -33,11 +33,13 @@ void MotrObjectAPIHandler::create_action() {
       // Perform operation on Object.
       switch (request->http_verb()) {
         case S3HttpVerb::DELETE:
-          action = std::make_shared<MotrDeleteObjectAction>(request);
+          action = s3_arena_make_shared<MotrDeleteObjectAction>(
+              request->get_arena(), request);
           s3_stats_inc("motr_http_delete_object_request_count");
           break;
         case S3HttpVerb::HEAD:
-          action = std::make_shared<MotrHeadObjectAction>(request);
+          action = s3_arena_make_shared<MotrHeadObjectAction>(
+              request->get_arena(), request);
           s3_stats_inc("motr_http_head_object_request_count");
           break;
         default:
@@ -119,6 +119,7 @@ RequestObject::RequestObject(
     EventInterface* event_obj_ptr)
     : ev_req(req),
       http_method(S3HttpVerb::UNKNOWN),
+      http_status(0),
       is_paused(false),
       notify_read_watermark(0),
       total_bytes_received(0),
@@ -132,7 +133,8 @@ RequestObject::RequestObject(
       in_query_params_copied(false),
       addb_request_id(m0_dummy_id_generate()),
       reply_buffer(NULL),
-      used_mempool_buffer_count(0) {
+      used_mempool_buffer_count(0),
+      arena(S3RequestArena::acquire()) {
 
   S3Uuid uuid;
   request_id = uuid.get_string_uuid();
@@ -242,6 +244,10 @@ RequestObject::~RequestObject() {
     reply_buffer = NULL;
   }
   free_client_read_timer();
+  // Objects allocated from the arena may still hold it
+  if (arena) {
+    arena->release();
+  }
 }
 
 const std::map<std::string, std::string, compare>&
@@ -41,6 +41,8 @@
 #include "s3_log.h"
 #include "s3_option.h"
 #include "s3_perf_logger.h"
+#include "s3_request_arena.h"
+#include "s3_stats_aggregator.h"
 #include "s3_timer.h"
 #include "s3_uuid.h"
 
@@ -109,6 +111,8 @@ class RequestObject {
   S3Timer turn_around_time;
   S3Timer paused_timer;
   S3Timer buffering_timer;
+  // Time spent in each phase, in us
+  uint64_t phase_time_us[(int)S3RequestPhase::count] = {};
 
   bool is_client_connected;
   bool ignore_incoming_data;
@@ -221,6 +225,7 @@ class RequestObject {
   const std::string& get_account_id();
   std::string get_request_id() const { return request_id; }
   std::string get_stripped_request_id() const { return stripped_request_id; }
+  S3RequestArena* get_arena() const { return arena; }
 
   S3RequestError get_request_error() const { return request_error; }
 
@@ -232,6 +237,10 @@ class RequestObject {
     bytes_sent = total_bytes_sent;
   }
 
+  void add_phase_time(S3RequestPhase phase, uint64_t time_us) {
+    phase_time_us[(int)phase] += time_us;
+  }
+
   /*
      Pause and resume will essentially stop and start attempting to read from
      the client socket.
@@ -357,6 +366,8 @@ class RequestObject {
  private:
   struct evbuffer* reply_buffer;
   size_t used_mempool_buffer_count;
+  // Memory of objects living as long as the request, nullptr if disabled
+  S3RequestArena* arena;
 
  public:
   virtual void send_response(int code, std::string body = "");
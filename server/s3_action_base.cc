@@ -56,6 +56,7 @@ void S3Action::set_authorization_meta() { next(); }
 
 void S3Action::check_authorization() {
   s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+  authorization_timer.start();
 
   if (is_authorizationheader_present) {
     auth_client->check_combo_auth(
@@ -70,12 +71,20 @@ void S3Action::check_authorization() {
 
 void S3Action::check_authorization_successful() {
   s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+  authorization_timer.stop();
+  request->add_phase_time(
+      S3RequestPhase::auth,
+      authorization_timer.elapsed_time_in_nanosec() / 1000);
   next();
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
 void S3Action::check_authorization_failed() {
   s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+  authorization_timer.stop();
+  request->add_phase_time(
+      S3RequestPhase::auth,
+      authorization_timer.elapsed_time_in_nanosec() / 1000);
   if (request->client_connected()) {
     std::string error_code = auth_client->get_error_code();
     std::string error_message = auth_client->get_error_message();
@@ -47,6 +47,7 @@
 class S3Action : public Action {
  protected:
   std::shared_ptr<S3RequestObject> request;
+  S3Timer authorization_timer;
 
  public:
   S3Action(std::shared_ptr<S3RequestObject> req, bool check_shutdown = true,
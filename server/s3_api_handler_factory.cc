@@ -32,24 +32,29 @@ std::shared_ptr<S3APIHandler> S3APIHandlerFactory::create_api_handler(
   switch (api_type) {
     case S3ApiType::service:
       s3_log(S3_LOG_DEBUG, request_id, "api_type = S3ApiType::service\n");
-      handler = std::make_shared<S3ServiceAPIHandler>(request, op_code);
+      handler = s3_arena_make_shared<S3ServiceAPIHandler>(
+          request->get_arena(), request, op_code);
       break;
     case S3ApiType::bucket:
       s3_log(S3_LOG_DEBUG, request_id, "api_type = S3ApiType::bucket\n");
-      handler = std::make_shared<S3BucketAPIHandler>(request, op_code);
+      handler = s3_arena_make_shared<S3BucketAPIHandler>(
+          request->get_arena(), request, op_code);
       break;
     case S3ApiType::object:
       s3_log(S3_LOG_DEBUG, request_id, "api_type = S3ApiType::object\n");
-      handler = std::make_shared<S3ObjectAPIHandler>(request, op_code);
+      handler = s3_arena_make_shared<S3ObjectAPIHandler>(
+          request->get_arena(), request, op_code);
       break;
     case S3ApiType::faultinjection:
       s3_log(S3_LOG_DEBUG, request_id,
              "api_type = S3ApiType::faultinjection\n");
-      handler = std::make_shared<S3FaultinjectionAPIHandler>(request, op_code);
+      handler = s3_arena_make_shared<S3FaultinjectionAPIHandler>(
+          request->get_arena(), request, op_code);
       break;
     case S3ApiType::management:
       s3_log(S3_LOG_DEBUG, request_id, "api_type = S3ApiType::management\n");
-      handler = std::make_shared<S3ManagementAPIHandler>(request, op_code);
+      handler = s3_arena_make_shared<S3ManagementAPIHandler>(
+          request->get_arena(), request, op_code);
       break;
     default:
       break;
@@ -20,9 +20,14 @@
 
 #include <cerrno>
 #include "s3_asyncop_context_base.h"
+#include "s3_motr_context.h"
 #include "s3_perf_logger.h"
 #include "s3_stats.h"
 #include "s3_log.h"
+#include "s3_option.h"
+
+extern struct s3_motr_idx_layout global_bucket_list_index_layout;
+extern struct s3_motr_idx_layout bucket_metadata_list_index_layout;
 
 S3AsyncOpContextBase::S3AsyncOpContextBase(std::shared_ptr<RequestObject> req,
                                            std::function<void(void)> success,
@@ -35,11 +40,13 @@ S3AsyncOpContextBase::S3AsyncOpContextBase(std::shared_ptr<RequestObject> req,
       ops_count(ops_cnt),
       response_received_count(0),
       at_least_one_success(false),
+      timer_phase(S3RequestPhase::count),
       s3_motr_api(motr_api ? std::move(motr_api)
                            : std::make_shared<ConcreteMotrAPI>()) {
   request_id = request->get_request_id();
   stripped_request_id = request->get_stripped_request_id();
   ops_response.resize(ops_count);
+  evbase = S3Option::get_instance()->get_eventbase();
 }
 
 void S3AsyncOpContextBase::reset_callbacks(std::function<void(void)> success,
@@ -95,8 +102,10 @@ void S3AsyncOpContextBase::set_op_errno_for(int op_idx, int err) {
   }
 }
 
-void S3AsyncOpContextBase::start_timer_for(const std::string& op_key) {
+void S3AsyncOpContextBase::start_timer_for(const std::string& op_key,
+                                           S3RequestPhase phase) {
   operation_key = op_key;
+  timer_phase = phase;
   timer.start();
 }
 
@@ -120,4 +129,19 @@ void S3AsyncOpContextBase::log_timer() {
            timer.elapsed_time_in_millisec());
 
   s3_stats_timing(operation_key, timer.elapsed_time_in_millisec());
+  if (request && timer_phase != S3RequestPhase::count) {
+    request->add_phase_time(timer_phase,
+                            timer.elapsed_time_in_nanosec() / 1000);
+  }
+}
+
+S3RequestPhase s3_motr_idx_phase(const struct s3_motr_idx_layout& idx_lo) {
+  for (const auto* global_lo :
+       {&global_bucket_list_index_layout, &bucket_metadata_list_index_layout}) {
+    if (idx_lo.oid.u_hi == global_lo->oid.u_hi &&
+        idx_lo.oid.u_lo == global_lo->oid.u_lo) {
+      return S3RequestPhase::bucket_metadata;
+    }
+  }
+  return S3RequestPhase::object_metadata;
 }
@@ -31,8 +31,15 @@
 #include "s3_motr_wrapper.h"
 #include "s3_common.h"
 #include "s3_request_object.h"
+#include "s3_stats_aggregator.h"
 #include "s3_timer.h"
 
+struct s3_motr_idx_layout;
+
+// Phase of a request an op on the index belongs to: bucket metadata for the
+// global bucket indexes, object metadata for the others
+S3RequestPhase s3_motr_idx_phase(const struct s3_motr_idx_layout& idx_lo);
+
 class S3AsyncOpResponse {
  public:
   S3AsyncOpResponse() {
@@ -65,12 +72,18 @@ class S3AsyncOpContextBase {
   // To measure performance
   S3Timer timer;
   std::string operation_key;  // used to identify operation(metric) name
+  // Phase of the request the time is added to, count for none
+  S3RequestPhase timer_phase;
   // Used for mocking motr return calls.
   std::shared_ptr<MotrAPI> s3_motr_api;
 
   std::string request_id;
   std::string stripped_request_id;
 
+  // Loop of the reactor that launched the operation; completions raised on
+  // Motr threads are posted back to it.
+  evbase_t* evbase;
+
  public:
   S3AsyncOpContextBase(std::shared_ptr<RequestObject> req,
                        std::function<void(void)> success,
@@ -101,12 +114,14 @@ class S3AsyncOpContextBase {
   bool is_at_least_one_op_successful() { return at_least_one_success; }
   // virtual void consume(char* chars, size_t length) = 0;
 
-  void start_timer_for(const std::string& op_key);
+  void start_timer_for(const std::string& op_key,
+                       S3RequestPhase phase = S3RequestPhase::count);
   void stop_timer(bool success = true);  // arg indicates success/failed metric
   // Call the logging always on main thread, so we dont need synchronisation of
   // log file.
   void log_timer();
   std::shared_ptr<MotrAPI> get_motr_api();
+  evbase_t* get_evbase() { return evbase; }
   // Google tests
   FRIEND_TEST(S3MotrReadWriteCommonTest, MotrOpDoneOnMainThreadOnSuccess);
   FRIEND_TEST(S3MotrReadWriteCommonTest, S3MotrOpStable);
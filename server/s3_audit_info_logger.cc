@@ -25,17 +25,26 @@
 #include "s3_audit_info_logger_log4cxx.h"
 #include "s3_audit_info_logger_syslog.h"
 #include "s3_audit_info_logger_kafka_web.h"
+#include "s3_post_to_main_loop.h"
 
 #include <stdexcept>
 
 S3AuditInfoLoggerBase* S3AuditInfoLogger::audit_info_logger = nullptr;
 bool S3AuditInfoLogger::audit_info_logger_enabled = false;
+evbase_t* S3AuditInfoLogger::audit_info_logger_evbase = nullptr;
+
+// Message saved on a reactor other than the one owning the logger
+struct S3AuditMsg {
+  std::string request_id;
+  std::string msg;
+};
 
 int S3AuditInfoLogger::init() {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
   int ret = 0;
   audit_info_logger = nullptr;
   audit_info_logger_enabled = false;
+  audit_info_logger_evbase = nullptr;
   std::string policy = S3Option::get_instance()->get_audit_logger_policy();
   if (policy == "disabled") {
     s3_log(S3_LOG_INFO, "", "Audit logger disabled by policy settings\n");
@@ -52,6 +61,7 @@ int S3AuditInfoLogger::init() {
           S3Option::get_instance()->get_audit_max_retry_count(),
           S3Option::get_instance()->get_audit_logger_rsyslog_msgid());
       audit_info_logger_enabled = true;
+      audit_info_logger_evbase = S3Option::get_instance()->get_eventbase();
     }
     catch (std::exception const& ex) {
       s3_log(S3_LOG_ERROR, "", "Cannot create Rsyslog logger %s", ex.what());
@@ -89,6 +99,7 @@ int S3AuditInfoLogger::init() {
           S3Option::get_instance()->get_audit_logger_port(),
           S3Option::get_instance()->get_audit_logger_kafka_web_path());
       audit_info_logger_enabled = true;
+      audit_info_logger_evbase = S3Option::get_instance()->get_eventbase();
     }
     catch (std::exception const& ex) {
       s3_log(S3_LOG_ERROR, "", "Cannot create Kafka Web logger %s", ex.what());
@@ -107,10 +118,34 @@ int S3AuditInfoLogger::init() {
 
 int S3AuditInfoLogger::save_msg(std::string const& cur_request_id,
                                 std::string const& audit_logging_msg) {
+  if (!audit_info_logger) {
+    return 1;
+  }
+  if (audit_info_logger_evbase &&
+      S3Option::get_instance()->get_eventbase() != audit_info_logger_evbase) {
+    // Bufferevents of the logger belong to another loop
+    struct user_event_context* user_ctx = (struct user_event_context*)calloc(
+        1, sizeof(struct user_event_context));
+    user_ctx->app_ctx = new S3AuditMsg{cur_request_id, audit_logging_msg};
+    user_ctx->evbase = audit_info_logger_evbase;
+    S3PostToMainLoop((void*)user_ctx)(save_msg_on_logger_loop, cur_request_id);
+    return 0;
+  }
+  return audit_info_logger->save_msg(cur_request_id, audit_logging_msg);
+}
+
+void S3AuditInfoLogger::save_msg_on_logger_loop(evutil_socket_t, short events,
+                                                void* user_data) {
+  struct user_event_context* user_ctx = (struct user_event_context*)user_data;
+  S3AuditMsg* audit_msg = (S3AuditMsg*)user_ctx->app_ctx;
   if (audit_info_logger) {
-    return audit_info_logger->save_msg(cur_request_id, audit_logging_msg);
+    audit_info_logger->save_msg(audit_msg->request_id, audit_msg->msg);
+  }
+  delete audit_msg;
+  if (user_ctx->user_event) {
+    event_free((struct event*)user_ctx->user_event);
   }
-  return 1;
+  free(user_ctx);
 }
 
 bool S3AuditInfoLogger::is_enabled() { return audit_info_logger_enabled; }
@@ -120,5 +155,6 @@ void S3AuditInfoLogger::finalize() {
   delete audit_info_logger;
   audit_info_logger = nullptr;
   audit_info_logger_enabled = false;
+  audit_info_logger_evbase = nullptr;
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
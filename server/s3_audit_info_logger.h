@@ -23,6 +23,8 @@
 #ifndef __S3_SERVER_AUDIT_INFO_LOGGER__H__
 #define __S3_SERVER_AUDIT_INFO_LOGGER__H__
 
+#include <evhtp.h>
+
 #include "s3_audit_info_logger_base.h"
 
 #include "gtest/gtest_prod.h"
@@ -31,6 +33,12 @@ class S3AuditInfoLogger {
  private:
   static S3AuditInfoLoggerBase* audit_info_logger;
   static bool audit_info_logger_enabled;
+  // Loop owning the connection of a network logger, messages saved on other
+  // reactors are posted to it. NULL for loggers usable from any thread.
+  static evbase_t* audit_info_logger_evbase;
+
+  static void save_msg_on_logger_loop(evutil_socket_t, short events,
+                                      void* user_data);
 
  public:
   static int init();
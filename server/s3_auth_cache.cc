@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <cinttypes>
+#include <list>
+#include <unordered_map>
+
+#include "s3_auth_cache.h"
+#include "s3_log.h"
+#include "s3_stats.h"
+
+S3AuthCache* S3AuthCache::p_instance;
+
+template <class T>
+class S3AuthCache::Table {
+  struct Entry {
+    T value;
+    std::chrono::steady_clock::time_point load_time;
+    // Position in 'lru', most recently used at the front
+    std::list<std::string>::iterator lru_pos;
+  };
+  std::unordered_map<std::string, Entry> entries;
+  std::list<std::string> lru;
+  const std::chrono::steady_clock::duration expire_interval;
+  const size_t max_size;
+  Counters& counters;
+
+ public:
+  Table(unsigned expire_interval_sec, size_t max_size, Counters& counters)
+      : expire_interval(std::chrono::seconds(expire_interval_sec)),
+        max_size(max_size),
+        counters(counters) {}
+
+  const T* find(const std::string& key) {
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+      return nullptr;
+    }
+    auto& entry = it->second;
+
+    if (std::chrono::steady_clock::now() - entry.load_time >=
+        expire_interval) {
+      lru.erase(entry.lru_pos);
+      entries.erase(it);
+      ++counters.expirations;
+      return nullptr;
+    }
+    lru.splice(lru.begin(), lru, entry.lru_pos);
+    return &entry.value;
+  }
+
+  void put(std::string key, T value) {
+    if (!max_size) {
+      return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    auto it = entries.find(key);
+
+    if (it != entries.end()) {
+      it->second.value = std::move(value);
+      it->second.load_time = now;
+      lru.splice(lru.begin(), lru, it->second.lru_pos);
+      return;
+    }
+    while (entries.size() >= max_size) {
+      entries.erase(lru.back());
+      lru.pop_back();
+      ++counters.evictions;
+    }
+    lru.push_front(key);
+    entries.emplace(std::move(key), Entry{std::move(value), now, lru.begin()});
+  }
+
+  size_t size() const { return entries.size(); }
+};
+
+S3AuthCache::S3AuthCache(size_t max_cache_size, unsigned expire_interval_sec,
+                         unsigned authorization_expire_interval_sec)
+    : signing_keys(new Table<SigningKey>(expire_interval_sec, max_cache_size,
+                                         counters)),
+      authorizations(new Table<std::string>(
+          authorization_expire_interval_sec, max_cache_size, counters)) {
+
+  s3_log(S3_LOG_INFO, "",
+         "%s Auth cache: max size %zu, expire %u sec, authorization expire "
+         "%u sec\n",
+         __func__, max_cache_size, expire_interval_sec,
+         authorization_expire_interval_sec);
+
+  if (!p_instance) {
+    p_instance = this;
+  }
+}
+
+S3AuthCache::~S3AuthCache() {
+  s3_log(S3_LOG_INFO, "",
+         "%s Auth cache: signing key %" PRIu64 " hits, %" PRIu64
+         " misses, authorization %" PRIu64 " hits, %" PRIu64
+         " misses, %" PRIu64 " expirations, %" PRIu64 " evictions\n",
+         __func__, counters.signing_key_hits.load(),
+         counters.signing_key_misses.load(),
+         counters.authorization_hits.load(),
+         counters.authorization_misses.load(), counters.expirations.load(),
+         counters.evictions.load());
+  if (p_instance == this) {
+    p_instance = nullptr;
+  }
+}
+
+bool S3AuthCache::find_signing_key(const std::string& key_id,
+                                   std::string& signing_key,
+                                   S3AuthIdentity& identity) {
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    const SigningKey* p_entry = signing_keys->find(key_id);
+
+    if (p_entry) {
+      signing_key = p_entry->signing_key;
+      identity = p_entry->identity;
+      found = true;
+    }
+  }
+  if (found) {
+    ++counters.signing_key_hits;
+    s3_stats_inc("auth_cache_signing_key_hit_count");
+  } else {
+    ++counters.signing_key_misses;
+    s3_stats_inc("auth_cache_signing_key_miss_count");
+  }
+  return found;
+}
+
+void S3AuthCache::put_signing_key(std::string key_id, std::string signing_key,
+                                  S3AuthIdentity identity) {
+  std::lock_guard<std::mutex> guard(lock);
+  signing_keys->put(std::move(key_id),
+                    SigningKey{std::move(signing_key), std::move(identity)});
+}
+
+bool S3AuthCache::find_authorization(const std::string& key,
+                                     std::string& default_acl) {
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    const std::string* p_acl = authorizations->find(key);
+
+    if (p_acl) {
+      default_acl = *p_acl;
+      found = true;
+    }
+  }
+  if (found) {
+    ++counters.authorization_hits;
+    s3_stats_inc("auth_cache_authorization_hit_count");
+  } else {
+    ++counters.authorization_misses;
+    s3_stats_inc("auth_cache_authorization_miss_count");
+  }
+  return found;
+}
+
+void S3AuthCache::put_authorization(std::string key, std::string default_acl) {
+  std::lock_guard<std::mutex> guard(lock);
+  authorizations->put(std::move(key), std::move(default_acl));
+}
+
+size_t S3AuthCache::size() const {
+  std::lock_guard<std::mutex> guard(lock);
+  return signing_keys->size() + authorizations->size();
+}
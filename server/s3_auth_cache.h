@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_AUTH_CACHE_H__
+#define __S3_SERVER_S3_AUTH_CACHE_H__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Requestor identity as returned by the auth server
+struct S3AuthIdentity {
+  std::string user_name;
+  std::string canonical_id;
+  std::string user_id;
+  std::string account_name;
+  std::string account_id;
+  std::string email;
+};
+
+// Process-wide cache of auth server answers, used by S3AuthClient to keep
+// the auth server off the hot path.
+//
+// Signing keys: SigV4 signing key is derived from the secret key and the
+// credential scope (date, region, service), it is handed out by the auth
+// server on successful authentication. With the key cached the signature of
+// further requests of the same access key and scope is verified in-process,
+// and the cached identity is used for the request.
+//
+// Authorization results: ACL based authorization decision (and default ACL
+// generated for the request) keyed by a digest of all the inputs the auth
+// server uses for it. Only successful results are cached.
+//
+// Both kinds of entries expire after a short interval regardless of use, so
+// deactivated access keys and changed ACLs become effective after at most
+// that time. Size limit applies to every kind of entries separately, the
+// least recently used entries are evicted.
+class S3AuthCache {
+
+  static S3AuthCache* p_instance;
+
+ public:
+  struct Counters {
+    std::atomic<uint64_t> signing_key_hits{0};
+    std::atomic<uint64_t> signing_key_misses{0};
+    std::atomic<uint64_t> authorization_hits{0};
+    std::atomic<uint64_t> authorization_misses{0};
+    std::atomic<uint64_t> expirations{0};
+    std::atomic<uint64_t> evictions{0};
+  };
+
+  S3AuthCache(size_t max_cache_size, unsigned expire_interval_sec,
+              unsigned authorization_expire_interval_sec);
+
+  S3AuthCache(const S3AuthCache&) = delete;
+  S3AuthCache& operator=(const S3AuthCache&) = delete;
+
+  ~S3AuthCache();
+
+  // Returns nullptr when the cache is not configured
+  static S3AuthCache* get_instance() { return p_instance; }
+
+  // 'key_id' is access key and credential scope,
+  // see S3AwsV4Signature::get_signing_key_id()
+  bool find_signing_key(const std::string& key_id, std::string& signing_key,
+                        S3AuthIdentity& identity);
+  void put_signing_key(std::string key_id, std::string signing_key,
+                       S3AuthIdentity identity);
+
+  bool find_authorization(const std::string& key, std::string& default_acl);
+  void put_authorization(std::string key, std::string default_acl);
+
+  size_t size() const;
+  const Counters& get_counters() const { return counters; }
+
+ private:
+  template <class T>
+  class Table;
+
+  struct SigningKey {
+    std::string signing_key;
+    S3AuthIdentity identity;
+  };
+
+  Counters counters;
+
+  mutable std::mutex lock;
+  std::unique_ptr<Table<SigningKey>> signing_keys;
+  std::unique_ptr<Table<std::string>> authorizations;
+};
+
+#endif  // __S3_SERVER_S3_AUTH_CACHE_H__
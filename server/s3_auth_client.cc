@@ -23,8 +23,11 @@
 #include <unistd.h>
 #include <string>
 
+#include "s3_auth_cache.h"
 #include "s3_auth_client.h"
+#include "s3_auth_connection_pool.h"
 #include "s3_auth_fake.h"
+#include "s3_aws_v4_signature.h"
 #include "s3_common.h"
 #include "s3_error_codes.h"
 #include "s3_fi_common.h"
@@ -86,6 +89,8 @@ static evhtp_res on_conn_err_callback(evhtp_connection_t *p_evhtp_conn,
   if (p_evhtp_conn->request) {
     evhtp_unset_all_hooks(&p_evhtp_conn->request->hooks);
   }
+  p_auth_ctx->release_connection(true);
+
   if (request_inst->client_connected()) {
     p_auth_ctx->set_op_status_for(0, S3AsyncOpStatus::connection_failed,
                                   "Cannot connect to Auth server.");
@@ -138,6 +143,7 @@ evhtp_res on_read_response(evhtp_request_t *p_req, evbuf_t *p_buf,
   // Note: Do not remove this, else you will have s3 crashes as the
   // callbacks are invoked after request/connection is freed.
   p_auth_ctx->unset_hooks();
+  p_auth_ctx->release_connection();
 
   if (!request_inst->client_connected()) {
     // S3 client has already disconnected, ignore
@@ -303,6 +309,9 @@ static evhtp_res on_response_headers_end(evhtp_request_t *p_evhtp_req,
     s3_log(S3_LOG_WARN, p_auth_ctx->get_request_id(),
            "S3AuthClient doesn't return \"Content-Length\" header");
   } else if (content_lentgh == 0) {
+    // No body to wait for
+    p_auth_ctx->unset_hooks();
+    p_auth_ctx->release_connection();
 
     switch (p_auth_ctx->op_type) {
       case S3AuthClientOpType::aclvalidation:
@@ -513,17 +522,19 @@ bool S3AuthClientOpContext::init_auth_op_ctx() {
   ADDB_AUTH(ACTS_AUTH_OP_CTX_NEW_CONN);
   clear_op_context();
 
-  auth_op_context = create_basic_auth_op_ctx(p_event_base);
+  f_pooled_connection = S3AuthConnectionPool::get_instance() != nullptr;
 
+  if (f_pooled_connection) {
+    // Connection is attached when the pool hands it out
+    auth_op_context = create_pooled_auth_op_ctx(p_event_base);
+  } else {
+    auth_op_context = create_basic_auth_op_ctx(p_event_base);
+  }
   if (auth_op_context == NULL) {
     return false;
   }
   evhtp_set_hook(&auth_op_context->auth_request->hooks, evhtp_hook_on_read,
                  (evhtp_hook)on_read_response, this);
-  evhtp_set_hook(&auth_op_context->conn->hooks, evhtp_hook_on_event,
-                 (evhtp_hook)on_event_hook, (void *)this);
-  evhtp_set_hook(&auth_op_context->conn->hooks, evhtp_hook_on_write,
-                 (evhtp_hook)on_write_hook, (void *)this);
   evhtp_set_hook(&auth_op_context->auth_request->hooks,
                  evhtp_hook_on_headers_start,
                  (evhtp_hook)on_response_headers_start, this);
@@ -531,10 +542,42 @@ bool S3AuthClientOpContext::init_auth_op_ctx() {
                  (evhtp_hook)on_response_header, this);
   evhtp_set_hook(&auth_op_context->auth_request->hooks, evhtp_hook_on_headers,
                  (evhtp_hook)on_response_headers_end, this);
+
+  if (auth_op_context->conn) {
+    set_connection_hooks();
+  }
+  return true;
+}
+
+void S3AuthClientOpContext::set_connection_hooks() {
+  evhtp_set_hook(&auth_op_context->conn->hooks, evhtp_hook_on_event,
+                 (evhtp_hook)on_event_hook, (void *)this);
+  evhtp_set_hook(&auth_op_context->conn->hooks, evhtp_hook_on_write,
+                 (evhtp_hook)on_write_hook, (void *)this);
   evhtp_set_hook(&auth_op_context->conn->hooks, evhtp_hook_on_conn_error,
                  (evhtp_hook)on_conn_err_callback, (void *)this);
+}
 
-  return true;
+void S3AuthClientOpContext::attach_connection(evhtp_connection_t *conn) {
+  assert(f_pooled_connection);
+  auth_op_context->conn = conn;
+  set_connection_hooks();
+}
+
+void S3AuthClientOpContext::release_connection(bool f_failed) {
+  if (!f_pooled_connection || !auth_op_context || !auth_op_context->conn) {
+    return;
+  }
+  S3AuthConnectionPool *connection_pool = S3AuthConnectionPool::get_instance();
+
+  if (connection_pool) {
+    if (f_failed) {
+      connection_pool->forget(auth_op_context->conn);
+    } else {
+      connection_pool->release(auth_op_context->conn);
+    }
+  }
+  auth_op_context->conn = NULL;
 }
 
 void S3AuthClientOpContext::unset_hooks() {
@@ -549,6 +592,15 @@ void S3AuthClientOpContext::unset_hooks() {
 }
 
 void S3AuthClientOpContext::clear_op_context() {
+  if (f_pooled_connection && auth_op_context && auth_op_context->conn) {
+    // Response is not read yet, the connection cannot be reused
+    unset_hooks();
+    S3AuthConnectionPool *connection_pool =
+        S3AuthConnectionPool::get_instance();
+    if (connection_pool) {
+      connection_pool->release(auth_op_context->conn, false);
+    }
+  }
   free_basic_auth_client_op_ctx(auth_op_context);
   auth_op_context = NULL;
 }
@@ -569,6 +621,14 @@ S3AuthClient::S3AuthClient(std::shared_ptr<RequestObject> req,
 
 S3AuthClient::~S3AuthClient() {
   s3_log(S3_LOG_DEBUG, request_id, "%s\n", __func__);
+
+  S3AuthConnectionPool *connection_pool = S3AuthConnectionPool::get_instance();
+  if (connection_pool) {
+    connection_pool->cancel(this);
+  }
+  if (local_chunk_auth_event) {
+    event_free(local_chunk_auth_event);
+  }
   ADDB_AUTH(ACTS_AUTH_CLNT_DESTRUCT);
 }
 
@@ -652,13 +712,14 @@ std::string S3AuthClient::get_error_code() const {
   return "ServiceUnavailable";  // auth server may be down
 }
 
-bool S3AuthClient::setup_auth_request_body() {
+bool S3AuthClient::setup_auth_request_data(std::string &auth_request_body) {
   s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
 
   // Setup the headers to forward to auth service
   s3_log(S3_LOG_DEBUG, request_id, "Headers from S3 client:\n");
 
   data_key_val.clear();
+  auth_request_body.clear();
 
   if (op_type != S3AuthClientOpType::policyvalidation) {
 
@@ -671,7 +732,6 @@ bool S3AuthClient::setup_auth_request_body() {
       add_key_val_to_body(s_hdr, s_val);
     }
   }
-  std::string auth_request_body;
   std::string method;
 
   switch (request->http_verb()) {
@@ -766,7 +826,6 @@ bool S3AuthClient::setup_auth_request_body() {
   if (!f_evhttp_encode_uri_succ) {
     s3_log(S3_LOG_ERROR, request_id,
            "evhttp_encode_uri() returned NULL for client query params");
-    auth_request_body.clear();
     return false;
   }
 
@@ -836,7 +895,6 @@ bool S3AuthClient::setup_auth_request_body() {
                           current_chunk_signature_from_auth);
       add_key_val_to_body("x-amz-content-sha256", hash_sha256_current_chunk);
     }
-
     auth_request_body = "Action=AuthenticateUser";
   } else if (op_type == S3AuthClientOpType::aclvalidation) {
 
@@ -847,6 +905,20 @@ bool S3AuthClient::setup_auth_request_body() {
     add_key_val_to_body("Policy", policy_str);
     auth_request_body = "Action=ValidatePolicy";
   }
+  s3_log(S3_LOG_DEBUG, request_id, "%s Exit", __func__);
+
+  return true;
+}
+
+bool S3AuthClient::setup_auth_request_body() {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+
+  std::string auth_request_body;
+
+  if (!setup_auth_request_data(auth_request_body)) {
+    return false;
+  }
+  bool f_evhttp_encode_uri_succ = true;
 
   for (auto &it : data_key_val) {
 
@@ -922,15 +994,28 @@ void S3AuthClient::setup_auth_request_headers() {
 
   evhtp_headers_add_header(p_evhtp_req->headers_out,
                            evhtp_header_new("User-Agent", "s3server", 1, 1));
-  /* Using a new connection per request, all types of requests like
-  *   authenticarion, authorization, validateacl, validatepolicy open
-  *   a connection and it will be closed by Authserver.
-  *   TODO : Evaluate performance and change this approach to reuse
-  *   connections
+  if (is_signing_key_requested()) {
+    // Signing key is going to be cached, see S3AuthCache. Headers of the S3
+    // client go to the request body, so only s3server sets this one.
+    evhtp_headers_add_header(
+        p_evhtp_req->headers_out,
+        evhtp_header_new(
+            "X-S3Server-Signing-Key-Secret",
+            S3Option::get_instance()->get_auth_signing_key_secret().c_str(), 0,
+            1));
+  }
+  /* Without S3AuthConnectionPool a new connection is used per request,
+  *   all types of requests like authenticarion, authorization, validateacl,
+  *   validatepolicy open a connection and it will be closed by Authserver.
   */
-
-  evhtp_headers_add_header(p_evhtp_req->headers_out,
-                           evhtp_header_new("Connection", "close", 1, 1));
+  if (S3AuthConnectionPool::get_instance()) {
+    evhtp_headers_add_header(
+        p_evhtp_req->headers_out,
+        evhtp_header_new("Connection", "keep-alive", 1, 1));
+  } else {
+    evhtp_headers_add_header(p_evhtp_req->headers_out,
+                             evhtp_header_new("Connection", "close", 1, 1));
+  }
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
@@ -1002,8 +1087,28 @@ void S3AuthClient::trigger_request() {
            sz_request);
     ::free(sz_request);
   }
-  execute_authconnect_request(auth_context->get_auth_op_ctx());
+  S3AuthConnectionPool *connection_pool = S3AuthConnectionPool::get_instance();
+
+  if (connection_pool) {
+    // Sent as soon as the pool hands out a connection
+    connection_pool->acquire(this, [this](evhtp_connection_t *conn) {
+      if (conn) {
+        auth_context->attach_connection(conn);
+        execute_authconnect_request(auth_context->get_auth_op_ctx());
+        return;
+      }
+      evbuffer_free(req_body_buffer);
+      req_body_buffer = NULL;
 
+      auth_context->set_op_status_for(0, S3AsyncOpStatus::connection_failed,
+                                      "Cannot connect to Auth server.");
+      auth_context->set_auth_response_error(
+          "InternalError", "Cannot connect to Auth server", request_id);
+      auth_context->on_failed_handler()();
+    });
+  } else {
+    execute_authconnect_request(auth_context->get_auth_op_ctx());
+  }
   at_exit_on_error.cancel();
   state = S3AuthClientOpState::started;
 
@@ -1101,6 +1206,8 @@ void S3AuthClient::on_common_success() {
     assert(S3AuthClientOpType::authentication == op_type);
     prev_chunk_signature_from_auth = get_signature_from_response();
   }
+  remember_auth_result();
+
   this->handler_on_success();
 
   s3_log(S3_LOG_DEBUG, nullptr, "%s Exit", __func__);
@@ -1169,6 +1276,7 @@ void S3AuthClient::check_authorization(std::function<void(void)> on_success,
       std::bind(&S3AuthClient::on_common_failed, this),
       op_type = S3AuthClientOpType::authorization));
 
+  authorization_cache_key.clear();
   trigger_request(std::move(on_success), std::move(on_failed));
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
@@ -1203,11 +1311,214 @@ void S3AuthClient::check_combo_auth(std::function<void(void)> on_success,
       break;
     }
   }
-  trigger_request(std::move(on_success), std::move(on_failed));
+  authorization_cache_key.clear();
+
+  if (authenticate_with_cache()) {
+    authorize_with_cache(std::move(on_success), std::move(on_failed));
+
+  } else if (!signing_key_id.empty()) {
+    // Combined request to the auth server does not return the signing key,
+    // so authenticate separately to have the key cached for next requests.
+    combo_auth_on_success = std::move(on_success);
+    combo_auth_on_failed = on_failed;
+
+    auth_context.reset(new S3AuthClientOpContext(
+        request, std::bind(&S3AuthClient::on_common_success, this),
+        std::bind(&S3AuthClient::on_common_failed, this),
+        op_type = S3AuthClientOpType::authentication));
+
+    trigger_request(std::bind(&S3AuthClient::combo_auth_authenticated, this),
+                    std::move(on_failed));
+  } else {
+    trigger_request(std::move(on_success), std::move(on_failed));
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3AuthClient::combo_auth_authenticated() {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+
+  authorize_with_cache(std::move(combo_auth_on_success),
+                       std::move(combo_auth_on_failed));
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
+// Verifies request signature with the signing key from S3AuthCache.
+// If the request can be verified locally, but the key is not cached yet,
+// returns false with 'signing_key_id' set, so the key is requested
+// from the auth server and cached on success.
+bool S3AuthClient::authenticate_with_cache() {
+  signing_key_id.clear();
+
+  S3AuthCache *auth_cache = S3AuthCache::get_instance();
+
+  if (!auth_cache || s3_fi_is_enabled("fake_authentication_fail")) {
+    return false;
+  }
+  S3AwsV4Signature aws_v4_signature;
+  bool f_parsed = false;
+
+  for (const auto &hdr_val : request->get_in_headers_copy()) {
+    if (!strcasecmp(hdr_val.first.c_str(), "Authorization")) {
+      f_parsed = aws_v4_signature.parse_authorization_header(hdr_val.second);
+      break;
+    }
+  }
+  if (!f_parsed) {
+    return false;
+  }
+  std::string auth_request_body;
+
+  if (!setup_auth_request_data(auth_request_body) ||
+      !aws_v4_signature.is_locally_verifiable(data_key_val, ::time(nullptr))) {
+    return false;
+  }
+  signing_key_id = aws_v4_signature.get_signing_key_id();
+
+  std::string signing_key;
+  S3AuthIdentity identity;
+
+  if (!auth_cache->find_signing_key(signing_key_id, signing_key, identity)) {
+    return false;
+  }
+  if (signing_key.empty()) {
+    // Auth server didn't hand out the key, don't ask it again till expiration
+    signing_key_id.clear();
+    return false;
+  }
+  if (!aws_v4_signature.verify(signing_key, data_key_val)) {
+    // Let the auth server decide, the secret key might have been changed
+    s3_log(S3_LOG_INFO, request_id,
+           "Signature doesn't match the cached signing key\n");
+    return false;
+  }
+  signing_key_id.clear();
+
+  request->set_user_name(identity.user_name);
+  request->set_canonical_id(identity.canonical_id);
+  request->set_user_id(identity.user_id);
+  request->set_account_name(identity.account_name);
+  request->set_account_id(identity.account_id);
+  request->set_email(identity.email);
+
+  s3_log(S3_LOG_DEBUG, request_id, "Authenticated with cached signing key\n");
+  return true;
+}
+
+// Authorizes already authenticated request, using cached result if any.
+void S3AuthClient::authorize_with_cache(std::function<void(void)> on_success,
+                                        std::function<void(void)> on_failed) {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+
+  auth_context.reset(new S3AuthClientOpContext(
+      request, std::bind(&S3AuthClient::on_common_success, this),
+      std::bind(&S3AuthClient::on_common_failed, this),
+      op_type = S3AuthClientOpType::authorization));
+
+  std::string auth_request_body;
+
+  authorization_cache_key = setup_auth_request_data(auth_request_body)
+                                ? get_authorization_cache_key()
+                                : "";
+  std::string default_acl;
+
+  if (!authorization_cache_key.empty() &&
+      S3AuthCache::get_instance()->find_authorization(authorization_cache_key,
+                                                      default_acl)) {
+    std::shared_ptr<S3RequestObject> s3_request =
+        std::dynamic_pointer_cast<S3RequestObject>(request);
+    if (s3_request) {
+      s3_request->set_default_acl(default_acl);
+    }
+    authorization_cache_key.clear();
+    state = S3AuthClientOpState::succeded;
+    ADDB_AUTH(ACTS_AUTH_CLNT_CHK_AUTHZ_SUCC);
+
+    on_success();
+  } else {
+    trigger_request(std::move(on_success), std::move(on_failed));
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+// Digest of everything ACL based authorization depends on; data_key_val
+// must be set up for authorization op. Empty string if the result should
+// not be cached.
+std::string S3AuthClient::get_authorization_cache_key() const {
+  // Bucket policy statements may have conditions on any request attribute
+  if (data_key_val.count("Policy") ||
+      !std::dynamic_pointer_cast<S3RequestObject>(request)) {
+    return "";
+  }
+  static const char *const key_names[] = {
+      "Method",              "RequestorAccountId", "RequestorUserId",
+      "RequestorCanonicalId", "ClientQueryParams", "Request-ACL",
+      "S3Action",            "S3ActionList",       "Auth-ACL",
+      "Bucket-ACL"};
+
+  std::string key_material;
+  auto add_key_val = [&key_material](const std::string &key,
+                                     const std::string &val) {
+    key_material += key;
+    key_material += '\n';
+    key_material += val;
+    key_material += '\n';
+  };
+  for (const char *key_name : key_names) {
+    auto it = data_key_val.find(key_name);
+    if (it != data_key_val.end()) {
+      add_key_val(it->first, it->second);
+    }
+  }
+  auto it = data_key_val.find("Request-ACL");
+  const bool f_acl_requested = it != data_key_val.end() && it->second == "true";
+
+  for (const auto &key_val : data_key_val) {
+    const char *sz_key = key_val.first.c_str();
+    // Generated ACL and ACL validation depend on the entity path,
+    // the rest of authorization is the same for all objects of a bucket
+    // with the same ACLs.
+    if ((f_acl_requested && key_val.first == "ClientAbsoluteUri") ||
+        !strncasecmp(sz_key, "x-amz-acl", 9) ||
+        !strncasecmp(sz_key, "x-amz-grant-", 12) ||
+        !strcasecmp(sz_key, "x-amz-copy-source")) {
+      add_key_val(key_val.first, key_val.second);
+    }
+  }
+  return S3AwsV4Signature::sha256_hex(key_material);
+}
+
+bool S3AuthClient::is_signing_key_requested() const {
+  return S3AuthClientOpType::authentication == op_type && !is_chunked_auth &&
+         !signing_key_id.empty();
+}
+
+void S3AuthClient::remember_auth_result() {
+  S3AuthCache *auth_cache = S3AuthCache::get_instance();
+
+  if (!auth_cache) {
+    return;
+  }
+  if (is_signing_key_requested()) {
+    // Empty key is remembered as well, so the auth server which doesn't
+    // support signing keys is not asked for them on every request
+    auth_cache->put_signing_key(
+        std::move(signing_key_id),
+        S3AwsV4Signature::from_hex(auth_context->get_signing_key()),
+        S3AuthIdentity{request->get_user_name(), request->get_canonical_id(),
+                       request->get_user_id(), request->get_account_name(),
+                       request->get_account_id(), request->get_email()});
+    signing_key_id.clear();
+
+  } else if (S3AuthClientOpType::authorization == op_type &&
+             !authorization_cache_key.empty()) {
+    auth_cache->put_authorization(std::move(authorization_cache_key),
+                                  auth_context->get_acl());
+    authorization_cache_key.clear();
+  }
+}
+
 /*
  *  <IEM_INLINE_DOCUMENTATION>
  *    <event_code>047001001</event_code>
@@ -1244,7 +1555,14 @@ void S3AuthClient::check_authentication(std::function<void(void)> on_success,
 
   is_chunked_auth = false;
 
-  trigger_request(std::move(on_success), std::move(on_failed));
+  if (authenticate_with_cache()) {
+    state = S3AuthClientOpState::succeded;
+    ADDB_AUTH(ACTS_AUTH_CLNT_CHK_AUTH_SUCC);
+
+    on_success();
+  } else {
+    trigger_request(std::move(on_success), std::move(on_failed));
+  }
 
   s3_log(S3_LOG_DEBUG, nullptr, "%s Exit", __func__);
 }
@@ -1269,10 +1587,116 @@ void S3AuthClient::init_chunk_auth_cycle(std::function<void(void)> on_success,
   is_chunked_auth = true;
   state = S3AuthClientOpState::init;
 
+  if (init_local_chunk_auth()) {
+    s3_log(S3_LOG_DEBUG, request_id,
+           "Chunk signatures are verified with cached signing key\n");
+  }
   s3_log(S3_LOG_DEBUG, request_id, "%s Exit", __func__);
   // trigger is done when sign and hash are available for any chunk
 }
 
+// The seed signature of "Authorization" header is already verified at this
+// point, so if its signing key is in S3AuthCache, the rest of the signature
+// chain is verified in-process instead of a round trip to the auth server
+// per chunk.
+bool S3AuthClient::init_local_chunk_auth() {
+  chunk_signature.reset();
+
+  if (local_chunk_auth_event) {
+    event_free(local_chunk_auth_event);
+    local_chunk_auth_event = nullptr;
+  }
+
+  S3AuthCache *auth_cache = S3AuthCache::get_instance();
+
+  if (!auth_cache || s3_fi_is_enabled("fake_authentication_fail")) {
+    return false;
+  }
+  std::unique_ptr<S3AwsV4Signature> signature(new S3AwsV4Signature);
+
+  if (!signature->parse_authorization_header(
+           request->get_header_value("Authorization"))) {
+    return false;
+  }
+  std::string request_date = request->get_header_value("x-amz-date");
+  std::string signing_key;
+  S3AuthIdentity identity;
+
+  if (request_date.empty() ||
+      !auth_cache->find_signing_key(signature->get_signing_key_id(),
+                                    signing_key, identity) ||
+      signing_key.empty()) {
+    return false;
+  }
+  chunk_signing_key = std::move(signing_key);
+  chunk_request_date = std::move(request_date);
+  prev_chunk_signature_from_auth = signature->get_signature();
+  chunk_signature = std::move(signature);
+
+  return true;
+}
+
+void S3AuthClient::verify_chunk_locally(const std::string &current_sign,
+                                        const std::string &sha256_of_payload) {
+  if (local_chunk_auth_event) {
+    // Result of the cycle is already known
+    return;
+  }
+  if (!chunk_signature->verify_chunk(chunk_signing_key, chunk_request_date,
+                                     prev_chunk_signature_from_auth,
+                                     sha256_of_payload, current_sign)) {
+    s3_log(S3_LOG_ERROR, request_id, "Chunk signature doesn't match\n");
+    post_local_chunk_auth_result(false);
+
+  } else if (last_chunk_added) {
+    post_local_chunk_auth_result(true);
+
+  } else {
+    prev_chunk_signature_from_auth = current_sign;
+    state = S3AuthClientOpState::succeded;
+  }
+}
+
+static void local_chunk_auth_cb(evutil_socket_t fd, short event, void *arg) {
+  ((S3AuthClient *)arg)->local_chunk_auth_done();
+}
+
+// Callers expect chunk auth result asynchronously, same as from the auth
+// server, so it is delivered on the next event loop iteration.
+void S3AuthClient::post_local_chunk_auth_result(bool f_success) {
+  local_chunk_auth_ok = f_success;
+  state = S3AuthClientOpState::started;
+
+  local_chunk_auth_event =
+      event_new(S3Option::get_instance()->get_eventbase(), -1, 0,
+                local_chunk_auth_cb, (void *)this);
+  event_active(local_chunk_auth_event, EV_TIMEOUT, 1);
+}
+
+void S3AuthClient::local_chunk_auth_done() {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+
+  if (local_chunk_auth_ok) {
+    state = S3AuthClientOpState::succeded;
+    ADDB_AUTH(ACTS_AUTH_CLNT_CHUNK_AUTH_SUCC);
+    this->handler_on_success();
+  } else {
+    chunk_auth_failed();
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3AuthClient::abort_chunk_auth_op() {
+  chunk_auth_aborted = true;
+
+  if (chunk_signature && !local_chunk_auth_event &&
+      S3AuthClientOpState::succeded == state) {
+    // Caller waits for the chunks it has added, end the cycle as the auth
+    // server path does on completion of the request in flight
+    post_local_chunk_auth_result(true);
+  }
+}
+
 // Insert the signature sent in each chunk (chunk-signature=value)
 // and sha256(chunk-data) to be used in auth of chunk
 void S3AuthClient::add_checksum_for_chunk(std::string current_sign,
@@ -1280,6 +1704,12 @@ void S3AuthClient::add_checksum_for_chunk(std::string current_sign,
   s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
   ADDB_AUTH(ACTS_AUTH_CLNT_CHUNK_ADD_CHKSUMM);
 
+  if (chunk_signature) {
+    verify_chunk_locally(current_sign, sha256_of_payload);
+
+    s3_log(S3_LOG_DEBUG, nullptr, "%s Exit", __func__);
+    return;
+  }
   chunk_validation_data.push(
       std::make_pair(std::move(current_sign), std::move(sha256_of_payload)));
 
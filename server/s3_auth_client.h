@@ -44,6 +44,8 @@
 #define ADDB_AUTH(req_state) \
   ADDB(S3_ADDB_AUTH_ID, request->addb_request_id, (req_state))
 
+class S3AwsV4Signature;
+
 evhtp_res on_read_response(evhtp_request_t* p_req, evbuf_t* p_buf, void* p_arg);
 
 class S3AuthClientOpContext : public S3AsyncOpContextBase {
@@ -56,6 +58,10 @@ class S3AuthClientOpContext : public S3AsyncOpContextBase {
   struct s3_auth_op_context* auth_op_context = NULL;
   long content_length = -1;
   bool f_success = false;
+  // Connection is taken from S3AuthConnectionPool
+  bool f_pooled_connection = false;
+
+  void set_connection_hooks();
 
  public:
   const S3AuthClientOpType op_type;
@@ -88,6 +94,12 @@ class S3AuthClientOpContext : public S3AsyncOpContextBase {
   std::string get_signature_sha256() const {
     return f_success ? success_obj->get_signature_sha256() : "";
   }
+  std::string get_signing_key() const {
+    return f_success ? success_obj->get_signing_key() : "";
+  }
+  std::string get_acl() const {
+    return f_success ? success_obj->get_acl() : "";
+  }
   const std::string& get_error_message() const {
     return error_obj->get_message();
   }
@@ -99,6 +111,12 @@ class S3AuthClientOpContext : public S3AsyncOpContextBase {
   void unset_hooks();
   void clear_op_context();
 
+  // Pooled connection to send the request over
+  void attach_connection(evhtp_connection_t* conn);
+  // Gives pooled connection back once the response is read;
+  // 'f_failed' if the connection is being freed by libevhtp.
+  void release_connection(bool f_failed = false);
+
   struct s3_auth_op_context* get_auth_op_ctx() const { return auth_op_context; }
 
   FRIEND_TEST(S3AuthClientOpContextTest, Constructor);
@@ -172,6 +190,24 @@ class S3AuthClient {
 
   bool skip_authorization;
 
+  // Keys of S3AuthCache entries to be stored on success of the current op
+  std::string signing_key_id;
+  std::string authorization_cache_key;
+
+  // Caller's handlers of combo auth, when it is done as separate
+  // authentication and authorization
+  std::function<void()> combo_auth_on_success;
+  std::function<void()> combo_auth_on_failed;
+
+  // In-process verification of chunk signatures, set when the signing key
+  // of the request is in S3AuthCache
+  std::unique_ptr<S3AwsV4Signature> chunk_signature;
+  std::string chunk_signing_key;
+  std::string chunk_request_date;
+  // Delivers result of the local chunk auth cycle from the event loop
+  struct event* local_chunk_auth_event = nullptr;
+  bool local_chunk_auth_ok = false;
+
   void trigger_request(std::function<void(void)> on_success,
                        std::function<void(void)> on_failed);
   // void remember_auth_details_in_request();
@@ -179,6 +215,24 @@ class S3AuthClient {
   void on_common_success();
   void on_common_failed();
 
+  // Fills data_key_val and sets "Action=..." of the auth server request
+  bool setup_auth_request_data(std::string& auth_request_body);
+
+  // S3AuthCache support
+  bool authenticate_with_cache();
+  void authorize_with_cache(std::function<void(void)> on_success,
+                            std::function<void(void)> on_failed);
+  void combo_auth_authenticated();
+  std::string get_authorization_cache_key() const;
+  // True if the current op asks the auth server for the signing key
+  bool is_signing_key_requested() const;
+  void remember_auth_result();
+
+  bool init_local_chunk_auth();
+  void verify_chunk_locally(const std::string& current_sign,
+                            const std::string& sha256_of_payload);
+  void post_local_chunk_auth_result(bool f_success);
+
  public:
   S3AuthClient(std::shared_ptr<RequestObject> req,
                bool skip_authorization = false);
@@ -241,8 +295,10 @@ class S3AuthClient {
                                            std::string sha256_of_payload);
   void chunk_auth_successful();
   void chunk_auth_failed();
+  // Called from the event loop, see post_local_chunk_auth_result()
+  void local_chunk_auth_done();
 
-  void abort_chunk_auth_op() { chunk_auth_aborted = true; }
+  void abort_chunk_auth_op();
   bool is_chunk_auth_op_aborted() { return chunk_auth_aborted; }
   void set_acl_and_policy(const std::string& acl, const std::string& policy);
   void set_bucket_acl(const std::string& bucket_acl);
@@ -264,6 +320,8 @@ class S3AuthClient {
   FRIEND_TEST(S3AuthClientTest, SetUpAuthRequestBodyForChunkedAuth);
   FRIEND_TEST(S3AuthClientTest, SetUpAuthRequestBodyForChunkedAuth1);
   FRIEND_TEST(S3AuthClientTest, SetUpAuthRequestBodyForChunkedAuth2);
+  FRIEND_TEST(S3AuthClientTest, AuthenticateWithCachedSigningKey);
+  FRIEND_TEST(S3AuthClientTest, AuthorizationCacheKey);
   FRIEND_TEST(S3BucketActionTest, SetAuthorizationMeta);
 };
 
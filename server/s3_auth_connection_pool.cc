@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <algorithm>
+
+#include "s3_auth_connection_pool.h"
+#include "s3_auth_context.h"
+#include "s3_log.h"
+#include "s3_stats.h"
+
+thread_local S3AuthConnectionPool *S3AuthConnectionPool::p_instance;
+
+S3AuthConnectionPool::S3AuthConnectionPool(evbase_t *evbase,
+                                           unsigned max_connections,
+                                           unsigned idle_timeout_sec)
+    : evbase(evbase),
+      max_connections(max_connections),
+      idle_timeout_sec(idle_timeout_sec) {
+  s3_log(S3_LOG_INFO, "",
+         "Auth server connection pool: max connections %u, idle timeout %u "
+         "sec\n",
+         max_connections, idle_timeout_sec);
+
+  connections.reserve(max_connections);
+  dispatch_event = event_new(evbase, -1, 0, dispatch_cb, this);
+
+  if (idle_timeout_sec) {
+    struct timeval tv = {1, 0};
+    idle_timer = event_new(evbase, -1, EV_PERSIST, idle_timer_cb, this);
+    event_add(idle_timer, &tv);
+  }
+  S3AuthConnectionPool::p_instance = this;
+}
+
+S3AuthConnectionPool::~S3AuthConnectionPool() {
+  // Pools of other reactors may be destroyed from the main thread
+  if (S3AuthConnectionPool::p_instance == this) {
+    S3AuthConnectionPool::p_instance = nullptr;
+  }
+  close_all_connections();
+
+  if (idle_timer) {
+    event_free(idle_timer);
+  }
+  event_free(dispatch_event);
+}
+
+evhtp_connection_t *S3AuthConnectionPool::create_connection() {
+  evhtp_connection_t *conn = create_auth_connection(evbase);
+
+  if (conn) {
+    watch_connection(conn);
+  }
+  return conn;
+}
+
+void S3AuthConnectionPool::free_connection(evhtp_connection_t *conn) {
+  // Neither pool's nor request's callbacks must be called from here
+  evhtp_unset_all_hooks(&conn->hooks);
+
+  if (conn->request) {
+    evhtp_unset_all_hooks(&conn->request->hooks);
+  }
+  evhtp_connection_free(conn);
+}
+
+void S3AuthConnectionPool::watch_connection(evhtp_connection_t *conn) {
+  evhtp_set_hook(&conn->hooks, evhtp_hook_on_connection_fini,
+                 (evhtp_hook)on_connection_fini, this);
+}
+
+void S3AuthConnectionPool::close_all_connections() {
+  for (auto &connection : connections) {
+    free_connection(connection.conn);
+  }
+  connections.clear();
+}
+
+S3AuthConnectionPool::Connection *S3AuthConnectionPool::find(
+    evhtp_connection_t *conn) {
+  for (auto &connection : connections) {
+    if (connection.conn == conn) {
+      return &connection;
+    }
+  }
+  return nullptr;
+}
+
+bool S3AuthConnectionPool::remove(evhtp_connection_t *conn) {
+  auto it = std::find_if(
+      connections.begin(), connections.end(),
+      [conn](const Connection &connection) { return connection.conn == conn; });
+
+  if (it == connections.end()) {
+    return false;
+  }
+  if (it->busy) {
+    s3_stats_update_gauge("auth_pool_busy_connections", -1);
+  }
+  connections.erase(it);
+  return true;
+}
+
+S3AuthConnectionPool::Connection *S3AuthConnectionPool::get_connection(
+    bool &f_failed) {
+  f_failed = false;
+  Connection *idle_connection = nullptr;
+
+  // The most recently released one, so that surplus connections time out
+  for (auto &connection : connections) {
+    if (!connection.busy &&
+        (!idle_connection ||
+         connection.idle_since >= idle_connection->idle_since)) {
+      idle_connection = &connection;
+    }
+  }
+  if (idle_connection || connections.size() >= max_connections) {
+    return idle_connection;
+  }
+  evhtp_connection_t *conn = create_connection();
+
+  if (!conn) {
+    s3_log(S3_LOG_ERROR, "", "Cannot create connection to Auth server\n");
+    f_failed = true;
+    return nullptr;
+  }
+  s3_stats_inc("auth_pool_connection_open_count");
+  connections.push_back(Connection{conn, false, false, 0, 0});
+
+  return &connections.back();
+}
+
+void S3AuthConnectionPool::hand_out(Connection &connection,
+                                    ReadyCallback on_ready) {
+  evhtp_connection_t *conn = connection.conn;
+
+  if (connection.served) {
+    s3_stats_inc("auth_pool_connection_reuse_count");
+  }
+  connection.busy = true;
+  s3_stats_update_gauge("auth_pool_busy_connections", 1);
+
+  // Request of the previous round trip is done with
+  if (conn->request) {
+    evhtp_request_free(conn->request);
+    conn->request = NULL;
+  }
+  // May get back to the pool, 'connection' must not be used after this
+  on_ready(conn);
+}
+
+void S3AuthConnectionPool::acquire(const void *owner,
+                                   ReadyCallback on_ready) {
+  bool f_failed = false;
+  // Requests which are already waiting go first
+  Connection *connection = waiters.empty() ? get_connection(f_failed) : nullptr;
+
+  if (connection) {
+    hand_out(*connection, std::move(on_ready));
+    return;
+  }
+  if (f_failed) {
+    // Failure is reported from the event loop, the same as the connection
+    // errors, so the caller is not re-entered
+    schedule_dispatch();
+  } else {
+    s3_log(S3_LOG_DEBUG, "", "All %u connections to Auth server are busy\n",
+           max_connections);
+    s3_stats_inc("auth_pool_queued_request_count");
+  }
+
+  waiters.push_back(Waiter{owner, std::move(on_ready), S3Timer()});
+  waiters.back().queue_timer.start();
+}
+
+void S3AuthConnectionPool::release(evhtp_connection_t *conn,
+                                   bool f_reusable) {
+  Connection *connection = find(conn);
+
+  if (!connection) {
+    s3_log(S3_LOG_WARN, "", "Unknown connection %p to Auth server\n",
+           (void *)conn);
+    return;
+  }
+  if (f_reusable) {
+    connection->returning = true;
+    ++connection->served;
+
+    // Hooks of the request have been removed along with the pool's one
+    watch_connection(conn);
+  } else {
+    remove(conn);
+    free_connection(conn);
+  }
+  schedule_dispatch();
+}
+
+void S3AuthConnectionPool::forget(evhtp_connection_t *conn) {
+  if (!remove(conn)) {
+    return;
+  }
+  s3_log(S3_LOG_INFO, "",
+         "Connection to Auth server failed, closing idle connections\n");
+  close_idle_connections(::time(nullptr));
+
+  schedule_dispatch();
+}
+
+void S3AuthConnectionPool::cancel(const void *owner) {
+  waiters.erase(std::remove_if(waiters.begin(), waiters.end(),
+                               [owner](const Waiter &waiter) {
+                  return waiter.owner == owner;
+                }),
+                waiters.end());
+}
+
+unsigned S3AuthConnectionPool::get_busy_count() const {
+  return std::count_if(
+      connections.begin(), connections.end(),
+      [](const Connection &connection) { return connection.busy; });
+}
+
+void S3AuthConnectionPool::close_idle_connections(time_t idle_since_limit) {
+  for (auto it = connections.begin(); it != connections.end();) {
+    if (!it->busy && it->idle_since <= idle_since_limit) {
+      free_connection(it->conn);
+      it = connections.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void S3AuthConnectionPool::schedule_dispatch() {
+  if (!f_dispatch_scheduled) {
+    f_dispatch_scheduled = true;
+    event_active(dispatch_event, EV_TIMEOUT, 0);
+  }
+}
+
+void S3AuthConnectionPool::dispatch() {
+  f_dispatch_scheduled = false;
+  const time_t now = ::time(nullptr);
+
+  for (auto &connection : connections) {
+    if (connection.returning) {
+      connection.returning = false;
+      connection.busy = false;
+      connection.idle_since = now;
+      s3_stats_update_gauge("auth_pool_busy_connections", -1);
+    }
+  }
+
+  while (!waiters.empty()) {
+    bool f_failed = false;
+    Connection *connection = get_connection(f_failed);
+
+    if (!connection && !f_failed) {
+      break;
+    }
+    Waiter waiter = std::move(waiters.front());
+    waiters.pop_front();
+
+    waiter.queue_timer.stop();
+    s3_stats_timing("auth_pool_queue_time",
+                    waiter.queue_timer.elapsed_time_in_millisec());
+
+    if (connection) {
+      hand_out(*connection, std::move(waiter.on_ready));
+    } else {
+      waiter.on_ready(nullptr);
+    }
+  }
+}
+
+void S3AuthConnectionPool::dispatch_cb(evutil_socket_t, short, void *arg) {
+  static_cast<S3AuthConnectionPool *>(arg)->dispatch();
+}
+
+void S3AuthConnectionPool::idle_timer_cb(evutil_socket_t, short, void *arg) {
+  auto *pool = static_cast<S3AuthConnectionPool *>(arg);
+  pool->close_idle_connections(::time(nullptr) - pool->idle_timeout_sec);
+}
+
+evhtp_res S3AuthConnectionPool::on_connection_fini(evhtp_connection_t *conn,
+                                                   void *arg) {
+  auto *pool = static_cast<S3AuthConnectionPool *>(arg);
+
+  s3_log(S3_LOG_DEBUG, "", "Connection %p to Auth server is closed\n",
+         (void *)conn);
+  if (pool->remove(conn)) {
+    pool->schedule_dispatch();
+  }
+  return EVHTP_RES_OK;
+}
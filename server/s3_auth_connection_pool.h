@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_AUTH_CONNECTION_POOL_H__
+#define __S3_SERVER_S3_AUTH_CONNECTION_POOL_H__
+
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include <evhtp.h>
+#include <gtest/gtest_prod.h>
+
+#include "s3_timer.h"
+
+// Keep-alive connections to the auth server, one pool per reactor.
+//
+// S3AuthClient acquires a connection for every request to the auth server
+// and releases it as soon as the response is read. libevhtp client connection
+// carries a single outstanding request, so a connection is either idle or
+// busy; the most recently released idle connection is handed out first, so
+// surplus connections stay idle and get closed after idle timeout. When all
+// the connections are busy and the pool is full, requests wait in FIFO order.
+//
+// Health: a connection closed by the auth server is dropped. When a request
+// fails on a connection, all idle connections are closed as well, since they
+// are likely to be dead too (auth server restart).
+class S3AuthConnectionPool {
+ public:
+  // Called with the connection to send the request over
+  typedef std::function<void(evhtp_connection_t *)> ReadyCallback;
+
+ private:
+  struct Connection {
+    evhtp_connection_t *conn;
+    bool busy;
+    // Released, becomes idle once libevhtp is done with the response
+    bool returning;
+    unsigned served;
+    time_t idle_since;
+  };
+  struct Waiter {
+    const void *owner;
+    ReadyCallback on_ready;
+    S3Timer queue_timer;
+  };
+
+  // The class should have single instance per reactor thread
+  static thread_local S3AuthConnectionPool *p_instance;
+
+  evbase_t *evbase;
+  unsigned max_connections;
+  unsigned idle_timeout_sec;
+
+  std::vector<Connection> connections;
+  std::deque<Waiter> waiters;
+
+  struct event *idle_timer = nullptr;
+  // Released connections are reused from the event loop, not from within
+  // the evhtp callback which has released the connection.
+  struct event *dispatch_event = nullptr;
+
+  bool f_dispatch_scheduled = false;
+
+  Connection *find(evhtp_connection_t *conn);
+  bool remove(evhtp_connection_t *conn);
+  // Idle connection or a new one if the pool is not full, nullptr otherwise.
+  // 'f_failed' is set when a new connection could not be created.
+  Connection *get_connection(bool &f_failed);
+  void hand_out(Connection &connection, ReadyCallback on_ready);
+  void close_idle_connections(time_t idle_since_limit);
+  void schedule_dispatch();
+
+  static void dispatch_cb(evutil_socket_t, short, void *arg);
+  static void idle_timer_cb(evutil_socket_t, short, void *arg);
+  static evhtp_res on_connection_fini(evhtp_connection_t *conn, void *arg);
+
+ protected:
+  virtual evhtp_connection_t *create_connection();
+  virtual void free_connection(evhtp_connection_t *conn);
+  // Sets the hook dropping the connection from the pool when it is freed
+  virtual void watch_connection(evhtp_connection_t *conn);
+
+  void close_all_connections();
+
+  // Makes released connections idle and resumes waiters while there are
+  // idle connections or a room for new ones
+  void dispatch();
+
+ public:
+  // 'max_connections' > 0, 'idle_timeout_sec' == 0 disables idle timeout
+  S3AuthConnectionPool(evbase_t *evbase, unsigned max_connections,
+                       unsigned idle_timeout_sec);
+  virtual ~S3AuthConnectionPool();
+
+  S3AuthConnectionPool(const S3AuthConnectionPool &) = delete;
+  S3AuthConnectionPool &operator=(const S3AuthConnectionPool &) = delete;
+
+  // Pool of the calling reactor, nullptr if pooling is not configured
+  static S3AuthConnectionPool *get_instance() { return p_instance; }
+
+  // 'on_ready' is called right away if there is an idle connection or the
+  // pool is not full, otherwise once a connection is released. It is called
+  // with nullptr from the event loop if a connection cannot be created.
+  void acquire(const void *owner, ReadyCallback on_ready);
+  // Returns the connection once the response is read. Connection which is
+  // not reusable is closed.
+  void release(evhtp_connection_t *conn, bool f_reusable = true);
+  // Connection failed and is being freed by libevhtp
+  void forget(evhtp_connection_t *conn);
+  // Drops requests of the 'owner' waiting for a connection
+  void cancel(const void *owner);
+
+  unsigned get_connection_count() const { return connections.size(); }
+  unsigned get_busy_count() const;
+  size_t get_waiter_count() const { return waiters.size(); }
+
+  FRIEND_TEST(S3AuthConnectionPoolTest, ClosesIdleConnections);
+};
+
+#endif  // __S3_SERVER_S3_AUTH_CONNECTION_POOL_H__
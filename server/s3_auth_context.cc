@@ -26,22 +26,26 @@
 
 extern evhtp_ssl_ctx_t *g_ssl_auth_ctx;
 
+evhtp_connection_t *create_auth_connection(struct event_base *eventbase) {
+  S3Option *option_instance = S3Option::get_instance();
+  std::string ipv4_auth_ip = "ipv4:" + option_instance->get_auth_ip_addr();
+
+  if (option_instance->is_s3_ssl_auth_enabled()) {
+    return evhtp_connection_ssl_new(eventbase, ipv4_auth_ip.c_str(),
+                                    option_instance->get_auth_port(),
+                                    g_ssl_auth_ctx);
+  }
+  return evhtp_connection_new(eventbase, ipv4_auth_ip.c_str(),
+                              option_instance->get_auth_port());
+}
+
 struct s3_auth_op_context *create_basic_auth_op_ctx(
     struct event_base *eventbase) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
-  S3Option *option_instance = S3Option::get_instance();
   struct s3_auth_op_context *ctx =
       (struct s3_auth_op_context *)calloc(1, sizeof(struct s3_auth_op_context));
   ctx->evbase = eventbase;
-  std::string ipv4_auth_ip = "ipv4:" + option_instance->get_auth_ip_addr();
-  if (option_instance->is_s3_ssl_auth_enabled()) {
-    ctx->conn = evhtp_connection_ssl_new(ctx->evbase, ipv4_auth_ip.c_str(),
-                                         option_instance->get_auth_port(),
-                                         g_ssl_auth_ctx);
-  } else {
-    ctx->conn = evhtp_connection_new(ctx->evbase, ipv4_auth_ip.c_str(),
-                                     option_instance->get_auth_port());
-  }
+  ctx->conn = create_auth_connection(ctx->evbase);
 
   ctx->auth_request = evhtp_request_new(NULL, ctx->evbase);
 
@@ -49,6 +53,18 @@ struct s3_auth_op_context *create_basic_auth_op_ctx(
   return ctx;
 }
 
+struct s3_auth_op_context *create_pooled_auth_op_ctx(
+    struct event_base *eventbase) {
+  s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
+  struct s3_auth_op_context *ctx =
+      (struct s3_auth_op_context *)calloc(1, sizeof(struct s3_auth_op_context));
+  ctx->evbase = eventbase;
+  ctx->auth_request = evhtp_request_new(NULL, ctx->evbase);
+
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+  return ctx;
+}
+
 int free_basic_auth_client_op_ctx(struct s3_auth_op_context *ctx) {
   s3_log(S3_LOG_DEBUG, "", "Called\n");
   free(ctx);
@@ -38,6 +38,12 @@ struct s3_auth_op_context {
 struct s3_auth_op_context* create_basic_auth_op_ctx(
     struct event_base* eventbase);
 
+// Context without connection, it is taken from S3AuthConnectionPool
+struct s3_auth_op_context* create_pooled_auth_op_ctx(
+    struct event_base* eventbase);
+
+evhtp_connection_t* create_auth_connection(struct event_base* eventbase);
+
 int free_basic_auth_client_op_ctx(struct s3_auth_op_context* ctx);
 
 EXTERN_C_BLOCK_END
@@ -58,6 +58,10 @@ const std::string &S3AuthResponseSuccess::get_request_id() {
 
 const std::string &S3AuthResponseSuccess::get_acl() { return acl; }
 
+const std::string &S3AuthResponseSuccess::get_signing_key() {
+  return signing_key;
+}
+
 void S3AuthResponseSuccess::set_auth_parameters(xmlNode *child_node) {
   xmlChar *key;
   if (child_node == NULL) {
@@ -91,6 +95,10 @@ void S3AuthResponseSuccess::set_auth_parameters(xmlNode *child_node) {
     } else if ((!xmlStrcmp(child_node->name, (const xmlChar *)"ACL"))) {
       s3_log(S3_LOG_DEBUG, "", "ACL =%s\n", (const char *)key);
       acl = (const char *)key;
+    } else if ((!xmlStrcmp(child_node->name,
+                           (const xmlChar *)"SigningKey"))) {
+      s3_log(S3_LOG_DEBUG, "", "SigningKey received\n");
+      signing_key = (const char *)key;
     } else if ((!xmlStrcmp(child_node->name,
                            (const xmlChar *)"AllUserRequest"))) {
       //<Alluserrequest> true/false </Alluserrequest>
@@ -41,6 +41,7 @@ class S3AuthResponseSuccess {
   std::string request_id;
   std::string acl;
   std::string email;
+  std::string signing_key;
   bool alluserrequest;
 
   bool parse_and_validate();
@@ -59,6 +60,8 @@ class S3AuthResponseSuccess {
   const std::string& get_signature_sha256();
   const std::string& get_request_id();
   const std::string& get_acl();
+  // Hex encoded SigV4 signing key, returned only if it was requested
+  const std::string& get_signing_key();
 
   FRIEND_TEST(S3AuthResponseSuccessTest, ConstructorTest);
   FRIEND_TEST(S3AuthResponseSuccessTest, GetUserName);
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+#include <strings.h>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "s3_aws_v4_signature.h"
+
+const char* const S3AwsV4Signature::algorithm = "AWS4-HMAC-SHA256";
+
+// Same as Java String::split(), trailing empty strings are dropped
+static std::vector<std::string> split(const std::string& str, char delim) {
+  std::vector<std::string> tokens;
+  size_t start = 0;
+
+  for (;;) {
+    const size_t pos = str.find(delim, start);
+    tokens.push_back(str.substr(start, pos - start));
+    if (std::string::npos == pos) {
+      break;
+    }
+    start = pos + 1;
+  }
+  while (!tokens.empty() && tokens.back().empty()) {
+    tokens.pop_back();
+  }
+  return tokens;
+}
+
+// The auth server keeps request data in case insensitive map
+static const std::string* find_value(
+    const std::map<std::string, std::string>& request_data,
+    const char* key) {
+  for (const auto& key_val : request_data) {
+    if (!strcasecmp(key_val.first.c_str(), key)) {
+      return &key_val.second;
+    }
+  }
+  return nullptr;
+}
+
+static std::string trim(const std::string& str) {
+  const size_t first = str.find_first_not_of(" \t\r\n");
+  if (std::string::npos == first) {
+    return "";
+  }
+  const size_t last = str.find_last_not_of(" \t\r\n");
+  return str.substr(first, last - first + 1);
+}
+
+bool S3AwsV4Signature::parse_authorization_header(
+    const std::string& header_value) {
+  // <algorithm> Credential=...,SignedHeaders=...,Signature=...
+  const size_t alg_len = strlen(algorithm);
+  if (header_value.compare(0, alg_len, algorithm) != 0 ||
+      header_value.length() <= alg_len || header_value[alg_len] != ' ') {
+    return false;
+  }
+  const auto tokens = split(header_value.substr(alg_len + 1), ',');
+  if (tokens.size() < 3) {
+    return false;
+  }
+  std::string credential;
+  for (const auto& token : tokens) {
+    const std::string param = trim(token);
+    const size_t pos = param.find('=');
+
+    if (std::string::npos == pos) {
+      return false;
+    }
+    const std::string name = param.substr(0, pos);
+
+    if ("Credential" == name) {
+      credential = param.substr(pos + 1);
+    } else if ("SignedHeaders" == name) {
+      signed_headers = param.substr(pos + 1);
+    } else if ("Signature" == name) {
+      signature = param.substr(pos + 1);
+    }
+  }
+  const size_t pos = credential.find('/');
+  if (std::string::npos == pos) {
+    return false;
+  }
+  access_key = credential.substr(0, pos);
+  credential_scope = credential.substr(pos + 1);
+
+  const auto scope = split(credential_scope, '/');
+  if (scope.size() != 4 || scope[3] != "aws4_request") {
+    return false;
+  }
+  date = scope[0];
+  region = scope[1];
+  service = scope[2];
+
+  return !access_key.empty() && !signed_headers.empty() && !signature.empty();
+}
+
+std::string S3AwsV4Signature::get_signing_key_id() const {
+  return access_key + '/' + credential_scope;
+}
+
+bool S3AwsV4Signature::is_locally_verifiable(
+    const std::map<std::string, std::string>& request_data, time_t now) const {
+
+  if (find_value(request_data, "x-amz-security-token") ||
+      !find_value(request_data, "x-amz-content-sha256")) {
+    return false;
+  }
+  const std::string* p_request_date = find_value(request_data, "x-amz-date");
+  if (!p_request_date || p_request_date->compare(0, date.length(), date)) {
+    return false;
+  }
+  struct tm tm_request = {};
+  const char* end = strptime(p_request_date->c_str(), "%Y%m%dT%H%M%SZ",
+                             &tm_request);
+  if (!end || *end) {
+    return false;
+  }
+  const time_t request_time = timegm(&tm_request);
+  if (request_time > now + max_time_skew_sec ||
+      request_time < now - max_time_skew_sec) {
+    return false;
+  }
+  for (const auto& header : split(signed_headers, ';')) {
+    if (!find_value(request_data, header.c_str()) &&
+        strcasecmp(header.c_str(), "connection")) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string S3AwsV4Signature::create_canonical_request(
+    const std::map<std::string, std::string>& request_data) const {
+  static const std::string empty;
+
+  const std::string* p_value = find_value(request_data, "Method");
+  std::string canonical_request = p_value ? *p_value : empty;
+  canonical_request += '\n';
+
+  p_value = find_value(request_data, "ClientAbsoluteUri");
+  canonical_request += p_value ? *p_value : empty;
+  canonical_request += '\n';
+
+  // Query parameters are already URI encoded by S3AuthClient
+  p_value = find_value(request_data, "ClientQueryParams");
+  if (p_value && !p_value->empty()) {
+    std::map<std::string, std::string> query_params;
+
+    for (const auto& param : split(*p_value, '&')) {
+      const auto name_val = split(param, '=');
+
+      if (name_val.size() == 2) {
+        query_params[name_val[0]] = name_val[1];
+      } else {
+        query_params[name_val.empty() ? empty : name_val[0]] = empty;
+      }
+    }
+    bool first = true;
+    for (const auto& name_val : query_params) {
+      if (!first) {
+        canonical_request += '&';
+      }
+      first = false;
+      canonical_request += name_val.first;
+      canonical_request += '=';
+      canonical_request += name_val.second;
+    }
+  }
+  canonical_request += '\n';
+
+  for (const auto& header : split(signed_headers, ';')) {
+    p_value = find_value(request_data, header.c_str());
+
+    if (p_value) {
+      canonical_request += header;
+      canonical_request += ':';
+      canonical_request += trim(*p_value);
+    } else if (!strcasecmp(header.c_str(), "connection")) {
+      canonical_request += "connection:Keep-Alive";
+    }
+    canonical_request += '\n';
+  }
+  canonical_request += '\n';
+  canonical_request += signed_headers;
+  canonical_request += '\n';
+
+  // Either payload hash or STREAMING-AWS4-HMAC-SHA256-PAYLOAD
+  p_value = find_value(request_data, "x-amz-content-sha256");
+  if (p_value) {
+    canonical_request += *p_value;
+  }
+  return canonical_request;
+}
+
+std::string S3AwsV4Signature::create_string_to_sign(
+    const std::map<std::string, std::string>& request_data) const {
+  const std::string* p_request_date = find_value(request_data, "x-amz-date");
+
+  std::string string_to_sign = algorithm;
+  string_to_sign += '\n';
+  string_to_sign += p_request_date ? *p_request_date : "";
+  string_to_sign += '\n';
+  string_to_sign += credential_scope;
+  string_to_sign += '\n';
+  string_to_sign += sha256_hex(create_canonical_request(request_data));
+
+  return string_to_sign;
+}
+
+bool S3AwsV4Signature::verify(
+    const std::string& signing_key,
+    const std::map<std::string, std::string>& request_data) const {
+  return is_same_signature(
+      to_hex(hmac_sha256(signing_key, create_string_to_sign(request_data))),
+      signature);
+}
+
+std::string S3AwsV4Signature::create_chunk_string_to_sign(
+    const std::string& request_date, const std::string& prev_signature,
+    const std::string& chunk_sha256) const {
+  // SHA256 of empty string, chunks have no headers of their own
+  static const char empty_sha256[] =
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+
+  std::string string_to_sign = algorithm;
+  string_to_sign += "-PAYLOAD\n";
+  string_to_sign += request_date;
+  string_to_sign += '\n';
+  string_to_sign += credential_scope;
+  string_to_sign += '\n';
+  string_to_sign += prev_signature;
+  string_to_sign += '\n';
+  string_to_sign += empty_sha256;
+  string_to_sign += '\n';
+  string_to_sign += chunk_sha256;
+
+  return string_to_sign;
+}
+
+bool S3AwsV4Signature::verify_chunk(const std::string& signing_key,
+                                    const std::string& request_date,
+                                    const std::string& prev_signature,
+                                    const std::string& chunk_sha256,
+                                    const std::string& chunk_signature) const {
+  return is_same_signature(
+      to_hex(hmac_sha256(signing_key,
+                         create_chunk_string_to_sign(
+                             request_date, prev_signature, chunk_sha256))),
+      chunk_signature);
+}
+
+bool S3AwsV4Signature::is_same_signature(const std::string& calculated,
+                                         const std::string& received) {
+  // Not a secret comparison, but keep it constant time anyway
+  if (calculated.length() != received.length()) {
+    return false;
+  }
+  unsigned char diff = 0;
+  for (size_t i = 0; i < calculated.length(); ++i) {
+    diff |= calculated[i] ^ received[i];
+  }
+  return !diff;
+}
+
+std::string S3AwsV4Signature::derive_signing_key(const std::string& secret_key,
+                                                 const std::string& date,
+                                                 const std::string& region,
+                                                 const std::string& service) {
+  const std::string k_date = hmac_sha256("AWS4" + secret_key, date);
+  const std::string k_region = hmac_sha256(k_date, region);
+  const std::string k_service = hmac_sha256(k_region, service);
+  return hmac_sha256(k_service, "aws4_request");
+}
+
+std::string S3AwsV4Signature::hmac_sha256(const std::string& key,
+                                          const std::string& data) {
+  unsigned char md[EVP_MAX_MD_SIZE];
+  unsigned md_len = 0;
+
+  HMAC(EVP_sha256(), key.data(), (int)key.length(),
+       (const unsigned char*)data.data(), data.length(), md, &md_len);
+
+  return std::string((const char*)md, md_len);
+}
+
+std::string S3AwsV4Signature::sha256_hex(const std::string& data) {
+  unsigned char md[SHA256_DIGEST_LENGTH];
+
+  SHA256((const unsigned char*)data.data(), data.length(), md);
+
+  return to_hex(std::string((const char*)md, sizeof(md)));
+}
+
+std::string S3AwsV4Signature::to_hex(const std::string& data) {
+  static const char hex_chars[] = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(data.length() * 2);
+
+  for (unsigned char c : data) {
+    hex += hex_chars[c >> 4];
+    hex += hex_chars[c & 0xf];
+  }
+  return hex;
+}
+
+std::string S3AwsV4Signature::from_hex(const std::string& hex) {
+  if (hex.length() % 2) {
+    return "";
+  }
+  std::string data;
+  data.reserve(hex.length() / 2);
+
+  for (size_t i = 0; i < hex.length(); i += 2) {
+    const char sz_byte[3] = {hex[i], hex[i + 1], '\0'};
+    char* end = nullptr;
+    const long val = strtol(sz_byte, &end, 16);
+
+    if (*end || !isxdigit(sz_byte[0])) {
+      return "";
+    }
+    data += (char)val;
+  }
+  return data;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_AWS_V4_SIGNATURE_H__
+#define __S3_SERVER_S3_AWS_V4_SIGNATURE_H__
+
+#include <ctime>
+#include <map>
+#include <string>
+
+// AWS Signature Version 4 of a request signed with the "Authorization"
+// header.
+//
+// Canonical request and string to sign are built exactly like the auth server
+// does (see AWSV4Sign.java), from the same key=val pairs which S3AuthClient
+// sends to it: request headers plus "Method", "ClientAbsoluteUri" and
+// "ClientQueryParams". So a signing key, once handed out by the auth server,
+// is enough to verify further requests of the same credential scope
+// in-process.
+class S3AwsV4Signature {
+  std::string access_key;
+  std::string date;
+  std::string region;
+  std::string service;
+  std::string credential_scope;
+  std::string signed_headers;
+  std::string signature;
+
+ public:
+  static const char* const algorithm;
+  // Maximal allowed difference between the request time and the local time
+  static const time_t max_time_skew_sec = 15 * 60;
+
+  // Parses "AWS4-HMAC-SHA256 Credential=<access key>/<date>/<region>/
+  // <service>/aws4_request, SignedHeaders=<h1;h2>, Signature=<hex>".
+  // Returns false for V2 signatures and malformed headers.
+  bool parse_authorization_header(const std::string& header_value);
+
+  const std::string& get_access_key() const { return access_key; }
+  const std::string& get_date() const { return date; }
+  const std::string& get_region() const { return region; }
+  const std::string& get_service() const { return service; }
+  const std::string& get_credential_scope() const { return credential_scope; }
+  const std::string& get_signed_headers() const { return signed_headers; }
+  const std::string& get_signature() const { return signature; }
+
+  // Access key and credential scope, identifies the signing key
+  std::string get_signing_key_id() const;
+
+  // Checks that the request has everything the local verification needs:
+  // x-amz-date within max_time_skew_sec of 'now', x-amz-content-sha256 and
+  // all signed headers. Requests with temporary credentials are left to the
+  // auth server, since the session token has to be checked there.
+  bool is_locally_verifiable(
+      const std::map<std::string, std::string>& request_data,
+      time_t now) const;
+
+  std::string create_canonical_request(
+      const std::map<std::string, std::string>& request_data) const;
+  std::string create_string_to_sign(
+      const std::map<std::string, std::string>& request_data) const;
+
+  // 'signing_key' is the binary (not hex encoded) derived key
+  bool verify(const std::string& signing_key,
+              const std::map<std::string, std::string>& request_data) const;
+
+  // aws-chunked payload (STREAMING-AWS4-HMAC-SHA256-PAYLOAD): every chunk is
+  // signed over the signature of the previous one, the seed signature of
+  // the "Authorization" header being the first link of the chain.
+  // 'request_date' is x-amz-date, 'chunk_sha256' is hex encoded.
+  std::string create_chunk_string_to_sign(
+      const std::string& request_date, const std::string& prev_signature,
+      const std::string& chunk_sha256) const;
+  bool verify_chunk(const std::string& signing_key,
+                    const std::string& request_date,
+                    const std::string& prev_signature,
+                    const std::string& chunk_sha256,
+                    const std::string& chunk_signature) const;
+
+  // kSigning = HMAC(HMAC(HMAC(HMAC("AWS4" + secret, date), region),
+  //                      service), "aws4_request")
+  static std::string derive_signing_key(const std::string& secret_key,
+                                        const std::string& date,
+                                        const std::string& region,
+                                        const std::string& service);
+  static std::string hmac_sha256(const std::string& key,
+                                 const std::string& data);
+  static std::string sha256_hex(const std::string& data);
+  // Constant time comparison of hex encoded signatures
+  static bool is_same_signature(const std::string& calculated,
+                                const std::string& received);
+
+  static std::string to_hex(const std::string& data);
+  // Returns empty string if 'hex' is not a valid hex encoded string
+  static std::string from_hex(const std::string& hex);
+};
+
+#endif  // __S3_SERVER_S3_AWS_V4_SIGNATURE_H__
@@ -48,7 +48,8 @@ void S3BucketAPIHandler::create_action() {
       switch (request->http_verb()) {
         case S3HttpVerb::GET:
           request->set_action_str("GetBucketLocation");
-          action = std::make_shared<S3GetBucketlocationAction>(request);
+          action = s3_arena_make_shared<S3GetBucketlocationAction>(
+              request->get_arena(), request);
           s3_stats_inc("get_bucket_location_request_count");
           break;
         case S3HttpVerb::PUT:
@@ -61,7 +62,8 @@ void S3BucketAPIHandler::create_action() {
       break;
     case S3OperationCode::multidelete:
       request->set_action_str("DeleteMultipleObjects");
-      action = std::make_shared<S3DeleteMultipleObjectsAction>(request);
+      action = s3_arena_make_shared<S3DeleteMultipleObjectsAction>(
+          request->get_arena(), request);
       s3_stats_inc("delete_multiobject_request_count");
       break;
     case S3OperationCode::acl:
@@ -69,12 +71,14 @@ void S3BucketAPIHandler::create_action() {
       switch (request->http_verb()) {
         case S3HttpVerb::GET:
           request->set_action_str("GetBucketAcl");
-          action = std::make_shared<S3GetBucketACLAction>(request);
+          action = s3_arena_make_shared<S3GetBucketACLAction>(
+              request->get_arena(), request);
           s3_stats_inc("get_bucket_acl_request_count");
           break;
         case S3HttpVerb::PUT:
           request->set_action_str("PutBucketAcl");
-          action = std::make_shared<S3PutBucketACLAction>(request);
+          action = s3_arena_make_shared<S3PutBucketACLAction>(
+              request->get_arena(), request);
           s3_stats_inc("put_bucket_acl_request_count");
           break;
         default:
@@ -87,7 +91,8 @@ void S3BucketAPIHandler::create_action() {
       switch (request->http_verb()) {
         case S3HttpVerb::GET:
           request->set_action_str("ListBucketMultipartUploads");
-          action = std::make_shared<S3GetMultipartBucketAction>(request);
+          action = s3_arena_make_shared<S3GetMultipartBucketAction>(
+              request->get_arena(), request);
           s3_stats_inc("get_multipart_bucket_request_count");
           break;
         default:
@@ -100,17 +105,20 @@ void S3BucketAPIHandler::create_action() {
       switch (request->http_verb()) {
         case S3HttpVerb::GET:
           request->set_action_str("GetBucketPolicy");
-          action = std::make_shared<S3GetBucketPolicyAction>(request);
+          action = s3_arena_make_shared<S3GetBucketPolicyAction>(
+              request->get_arena(), request);
           s3_stats_inc("get_bucket_policy_request_count");
           break;
         case S3HttpVerb::PUT:
           request->set_action_str("PutBucketPolicy");
-          action = std::make_shared<S3PutBucketPolicyAction>(request);
+          action = s3_arena_make_shared<S3PutBucketPolicyAction>(
+              request->get_arena(), request);
           s3_stats_inc("put_bucket_policy_request_count");
           break;
         case S3HttpVerb::DELETE:
           request->set_action_str("DeleteBucketPolicy");
-          action = std::make_shared<S3DeleteBucketPolicyAction>(request);
+          action = s3_arena_make_shared<S3DeleteBucketPolicyAction>(
+              request->get_arena(), request);
           s3_stats_inc("delete_bucket_policy_request_count");
           break;
         default:
@@ -168,17 +176,20 @@ void S3BucketAPIHandler::create_action() {
       switch (request->http_verb()) {
         case S3HttpVerb::GET:
           request->set_action_str("GetBucketTagging");
-          action = std::make_shared<S3GetBucketTaggingAction>(request);
+          action = s3_arena_make_shared<S3GetBucketTaggingAction>(
+              request->get_arena(), request);
           s3_stats_inc("get_bucket_tagging_count");
           break;
         case S3HttpVerb::PUT:
           request->set_action_str("PutBucketTagging");
-          action = std::make_shared<S3PutBucketTaggingAction>(request);
+          action = s3_arena_make_shared<S3PutBucketTaggingAction>(
+              request->get_arena(), request);
           s3_stats_inc("put_bucket_tagging_count");
           break;
         case S3HttpVerb::DELETE:
           request->set_action_str("DeleteBucketTagging");
-          action = std::make_shared<S3DeleteBucketTaggingAction>(request);
+          action = s3_arena_make_shared<S3DeleteBucketTaggingAction>(
+              request->get_arena(), request);
           s3_stats_inc("delete_bucket_tagging_count");
           break;
         default:
@@ -295,7 +306,8 @@ void S3BucketAPIHandler::create_action() {
       switch (request->http_verb()) {
         case S3HttpVerb::HEAD:
           request->set_action_str("HeadBucket");
-          action = std::make_shared<S3HeadBucketAction>(request);
+          action = s3_arena_make_shared<S3HeadBucketAction>(
+              request->get_arena(), request);
           s3_stats_inc("head_bucket_request_count");
           break;
         case S3HttpVerb::GET:
@@ -303,23 +315,27 @@ void S3BucketAPIHandler::create_action() {
           if (!request->has_query_param_key("list-type")) {
             // List Objects in bucket
             request->set_action_str("ListBucket");
-            action = std::make_shared<S3GetBucketAction>(request);
+            action = s3_arena_make_shared<S3GetBucketAction>(
+                request->get_arena(), request);
             s3_stats_inc("get_bucket_request_count");
           } else {
             // List Objects (V2) in bucket
             request->set_action_str("ListBucketV2");
-            action = std::make_shared<S3GetBucketActionV2>(request);
+            action = s3_arena_make_shared<S3GetBucketActionV2>(
+                request->get_arena(), request);
             s3_stats_inc("get_bucket_v2_request_count");
           }
           break;
         case S3HttpVerb::PUT:
           request->set_action_str("CreateBucket");
-          action = std::make_shared<S3PutBucketAction>(request);
+          action = s3_arena_make_shared<S3PutBucketAction>(
+              request->get_arena(), request);
           s3_stats_inc("put_bucket_request_count");
           break;
         case S3HttpVerb::DELETE:
           request->set_action_str("DeleteBucket");
-          action = std::make_shared<S3DeleteBucketAction>(request);
+          action = s3_arena_make_shared<S3DeleteBucketAction>(
+              request->get_arena(), request);
           s3_stats_inc("delete_bucket_request_count");
           break;
         case S3HttpVerb::POST:
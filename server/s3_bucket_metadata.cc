@@ -28,6 +28,7 @@
 #include "s3_iem.h"
 #include "s3_log.h"
 #include "s3_m0_uint128_helper.h"
+#include "s3_metadata_codec.h"
 #include "s3_request_object.h"
 #include "s3_uri_to_motr_oid.h"
 
@@ -170,6 +171,9 @@ std::string S3BucketMetadata::to_json() {
 }
 
 int S3BucketMetadata::from_json(std::string content) {
+  if (S3MetadataDecoder::is_binary(content)) {
+    return from_binary(content);
+  }
   s3_log(S3_LOG_DEBUG, request_id, "Called\n");
   Json::Value newroot;
   Json::Reader reader;
@@ -221,6 +225,119 @@ int S3BucketMetadata::from_json(std::string content) {
   return 0;
 }
 
+// Field tags of binary encoded bucket metadata, must never be reused
+enum S3BucketMetadataField : unsigned {
+  BUCKET_FIELD_BUCKET_NAME = 1,
+  BUCKET_FIELD_SYSTEM_DEFINED = 2,
+  BUCKET_FIELD_USER_DEFINED = 3,
+  BUCKET_FIELD_ACL = 4,
+  BUCKET_FIELD_POLICY = 5,
+  BUCKET_FIELD_TAGS = 6,
+  BUCKET_FIELD_OBJECT_LIST_INDEX_LAYOUT = 7,
+  BUCKET_FIELD_MULTIPART_INDEX_LAYOUT = 8,
+  BUCKET_FIELD_EXTENDED_METADATA_INDEX_LAYOUT = 9,
+  BUCKET_FIELD_VERSION_LIST_INDEX_LAYOUT = 10,
+  BUCKET_FIELD_CREATE_TIMESTAMP = 11
+};
+
+std::string S3BucketMetadata::to_binary() {
+  s3_log(S3_LOG_DEBUG, request_id, "Called\n");
+  S3MetadataEncoder encoder(S3MetadataRecordType::bucket);
+
+  encoder.add(BUCKET_FIELD_BUCKET_NAME, bucket_name);
+  encoder.add_map(BUCKET_FIELD_SYSTEM_DEFINED, system_defined_attribute);
+  encoder.add_map(BUCKET_FIELD_USER_DEFINED, user_defined_attribute);
+  if (encoded_acl.empty()) {
+    encoded_acl = request->get_default_acl();
+  }
+  encoder.add(BUCKET_FIELD_ACL, encoded_acl);
+  // Unlike JSON, policy is stored as is
+  encoder.add(BUCKET_FIELD_POLICY, bucket_policy);
+  encoder.add_map(BUCKET_FIELD_TAGS, bucket_tags);
+
+  encoder.add_raw(BUCKET_FIELD_OBJECT_LIST_INDEX_LAYOUT,
+                  object_list_index_layout);
+  encoder.add_raw(BUCKET_FIELD_MULTIPART_INDEX_LAYOUT, multipart_index_layout);
+  encoder.add_raw(BUCKET_FIELD_EXTENDED_METADATA_INDEX_LAYOUT,
+                  extended_metadata_index_layout);
+  encoder.add_raw(BUCKET_FIELD_VERSION_LIST_INDEX_LAYOUT,
+                  objects_version_list_index_layout);
+
+  S3DateTime current_time;
+  current_time.init_current_time();
+  encoder.add(BUCKET_FIELD_CREATE_TIMESTAMP,
+              current_time.get_isoformat_string());
+
+  return std::move(encoder.get_buffer());
+}
+
+int S3BucketMetadata::from_binary(const std::string& content) {
+  s3_log(S3_LOG_DEBUG, request_id, "Called\n");
+  S3MetadataDecoder decoder(content, S3MetadataRecordType::bucket);
+  S3MetadataField field;
+  unsigned tag;
+  bool ok = true;
+
+  system_defined_attribute.clear();
+  user_defined_attribute.clear();
+  bucket_tags.clear();
+  bucket_policy.clear();
+  encoded_acl.clear();
+  object_list_index_layout = {};
+  multipart_index_layout = {};
+  extended_metadata_index_layout = {};
+  objects_version_list_index_layout = {};
+
+  while (ok && decoder.next(tag, field)) {
+    switch (tag) {
+      case BUCKET_FIELD_BUCKET_NAME:
+        bucket_name = field.to_string();
+        break;
+      case BUCKET_FIELD_SYSTEM_DEFINED:
+        ok = field.to_map(system_defined_attribute);
+        break;
+      case BUCKET_FIELD_USER_DEFINED:
+        ok = field.to_map(user_defined_attribute);
+        break;
+      case BUCKET_FIELD_ACL:
+        encoded_acl = field.to_string();
+        break;
+      case BUCKET_FIELD_POLICY:
+        bucket_policy = field.to_string();
+        break;
+      case BUCKET_FIELD_TAGS:
+        ok = field.to_map(bucket_tags);
+        break;
+      case BUCKET_FIELD_OBJECT_LIST_INDEX_LAYOUT:
+        ok = field.copy_to(object_list_index_layout);
+        break;
+      case BUCKET_FIELD_MULTIPART_INDEX_LAYOUT:
+        ok = field.copy_to(multipart_index_layout);
+        break;
+      case BUCKET_FIELD_EXTENDED_METADATA_INDEX_LAYOUT:
+        ok = field.copy_to(extended_metadata_index_layout);
+        break;
+      case BUCKET_FIELD_VERSION_LIST_INDEX_LAYOUT:
+        ok = field.copy_to(objects_version_list_index_layout);
+        break;
+      default:
+        break;
+    }
+  }
+  if (!ok || !decoder.is_valid() ||
+      s3_fi_is_enabled("bucket_metadata_corrupted")) {
+    s3_log(S3_LOG_ERROR, request_id, "Binary metadata parsing failed.\n");
+    return -1;
+  }
+  user_name = system_defined_attribute["Owner-User"];
+  user_id = system_defined_attribute["Owner-User-id"];
+  account_name = system_defined_attribute["Owner-Account"];
+  account_id = system_defined_attribute["Owner-Account-id"];
+  owner_canonical_id = system_defined_attribute["Owner-Canonical-id"];
+
+  return 0;
+}
+
 void S3BucketMetadata::acl_from_json(std::string acl_json_str) {
   s3_log(S3_LOG_DEBUG, "", "Called\n");
   encoded_acl = std::move(acl_json_str);
@@ -76,6 +76,8 @@ class S3BucketMetadata {
 
   // Streaming to json
   virtual std::string to_json();
+  // Compact alternative to to_json(), see s3_metadata_codec.h
+  std::string to_binary();
 
  protected:
   S3BucketMetadata(std::shared_ptr<S3RequestObject> req,
@@ -145,8 +147,10 @@ class S3BucketMetadata {
   virtual void remove(std::function<void(void)> on_success,
                       std::function<void(void)> on_failed);
 
+  // Accepts both JSON and binary encoded metadata.
   // returns 0 on success, -1 on parsing error
   virtual int from_json(std::string content);
+  int from_binary(const std::string& content);
 
   virtual S3BucketMetadataState get_state() const { return state; }
 };
@@ -18,7 +18,10 @@
  *
  */
 
+#include <algorithm>
 #include <cassert>
+#include <cinttypes>
+#include <unordered_map>
 
 #define S3_BUCKET_METADATA_CACHE_DEFINITION
 #define S3_BUCKET_METADATA_V1_DEFINITION
@@ -27,9 +30,20 @@
 #include "s3_bucket_metadata_v1.h"
 #include "s3_factory.h"
 #include "s3_log.h"
+#include "s3_option.h"
+#include "s3_post_to_main_loop.h"
 #include "s3_request_object.h"
+#include "s3_stats.h"
 
-S3BucketMetadataCache* S3BucketMetadataCache::p_instance;
+thread_local S3BucketMetadataCache* S3BucketMetadataCache::p_instance;
+std::mutex S3BucketMetadataCache::registry_lock;
+std::vector<S3BucketMetadataCache*> S3BucketMetadataCache::registry;
+
+// Invalidation of a bucket posted to the loop of another cache
+struct S3BucketMetadataInvalidation {
+  S3BucketMetadataCache* p_cache;
+  std::string bucket_name;
+};
 
 std::unique_ptr<S3BucketMetadataV1>
 S3MotrBucketMetadataFactory::create_motr_bucket_metadata_obj(
@@ -38,6 +52,59 @@ S3MotrBucketMetadataFactory::create_motr_bucket_metadata_obj(
   return std::unique_ptr<S3BucketMetadataV1>(new S3BucketMetadataV1(src));
 }
 
+// Intrusive doubly linked list of cache items, most recent at the head.
+// Links are members of Item, so moving an item costs no allocation.
+template <S3BucketMetadataCache::Item* S3BucketMetadataCache::Item::*Prev,
+          S3BucketMetadataCache::Item* S3BucketMetadataCache::Item::*Next>
+class S3BucketMetadataCache::Lru {
+  Item* head = nullptr;
+  Item* tail = nullptr;
+
+ public:
+  Item* front() const { return head; }
+  Item* back() const { return tail; }
+  static Item* prev(Item* p_item) { return p_item->*Prev; }
+
+  void push_front(Item* p_item) {
+    p_item->*Prev = nullptr;
+    p_item->*Next = head;
+    if (head) {
+      head->*Prev = p_item;
+    } else {
+      tail = p_item;
+    }
+    head = p_item;
+  }
+
+  void erase(Item* p_item) {
+    if (p_item->*Prev) {
+      (p_item->*Prev)->*Next = p_item->*Next;
+    } else {
+      head = p_item->*Next;
+    }
+    if (p_item->*Next) {
+      (p_item->*Next)->*Prev = p_item->*Prev;
+    } else {
+      tail = p_item->*Prev;
+    }
+    p_item->*Prev = p_item->*Next = nullptr;
+  }
+
+  void move_to_front(Item* p_item) {
+    if (head != p_item) {
+      erase(p_item);
+      push_front(p_item);
+    }
+  }
+};
+
+struct S3BucketMetadataCache::Shard {
+  std::unordered_map<std::string, std::unique_ptr<Item> > items;
+
+  Lru<&Item::access_prev, &Item::access_next> sorted_by_access;
+  Lru<&Item::update_prev, &Item::update_next> sorted_by_update;
+};
+
 S3BucketMetadataCache::Item::Item(const S3BucketMetadata& src)
     : p_value(new S3BucketMetadata(src)) {
 
@@ -62,6 +129,11 @@ inline const std::string& S3BucketMetadataCache::Item::get_bucket_name() const {
   return p_value->get_bucket_name();
 }
 
+inline S3BucketMetadataState S3BucketMetadataCache::Item::get_state() const {
+  assert(p_value);
+  return p_value->get_state();
+}
+
 void S3BucketMetadataCache::Item::on_load(S3BucketMetadataState state) {
   s3_log(S3_LOG_DEBUG, nullptr, "%s Entry", __func__);
   assert(p_engine_load);
@@ -89,8 +161,27 @@ void S3BucketMetadataCache::Item::on_done(S3BucketMetadataState state) {
   p_engine_modify.reset();
 
   update_time = Clock::now();
+  if (stale) {
+    // Changed by another reactor meanwhile, the next fetch reloads it
+    update_time = TimePoint();
+    stale = false;
+  }
   S3BucketMetadataCache::p_instance->updated(this);
 
+  if (CurrentOp::saving == current_op || CurrentOp::deleting == current_op) {
+    S3BucketMetadataCache::p_instance->invalidate_peers(
+        p_value->get_bucket_name());
+  }
+
+  const bool failed = S3BucketMetadataState::failed == state ||
+                      S3BucketMetadataState::failed_to_launch == state;
+  // Fetches queued after the entry became stale wait for a new load, unless
+  // this is a failure or the result of our own save or remove
+  const bool reload = !reload_waiters.empty() && !failed &&
+                      CurrentOp::fetching == current_op;
+  if (!reload) {
+    move_reload_waiters();
+  }
   while (!fetch_waiters.empty()) {
 
     auto on_fetch = std::move(fetch_waiters.front());
@@ -106,59 +197,104 @@ void S3BucketMetadataCache::Item::on_done(S3BucketMetadataState state) {
     auto on_changed = std::move(this->on_changed);
     on_changed(state);
   }
-  if (S3BucketMetadataState::failed == state ||
-      S3BucketMetadataState::failed_to_launch == state ||
-      CurrentOp::deleting == current_op) {
+  if (failed || CurrentOp::deleting == current_op) {
 
     S3BucketMetadataCache::p_instance->remove_item(p_value->get_bucket_name());
+
+  } else if (reload) {
+    s3_log(S3_LOG_DEBUG, nullptr,
+           "Bucket \"%s\" changed during the load, loading it again",
+           p_value->get_bucket_name().c_str());
+
+    move_reload_waiters();
+    // A fetch handler could have launched an operation already
+    if (!p_engine_load && !p_engine_modify) {
+      load();
+    }
   }
   s3_log(S3_LOG_DEBUG, nullptr, "%s Exit", __func__);
 }
 
+void S3BucketMetadataCache::Item::move_reload_waiters() {
+  while (!reload_waiters.empty()) {
+    fetch_waiters.push(std::move(reload_waiters.front()));
+    reload_waiters.pop();
+  }
+}
+
+void S3BucketMetadataCache::Item::load() {
+  p_engine_load = S3BucketMetadataCache::p_instance->create_engine(*p_value);
+
+  p_engine_load->load(*p_value,
+                      std::bind(&S3BucketMetadataCache::Item::on_load, this,
+                                std::placeholders::_1));
+  current_op = CurrentOp::fetching;
+}
+
 void S3BucketMetadataCache::Item::fetch(const S3BucketMetadata& src,
                                         FetchHandlerType on_fetch) {
   s3_log(S3_LOG_DEBUG, src.get_request_id(), "%s Entry", __func__);
 
-  fetch_waiters.push(std::move(on_fetch));
+  auto* const p_cache = S3BucketMetadataCache::p_instance;
 
   const auto seconds_lasted = std::chrono::duration_cast<std::chrono::seconds>(
       access_time - update_time).count();
+  const bool is_busy = p_engine_modify || p_engine_load;
+
+  if (!p_cache->disabled && get_state() == S3BucketMetadataState::present) {
+
+    if (seconds_lasted < p_cache->expire_interval_sec) {
+      s3_log(S3_LOG_DEBUG, src.get_request_id(),
+             "Using cached bucket metadata for \"%s\"",
+             src.get_bucket_name().c_str());
+
+      if (seconds_lasted >= p_cache->refresh_interval_sec && !is_busy) {
+        // Refresh ahead: the request is served with current value, the
+        // reload result will be used by subsequent requests
+        s3_log(S3_LOG_DEBUG, src.get_request_id(),
+               "Cache entry for \"%s\" is refreshed in background",
+               src.get_bucket_name().c_str());
+        ++p_cache->counters.refreshes;
+        s3_stats_inc("bucket_metadata_cache_refresh_count");
+        load();
+      }
+      ++p_cache->counters.hits;
+      s3_stats_inc("bucket_metadata_cache_hit_count");
 
-  const bool is_expired =
-      seconds_lasted >= S3BucketMetadataCache::p_instance->expire_interval_sec;
+      on_fetch(S3BucketMetadataState::present, *p_value);
 
-  if (is_expired) {
+      s3_log(S3_LOG_DEBUG, nullptr, "%s Exit", __func__);
+      return;
+    }
     s3_log(S3_LOG_DEBUG, src.get_request_id(),
            "Cache entry for \"%s\" is expired", src.get_bucket_name().c_str());
-  }
-  if (!is_expired && !S3BucketMetadataCache::p_instance->disabled &&
-      p_value->get_state() == S3BucketMetadataState::present) {
+
+  } else if (!p_cache->disabled && !is_busy &&
+             get_state() == S3BucketMetadataState::missing &&
+             seconds_lasted < p_cache->negative_expire_interval_sec) {
 
     s3_log(S3_LOG_DEBUG, src.get_request_id(),
-           "Using cached bucket metadata for \"%s\"",
+           "Bucket \"%s\" is cached as missing",
            src.get_bucket_name().c_str());
 
-    // We have to "retain" one S3 request to avoid a case when number of
-    // requests to Motr exceeds the number of requests to S3server
-    if (seconds_lasted <
-            S3BucketMetadataCache::p_instance->refresh_interval_sec ||
-        fetch_waiters.size() > 1) {
+    ++p_cache->counters.negative_hits;
+    s3_stats_inc("bucket_metadata_cache_negative_hit_count");
 
-      on_fetch = std::move(fetch_waiters.front());
-      fetch_waiters.pop();
-
-      on_fetch(S3BucketMetadataState::present, *p_value);
+    on_fetch(S3BucketMetadataState::missing, *p_value);
 
-      s3_log(S3_LOG_DEBUG, nullptr, "%s Exit", __func__);
-      return;
+    s3_log(S3_LOG_DEBUG, nullptr, "%s Exit", __func__);
+    return;
+  }
+  ++p_cache->counters.misses;
+  s3_stats_inc("bucket_metadata_cache_miss_count");
 
-    } else {
-      s3_log(S3_LOG_DEBUG, nullptr,
-             "Cache entry for \"%s\" needs to be refreshed",
-             p_value->get_bucket_name().c_str());
-    }
+  if (stale && p_engine_load && !p_engine_modify) {
+    reload_waiters.push(std::move(on_fetch));
+  } else {
+    fetch_waiters.push(std::move(on_fetch));
   }
-  if (p_engine_modify || p_engine_load) {
+
+  if (is_busy) {
 
     s3_log(S3_LOG_DEBUG, nullptr,
            "Another operation is in progress for \"%s\" bucket. Updated "
@@ -166,12 +302,7 @@ void S3BucketMetadataCache::Item::fetch(const S3BucketMetadata& src,
            p_value->get_bucket_name().c_str());
 
   } else {
-    p_engine_load = S3BucketMetadataCache::p_instance->create_engine(*p_value);
-
-    p_engine_load->load(*p_value,
-                        std::bind(&S3BucketMetadataCache::Item::on_load, this,
-                                  std::placeholders::_1));
-    current_op = CurrentOp::fetching;
+    load();
   }
   s3_log(S3_LOG_DEBUG, nullptr, "%s Exit", __func__);
 }
@@ -248,11 +379,15 @@ void S3BucketMetadataCache::Item::remove(StateHandlerType on_remove) {
 
 S3BucketMetadataCache::S3BucketMetadataCache(
     unsigned max_cache_size, unsigned expire_interval_sec,
-    unsigned refresh_interval_sec,
+    unsigned refresh_interval_sec, unsigned negative_expire_interval_sec,
+    unsigned n_shards,
     std::shared_ptr<S3MotrBucketMetadataFactory> motr_bucket_metadata_factory)
     : max_cache_size(max_cache_size),
       expire_interval_sec(expire_interval_sec),
-      refresh_interval_sec(refresh_interval_sec) {
+      refresh_interval_sec(refresh_interval_sec),
+      negative_expire_interval_sec(negative_expire_interval_sec),
+      n_shards(n_shards ? n_shards : 1),
+      shards(new Shard[this->n_shards]) {
 
   if (p_instance) {
     s3_log(S3_LOG_FATAL, "",
@@ -263,10 +398,30 @@ S3BucketMetadataCache::S3BucketMetadataCache(
           ? std::move(motr_bucket_metadata_factory)
           : std::make_shared<S3MotrBucketMetadataFactory>();
   p_instance = this;
+
+  // The cache is created on the thread of its reactor
+  evbase = S3Option::get_instance()->get_eventbase();
+
+  std::lock_guard<std::mutex> lock(registry_lock);
+  registry.push_back(this);
 }
 
 S3BucketMetadataCache::~S3BucketMetadataCache() {
-  S3BucketMetadataCache::p_instance = nullptr;
+  s3_log(S3_LOG_INFO, "",
+         "Bucket metadata cache: hits %" PRIu64 ", negative hits %" PRIu64
+         ", misses %" PRIu64 ", refreshes %" PRIu64 ", evictions %" PRIu64
+         "\n",
+         counters.hits, counters.negative_hits, counters.misses,
+         counters.refreshes, counters.evictions);
+  {
+    std::lock_guard<std::mutex> lock(registry_lock);
+    registry.erase(std::remove(registry.begin(), registry.end(), this),
+                   registry.end());
+  }
+  // Caches of other reactors may be destroyed from the main thread
+  if (S3BucketMetadataCache::p_instance == this) {
+    S3BucketMetadataCache::p_instance = nullptr;
+  }
 }
 
 S3BucketMetadataCache* S3BucketMetadataCache::get_instance() {
@@ -277,40 +432,60 @@ S3BucketMetadataCache* S3BucketMetadataCache::get_instance() {
   return p_instance;
 }
 
-void S3BucketMetadataCache::remove_item(std::string bucket_name) {
+unsigned S3BucketMetadataCache::get_shard_index(
+    const std::string& bucket_name) const {
+  return std::hash<std::string>()(bucket_name) % n_shards;
+}
 
-  assert(sorted_by_access.size() == sorted_by_update.size());
-  assert(sorted_by_access.size() == items.size());
+S3BucketMetadataCache::Item* S3BucketMetadataCache::find_item(
+    const std::string& bucket_name) const {
 
+  const auto& items = shards[get_shard_index(bucket_name)].items;
   auto map_it = items.find(bucket_name);
-  assert(items.end() != map_it);
 
-  auto* p_item = (*map_it).second.get();
+  return items.end() != map_it ? map_it->second.get() : nullptr;
+}
+
+void S3BucketMetadataCache::remove_item(const std::string& bucket_name) {
 
-  sorted_by_access.erase(p_item->ptr_access);
-  sorted_by_update.erase(p_item->ptr_update);
-  items.erase(map_it);
+  auto& shard = shards[get_shard_index(bucket_name)];
 
+  auto map_it = shard.items.find(bucket_name);
+  assert(shard.items.end() != map_it);
+
+  auto* p_item = (*map_it).second.get();
+
+  shard.sorted_by_access.erase(p_item);
+  shard.sorted_by_update.erase(p_item);
+  // bucket_name may refer to the item being destroyed
   s3_log(S3_LOG_DEBUG, "",
          "Metadata for \"%s\" has been removed from the cache",
          bucket_name.c_str());
+  shard.items.erase(map_it);
+  --n_items;
 }
 
-bool S3BucketMetadataCache::shrink() {
+bool S3BucketMetadataCache::shrink_shard(Shard& shard) {
 
-  for (auto rit = sorted_by_update.rbegin(); rit != sorted_by_update.rend();
-       ++rit) {
-    auto* p_item = *rit;
+  const auto now = Clock::now();
+
+  for (auto* p_item = shard.sorted_by_update.back(); p_item;
+       p_item = shard.sorted_by_update.prev(p_item)) {
 
     const auto seconds_lasted =
         std::chrono::duration_cast<std::chrono::seconds>(
-            Clock::now() - p_item->update_time).count();
-
-    if (seconds_lasted < expire_interval_sec) {
-
-      s3_log(S3_LOG_DEBUG, "",
-             "There are no expired entries in bucket metadata cache");
-      break;
+            now - p_item->update_time).count();
+
+    const unsigned ttl = (p_item->get_state() == S3BucketMetadataState::missing)
+                             ? negative_expire_interval_sec
+                             : expire_interval_sec;
+    if (seconds_lasted < ttl) {
+      if (seconds_lasted < expire_interval_sec) {
+        s3_log(S3_LOG_DEBUG, "",
+               "There are no expired entries in bucket metadata cache");
+        break;
+      }
+      continue;
     }
     if (p_item->can_remove()) {
 
@@ -319,12 +494,12 @@ bool S3BucketMetadataCache::shrink() {
              p_item->get_bucket_name().c_str());
 
       remove_item(p_item->get_bucket_name());
+      ++counters.evictions;
       return true;
     }
   }
-  for (auto rit = sorted_by_access.rbegin(); rit != sorted_by_access.rend();
-       ++rit) {
-    auto* p_item = *rit;
+  for (auto* p_item = shard.sorted_by_access.back(); p_item;
+       p_item = shard.sorted_by_access.prev(p_item)) {
 
     if (p_item->can_remove()) {
 
@@ -333,6 +508,17 @@ bool S3BucketMetadataCache::shrink() {
              p_item->get_bucket_name().c_str());
 
       remove_item(p_item->get_bucket_name());
+      ++counters.evictions;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool S3BucketMetadataCache::shrink(unsigned first_shard) {
+
+  for (unsigned i = 0; i < n_shards; ++i) {
+    if (shrink_shard(shards[(first_shard + i) % n_shards])) {
       return true;
     }
   }
@@ -345,41 +531,41 @@ S3BucketMetadataCache::Item* S3BucketMetadataCache::get_item(
     const S3BucketMetadata& src) {
 
   const auto& bucket_name = src.get_bucket_name();
-  const bool f_new = (items.end() == items.find(bucket_name));
+  const unsigned shard_index = get_shard_index(bucket_name);
+  auto& shard = shards[shard_index];
+
+  Item* p_item = find_item(bucket_name);
+  const bool f_new = !p_item;
 
   // L-part of the expression below contains the predicted number of cache
   // entries after the function returns (without call of shrink())
-  if (items.size() + f_new > max_cache_size) {
+  if (n_items + f_new > max_cache_size) {
 
     s3_log(S3_LOG_DEBUG, src.get_request_id(), "Bucket metadata cache is full");
 
-    if (!shrink()) {
+    // Evict from the shard of the new entry first, it is the one growing
+    if (!shrink(shard_index)) {
       return nullptr;
     }
   }
-  auto& sptr = items[bucket_name];
-
   if (f_new) {
     s3_log(S3_LOG_DEBUG, src.get_request_id(),
            "Metadata for \"%s\" bucket is absent in cache",
            bucket_name.c_str());
 
-    sptr.reset(new Item(src));
+    p_item = new Item(src);
+    shard.items[bucket_name].reset(p_item);
+    ++n_items;
+
+    shard.sorted_by_update.push_front(p_item);
+    shard.sorted_by_access.push_front(p_item);
   } else {
     s3_log(S3_LOG_DEBUG, src.get_request_id(),
            "Metadata for \"%s\" bucket is cached", bucket_name.c_str());
-  }
-  Item* p_item = sptr.get();
-  p_item->access_time = Clock::now();
 
-  if (f_new) {
-    p_item->ptr_update =
-        sorted_by_update.insert(sorted_by_update.end(), p_item);
-  } else {
-    sorted_by_access.erase(p_item->ptr_access);
+    shard.sorted_by_access.move_to_front(p_item);
   }
-  p_item->ptr_access =
-      sorted_by_access.insert(sorted_by_access.begin(), p_item);
+  p_item->access_time = Clock::now();
 
   return p_item;
 }
@@ -445,9 +631,8 @@ void S3BucketMetadataCache::remove(const S3BucketMetadata& src,
 }
 
 void S3BucketMetadataCache::updated(Item* p_item) {
-  sorted_by_update.erase(p_item->ptr_update);
-  p_item->ptr_update =
-      sorted_by_update.insert(sorted_by_update.begin(), p_item);
+  shards[get_shard_index(p_item->get_bucket_name())]
+      .sorted_by_update.move_to_front(p_item);
 }
 
 std::unique_ptr<S3BucketMetadataV1> S3BucketMetadataCache::create_engine(
@@ -455,3 +640,63 @@ std::unique_ptr<S3BucketMetadataV1> S3BucketMetadataCache::create_engine(
 
   return s3_motr_bucket_metadata_factory->create_motr_bucket_metadata_obj(src);
 }
+
+void S3BucketMetadataCache::invalidate(const std::string& bucket_name) {
+
+  Item* p_item = find_item(bucket_name);
+
+  if (!p_item) {
+    return;
+  }
+  if (p_item->can_remove()) {
+    s3_log(S3_LOG_DEBUG, "", "Cache entry for \"%s\" is invalidated",
+           bucket_name.c_str());
+    remove_item(bucket_name);
+  } else {
+    s3_log(S3_LOG_DEBUG, "",
+           "Cache entry for \"%s\" is busy, marked as stale",
+           bucket_name.c_str());
+    p_item->stale = true;
+    p_item->update_time = TimePoint();
+  }
+}
+
+void S3BucketMetadataCache::invalidate_peers(const std::string& bucket_name) {
+
+  std::lock_guard<std::mutex> lock(registry_lock);
+
+  for (auto* p_cache : registry) {
+    if (p_cache == this || !p_cache->evbase || p_cache->evbase == evbase) {
+      continue;
+    }
+    struct user_event_context* user_ctx = (struct user_event_context*)calloc(
+        1, sizeof(struct user_event_context));
+    user_ctx->app_ctx =
+        new S3BucketMetadataInvalidation{p_cache, bucket_name};
+    user_ctx->evbase = p_cache->evbase;
+
+    S3PostToMainLoop((void*)user_ctx)(invalidate_on_loop);
+  }
+}
+
+void S3BucketMetadataCache::invalidate_on_loop(evutil_socket_t, short events,
+                                               void* user_data) {
+  struct user_event_context* user_ctx = (struct user_event_context*)user_data;
+  auto* p_invalidation = (S3BucketMetadataInvalidation*)user_ctx->app_ctx;
+  bool f_alive;
+  {
+    // The cache might have been destroyed since the event was posted
+    std::lock_guard<std::mutex> lock(registry_lock);
+    f_alive = std::find(registry.begin(), registry.end(),
+                        p_invalidation->p_cache) != registry.end();
+  }
+  if (f_alive) {
+    p_invalidation->p_cache->invalidate(p_invalidation->bucket_name);
+  }
+  delete p_invalidation;
+
+  if (user_ctx->user_event) {
+    event_free((struct event*)user_ctx->user_event);
+  }
+  free(user_ctx);
+}
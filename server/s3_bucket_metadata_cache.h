@@ -22,12 +22,15 @@
 #include "s3_bucket_metadata.h"
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
-#include <list>
-#include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
+#include <vector>
+
+#include <evhtp.h>
 
 #include <gtest/gtest_prod.h>
 
@@ -36,18 +39,47 @@ class S3BucketMetadataV1;
 class S3MotrBucketMetadataFactory;
 class S3RequestObject;
 
+// Cache of bucket metadata, one instance per reactor.
+//
+// Entries are spread among shards by hash of the bucket name. Each shard keeps
+// its entries in a hash table and two intrusive LRU lists (by last access and
+// by last update), so lookup and eviction do not depend on the total number
+// of cached buckets.
+//
+// "Bucket not found" results are cached for negative_expire_interval_sec.
+// Present entries older than refresh_interval_sec are served from the cache
+// while a single reload is launched in background (refresh-ahead).
+//
+// When a save, update or remove completes, the caches of the other reactors
+// are told to drop the entry, so they don't serve stale ACL, policy or
+// versioning state until it expires.
 class S3BucketMetadataCache {
 
-  // The class should have single instance
-  static S3BucketMetadataCache* p_instance;
+  // The class should have single instance per reactor thread
+  static thread_local S3BucketMetadataCache* p_instance;
+
+  // Caches of all reactors, for propagating invalidations
+  static std::mutex registry_lock;
+  static std::vector<S3BucketMetadataCache*> registry;
 
  protected:
-  unsigned max_cache_size, expire_interval_sec, refresh_interval_sec;
+  unsigned max_cache_size, expire_interval_sec, refresh_interval_sec,
+      negative_expire_interval_sec;
   bool disabled = false;
 
  public:
+  struct Counters {
+    uint64_t hits = 0;           // present metadata returned from the cache
+    uint64_t negative_hits = 0;  // "missing" returned from the cache
+    uint64_t misses = 0;         // request had to wait for Motr
+    uint64_t refreshes = 0;      // background reloads launched
+    uint64_t evictions = 0;      // entries dropped to free space
+  };
+
   S3BucketMetadataCache(unsigned max_cache_size, unsigned expire_interval_sec,
                         unsigned refresh_interval_sec,
+                        unsigned negative_expire_interval_sec = 0,
+                        unsigned n_shards = 1,
                         std::shared_ptr<S3MotrBucketMetadataFactory> = {});
 
   S3BucketMetadataCache(const S3BucketMetadataCache&) = delete;
@@ -61,6 +93,9 @@ class S3BucketMetadataCache {
   void disable() { disabled = true; }
   void enable() { disabled = false; }
 
+  size_t size() const { return n_items; }
+  const Counters& get_counters() const { return counters; }
+
   using FetchHandlerType =
       std::function<void(S3BucketMetadataState, const S3BucketMetadata&)>;
   using StateHandlerType = std::function<void(S3BucketMetadataState)>;
@@ -70,27 +105,45 @@ class S3BucketMetadataCache {
   virtual void update(const S3BucketMetadata& src, StateHandlerType on_update);
   virtual void remove(const S3BucketMetadata& src, StateHandlerType on_remove);
 
+  // Drops the entry, or marks it stale if a Motr operation is in progress,
+  // so the next fetch reloads it. Must be called on the loop of the cache.
+  void invalidate(const std::string& bucket_name);
+
  private:
   std::shared_ptr<S3MotrBucketMetadataFactory> s3_motr_bucket_metadata_factory;
 
-  bool shrink();
-  void remove_item(std::string bucket_name);
+  class Item;
+  template <Item* Item::*Prev, Item* Item::*Next>
+  class Lru;
+  struct Shard;
+
+  // Evicts one entry, trying shards starting from the given one
+  bool shrink(unsigned first_shard = 0);
+  bool shrink_shard(Shard& shard);
+  void remove_item(const std::string& bucket_name);
 
   std::unique_ptr<S3BucketMetadataV1> create_engine(
       const S3BucketMetadata& src);
 
-  class Item;
+  unsigned get_shard_index(const std::string& bucket_name) const;
+  Item* find_item(const std::string& bucket_name) const;
   Item* get_item(const S3BucketMetadata& src);
 
   void updated(Item* p_item);
 
-  std::map<std::string, std::unique_ptr<Item> > items;
+  // Posts invalidation of the entry to the loops of all other caches
+  void invalidate_peers(const std::string& bucket_name);
+  static void invalidate_on_loop(evutil_socket_t, short events,
+                                 void* user_data);
 
-  using ListItems = std::list<Item*>;
-  using ListIterator = ListItems::iterator;
+  // Loop the cache belongs to
+  evbase_t* evbase;
 
-  ListItems sorted_by_access;
-  ListItems sorted_by_update;
+  const unsigned n_shards;
+  std::unique_ptr<Shard[]> shards;
+  size_t n_items = 0;
+
+  Counters counters;
 
   using Clock = std::chrono::steady_clock;
   using Duration = Clock::duration;
@@ -111,12 +164,20 @@ class S3BucketMetadataCache::Item {
 
   bool can_remove() const;
   const std::string& get_bucket_name() const;
+  S3BucketMetadataState get_state() const;
 
   TimePoint update_time;
   TimePoint access_time;
 
-  ListIterator ptr_access;
-  ListIterator ptr_update;
+  // Intrusive links of the shard LRU lists
+  Item* access_prev = nullptr;
+  Item* access_next = nullptr;
+  Item* update_prev = nullptr;
+  Item* update_next = nullptr;
+
+  // Invalidated by another reactor while a Motr operation was in progress,
+  // the result of the operation must not be cached as fresh
+  bool stale = false;
 
   enum class CurrentOp {
     none,
@@ -126,6 +187,8 @@ class S3BucketMetadataCache::Item {
   };
 
  private:
+  void load();
+  void move_reload_waiters();
   void on_done(S3BucketMetadataState state);
   void on_load(S3BucketMetadataState state);
 
@@ -134,6 +197,10 @@ class S3BucketMetadataCache::Item {
   StateHandlerType on_changed;
   // For fetch operation
   std::queue<FetchHandlerType> fetch_waiters;
+  // Fetches queued after the entry became stale while a load was in flight.
+  // That load may have read the value before the change, so they wait for
+  // the next one.
+  std::queue<FetchHandlerType> reload_waiters;
 
   std::unique_ptr<S3BucketMetadata> p_value;
   std::unique_ptr<S3BucketMetadataV1> p_engine_modify;
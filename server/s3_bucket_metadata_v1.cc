@@ -26,6 +26,7 @@
 #include "s3_global_bucket_index_metadata.h"
 #include "s3_iem.h"
 #include "s3_log.h"
+#include "s3_option.h"
 #include "s3_request_object.h"
 #include "s3_stats.h"
 #include "s3_uri_to_motr_oid.h"
@@ -511,7 +512,9 @@ void S3BucketMetadataV1::save_bucket_info(bool clean_glob_on_err) {
   should_cleanup_global_idx = clean_glob_on_err;
   motr_kv_writer->put_keyval(
       bucket_metadata_list_index_layout, get_bucket_metadata_index_key_name(),
-      this->to_json(),
+      S3Option::get_instance()->is_metadata_binary_encoding_enabled()
+          ? this->to_binary()
+          : this->to_json(),
       std::bind(&S3BucketMetadataV1::save_bucket_info_successful, this),
       std::bind(&S3BucketMetadataV1::save_bucket_info_failed, this));
 
@@ -19,6 +19,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "s3_chunk_payload_parser.h"
 #include "s3_iem.h"
@@ -77,8 +78,7 @@ S3ChunkPayloadParser::S3ChunkPayloadParser()
     : parser_state(ChunkParserState::c_start),
       chunk_data_size_to_read(0),
       content_length(0),
-      chunk_sig_key_q_const(S3_AWS_CHUNK_KEY),
-      chunk_sig_key_char_state(S3_AWS_CHUNK_KEY) {
+      chunk_sig_key_matched(0) {
   s3_log(S3_LOG_DEBUG, "", "%s Ctor\n", __func__);
 
   evbuf_t *spare_buffer = evbuffer_new();
@@ -104,7 +104,7 @@ void S3ChunkPayloadParser::reset_parser_state() {
   chunk_data_size_to_read = 0;
   current_chunk_size = "";
   current_chunk_signature = "";
-  chunk_sig_key_char_state = chunk_sig_key_q_const;
+  chunk_sig_key_matched = 0;
   current_chunk_detail.reset();
   current_chunk_detail.incr_chunk_number();
 }
@@ -182,215 +182,15 @@ std::deque<evbuf_t *> S3ChunkPayloadParser::run(evbuf_t *buf) {
                 num_of_extents);
 
   for (size_t i = 0; i < num_of_extents; i++) {
-    // std::string chunk_debug((const char*)vec_in[i].iov_base,
-    // vec_in[i].iov_len);
-    // s3_log(S3_LOG_DEBUG, "", "vec_in[i].iov_base = %s\n",
-    // chunk_debug.c_str());
-    // s3_log(S3_LOG_DEBUG, "", "vec_in[i].iov_len = %zu\n", vec_in[i].iov_len);
-    // Within current vec
-    for (size_t j = 0; j < vec_in[i].iov_len; j++) {
-      // Parsing Syntax:
-      // string(IntHexBase(chunk-size)) + ";chunk-signature=" + signature + \r\n
-      // + chunk-data + \r\n
-      if (parser_state == ChunkParserState::c_start) {
-        reset_parser_state();
-        // reset_parsing = false;
-        parser_state = ChunkParserState::c_chunk_size;
-      }
-      switch (parser_state) {
-        case ChunkParserState::c_error: {
-          s3_log(S3_LOG_ERROR, "",
-                 "ChunkParserState::c_error. i(%zu), j(%zu)\n", i, j);
-          free(vec_in);
-          return ready_buffers;
-        }
-        case ChunkParserState::c_start: {
-          s3_log(S3_LOG_DEBUG, "",
-                 "ChunkParserState::c_start. i(%zu), j(%zu)\n", i, j);
-        }  // dummycase will never happen, see 1 line above
-        case ChunkParserState::c_chunk_size: {
-          s3_log(S3_LOG_DEBUG, "",
-                 "ChunkParserState::c_chunk_size. i(%zu), j(%zu)\n", i, j);
-          const char *chptr = (const char *)vec_in[i].iov_base;
-
-          if (chptr[j] == ';') {
-            parser_state = ChunkParserState::c_chunk_signature_key;
-            chunk_sig_key_char_state = chunk_sig_key_q_const;
-            chunk_data_size_to_read =
-                strtol(current_chunk_size.c_str(), NULL, 16);
-            current_chunk_detail.add_size(chunk_data_size_to_read);
-            s3_log(S3_LOG_DEBUG, "", "current_chunk_size = [%s]\n",
-                   current_chunk_size.c_str());
-            s3_log(S3_LOG_DEBUG, "", "chunk_data_size_to_read (int) = [%zu]\n",
-                   chunk_data_size_to_read);
-
-            // ignore the semicolon
-          } else {
-            current_chunk_size.push_back(chptr[j]);
-          }
-          break;
-        }
-        case ChunkParserState::c_chunk_signature_key: {
-          s3_log(S3_LOG_DEBUG, "",
-                 "ChunkParserState::c_chunk_signature_key. i(%zu), j(%zu)\n", i,
-                 j);
-          const char *chptr = (const char *)vec_in[i].iov_base;
-
-          if (chunk_sig_key_char_state.empty()) {
-            // ignore '='
-            if (chptr[j] == '=') {
-              parser_state = ChunkParserState::c_chunk_signature_value;
-            } else {
-              parser_state = ChunkParserState::c_error;
-              free(vec_in);
-              return ready_buffers;
-            }
-          } else {
-            if (chptr[j] == chunk_sig_key_char_state.front()) {
-              chunk_sig_key_char_state.pop();
-            } else {
-              parser_state = ChunkParserState::c_error;
-              free(vec_in);
-              return ready_buffers;
-            }
-          }
-          break;
-        }
-        case ChunkParserState::c_chunk_signature_value: {
-          s3_log(S3_LOG_DEBUG, "",
-                 "ChunkParserState::c_chunk_signature_value. i(%zu), j(%zu)\n",
-                 i, j);
-          const char *chptr = (const char *)vec_in[i].iov_base;
-          if ((unsigned char)chptr[j] == CR) {
-            parser_state = ChunkParserState::c_cr;
-          } else {
-            current_chunk_signature.push_back(chptr[j]);
-          }
-          break;
-        }
-        case ChunkParserState::c_cr: {
-          s3_log(S3_LOG_DEBUG, "", "ChunkParserState::c_cr. i(%zu), j(%zu)\n",
-                 i, j);
-          const char *chptr = (const char *)vec_in[i].iov_base;
-          if ((unsigned char)chptr[j] == LF) {
-            // CRLF means we are done with signature
-            parser_state = ChunkParserState::c_chunk_data;
-            current_chunk_detail.add_signature(current_chunk_signature);
-            s3_log(S3_LOG_DEBUG, "", "current_chunk_signature = [%s]\n",
-                   current_chunk_signature.c_str());
-          } else {
-            // what we detected as CR was part of signature, move back
-            current_chunk_signature.push_back(CR);
-            if ((unsigned char)chptr[j] == CR) {
-              parser_state = ChunkParserState::c_cr;
-            } else {
-              current_chunk_signature.push_back(chptr[j]);
-            }
-          }
-          break;
-        }
-        case ChunkParserState::c_chunk_data: {
-          s3_log(S3_LOG_DEBUG, "",
-                 "ChunkParserState::c_chunk_data. i(%zu), j(%zu)\n", i, j);
-
-          // we have to read 'chunk_data_size_to_read' data, so we have 3 cases.
-          // 1. current payload has "all" and "only" data related to current
-          // chunk, optionally crlf
-          // 2. current payload has "partial" and "only" data related to current
-          // chunk.
-          // 3. current payload had "all" data of current chunk and some part of
-          // next chunk
-          s3_log(S3_LOG_DEBUG, "", "chunk_data_size_to_read(%zu)\n",
-                 chunk_data_size_to_read);
-          if (chunk_data_size_to_read > 0) {
-            // How much data does current vec has for current chunk?
-            void *data_ptr = (void *)((const char *)(vec_in[i].iov_base) + j);
-            size_t data_len = 0;
-            s3_log(S3_LOG_DEBUG, "", "vec_in[i].iov_len(%zu)\n",
-                   vec_in[i].iov_len);
-            if (chunk_data_size_to_read <= vec_in[i].iov_len - j) {
-              // current vec has all data and possibly next some of chunk
-              data_len = chunk_data_size_to_read;
-            } else {
-              // Current vec has only data
-              data_len = vec_in[i].iov_len - j;
-            }
-            add_to_spare(data_ptr, data_len);
-            current_chunk_detail.update_hash(data_ptr, data_len);
-            chunk_data_size_to_read -= data_len;
-            content_length -= data_len;
-            s3_log(S3_LOG_DEBUG, "", "chunk_data_size_to_read(%zu)\n",
-                   chunk_data_size_to_read);
-            j += data_len - 1;
-
-            if (chunk_data_size_to_read == 0) {
-              s3_log(S3_LOG_DEBUG, "",
-                     "goto c_chunk_data_end_cr i(%zu), j(%zu)\n", i, j);
-              // Means we are moving on to crlf followed by next chunk.
-              parser_state = ChunkParserState::c_chunk_data_end_cr;
-            } else if (chunk_data_size_to_read < 0) {
-              parser_state = ChunkParserState::c_error;
-              free(vec_in);
-              return ready_buffers;
-            } else {
-              // we are expecting more data, keep going with same parser state
-            }
-          } else {
-            // This can be last chunk with size 0
-            s3_log(S3_LOG_DEBUG, "", "Last chunk of size 0 i(%zu), j(%zu)\n", i,
-                   j);
-            parser_state = ChunkParserState::c_chunk_data_end_cr;
-            j--;
-            current_chunk_detail.update_hash(NULL);
-          }
-          break;
-        }
-        case ChunkParserState::c_chunk_data_end_cr: {
-          s3_log(S3_LOG_DEBUG, "",
-                 "ChunkParserState::c_chunk_data_end_cr. i(%zu), j(%zu)\n", i,
-                 j);
-          const char *chptr = (const char *)vec_in[i].iov_base;
-
-          if ((unsigned char)chptr[j] == CR) {
-            parser_state = ChunkParserState::c_chunk_data_end_lf;
-          } else {
-            parser_state = ChunkParserState::c_error;
-            free(vec_in);
-            return ready_buffers;
-          }
-          break;
-        }
-        case ChunkParserState::c_chunk_data_end_lf: {
-          s3_log(S3_LOG_DEBUG, "",
-                 "ChunkParserState::c_chunk_data_end_lf. i(%zu), j(%zu)\n", i,
-                 j);
-          const char *chptr = (const char *)vec_in[i].iov_base;
-
-          if ((unsigned char)chptr[j] == LF) {
-            // CRLF means we are done with data
-            parser_state = ChunkParserState::c_start;
-            current_chunk_detail.fini_hash();
-            current_chunk_detail.debug_dump();
-            chunk_details.push(current_chunk_detail);
-          } else {
-            parser_state = ChunkParserState::c_error;
-            free(vec_in);
-            return ready_buffers;
-          }
-          break;
-        }
-        default: {
-          s3_log(S3_LOG_ERROR, "", "Invalid ChunkParserState. i(%zu), j(%zu)\n",
-                 i, j);
-          // s3_iem(LOG_ERR, S3_IEM_CHUNK_PARSING_FAIL,
-          //     S3_IEM_CHUNK_PARSING_FAIL_STR, S3_IEM_CHUNK_PARSING_FAIL_JSON);
-          parser_state = ChunkParserState::c_error;
-          free(vec_in);
-          return ready_buffers;
-        }
-      };  // switch
-    }     // Inner for
-  }       // for num_of_extents
+    if (!parse((const char *)vec_in[i].iov_base, vec_in[i].iov_len)) {
+      s3_log(S3_LOG_ERROR, "", "ChunkParserState::c_error. extent(%zu)\n", i);
+      // s3_iem(LOG_ERR, S3_IEM_CHUNK_PARSING_FAIL,
+      //     S3_IEM_CHUNK_PARSING_FAIL_STR, S3_IEM_CHUNK_PARSING_FAIL_JSON);
+      parser_state = ChunkParserState::c_error;
+      free(vec_in);
+      return ready_buffers;
+    }
+  }  // for num_of_extents
   free(vec_in);
 
   s3_log(S3_LOG_DEBUG, "", "content_length(%zu)\n", content_length);
@@ -415,6 +215,141 @@ std::deque<evbuf_t *> S3ChunkPayloadParser::run(evbuf_t *buf) {
   return ready_buffers;
 }
 
+// Parsing Syntax:
+// string(IntHexBase(chunk-size)) + ";chunk-signature=" + signature + \r\n
+// + chunk-data + \r\n
+// Any element can be split between extents, so the partial element is kept
+// in parser state till the rest of it arrives.
+bool S3ChunkPayloadParser::parse(const char *data, size_t len) {
+  static const size_t chunk_sig_key_len = sizeof(S3_AWS_CHUNK_KEY) - 1;
+
+  const char *ptr = data;
+  const char *const end = data + len;
+
+  while (ptr < end) {
+    switch (parser_state) {
+      case ChunkParserState::c_start: {
+        reset_parser_state();
+        parser_state = ChunkParserState::c_chunk_size;
+        break;
+      }
+      case ChunkParserState::c_chunk_size: {
+        const char *semicolon = (const char *)memchr(ptr, ';', end - ptr);
+
+        if (!semicolon) {
+          current_chunk_size.append(ptr, end - ptr);
+          return true;
+        }
+        current_chunk_size.append(ptr, semicolon - ptr);
+        ptr = semicolon + 1;  // ignore the semicolon
+
+        chunk_data_size_to_read = strtol(current_chunk_size.c_str(), NULL, 16);
+        current_chunk_detail.add_size(chunk_data_size_to_read);
+        s3_log(S3_LOG_DEBUG, "", "current_chunk_size = [%s] (%zu)\n",
+               current_chunk_size.c_str(), chunk_data_size_to_read);
+
+        chunk_sig_key_matched = 0;
+        parser_state = ChunkParserState::c_chunk_signature_key;
+        break;
+      }
+      case ChunkParserState::c_chunk_signature_key: {
+        size_t to_match = chunk_sig_key_len - chunk_sig_key_matched;
+        if (to_match > (size_t)(end - ptr)) {
+          to_match = end - ptr;
+        }
+        if (memcmp(ptr, S3_AWS_CHUNK_KEY + chunk_sig_key_matched, to_match)) {
+          return false;
+        }
+        ptr += to_match;
+        chunk_sig_key_matched += to_match;
+
+        if (chunk_sig_key_matched == chunk_sig_key_len) {
+          parser_state = ChunkParserState::c_chunk_signature_value;
+        }
+        break;
+      }
+      case ChunkParserState::c_chunk_signature_value: {
+        const char *cr = (const char *)memchr(ptr, CR, end - ptr);
+
+        if (!cr) {
+          current_chunk_signature.append(ptr, end - ptr);
+          return true;
+        }
+        current_chunk_signature.append(ptr, cr - ptr);
+        ptr = cr + 1;
+        parser_state = ChunkParserState::c_cr;
+        break;
+      }
+      case ChunkParserState::c_cr: {
+        if ((unsigned char)*ptr == LF) {
+          // CRLF means we are done with signature
+          parser_state = ChunkParserState::c_chunk_data;
+          current_chunk_detail.add_signature(current_chunk_signature);
+          s3_log(S3_LOG_DEBUG, "", "current_chunk_signature = [%s]\n",
+                 current_chunk_signature.c_str());
+          ++ptr;
+        } else {
+          // what we detected as CR was part of signature, move back
+          current_chunk_signature.push_back(CR);
+          parser_state = ChunkParserState::c_chunk_signature_value;
+        }
+        break;
+      }
+      case ChunkParserState::c_chunk_data: {
+        if (chunk_data_size_to_read == 0) {
+          // Last chunk of size 0
+          current_chunk_detail.update_hash(NULL);
+          parser_state = ChunkParserState::c_chunk_data_end_cr;
+          break;
+        }
+        // Current extent can have part of chunk data, or all of it
+        // followed by the next chunk
+        size_t data_len = end - ptr;
+        if (chunk_data_size_to_read < data_len) {
+          data_len = chunk_data_size_to_read;
+        }
+        add_to_spare(ptr, data_len);
+        // Unlike MD5 and PI (see S3HashThreadPool), SHA-256 of chunk data is
+        // calculated here on the event loop: the data is handed over to the
+        // action as soon as it's parsed, before a hash thread would be done.
+        current_chunk_detail.update_hash(ptr, data_len);
+        chunk_data_size_to_read -= data_len;
+        content_length -= data_len;
+        ptr += data_len;
+
+        if (chunk_data_size_to_read == 0) {
+          // Means we are moving on to crlf followed by next chunk.
+          parser_state = ChunkParserState::c_chunk_data_end_cr;
+        }
+        break;
+      }
+      case ChunkParserState::c_chunk_data_end_cr: {
+        if ((unsigned char)*ptr++ != CR) {
+          return false;
+        }
+        parser_state = ChunkParserState::c_chunk_data_end_lf;
+        break;
+      }
+      case ChunkParserState::c_chunk_data_end_lf: {
+        if ((unsigned char)*ptr++ != LF) {
+          return false;
+        }
+        // CRLF means we are done with data
+        parser_state = ChunkParserState::c_start;
+        current_chunk_detail.fini_hash();
+        current_chunk_detail.debug_dump();
+        chunk_details.push(current_chunk_detail);
+        break;
+      }
+      default: {
+        s3_log(S3_LOG_ERROR, "", "Invalid ChunkParserState\n");
+        return false;
+      }
+    }  // switch
+  }
+  return true;
+}
+
 bool S3ChunkPayloadParser::is_chunk_detail_ready() {
   if (!chunk_details.empty() && chunk_details.front().is_ready()) {
     return true;
@@ -37,8 +37,8 @@
 #define LF (unsigned char)10
 #define CR (unsigned char)13
 
-#define S3_AWS_CHUNK_KEY \
-  { 'c', 'h', 'u', 'n', 'k', '-', 's', 'i', 'g', 'n', 'a', 't', 'u', 'r', 'e' }
+// Follows chunk-size and ';'
+#define S3_AWS_CHUNK_KEY "chunk-signature="
 
 class S3ChunkDetail {
   size_t chunk_size;
@@ -92,12 +92,18 @@ class S3ChunkPayloadParser {
   std::string current_chunk_signature;
   S3ChunkDetail current_chunk_detail;
 
-  const std::queue<char> chunk_sig_key_q_const;
-  std::queue<char> chunk_sig_key_char_state;  // init has val = chunk-signature,
-                                              // pops on each char encountered
+  // Number of S3_AWS_CHUNK_KEY chars matched so far, key can be split
+  // between buffers
+  size_t chunk_sig_key_matched;
 
   void reset_parser_state();
 
+  // Parses one contiguous extent of the payload. Delimiters are searched
+  // with memchr() and chunk data is consumed in bulk, so the cost per byte
+  // is that of the copy to spare buffers and the SHA256 update.
+  // Returns false on format error.
+  bool parse(const char *data, size_t len);
+
   // We hold a spare buffer block internally to copy chunked data in it
   // and keep rotating with incoming buffers in parser. Once data in incoming
   // buffer is emptied we retain it as spare and buffer that is filled
@@ -108,6 +114,9 @@ class S3ChunkPayloadParser {
 
   // Adds to current spare buffer. but when spare is full:
   // moves filled spare -> ready
+  // Chunk data is copied, not referenced: S3MotrWiter needs every buffer but
+  // the last one to be exactly of libevent pool buffer size, while the data
+  // in incoming buffers is shifted by the chunk headers between it.
   void add_to_spare(const void *data, size_t len);
 
  public:
@@ -74,6 +74,12 @@ DEFINE_bool(fake_motr_putkv, false, "Fake out motr put key-val");
 DEFINE_bool(fake_motr_deletekv, false, "Fake out motr delete key-val");
 DEFINE_bool(fake_motr_redis_kvs, false,
             "Fake out motr kvs with redis in-memory storage");
+DEFINE_bool(fake_motr_obj_store, false,
+            "Keep data of faked motr object ops in memory");
+DEFINE_string(fake_motr_obj_store_dir, "",
+              "Keep data of faked motr object ops in files of this directory");
+DEFINE_int32(fake_motr_latency_us, 0,
+             "Delay completion of faked motr ops, in microseconds");
 DEFINE_bool(fault_injection, false, "Enable fault Injection flag for testing");
 DEFINE_bool(loading_indicators, false, "Enable logging load indicators");
 DEFINE_bool(addb, false, "Enable logging via ADDB motr subsystem");
@@ -69,6 +69,9 @@ DECLARE_bool(fake_motr_getkv);
 DECLARE_bool(fake_motr_putkv);
 DECLARE_bool(fake_motr_deletekv);
 DECLARE_bool(fake_motr_redis_kvs);
+DECLARE_bool(fake_motr_obj_store);
+DECLARE_string(fake_motr_obj_store_dir);
+DECLARE_int32(fake_motr_latency_us);
 DECLARE_bool(fault_injection);
 DECLARE_bool(reuseport);
 DECLARE_bool(getoid);
@@ -71,8 +71,6 @@ const char xml_spaces[] = "        ";
 #define MAX_FRAGMENTS_WITHOUT_WHITESPACE 4
 // If any part/fragment size is greater than 10MB, white space send to client
 #define MAX_PART_SIZE_WITHOUT_WHITESPACE 10485760
-// Max parallel copy operation
-#define MAX_PARALLEL_COPY 3
 
 enum class S3ApiType {
   service,
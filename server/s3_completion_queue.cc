@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <stdint.h>
+
+#include "s3_completion_queue.h"
+#include "s3_log.h"
+#include "s3_stats.h"
+
+std::atomic<S3CompletionQueue *>
+    S3CompletionQueue::queues[S3CompletionQueue::MAX_QUEUES];
+
+S3CompletionQueue::S3CompletionQueue(evbase_t *base, size_t capacity,
+                                     unsigned max_batch)
+    : evbase(base),
+      max_batch(max_batch ? max_batch : 1),
+      enqueue_pos(0),
+      dequeue_pos(0),
+      drain_pending(false),
+      reported_depth(0) {
+  size_t size = 2;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  mask = size - 1;
+  cells.reset(new Cell[size]);
+  for (size_t i = 0; i < size; ++i) {
+    cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  drain_event = event_new(evbase, -1, 0, on_drain, this);
+
+  unsigned slot = 0;
+  for (; slot < MAX_QUEUES; ++slot) {
+    S3CompletionQueue *expected = nullptr;
+    if (queues[slot].compare_exchange_strong(expected, this)) {
+      break;
+    }
+  }
+  if (slot == MAX_QUEUES) {
+    s3_log(S3_LOG_WARN, "",
+           "%s Too many event loops, callbacks of this one are posted one "
+           "event each\n",
+           __func__);
+  }
+  s3_log(S3_LOG_INFO, "",
+         "%s Completion queue: %zu callbacks, drained %u at a time\n",
+         __func__, size, this->max_batch);
+}
+
+S3CompletionQueue::~S3CompletionQueue() {
+  s3_log(S3_LOG_DEBUG, "", "%s\n", __func__);
+  for (unsigned slot = 0; slot < MAX_QUEUES; ++slot) {
+    S3CompletionQueue *expected = this;
+    queues[slot].compare_exchange_strong(expected, nullptr);
+  }
+  // Queued callbacks are not run, the loop has stopped
+  event_free(drain_event);
+}
+
+S3CompletionQueue *S3CompletionQueue::find(evbase_t *base) {
+  for (unsigned slot = 0; slot < MAX_QUEUES; ++slot) {
+    S3CompletionQueue *queue = queues[slot].load(std::memory_order_acquire);
+    if (queue && queue->evbase == base) {
+      return queue;
+    }
+  }
+  return nullptr;
+}
+
+bool S3CompletionQueue::post(user_event_on_main_loop callback,
+                             void *user_data) {
+  Cell *cell;
+  size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+  for (;;) {
+    cell = &cells[pos & mask];
+    size_t seq = cell->sequence.load(std::memory_order_acquire);
+    intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+    if (dif == 0) {
+      if (enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (dif < 0) {
+      // The loop has not drained the callback a lap earlier yet
+      return false;
+    } else {
+      pos = enqueue_pos.load(std::memory_order_relaxed);
+    }
+  }
+  cell->callback = callback;
+  cell->user_data = user_data;
+  cell->sequence.store(pos + 1, std::memory_order_release);
+
+  schedule_drain();
+  return true;
+}
+
+void S3CompletionQueue::schedule_drain() {
+  // Only the first callback since the last drain wakes the loop up
+  if (!drain_pending.exchange(true, std::memory_order_acq_rel)) {
+    event_active(drain_event, EV_READ | EV_WRITE | EV_TIMEOUT, 1);
+  }
+}
+
+void S3CompletionQueue::on_drain(evutil_socket_t, short events, void *arg) {
+  ((S3CompletionQueue *)arg)->drain();
+}
+
+size_t S3CompletionQueue::drain() {
+  // Callbacks queued from now on schedule another drain
+  drain_pending.exchange(false, std::memory_order_acq_rel);
+
+  // Gauge sums queued callbacks of all loops
+  size_t depth = enqueue_pos.load(std::memory_order_relaxed) - dequeue_pos;
+  if (depth != reported_depth) {
+    s3_stats_update_gauge("completion_queue_depth",
+                          (int)depth - (int)reported_depth);
+    reported_depth = depth;
+  }
+
+  size_t count = 0;
+  while (count < max_batch) {
+    Cell *cell = &cells[dequeue_pos & mask];
+    if (cell->sequence.load(std::memory_order_acquire) != dequeue_pos + 1) {
+      // Empty, or the next callback is still being queued
+      return count;
+    }
+    user_event_on_main_loop callback = cell->callback;
+    void *user_data = cell->user_data;
+    cell->sequence.store(dequeue_pos + mask + 1, std::memory_order_release);
+    ++dequeue_pos;
+    ++count;
+
+    callback(-1, EV_READ | EV_WRITE | EV_TIMEOUT, user_data);
+  }
+  // Let other events of the loop run before the rest of the queue
+  if (cells[dequeue_pos & mask].sequence.load(std::memory_order_acquire) ==
+      dequeue_pos + 1) {
+    schedule_drain();
+  }
+  return count;
+}
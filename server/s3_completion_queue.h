@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_COMPLETION_QUEUE_H__
+#define __S3_SERVER_S3_COMPLETION_QUEUE_H__
+
+#include <atomic>
+#include <memory>
+
+#include <evhtp.h>
+
+#include "s3_post_to_main_loop.h"
+
+// Callbacks posted to an event loop by S3PostToMainLoop, mostly Motr
+// completions coming from Motr threads. Producers claim a slot of a bounded
+// ring without allocating or taking the event base lock. The loop drains the
+// ring from one event, activated once for all callbacks queued since the
+// last drain. When the ring is full, S3PostToMainLoop falls back to an event
+// per callback.
+class S3CompletionQueue {
+  struct Cell {
+    std::atomic<size_t> sequence;
+    user_event_on_main_loop callback;
+    void *user_data;
+  };
+
+  static const unsigned MAX_QUEUES = 64;
+  static std::atomic<S3CompletionQueue *> queues[MAX_QUEUES];
+
+  evbase_t *evbase;
+  struct event *drain_event;
+  std::unique_ptr<Cell[]> cells;
+  size_t mask;
+  unsigned max_batch;
+
+  // Producers and the loop work on different cache lines
+  char pad0[64];
+  std::atomic<size_t> enqueue_pos;
+  char pad1[64];
+  size_t dequeue_pos;
+  std::atomic<bool> drain_pending;
+  size_t reported_depth;
+  char pad2[64];
+
+  static void on_drain(evutil_socket_t, short events, void *arg);
+  void schedule_drain();
+
+ public:
+  // Callbacks run per drain before other events of the loop get a turn
+  static const unsigned DEFAULT_MAX_BATCH = 256;
+
+  // capacity is rounded up to a power of 2
+  S3CompletionQueue(evbase_t *base, size_t capacity, unsigned max_batch);
+  ~S3CompletionQueue();
+
+  // Queue of the loop, nullptr when the loop has none
+  static S3CompletionQueue *find(evbase_t *base);
+
+  // Safe to call from any thread. Returns false when the queue is full.
+  bool post(user_event_on_main_loop callback, void *user_data);
+
+  // Runs up to max_batch queued callbacks, returns how many ran.
+  // Called on the loop.
+  size_t drain();
+
+  size_t get_capacity() const { return mask + 1; }
+};
+
+#endif
@@ -160,7 +160,8 @@ void S3CopyObjectAction::create_one_or_more_objects() {
 // Copy source object(s) to destination object(s)
 void S3CopyObjectAction::copy_one_or_more_objects() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
-  max_parallel_copy = MAX_PARALLEL_COPY;
+  max_parallel_copy = std::max<int>(
+      1, S3Option::get_instance()->get_copy_max_parallel_fragments());
   if (additional_object_metadata->get_number_of_fragments() == 0) {
     copy_object();
   } else {
@@ -186,7 +186,11 @@ void S3DeleteBucketAction::fetch_multipart_objects() {
     multipart_present = true;
     // There is an oid for index present, so read objects from it
     size_t count = S3Option::get_instance()->get_motr_idx_fetch_count();
-    motr_kv_reader->next_keyval(
+    if (multipart_kv_cursor == nullptr) {
+      multipart_kv_cursor = std::make_shared<S3MotrKVSScanCursor>(
+          request, motr_kvs_reader_factory, s3_motr_api);
+    }
+    multipart_kv_cursor->next_keyval(
         mp_idx_lo, last_key, count,
         std::bind(&S3DeleteBucketAction::fetch_multipart_objects_successful,
                   this),
@@ -203,7 +207,7 @@ void S3DeleteBucketAction::fetch_multipart_objects_successful() {
   struct m0_uint128 multipart_obj_oid;
   s3_log(S3_LOG_DEBUG, request_id, "Found multipart uploads listing\n");
   size_t return_list_size = 0;
-  auto& kvps = motr_kv_reader->get_key_values();
+  auto& kvps = multipart_kv_cursor->get_key_values();
   size_t count_we_requested =
       S3Option::get_instance()->get_motr_idx_fetch_count();
   size_t length = kvps.size();
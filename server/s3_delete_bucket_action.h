@@ -28,11 +28,13 @@
 #include "s3_bucket_action_base.h"
 #include "s3_bucket_metadata.h"
 #include "s3_motr_kvs_reader.h"
+#include "s3_motr_kvs_scan_cursor.h"
 #include "s3_motr_writer.h"
 #include "s3_factory.h"
 
 class S3DeleteBucketAction : public S3BucketAction {
   std::shared_ptr<S3MotrKVSReader> motr_kv_reader;
+  std::shared_ptr<S3MotrKVSScanCursor> multipart_kv_cursor;
   std::shared_ptr<S3ObjectMetadata> object_multipart_metadata;
   std::shared_ptr<S3MotrKVSWriter> motr_kv_writer;
   std::shared_ptr<S3MotrWiter> motr_writer;
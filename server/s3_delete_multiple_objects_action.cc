@@ -24,6 +24,7 @@
 #include "s3_option.h"
 #include "s3_perf_logger.h"
 #include "s3_m0_uint128_helper.h"
+#include "s3_object_metadata_cache.h"
 #include "s3_common_utilities.h"
 
 extern struct s3_motr_idx_layout global_probable_dead_object_list_index_layout;
@@ -71,11 +72,10 @@ S3DeleteMultipleObjectsAction::S3DeleteMultipleObjectsAction(
     motr_kvs_writer_factory = std::make_shared<S3MotrKVSWriterFactory>();
   }
 
-  std::shared_ptr<MotrAPI> s3_motr_api = std::make_shared<ConcreteMotrAPI>();
-
-  motr_kv_reader =
-      motr_kvs_reader_factory->create_motr_kvs_reader(request, s3_motr_api);
+  s3_motr_api = std::make_shared<ConcreteMotrAPI>();
 
+  // Lanes get their own KVS reader and writer, this one cleans up the
+  // probable delete records once the response is sent
   motr_kv_writer =
       motr_kvs_writer_factory->create_motr_kvs_writer(request, s3_motr_api);
 
@@ -88,10 +88,9 @@ S3DeleteMultipleObjectsAction::S3DeleteMultipleObjectsAction(
 void S3DeleteMultipleObjectsAction::setup_steps() {
   s3_log(S3_LOG_DEBUG, request_id, "Setting up the action\n");
   ACTION_TASK_ADD(S3DeleteMultipleObjectsAction::validate_request, this);
+  // Batches of keys are deleted in parallel lanes, the last lane to finish
+  // sends the response
   ACTION_TASK_ADD(S3DeleteMultipleObjectsAction::fetch_objects_info, this);
-  // ACTION_TASK_ADD(S3DeleteMultipleObjectsAction::fetch_objects_extended_info,
-  //                this);
-  // Delete will be cycling between delete_objects_metadata and delete_objects
   ACTION_TASK_ADD(S3DeleteMultipleObjectsAction::send_response_to_s3_client,
                   this);
   // ...
@@ -169,67 +168,105 @@ void S3DeleteMultipleObjectsAction::fetch_bucket_info_failed() {
   send_response_to_s3_client();
 }
 
+S3DeleteMultipleObjectsLane* S3DeleteMultipleObjectsAction::create_lane() {
+  std::unique_ptr<S3DeleteMultipleObjectsLane> lane(
+      new S3DeleteMultipleObjectsLane());
+  lane->motr_kv_reader =
+      motr_kvs_reader_factory->create_motr_kvs_reader(request, s3_motr_api);
+  lane->motr_kv_writer =
+      motr_kvs_writer_factory->create_motr_kvs_writer(request, s3_motr_api);
+  lanes.push_back(std::move(lane));
+  return lanes.back().get();
+}
+
+void S3DeleteMultipleObjectsAction::set_lane_error(const std::string& code) {
+  if (!is_error_state()) {
+    set_s3_error(code);
+  }
+}
+
 void S3DeleteMultipleObjectsAction::fetch_objects_info() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   object_list_index_layout = bucket_metadata->get_object_list_index_layout();
   extended_list_index_layout =
       bucket_metadata->get_extended_metadata_index_layout();
   if (zero(object_list_index_layout.oid)) {
-    for (const auto& key : keys_to_delete) {
+    // Bucket has no objects, so every requested key is already deleted
+    for (const auto& key :
+         delete_request.get_keys(0, delete_request.get_count())) {
       delete_objects_response.add_success(key);
     }
     send_response_to_s3_client();
+  } else if (delete_index_in_req >= delete_request.get_count()) {
+    send_response_to_s3_client();
   } else {
-    if (delete_index_in_req < delete_request.get_count()) {
-      keys_to_delete.clear();
-      keys_to_delete = delete_request.get_keys(
-          delete_index_in_req,
-          S3Option::get_instance()->get_motr_idx_fetch_count());
-      if (s3_fi_is_enabled("fail_fetch_objects_info")) {
-        s3_fi_enable_once("motr_kv_get_fail");
-      }
-      motr_kv_reader->get_keyval(
-          object_list_index_layout, keys_to_delete,
-          std::bind(
-              &S3DeleteMultipleObjectsAction::fetch_objects_info_successful,
-              this),
-          std::bind(&S3DeleteMultipleObjectsAction::fetch_objects_info_failed,
-                    this));
-      delete_index_in_req += keys_to_delete.size();
+    unsigned int max_lanes =
+        S3Option::get_instance()->get_motr_multi_delete_max_inflight();
+    if (max_lanes == 0) {
+      max_lanes = 1;
+    }
+    // Count all lanes as busy before launching, a lane failing to launch
+    // finishes synchronously and must not respond for the others.
+    std::vector<S3DeleteMultipleObjectsLane*> to_start;
+    int keys_left = delete_request.get_count() - delete_index_in_req;
+    int batch_size = S3Option::get_instance()->get_motr_idx_fetch_count();
+    while (to_start.size() < max_lanes && keys_left > 0) {
+      to_start.push_back(create_lane());
+      keys_left -= batch_size;
+    }
+    lanes_in_flight += to_start.size();
+    s3_log(S3_LOG_DEBUG, request_id, "Deleting %d keys in %zu lanes\n",
+           delete_request.get_count(), to_start.size());
+    for (auto lane : to_start) {
+      fetch_next_batch(lane);
     }
   }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3DeleteMultipleObjectsAction::fetch_objects_info_failed() {
+void S3DeleteMultipleObjectsAction::fetch_next_batch(
+    S3DeleteMultipleObjectsLane* lane) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
-  if (motr_kv_reader->get_state() == S3MotrKVSReaderOpState::missing) {
-    for (auto& key : keys_to_delete) {
+  lane->reset();
+  lane->keys_to_delete = delete_request.get_keys(
+      delete_index_in_req,
+      S3Option::get_instance()->get_motr_idx_fetch_count());
+  delete_index_in_req += lane->keys_to_delete.size();
+  if (s3_fi_is_enabled("fail_fetch_objects_info")) {
+    s3_fi_enable_once("motr_kv_get_fail");
+  }
+  lane->motr_kv_reader->get_keyval(
+      object_list_index_layout, lane->keys_to_delete,
+      std::bind(&S3DeleteMultipleObjectsAction::fetch_objects_info_successful,
+                this, lane),
+      std::bind(&S3DeleteMultipleObjectsAction::fetch_objects_info_failed,
+                this, lane));
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3DeleteMultipleObjectsAction::fetch_objects_info_failed(
+    S3DeleteMultipleObjectsLane* lane) {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  if (lane->motr_kv_reader->get_state() == S3MotrKVSReaderOpState::missing) {
+    for (auto& key : lane->keys_to_delete) {
       delete_objects_response.add_success(key);
     }
-    if (delete_index_in_req < delete_request.get_count()) {
-      fetch_objects_info();
-    } else {
-      send_response_to_s3_client();
-    }
   } else {
-    set_s3_error("InternalError");
-    send_response_to_s3_client();
+    set_lane_error("InternalError");
   }
+  lane_batch_done(lane);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3DeleteMultipleObjectsAction::fetch_objects_info_successful() {
+void S3DeleteMultipleObjectsAction::fetch_objects_info_successful(
+    S3DeleteMultipleObjectsLane* lane) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   // Create a list of objects found to be deleted
 
-  const auto& kvps = motr_kv_reader->get_key_values();
-  objects_metadata.clear();
-  extended_oids_to_delete.clear();
-  objects_metadata_with_extends.clear();
-  objects_metadata_with_extends_index = 0;
-  extended_layout_id_for_objs_to_delete.clear();
-  extended_pv_ids_to_delete.clear();
+  const auto& kvps = lane->motr_kv_reader->get_key_values();
+  lane->objects_metadata.clear();
+  lane->objects_metadata_with_extends.clear();
+  lane->objects_metadata_with_extends_index = 0;
 
   bool atleast_one_json_error = false;
   bool all_had_json_error = true;
@@ -258,9 +295,9 @@ void S3DeleteMultipleObjectsAction::fetch_objects_info_successful() {
       } else {
         all_had_json_error = false;  // at least one good object to delete
         if (object->get_number_of_fragments() > 0) {
-          objects_metadata_with_extends.push_back(object);
+          lane->objects_metadata_with_extends.push_back(object);
         }
-        objects_metadata.push_back(object);
+        lane->objects_metadata.push_back(object);
       }
     } else {
       s3_log(S3_LOG_DEBUG, request_id, "Object metadata missing for = %s\n",
@@ -274,73 +311,70 @@ void S3DeleteMultipleObjectsAction::fetch_objects_info_successful() {
     s3_log(S3_LOG_DEBUG, request_id, "metadata may be inappropriate\n");
   }
   if (all_had_json_error) {
-    // Fetch more if present, else just respond
-    if (delete_index_in_req < delete_request.get_count()) {
-      // Try to delete the remaining
-      fetch_objects_info();
-    } else {
-      if (!at_least_one_delete_successful) {
-        set_s3_error("InternalError");
-      }
-      send_response_to_s3_client();
-    }
+    // Nothing to delete in this batch, move on to the remaining keys
+    metadata_errors_seen = true;
+    lane_batch_done(lane);
   } else {
-    // next();
-    fetch_objects_extended_info();
+    fetch_objects_extended_info(lane);
   }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3DeleteMultipleObjectsAction::fetch_objects_extended_info() {
+void S3DeleteMultipleObjectsAction::fetch_objects_extended_info(
+    S3DeleteMultipleObjectsLane* lane) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
-  if (objects_metadata_with_extends.size() == 0) {
-    add_object_oid_to_probable_dead_oid_list();
+  if (lane->objects_metadata_with_extends.size() == 0) {
+    add_object_oid_to_probable_dead_oid_list(lane);
   } else {
-    object_metadata =
-        objects_metadata_with_extends[objects_metadata_with_extends_index++];
+    lane->object_metadata =
+        lane->objects_metadata_with_extends
+            [lane->objects_metadata_with_extends_index++];
     // Read the extended parts of the object from extended index table
     std::shared_ptr<S3ObjectExtendedMetadata> extended_obj_metadata =
         object_metadata_factory->create_object_ext_metadata_obj(
-            request, object_metadata->get_bucket_name(),
-            object_metadata->get_object_name(),
-            object_metadata->get_obj_version_key(),
-            object_metadata->get_number_of_parts(),
-            object_metadata->get_number_of_fragments(),
+            request, lane->object_metadata->get_bucket_name(),
+            lane->object_metadata->get_object_name(),
+            lane->object_metadata->get_obj_version_key(),
+            lane->object_metadata->get_number_of_parts(),
+            lane->object_metadata->get_number_of_fragments(),
             bucket_metadata->get_extended_metadata_index_layout());
-    object_metadata->set_extended_object_metadata(extended_obj_metadata);
+    lane->object_metadata->set_extended_object_metadata(
+        extended_obj_metadata);
     extended_obj_metadata->load(
         std::bind(&S3DeleteMultipleObjectsAction::
                        fetch_objects_extended_info_successful,
-                  this),
+                  this, lane),
         std::bind(
             &S3DeleteMultipleObjectsAction::fetch_objects_extended_info_failed,
-            this));
+            this, lane));
   }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3DeleteMultipleObjectsAction::fetch_objects_extended_info_successful() {
+void S3DeleteMultipleObjectsAction::fetch_objects_extended_info_successful(
+    S3DeleteMultipleObjectsLane* lane) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
-  if (objects_metadata_with_extends_index <
-      objects_metadata_with_extends.size()) {
-    fetch_objects_extended_info();
+  if (lane->objects_metadata_with_extends_index <
+      lane->objects_metadata_with_extends.size()) {
+    fetch_objects_extended_info(lane);
   } else {
-    add_object_oid_to_probable_dead_oid_list();
+    add_object_oid_to_probable_dead_oid_list(lane);
   }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3DeleteMultipleObjectsAction::fetch_objects_extended_info_failed() {
+void S3DeleteMultipleObjectsAction::fetch_objects_extended_info_failed(
+    S3DeleteMultipleObjectsLane* lane) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   s3_log(S3_LOG_WARN, request_id,
          "Failed to fetch object %s metadata, this may remain stale\n",
-         object_metadata->get_object_name().c_str());
-  object_metadata->set_extended_object_metadata(nullptr);
-  if (objects_metadata_with_extends_index <
-      objects_metadata_with_extends.size()) {
-    fetch_objects_extended_info();
+         lane->object_metadata->get_object_name().c_str());
+  lane->object_metadata->set_extended_object_metadata(nullptr);
+  if (lane->objects_metadata_with_extends_index <
+      lane->objects_metadata_with_extends.size()) {
+    fetch_objects_extended_info(lane);
   } else {
-    add_object_oid_to_probable_dead_oid_list();
+    add_object_oid_to_probable_dead_oid_list(lane);
   }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
@@ -377,6 +411,7 @@ void S3DeleteMultipleObjectsAction::_add_object_oid_to_probable_dead_oid_list(
 }
 
 void S3DeleteMultipleObjectsAction::_add_oids_to_probable_dead_oid_list(
+    S3DeleteMultipleObjectsLane* lane,
     const std::shared_ptr<S3ObjectMetadata>& obj_metadata,
     std::map<std::string, std::string>& delete_list) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
@@ -403,8 +438,8 @@ void S3DeleteMultipleObjectsAction::_add_oids_to_probable_dead_oid_list(
   }
   extended_keys_list = ext_obj->get_extended_entries_key_list();
   // insert entried to the vector which will be used in kv deletion
-  extended_keys_list_to_be_deleted.insert(
-      extended_keys_list_to_be_deleted.end(), extended_keys_list.begin(),
+  lane->extended_keys_list_to_be_deleted.insert(
+      lane->extended_keys_list_to_be_deleted.end(), extended_keys_list.begin(),
       extended_keys_list.end());
   const std::map<int, std::vector<struct s3_part_frag_context>>& ext_entries =
       ext_obj->get_raw_extended_entries();
@@ -437,48 +472,53 @@ void S3DeleteMultipleObjectsAction::_add_oids_to_probable_dead_oid_list(
             false /* force_delete */, false,
             bucket_metadata->get_extended_metadata_index_layout().oid));
     delete_list[oid_str] = probable_oid_list[oid_str]->to_json();
-    extended_oids_to_delete.push_back(
+    lane->extended_oids_to_delete.push_back(
         probable_oid_list[oid_str]->get_current_object_oid());
-    extended_layout_id_for_objs_to_delete.push_back(frag_info.layout_id);
-    extended_pv_ids_to_delete.push_back(frag_info.PVID);
+    lane->extended_layout_id_for_objs_to_delete.push_back(frag_info.layout_id);
+    lane->extended_pv_ids_to_delete.push_back(frag_info.PVID);
   }
 }
 
-void S3DeleteMultipleObjectsAction::add_object_oid_to_probable_dead_oid_list() {
+void S3DeleteMultipleObjectsAction::add_object_oid_to_probable_dead_oid_list(
+    S3DeleteMultipleObjectsLane* lane) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   std::map<std::string, std::string> delete_list;
-  for (const auto& obj : objects_metadata) {
+  for (const auto& obj : lane->objects_metadata) {
     if (obj->get_number_of_fragments() == 0) {
       _add_object_oid_to_probable_dead_oid_list(obj, delete_list);
     } else {
-      _add_oids_to_probable_dead_oid_list(obj, delete_list);
+      _add_oids_to_probable_dead_oid_list(lane, obj, delete_list);
     }
   }
-  motr_kv_writer->put_keyval(
+  lane->motr_kv_writer->put_keyval(
       global_probable_dead_object_list_index_layout, delete_list,
-      std::bind(&S3DeleteMultipleObjectsAction::delete_objects_metadata, this),
+      std::bind(&S3DeleteMultipleObjectsAction::delete_objects_metadata, this,
+                lane),
       std::bind(&S3DeleteMultipleObjectsAction::
                      add_object_oid_to_probable_dead_oid_list_failed,
-                this));
+                this, lane));
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
 void S3DeleteMultipleObjectsAction::
-    add_object_oid_to_probable_dead_oid_list_failed() {
+    add_object_oid_to_probable_dead_oid_list_failed(
+        S3DeleteMultipleObjectsLane* lane) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
-  if (motr_kv_writer->get_state() == S3MotrKVSWriterOpState::failed_to_launch) {
-    set_s3_error("ServiceUnavailable");
+  if (lane->motr_kv_writer->get_state() ==
+      S3MotrKVSWriterOpState::failed_to_launch) {
+    set_lane_error("ServiceUnavailable");
   } else {
-    set_s3_error("InternalError");
+    set_lane_error("InternalError");
   }
-  send_response_to_s3_client();
+  lane_batch_done(lane);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3DeleteMultipleObjectsAction::delete_objects_metadata() {
+void S3DeleteMultipleObjectsAction::delete_objects_metadata(
+    S3DeleteMultipleObjectsLane* lane) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   std::vector<std::string> keys;
-  for (auto& obj : objects_metadata) {
+  for (auto& obj : lane->objects_metadata) {
     if (obj->get_state() != S3ObjectMetadataState::invalid) {
       keys.push_back(obj->get_object_name());
     }
@@ -486,101 +526,117 @@ void S3DeleteMultipleObjectsAction::delete_objects_metadata() {
   if (s3_fi_is_enabled("fail_delete_objects_metadata")) {
     s3_fi_enable_once("motr_kv_delete_fail");
   }
-  motr_kv_writer->delete_keyval(
+  invalidate_cached_objects_metadata(lane);
+  lane->motr_kv_writer->delete_keyval(
       object_list_index_layout, keys,
-      std::bind(&S3DeleteMultipleObjectsAction::delete_extended_metadata, this),
+      std::bind(&S3DeleteMultipleObjectsAction::delete_extended_metadata, this,
+                lane),
       std::bind(&S3DeleteMultipleObjectsAction::delete_objects_metadata_failed,
-                this));
+                this, lane));
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3DeleteMultipleObjectsAction::delete_extended_metadata() {
+void S3DeleteMultipleObjectsAction::invalidate_cached_objects_metadata(
+    S3DeleteMultipleObjectsLane* lane) {
+  S3ObjectMetadataCache* p_cache = S3ObjectMetadataCache::get_instance();
+  if (p_cache) {
+    for (auto& obj : lane->objects_metadata) {
+      p_cache->invalidate(object_list_index_layout.oid, obj->get_object_name());
+    }
+  }
+}
+
+void S3DeleteMultipleObjectsAction::delete_extended_metadata(
+    S3DeleteMultipleObjectsLane* lane) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
-  if (extended_keys_list_to_be_deleted.size() > 0) {
-    motr_kv_writer->delete_keyval(
-        extended_list_index_layout, extended_keys_list_to_be_deleted,
+  // Loads launched during the delete could have cached deleted entries
+  invalidate_cached_objects_metadata(lane);
+  if (lane->extended_keys_list_to_be_deleted.size() > 0) {
+    lane->motr_kv_writer->delete_keyval(
+        extended_list_index_layout, lane->extended_keys_list_to_be_deleted,
         std::bind(
             &S3DeleteMultipleObjectsAction::delete_extended_metadata_successful,
-            this),
+            this, lane),
         std::bind(
             &S3DeleteMultipleObjectsAction::delete_extended_metadata_failed,
-            this));
+            this, lane));
   } else {
-    delete_extended_metadata_successful();
+    delete_extended_metadata_successful(lane);
   }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3DeleteMultipleObjectsAction::delete_extended_metadata_successful() {
+void S3DeleteMultipleObjectsAction::delete_extended_metadata_successful(
+    S3DeleteMultipleObjectsLane* lane) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   at_least_one_delete_successful = true;
-  for (auto& obj : objects_metadata) {
+  for (auto& obj : lane->objects_metadata) {
     delete_objects_response.add_success(obj->get_object_name());
     oids_to_delete.push_back(obj->get_oid());
     layout_id_for_objs_to_delete.push_back(obj->get_layout_id());
     pv_ids_to_delete.push_back(obj->get_pvid());
-    if (extended_oids_to_delete.size() != 0) {
-      oids_to_delete.insert(oids_to_delete.end(),
-                            extended_oids_to_delete.begin(),
-                            extended_oids_to_delete.end());
-      layout_id_for_objs_to_delete.insert(
-          layout_id_for_objs_to_delete.end(),
-          extended_layout_id_for_objs_to_delete.begin(),
-          extended_layout_id_for_objs_to_delete.end());
-      pv_ids_to_delete.insert(pv_ids_to_delete.end(),
-                              extended_pv_ids_to_delete.begin(),
-                              extended_pv_ids_to_delete.end());
-    }
-  }
-
-  if (delete_index_in_req < delete_request.get_count()) {
-    // Try to fetch the remaining
-    fetch_objects_info();
-  } else {
-    send_response_to_s3_client();
   }
+  if (lane->extended_oids_to_delete.size() != 0) {
+    oids_to_delete.insert(oids_to_delete.end(),
+                          lane->extended_oids_to_delete.begin(),
+                          lane->extended_oids_to_delete.end());
+    layout_id_for_objs_to_delete.insert(
+        layout_id_for_objs_to_delete.end(),
+        lane->extended_layout_id_for_objs_to_delete.begin(),
+        lane->extended_layout_id_for_objs_to_delete.end());
+    pv_ids_to_delete.insert(pv_ids_to_delete.end(),
+                            lane->extended_pv_ids_to_delete.begin(),
+                            lane->extended_pv_ids_to_delete.end());
+  }
+  lane_batch_done(lane);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3DeleteMultipleObjectsAction::delete_extended_metadata_failed() {
+void S3DeleteMultipleObjectsAction::delete_extended_metadata_failed(
+    S3DeleteMultipleObjectsLane* lane) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   // Do logging of stale entries and then go ahead with OID deletion
-  if (motr_kv_writer->get_state() == S3MotrKVSWriterOpState::failed_to_launch) {
+  if (lane->motr_kv_writer->get_state() ==
+      S3MotrKVSWriterOpState::failed_to_launch) {
     s3_log(S3_LOG_WARN, request_id,
            "Extended Object metadata delete operation failed due to pre launch "
            "failure this will lead to stale entries\n");
-    for (auto& extended_obj : extended_keys_list_to_be_deleted) {
+    for (auto& extended_obj : lane->extended_keys_list_to_be_deleted) {
       s3_log(S3_LOG_WARN, request_id, "Extended entry %s will be stale",
              extended_obj.c_str());
     }
 
   } else {
     uint obj_index = 0;
-    for (auto& extended_obj_keyname : extended_keys_list_to_be_deleted) {
-      if ((motr_kv_writer->get_op_ret_code_for_del_kv(obj_index) != -ENOENT) &&
-          (motr_kv_writer->get_op_ret_code_for_del_kv(obj_index) != 0)) {
+    for (auto& extended_obj_keyname : lane->extended_keys_list_to_be_deleted) {
+      if ((lane->motr_kv_writer->get_op_ret_code_for_del_kv(obj_index) !=
+           -ENOENT) &&
+          (lane->motr_kv_writer->get_op_ret_code_for_del_kv(obj_index) != 0)) {
         s3_log(S3_LOG_WARN, request_id, "Extended entry %s will be stale",
                extended_obj_keyname.c_str());
       }
       ++obj_index;
     }
   }
-  delete_extended_metadata_successful();
+  delete_extended_metadata_successful(lane);
 }
 
-void S3DeleteMultipleObjectsAction::delete_objects_metadata_failed() {
+void S3DeleteMultipleObjectsAction::delete_objects_metadata_failed(
+    S3DeleteMultipleObjectsLane* lane) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  invalidate_cached_objects_metadata(lane);
 
-  if (motr_kv_writer->get_state() == S3MotrKVSWriterOpState::failed_to_launch) {
+  if (lane->motr_kv_writer->get_state() ==
+      S3MotrKVSWriterOpState::failed_to_launch) {
     s3_log(
         S3_LOG_DEBUG, request_id,
         "Object metadata delete operation failed due to pre launch failure\n");
-    set_s3_error("ServiceUnavailable");
-    send_response_to_s3_client();
+    set_lane_error("ServiceUnavailable");
   } else {
     uint obj_index = 0;
-    for (auto& obj : objects_metadata) {
-      if (motr_kv_writer->get_op_ret_code_for_del_kv(obj_index) == -ENOENT) {
+    for (auto& obj : lane->objects_metadata) {
+      if (lane->motr_kv_writer->get_op_ret_code_for_del_kv(obj_index) ==
+          -ENOENT) {
         at_least_one_delete_successful = true;
         delete_objects_response.add_success(obj->get_object_name());
       } else {
@@ -589,11 +645,26 @@ void S3DeleteMultipleObjectsAction::delete_objects_metadata_failed() {
       }
       ++obj_index;
     }
-    if (delete_index_in_req < delete_request.get_count()) {
-      // Try to fetch the remaining
-      fetch_objects_info();
-    } else {
-      if (!at_least_one_delete_successful) {
+    metadata_errors_seen = true;
+  }
+  lane_batch_done(lane);
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3DeleteMultipleObjectsAction::lane_batch_done(
+    S3DeleteMultipleObjectsLane* lane) {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  if (!is_error_state() && delete_index_in_req < delete_request.get_count()) {
+    // Try to fetch the remaining
+    fetch_next_batch(lane);
+  } else {
+    lane->reset();
+    if (lanes_in_flight > 0) {
+      --lanes_in_flight;
+    }
+    if (lanes_in_flight == 0) {
+      if (!is_error_state() && metadata_errors_seen &&
+          !at_least_one_delete_successful) {
         set_s3_error("InternalError");
       }
       send_response_to_s3_client();
@@ -38,14 +38,41 @@
 #include "s3_object_metadata.h"
 #include "s3_probable_delete_record.h"
 
-class S3DeleteMultipleObjectsAction : public S3BucketAction {
+// Keys of the request are processed in batches of S3_MOTR_MAX_IDX_FETCH_COUNT,
+// up to S3_MOTR_MULTI_DELETE_MAX_INFLIGHT batches at a time. A lane holds the
+// state of one batch, it picks up the next batch once its current one is done.
+struct S3DeleteMultipleObjectsLane {
+  std::shared_ptr<S3MotrKVSReader> motr_kv_reader;
+  std::shared_ptr<S3MotrKVSWriter> motr_kv_writer;
+
+  std::vector<std::string> keys_to_delete;
   std::vector<std::shared_ptr<S3ObjectMetadata>> objects_metadata;
   std::vector<std::shared_ptr<S3ObjectMetadata>> objects_metadata_with_extends;
+  unsigned int objects_metadata_with_extends_index = 0;
   std::shared_ptr<S3ObjectMetadata> object_metadata;
+
   std::vector<std::string> extended_keys_list_to_be_deleted;
+  std::vector<struct m0_uint128> extended_oids_to_delete;
+  std::vector<int> extended_layout_id_for_objs_to_delete;
+  std::vector<struct m0_fid> extended_pv_ids_to_delete;
+
+  void reset() {
+    keys_to_delete.clear();
+    objects_metadata.clear();
+    objects_metadata_with_extends.clear();
+    objects_metadata_with_extends_index = 0;
+    object_metadata.reset();
+    extended_keys_list_to_be_deleted.clear();
+    extended_oids_to_delete.clear();
+    extended_layout_id_for_objs_to_delete.clear();
+    extended_pv_ids_to_delete.clear();
+  }
+};
+
+class S3DeleteMultipleObjectsAction : public S3BucketAction {
   std::shared_ptr<S3MotrWiter> motr_writer;
-  std::shared_ptr<S3MotrKVSReader> motr_kv_reader;
   std::shared_ptr<S3MotrKVSWriter> motr_kv_writer;
+  std::shared_ptr<MotrAPI> s3_motr_api;
 
   std::shared_ptr<S3ObjectMetadataFactory> object_metadata_factory;
   std::shared_ptr<S3MotrWriterFactory> motr_writer_factory;
@@ -57,15 +84,14 @@ class S3DeleteMultipleObjectsAction : public S3BucketAction {
   struct s3_motr_idx_layout extended_list_index_layout = {};
   S3DeleteMultipleObjectsBody delete_request;
   int delete_index_in_req;
+  std::vector<std::unique_ptr<S3DeleteMultipleObjectsLane>> lanes;
+  unsigned int lanes_in_flight = 0;
   std::vector<struct m0_uint128> oids_to_delete;
   std::vector<int> layout_id_for_objs_to_delete;
   std::vector<struct m0_fid> pv_ids_to_delete;
-  std::vector<struct m0_uint128> extended_oids_to_delete;
-  std::vector<int> extended_layout_id_for_objs_to_delete;
-  std::vector<struct m0_fid> extended_pv_ids_to_delete;
-  std::vector<std::string> keys_to_delete;
   bool at_least_one_delete_successful;
-  unsigned int objects_metadata_with_extends_index = 0;
+  // Some keys failed on metadata errors, request fails if nothing got deleted
+  bool metadata_errors_seen = false;
 
   S3DeleteMultipleObjectsResponseBody delete_objects_response;
 
@@ -76,6 +102,10 @@ class S3DeleteMultipleObjectsAction : public S3BucketAction {
     return "BUCKET/" + request->get_bucket_name();
   }
 
+  S3DeleteMultipleObjectsLane* create_lane();
+  // Sets the error of the request unless an earlier lane already did
+  void set_lane_error(const std::string& code);
+
  public:
   S3DeleteMultipleObjectsAction(
       std::shared_ptr<S3RequestObject> req,
@@ -94,23 +124,34 @@ class S3DeleteMultipleObjectsAction : public S3BucketAction {
   void validate_request_body();
 
   void fetch_bucket_info_failed();
+  // Starts up to S3_MOTR_MULTI_DELETE_MAX_INFLIGHT lanes
   void fetch_objects_info();
-  void fetch_objects_info_successful();
-  void fetch_objects_info_failed();
-  void fetch_objects_extended_info();
-  void fetch_objects_extended_info_successful();
-  void fetch_objects_extended_info_failed();
-
-  void delete_objects_metadata();
-  void delete_objects_metadata_failed();
-
-  void delete_extended_metadata();
-  void delete_extended_metadata_failed();
-  void delete_extended_metadata_successful();
-
-  void add_object_oid_to_probable_dead_oid_list();
-  void add_object_oid_to_probable_dead_oid_list_failed();
+  void fetch_next_batch(S3DeleteMultipleObjectsLane* lane);
+  void fetch_objects_info_successful(S3DeleteMultipleObjectsLane* lane);
+  void fetch_objects_info_failed(S3DeleteMultipleObjectsLane* lane);
+  void fetch_objects_extended_info(S3DeleteMultipleObjectsLane* lane);
+  void fetch_objects_extended_info_successful(
+      S3DeleteMultipleObjectsLane* lane);
+  void fetch_objects_extended_info_failed(S3DeleteMultipleObjectsLane* lane);
+
+  void delete_objects_metadata(S3DeleteMultipleObjectsLane* lane);
+  void delete_objects_metadata_failed(S3DeleteMultipleObjectsLane* lane);
+  // Drops entries of the deleted objects from object metadata cache
+  void invalidate_cached_objects_metadata(S3DeleteMultipleObjectsLane* lane);
+
+  void delete_extended_metadata(S3DeleteMultipleObjectsLane* lane);
+  void delete_extended_metadata_failed(S3DeleteMultipleObjectsLane* lane);
+  void delete_extended_metadata_successful(S3DeleteMultipleObjectsLane* lane);
+
+  // Lane moves on to the next batch, the last lane to finish responds
+  void lane_batch_done(S3DeleteMultipleObjectsLane* lane);
+
+  void add_object_oid_to_probable_dead_oid_list(
+      S3DeleteMultipleObjectsLane* lane);
+  void add_object_oid_to_probable_dead_oid_list_failed(
+      S3DeleteMultipleObjectsLane* lane);
   void _add_oids_to_probable_dead_oid_list(
+      S3DeleteMultipleObjectsLane* lane,
       const std::shared_ptr<S3ObjectMetadata>& object_metadata,
       std::map<std::string, std::string>& delete_list);
   void _add_object_oid_to_probable_dead_oid_list(
@@ -190,6 +231,11 @@ class S3DeleteMultipleObjectsAction : public S3BucketAction {
               CleanupOnMetadataSavedDelayedDel);
   FRIEND_TEST(S3DeleteMultipleObjectsActionTest, CleanupOnMetadataSavedTest2);
   FRIEND_TEST(S3DeleteMultipleObjectsActionTest, DelayedDeleteMultipleObjects);
+  FRIEND_TEST(S3DeleteMultipleObjectsActionTest, FetchObjectInfoStartsLanes);
+  FRIEND_TEST(S3DeleteMultipleObjectsActionTest,
+              LaneBatchDoneRespondsAfterLastLane);
+  FRIEND_TEST(S3DeleteMultipleObjectsActionTest,
+              LaneBatchDoneStopsOnErrorAndDrains);
 };
 
 #endif
@@ -23,6 +23,10 @@
 #ifndef __S3_SERVER_S3_DELETE_MULTIPLE_OBJECTS_RESPONSE_BODY_H__
 #define __S3_SERVER_S3_DELETE_MULTIPLE_OBJECTS_RESPONSE_BODY_H__
 
+#include <string>
+
+#include "s3_xml_writer.h"
+
 class SuccessDeleteKey {
   std::string object_key;
   std::string version;
@@ -30,17 +34,20 @@ class SuccessDeleteKey {
  public:
   SuccessDeleteKey(std::string key, std::string id = "") : object_key(key) {}
 
+  static void append_xml(std::string& xml, const std::string& key) {
+    S3XmlWriter writer(xml);
+    writer.add_raw("<Deleted>\n  <Key>");
+    writer.add_text(key);
+    writer.add_raw("</Key>\n");
+    //  "  <VersionId>" + version + "</VersionId>\n"
+    //  "  <DeleteMarker>" + true + "</DeleteMarker>\n"
+    //  "  <DeleteMarkerVersionId>" + true + "</DeleteMarkerVersionId>\n"
+    writer.add_raw("</Deleted>\n");
+  }
+
   std::string to_xml() {
     std::string xml = "";
-    xml +=
-        "<Deleted>\n"
-        "  <Key>" +
-        object_key +
-        "</Key>\n"
-        //  "  <VersionId>" + version + "</VersionId>\n"
-        //  "  <DeleteMarker>" + true + "</DeleteMarker>\n"
-        //  "  <DeleteMarkerVersionId>" + true + "</DeleteMarkerVersionId>\n"
-        "</Deleted>\n";
+    append_xml(xml, object_key);
     return xml;
   }
 };
@@ -54,49 +61,59 @@ class ErrorDeleteKey {
   ErrorDeleteKey(std::string key, std::string code, std::string msg)
       : object_key(key), error_code(code), error_message(msg) {}
 
+  static void append_xml(std::string& xml, const std::string& key,
+                         const std::string& code, const std::string& message) {
+    S3XmlWriter writer(xml);
+    writer.add_raw("<Error>\n  <Key>");
+    writer.add_text(key);
+    writer.add_raw("</Key>\n");
+    //  "  <VersionId>" + owner_name + "</VersionId>\n"
+    writer.add_raw("  <Code>");
+    writer.add_text(code);
+    writer.add_raw("</Code>\n  <Message>");
+    writer.add_text(message);
+    writer.add_raw("</Message>\n</Error>\n");
+  }
+
   std::string to_xml() {
     std::string xml = "";
-    xml +=
-        "<Error>\n"
-        "  <Key>" +
-        object_key +
-        "</Key>\n"
-        //  "  <VersionId>" + owner_name + "</VersionId>\n"
-        "  <Code>" +
-        error_code +
-        "</Code>\n"
-        "  <Message>" +
-        error_message +
-        "</Message>\n"
-        "</Error>\n";
+    append_xml(xml, object_key, error_code, error_message);
     return xml;
   }
 };
 
 class S3DeleteMultipleObjectsResponseBody {
-  std::vector<SuccessDeleteKey> success;
-  // key, errorcode
-  std::vector<ErrorDeleteKey> error;
+  // <Deleted> and <Error> elements are serialized as the keys complete, so
+  // the final response is a concatenation instead of a walk over all keys.
+  std::string success_xml;
+  std::string error_xml;
+  size_t success_count = 0;
+  size_t error_count = 0;
 
   std::string response_xml;
 
  public:
-  void add_success(std::string key, std::string version = "") {
-    success.push_back(SuccessDeleteKey(key, version));
+  void add_success(const std::string& key, const std::string& version = "") {
+    SuccessDeleteKey::append_xml(success_xml, key);
+    ++success_count;
   }
 
-  size_t get_success_count() { return success.size(); }
+  size_t get_success_count() { return success_count; }
 
-  void add_failure(std::string key, std::string code,
-                   std::string message = "") {
-    error.push_back(ErrorDeleteKey(key, code, message));
+  void add_failure(const std::string& key, const std::string& code,
+                   const std::string& message = "") {
+    ErrorDeleteKey::append_xml(error_xml, key, code, message);
+    ++error_count;
   }
 
-  size_t get_failure_count() { return error.size(); }
+  size_t get_failure_count() { return error_count; }
 
   std::string& to_xml(bool quiet_mode = false) {
 
-    response_xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    response_xml.clear();
+    response_xml.reserve(128 + (quiet_mode ? 0 : success_xml.size()) +
+                         error_xml.size());
+    response_xml += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
     response_xml +=
         "<DeleteResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">";
 
@@ -106,13 +123,9 @@ class S3DeleteMultipleObjectsResponseBody {
     // encountered an error.
 
     if (!quiet_mode) {
-      for (auto sitem : success) {
-        response_xml += sitem.to_xml();
-      }
-    }
-    for (auto eitem : error) {
-      response_xml += eitem.to_xml();
+      response_xml += success_xml;
     }
+    response_xml += error_xml;
     response_xml += "</DeleteResult>";
     return response_xml;
   }
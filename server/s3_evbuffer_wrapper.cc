@@ -19,12 +19,20 @@
  */
 
 #include "s3_evbuffer_wrapper.h"
+#include "s3_mem_pool_manager.h"
 #include "s3_motr_context.h"
 #include "s3_option.h"
 
+// evbuffer cleanup callback of pool buffers, buffer length is the unit size
+static void release_pool_buffer(const void* data, size_t datalen, void*) {
+  S3MempoolManager::get_instance()->release_buffer_for_unit_size(
+      const_cast<void*>(data), datalen);
+}
+
 // Create evbuffer of size buf_sz, with each basic buffer buf_unit_sz
 S3Evbuffer::S3Evbuffer(const std::string req_id, size_t buf_sz,
-                       int buf_unit_sz) {
+                       int buf_unit_sz, bool f_pool_buffers)
+    : f_pool_buffers(f_pool_buffers) {
   p_evbuf = evbuffer_new();
   assert(p_evbuf);
   assert(buf_unit_sz);
@@ -42,6 +50,9 @@ int S3Evbuffer::init() {
     s3_log(S3_LOG_ERROR, request_id, "memory allocation failure\n");
     return -ENOMEM;
   }
+  if (f_pool_buffers) {
+    return init_pool_buffers();
+  }
   for (size_t i = 0; i < nvecs; i++) {
     // Reserve buf_sz bytes memory
     int no_of_extends =
@@ -74,19 +85,51 @@ int S3Evbuffer::init() {
     }
   }
   // Log mempool stats
-  struct pool_info poolinfo;
-  int rc = event_mempool_getinfo(&poolinfo);
-  if (rc != 0) {
-    s3_log(S3_LOG_FATAL, "", "Issue with memory pool!\n");
-  } else {
-    s3_log(S3_LOG_DEBUG, "",
-           "mempool info after allocation : mempool_item_size = %zu "
-           "free_bufs_in_pool = %d "
-           "number_of_bufs_shared = %d "
-           "total_bufs_allocated_by_pool = %d\n",
-           poolinfo.mempool_item_size, poolinfo.free_bufs_in_pool,
-           poolinfo.number_of_bufs_shared,
-           poolinfo.total_bufs_allocated_by_pool);
+  if (s3log_level <= S3_LOG_DEBUG) {
+    struct pool_info poolinfo;
+    int rc = event_mempool_getinfo(&poolinfo);
+    if (rc != 0) {
+      s3_log(S3_LOG_FATAL, "", "Issue with memory pool!\n");
+    } else {
+      s3_log(S3_LOG_DEBUG, "",
+             "mempool info after allocation : mempool_item_size = %zu "
+             "free_bufs_in_pool = %d "
+             "number_of_bufs_shared = %d "
+             "total_bufs_allocated_by_pool = %d\n",
+             poolinfo.mempool_item_size, poolinfo.free_bufs_in_pool,
+             poolinfo.number_of_bufs_shared,
+             poolinfo.total_bufs_allocated_by_pool);
+    }
+  }
+  return 0;
+}
+
+bool S3Evbuffer::can_use_pool_buffers(size_t unit_size) {
+  return S3Option::get_instance()->get_motr_read_unit_buffers() &&
+         S3MempoolManager::get_instance()->has_pool_for_unit_size(unit_size);
+}
+
+int S3Evbuffer::init_pool_buffers() {
+  for (size_t i = 0; i < nvecs; i++) {
+    void* buf = S3MempoolManager::get_instance()->get_buffer_for_unit_size(
+        buffer_unit_sz);
+    if (buf == nullptr) {
+      s3_log(S3_LOG_ERROR, request_id,
+             "Failed to get motr read buffer, i = %zu buffer_unit_sz = %zu\n",
+             i, buffer_unit_sz);
+      return -ENOMEM;
+    }
+    // Content is filled by motr later, the evbuffer only refers to it
+    if (evbuffer_add_reference(p_evbuf, buf, buffer_unit_sz,
+                               release_pool_buffer, nullptr) != 0) {
+      s3_log(S3_LOG_ERROR, request_id,
+             "evbuffer_add_reference failed i = %zu, nvecs = %zu\n", i, nvecs);
+      S3MempoolManager::get_instance()->release_buffer_for_unit_size(
+          buf, buffer_unit_sz);
+      return -1;
+    }
+    vec[i].iov_base = buf;
+    vec[i].iov_len = buffer_unit_sz;
   }
   return 0;
 }
@@ -38,6 +38,10 @@
 //  delete evbuf;
 //  ...
 //  evhtp_obj->http_send_reply_body(ev_req, evbuf);
+//
+//  With f_pool_buffers each basic buffer is a buffer_unit_sz buffer taken from
+//  S3MempoolManager pool of that unit size and referenced by the evbuffer, the
+//  buffer goes back to the pool when the evbuffer releases it.
 
 class S3Evbuffer {
   struct evbuffer *p_evbuf;
@@ -47,11 +51,18 @@ class S3Evbuffer {
   size_t nvecs;
   size_t total_size;
   size_t buffer_unit_sz;
+  bool f_pool_buffers;
   std::string request_id;
 
+  int init_pool_buffers();
+
  public:
   // Create evbuffer of size buf_sz
-  S3Evbuffer(std::string request_id, size_t buf_sz, int buf_unit_sz = 16384);
+  S3Evbuffer(std::string request_id, size_t buf_sz, int buf_unit_sz = 16384,
+             bool f_pool_buffers = false);
+
+  // Whether motr read buffers of unit_size can be taken from S3MempoolManager
+  static bool can_use_pool_buffers(size_t unit_size);
 
   int init();
   inline unsigned int const get_nvecs() { return nvecs; }
@@ -159,7 +159,9 @@ class S3MotrKVSReaderFactory {
       std::shared_ptr<MotrAPI> s3_motr_api = nullptr) {
     s3_log(S3_LOG_DEBUG, "",
            "S3MotrKVSReaderFactory::create_motr_kvs_reader\n");
-    return std::make_shared<S3MotrKVSReader>(req, s3_motr_api);
+    // Readers are released with the request, keep them in its arena
+    S3RequestArena* arena = req ? req->get_arena() : nullptr;
+    return s3_arena_make_shared<S3MotrKVSReader>(arena, req, s3_motr_api);
   }
 };
 
@@ -26,11 +26,13 @@
 #include <algorithm>
 
 std::unique_ptr<S3FakeMotrKvs> S3FakeMotrKvs::inst;
+std::once_flag S3FakeMotrKvs::inst_once;
 
 S3FakeMotrKvs::S3FakeMotrKvs() : in_mem_kv() {}
 
 int S3FakeMotrKvs::kv_read(struct m0_uint128 const &oid,
                            struct s3_motr_kvs_op_context const &kv) {
+  std::lock_guard<std::mutex> lock(kv_lock);
   s3_log(S3_LOG_DEBUG, "", "%s Entry with oid %" SCNx64 " : %" SCNx64 "\n",
          __func__, oid.u_hi, oid.u_lo);
   if (in_mem_kv.count(oid) == 0) {
@@ -63,6 +65,7 @@ int S3FakeMotrKvs::kv_read(struct m0_uint128 const &oid,
 
 int S3FakeMotrKvs::kv_next(struct m0_uint128 const &oid,
                            struct s3_motr_kvs_op_context const &kv) {
+  std::lock_guard<std::mutex> lock(kv_lock);
   s3_log(S3_LOG_DEBUG, "", "%s Entry with oid %" SCNx64 " : %" SCNx64 "\n",
          __func__, oid.u_hi, oid.u_lo);
   if (in_mem_kv.count(oid) == 0) {
@@ -127,6 +130,7 @@ int S3FakeMotrKvs::kv_next(struct m0_uint128 const &oid,
 
 int S3FakeMotrKvs::kv_write(struct m0_uint128 const &oid,
                             struct s3_motr_kvs_op_context const &kv) {
+  std::lock_guard<std::mutex> lock(kv_lock);
   s3_log(S3_LOG_DEBUG, "", "%s Entry with oid %" SCNx64 " : %" SCNx64 "\n",
          __func__, oid.u_hi, oid.u_lo);
   KeyVal &obj_kv = in_mem_kv[oid];
@@ -149,6 +153,7 @@ int S3FakeMotrKvs::kv_write(struct m0_uint128 const &oid,
 
 int S3FakeMotrKvs::kv_del(struct m0_uint128 const &oid,
                           struct s3_motr_kvs_op_context const &kv) {
+  std::lock_guard<std::mutex> lock(kv_lock);
   s3_log(S3_LOG_DEBUG, "", "%s Entry with oid %" SCNx64 " : %" SCNx64 "\n",
          __func__, oid.u_hi, oid.u_lo);
   if (in_mem_kv.count(oid) == 0) {
@@ -26,6 +26,7 @@
 #include "s3_motr_context.h"
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 class S3FakeMotrKvs {
@@ -41,9 +42,12 @@ class S3FakeMotrKvs {
   };
 
   std::map<struct m0_uint128, KeyVal, Uint128Comp> in_mem_kv;
+  // Ops come from every reactor
+  std::mutex kv_lock;
 
  private:
   static std::unique_ptr<S3FakeMotrKvs> inst;
+  static std::once_flag inst_once;
 
  public:
   virtual ~S3FakeMotrKvs() {}
@@ -62,9 +66,7 @@ class S3FakeMotrKvs {
 
  public:
   static S3FakeMotrKvs *instance() {
-    if (!inst) {
-      inst = std::unique_ptr<S3FakeMotrKvs>(new S3FakeMotrKvs());
-    }
+    std::call_once(inst_once, []() { inst.reset(new S3FakeMotrKvs()); });
     return inst.get();
   }
 };
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "s3_fake_motr_obj_store.h"
+#include "s3_log.h"
+#include "s3_option.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+
+std::unique_ptr<S3FakeMotrObjStore> S3FakeMotrObjStore::inst;
+std::once_flag S3FakeMotrObjStore::inst_once;
+
+S3FakeMotrObjStore::S3FakeMotrObjStore(const std::string &dir) : dir(dir) {
+  s3_log(S3_LOG_INFO, "", "%s Fake motr object data kept in %s\n", __func__,
+         dir.empty() ? "memory" : dir.c_str());
+}
+
+S3FakeMotrObjStore *S3FakeMotrObjStore::instance() {
+  // Faked ops of every reactor may get here first
+  std::call_once(inst_once, []() {
+    inst.reset(new S3FakeMotrObjStore(
+        S3Option::get_instance()->get_fake_motr_obj_store_dir()));
+  });
+  return inst.get();
+}
+
+std::string S3FakeMotrObjStore::get_path(struct m0_uint128 const &oid) const {
+  char name[64];
+  snprintf(name, sizeof(name), "/%016" PRIx64 "-%016" PRIx64, oid.u_hi,
+           oid.u_lo);
+  return dir + name;
+}
+
+int S3FakeMotrObjStore::obj_create(struct m0_uint128 const &oid) {
+  s3_log(S3_LOG_DEBUG, "", "%s Entry with oid %" SCNx64 " : %" SCNx64 "\n",
+         __func__, oid.u_hi, oid.u_lo);
+  if (is_file_backed()) {
+    int fd = open(get_path(oid).c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+      return -errno;
+    }
+    close(fd);
+    return 0;
+  }
+  std::lock_guard<std::mutex> guard(lock);
+  if (!in_mem_obj.emplace(oid, std::string()).second) {
+    return -EEXIST;
+  }
+  return 0;
+}
+
+int S3FakeMotrObjStore::obj_open(struct m0_uint128 const &oid) {
+  s3_log(S3_LOG_DEBUG, "", "%s Entry with oid %" SCNx64 " : %" SCNx64 "\n",
+         __func__, oid.u_hi, oid.u_lo);
+  if (is_file_backed()) {
+    return access(get_path(oid).c_str(), F_OK) == 0 ? 0 : -errno;
+  }
+  std::lock_guard<std::mutex> guard(lock);
+  return in_mem_obj.count(oid) ? 0 : -ENOENT;
+}
+
+int S3FakeMotrObjStore::obj_delete(struct m0_uint128 const &oid) {
+  s3_log(S3_LOG_DEBUG, "", "%s Entry with oid %" SCNx64 " : %" SCNx64 "\n",
+         __func__, oid.u_hi, oid.u_lo);
+  if (is_file_backed()) {
+    return unlink(get_path(oid).c_str()) == 0 ? 0 : -errno;
+  }
+  std::lock_guard<std::mutex> guard(lock);
+  return in_mem_obj.erase(oid) ? 0 : -ENOENT;
+}
+
+int S3FakeMotrObjStore::obj_write(struct m0_uint128 const &oid,
+                                  struct m0_indexvec const &ext,
+                                  struct m0_bufvec const &data) {
+  uint32_t nr = std::min(ext.iv_vec.v_nr, data.ov_vec.v_nr);
+  s3_log(S3_LOG_DEBUG, "",
+         "%s Entry with oid %" SCNx64 " : %" SCNx64 ", %u extents\n", __func__,
+         oid.u_hi, oid.u_lo, nr);
+  if (is_file_backed()) {
+    int fd = open(get_path(oid).c_str(), O_WRONLY);
+    if (fd < 0) {
+      return -errno;
+    }
+    int rc = 0;
+    for (uint32_t i = 0; i < nr && rc == 0; ++i) {
+      const char *buf = (const char *)data.ov_buf[i];
+      size_t len = std::min(ext.iv_vec.v_count[i], data.ov_vec.v_count[i]);
+      off_t offset = ext.iv_index[i];
+      while (len > 0) {
+        ssize_t written = pwrite(fd, buf, len, offset);
+        if (written < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          rc = -errno;
+          break;
+        }
+        buf += written;
+        len -= written;
+        offset += written;
+      }
+    }
+    close(fd);
+    return rc;
+  }
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = in_mem_obj.find(oid);
+  if (it == in_mem_obj.end()) {
+    return -ENOENT;
+  }
+  std::string &obj_data = it->second;
+  for (uint32_t i = 0; i < nr; ++i) {
+    size_t len = std::min(ext.iv_vec.v_count[i], data.ov_vec.v_count[i]);
+    size_t offset = ext.iv_index[i];
+    if (obj_data.size() < offset + len) {
+      obj_data.resize(offset + len);
+    }
+    obj_data.replace(offset, len, (const char *)data.ov_buf[i], len);
+  }
+  return 0;
+}
+
+int S3FakeMotrObjStore::obj_read(struct m0_uint128 const &oid,
+                                 struct m0_indexvec const &ext,
+                                 struct m0_bufvec const &data) {
+  uint32_t nr = std::min(ext.iv_vec.v_nr, data.ov_vec.v_nr);
+  s3_log(S3_LOG_DEBUG, "",
+         "%s Entry with oid %" SCNx64 " : %" SCNx64 ", %u extents\n", __func__,
+         oid.u_hi, oid.u_lo, nr);
+  if (is_file_backed()) {
+    int fd = open(get_path(oid).c_str(), O_RDONLY);
+    if (fd < 0) {
+      return -errno;
+    }
+    int rc = 0;
+    for (uint32_t i = 0; i < nr && rc == 0; ++i) {
+      char *buf = (char *)data.ov_buf[i];
+      size_t len = std::min(ext.iv_vec.v_count[i], data.ov_vec.v_count[i]);
+      off_t offset = ext.iv_index[i];
+      while (len > 0) {
+        ssize_t got = pread(fd, buf, len, offset);
+        if (got < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          rc = -errno;
+          break;
+        }
+        if (got == 0) {
+          memset(buf, 0, len);
+          break;
+        }
+        buf += got;
+        len -= got;
+        offset += got;
+      }
+    }
+    close(fd);
+    return rc;
+  }
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = in_mem_obj.find(oid);
+  if (it == in_mem_obj.end()) {
+    return -ENOENT;
+  }
+  const std::string &obj_data = it->second;
+  for (uint32_t i = 0; i < nr; ++i) {
+    char *buf = (char *)data.ov_buf[i];
+    size_t len = std::min(ext.iv_vec.v_count[i], data.ov_vec.v_count[i]);
+    size_t offset = ext.iv_index[i];
+    size_t copied = 0;
+    if (offset < obj_data.size()) {
+      copied = obj_data.copy(buf, len, offset);
+    }
+    memset(buf + copied, 0, len - copied);
+  }
+  return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_FAKE_MOTR_OBJ_STORE_H__
+#define __S3_SERVER_FAKE_MOTR_OBJ_STORE_H__
+
+#include "s3_motr_context.h"
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Object data of the fake motr mode. Objects are kept in memory, or in
+// files of a directory when one is given, so data written by PUT can be
+// read back by GET without a motr cluster.
+class S3FakeMotrObjStore {
+ private:
+  struct Uint128Comp {
+    bool operator()(struct m0_uint128 const &a,
+                    struct m0_uint128 const &b) const {
+      return std::memcmp((void *)&a, (void *)&b, sizeof(a)) < 0;
+    }
+  };
+
+  // Empty for the in-memory store
+  std::string dir;
+  std::map<struct m0_uint128, std::string, Uint128Comp> in_mem_obj;
+  // Ops of all reactors
+  std::mutex lock;
+
+  static std::unique_ptr<S3FakeMotrObjStore> inst;
+  static std::once_flag inst_once;
+
+  std::string get_path(struct m0_uint128 const &oid) const;
+
+ public:
+  explicit S3FakeMotrObjStore(const std::string &dir = "");
+  virtual ~S3FakeMotrObjStore() {}
+
+  bool is_file_backed() const { return !dir.empty(); }
+
+  // Return 0 or negative errno, as motr ops do
+  int obj_create(struct m0_uint128 const &oid);
+  int obj_open(struct m0_uint128 const &oid);
+  int obj_delete(struct m0_uint128 const &oid);
+
+  // Buffer i of data is written at ext index i
+  int obj_write(struct m0_uint128 const &oid, struct m0_indexvec const &ext,
+                struct m0_bufvec const &data);
+  // Parts of ext past the end of the object read as zeros
+  int obj_read(struct m0_uint128 const &oid, struct m0_indexvec const &ext,
+               struct m0_bufvec const &data);
+
+  static S3FakeMotrObjStore *instance();
+  static void destroy_instance() { inst.reset(); }
+};
+
+#endif
@@ -29,7 +29,7 @@
 #include "s3_motr_kvs_writer.h"
 #include "s3_motr_rw_common.h"
 
-std::unique_ptr<S3FakeMotrRedisKvs> S3FakeMotrRedisKvs::inst;
+thread_local std::unique_ptr<S3FakeMotrRedisKvs> S3FakeMotrRedisKvs::inst;
 
 void finalize_op(struct m0_op *op, op_stable_cb stable, op_failed_cb failed) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry", __func__);
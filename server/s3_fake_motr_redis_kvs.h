@@ -38,7 +38,10 @@ class S3FakeMotrRedisKvs {
   redisAsyncContext *redis_ctx = nullptr;
 
  private:
-  static std::unique_ptr<S3FakeMotrRedisKvs> inst;
+  // Connection is attached to the loop of a reactor, so every reactor
+  // thread has its own; the ones of additional reactors are closed when
+  // their threads exit.
+  static thread_local std::unique_ptr<S3FakeMotrRedisKvs> inst;
 
   static void connect_cb(const redisAsyncContext *c, int status) {
     s3_log(S3_LOG_DEBUG, "", "%s Entry", __func__);
@@ -31,7 +31,8 @@ void S3FaultinjectionAPIHandler::create_action() {
       // Perform operation on Service.
       switch (request->http_verb()) {
         case S3HttpVerb::PUT:
-          action = std::make_shared<S3PutFiAction>(request);
+          action = s3_arena_make_shared<S3PutFiAction>(
+              request->get_arena(), request);
           break;
         default:
           // should never be here.
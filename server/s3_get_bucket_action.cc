@@ -18,6 +18,7 @@
  *
  */
 
+#include <iterator>
 #include <string>
 
 #include "s3_error_codes.h"
@@ -67,7 +68,7 @@ S3GetBucketAction::S3GetBucketAction(
   } else {
     object_metadata_factory = std::make_shared<S3ObjectMetadataFactory>();
   }
-  motr_kv_reader = nullptr;
+  motr_kv_cursor = nullptr;
   b_first_next_keyval_call = true;
   // When we skip keys with same common prefix, we need a way to indicate
   // a state in which we'll make use of existing key fetch logic just to see if
@@ -156,12 +157,12 @@ void S3GetBucketAction::get_next_objects() {
   const auto& object_list_index_layout =
       bucket_metadata->get_object_list_index_layout();
 
-  if (motr_kv_reader == nullptr) {
-    motr_kv_reader = s3_motr_kvs_reader_factory->create_motr_kvs_reader(
-        request, s3_motr_api);
+  if (motr_kv_cursor == nullptr) {
+    motr_kv_cursor = std::make_shared<S3MotrKVSScanCursor>(
+        request, s3_motr_kvs_reader_factory, s3_motr_api);
   }
 
-  if (motr_kv_reader->get_state() == S3MotrKVSReaderOpState::failed_e2big) {
+  if (motr_kv_cursor->get_state() == S3MotrKVSReaderOpState::failed_e2big) {
     if (retry_count > MAX_RETRY_COUNT) {
       max_record_count = 1;
     } else {
@@ -184,6 +185,8 @@ void S3GetBucketAction::get_next_objects() {
     object_list->set_key_count(key_Count);
     send_response_to_s3_client();
   } else {
+    motr_kv_cursor->set_key_budget(max_keys > key_Count ? max_keys - key_Count
+                                                        : 0);
     // We pass M0_OIF_EXCLUDE_START_KEY flag to Motr. This flag skips key that
     // is passed during listing of all keys. If this flag is not passed then
     // input key is returned in result.
@@ -191,12 +194,12 @@ void S3GetBucketAction::get_next_objects() {
         b_first_next_keyval_call) {
       b_first_next_keyval_call = false;
       last_key = request_prefix;
-      motr_kv_reader->next_keyval(
+      motr_kv_cursor->next_keyval(
           object_list_index_layout, last_key, max_record_count,
           std::bind(&S3GetBucketAction::get_next_objects_successful, this),
           std::bind(&S3GetBucketAction::get_next_objects_failed, this), 0);
     } else {
-      motr_kv_reader->next_keyval(
+      motr_kv_cursor->next_keyval(
           object_list_index_layout, last_key, max_record_count,
           std::bind(&S3GetBucketAction::get_next_objects_successful, this),
           std::bind(&S3GetBucketAction::get_next_objects_failed, this));
@@ -224,7 +227,7 @@ void S3GetBucketAction::get_next_objects_successful() {
   bool skip_no_further_prefix_match = false;
   bool b_skip_remaining_common_prefixes = false;
   std::string last_common_prefix = "";
-  auto& kvps = motr_kv_reader->get_key_values();
+  auto& kvps = motr_kv_cursor->get_key_values();
   size_t length = kvps.size();
   if (b_state_start_check_any_more_keys) {
     // Check if this is the call to identify any more keys left
@@ -266,7 +269,8 @@ void S3GetBucketAction::get_next_objects_successful() {
     total_keys_visited += length;
   }
 
-  for (auto& kv : kvps) {
+  for (auto it = kvps.begin(); it != kvps.end(); ++it) {
+    auto& kv = *it;
     s3_log(S3_LOG_DEBUG, request_id, "Read Object = %s\n", kv.first.c_str());
     s3_log(S3_LOG_DEBUG, request_id, "Read Object Value = %s\n",
            kv.second.second.c_str());
@@ -405,13 +409,22 @@ void S3GetBucketAction::get_next_objects_successful() {
           last_key_in_common_prefix = true;
         }
         if (b_skip_remaining_common_prefixes) {
-          // Skip remaining common prefixes
-          // For this, set last key for the next key enumeration and break
-          last_key = common_prefix + "\xff";
-          s3_log(S3_LOG_DEBUG, request_id,
-                 "Skipping further common prefixes, set next key = [%s]\n",
-                 last_key.c_str());
-          break;
+          // Skip remaining keys of the common prefix.  If the batch holds a
+          // key past them, carry on from it, else seek past the common
+          // prefix with the next key enumeration.
+          auto kv_past_prefix = kvps.upper_bound(common_prefix + "\xff");
+          if (kv_past_prefix == kvps.end()) {
+            last_key = common_prefix + "\xff";
+            s3_log(S3_LOG_DEBUG, request_id,
+                   "Skipping further common prefixes, set next key = [%s]\n",
+                   last_key.c_str());
+            break;
+          }
+          length -= std::distance(it, kv_past_prefix);
+          it = std::prev(kv_past_prefix);
+          last_key = it->first;
+          b_skip_remaining_common_prefixes = false;
+          continue;
         }
       }
     } else {
@@ -459,13 +472,20 @@ void S3GetBucketAction::get_next_objects_successful() {
             last_key_in_common_prefix = true;
           }
           if (b_skip_remaining_common_prefixes) {
-            // Skip remaining common prefixes
-            // For this, set last key for the next key enumeration and break
-            last_key = common_prefix + "\xff";
-            s3_log(S3_LOG_DEBUG, request_id,
-                   "Skipping further common prefixes, set next key = [%s]\n",
-                   last_key.c_str());
-            break;
+            // Skip remaining keys of the common prefix, see above
+            auto kv_past_prefix = kvps.upper_bound(common_prefix + "\xff");
+            if (kv_past_prefix == kvps.end()) {
+              last_key = common_prefix + "\xff";
+              s3_log(S3_LOG_DEBUG, request_id,
+                     "Skipping further common prefixes, set next key = [%s]\n",
+                     last_key.c_str());
+              break;
+            }
+            length -= std::distance(it, kv_past_prefix);
+            it = std::prev(kv_past_prefix);
+            last_key = it->first;
+            b_skip_remaining_common_prefixes = false;
+            continue;
           }
         }
       } else {
@@ -550,19 +570,19 @@ void S3GetBucketAction::get_next_objects_successful() {
 
 void S3GetBucketAction::get_next_objects_failed() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
-  if (motr_kv_reader->get_state() == S3MotrKVSReaderOpState::missing) {
+  if (motr_kv_cursor->get_state() == S3MotrKVSReaderOpState::missing) {
     s3_log(S3_LOG_DEBUG, request_id, "No Objects found in Object listing\n");
     // reset state
     b_state_start_check_any_more_keys = false;
     fetch_successful = true;  // With no entries.
     object_list->set_key_count(key_Count);
-  } else if (motr_kv_reader->get_state() ==
+  } else if (motr_kv_cursor->get_state() ==
              S3MotrKVSReaderOpState::failed_to_launch) {
     s3_log(S3_LOG_ERROR, request_id,
            "Bucket metadata next keyval operation failed due to pre launch "
            "failure\n");
     set_s3_error("ServiceUnavailable");
-  } else if (motr_kv_reader->get_state() ==
+  } else if (motr_kv_cursor->get_state() ==
              S3MotrKVSReaderOpState::failed_e2big) {
     s3_log(S3_LOG_ERROR, request_id,
            "Next keyval operation failed due rpc message size threshold\n");
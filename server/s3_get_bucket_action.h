@@ -27,14 +27,14 @@
 
 #include "s3_bucket_action_base.h"
 #include "s3_bucket_metadata.h"
-#include "s3_motr_kvs_reader.h"
+#include "s3_motr_kvs_scan_cursor.h"
 #include "s3_factory.h"
 #include "s3_object_list_response.h"
 
 class S3GetBucketAction : public S3BucketAction {
   std::shared_ptr<S3MotrKVSReaderFactory> s3_motr_kvs_reader_factory;
   std::shared_ptr<S3ObjectMetadataFactory> object_metadata_factory;
-  std::shared_ptr<S3MotrKVSReader> motr_kv_reader;
+  std::shared_ptr<S3MotrKVSScanCursor> motr_kv_cursor;
   std::shared_ptr<MotrAPI> s3_motr_api;
   size_t max_record_count;
   short retry_count = 0;
@@ -118,6 +118,8 @@ class S3GetBucketAction : public S3BucketAction {
   FRIEND_TEST(S3GetBucketActionTest,
               GetNextObjectsSuccessfulPrefixDelimMultiComponentKey);
   FRIEND_TEST(S3GetBucketActionTest, GetNextObjectsSuccessfulDelimiterLastKey);
+  FRIEND_TEST(S3GetBucketActionTest,
+              GetNextObjectsSuccessfulDelimiterSkipsInBatch);
 };
 
 #endif
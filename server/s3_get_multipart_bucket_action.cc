@@ -18,6 +18,7 @@
  *
  */
 
+#include <iterator>
 #include <string>
 
 #include "s3_error_codes.h"
@@ -145,10 +146,16 @@ void S3GetMultipartBucketAction::get_next_objects() {
     send_response_to_s3_client();
   } else {
     size_t count = S3Option::get_instance()->get_motr_idx_fetch_count();
-    motr_kv_reader = s3_motr_kvs_reader_factory->create_motr_kvs_reader(
-        request, s3_motr_api);
-    motr_kv_reader->next_keyval(
-        bucket_metadata->get_multipart_index_layout(), last_key, count,
+    if (motr_kv_cursor == nullptr) {
+      motr_kv_cursor = std::make_shared<S3MotrKVSScanCursor>(
+          request, s3_motr_kvs_reader_factory, s3_motr_api);
+    }
+    std::string start_key = seek_key.empty() ? last_key : seek_key;
+    seek_key.clear();
+    motr_kv_cursor->set_key_budget(
+        max_uploads > return_list_size ? max_uploads - return_list_size : 0);
+    motr_kv_cursor->next_keyval(
+        bucket_metadata->get_multipart_index_layout(), start_key, count,
         std::bind(&S3GetMultipartBucketAction::get_next_objects_successful,
                   this),
         std::bind(&S3GetMultipartBucketAction::get_next_objects_failed, this));
@@ -165,10 +172,11 @@ void S3GetMultipartBucketAction::get_next_objects_successful() {
   const auto& mp_idx_lo = bucket_metadata->get_multipart_index_layout();
   bool atleast_one_json_error = false;
   bool skip_marker_key = true;
-  auto& kvps = motr_kv_reader->get_key_values();
+  auto& kvps = motr_kv_cursor->get_key_values();
   size_t length = kvps.size();
   multipart_object_list.chop_uploadid_from_key();
-  for (auto& kv : kvps) {
+  for (auto it = kvps.begin(); it != kvps.end(); ++it) {
+    auto& kv = *it;
     s3_log(S3_LOG_DEBUG, request_id, "Read Object = %s\n", kv.first.c_str());
     auto object = object_metadata_factory->create_object_metadata_obj(request);
     size_t delimiter_pos = std::string::npos;
@@ -214,8 +222,12 @@ void S3GetMultipartBucketAction::get_next_objects_successful() {
         s3_log(S3_LOG_DEBUG, request_id,
                "Delimiter %s found at pos %zu in string %s\n",
                request_delimiter.c_str(), delimiter_pos, kv.first.c_str());
-        multipart_object_list.add_common_prefix(
-            kv.first.substr(0, delimiter_pos + 1));
+        std::string common_prefix = kv.first.substr(0, delimiter_pos + 1);
+        multipart_object_list.add_common_prefix(common_prefix);
+        if (skip_common_prefix(common_prefix, it, length)) {
+          continue;
+        }
+        break;
       }
     } else {
       // both prefix and delimiter are not empty
@@ -230,8 +242,12 @@ void S3GetMultipartBucketAction::get_next_objects_successful() {
           s3_log(S3_LOG_DEBUG, request_id,
                  "Delimiter %s found at pos %zu in string %s\n",
                  request_delimiter.c_str(), delimiter_pos, kv.first.c_str());
-          multipart_object_list.add_common_prefix(
-              kv.first.substr(0, delimiter_pos + 1));
+          std::string common_prefix = kv.first.substr(0, delimiter_pos + 1);
+          multipart_object_list.add_common_prefix(common_prefix);
+          if (skip_common_prefix(common_prefix, it, length)) {
+            continue;
+          }
+          break;
         }
       }  // else no prefix match, filter it out
     }
@@ -265,12 +281,31 @@ void S3GetMultipartBucketAction::get_next_objects_successful() {
   }
 }
 
+bool S3GetMultipartBucketAction::skip_common_prefix(
+    const std::string& common_prefix, KeyValIterator& it, size_t& length) {
+  // Keys rolled into the common prefix add nothing to the listing
+  const auto& kvps = motr_kv_cursor->get_key_values();
+  auto kv_past_prefix = kvps.upper_bound(common_prefix + "\xff");
+  if (kv_past_prefix == kvps.end()) {
+    // The rest of the batch belongs to the common prefix,
+    // next key enumeration seeks past it.
+    seek_key = common_prefix + "\xff";
+    s3_log(S3_LOG_DEBUG, request_id,
+           "Skipping further common prefixes, set next key = [%s]\n",
+           seek_key.c_str());
+    return false;
+  }
+  length -= std::distance(it, kv_past_prefix);
+  it = std::prev(kv_past_prefix);
+  return true;
+}
+
 void S3GetMultipartBucketAction::get_next_objects_failed() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
-  if (motr_kv_reader->get_state() == S3MotrKVSReaderOpState::missing) {
+  if (motr_kv_cursor->get_state() == S3MotrKVSReaderOpState::missing) {
     s3_log(S3_LOG_DEBUG, request_id, "No more multipart uploads listing\n");
     fetch_successful = true;  // With no entries.
-  } else if (motr_kv_reader->get_state() ==
+  } else if (motr_kv_cursor->get_state() ==
              S3MotrKVSReaderOpState::failed_to_launch) {
     s3_log(S3_LOG_ERROR, request_id,
            "Multipart metadata next keyval operation failed due to pre launch "
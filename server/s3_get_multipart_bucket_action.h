@@ -23,20 +23,23 @@
 #ifndef __S3_SERVER_S3_GET_MULTIPART_BUCKET_ACTION_H__
 #define __S3_SERVER_S3_GET_MULTIPART_BUCKET_ACTION_H__
 
+#include <map>
 #include <memory>
 
 #include "s3_bucket_action_base.h"
-#include "s3_motr_kvs_reader.h"
+#include "s3_motr_kvs_scan_cursor.h"
 #include "s3_factory.h"
 #include "s3_object_list_response.h"
 
 class S3GetMultipartBucketAction : public S3BucketAction {
-  std::shared_ptr<S3MotrKVSReader> motr_kv_reader;
+  std::shared_ptr<S3MotrKVSScanCursor> motr_kv_cursor;
   std::shared_ptr<MotrAPI> s3_motr_api;
   std::shared_ptr<S3MotrKVSReaderFactory> s3_motr_kvs_reader_factory;
   std::shared_ptr<S3ObjectMetadataFactory> object_metadata_factory;
   S3ObjectListResponse multipart_object_list;
   std::string last_key;  // last key during each iteration
+  // Start of the next key enumeration past a common prefix, if not empty
+  std::string seek_key;
   size_t return_list_size;
 
   bool fetch_successful;
@@ -67,6 +70,12 @@ class S3GetMultipartBucketAction : public S3BucketAction {
   void get_next_objects();
   void get_next_objects_successful();
   void get_next_objects_failed();
+  typedef std::map<std::string, std::pair<int, std::string>>::const_iterator
+      KeyValIterator;
+  // Moves 'it' to the last key of the common prefix in fetched batch,
+  // returns false if the batch ends within the common prefix.
+  bool skip_common_prefix(const std::string& common_prefix, KeyValIterator& it,
+                          size_t& length);
   void get_key_object();
   void get_key_object_successful();
   void get_key_object_failed();
@@ -88,6 +97,8 @@ class S3GetMultipartBucketAction : public S3BucketAction {
               GetNextObjectsSuccessfulDelimiter);
   FRIEND_TEST(S3GetMultipartBucketActionTest,
               GetNextObjectsSuccessfulPrefixDelimiter);
+  FRIEND_TEST(S3GetMultipartBucketActionTest,
+              GetNextObjectsSuccessfulDelimiterSeeksPastPrefix);
   FRIEND_TEST(S3GetMultipartBucketActionTest, GetNextObjectsFailed);
   FRIEND_TEST(S3GetMultipartBucketActionTest, GetNextObjectsFailedNoEntries);
   FRIEND_TEST(S3GetMultipartBucketActionTest,
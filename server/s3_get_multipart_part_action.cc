@@ -250,9 +250,13 @@ void S3GetMultipartPartAction::get_next_objects() {
   if (multipart_object_state == S3ObjectMetadataState::present) {
     size_t count = S3Option::get_instance()->get_motr_idx_fetch_count();
 
-    motr_kv_reader =
-        motr_kvs_reader_factory->create_motr_kvs_reader(request, s3_motr_api);
-    motr_kv_reader->next_keyval(
+    if (motr_kv_cursor == nullptr) {
+      motr_kv_cursor = std::make_shared<S3MotrKVSScanCursor>(
+          request, motr_kvs_reader_factory, s3_motr_api);
+    }
+    motr_kv_cursor->set_key_budget(
+        max_parts > return_list_size ? max_parts - return_list_size : 0);
+    motr_kv_cursor->next_keyval(
         object_multipart_metadata->get_part_index_layout(), last_key, count,
         std::bind(&S3GetMultipartPartAction::get_next_objects_successful, this),
         std::bind(&S3GetMultipartPartAction::get_next_objects_failed, this));
@@ -277,7 +281,7 @@ void S3GetMultipartPartAction::get_next_objects_successful() {
   const auto& part_index_layout =
       object_multipart_metadata->get_part_index_layout();
   bool atleast_one_json_error = false;
-  auto& kvps = motr_kv_reader->get_key_values();
+  auto& kvps = motr_kv_cursor->get_key_values();
   size_t length = kvps.size();
   for (auto& kv : kvps) {
     s3_log(S3_LOG_DEBUG, request_id, "Read Object = %s\n", kv.first.c_str());
@@ -325,10 +329,10 @@ void S3GetMultipartPartAction::get_next_objects_successful() {
 
 void S3GetMultipartPartAction::get_next_objects_failed() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
-  if (motr_kv_reader->get_state() == S3MotrKVSReaderOpState::missing) {
+  if (motr_kv_cursor->get_state() == S3MotrKVSReaderOpState::missing) {
     s3_log(S3_LOG_DEBUG, request_id, "Missing part listing\n");
     fetch_successful = true;  // With no entries.
-  } else if (motr_kv_reader->get_state() ==
+  } else if (motr_kv_cursor->get_state() ==
              S3MotrKVSReaderOpState::failed_to_launch) {
     s3_log(S3_LOG_ERROR, request_id,
            "Part metadata next keyval operation failed due to pre launch "
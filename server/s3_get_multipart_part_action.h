@@ -28,11 +28,15 @@
 
 #include "s3_bucket_action_base.h"
 #include "s3_motr_kvs_reader.h"
+#include "s3_motr_kvs_scan_cursor.h"
 #include "s3_factory.h"
 #include "s3_object_list_response.h"
 
 class S3GetMultipartPartAction : public S3BucketAction {
+  // Reads the part asked for by part-number-marker
   std::shared_ptr<S3MotrKVSReader> motr_kv_reader;
+  // Pages through the part index
+  std::shared_ptr<S3MotrKVSScanCursor> motr_kv_cursor;
   std::shared_ptr<MotrAPI> s3_motr_api;
   std::shared_ptr<S3ObjectMetadata> object_multipart_metadata;
   S3ObjectListResponse multipart_part_list;
@@ -43,6 +43,10 @@ S3GetObjectAction::S3GetObjectAction(
       first_byte_offset_to_read(0),
       last_byte_offset_to_read(0),
       total_blocks_to_read(0),
+      read_window(
+          S3Option::get_instance()->get_motr_units_per_request(),
+          S3Option::get_instance()->get_motr_units_per_request() *
+              S3Option::get_instance()->get_get_read_window_max_multiple()),
       read_object_reply_started(false),
       total_objects(0),
       total_objects_to_read(0),
@@ -617,6 +621,7 @@ void S3GetObjectAction::read_fragmented_object() {
       request, extended_objects[next_fragment_object].object_OID,
       extended_objects[next_fragment_object].object_layout,
       extended_objects[next_fragment_object].object_pvid);
+  motr_reader->use_unit_buffers();
   // get the block,in which first_byte_offset_to_read is present
   // and initilaize the last index with starting offset of the block
   size_t block_start_offset = 0;
@@ -658,6 +663,7 @@ void S3GetObjectAction::read_object() {
     motr_reader = motr_reader_factory->create_motr_reader(
         request, object_metadata->get_oid(), object_metadata->get_layout_id(),
         object_metadata->get_pvid());
+    motr_reader->use_unit_buffers();
     // get the block,in which first_byte_offset_to_read is present
     // and initilaize the last index with starting offset the block
     size_t block_start_offset =
@@ -674,6 +680,15 @@ void S3GetObjectAction::read_object() {
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
+size_t S3GetObjectAction::get_unit_size_of_current_object() const {
+  if (!object_metadata->is_object_extended()) {
+    return S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
+        object_metadata->get_layout_id());
+  }
+  return S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
+      extended_objects[next_fragment_object].object_layout);
+}
+
 void S3GetObjectAction::check_outbuffer_and_mempool_stats(bool& bcontinue) {
   s3_log(S3_LOG_DEBUG, stripped_request_id, "%s Entry\n", __func__);
   bcontinue = true;
@@ -700,10 +715,20 @@ void S3GetObjectAction::check_outbuffer_and_mempool_stats(bool& bcontinue) {
          len_response_buffer);
   s3_log(S3_LOG_INFO, request_id, "Free S3 mempool memory: (%zu)\n",
          len_mempool_free_mem);
+  // When reads land in motr read pool buffers, that pool has to have room
+  // for the next read too
+  bool f_read_pool_full = false;
+  if (S3Option::get_instance()->get_motr_read_unit_buffers()) {
+    const size_t unit_size = get_unit_size_of_current_object();
+    f_read_pool_full = S3Evbuffer::can_use_pool_buffers(unit_size) &&
+                       !S3MemoryProfile().we_have_enough_memory_for_get_read(
+                           unit_size, read_window.get_blocks() * unit_size);
+  }
   if ((len_response_buffer >=
        (motr_read_payload_size *
         S3Option::get_instance()->get_write_buffer_multiple())) ||
-      (!S3MemoryProfile().free_memory_in_pool_above_threshold_limits())) {
+      (!S3MemoryProfile().free_memory_in_pool_above_threshold_limits()) ||
+      f_read_pool_full) {
     bcontinue = false;
     s3_log(
         S3_LOG_WARN, stripped_request_id,
@@ -728,6 +753,7 @@ void S3GetObjectAction::read_object_data() {
   bool bcontinue = true;
   check_outbuffer_and_mempool_stats(bcontinue);
   if (!bcontinue) {
+    read_window.on_throttled();
     int throttle_for_millisecs =
         S3Option::get_instance()->get_s3_req_throttle_time();
     // Throttle S3 Get API by adding delay using timer event
@@ -742,8 +768,7 @@ void S3GetObjectAction::read_object_data() {
              "Failed to throttle S3 GET API response\n");
     }
   }
-  size_t max_blocks_in_one_read_op =
-      S3Option::get_instance()->get_motr_units_per_request();
+  size_t max_blocks_in_one_read_op = read_window.get_blocks();
   size_t motr_unit_size = 0;
   if (!object_metadata->is_object_extended()) {
     motr_unit_size = S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
@@ -892,7 +917,7 @@ void S3GetObjectAction::send_data_to_client() {
          data_sent_to_client);
 
   S3Evbuffer* p_evbuffer = motr_reader->get_evbuffer();
-  size_t buff_count = (p_evbuffer->get_evbuff_length() + 16384 - 1) / 16384;
+  size_t buff_count = p_evbuffer->get_nvecs();
   request->add_to_mempool_buffer_count(buff_count);
   size_t obj_unit_sz = 0;
   if (!object_metadata->is_object_extended()) {
@@ -950,6 +975,14 @@ void S3GetObjectAction::send_data_to_client() {
     p_evbuffer->read_drain_data_from_buffer(length);
   }
   size_t bytes_sent = p_evbuffer->get_evbuff_length();
+  // Adapt size of next reads to how much of the earlier data the client
+  // has not taken yet
+  const size_t next_read_size = read_window.get_blocks() * 2 * obj_unit_sz;
+  read_window.on_read_complete(
+      bytes_sent, request->get_write_buffer_outstanding_length(),
+      read_window.get_blocks() < read_window.get_max_blocks() &&
+          S3MemoryProfile().we_have_enough_memory_for_get_read(
+              obj_unit_sz, next_read_size));
   data_sent_to_client += bytes_sent;
   request->set_bytes_sent(data_sent_to_client);
   data_sent_to_client_for_object += bytes_sent;
@@ -1037,6 +1070,27 @@ void S3GetObjectAction::send_response_to_s3_client() {
   s3_log(S3_LOG_DEBUG, request_id,
          "S3 request [%s] with total allocated mempool buffers = %zu\n",
          request_id.c_str(), request->get_mempool_buffer_count());
+  if (request->get_mempool_buffer_count() > 0) {
+    // Bytes per Motr read buffer handed to the response, not per write
+    // syscall: libevent writes the output with writev() over several buffers
+    // at once, which isn't visible from here.
+    const size_t bytes_per_buffer =
+        data_sent_to_client / request->get_mempool_buffer_count();
+    s3_log(S3_LOG_DEBUG, request_id, "Bytes sent per read buffer = %zu\n",
+           bytes_per_buffer);
+    s3_stats_timing("get_object_bytes_per_read_buffer", bytes_per_buffer);
+  }
+  if (read_window.get_reads_count() > 0) {
+    s3_log(S3_LOG_INFO, stripped_request_id,
+           "Read window stats: reads = %zu, units: last = %zu, max used = %zu, "
+           "grown = %zu, shrunk = %zu, throttled = %zu\n",
+           read_window.get_reads_count(), read_window.get_blocks(),
+           read_window.get_max_blocks_used(), read_window.get_grow_count(),
+           read_window.get_shrink_count(), read_window.get_throttle_count());
+    s3_stats_count("get_read_window_grow_count", read_window.get_grow_count());
+    s3_stats_count("get_read_window_shrink_count",
+                   read_window.get_shrink_count());
+  }
 
   if (reject_if_shutting_down()) {
     if (read_object_reply_started) {
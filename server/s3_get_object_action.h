@@ -29,6 +29,7 @@
 #include "s3_object_action_base.h"
 #include "s3_bucket_metadata.h"
 #include "s3_motr_reader.h"
+#include "s3_read_ahead_window.h"
 #include "s3_factory.h"
 #include "s3_timer.h"
 
@@ -45,6 +46,7 @@ class S3GetObjectAction : public S3ObjectAction {
   size_t last_byte_offset_to_read;
   size_t total_blocks_to_read;
   size_t blocks_to_read;
+  S3ReadAheadWindow read_window;
 
   bool read_object_reply_started;
   std::shared_ptr<S3MotrReaderFactory> motr_reader_factory;
@@ -61,6 +63,7 @@ class S3GetObjectAction : public S3ObjectAction {
   size_t get_requested_content_length() const {
     return last_byte_offset_to_read - first_byte_offset_to_read + 1;
   }
+  size_t get_unit_size_of_current_object() const;
 
  public:
   S3GetObjectAction(
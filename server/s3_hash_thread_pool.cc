@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <atomic>
+#include <cstdlib>
+
+#include "s3_hash_thread_pool.h"
+#include "s3_log.h"
+#include "s3_option.h"
+#include "s3_post_to_main_loop.h"
+
+struct S3HashThreadPool::Queue {
+  struct Task {
+    std::function<void()> work;
+    std::function<void()> on_done;
+    evbase_t* evbase;
+  };
+  // Guarded by S3HashThreadPool::lock
+  std::deque<Task> tasks;
+  bool scheduled = false;  // in ready_queues or run by a worker
+  bool running = false;
+
+  // Set on the event loop of the queue owner, checked there and by the
+  // running task
+  std::atomic<bool> cancelled{false};
+};
+
+// Completion of a task, passed as app_ctx of user_event_context
+struct s3_hash_task_done {
+  std::shared_ptr<S3HashThreadPool::Queue> queue;
+  std::function<void()> on_done;
+};
+
+static void hash_task_done_on_main_thread(evutil_socket_t, short events,
+                                          void* user_data) {
+  struct user_event_context* user_context =
+      (struct user_event_context*)user_data;
+  struct s3_hash_task_done* task_done =
+      (struct s3_hash_task_done*)user_context->app_ctx;
+
+  if (!task_done->queue->cancelled) {
+    task_done->on_done();
+  }
+  if (user_context->user_event) {
+    event_free((struct event*)user_context->user_event);
+  }
+  free(user_context);
+  delete task_done;
+}
+
+S3HashThreadPool* S3HashThreadPool::p_instance;
+
+// Cancellation flag of the queue whose task is run by this worker thread
+static thread_local const std::atomic<bool>* current_task_cancelled;
+
+S3HashThreadPool::S3HashThreadPool(unsigned thread_count) {
+  s3_log(S3_LOG_INFO, "", "%s Hash thread pool: %u threads\n", __func__,
+         thread_count);
+
+  for (unsigned i = 0; i < thread_count; ++i) {
+    workers.emplace_back(&S3HashThreadPool::run_worker, this);
+  }
+  if (!p_instance) {
+    p_instance = this;
+  }
+}
+
+S3HashThreadPool::~S3HashThreadPool() {
+  s3_log(S3_LOG_INFO, "", "%s\n", __func__);
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stopping = true;
+  }
+  task_ready.notify_all();
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  if (p_instance == this) {
+    p_instance = nullptr;
+  }
+}
+
+void S3HashThreadPool::run_worker() {
+  std::unique_lock<std::mutex> guard(lock);
+
+  for (;;) {
+    task_ready.wait(guard,
+                    [this]() { return stopping || !ready_queues.empty(); });
+    if (stopping) {
+      break;
+    }
+    std::shared_ptr<Queue> queue = std::move(ready_queues.front());
+    ready_queues.pop_front();
+
+    if (queue->tasks.empty()) {
+      // Cancelled while waiting
+      queue->scheduled = false;
+      continue;
+    }
+    Queue::Task task = std::move(queue->tasks.front());
+    queue->tasks.pop_front();
+    queue->running = true;
+
+    guard.unlock();
+
+    current_task_cancelled = &queue->cancelled;
+    task.work();
+    current_task_cancelled = nullptr;
+
+    struct user_event_context* user_context =
+        (struct user_event_context*)calloc(1,
+                                           sizeof(struct user_event_context));
+    user_context->app_ctx =
+        new s3_hash_task_done{queue, std::move(task.on_done)};
+    user_context->evbase = task.evbase;
+    S3PostToMainLoop((void*)user_context)(hash_task_done_on_main_thread);
+
+    guard.lock();
+
+    queue->running = false;
+    if (queue->tasks.empty()) {
+      queue->scheduled = false;
+    } else {
+      // Back of the line, so that one busy request doesn't starve others
+      ready_queues.push_back(std::move(queue));
+      task_ready.notify_one();
+    }
+    task_done.notify_all();
+  }
+}
+
+S3HashQueue::S3HashQueue(S3HashThreadPool* pool)
+    : pool(pool), queue(std::make_shared<S3HashThreadPool::Queue>()) {}
+
+S3HashQueue::~S3HashQueue() {
+  std::unique_lock<std::mutex> guard(pool->lock);
+
+  queue->cancelled = true;
+  queue->tasks.clear();
+
+  pool->task_done.wait(guard, [this]() { return !queue->running; });
+}
+
+bool S3HashQueue::is_current_task_cancelled() {
+  return current_task_cancelled && *current_task_cancelled;
+}
+
+void S3HashQueue::submit(std::function<void()> work,
+                         std::function<void()> on_done) {
+  evbase_t* evbase = S3Option::get_instance()->get_eventbase();
+
+  std::lock_guard<std::mutex> guard(pool->lock);
+
+  queue->tasks.push_back(
+      S3HashThreadPool::Queue::Task{std::move(work), std::move(on_done),
+                                    evbase});
+  if (!queue->scheduled) {
+    queue->scheduled = true;
+    pool->ready_queues.push_back(queue);
+    pool->task_ready.notify_one();
+  }
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_HASH_THREAD_POOL_H__
+#define __S3_SERVER_S3_HASH_THREAD_POOL_H__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads calculating digests of request data (MD5 and
+// Motr PI) off the event loops, so one large write doesn't stall every other
+// request of the reactor. Work is submitted with S3HashQueue.
+class S3HashThreadPool {
+ public:
+  // Tasks of one S3HashQueue, shared with workers and pending completions
+  struct Queue;
+
+ private:
+  static S3HashThreadPool* p_instance;
+
+  std::vector<std::thread> workers;
+
+  std::mutex lock;
+  std::condition_variable task_ready;
+  std::condition_variable task_done;
+  // Queues with pending tasks, which are not run by any worker right now
+  std::deque<std::shared_ptr<Queue>> ready_queues;
+  bool stopping = false;
+
+  void run_worker();
+
+  friend class S3HashQueue;
+
+ public:
+  explicit S3HashThreadPool(unsigned thread_count);
+  S3HashThreadPool(const S3HashThreadPool&) = delete;
+  S3HashThreadPool& operator=(const S3HashThreadPool&) = delete;
+
+  // Pending tasks are dropped, running ones are waited for
+  ~S3HashThreadPool();
+
+  // nullptr if digests are calculated on the event loop
+  static S3HashThreadPool* get_instance() { return p_instance; }
+
+  size_t get_thread_count() const { return workers.size(); }
+};
+
+// Serial queue of one request. Incremental digests depend on the order of
+// data, so tasks of a queue are run one at a time in submission order, while
+// tasks of different queues run in parallel.
+class S3HashQueue {
+  S3HashThreadPool* pool;
+  std::shared_ptr<S3HashThreadPool::Queue> queue;
+
+ public:
+  explicit S3HashQueue(S3HashThreadPool* pool);
+  S3HashQueue(const S3HashQueue&) = delete;
+  S3HashQueue& operator=(const S3HashQueue&) = delete;
+
+  // Cancels pending tasks and waits for the running one, which is expected
+  // to stop early (see is_current_task_cancelled). Completion handlers not
+  // called yet are never called.
+  ~S3HashQueue();
+
+  // Called from 'work' of a long task between its steps: true if the queue
+  // running it is being destroyed, so the rest of the work is useless.
+  // Always false on the event loop.
+  static bool is_current_task_cancelled();
+
+  // 'work' is run on a worker thread, then 'on_done' is called on the event
+  // loop of the calling reactor (see S3PostToMainLoop).
+  void submit(std::function<void()> work, std::function<void()> on_done);
+};
+
+#endif  // __S3_SERVER_S3_HASH_THREAD_POOL_H__
@@ -32,13 +32,15 @@ void S3ManagementAPIHandler::create_action() {
       // Perform operation on Service.
       switch (request->http_verb()) {
         case S3HttpVerb::DELETE: {
-          action = std::make_shared<S3AccountDeleteMetadataAction>(request);
+          action = s3_arena_make_shared<S3AccountDeleteMetadataAction>(
+              request->get_arena(), request);
           s3_log(S3_LOG_DEBUG, request_id, "S3AccountDeleteMetadataAction");
         } break;
         case S3HttpVerb::GET: {
           std::string full_uri(request->c_get_full_path());
           if (full_uri.compare("/s3/audit-log/schema") == 0) {
-            action = std::make_shared<S3GetAuditLogSchemaAction>(request);
+            action = s3_arena_make_shared<S3GetAuditLogSchemaAction>(
+                request->get_arena(), request);
             s3_log(S3_LOG_DEBUG, request_id, "S3GetAuditLogSchemaAction");
           }
         } break;
@@ -22,7 +22,7 @@
 
 S3MempoolManager *S3MempoolManager::instance = NULL;
 
-size_t S3MempoolManager::free_space = 0;
+std::atomic<size_t> S3MempoolManager::free_space{0};
 
 extern "C" size_t mem_get_free_space_func() {
   return S3MempoolManager::free_space;
@@ -162,19 +162,23 @@ int S3MempoolManager::release_buffer_for_unit_size(void *buf,
     // We have required memory pool.
     MemoryPoolHandle handle = item->second;
     int retn = mempool_releasebuffer(handle, buf, unit_size);
-    const char *log_memool_stats =
-        "S3 Mempool stats during release:"
-        "mempool_item_size = %zu "
-        "free_bufs_in_pool = %d "
-        "number_of_bufs_shared = %d "
-        "total_bufs_allocated_by_pool = %d\n";
-    char log_mem_stats[1024];
-    struct pool_info poolinfo = {0};
-    mempool_getinfo(handle, &poolinfo);
-    snprintf(log_mem_stats, sizeof(log_mem_stats), log_memool_stats,
-             poolinfo.mempool_item_size, poolinfo.free_bufs_in_pool,
-             poolinfo.expandable_size, poolinfo.total_bufs_allocated_by_pool);
-    s3_log(S3_LOG_DEBUG, "S3_Mempool_Stats", "%s\n", log_mem_stats);
+    // Pool stats are only logged, don't collect them on every release
+    if (s3log_level <= S3_LOG_DEBUG) {
+      const char *log_memool_stats =
+          "S3 Mempool stats during release:"
+          "mempool_item_size = %zu "
+          "free_bufs_in_pool = %d "
+          "number_of_bufs_shared = %d "
+          "total_bufs_allocated_by_pool = %d\n";
+      char log_mem_stats[1024];
+      struct pool_info poolinfo = {0};
+      mempool_getinfo(handle, &poolinfo);
+      snprintf(log_mem_stats, sizeof(log_mem_stats), log_memool_stats,
+               poolinfo.mempool_item_size, poolinfo.free_bufs_in_pool,
+               poolinfo.number_of_bufs_shared,
+               poolinfo.total_bufs_allocated_by_pool);
+      s3_log(S3_LOG_DEBUG, "S3_Mempool_Stats", "%s\n", log_mem_stats);
+    }
     return retn;
   }
   s3_log(S3_LOG_ERROR, "", "%s Exit: Not found unit_size[%zu]\n", __func__,
@@ -223,10 +227,28 @@ bool S3MempoolManager::free_any_unused() {
     }
 
     int rc = mempool_downsize(free_space_map.rbegin()->second, size_to_reduce);
-    if (rc == 0) {
+    // Pools of hugepage slabs free whole slabs only, maybe nothing
+    size_t free_bytes = 0;
+    mempool_reserved_space(free_space_map.rbegin()->second, &free_bytes);
+    if (rc == 0 && free_bytes < free_space_map.rbegin()->first) {
       return true;
     } else {
       return false;
     }
   }
 }
+
+int S3MempoolManager::reserve_for_thread(int buffer_count_per_pool) {
+  int rc = 0;
+  for (auto &mem_pool : pool_of_mem_pool) {
+    int pool_rc = mempool_reserve_for_thread(
+        mem_pool.second, buffer_count_per_pool * mem_pool.first);
+    if (pool_rc != 0) {
+      s3_log(S3_LOG_WARN, "",
+             "Could not reserve %d buffers of unit_size[%zu], rc = %d\n",
+             buffer_count_per_pool, mem_pool.first, pool_rc);
+      rc = pool_rc;
+    }
+  }
+  return rc;
+}
@@ -23,6 +23,7 @@
 #ifndef __S3_SERVER_S3_MEM_POOL_MANAGER_H__
 #define __S3_SERVER_S3_MEM_POOL_MANAGER_H__
 
+#include <atomic>
 #include <map>
 #include <vector>
 
@@ -57,7 +58,9 @@ class S3MempoolManager {
  public:
   // initially equal to total_memory_threshold
   // static so C callback passed to mempool can access this
-  static size_t free_space;
+  // atomic as pools of all unit sizes share it, and with several reactors
+  // they are used from several threads
+  static std::atomic<size_t> free_space;
 
   //  Return the buffer of give unit_size
   // For flags see mempool_getbuffer() in s3_memory_pool.h header
@@ -69,6 +72,14 @@ class S3MempoolManager {
 
   size_t get_free_space_for(size_t unit_size);
 
+  bool has_pool_for_unit_size(size_t unit_size) const {
+    return pool_of_mem_pool.count(unit_size) != 0;
+  }
+
+  // Allocates buffer_count_per_pool more buffers in every pool by the calling
+  // thread, see mempool_reserve_for_thread()
+  int reserve_for_thread(int buffer_count_per_pool);
+
   // Free any mempool that has max free space, free it by half
   // Returns true if space was free'ed in any pool, false if it cannot be
   bool free_any_unused();
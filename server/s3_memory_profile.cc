@@ -21,7 +21,9 @@
 #include <event2/event.h>
 
 #include "s3_motr_layout.h"
+#include "s3_evbuffer_wrapper.h"
 #include "s3_log.h"
+#include "s3_mem_pool_manager.h"
 #include "s3_memory_pool.h"
 #include "s3_memory_profile.h"
 #include "s3_option.h"
@@ -49,6 +51,22 @@ bool S3MemoryProfile::we_have_enough_memory_for_put_obj(int layout_id) {
   return (free_space_in_libevent_mempool > min_mem_for_put_obj);
 }
 
+bool S3MemoryProfile::we_have_enough_memory_for_get_read(size_t unit_size,
+                                                         size_t read_size) {
+#ifdef S3_GOOGLE_TEST
+  return true;
+#endif
+  if (S3Evbuffer::can_use_pool_buffers(unit_size)) {
+    return S3MempoolManager::get_instance()->get_free_space_for(unit_size) >
+           read_size;
+  }
+  size_t free_space_in_libevent_mempool = 0;
+  event_mempool_free_space(&free_space_in_libevent_mempool);
+
+  return free_space_in_libevent_mempool >
+         g_option_instance->get_libevent_pool_reserve_size() + read_size;
+}
+
 bool S3MemoryProfile::free_memory_in_pool_above_threshold_limits() {
 #ifdef S3_GOOGLE_TEST
   return true;
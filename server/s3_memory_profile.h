@@ -33,6 +33,11 @@ class S3MemoryProfile {
   // blocked by less used unit_size, so we cannot get accurate estimate
   virtual bool we_have_enough_memory_for_put_obj(int layout_id);
   virtual bool free_memory_in_pool_above_threshold_limits();
+  // Returns true if 'read_size' more bytes can be read by GET into buffers
+  // of unit_size: from motr read pool of that unit size if GET reads use it,
+  // from libevent mempool (on top of the reserve) otherwise
+  virtual bool we_have_enough_memory_for_get_read(size_t unit_size,
+                                                  size_t read_size);
 };
 
 #endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "s3_metadata_codec.h"
+
+static const char s3_metadata_magic[] = {'\0', 'S', '3', 'B'};
+static const size_t s3_metadata_header_size = sizeof(s3_metadata_magic) + 2;
+
+static bool read_varint(const char*& pos, const char* end, uint64_t& value) {
+  value = 0;
+  for (unsigned shift = 0; shift < 64 && pos < end; shift += 7) {
+    const uint8_t byte = static_cast<uint8_t>(*pos++);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool read_string(const char*& pos, const char* end, std::string& dst) {
+  uint64_t size;
+  if (!read_varint(pos, end, size) ||
+      size > static_cast<uint64_t>(end - pos)) {
+    return false;
+  }
+  dst.assign(pos, size);
+  pos += size;
+  return true;
+}
+
+bool S3MetadataField::to_uint(uint64_t& value) const {
+  const char* pos = data;
+  return read_varint(pos, data + size, value) && pos == data + size;
+}
+
+bool S3MetadataField::to_int(int64_t& value) const {
+  uint64_t zigzag;
+  if (!to_uint(zigzag)) {
+    return false;
+  }
+  value = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+  return true;
+}
+
+bool S3MetadataField::to_map(std::map<std::string, std::string>& dst) const {
+  const char* pos = data;
+  const char* const end = data + size;
+  std::string key;
+
+  while (pos < end) {
+    if (!read_string(pos, end, key) || !read_string(pos, end, dst[key])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+S3MetadataEncoder::S3MetadataEncoder(S3MetadataRecordType type,
+                                     size_t size_hint) {
+  buffer.reserve(size_hint);
+  buffer.append(s3_metadata_magic, sizeof(s3_metadata_magic));
+  buffer.push_back(static_cast<char>(S3MetadataDecoder::format_version));
+  buffer.push_back(static_cast<char>(type));
+}
+
+void S3MetadataEncoder::append_varint(uint64_t value) {
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<char>(value));
+}
+
+void S3MetadataEncoder::append_header(unsigned tag, size_t size) {
+  append_varint(tag);
+  append_varint(size);
+}
+
+void S3MetadataEncoder::add(unsigned tag, const char* data, size_t size) {
+  append_header(tag, size);
+  buffer.append(data, size);
+}
+
+void S3MetadataEncoder::add_uint(unsigned tag, uint64_t value) {
+  char tmp[10];
+  size_t size = 0;
+
+  while (value >= 0x80) {
+    tmp[size++] = static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  tmp[size++] = static_cast<char>(value);
+  add(tag, tmp, size);
+}
+
+void S3MetadataEncoder::add_int(unsigned tag, int64_t value) {
+  add_uint(tag, (static_cast<uint64_t>(value) << 1) ^
+                    static_cast<uint64_t>(value >> 63));
+}
+
+void S3MetadataEncoder::add_map(
+    unsigned tag, const std::map<std::string, std::string>& map) {
+  // Size of the value must be known before the value is written
+  size_t size = 0;
+  for (const auto& kv : map) {
+    for (const std::string* p_str : {&kv.first, &kv.second}) {
+      size_t len = p_str->size();
+      do {
+        ++size;
+        len >>= 7;
+      } while (len);
+      size += p_str->size();
+    }
+  }
+  append_header(tag, size);
+
+  for (const auto& kv : map) {
+    append_varint(kv.first.size());
+    buffer.append(kv.first);
+    append_varint(kv.second.size());
+    buffer.append(kv.second);
+  }
+}
+
+bool S3MetadataDecoder::is_binary(const std::string& buffer) {
+  return buffer.size() >= s3_metadata_header_size &&
+         !memcmp(buffer.data(), s3_metadata_magic, sizeof(s3_metadata_magic));
+}
+
+S3MetadataDecoder::S3MetadataDecoder(const std::string& buffer,
+                                     S3MetadataRecordType type)
+    : pos(buffer.data()), end(buffer.data() + buffer.size()) {
+  if (is_binary(buffer) &&
+      static_cast<uint8_t>(buffer[sizeof(s3_metadata_magic)]) ==
+          format_version &&
+      static_cast<uint8_t>(buffer[sizeof(s3_metadata_magic) + 1]) ==
+          static_cast<uint8_t>(type)) {
+    pos += s3_metadata_header_size;
+    valid = true;
+  }
+}
+
+bool S3MetadataDecoder::next(unsigned& tag, S3MetadataField& field) {
+  if (!valid || pos == end) {
+    return false;
+  }
+  uint64_t tag64, size;
+  if (!read_varint(pos, end, tag64) || !read_varint(pos, end, size) ||
+      size > static_cast<uint64_t>(end - pos)) {
+    valid = false;
+    return false;
+  }
+  tag = static_cast<unsigned>(tag64);
+  field.data = pos;
+  field.size = size;
+  pos += size;
+  return true;
+}
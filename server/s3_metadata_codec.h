@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_METADATA_CODEC_H__
+#define __S3_SERVER_S3_METADATA_CODEC_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+
+// Compact binary encoding of metadata records stored in Motr KVS,
+// an alternative to JSON.
+//
+// Layout of a record:
+//   magic "\0S3B" (JSON values always start with '{'), format version byte,
+//   record type byte, then a sequence of fields.
+// Every field is: varint tag, varint length, <length> bytes of value.
+// Unsigned integers are stored as varints inside the value, signed ones are
+// zigzag encoded first. A string map is a value made of
+// (varint length, key, varint length, value) pairs.
+// Decoders skip fields with unknown tags, so new fields can be added
+// without bumping the format version.
+
+enum class S3MetadataRecordType : uint8_t {
+  object = 1,
+  part = 2,
+  bucket = 3
+};
+
+// View of a field value, points into the buffer being decoded
+struct S3MetadataField {
+  const char* data = nullptr;
+  size_t size = 0;
+
+  std::string to_string() const { return std::string(data, size); }
+
+  // Fixed size binary field, e.g. OID or index layout
+  template <typename T>
+  bool copy_to(T& dst) const {
+    if (size != sizeof(T)) {
+      return false;
+    }
+    memcpy(&dst, data, sizeof(T));
+    return true;
+  }
+
+  bool to_uint(uint64_t& value) const;
+  bool to_int(int64_t& value) const;
+  // Entries are added to (not replace) the existing map content
+  bool to_map(std::map<std::string, std::string>& dst) const;
+};
+
+class S3MetadataEncoder {
+  std::string buffer;
+
+  void append_varint(uint64_t value);
+  void append_header(unsigned tag, size_t size);
+
+ public:
+  explicit S3MetadataEncoder(S3MetadataRecordType type,
+                             size_t size_hint = 256);
+
+  void add(unsigned tag, const char* data, size_t size);
+  void add(unsigned tag, const std::string& value) {
+    add(tag, value.data(), value.size());
+  }
+  template <typename T>
+  void add_raw(unsigned tag, const T& value) {
+    add(tag, reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  void add_uint(unsigned tag, uint64_t value);
+  void add_int(unsigned tag, int64_t value);
+  void add_map(unsigned tag, const std::map<std::string, std::string>& map);
+
+  std::string& get_buffer() { return buffer; }
+};
+
+class S3MetadataDecoder {
+  const char* pos;
+  const char* const end;
+  bool valid = false;
+
+ public:
+  static const uint8_t format_version = 1;
+
+  // The buffer must outlive the decoder and all the field views
+  S3MetadataDecoder(const std::string& buffer, S3MetadataRecordType type);
+
+  // True if the value is in binary format; JSON is assumed otherwise
+  static bool is_binary(const std::string& buffer);
+
+  // Returns false when there are no more fields or the record is malformed;
+  // is_valid() tells between the two.
+  bool next(unsigned& tag, S3MetadataField& field);
+  bool is_valid() const { return valid; }
+};
+
+#endif  // __S3_SERVER_S3_METADATA_CODEC_H__
@@ -30,6 +30,8 @@ extern std::set<struct s3_motr_op_context *> global_motr_object_ops_list;
 extern std::set<struct s3_motr_idx_op_context *> global_motr_idx_ops_list;
 extern std::set<struct s3_motr_idx_context *> global_motr_idx;
 extern std::set<struct s3_motr_obj_context *> global_motr_obj;
+
+std::mutex global_motr_ctx_lock;
 extern int shutdown_motr_teardown_called;
 
 // Helper methods to free m0_bufvec array which holds
@@ -114,7 +116,10 @@ struct s3_motr_obj_context *create_obj_context(size_t count) {
 
   ctx->objs = (struct m0_obj *)calloc(count, sizeof(struct m0_obj));
   ctx->obj_count = count;
-  global_motr_obj.insert(ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_obj.insert(ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return ctx;
 }
@@ -148,7 +153,10 @@ struct s3_motr_op_context *create_basic_op_ctx(size_t op_count) {
 int free_basic_op_ctx(struct s3_motr_op_context *ctx) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
   if (!shutdown_motr_teardown_called) {
-    global_motr_object_ops_list.erase(ctx);
+    {
+      std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+      global_motr_object_ops_list.erase(ctx);
+    }
     for (size_t i = 0; i < ctx->op_count; i++) {
       if (ctx->ops[i] != NULL) {
         teardown_motr_op(ctx->ops[i]);
@@ -307,7 +315,10 @@ struct s3_motr_idx_context *create_idx_context(size_t idx_count) {
       1, sizeof(struct s3_motr_idx_context));
   ctx->idx = (struct m0_idx *)calloc(idx_count, sizeof(struct m0_idx));
   ctx->idx_count = idx_count;
-  global_motr_idx.insert(ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_idx.insert(ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return ctx;
 }
@@ -338,7 +349,10 @@ struct s3_motr_idx_op_context *create_basic_idx_op_ctx(int op_count) {
 int free_basic_idx_op_ctx(struct s3_motr_idx_op_context *ctx) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
   if (!shutdown_motr_teardown_called) {
-    global_motr_idx_ops_list.erase(ctx);
+    {
+      std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+      global_motr_idx_ops_list.erase(ctx);
+    }
 
     for (size_t i = 0; i < ctx->op_count; i++) {
       if (ctx->ops[i] == NULL) {
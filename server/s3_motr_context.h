@@ -25,6 +25,7 @@
 
 #include "s3_common.h"
 #include "s3_log.h"
+#include <mutex>
 #include <set>
 #include <openssl/md5.h>
 
@@ -40,6 +41,9 @@ EXTERN_C_BLOCK_END
 
 #include "s3_memory_pool.h"
 
+// Guards the global_motr_* bookkeeping sets, which are shared by all reactors
+extern std::mutex global_motr_ctx_lock;
+
 struct s3_motr_obj_context {
   struct m0_obj *objs;
   size_t n_initialized_contexts;
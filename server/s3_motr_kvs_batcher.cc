@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <cassert>
+#include <cerrno>
+
+#include "s3_log.h"
+#include "s3_motr_kvs_batcher.h"
+#include "s3_motr_kvs_writer.h"
+
+thread_local S3MotrKVSBatcher *S3MotrKVSBatcher::p_instance;
+
+S3MotrKVSBatcher::S3MotrKVSBatcher(evbase_t *evbase, unsigned window_us,
+                                   unsigned max_keys)
+    : evbase(evbase), window_us(window_us), max_keys(max_keys ? max_keys : 1) {
+  s3_log(S3_LOG_INFO, "",
+         "%s KVS batching: window %u us, up to %u keys per op\n", __func__,
+         window_us, this->max_keys);
+  window_timer = event_new(evbase, -1, 0, window_expired, this);
+  retire_event = event_new(evbase, -1, 0, free_retired, this);
+  p_instance = this;
+}
+
+S3MotrKVSBatcher::~S3MotrKVSBatcher() {
+  s3_log(S3_LOG_DEBUG, "", "%s\n", __func__);
+  if (p_instance == this) {
+    p_instance = nullptr;
+  }
+  event_free(window_timer);
+  event_free(retire_event);
+  // Pending callers are not resumed, the loop has stopped
+}
+
+S3MotrKVSWriter *S3MotrKVSBatcher::create_writer(
+    std::shared_ptr<RequestObject> req, std::shared_ptr<MotrAPI> motr_api) {
+  S3MotrKVSWriter *writer = new S3MotrKVSWriter(std::move(req), motr_api);
+  writer->disable_batching();
+  return writer;
+}
+
+void S3MotrKVSBatcher::put_keyval(
+    std::shared_ptr<RequestObject> req, std::shared_ptr<MotrAPI> motr_api,
+    const struct s3_motr_idx_layout &idx_lo,
+    const std::map<std::string, std::string> &kv_list, DoneCallback on_done) {
+  std::vector<std::string> keys;
+  keys.reserve(kv_list.size());
+  for (const auto &kv : kv_list) {
+    keys.push_back(kv.first);
+  }
+  add(std::move(req), std::move(motr_api), idx_lo, false, kv_list,
+      std::move(keys), std::move(on_done));
+}
+
+void S3MotrKVSBatcher::delete_keyval(std::shared_ptr<RequestObject> req,
+                                     std::shared_ptr<MotrAPI> motr_api,
+                                     const struct s3_motr_idx_layout &idx_lo,
+                                     const std::vector<std::string> &keys,
+                                     DoneCallback on_done) {
+  std::map<std::string, std::string> kv_list;
+  for (const auto &key : keys) {
+    kv_list.emplace(key, std::string());
+  }
+  add(std::move(req), std::move(motr_api), idx_lo, true, kv_list, keys,
+      std::move(on_done));
+}
+
+void S3MotrKVSBatcher::add(std::shared_ptr<RequestObject> req,
+                           std::shared_ptr<MotrAPI> motr_api,
+                           const struct s3_motr_idx_layout &idx_lo,
+                           bool is_delete,
+                           const std::map<std::string, std::string> &kv_list,
+                           std::vector<std::string> keys,
+                           DoneCallback on_done) {
+  const std::string &request_id = req->get_request_id();
+  s3_log(S3_LOG_DEBUG, request_id,
+         "%s Entry with oid = %" SCNx64 " : %" SCNx64 " %s of %zu keys\n",
+         __func__, idx_lo.oid.u_hi, idx_lo.oid.u_lo,
+         is_delete ? "delete" : "put", keys.size());
+
+  // Ops of the other type on the index keep their order with this one
+  BatchKey other_key(idx_lo.oid.u_hi, idx_lo.oid.u_lo, !is_delete,
+                     motr_api.get());
+  if (pending.count(other_key)) {
+    launch(other_key);
+  }
+  BatchKey key(idx_lo.oid.u_hi, idx_lo.oid.u_lo, is_delete, motr_api.get());
+  auto it = pending.find(key);
+  if (it != pending.end()) {
+    // The same key twice in one op would have no defined outcome
+    bool has_same_key = false;
+    for (const auto &kv : kv_list) {
+      if (it->second->kv_list.count(kv.first)) {
+        has_same_key = true;
+        break;
+      }
+    }
+    if (has_same_key ||
+        it->second->kv_list.size() + kv_list.size() > max_keys) {
+      launch(key);
+      it = pending.end();
+    }
+  }
+  if (it == pending.end()) {
+    std::unique_ptr<Batch> batch(new Batch());
+    batch->request = std::move(req);
+    batch->motr_api = std::move(motr_api);
+    batch->idx_lo = idx_lo;
+    batch->is_delete = is_delete;
+    it = pending.emplace(key, std::move(batch)).first;
+  }
+  Batch &batch = *it->second;
+  batch.kv_list.insert(kv_list.begin(), kv_list.end());
+  batch.callers.push_back({std::move(keys), std::move(on_done)});
+
+  if (batch.kv_list.size() >= max_keys || window_us == 0) {
+    launch(key);
+  } else if (!evtimer_pending(window_timer, NULL)) {
+    struct timeval window = {(time_t)(window_us / 1000000),
+                             (suseconds_t)(window_us % 1000000)};
+    evtimer_add(window_timer, &window);
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3MotrKVSBatcher::launch(BatchKey key) {
+  auto it = pending.find(key);
+  assert(it != pending.end());
+  std::unique_ptr<Batch> owned = std::move(it->second);
+  pending.erase(it);
+  Batch *batch = owned.get();
+  in_flight.push_back(std::move(owned));
+
+  s3_log(S3_LOG_INFO, batch->request->get_stripped_request_id(),
+         "%s %s of %zu keys for %zu requests\n", __func__,
+         batch->is_delete ? "delete" : "put", batch->kv_list.size(),
+         batch->callers.size());
+
+  batch->writer.reset(create_writer(batch->request, batch->motr_api));
+  auto on_success = std::bind(&S3MotrKVSBatcher::batch_done, this, batch, true);
+  auto on_failed = std::bind(&S3MotrKVSBatcher::batch_done, this, batch, false);
+  if (batch->is_delete) {
+    std::vector<std::string> keys;
+    keys.reserve(batch->kv_list.size());
+    for (const auto &kv : batch->kv_list) {
+      keys.push_back(kv.first);
+    }
+    batch->writer->delete_keyval(batch->idx_lo, keys, on_success, on_failed);
+  } else {
+    batch->writer->put_keyval(batch->idx_lo, batch->kv_list, on_success,
+                              on_failed);
+  }
+}
+
+void S3MotrKVSBatcher::batch_done(Batch *batch, bool success) {
+  auto it = in_flight.begin();
+  while (it != in_flight.end() && it->get() != batch) {
+    ++it;
+  }
+  assert(it != in_flight.end());
+
+  // Keys of the op are in the order of kv_list
+  std::map<std::string, size_t> key_index;
+  size_t index = 0;
+  for (const auto &kv : batch->kv_list) {
+    key_index.emplace(kv.first, index++);
+  }
+  const int op_rc = batch->writer->get_op_ret_code_for(0);
+  s3_log(S3_LOG_DEBUG, batch->request->get_request_id(),
+         "%s %s, rc = %d, %zu callers\n", __func__,
+         success ? "succeeded" : "failed", op_rc, batch->callers.size());
+
+  std::vector<std::vector<int>> key_rcs(batch->callers.size());
+  for (size_t i = 0; i < batch->callers.size(); ++i) {
+    for (const auto &key : batch->callers[i].keys) {
+      key_rcs[i].push_back(
+          batch->writer->get_op_ret_code_for_del_kv(key_index[key]));
+    }
+  }
+  std::vector<Caller> callers = std::move(batch->callers);
+
+  // This runs in a callback of the batch's writer, so it is freed later
+  retired.push_back(std::move(*it));
+  in_flight.erase(it);
+  event_active(retire_event, EV_TIMEOUT, 0);
+
+  for (size_t i = 0; i < callers.size(); ++i) {
+    bool caller_success = success;
+    int caller_rc = op_rc;
+    if (!success && op_rc == -ENOENT) {
+      // Missing key fails the whole op (fake KVS), it is only the caller's
+      // failure if the key is one of the caller's
+      caller_rc = 0;
+      for (int rc : key_rcs[i]) {
+        if (rc != 0) {
+          caller_rc = rc;
+          break;
+        }
+      }
+      caller_success = caller_rc == 0;
+    }
+    callers[i].on_done(caller_success, caller_rc, key_rcs[i]);
+  }
+}
+
+void S3MotrKVSBatcher::free_retired(evutil_socket_t, short, void *arg) {
+  ((S3MotrKVSBatcher *)arg)->retired.clear();
+}
+
+void S3MotrKVSBatcher::flush() {
+  while (!pending.empty()) {
+    launch(pending.begin()->first);
+  }
+}
+
+void S3MotrKVSBatcher::window_expired(evutil_socket_t, short, void *arg) {
+  ((S3MotrKVSBatcher *)arg)->flush();
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_MOTR_KVS_BATCHER_H__
+#define __S3_SERVER_S3_MOTR_KVS_BATCHER_H__
+
+#include <gtest/gtest_prod.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <evhtp.h>
+
+#include "s3_motr_context.h"
+#include "s3_motr_wrapper.h"
+#include "s3_request_object.h"
+
+class S3MotrKVSWriter;
+
+// Merges KV puts and deletes of concurrent requests to the same index into
+// one Motr index op, launched when the batch window expires or the batch has
+// enough keys. Return codes are handed back to every caller for its own
+// keys. Each reactor has its own batcher, as completions run on its loop.
+class S3MotrKVSBatcher {
+ public:
+  // success - the op succeeded; op_rc - return code of the op;
+  // key_rcs - return codes of the caller's keys, in the caller's order
+  typedef std::function<void(bool success, int op_rc,
+                             const std::vector<int>& key_rcs)> DoneCallback;
+
+ private:
+  static thread_local S3MotrKVSBatcher* p_instance;
+
+  struct Caller {
+    std::vector<std::string> keys;
+    DoneCallback on_done;
+  };
+
+  // Keys of one index and op type, waiting to be launched or in flight
+  struct Batch {
+    std::shared_ptr<RequestObject> request;
+    std::shared_ptr<MotrAPI> motr_api;
+    struct s3_motr_idx_layout idx_lo;
+    bool is_delete;
+    std::map<std::string, std::string> kv_list;
+    std::vector<Caller> callers;
+    std::unique_ptr<S3MotrKVSWriter> writer;
+  };
+
+  typedef std::tuple<uint64_t, uint64_t, bool, const MotrAPI*> BatchKey;
+
+  evbase_t* evbase;
+  struct event* window_timer;
+  struct event* retire_event;
+  unsigned window_us;
+  unsigned max_keys;
+
+  std::map<BatchKey, std::unique_ptr<Batch>> pending;
+  std::vector<std::unique_ptr<Batch>> in_flight;
+  // Done batches, freed once their writer's callback has returned
+  std::vector<std::unique_ptr<Batch>> retired;
+
+  void add(std::shared_ptr<RequestObject> req,
+           std::shared_ptr<MotrAPI> motr_api,
+           const struct s3_motr_idx_layout& idx_lo, bool is_delete,
+           const std::map<std::string, std::string>& kv_list,
+           std::vector<std::string> keys, DoneCallback on_done);
+  void launch(BatchKey key);
+  void batch_done(Batch* batch, bool success);
+
+  static void window_expired(evutil_socket_t, short, void* arg);
+  static void free_retired(evutil_socket_t, short, void* arg);
+
+ protected:
+  // Motr index op of a batch, overridden in tests
+  virtual S3MotrKVSWriter* create_writer(std::shared_ptr<RequestObject> req,
+                                         std::shared_ptr<MotrAPI> motr_api);
+
+ public:
+  S3MotrKVSBatcher(evbase_t* evbase, unsigned window_us, unsigned max_keys);
+  virtual ~S3MotrKVSBatcher();
+
+  S3MotrKVSBatcher(const S3MotrKVSBatcher&) = delete;
+  S3MotrKVSBatcher& operator=(const S3MotrKVSBatcher&) = delete;
+
+  // Batcher of the current reactor, nullptr if batching is disabled
+  static S3MotrKVSBatcher* get_instance() { return p_instance; }
+
+  void put_keyval(std::shared_ptr<RequestObject> req,
+                  std::shared_ptr<MotrAPI> motr_api,
+                  const struct s3_motr_idx_layout& idx_lo,
+                  const std::map<std::string, std::string>& kv_list,
+                  DoneCallback on_done);
+
+  void delete_keyval(std::shared_ptr<RequestObject> req,
+                     std::shared_ptr<MotrAPI> motr_api,
+                     const struct s3_motr_idx_layout& idx_lo,
+                     const std::vector<std::string>& keys,
+                     DoneCallback on_done);
+
+  // Launches all pending batches now
+  void flush();
+
+  size_t get_pending_batch_count() const { return pending.size(); }
+  size_t get_in_flight_batch_count() const { return in_flight.size(); }
+};
+
+#endif  // __S3_SERVER_S3_MOTR_KVS_BATCHER_H__
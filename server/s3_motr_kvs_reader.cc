@@ -51,7 +51,10 @@ S3MotrKVSReader::~S3MotrKVSReader() { clean_up_contexts(); }
 void S3MotrKVSReader::clean_up_contexts() {
   reader_context = nullptr;
   if (!shutdown_motr_teardown_called) {
-    global_motr_idx.erase(idx_ctx);
+    {
+      std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+      global_motr_idx.erase(idx_ctx);
+    }
     if (idx_ctx) {
       for (size_t i = 0; i < idx_ctx->n_initialized_contexts; i++) {
         s3_motr_api->motr_idx_fini(&idx_ctx->idx[i]);
@@ -149,11 +152,14 @@ void S3MotrKVSReader::get_keyval(const struct s3_motr_idx_layout &idx_lo,
   idx_op_ctx->ops[0]->op_datum = (void *)op_ctx;
   s3_motr_api->motr_op_setup(idx_op_ctx->ops[0], idx_op_ctx->cbs, 0);
 
-  reader_context->start_timer_for("get_keyval");
+  reader_context->start_timer_for("get_keyval", s3_motr_idx_phase(idx_lo));
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops, 1,
                               MotrOpType::getkv);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_idx_ops_list.insert(idx_op_ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return;
 }
@@ -214,7 +220,7 @@ void S3MotrKVSReader::lookup_index(const struct s3_motr_idx_layout &idx_lo,
   idx_op_ctx->ops[0]->op_datum = (void *)op_ctx;
   s3_motr_api->motr_op_setup(idx_op_ctx->ops[0], idx_op_ctx->cbs, 0);
 
-  reader_context->start_timer_for("lookup_index");
+  reader_context->start_timer_for("lookup_index", s3_motr_idx_phase(idx_lo));
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops, 1,
                               MotrOpType::headidx);
@@ -390,11 +396,14 @@ void S3MotrKVSReader::next_keyval(const struct s3_motr_idx_layout &idx_lo,
   idx_op_ctx->ops[0]->op_datum = (void *)op_ctx;
   s3_motr_api->motr_op_setup(idx_op_ctx->ops[0], idx_op_ctx->cbs, 0);
 
-  reader_context->start_timer_for("get_keyval");
+  reader_context->start_timer_for("get_keyval", s3_motr_idx_phase(idx_lo));
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops, 1,
                               MotrOpType::getkv);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_idx_ops_list.insert(idx_op_ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return;
 }
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "s3_motr_kvs_scan_cursor.h"
+#include "s3_factory.h"
+#include "s3_log.h"
+#include "s3_option.h"
+#include "s3_post_to_main_loop.h"
+
+S3MotrKVSScanCursor::S3MotrKVSScanCursor(
+    std::shared_ptr<RequestObject> req,
+    std::shared_ptr<S3MotrKVSReaderFactory> kvs_reader_factory,
+    std::shared_ptr<MotrAPI> motr_api)
+    : request(std::move(req)),
+      reader_factory(std::move(kvs_reader_factory)),
+      s3_motr_api(std::move(motr_api)) {
+  request_id = request->get_request_id();
+  stripped_request_id = request->get_stripped_request_id();
+  s3_log(S3_LOG_DEBUG, request_id, "%s Ctor\n", __func__);
+
+  max_prefetch_keys =
+      S3Option::get_instance()->get_motr_kvs_prefetch_max_keys();
+  current_reader =
+      reader_factory->create_motr_kvs_reader(request, s3_motr_api);
+}
+
+S3MotrKVSScanCursor::~S3MotrKVSScanCursor() {
+  s3_log(S3_LOG_DEBUG, request_id, "%s\n", __func__);
+  cancel();
+  orphan_reader(current_guard, current_reader);
+}
+
+void S3MotrKVSScanCursor::orphan_reader(
+    std::shared_ptr<FetchGuard>& guard,
+    std::shared_ptr<S3MotrKVSReader>& reader) {
+  if (guard) {
+    guard->cursor = nullptr;
+    guard->orphan = std::move(reader);
+    guard.reset();
+  }
+  reader.reset();
+}
+
+void S3MotrKVSScanCursor::on_fetch_done(std::shared_ptr<FetchGuard> guard,
+                                        bool prefetch, bool successful) {
+  if (guard->cursor == nullptr) {
+    // Nobody waits for the page. The reader goes away from within its own
+    // callback, it is not touched after the callback returns.
+    guard->orphan.reset();
+    return;
+  }
+  if (prefetch) {
+    guard->cursor->prefetch_done(successful);
+  } else {
+    guard->cursor->fetch_done(successful);
+  }
+}
+
+void S3MotrKVSScanCursor::prefetched_page_on_main_thread(evutil_socket_t,
+                                                         short events,
+                                                         void* user_data) {
+  struct user_event_context* user_context =
+      (struct user_event_context*)user_data;
+  auto guard_ref = (std::shared_ptr<FetchGuard>*)user_context->app_ctx;
+  std::shared_ptr<FetchGuard> guard = std::move(*guard_ref);
+  delete guard_ref;
+  if (user_context->user_event) {
+    event_free((struct event*)user_context->user_event);
+  }
+  free(user_context);
+
+  if (guard->cursor == nullptr) {
+    guard->orphan.reset();
+  } else {
+    guard->cursor->use_prefetched_page();
+  }
+}
+
+bool S3MotrKVSScanCursor::is_prefetched(
+    const struct s3_motr_idx_layout& idx_lo, const std::string& key,
+    size_t nr_kvp, unsigned int flag) const {
+  return ahead_state != PrefetchState::idle &&
+         flag == M0_OIF_EXCLUDE_START_KEY && nr_kvp == ahead_nr_kvp &&
+         key == ahead_key &&
+         m0_uint128_cmp(&idx_lo.oid, &ahead_idx_lo.oid) == 0;
+}
+
+void S3MotrKVSScanCursor::next_keyval(const struct s3_motr_idx_layout& idx_lo,
+                                      const std::string& key, size_t nr_kvp,
+                                      std::function<void(void)> on_success,
+                                      std::function<void(void)> on_failed,
+                                      unsigned int flag) {
+  s3_log(S3_LOG_INFO, stripped_request_id,
+         "%s Entry with key = %s and count = %zu\n", __func__, key.c_str(),
+         nr_kvp);
+
+  handler_on_success = std::move(on_success);
+  handler_on_failed = std::move(on_failed);
+
+  page_idx_lo = idx_lo;
+  page_key = key;
+  page_nr_kvp = nr_kvp;
+  page_flag = flag;
+
+  if (!is_prefetched(idx_lo, key, nr_kvp, flag)) {
+    cancel();
+    fetch_page();
+  } else if (ahead_state == PrefetchState::in_flight) {
+    s3_log(S3_LOG_DEBUG, request_id, "Waiting for page fetched ahead\n");
+    waiting_for_ahead = true;
+  } else {
+    s3_log(S3_LOG_DEBUG, request_id, "Page was fetched ahead\n");
+    ahead_guard = std::make_shared<FetchGuard>(this);
+    struct user_event_context* user_ctx = (struct user_event_context*)calloc(
+        1, sizeof(struct user_event_context));
+    user_ctx->app_ctx = new std::shared_ptr<FetchGuard>(ahead_guard);
+    user_ctx->evbase = S3Option::get_instance()->get_eventbase();
+#ifdef S3_GOOGLE_TEST
+    evutil_socket_t test_sock = 0;
+    short events = 0;
+    prefetched_page_on_main_thread(test_sock, events, (void*)user_ctx);
+#else
+    S3PostToMainLoop((void*)user_ctx)(prefetched_page_on_main_thread,
+                                      request_id);
+#endif  // S3_GOOGLE_TEST
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3MotrKVSScanCursor::fetch_page() {
+  current_guard = std::make_shared<FetchGuard>(this);
+  current_reader->next_keyval(
+      page_idx_lo, page_key, page_nr_kvp,
+      std::bind(&S3MotrKVSScanCursor::on_fetch_done, current_guard, false,
+                true),
+      std::bind(&S3MotrKVSScanCursor::on_fetch_done, current_guard, false,
+                false),
+      page_flag);
+}
+
+void S3MotrKVSScanCursor::fetch_done(bool successful) {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+  current_guard.reset();
+  if (successful) {
+    prefetch_next_page();
+  }
+  // Caller may let go of the cursor from within its handler
+  auto handler = std::move(successful ? handler_on_success : handler_on_failed);
+  handler();
+}
+
+void S3MotrKVSScanCursor::prefetch_next_page() {
+  const auto& kvps = current_reader->get_key_values();
+  if (max_prefetch_keys == 0 || page_nr_kvp > max_prefetch_keys ||
+      kvps.empty() || kvps.size() < page_nr_kvp) {
+    // A short page means there is nothing left to fetch
+    return;
+  }
+  if (kvps.size() >= key_budget) {
+    // The caller may stop with this page
+    s3_log(S3_LOG_DEBUG, request_id,
+           "Key budget %zu is used up by the page, not fetching ahead\n",
+           key_budget);
+    return;
+  }
+  if (!ahead_reader) {
+    ahead_reader = reader_factory->create_motr_kvs_reader(request, s3_motr_api);
+  }
+  ahead_idx_lo = page_idx_lo;
+  ahead_key = kvps.rbegin()->first;
+  ahead_nr_kvp = page_nr_kvp;
+  ahead_state = PrefetchState::in_flight;
+  ahead_guard = std::make_shared<FetchGuard>(this);
+  s3_log(S3_LOG_DEBUG, request_id, "Fetching ahead page after key = %s\n",
+         ahead_key.c_str());
+
+  ahead_reader->next_keyval(
+      ahead_idx_lo, ahead_key, ahead_nr_kvp,
+      std::bind(&S3MotrKVSScanCursor::on_fetch_done, ahead_guard, true, true),
+      std::bind(&S3MotrKVSScanCursor::on_fetch_done, ahead_guard, true, false),
+      M0_OIF_EXCLUDE_START_KEY);
+}
+
+void S3MotrKVSScanCursor::prefetch_done(bool successful) {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+  ahead_guard.reset();
+  ahead_successful = successful;
+  S3MotrKVSReaderOpState state = ahead_reader->get_state();
+  if (successful || state == S3MotrKVSReaderOpState::missing ||
+      state == S3MotrKVSReaderOpState::failed_e2big) {
+    // Fetching the page again would end the same way
+    ahead_state = PrefetchState::ready;
+  } else {
+    s3_log(S3_LOG_WARN, request_id,
+           "Fetching ahead page after key = %s failed\n", ahead_key.c_str());
+    ahead_state = PrefetchState::idle;
+  }
+
+  if (waiting_for_ahead) {
+    waiting_for_ahead = false;
+    if (ahead_state == PrefetchState::ready) {
+      use_prefetched_page();
+    } else {
+      fetch_page();
+    }
+  }
+}
+
+void S3MotrKVSScanCursor::use_prefetched_page() {
+  ahead_guard.reset();
+  ahead_state = PrefetchState::idle;
+  std::swap(current_reader, ahead_reader);
+  fetch_done(ahead_successful);
+}
+
+S3MotrKVSReaderOpState S3MotrKVSScanCursor::get_state() const {
+  return current_reader->get_state();
+}
+
+const std::map<std::string, std::pair<int, std::string>>&
+S3MotrKVSScanCursor::get_key_values() const {
+  return current_reader->get_key_values();
+}
+
+void S3MotrKVSScanCursor::cancel() {
+  if (ahead_state != PrefetchState::idle) {
+    s3_log(S3_LOG_DEBUG, request_id, "Dropping page after key = %s\n",
+           ahead_key.c_str());
+  }
+  orphan_reader(ahead_guard, ahead_reader);
+  ahead_state = PrefetchState::idle;
+  waiting_for_ahead = false;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_MOTR_KVS_SCAN_CURSOR_H__
+#define __S3_SERVER_S3_MOTR_KVS_SCAN_CURSOR_H__
+
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <evhtp.h>
+
+#include "s3_motr_context.h"
+#include "s3_motr_kvs_reader.h"
+#include "s3_motr_wrapper.h"
+#include "s3_request_object.h"
+
+class S3MotrKVSReaderFactory;
+
+// Pages through a KV index for callers that list it batch by batch. Once a
+// full page is handed out, the page following its last key is fetched on a
+// second reader while the caller works on the current one, so the next
+// next_keyval() from that last key is served without a Motr round trip.
+// Callers that stop at a limit tell the cursor how many keys they may still
+// take, so no page is fetched ahead that they will never ask for.
+// Any other next_keyval() drops the page fetched ahead and reads as
+// S3MotrKVSReader would. Results are valid until the next next_keyval().
+class S3MotrKVSScanCursor {
+  // Handed to reader callbacks instead of the cursor. When the cursor goes
+  // away with a fetch in flight, the reader is parked here till it completes.
+  struct FetchGuard {
+    S3MotrKVSScanCursor* cursor;
+    std::shared_ptr<S3MotrKVSReader> orphan;
+
+    explicit FetchGuard(S3MotrKVSScanCursor* owner) : cursor(owner) {}
+  };
+
+  enum class PrefetchState {
+    idle,
+    in_flight,
+    ready,
+  };
+
+  std::shared_ptr<RequestObject> request;
+  std::shared_ptr<S3MotrKVSReaderFactory> reader_factory;
+  std::shared_ptr<MotrAPI> s3_motr_api;
+
+  std::string request_id;
+  std::string stripped_request_id;
+
+  // Pages larger than this are not fetched ahead, 0 disables it
+  size_t max_prefetch_keys;
+  // Keys the caller may still take, see set_key_budget()
+  size_t key_budget = std::numeric_limits<size_t>::max();
+
+  // Holds the page handed to the caller
+  std::shared_ptr<S3MotrKVSReader> current_reader;
+  std::shared_ptr<FetchGuard> current_guard;
+
+  // Page last asked for by the caller
+  struct s3_motr_idx_layout page_idx_lo = {};
+  std::string page_key;
+  size_t page_nr_kvp = 0;
+  unsigned int page_flag = 0;
+
+  // Page following the current one
+  std::shared_ptr<S3MotrKVSReader> ahead_reader;
+  std::shared_ptr<FetchGuard> ahead_guard;
+  PrefetchState ahead_state = PrefetchState::idle;
+  bool ahead_successful = false;
+  struct s3_motr_idx_layout ahead_idx_lo = {};
+  std::string ahead_key;
+  size_t ahead_nr_kvp = 0;
+  // Caller asked for the page fetched ahead before it arrived
+  bool waiting_for_ahead = false;
+
+  std::function<void(void)> handler_on_success;
+  std::function<void(void)> handler_on_failed;
+
+  static void on_fetch_done(std::shared_ptr<FetchGuard> guard, bool prefetch,
+                            bool successful);
+  static void prefetched_page_on_main_thread(evutil_socket_t, short events,
+                                             void* user_data);
+
+  void fetch_page();
+  void fetch_done(bool successful);
+  void prefetch_next_page();
+  void prefetch_done(bool successful);
+  void use_prefetched_page();
+  bool is_prefetched(const struct s3_motr_idx_layout& idx_lo,
+                     const std::string& key, size_t nr_kvp,
+                     unsigned int flag) const;
+  static void orphan_reader(std::shared_ptr<FetchGuard>& guard,
+                            std::shared_ptr<S3MotrKVSReader>& reader);
+
+ public:
+  S3MotrKVSScanCursor(std::shared_ptr<RequestObject> req,
+                      std::shared_ptr<S3MotrKVSReaderFactory> reader_factory,
+                      std::shared_ptr<MotrAPI> motr_api = nullptr);
+  virtual ~S3MotrKVSScanCursor();
+
+  // Same contract as S3MotrKVSReader::next_keyval()
+  virtual void next_keyval(const struct s3_motr_idx_layout& idx_lo,
+                           const std::string& key, size_t nr_kvp,
+                           std::function<void(void)> on_success,
+                           std::function<void(void)> on_failed,
+                           unsigned int flag = M0_OIF_EXCLUDE_START_KEY);
+
+  virtual S3MotrKVSReaderOpState get_state() const;
+
+  virtual const std::map<std::string, std::pair<int, std::string>>&
+  get_key_values() const;
+
+  // Keys the caller may still take, counting those of the page it asks for
+  // next. The following page is fetched ahead only if the budget reaches
+  // past the page handed out. Unlimited by default, for scans that run to
+  // the end of the index.
+  void set_key_budget(size_t keys) { key_budget = keys; }
+
+  // Drops the page fetched ahead, callers that stop paging early may call
+  // this to release it before the cursor goes away.
+  void cancel();
+};
+
+#endif
@@ -22,6 +22,7 @@
 
 #include "s3_common.h"
 
+#include "s3_motr_kvs_batcher.h"
 #include "s3_motr_kvs_writer.h"
 #include "s3_motr_rw_common.h"
 #include "s3_option.h"
@@ -72,7 +73,10 @@ void S3MotrKVSWriter::clean_up_contexts() {
   writer_context = nullptr;
   sync_context = nullptr;
   if (!shutdown_motr_teardown_called) {
-    global_motr_idx.erase(idx_ctx);
+    {
+      std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+      global_motr_idx.erase(idx_ctx);
+    }
     if (idx_ctx) {
       for (size_t i = 0; i < idx_ctx->n_initialized_contexts; i++) {
         if (shutdown_motr_teardown_called) {
@@ -160,11 +164,15 @@ void S3MotrKVSWriter::create_index_with_oid(
   idx_op_ctx->ops[0]->op_datum = (void *)op_ctx;
   s3_motr_api->motr_op_setup(idx_op_ctx->ops[0], idx_op_ctx->cbs, 0);
 
-  writer_context->start_timer_for("create_index_op");
+  writer_context->start_timer_for("create_index_op",
+                                  S3RequestPhase::bucket_metadata);
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops, 1,
                               MotrOpType::createidx);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_idx_ops_list.insert(idx_op_ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -352,11 +360,15 @@ void S3MotrKVSWriter::delete_index(const struct s3_motr_idx_layout &idx_lo,
   idx_op_ctx->ops[0]->op_datum = (void *)op_ctx;
 
   s3_motr_api->motr_op_setup(idx_op_ctx->ops[0], idx_op_ctx->cbs, 0);
-  writer_context->start_timer_for("delete_index_op");
+  writer_context->start_timer_for("delete_index_op",
+                                  S3RequestPhase::bucket_metadata);
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops, 1,
                               MotrOpType::deleteidx);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_idx_ops_list.insert(idx_op_ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -454,11 +466,15 @@ void S3MotrKVSWriter::delete_indices(
     s3_motr_api->motr_op_setup(idx_op_ctx->ops[i], &idx_op_ctx->cbs[i], 0);
   }
 
-  writer_context->start_timer_for("delete_index_op");
+  writer_context->start_timer_for("delete_index_op",
+                                  S3RequestPhase::bucket_metadata);
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops,
                               ops_count, MotrOpType::deleteidx);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_idx_ops_list.insert(idx_op_ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -505,6 +521,17 @@ void S3MotrKVSWriter::put_keyval(
   this->handler_on_success = std::move(on_success);
   this->handler_on_failed = std::move(on_failed);
 
+  S3MotrKVSBatcher *batcher = get_batcher();
+  if (batcher && callback == S3MotrKVSWriter::CallbackType::STABLE) {
+    clean_up_contexts();
+    batcher->put_keyval(
+        request, s3_motr_api, idx_lo, kv_list,
+        std::bind(&S3MotrKVSWriter::batched_put_keyval_done, this,
+                  std::placeholders::_1, std::placeholders::_2,
+                  std::placeholders::_3));
+    return;
+  }
+
   if (idx_ctx) {
     // clean up any old allocations
     clean_up_contexts();
@@ -661,13 +688,17 @@ int S3MotrKVSWriter::put_keyval_impl(
 
   if (is_async) {
 
-    writer_context->start_timer_for("put_keyval");
+    writer_context->start_timer_for("put_keyval",
+                                    s3_motr_idx_phase(idx_los[0]));
   }
 
   s3_motr_api->motr_op_launch(
       (is_async ? request->addb_request_id : m0_dummy_id_generate()),
       &(idx_op_ctx->ops[0]), 1, MotrOpType::putkv);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_idx_ops_list.insert(idx_op_ctx);
+  }
   if (!is_async) {
     s3_log(S3_LOG_DEBUG, request_id, "Waiting for motr put KV to complete\n");
     rc = s3_motr_api->motr_op_wait(
@@ -738,6 +769,17 @@ void S3MotrKVSWriter::put_keyval(const struct s3_motr_idx_layout &idx_lo,
   this->handler_on_success = std::move(on_success);
   this->handler_on_failed = std::move(on_failed);
 
+  S3MotrKVSBatcher *batcher = get_batcher();
+  if (batcher && callback == S3MotrKVSWriter::CallbackType::STABLE) {
+    clean_up_contexts();
+    batcher->put_keyval(
+        request, s3_motr_api, idx_lo, {{key, val}},
+        std::bind(&S3MotrKVSWriter::batched_put_keyval_done, this,
+                  std::placeholders::_1, std::placeholders::_2,
+                  std::placeholders::_3));
+    return;
+  }
+
   if (idx_ctx) {
     // clean up any old allocations
     clean_up_contexts();
@@ -796,11 +838,14 @@ void S3MotrKVSWriter::put_keyval(const struct s3_motr_idx_layout &idx_lo,
   idx_op_ctx->ops[0]->op_datum = (void *)op_ctx;
   s3_motr_api->motr_op_setup(idx_op_ctx->ops[0], idx_op_ctx->cbs, 0);
 
-  writer_context->start_timer_for("put_keyval");
+  writer_context->start_timer_for("put_keyval", s3_motr_idx_phase(idx_lo));
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops, 1,
                               MotrOpType::putkv);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_idx_ops_list.insert(idx_op_ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -968,6 +1013,17 @@ void S3MotrKVSWriter::delete_keyval(const struct s3_motr_idx_layout &idx_lo,
   this->handler_on_success = std::move(on_success);
   this->handler_on_failed = std::move(on_failed);
 
+  S3MotrKVSBatcher *batcher = get_batcher();
+  if (batcher) {
+    clean_up_contexts();
+    batcher->delete_keyval(
+        request, s3_motr_api, idx_lo, keys_list,
+        std::bind(&S3MotrKVSWriter::batched_delete_keyval_done, this,
+                  std::placeholders::_1, std::placeholders::_2,
+                  std::placeholders::_3));
+    return;
+  }
+
   if (idx_ctx) {
     // clean up any old allocations
     clean_up_contexts();
@@ -1026,11 +1082,14 @@ void S3MotrKVSWriter::delete_keyval(const struct s3_motr_idx_layout &idx_lo,
   idx_op_ctx->ops[0]->op_datum = (void *)op_ctx;
   s3_motr_api->motr_op_setup(idx_op_ctx->ops[0], idx_op_ctx->cbs, 0);
 
-  writer_context->start_timer_for("delete_keyval");
+  writer_context->start_timer_for("delete_keyval", s3_motr_idx_phase(idx_lo));
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops, 1,
                               MotrOpType::deletekv);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_idx_ops_list.insert(idx_op_ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -1047,7 +1106,7 @@ void S3MotrKVSWriter::delete_keyval_successful() {
 void S3MotrKVSWriter::delete_keyval_failed() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   if (state != S3MotrKVSWriterOpState::failed_to_launch) {
-    if (writer_context->get_errno_for(0) == -ENOENT) {
+    if (get_op_ret_code_for(0) == -ENOENT) {
       s3_log(S3_LOG_DEBUG, request_id, "The key doesn't exist\n");
       state = S3MotrKVSWriterOpState::missing;
     } else {
@@ -1059,6 +1118,34 @@ void S3MotrKVSWriter::delete_keyval_failed() {
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
+S3MotrKVSBatcher *S3MotrKVSWriter::get_batcher() const {
+  // Batched ops are launched on behalf of a request
+  return batching_enabled && request ? S3MotrKVSBatcher::get_instance()
+                                     : nullptr;
+}
+
+void S3MotrKVSWriter::batched_put_keyval_done(bool success, int op_rc,
+                                              const std::vector<int> &key_rcs) {
+  batched_op_rc = op_rc;
+  batched_key_rcs = key_rcs;
+  if (success) {
+    put_keyval_successful();
+  } else {
+    put_keyval_failed();
+  }
+}
+
+void S3MotrKVSWriter::batched_delete_keyval_done(
+    bool success, int op_rc, const std::vector<int> &key_rcs) {
+  batched_op_rc = op_rc;
+  batched_key_rcs = key_rcs;
+  if (success) {
+    delete_keyval_successful();
+  } else {
+    delete_keyval_failed();
+  }
+}
+
 void S3MotrKVSWriter::set_up_key_value_store(
     struct s3_motr_kvs_op_context *kvs_ctx, const std::string &key,
     const std::string &val, size_t pos) {
@@ -33,6 +33,8 @@
 #include "s3_log.h"
 #include "s3_request_object.h"
 
+class S3MotrKVSBatcher;
+
 class S3SyncMotrKVSWriterContext {
   // Basic Operation context.
   struct s3_motr_idx_op_context* motr_idx_op_context;
@@ -154,8 +156,19 @@ class S3MotrKVSWriter {
 
   struct s3_motr_idx_context* idx_ctx;
 
+  // Results of the last put/delete when it went through S3MotrKVSBatcher
+  bool batching_enabled = true;
+  int batched_op_rc = 0;
+  std::vector<int> batched_key_rcs;
+
   void clean_up_contexts();
 
+  S3MotrKVSBatcher* get_batcher() const;
+  void batched_put_keyval_done(bool success, int op_rc,
+                               const std::vector<int>& key_rcs);
+  void batched_delete_keyval_done(bool success, int op_rc,
+                                  const std::vector<int>& key_rcs);
+
   void create_index_successful();
   void create_index_failed();
   void delete_index_successful();
@@ -263,12 +276,18 @@ class S3MotrKVSWriter {
                               const std::string& key, const std::string& val,
                               size_t pos = 0);
 
+  // Puts and deletes of this writer are sent as they are, used by the
+  // batcher's own writers
+  void disable_batching() { batching_enabled = false; }
+
   virtual int get_op_ret_code_for(int index) {
-    return writer_context->get_errno_for(index);
+    return writer_context ? writer_context->get_errno_for(index)
+                          : batched_op_rc;
   }
 
   virtual int get_op_ret_code_for_del_kv(int key_i) {
-    return writer_context->get_motr_kvs_op_ctx()->rcs[key_i];
+    return writer_context ? writer_context->get_motr_kvs_op_ctx()->rcs[key_i]
+                          : batched_key_rcs[key_i];
   }
 
   // For Testing purpose
@@ -50,14 +50,21 @@ S3MotrReader::S3MotrReader(std::shared_ptr<RequestObject> req,
       S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(layout_id);
 }
 
-S3MotrReader::~S3MotrReader() { clean_up_contexts(); }
+S3MotrReader::~S3MotrReader() {
+  // Pending checksum verification refers to the read buffers
+  hash_queue.reset();
+  clean_up_contexts();
+}
 
 void S3MotrReader::clean_up_contexts() {
   // op contexts need to be free'ed before object
   open_context = nullptr;
   reader_context = nullptr;
   if (!shutdown_motr_teardown_called) {
-    global_motr_obj.erase(obj_ctx);
+    {
+      std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+      global_motr_obj.erase(obj_ctx);
+    }
     if (obj_ctx) {
       for (size_t i = 0; i < obj_ctx->n_initialized_contexts; i++) {
         s3_motr_api->motr_obj_fini(&obj_ctx->objs[i]);
@@ -183,7 +190,10 @@ int S3MotrReader::open_object(std::function<void(void)> on_success,
 
   s3_motr_api->motr_op_launch(request->addb_request_id, ctx->ops, 1,
                               MotrOpType::openobj);
-  global_motr_object_ops_list.insert(ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_object_ops_list.insert(ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return rc;
 }
@@ -242,7 +252,8 @@ bool S3MotrReader::read_object() {
 
   /* Read the requisite number of blocks from the entity */
   if (!reader_context->init_read_op_ctx(request_id, num_of_blocks_to_read,
-                                        motr_unit_size, &last_index)) {
+                                        motr_unit_size, &last_index,
+                                        unit_buffers)) {
     // out-of-memory
     state = S3MotrReaderOpState::ooo;
     s3_log(S3_LOG_ERROR, request_id,
@@ -290,7 +301,8 @@ bool S3MotrReader::read_object() {
   ctx->ops[0]->op_datum = (void *)op_ctx;
   s3_motr_api->motr_op_setup(ctx->ops[0], &ctx->cbs[0], 0);
 
-  reader_context->start_timer_for("read_object_data");
+  reader_context->start_timer_for("read_object_data",
+                                  S3RequestPhase::data_io);
 
   s3_log(S3_LOG_INFO, stripped_request_id,
          "Motr API: readobj(operation: M0_OC_READ, oid: ("
@@ -299,7 +311,10 @@ bool S3MotrReader::read_object() {
 
   s3_motr_api->motr_op_launch(request->addb_request_id, ctx->ops, 1,
                               MotrOpType::readobj);
-  global_motr_object_ops_list.insert(ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_object_ops_list.insert(ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return true;
 }
@@ -392,6 +407,10 @@ bool S3MotrReader::ValidateStoredChksum() {
   uint64_t current_index = starting_index_for_read;
 
   for (uint32_t i = 0; i < pi_buffer_count; i++) {
+    if (S3HashQueue::is_current_task_cancelled()) {
+      // Reader is being destroyed, the result won't be used
+      return false;
+    }
 
     assert(end_offset <= data_buffer_count);
 
@@ -473,14 +492,34 @@ void S3MotrReader::read_object_successful() {
     }
   }
 
+  is_stored_chksum_valid = true;
   if (S3Option::get_instance()->is_s3_read_di_check_enabled()) {
-    if (!this->ValidateStoredChksum()) {
-      state = S3MotrReaderOpState::failed;
-      this->handler_on_failed();
+    S3HashThreadPool *hash_pool = S3HashThreadPool::get_instance();
+    if (hash_pool) {
+      // Checksums are verified on a hash thread, the event loop serves
+      // other requests meanwhile (see also S3MotrWiter::write_content())
+      if (!hash_queue) {
+        hash_queue.reset(new S3HashQueue(hash_pool));
+      }
+      hash_queue->submit(
+          [this]() { is_stored_chksum_valid = ValidateStoredChksum(); },
+          std::bind(&S3MotrReader::read_object_verified, this));
+      s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
       return;
     }
+    is_stored_chksum_valid = this->ValidateStoredChksum();
   }
+  read_object_verified();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
 
+void S3MotrReader::read_object_verified() {
+  s3_log(S3_LOG_DEBUG, "", "%s Entry", __func__);
+  if (!is_stored_chksum_valid) {
+    state = S3MotrReaderOpState::failed;
+    this->handler_on_failed();
+    return;
+  }
   state = S3MotrReaderOpState::success;
   this->handler_on_success();
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
@@ -28,6 +28,7 @@
 
 #include "s3_asyncop_context_base.h"
 #include "s3_buffer_sequence.h"
+#include "s3_hash_thread_pool.h"
 #include "s3_motr_context.h"
 #include "s3_motr_layout.h"
 #include "s3_motr_wrapper.h"
@@ -91,22 +92,37 @@ class S3MotrReaderContext : public S3AsyncOpContextBase {
   // param(in): motr_block_count - motr blocks to read
   // param(in): sz_per_block - motr unit size of each block to read
   // param(in/out): last_index - where next read should start
+  // param(in): unit_buffers - read into unit sized pool buffers if possible
   bool init_read_op_ctx(std::string request_id, size_t motr_block_count,
-                        size_t sz_per_block, uint64_t* last_index) {
-    // Since we use const size buffer pool in libevent, we use its size of buf
+                        size_t sz_per_block, uint64_t* last_index,
+                        bool unit_buffers = false) {
     size_t total_read_sz = motr_block_count * sz_per_block;
-    size_t evbuf_unit_buf_sz =
-        S3Option::get_instance()->get_libevent_pool_buffer_size();
-    size_t buf_count_in_evbuf =
-        (total_read_sz + (evbuf_unit_buf_sz - 1)) / evbuf_unit_buf_sz;
-
-    // Motr unit size / size of 1 evbuf.
-    int motr_unit_size =
-        S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(layout_id);
-    int sz_of_one_evt_buf =
-        S3Option::get_instance()->get_libevent_pool_buffer_size();
-    size_t buf_per_motr_unit =
-        (motr_unit_size + (sz_of_one_evt_buf - 1)) / sz_of_one_evt_buf;
+    size_t evbuf_unit_buf_sz;
+    size_t buf_count_in_evbuf;
+    size_t buf_per_motr_unit;
+    const bool f_pool_buffers =
+        unit_buffers && S3Evbuffer::can_use_pool_buffers(sz_per_block);
+    if (f_pool_buffers) {
+      // One contiguous buffer per motr unit
+      evbuf_unit_buf_sz = sz_per_block;
+      buf_count_in_evbuf = motr_block_count;
+      buf_per_motr_unit = 1;
+    } else {
+      // Since we use const size buffer pool in libevent, we use its size of
+      // buf
+      evbuf_unit_buf_sz =
+          S3Option::get_instance()->get_libevent_pool_buffer_size();
+      buf_count_in_evbuf =
+          (total_read_sz + (evbuf_unit_buf_sz - 1)) / evbuf_unit_buf_sz;
+
+      // Motr unit size / size of 1 evbuf.
+      int motr_unit_size =
+          S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(layout_id);
+      int sz_of_one_evt_buf =
+          S3Option::get_instance()->get_libevent_pool_buffer_size();
+      buf_per_motr_unit =
+          (motr_unit_size + (sz_of_one_evt_buf - 1)) / sz_of_one_evt_buf;
+    }
 
     motr_rw_op_context = create_basic_rw_op_ctx(
         buf_count_in_evbuf, buf_per_motr_unit, evbuf_unit_buf_sz);
@@ -120,7 +136,8 @@ class S3MotrReaderContext : public S3AsyncOpContextBase {
     }
     // Create real buffer space using evbuffer
     p_s3_evbuffer = std::unique_ptr<S3Evbuffer>(
-        new S3Evbuffer(request_id, total_read_sz, evbuf_unit_buf_sz));
+        new S3Evbuffer(request_id, total_read_sz, evbuf_unit_buf_sz,
+                       f_pool_buffers));
     int rc = p_s3_evbuffer->init();
     if (rc != 0) {
       s3_log(S3_LOG_ERROR, request_id, "p_s3_evbuffer->init failed\n");
@@ -201,10 +218,20 @@ class S3MotrReader {
   bool is_object_opened = false;
   struct s3_motr_obj_context* obj_ctx = nullptr;
 
+  // Read into unit sized pool buffers when S3_MOTR_READ_UNIT_BUFFERS allows.
+  // Blocks read are then motr unit long instead of
+  // S3_LIBEVENT_POOL_BUFFER_SIZE, so only consumers taking blocks of any size
+  // (GET) opt in.
+  bool unit_buffers = false;
+
   // fill entire object with zeroes when reading it from the storage
   // See S3MotrWiter::corrupt_fill_zero.
   bool corrupt_fill_zero = false;
 
+  // Checksum verification of read data, when done off the event loop
+  std::unique_ptr<S3HashQueue> hash_queue;
+  bool is_stored_chksum_valid = true;
+
   // Internal open operation so motr can fetch required object metadata
   // for example object pool version
   int open_object(std::function<void(void)> on_success,
@@ -216,6 +243,8 @@ class S3MotrReader {
   // opened.
   virtual bool read_object();
   void read_object_successful();
+  // Completes the read after the stored checksums are verified (if enabled)
+  void read_object_verified();
   bool ValidateStoredChksum();
   size_t CalculateBytesProcessed(m0_bufvec* motr_data_unit);
   bool ValidateStoredMD5Chksum(m0_bufvec* motr_data_unit,
@@ -237,6 +266,8 @@ class S3MotrReader {
 
   virtual void set_oid(struct m0_uint128 id) { oid = id; }
 
+  void use_unit_buffers() { unit_buffers = true; }
+
   // async read
   // Returns: true = launched, false = failed to launch (out-of-memory)
   virtual bool read_object_data(size_t num_of_blocks,
@@ -289,6 +320,7 @@ class S3MotrReader {
   FRIEND_TEST(S3MotrReaderTest, OpenObjectMissingTest);
   FRIEND_TEST(S3MotrReaderTest, OpenObjectErrFailedTest);
   FRIEND_TEST(S3MotrReaderTest, OpenObjectSuccessTest);
+  FRIEND_TEST(S3ObjectDataCopierTest, ReadWithUnitBuffersEnabled);
 };
 
 #endif
@@ -26,6 +26,9 @@
 #include "s3_motr_kvs_reader.h"
 #include "s3_motr_kvs_writer.h"
 #include "s3_fake_motr_kvs.h"
+#include "s3_fake_motr_obj_store.h"
+#include "s3_motr_reader.h"
+#include "s3_motr_writer.h"
 #include "s3_common_utilities.h"
 
 #include <ctime>
@@ -88,10 +91,8 @@ void motr_op_done_on_main_thread(evutil_socket_t, short events,
     stripped_request_id = context->get_request()->get_stripped_request_id();
   }
   s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+  // NULL when posted through the completion queue of the loop
   struct event *s3user_event = (struct event *)user_context->user_event;
-  if (s3user_event == NULL) {
-    s3_log(S3_LOG_ERROR, request_id, "User event is NULL\n");
-  }
   context->log_timer();
 
   if (context->is_at_least_one_op_successful()) {
@@ -180,6 +181,7 @@ std::string s3_motr_op_common(struct m0_op *op) {
     struct user_event_context *user_ctx = (struct user_event_context *)calloc(
         1, sizeof(struct user_event_context));
     user_ctx->app_ctx = app_ctx;
+    user_ctx->evbase = app_ctx->get_evbase();
     app_ctx->stop_timer();
 
 #ifdef S3_GOOGLE_TEST
@@ -236,6 +238,7 @@ void s3_motr_op_failed(struct m0_op *op) {
     struct user_event_context *user_ctx = (struct user_event_context *)calloc(
         1, sizeof(struct user_event_context));
     user_ctx->app_ctx = app_ctx;
+    user_ctx->evbase = app_ctx->get_evbase();
     app_ctx->stop_timer(false);
 #ifdef S3_GOOGLE_TEST
     evutil_socket_t test_sock = 0;
@@ -270,6 +273,32 @@ void s3_motr_op_pre_launch_failure(void *application_context, int rc) {
   s3_log(S3_LOG_DEBUG, request_id, "%s Exit", __func__);
 }
 
+// Object ops of the fake motr mode served by S3FakeMotrObjStore
+static int s3_fake_motr_obj_op(struct m0_op *op) {
+  S3FakeMotrObjStore *store = S3FakeMotrObjStore::instance();
+  struct m0_uint128 const &oid = op->op_entity->en_id;
+  struct s3_motr_context_obj *ctx = (struct s3_motr_context_obj *)op->op_datum;
+
+  if (op->op_code == M0_EO_CREATE) {
+    return store->obj_create(oid);
+  } else if (op->op_code == M0_EO_OPEN) {
+    return store->obj_open(oid);
+  } else if (op->op_code == M0_EO_DELETE) {
+    return store->obj_delete(oid);
+  } else if (op->op_code == M0_OC_WRITE) {
+    S3MotrWiterContext *write_ctx =
+        (S3MotrWiterContext *)ctx->application_context;
+    struct s3_motr_rw_op_context *rw_ctx = write_ctx->get_motr_rw_op_ctx();
+    return store->obj_write(oid, *rw_ctx->ext, *rw_ctx->data);
+  } else if (op->op_code == M0_OC_READ) {
+    S3MotrReaderContext *read_ctx =
+        (S3MotrReaderContext *)ctx->application_context;
+    struct s3_motr_rw_op_context *rw_ctx = read_ctx->get_motr_rw_op_ctx();
+    return store->obj_read(oid, *rw_ctx->ext, *rw_ctx->data);
+  }
+  return 0;
+}
+
 void s3_motr_dummy_op_stable(evutil_socket_t, short events, void *user_data) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
   struct user_event_context *user_context =
@@ -315,10 +344,15 @@ void s3_motr_dummy_op_stable(evutil_socket_t, short events, void *user_data) {
 
     op->op_rc = S3FakeMotrKvs::instance()->kv_del(
         op->op_entity->en_id, *write_ctx->get_motr_kvs_op_ctx());
+  } else if (op->op_entity && op->op_entity->en_type == M0_ET_OBJ &&
+             S3Option::get_instance()->is_fake_motr_obj_store()) {
+    op->op_rc = s3_fake_motr_obj_op(op);
   }
 
-  // Free user event
-  event_free((struct event *)user_context->user_event);
+  // Free user event, if it was posted with one
+  if (user_context->user_event) {
+    event_free((struct event *)user_context->user_event);
+  }
   s3_motr_op_stable(op);
   free(user_data);
 }
@@ -334,8 +368,10 @@ void s3_motr_dummy_op_failed(evutil_socket_t, short events, void *user_data) {
   // where m0_rc can't be mocked.
   op->op_rc = -ETIMEDOUT;  // fake network failure
   ctx->is_fake_failure = 1;
-  // Free user event
-  event_free((struct event *)user_context->user_event);
+  // Free user event, if it was posted with one
+  if (user_context->user_event) {
+    event_free((struct event *)user_context->user_event);
+  }
   s3_motr_op_failed(op);
   free(user_data);
 }
@@ -30,11 +30,27 @@ extern struct m0_ufid_generator s3_ufid_generator;
 
 void ConcreteMotrAPI::motr_fake_op_launch(struct m0_op **op, uint32_t nr) {
   s3_log(S3_LOG_DEBUG, "", "Called\n");
-  struct user_event_context *user_ctx =
-      (struct user_event_context *)calloc(1, sizeof(struct user_event_context));
-  user_ctx->app_ctx = op[0];
+  S3Option *config = S3Option::get_instance();
+  unsigned latency_us = config->get_fake_motr_latency_us();
+  // Every op of the launch completes, as the requester waits for all of them
+  uint32_t ops_count = config->is_fake_motr_obj_store() ? nr : 1;
+  for (uint32_t i = 0; i < ops_count; ++i) {
+    struct user_event_context *user_ctx = (struct user_event_context *)calloc(
+        1, sizeof(struct user_event_context));
+    user_ctx->app_ctx = op[i];
 
-  S3PostToMainLoop((void *)user_ctx)(s3_motr_dummy_op_stable);
+    if (latency_us == 0) {
+      S3PostToMainLoop((void *)user_ctx)(s3_motr_dummy_op_stable);
+      continue;
+    }
+    // Emulated network and storage latency
+    struct event *ev_timer = event_new(config->get_eventbase(), -1, 0,
+                                       s3_motr_dummy_op_stable, user_ctx);
+    user_ctx->user_event = ev_timer;
+    struct timeval latency = {(time_t)(latency_us / 1000000),
+                              (suseconds_t)(latency_us % 1000000)};
+    evtimer_add(ev_timer, &latency);
+  }
 }
 
 void ConcreteMotrAPI::motr_fake_redis_op_launch(struct m0_op **op,
@@ -308,6 +324,8 @@ int ConcreteMotrAPI::motr_obj_op(struct m0_obj *obj, enum m0_obj_opcode opcode,
     }
     (*op)->op_code = opcode;
     (*op)->op_sm.sm_state = M0_OS_INITIALISED;
+    // Object of the op for the fake object store
+    (*op)->op_entity = &obj->ob_entity;
     return 0;
   }
 
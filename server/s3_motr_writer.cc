@@ -130,6 +130,9 @@ S3MotrWiter::S3MotrWiter(std::shared_ptr<RequestObject> req,
 }
 
 S3MotrWiter::~S3MotrWiter() {
+  // Pending checksum calculation refers to the buffers and contexts.
+  // The running one is cancelled, so the wait is at most one unit's digest.
+  hash_queue.reset();
   reset_buffers_if_any(unit_size_for_place_holder);
   clean_up_contexts();
 }
@@ -159,7 +162,10 @@ void S3MotrWiter::clean_up_contexts() {
   writer_context = nullptr;
   delete_context = nullptr;
   if (!shutdown_motr_teardown_called) {
-    global_motr_obj.erase(obj_ctx);
+    {
+      std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+      global_motr_obj.erase(obj_ctx);
+    }
     if (obj_ctx) {
       for (size_t i = 0; i < obj_ctx->n_initialized_contexts; ++i) {
         s3_motr_api->motr_obj_fini(&obj_ctx->objs[i]);
@@ -240,7 +246,10 @@ int S3MotrWiter::open_objects() {
          oid_list_stream.str().c_str());
   s3_motr_api->motr_op_launch(request->addb_request_id, ctx->ops, ops_count,
                               MotrOpType::openobj);
-  global_motr_object_ops_list.insert(ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_object_ops_list.insert(ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return 0;
 }
@@ -373,7 +382,10 @@ void S3MotrWiter::create_object(std::function<void(void)> on_success,
 
   s3_motr_api->motr_op_launch(request->addb_request_id, ctx->ops, 1,
                               MotrOpType::createobj);
-  global_motr_object_ops_list.insert(ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_object_ops_list.insert(ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -451,7 +463,6 @@ void S3MotrWiter::write_content(std::function<void(void)> on_success,
 }
 
 void S3MotrWiter::write_content() {
-  int rc;
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry with layout_id = %d\n",
          __func__, layout_ids[0]);
 
@@ -494,6 +505,39 @@ void S3MotrWiter::write_content() {
 
   writer_context->init_write_op_ctx(motr_buf_count, buffers_per_unit);
 
+  struct s3_motr_rw_op_context *rw_ctx = writer_context->get_motr_rw_op_ctx();
+
+  // Placeholder buffer allocation for padding, mempool is used only here
+  size_t data_buf_count = buffer_sequence.size();
+  find_and_allocate_placeholder_for_data_alignment(data_buf_count,
+                                                   motr_buf_count);
+
+  S3HashThreadPool *hash_pool = S3HashThreadPool::get_instance();
+  if (hash_pool) {
+    // Checksums are calculated on a hash thread, the event loop serves
+    // other requests meanwhile. Actions keep a single write in flight, so
+    // hashing of the next buffers doesn't overlap with this Motr write.
+    if (!hash_queue) {
+      hash_queue.reset(new S3HashQueue(hash_pool));
+    }
+    hash_queue->submit(
+        [this, rw_ctx, motr_buf_count]() {
+          set_up_motr_data_buffers(rw_ctx, std::move(buffer_sequence),
+                                   motr_buf_count);
+        },
+        std::bind(&S3MotrWiter::launch_write_op, this));
+  } else {
+    set_up_motr_data_buffers(rw_ctx, std::move(buffer_sequence),
+                             motr_buf_count);
+    launch_write_op();
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3MotrWiter::launch_write_op() {
+  int rc;
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+
   struct s3_motr_op_context *ctx = writer_context->get_motr_op_ctx();
 
   struct s3_motr_rw_op_context *rw_ctx = writer_context->get_motr_rw_op_ctx();
@@ -509,8 +553,6 @@ void S3MotrWiter::write_content() {
   ctx->cbs[0].oop_stable = s3_motr_op_stable;
   ctx->cbs[0].oop_failed = s3_motr_op_failed;
 
-  set_up_motr_data_buffers(rw_ctx, std::move(buffer_sequence), motr_buf_count);
-
   // see also similar code in S3MotrReader::read_object_successful()
   if (s3_di_fi_is_enabled("di_data_corrupted_on_write")) {
     struct m0_bufvec *bv = rw_ctx->data;
@@ -558,7 +600,8 @@ void S3MotrWiter::write_content() {
 
   ctx->ops[0]->op_datum = (void *)op_ctx;
   s3_motr_api->motr_op_setup(ctx->ops[0], &ctx->cbs[0], 0);
-  writer_context->start_timer_for("write_to_motr_op");
+  writer_context->start_timer_for("write_to_motr_op",
+                                  S3RequestPhase::data_io);
 
   s3_log(S3_LOG_INFO, stripped_request_id,
          "Motr API: Write (operation: M0_OC_WRITE, oid: ("
@@ -568,7 +611,10 @@ void S3MotrWiter::write_content() {
          size_in_current_write);
   s3_motr_api->motr_op_launch(request->addb_request_id, ctx->ops, 1,
                               MotrOpType::writeobj);
-  global_motr_object_ops_list.insert(ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_object_ops_list.insert(ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -670,13 +716,17 @@ void S3MotrWiter::delete_objects() {
                     << ") ";
   }
 
-  delete_context->start_timer_for("delete_objects_from_motr");
+  delete_context->start_timer_for("delete_objects_from_motr",
+                                  S3RequestPhase::data_io);
 
   s3_log(S3_LOG_INFO, stripped_request_id, "Motr API: deleteobj(oid: %s)\n",
          oid_list_stream.str().c_str());
   s3_motr_api->motr_op_launch(request->addb_request_id, ctx->ops, ops_count,
                               MotrOpType::deleteobj);
-  global_motr_object_ops_list.insert(ctx);
+  {
+    std::lock_guard<std::mutex> guard(global_motr_ctx_lock);
+    global_motr_object_ops_list.insert(ctx);
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -949,6 +999,12 @@ void S3MotrWiter::set_up_motr_data_buffers(struct s3_motr_rw_op_context *rw_ctx,
   int s3_checksum_flag = 0;
 
   while (!buffer_sequence.empty()) {
+    if (S3HashQueue::is_current_task_cancelled()) {
+      // Writer is being destroyed, buffers and checksums won't be used.
+      // The buffers stay owned by the caller.
+      s3_log(S3_LOG_DEBUG, request_id, "%s Cancelled\n", __func__);
+      return;
+    }
     calculated_chksum_at_unit_boundary = false;
     const auto &ptr_n_len = buffer_sequence.front();
     len_in_buf = ptr_n_len.second;
@@ -995,10 +1051,7 @@ void S3MotrWiter::set_up_motr_data_buffers(struct s3_motr_rw_op_context *rw_ctx,
         (unsigned char *)s3_md5crypt->get_prev_write_checksum());
   }
 
-  // Placeholder buffer allocation for padding
-  find_and_allocate_placeholder_for_data_alignment(buf_idx, motr_buf_count);
-
-  // Perform padding using above placeholder buffer
+  // Perform padding using placeholder buffer allocated by write_content()
   align_data_to_motr_unit_size(rw_ctx, buf_idx, motr_buf_count,
                                starting_checksum_buf_idx);
 
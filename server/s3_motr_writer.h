@@ -35,6 +35,7 @@
 #include "s3_md5_hash.h"
 #include "s3_request_object.h"
 #include "s3_buffer_sequence.h"
+#include "s3_hash_thread_pool.h"
 
 class S3MotrWiterContext : public S3AsyncOpContextBase {
   // Basic Operation context.
@@ -134,6 +135,9 @@ class S3MotrWiter {
   // writing to Motr
   bool corrupt_fill_zero = false;
 
+  // Checksum calculation of written data, when done off the event loop
+  std::unique_ptr<S3HashQueue> hash_queue;
+
   // Write - single object, delete - multiple objects supported
   void create_object_successful();
   void create_object_failed();
@@ -143,6 +147,8 @@ class S3MotrWiter {
   void open_objects_failed();
 
   void write_content();
+  // Continues write_content() once checksums of the data are calculated
+  void launch_write_op();
   void write_content_successful();
   void write_content_failed();
 
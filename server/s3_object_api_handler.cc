@@ -47,12 +47,14 @@ void S3ObjectAPIHandler::create_action() {
       switch (request->http_verb()) {
         case S3HttpVerb::GET:
           request->set_action_str("GetObjectAcl");
-          action = std::make_shared<S3GetObjectACLAction>(request);
+          action = s3_arena_make_shared<S3GetObjectACLAction>(
+              request->get_arena(), request);
           s3_stats_inc("get_object_acl_request_count");
           break;
         case S3HttpVerb::PUT:
           request->set_action_str("PutObjectAcl");
-          action = std::make_shared<S3PutObjectACLAction>(request);
+          action = s3_arena_make_shared<S3PutObjectACLAction>(
+              request->get_arena(), request);
           s3_stats_inc("put_object_acl_request_count");
           break;
         default:
@@ -66,12 +68,14 @@ void S3ObjectAPIHandler::create_action() {
           if (request->has_query_param_key("uploadid")) {
             // Complete multipart upload
             request->set_action_str("PostComplete");
-            action = std::make_shared<S3PostCompleteAction>(request);
+            action = s3_arena_make_shared<S3PostCompleteAction>(
+                request->get_arena(), request);
             s3_stats_inc("post_multipart_complete_request_count");
           } else {
             // Initiate Multipart
             request->set_action_str("PostMultipart");
-            action = std::make_shared<S3PostMultipartObjectAction>(request);
+            action = s3_arena_make_shared<S3PostMultipartObjectAction>(
+                request->get_arena(), request);
             s3_stats_inc("post_multipart_initiate_request_count");
           }
           break;
@@ -83,20 +87,23 @@ void S3ObjectAPIHandler::create_action() {
             // Multipart part uploads
             request->set_object_size(request->get_data_length());
             request->set_action_str("PutMultiObject");
-            action = std::make_shared<S3PutMultiObjectAction>(request);
+            action = s3_arena_make_shared<S3PutMultiObjectAction>(
+                request->get_arena(), request);
             s3_stats_inc("put_multipart_part_request_count");
           }
           break;
         case S3HttpVerb::GET:
           // Multipart part listing
           request->set_action_str("ListMultiPartUploadParts");
-          action = std::make_shared<S3GetMultipartPartAction>(request);
+          action = s3_arena_make_shared<S3GetMultipartPartAction>(
+              request->get_arena(), request);
           s3_stats_inc("get_multipart_parts_request_count");
           break;
         case S3HttpVerb::DELETE:
           // Multipart abort
           request->set_action_str("AbortMultipartUpload");
-          action = std::make_shared<S3AbortMultipartAction>(request);
+          action = s3_arena_make_shared<S3AbortMultipartAction>(
+              request->get_arena(), request);
           s3_stats_inc("abort_multipart_request_count");
           break;
         default:
@@ -109,7 +116,8 @@ void S3ObjectAPIHandler::create_action() {
         case S3HttpVerb::HEAD:
           request->set_object_size(request->get_data_length());
           request->set_action_str("HeadObject");
-          action = std::make_shared<S3HeadObjectAction>(request);
+          action = s3_arena_make_shared<S3HeadObjectAction>(
+              request->get_arena(), request);
           s3_stats_inc("head_object_request_count");
           break;
         case S3HttpVerb::PUT:
@@ -118,29 +126,34 @@ void S3ObjectAPIHandler::create_action() {
             // chunk upload
             request->set_object_size(request->get_data_length());
             request->set_action_str("PutChunkUploadObject");
-            action = std::make_shared<S3PutChunkUploadObjectAction>(request);
+            action = s3_arena_make_shared<S3PutChunkUploadObjectAction>(
+                request->get_arena(), request);
             s3_stats_inc("put_object_chunkupload_request_count");
           } else if (!request->get_header_value("x-amz-copy-source").empty()) {
             request->set_action_str("CopyObject");
             request->set_object_size(request->get_data_length());
-            action = std::make_shared<S3CopyObjectAction>(request);
+            action = s3_arena_make_shared<S3CopyObjectAction>(
+                request->get_arena(), request);
             s3_stats_inc("copy_object_request_count");
           } else {
             // single chunk upload
             request->set_action_str("PutObject");
             request->set_object_size(request->get_data_length());
-            action = std::make_shared<S3PutObjectAction>(request);
+            action = s3_arena_make_shared<S3PutObjectAction>(
+                request->get_arena(), request);
             s3_stats_inc("put_object_request_count");
           }
           break;
         case S3HttpVerb::GET:
           request->set_action_str("GetObject");
-          action = std::make_shared<S3GetObjectAction>(request);
+          action = s3_arena_make_shared<S3GetObjectAction>(
+              request->get_arena(), request);
           s3_stats_inc("get_object_request_count");
           break;
         case S3HttpVerb::DELETE:
           request->set_action_str("DeleteObject");
-          action = std::make_shared<S3DeleteObjectAction>(request);
+          action = s3_arena_make_shared<S3DeleteObjectAction>(
+              request->get_arena(), request);
           s3_stats_inc("delete_object_request_count");
           break;
         case S3HttpVerb::POST:
@@ -164,17 +177,20 @@ void S3ObjectAPIHandler::create_action() {
       switch (request->http_verb()) {
         case S3HttpVerb::GET:
           request->set_action_str("GetObjectTagging");
-          action = std::make_shared<S3GetObjectTaggingAction>(request);
+          action = s3_arena_make_shared<S3GetObjectTaggingAction>(
+              request->get_arena(), request);
           s3_stats_inc("get_object_tagging_count");
           break;
         case S3HttpVerb::PUT:
           request->set_action_str("PutObjectTagging");
-          action = std::make_shared<S3PutObjectTaggingAction>(request);
+          action = s3_arena_make_shared<S3PutObjectTaggingAction>(
+              request->get_arena(), request);
           s3_stats_inc("put_object_tagging_count");
           break;
         case S3HttpVerb::DELETE:
           request->set_action_str("DeleteObjectTagging");
-          action = std::make_shared<S3DeleteObjectTaggingAction>(request);
+          action = s3_arena_make_shared<S3DeleteObjectTaggingAction>(
+              request->get_arena(), request);
           s3_stats_inc("delete_object_tagging_count");
           break;
         default:
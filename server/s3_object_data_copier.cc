@@ -60,31 +60,98 @@ S3ObjectDataCopier::~S3ObjectDataCopier() {
   if (p_evbuffer_write) {
     ::evbuffer_free(p_evbuffer_write);
   }
-  if (p_evbuffer_read) {
-    ::evbuffer_free(p_evbuffer_read);
+  for (auto& chunk : chunks_read) {
+    if (chunk.second.p_evbuffer) {
+      ::evbuffer_free(chunk.second.p_evbuffer);
+    }
+  }
+}
+
+void S3ObjectDataCopier::notify_failure() {
+  if (copy_parts_fragment) {
+    this->on_failure_for_fragments(vector_index);
+  } else {
+    this->on_failure();
+  }
+}
+
+void S3ObjectDataCopier::notify_success() {
+  if (copy_parts_fragment) {
+    this->on_success_for_fragments(vector_index);
+  } else {
+    this->on_success();
+  }
+}
+
+void S3ObjectDataCopier::pump() {
+  if (in_pump) {
+    // Callback ran synchronously while starting an operation,
+    // the outer call will pick up its result.
+    return;
+  }
+  in_pump = true;
+  if (!copy_failed) {
+    if (!write_in_progress) {
+      write_data_block();
+    }
+    read_data_blocks();
+  }
+  in_pump = false;
+
+  if (reads_in_progress || write_in_progress) {
+    return;
+  }
+  if (copy_failed) {
+    notify_failure();
+  } else if (next_chunk_to_write == chunks_total) {
+    notify_success();
+  }
+}
+
+void S3ObjectDataCopier::read_data_blocks() {
+  for (size_t i = 0; i < read_slots.size(); ++i) {
+    if (copy_failed || next_chunk_to_read >= chunks_total ||
+        reads_in_progress + chunks_read.size() >= pipeline_depth) {
+      break;
+    }
+    if (!read_slots[i].read_in_progress) {
+      read_data_block(i);
+    }
   }
 }
 
-void S3ObjectDataCopier::read_data_block() {
+void S3ObjectDataCopier::read_data_block(size_t slot_index) {
   s3_log(S3_LOG_INFO, request_id, "%s Entry\n", __func__);
 
-  assert(!read_in_progress);
-  assert(data_blocks_read.empty());
-  assert(!p_evbuffer_read);
-  assert(bytes_left_to_read > 0);
-  const auto n_blocks = std::min<size_t>(
-      S3Option::get_instance()->get_motr_units_per_request(),
-      (bytes_left_to_read + motr_unit_size - 1) / motr_unit_size);
+  auto& slot = read_slots[slot_index];
+  assert(!slot.read_in_progress);
+  assert(next_chunk_to_read < chunks_total);
+
+  const size_t offset = next_chunk_to_read * chunk_size;
+  const size_t bytes_in_chunk = std::min(chunk_size, object_size - offset);
+  const size_t n_blocks =
+      (bytes_in_chunk + motr_unit_size - 1) / motr_unit_size;
 
+  slot.chunk_index = next_chunk_to_read++;
+  slot.read_in_progress = true;
+  ++reads_in_progress;
+  slot.motr_reader->set_last_index(offset);
+
+  // read_object_data() can call the failure handler before returning
+  auto motr_reader = slot.motr_reader;
   if (motr_reader->read_object_data(
           n_blocks,
-          std::bind(&S3ObjectDataCopier::read_data_block_success, this),
-          std::bind(&S3ObjectDataCopier::read_data_block_failed, this))) {
+          std::bind(&S3ObjectDataCopier::read_data_block_success, this,
+                    slot_index),
+          std::bind(&S3ObjectDataCopier::read_data_block_failed, this,
+                    slot_index))) {
 
-    s3_log(S3_LOG_DEBUG, request_id, "Read of %zu data block is started",
-           n_blocks);
-    read_in_progress = true;
-  } else {
+    s3_log(S3_LOG_DEBUG, request_id,
+           "Read of %zu data blocks of chunk %zu is started", n_blocks,
+           read_slots[slot_index].chunk_index);
+  } else if (read_slots[slot_index].read_in_progress) {
+    read_slots[slot_index].read_in_progress = false;
+    --reads_in_progress;
     copy_failed = true;
     s3_log(S3_LOG_ERROR, request_id, "Read of %zu data block failed to start",
            n_blocks);
@@ -92,124 +159,77 @@ void S3ObjectDataCopier::read_data_block() {
                          S3MotrReaderOpState::failed_to_launch
                      ? "ServiceUnavailable"
                      : "InternalError");
-    if (!write_in_progress) {
-      if (copy_parts_fragment) {
-        this->on_failure_for_fragments(vector_index);
-      } else {
-        this->on_failure();
-      }
-    }
   }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3ObjectDataCopier::read_data_block_success() {
+void S3ObjectDataCopier::read_data_block_success(size_t slot_index) {
 
   s3_log(S3_LOG_INFO, request_id, "%s Entry\n", __func__);
   s3_log(S3_LOG_INFO, request_id, "Reading a part of data succeeded");
 
-  assert(read_in_progress);
-  read_in_progress = false;
+  auto& slot = read_slots[slot_index];
+  assert(slot.read_in_progress);
+  slot.read_in_progress = false;
+  --reads_in_progress;
 
   if (check_shutdown_and_rollback()) {
     s3_log(S3_LOG_DEBUG, nullptr, "Shutdown or rollback");
     return;
   }
   if (copy_failed) {
-    assert(!write_in_progress);
-
-    if (copy_parts_fragment) {
-      this->on_failure_for_fragments(vector_index);
-    } else {
-      this->on_failure();
-    }
+    pump();
     return;
   }
-  assert(data_blocks_read.empty());
-  data_blocks_read = motr_reader->extract_blocks_read();
+  assert(chunks_read.count(slot.chunk_index) == 0);
+  ChunkRead& chunk = chunks_read[slot.chunk_index];
+  chunk.data_blocks = slot.motr_reader->extract_blocks_read();
 
   // Save ev buffer containing the read data, which will be freed after
   // data write completion.
-  assert(!p_evbuffer_read);
-  p_evbuffer_read = motr_reader->get_evbuffer_ownership();
-  assert(p_evbuffer_read != nullptr);
-
-  size_t bytes_in_chunk_count = 0;
+  chunk.p_evbuffer = slot.motr_reader->get_evbuffer_ownership();
+  assert(chunk.p_evbuffer != nullptr);
 
-  if (data_blocks_read.empty()) {
+  if (chunk.data_blocks.empty()) {
     s3_log(S3_LOG_ERROR, request_id, "Motr reader returned no data");
 
     copy_failed = true;
     set_s3_error("InternalError");
-
-    if (!write_in_progress) {
-      if (copy_parts_fragment) {
-        this->on_failure_for_fragments(vector_index);
-      } else {
-        this->on_failure();
-      }
-    }
+    pump();
     return;
   }
-  // Calculating actial size of data that has just been read
+  // Calculating actual size of data that has just been read
+  size_t bytes_in_chunk_count = 0;
 
-  for (size_t i = 0, n = data_blocks_read.size(); i < n; ++i) {
-    const auto motr_block_size = data_blocks_read[i].second;
+  for (size_t i = 0, n = chunk.data_blocks.size(); i < n; ++i) {
+    const auto motr_block_size = chunk.data_blocks[i].second;
     assert(motr_block_size == size_of_ev_buffer);
 
     // We can use multiplication, but something may change in the future
     bytes_in_chunk_count += motr_block_size;
   }
-  if (bytes_in_chunk_count >= bytes_left_to_read) {
-    s3_log(S3_LOG_DEBUG, request_id,
-           "Too many data has been read. Data left - %zu, got - %zu",
-           bytes_left_to_read, bytes_in_chunk_count);
-    // get_buffers(data_blocks_read, bytes_in_chunk_count, bytes_left_to_read);
-    bytes_in_chunk_count = bytes_left_to_read;
-    bytes_left_to_read = 0;
-  } else {
-    bytes_left_to_read -= bytes_in_chunk_count;
-  }
-
-  s3_log(S3_LOG_DEBUG, request_id, "Got %zu bytes in %zu blocks",
-         bytes_in_chunk_count, data_blocks_read.size());
+  s3_log(S3_LOG_DEBUG, request_id, "Got %zu bytes of chunk %zu in %zu blocks",
+         bytes_in_chunk_count, slot.chunk_index, chunk.data_blocks.size());
 
-  if (!write_in_progress) {
-    // Anyway we have data for writing here and can kick data writing
-    write_data_block();
-
-    if (write_in_progress && bytes_left_to_read) {
-      // Writing has started successfully.
-      // So we have 'space' for reading.
-      assert(data_blocks_read.empty());
-      assert(!p_evbuffer_read);
-
-      read_data_block();
-    }
-  }
+  pump();
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3ObjectDataCopier::read_data_block_failed() {
+void S3ObjectDataCopier::read_data_block_failed(size_t slot_index) {
   s3_log(S3_LOG_INFO, request_id, "%s Entry\n", __func__);
   s3_log(S3_LOG_ERROR, request_id, "Failed to read object data from motr");
 
-  assert(read_in_progress);
-  read_in_progress = false;
+  auto& slot = read_slots[slot_index];
+  assert(slot.read_in_progress);
+  slot.read_in_progress = false;
+  --reads_in_progress;
   copy_failed = true;
 
-  set_s3_error(motr_reader->get_state() == S3MotrReaderOpState::failed_to_launch
+  set_s3_error(slot.motr_reader->get_state() ==
+                       S3MotrReaderOpState::failed_to_launch
                    ? "ServiceUnavailable"
                    : "InternalError");
-  if (!write_in_progress) {
-    if (copy_parts_fragment) {
-      this->on_failure_for_fragments(vector_index);
-    } else {
-      this->on_failure();
-    }
-  }
-
-  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+  pump();
 }
 
 void S3ObjectDataCopier::write_data_block() {
@@ -217,33 +237,30 @@ void S3ObjectDataCopier::write_data_block() {
 
   assert(!write_in_progress);
 
-  assert(!data_blocks_read.empty());
-
-  assert(p_evbuffer_read != nullptr);
+  auto it = chunks_read.find(next_chunk_to_write);
+  if (it == chunks_read.end()) {
+    // Next chunk in order is still being read
+    return;
+  }
+  assert(!it->second.data_blocks.empty());
+  assert(it->second.p_evbuffer != nullptr);
   assert(!p_evbuffer_write);
-  p_evbuffer_write = p_evbuffer_read;
-  p_evbuffer_read = nullptr;
+  p_evbuffer_write = it->second.p_evbuffer;
+  S3BufferSequence data_blocks = std::move(it->second.data_blocks);
+  // Taking the chunk for writing frees a 'slot' for further reading
+  chunks_read.erase(it);
+  ++next_chunk_to_write;
 
-  // We have just separated part of data for writing and
-  // also freed a 'slot' for futher reading
   motr_writer->write_content(
       std::bind(&S3ObjectDataCopier::write_data_block_success, this),
       std::bind(&S3ObjectDataCopier::write_data_block_failed, this),
-      std::move(data_blocks_read), size_of_ev_buffer);
+      std::move(data_blocks), size_of_ev_buffer);
 
   if (motr_writer->get_state() == S3MotrWiterOpState::failed_to_launch) {
     s3_log(S3_LOG_ERROR, request_id, "Write of data block failed to start");
 
     copy_failed = true;
     set_s3_error("ServiceUnavailable");
-
-    if (!read_in_progress) {
-      if (copy_parts_fragment) {
-        this->on_failure_for_fragments(vector_index);
-      } else {
-        this->on_failure();
-      }
-    }
   } else {
     write_in_progress = true;
   }
@@ -264,43 +281,7 @@ void S3ObjectDataCopier::write_data_block_success() {
     s3_log(S3_LOG_DEBUG, nullptr, "Shutdown or rollback");
     return;
   }
-  if (copy_failed) {
-    assert(!read_in_progress);
-    if (copy_parts_fragment) {
-      this->on_failure_for_fragments(vector_index);
-    } else {
-      this->on_failure();
-    }
-    return;
-  }
-  if (!data_blocks_read.empty()) {
-    // We have new chunk of data for writing
-    write_data_block();
-
-    if (copy_failed) {
-      // New writing failed to start
-      return;
-    }
-  }
-  assert(!copy_failed);
-  assert(data_blocks_read.empty());
-
-  if (bytes_left_to_read) {
-
-    if (!read_in_progress) {
-      read_data_block();
-    }
-  } else if (!write_in_progress) {
-    // We have read all source's data but the call of write_data_block()
-    // did not start writing.
-    // It means that the function did not find data ready for writing.
-    // So all data has been written.
-    if (copy_parts_fragment) {
-      this->on_success_for_fragments(vector_index);
-    } else {
-      this->on_success();
-    }
-  }
+  pump();
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -316,14 +297,40 @@ void S3ObjectDataCopier::write_data_block_failed() {
   set_s3_error(motr_writer->get_state() == S3MotrWiterOpState::failed_to_launch
                    ? "ServiceUnavailable"
                    : "InternalError");
-  if (!read_in_progress) {
-    if (copy_parts_fragment) {
-      this->on_failure_for_fragments(vector_index);
-    } else {
-      this->on_failure();
-    }
+  pump();
+}
+
+void S3ObjectDataCopier::start_copy(struct m0_uint128 src_obj_id,
+                                    size_t object_size, int layout_id,
+                                    struct m0_fid pvid) {
+  motr_unit_size =
+      S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(layout_id);
+
+  this->object_size = object_size;
+  chunk_size =
+      motr_unit_size * S3Option::get_instance()->get_motr_units_per_request();
+  chunks_total = (object_size + chunk_size - 1) / chunk_size;
+  next_chunk_to_read = 0;
+  next_chunk_to_write = 0;
+  reads_in_progress = 0;
+
+  pipeline_depth = std::max<size_t>(
+      1, S3Option::get_instance()->get_copy_pipeline_depth());
+  const size_t n_readers = std::min(pipeline_depth, chunks_total);
+  read_slots.clear();
+  read_slots.resize(n_readers);
+  for (auto& slot : read_slots) {
+    slot.motr_reader = motr_reader_factory->create_motr_reader(
+        request_object, src_obj_id, layout_id, pvid, motr_api);
   }
-  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+  s3_log(S3_LOG_DEBUG, request_id,
+         "Copying %zu bytes in %zu chunks with %zu readers", object_size,
+         chunks_total, n_readers);
+
+  copy_failed = false;
+  write_in_progress = false;
+
+  pump();
 }
 
 void S3ObjectDataCopier::copy(
@@ -344,20 +351,7 @@ void S3ObjectDataCopier::copy(
   this->on_success = std::move(on_success);
   this->on_failure = std::move(on_failure);
 
-  motr_unit_size =
-      S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(layout_id);
-
-  motr_reader = motr_reader_factory->create_motr_reader(
-      request_object, src_obj_id, layout_id, pvid, motr_api);
-  motr_reader->set_last_index(0);
-
-  bytes_left_to_read = object_size;
-
-  copy_failed = false;
-  read_in_progress = false;
-  write_in_progress = false;
-
-  read_data_block();
+  start_copy(src_obj_id, object_size, layout_id, pvid);
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
@@ -383,24 +377,11 @@ void S3ObjectDataCopier::copy_part_fragment(
   this->on_failure_for_fragments = std::move(on_failure_for_fragments);
   // Index of the part/fragment info vector
   this->vector_index = index;
-  copy_parts_fragment = true;
-
-  motr_unit_size = S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
-      part_fragment_context_list[index].layout_id);
-
-  motr_reader = motr_reader_factory->create_motr_reader(
-      request_object, part_fragment_context_list[index].motr_OID,
-      part_fragment_context_list[index].layout_id,
-      part_fragment_context_list[index].PVID, motr_api);
-  motr_reader->set_last_index(0);
-
-  bytes_left_to_read = part_fragment_context_list[index].item_size;
-
-  copy_failed = false;
-  read_in_progress = false;
-  write_in_progress = false;
 
-  read_data_block();
+  start_copy(part_fragment_context_list[index].motr_OID,
+             part_fragment_context_list[index].item_size,
+             part_fragment_context_list[index].layout_id,
+             part_fragment_context_list[index].PVID);
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
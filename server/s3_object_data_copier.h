@@ -21,8 +21,10 @@
 
 #include <cstddef>
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest_prod.h>
 
@@ -38,6 +40,18 @@ struct evbuffer;
 
 class S3ObjectDataCopier {
 
+  // Chunk of the source that has been read but not taken for writing yet
+  struct ChunkRead {
+    S3BufferSequence data_blocks;
+    struct evbuffer* p_evbuffer = nullptr;
+  };
+  // Each slot reads one chunk at a time with its own Motr reader
+  struct ReadSlot {
+    std::shared_ptr<S3MotrReader> motr_reader;
+    size_t chunk_index = 0;
+    bool read_in_progress = false;
+  };
+
   std::string request_id;
   std::string s3_error;
 
@@ -51,32 +65,47 @@ class S3ObjectDataCopier {
   std::shared_ptr<S3MotrWiter> motr_writer;
   std::shared_ptr<S3MotrReaderFactory> motr_reader_factory;
   std::shared_ptr<MotrAPI> motr_api;
-  std::shared_ptr<S3MotrReader> motr_reader;
   bool copy_parts_fragment = 0;
   int vector_index;
-  S3BufferSequence data_blocks_read;  // Source's data has been read but not
-                                      // taken for writing.
 
-  // All POD variables should be (re)initialized in This::copy()
-  size_t bytes_left_to_read;
+  // Up to 'pipeline_depth' chunks are read or wait for writing at a time.
+  // Reads may complete out of order, chunks are written in order.
+  std::vector<ReadSlot> read_slots;
+  std::map<size_t, ChunkRead> chunks_read;
+
+  // All POD variables should be (re)initialized in This::start_copy()
+  size_t object_size;
   size_t motr_unit_size;
+  size_t chunk_size;
+  size_t chunks_total;
+  size_t next_chunk_to_read;
+  size_t next_chunk_to_write;
+  size_t reads_in_progress;
+  size_t pipeline_depth;
   bool copy_failed;
-  bool read_in_progress;
   bool write_in_progress;
+  bool in_pump = false;
   // Size of each ev buffer (e.g, 16384)
   size_t size_of_ev_buffer;
 
-  struct evbuffer* p_evbuffer_read = nullptr;
   struct evbuffer* p_evbuffer_write = nullptr;
 
-  void cleanup_blocks_written();
-  void read_data_block();
-  void read_data_block_success();
-  void read_data_block_failed();
+  void start_copy(struct m0_uint128 src_obj_id, size_t object_size,
+                  int layout_id, struct m0_fid pvid);
+  // Starts whatever reads and the write can be started and reports the
+  // result once nothing is in flight. Must be the last call of a callback,
+  // as reporting the result may destroy the copier.
+  void pump();
+  void read_data_blocks();
+  void read_data_block(size_t slot_index);
+  void read_data_block_success(size_t slot_index);
+  void read_data_block_failed(size_t slot_index);
   void write_data_block();
   void write_data_block_success();
   void write_data_block_failed();
   void set_s3_error(std::string);
+  void notify_failure();
+  void notify_success();
 
  public:
   S3ObjectDataCopier(std::shared_ptr<RequestObject> request_object,
@@ -125,4 +154,7 @@ class S3ObjectDataCopier {
               WriteObjectSuccessfulShouldRestartWritingData);
   FRIEND_TEST(S3ObjectDataCopierTest,
               WriteObjectSuccessfulDoNextStepWhenAllIsWritten);
+  FRIEND_TEST(S3ObjectDataCopierTest, ReadsAheadUpToPipelineDepth);
+  FRIEND_TEST(S3ObjectDataCopierTest, OutOfOrderReadWaitsForEarlierChunk);
+  FRIEND_TEST(S3ObjectDataCopierTest, ReadFailureWaitsForWriteInFlight);
 };
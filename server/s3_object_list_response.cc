@@ -21,8 +21,8 @@
 
 #include <evhttp.h>
 #include "s3_object_list_response.h"
-#include "s3_common_utilities.h"
 #include "s3_log.h"
+#include "s3_xml_writer.h"
 
 S3ObjectListResponse::S3ObjectListResponse(const std::string& encoding_type)
     : encoding_type(encoding_type),
@@ -201,103 +201,104 @@ std::string S3ObjectListResponse::get_next_marker_key() {
   return raw_value;
 }
 
+void S3ObjectListResponse::add_key_element(S3XmlWriter& xml, const char* tag,
+                                           const std::string& key_value) {
+  if (encoding_type == "url") {
+    xml.add_element(tag, get_response_format_key_value(key_value));
+  } else {
+    xml.add_element(tag, key_value);
+  }
+}
+
+void S3ObjectListResponse::add_common_prefixes(S3XmlWriter& xml) {
+  for (auto&& prefix : common_prefixes) {
+    xml.open_element("CommonPrefixes");
+    std::string prefix_no_delimiter = prefix;
+    // Remove the delimiter from the end
+    prefix_no_delimiter.pop_back();
+    std::string uri_encode_prefix =
+        get_response_format_key_value(prefix_no_delimiter);
+    // Add the delimiter at the end
+    uri_encode_prefix += request_delimiter;
+    xml.add_element("Prefix", uri_encode_prefix);
+    xml.close_element("CommonPrefixes");
+  }
+}
+
 std::string& S3ObjectListResponse::get_xml(
     const std::string requestor_canonical_id,
     const std::string bucket_owner_user_id,
     const std::string requestor_user_id) {
-  // clang-format off
-  response_xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
-  response_xml +=
-      "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">";
-  response_xml += S3CommonUtilities::format_xml_string("Name", bucket_name);
-  response_xml +=
-      S3CommonUtilities::format_xml_string("Prefix", request_prefix);
+  response_xml.clear();
+  S3XmlWriter xml(response_xml);
+  xml.reserve(XML_SIZE_FIXED + object_list.size() * XML_SIZE_PER_OBJECT +
+              common_prefixes.size() * XML_SIZE_PER_PREFIX);
+
+  xml.add_raw("<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
+  xml.add_raw(
+      "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">");
+  xml.add_element("Name", bucket_name);
+  xml.add_element("Prefix", request_prefix);
   // When 'Delimiter' is specified in the request, the response should have
   // 'Delimiter'
   if (!this->get_request_delimiter().empty()) {
-    response_xml +=
-        S3CommonUtilities::format_xml_string("Delimiter", request_delimiter);
+    xml.add_element("Delimiter", request_delimiter);
   }
   if (encoding_type == "url") {
-    response_xml += S3CommonUtilities::format_xml_string("EncodingType", "url");
+    xml.add_element("EncodingType", "url");
   }
-  response_xml +=
-      S3CommonUtilities::format_xml_string("Marker", request_marker_key);
-  response_xml += S3CommonUtilities::format_xml_string("MaxKeys", max_keys);
+  xml.add_element("Marker", request_marker_key);
+  xml.add_element("MaxKeys", max_keys);
   // When is_truncated is true, the response should have "NextMarker".
   // Refer AWS S3 ListObjects documentation for NextMarker.
   if (this->response_is_truncated) {
-    response_xml +=
-        S3CommonUtilities::format_xml_string("NextMarker", next_marker_key);
+    xml.add_element("NextMarker", next_marker_key);
   }
-  response_xml += S3CommonUtilities::format_xml_string(
-      "IsTruncated", (response_is_truncated ? "true" : "false"));
+  xml.add_element("IsTruncated", response_is_truncated ? "true" : "false");
 
   for (auto&& object : object_list) {
-    response_xml += "<Contents>";
-    response_xml += S3CommonUtilities::format_xml_string(
-        "Key", get_response_format_key_value(object->get_object_name()));
-    response_xml += S3CommonUtilities::format_xml_string(
-        "LastModified", object->get_last_modified_iso());
-    response_xml +=
-        S3CommonUtilities::format_xml_string("ETag", object->get_md5(), true);
-    response_xml += S3CommonUtilities::format_xml_string(
-        "Size", object->get_content_length_str());
-    response_xml += S3CommonUtilities::format_xml_string(
-        "StorageClass", object->get_storage_class());
-    if (requestor_canonical_id == object->get_canonical_id() ||
+    xml.open_element("Contents");
+    add_key_element(xml, "Key", object->get_object_name());
+    xml.add_element("LastModified", object->get_last_modified_iso());
+    xml.add_element("ETag", object->get_md5(), true);
+    xml.add_element("Size", object->get_content_length_str());
+    xml.add_element("StorageClass", object->get_storage_class());
+    const std::string object_canonical_id = object->get_canonical_id();
+    if (requestor_canonical_id == object_canonical_id ||
         bucket_owner_user_id == requestor_user_id) {
-    response_xml += "<Owner>";
-    response_xml +=
-        S3CommonUtilities::format_xml_string("ID", object->get_canonical_id());
-    response_xml += S3CommonUtilities::format_xml_string(
-        "DisplayName", object->get_account_name());
-    response_xml += "</Owner>";
+      xml.open_element("Owner");
+      xml.add_element("ID", object_canonical_id);
+      xml.add_element("DisplayName", object->get_account_name());
+      xml.close_element("Owner");
     }
-    response_xml += "</Contents>";
-  }
-
-  for (auto&& prefix : common_prefixes) {
-    response_xml += "<CommonPrefixes>";
-    std::string prefix_no_delimiter = prefix;
-    // Remove the delimiter from the end
-    prefix_no_delimiter.pop_back();
-    std::string uri_encode_prefix =
-        get_response_format_key_value(prefix_no_delimiter);
-    // Add the delimiter at the end
-    uri_encode_prefix += request_delimiter;
-    response_xml +=
-        S3CommonUtilities::format_xml_string("Prefix", uri_encode_prefix);
-    response_xml += "</CommonPrefixes>";
+    xml.close_element("Contents");
   }
+  add_common_prefixes(xml);
 
-  response_xml += "</ListBucketResult>";
-  // clang-format on
+  xml.add_raw("</ListBucketResult>");
   return response_xml;
 }
 
 std::string& S3ObjectListResponse::get_multiupload_xml() {
-  // clang-format off
-  response_xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
-  response_xml +=
+  response_xml.clear();
+  S3XmlWriter xml(response_xml);
+  xml.reserve(XML_SIZE_FIXED + object_list.size() * XML_SIZE_PER_UPLOAD +
+              common_prefixes.size() * XML_SIZE_PER_PREFIX);
+
+  xml.add_raw("<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
+  xml.add_raw(
       "<ListMultipartUploadsResult "
-      "xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">";
-  response_xml += S3CommonUtilities::format_xml_string("Bucket", bucket_name);
-  response_xml +=
-      S3CommonUtilities::format_xml_string("KeyMarker", request_marker_key);
-  response_xml += S3CommonUtilities::format_xml_string("UploadIdMarker",
-                                                       request_marker_uploadid);
-  response_xml +=
-      S3CommonUtilities::format_xml_string("NextKeyMarker", next_marker_key);
-  response_xml += S3CommonUtilities::format_xml_string("NextUploadIdMarker",
-                                                       next_marker_uploadid);
-  response_xml +=
-      S3CommonUtilities::format_xml_string("MaxUploads", max_uploads);
-  response_xml += S3CommonUtilities::format_xml_string(
-      "IsTruncated", (response_is_truncated ? "true" : "false"));
+      "xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">");
+  xml.add_element("Bucket", bucket_name);
+  xml.add_element("KeyMarker", request_marker_key);
+  xml.add_element("UploadIdMarker", request_marker_uploadid);
+  xml.add_element("NextKeyMarker", next_marker_key);
+  xml.add_element("NextUploadIdMarker", next_marker_uploadid);
+  xml.add_element("MaxUploads", max_uploads);
+  xml.add_element("IsTruncated", response_is_truncated ? "true" : "false");
 
   if (encoding_type == "url") {
-    response_xml += S3CommonUtilities::format_xml_string("EncodingType", "url");
+    xml.add_element("EncodingType", "url");
   }
 
   for (auto&& object : object_list) {
@@ -308,94 +309,77 @@ std::string& S3ObjectListResponse::get_multiupload_xml() {
       // we append |uploadid to object name
       std::size_t pos = object_name.rfind("|");
       if (pos != std::string::npos) {
-        object_name = object_name.substr(0, pos);
+        object_name.resize(pos);
       }
     }
-    response_xml += "<Upload>";
-    response_xml += S3CommonUtilities::format_xml_string(
-        "Key", get_response_format_key_value(object_name));
-    response_xml += S3CommonUtilities::format_xml_string(
-        "UploadId", object->get_upload_id());
-    response_xml += "<Initiator>";
-    response_xml +=
-        S3CommonUtilities::format_xml_string("ID", object->get_user_id());
-    response_xml += S3CommonUtilities::format_xml_string(
-        "DisplayName", object->get_user_name());
-    response_xml += "</Initiator>";
-    response_xml += "<Owner>";
-    response_xml +=
-        S3CommonUtilities::format_xml_string("ID", object->get_user_id());
-    response_xml += S3CommonUtilities::format_xml_string(
-        "DisplayName", object->get_user_name());
-    response_xml += "</Owner>";
-    response_xml += S3CommonUtilities::format_xml_string("StorageClass",
-                                                         get_storage_class());
-    response_xml += S3CommonUtilities::format_xml_string(
-        "Initiated", object->get_last_modified_iso());
-    response_xml += "</Upload>";
+    const std::string user_id = object->get_user_id();
+    const std::string user_name = object->get_user_name();
+
+    xml.open_element("Upload");
+    add_key_element(xml, "Key", object_name);
+    xml.add_element("UploadId", object->get_upload_id());
+    xml.open_element("Initiator");
+    xml.add_element("ID", user_id);
+    xml.add_element("DisplayName", user_name);
+    xml.close_element("Initiator");
+    xml.open_element("Owner");
+    xml.add_element("ID", user_id);
+    xml.add_element("DisplayName", user_name);
+    xml.close_element("Owner");
+    xml.add_element("StorageClass", get_storage_class());
+    xml.add_element("Initiated", object->get_last_modified_iso());
+    xml.close_element("Upload");
   }
 
   for (auto&& prefix : common_prefixes) {
-    response_xml += "<CommonPrefixes>";
-    response_xml += S3CommonUtilities::format_xml_string("Prefix", prefix);
-    response_xml += "</CommonPrefixes>";
+    xml.open_element("CommonPrefixes");
+    xml.add_element("Prefix", prefix);
+    xml.close_element("CommonPrefixes");
   }
 
-  response_xml += "</ListMultipartUploadsResult>";
-  // clang-format on
+  xml.add_raw("</ListMultipartUploadsResult>");
   return response_xml;
 }
 
 std::string& S3ObjectListResponse::get_multipart_xml() {
-  // clang-format off
-  response_xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
-  response_xml +=
-      "<ListPartsResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">";
-  response_xml += S3CommonUtilities::format_xml_string("Bucket", bucket_name);
-  response_xml += S3CommonUtilities::format_xml_string(
-      "Key", get_response_format_key_value(get_object_name()));
-  response_xml +=
-      S3CommonUtilities::format_xml_string("UploadID", get_upload_id());
-  response_xml += "<Initiator>";
-  response_xml += S3CommonUtilities::format_xml_string("ID", get_user_id());
-  response_xml +=
-      S3CommonUtilities::format_xml_string("DisplayName", get_user_name());
-  response_xml += "</Initiator>";
-  response_xml += "<Owner>";
-  response_xml += S3CommonUtilities::format_xml_string("ID", get_account_id());
-  response_xml +=
-      S3CommonUtilities::format_xml_string("DisplayName", get_account_name());
-  response_xml += "</Owner>";
-  response_xml +=
-      S3CommonUtilities::format_xml_string("StorageClass", get_storage_class());
-  response_xml += S3CommonUtilities::format_xml_string("PartNumberMarker",
-                                                       request_marker_key);
-  response_xml += S3CommonUtilities::format_xml_string(
-      "NextPartNumberMarker",
-      (next_marker_key.empty() ? "0" : next_marker_key));
-  response_xml += S3CommonUtilities::format_xml_string("MaxParts", max_parts);
-  response_xml += S3CommonUtilities::format_xml_string(
-      "IsTruncated", (response_is_truncated ? "true" : "false"));
+  response_xml.clear();
+  S3XmlWriter xml(response_xml);
+  xml.reserve(XML_SIZE_FIXED + part_list.size() * XML_SIZE_PER_PART);
+
+  xml.add_raw("<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
+  xml.add_raw(
+      "<ListPartsResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">");
+  xml.add_element("Bucket", bucket_name);
+  add_key_element(xml, "Key", get_object_name());
+  xml.add_element("UploadID", get_upload_id());
+  xml.open_element("Initiator");
+  xml.add_element("ID", get_user_id());
+  xml.add_element("DisplayName", get_user_name());
+  xml.close_element("Initiator");
+  xml.open_element("Owner");
+  xml.add_element("ID", get_account_id());
+  xml.add_element("DisplayName", get_account_name());
+  xml.close_element("Owner");
+  xml.add_element("StorageClass", get_storage_class());
+  xml.add_element("PartNumberMarker", request_marker_key);
+  xml.add_element("NextPartNumberMarker",
+                  next_marker_key.empty() ? "0" : next_marker_key);
+  xml.add_element("MaxParts", max_parts);
+  xml.add_element("IsTruncated", response_is_truncated ? "true" : "false");
 
   if (encoding_type == "url") {
-    response_xml += S3CommonUtilities::format_xml_string("EncodingType", "url");
+    xml.add_element("EncodingType", "url");
   }
 
   for (auto&& part : part_list) {
-    response_xml += "<Part>";
-    response_xml += S3CommonUtilities::format_xml_string(
-        "PartNumber", part.second->get_part_number());
-    response_xml += S3CommonUtilities::format_xml_string(
-        "LastModified", part.second->get_last_modified_iso());
-    response_xml += S3CommonUtilities::format_xml_string(
-        "ETag", part.second->get_md5(), true);
-    response_xml += S3CommonUtilities::format_xml_string(
-        "Size", part.second->get_content_length_str());
-    response_xml += "</Part>";
+    xml.open_element("Part");
+    xml.add_element("PartNumber", part.second->get_part_number());
+    xml.add_element("LastModified", part.second->get_last_modified_iso());
+    xml.add_element("ETag", part.second->get_md5(), true);
+    xml.add_element("Size", part.second->get_content_length_str());
+    xml.close_element("Part");
   }
 
-  response_xml += "</ListPartsResult>";
-  // clang-format on
-
+  xml.add_raw("</ListPartsResult>");
   return response_xml;
 }
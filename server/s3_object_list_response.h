@@ -31,6 +31,7 @@
 
 #include "s3_object_metadata.h"
 #include "s3_part_metadata.h"
+#include "s3_xml_writer.h"
 
 class S3ObjectListResponse {
   // value can be url or empty string
@@ -62,6 +63,17 @@ class S3ObjectListResponse {
   std::string response_xml;
 
   std::string get_response_format_key_value(const std::string& key_value);
+  // Adds element with the key name in the requested encoding
+  void add_key_element(S3XmlWriter& xml, const char* tag,
+                       const std::string& key_value);
+  void add_common_prefixes(S3XmlWriter& xml);
+
+  // Estimated sizes of xml parts, to allocate the response at once
+  static const size_t XML_SIZE_FIXED = 1024;
+  static const size_t XML_SIZE_PER_OBJECT = 384;
+  static const size_t XML_SIZE_PER_UPLOAD = 512;
+  static const size_t XML_SIZE_PER_PART = 256;
+  static const size_t XML_SIZE_PER_PREFIX = 96;
 
  public:
   S3ObjectListResponse(const std::string& encoding_type = "");
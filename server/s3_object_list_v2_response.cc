@@ -20,8 +20,8 @@
 
 #include <evhttp.h>
 #include "s3_object_list_v2_response.h"
-#include "s3_common_utilities.h"
 #include "s3_log.h"
+#include "s3_xml_writer.h"
 
 S3ObjectListResponseV2::S3ObjectListResponseV2(const std::string& encoding_type)
     : S3ObjectListResponse(encoding_type),
@@ -51,83 +51,60 @@ std::string& S3ObjectListResponseV2::get_xml(
     const std::string& requestor_canonical_id,
     const std::string& bucket_owner_user_id,
     const std::string& requestor_user_id) {
-  // clang-format off
-  response_xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
-  response_xml +=
-      "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">";
-  response_xml += S3CommonUtilities::format_xml_string("Name", bucket_name);
-  response_xml +=
-      S3CommonUtilities::format_xml_string("Prefix", request_prefix);
+  response_xml.clear();
+  S3XmlWriter xml(response_xml);
+  xml.reserve(XML_SIZE_FIXED + object_list.size() * XML_SIZE_PER_OBJECT +
+              common_prefixes.size() * XML_SIZE_PER_PREFIX);
+
+  xml.add_raw("<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
+  xml.add_raw(
+      "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">");
+  xml.add_element("Name", bucket_name);
+  xml.add_element("Prefix", request_prefix);
   // When 'Delimiter' is specified in the request, the response should have
   // 'Delimiter'
   if (!this->get_request_delimiter().empty()) {
-    response_xml +=
-        S3CommonUtilities::format_xml_string("Delimiter", request_delimiter);
+    xml.add_element("Delimiter", request_delimiter);
   }
   if (encoding_type == "url") {
-    response_xml += S3CommonUtilities::format_xml_string("EncodingType", "url");
+    xml.add_element("EncodingType", "url");
   }
-  response_xml += S3CommonUtilities::format_xml_string("KeyCount", key_count);
+  xml.add_element("KeyCount", key_count);
   // If 'continuation-token' specified in original request, include it in the
   // response
   if (cont_token_specified) {
-    response_xml += S3CommonUtilities::format_xml_string("ContinuationToken",
-                                                         continuation_token);
+    xml.add_element("ContinuationToken", continuation_token);
   }
-  response_xml += S3CommonUtilities::format_xml_string("MaxKeys", max_keys);
+  xml.add_element("MaxKeys", max_keys);
   // When is_truncated is true, the response should have
   // "NextContinuationToken".
   // Refer AWS S3 ListObjects V2 documentation for NextContinuationToken.
   if (this->response_is_truncated) {
-    response_xml += S3CommonUtilities::format_xml_string(
-        "NextContinuationToken", next_marker_key);
+    xml.add_element("NextContinuationToken", next_marker_key);
   }
   // If 'start-after' specified in request, include it in response
   if (!start_after.empty()) {
-    response_xml +=
-        S3CommonUtilities::format_xml_string("StartAfter", start_after);
+    xml.add_element("StartAfter", start_after);
   }
-  response_xml += S3CommonUtilities::format_xml_string(
-      "IsTruncated", (response_is_truncated ? "true" : "false"));
+  xml.add_element("IsTruncated", response_is_truncated ? "true" : "false");
 
   for (auto&& object : object_list) {
-    response_xml += "<Contents>";
-    response_xml += S3CommonUtilities::format_xml_string(
-        "Key", get_response_format_key_value(object->get_object_name()));
-    response_xml += S3CommonUtilities::format_xml_string(
-        "LastModified", object->get_last_modified_iso());
-    response_xml +=
-        S3CommonUtilities::format_xml_string("ETag", object->get_md5(), true);
-    response_xml += S3CommonUtilities::format_xml_string(
-        "Size", object->get_content_length_str());
-    response_xml += S3CommonUtilities::format_xml_string(
-        "StorageClass", object->get_storage_class());
+    xml.open_element("Contents");
+    add_key_element(xml, "Key", object->get_object_name());
+    xml.add_element("LastModified", object->get_last_modified_iso());
+    xml.add_element("ETag", object->get_md5(), true);
+    xml.add_element("Size", object->get_content_length_str());
+    xml.add_element("StorageClass", object->get_storage_class());
     if (this->fetch_owner) {
-      response_xml += "<Owner>";
-      response_xml += S3CommonUtilities::format_xml_string(
-          "ID", object->get_canonical_id());
-      response_xml += S3CommonUtilities::format_xml_string(
-          "DisplayName", object->get_account_name());
-      response_xml += "</Owner>";
+      xml.open_element("Owner");
+      xml.add_element("ID", object->get_canonical_id());
+      xml.add_element("DisplayName", object->get_account_name());
+      xml.close_element("Owner");
     }
-    response_xml += "</Contents>";
-  }
-
-  for (auto&& prefix : common_prefixes) {
-    response_xml += "<CommonPrefixes>";
-    std::string prefix_no_delimiter = prefix;
-    // Remove the delimiter from the end
-    prefix_no_delimiter.pop_back();
-    std::string uri_encode_prefix =
-        get_response_format_key_value(prefix_no_delimiter);
-    // Add the delimiter at the end
-    uri_encode_prefix += request_delimiter;
-    response_xml +=
-        S3CommonUtilities::format_xml_string("Prefix", uri_encode_prefix);
-    response_xml += "</CommonPrefixes>";
+    xml.close_element("Contents");
   }
+  add_common_prefixes(xml);
 
-  response_xml += "</ListBucketResult>";
-  // clang-format on
+  xml.add_raw("</ListBucketResult>");
   return response_xml;
 }
@@ -28,7 +28,9 @@
 #include "s3_factory.h"
 #include "s3_iem.h"
 #include "s3_log.h"
+#include "s3_metadata_codec.h"
 #include "s3_object_metadata.h"
+#include "s3_object_metadata_cache.h"
 #include "s3_object_versioning_helper.h"
 #include "s3_uri_to_motr_oid.h"
 #include "s3_common_utilities.h"
@@ -412,10 +414,31 @@ void S3ObjectMetadata::load(std::function<void(void)> on_success,
 
   state = S3ObjectMetadataState::empty;
 
-  motr_kv_reader =
-      motr_kv_reader_factory->create_motr_kvs_reader(request, s3_motr_api);
   requested_bucket_name = bucket_name;
   requested_object_name = object_name;
+
+  // Multipart uploads are short lived and not worth caching
+  S3ObjectMetadataCache* p_cache =
+      is_multipart ? nullptr : S3ObjectMetadataCache::get_instance();
+  if (p_cache) {
+    auto p_cached = p_cache->get(object_list_index_layout.oid, object_name);
+    if (p_cached) {
+      s3_log(S3_LOG_DEBUG, request_id, "Object metadata found in cache\n");
+      copy_loaded_attributes(*p_cached);
+      if (validate_attrs()) {
+        state = S3ObjectMetadataState::present;
+        this->handler_on_success();
+      } else {
+        state = S3ObjectMetadataState::invalid;
+        this->handler_on_failed();
+      }
+      return;
+    }
+    cache_generation =
+        p_cache->get_generation(object_list_index_layout.oid, object_name);
+  }
+  motr_kv_reader =
+      motr_kv_reader_factory->create_motr_kvs_reader(request, s3_motr_api);
   motr_kv_reader->get_keyval(
       object_list_index_layout, object_name,
       std::bind(&S3ObjectMetadata::load_successful, this),
@@ -479,11 +502,65 @@ void S3ObjectMetadata::load_successful() {
     LOG_PERF("load_object_metadata_ms", request_id.c_str(), mss);
     s3_stats_timing("load_object_metadata", mss);
 
+    S3ObjectMetadataCache* p_cache = S3ObjectMetadataCache::get_instance();
+    if (p_cache && !is_multipart) {
+      p_cache->put(object_list_index_layout.oid, object_name, cache_generation,
+                   create_cache_snapshot());
+    }
     state = S3ObjectMetadataState::present;
     this->handler_on_success();
   }
 }
 
+void S3ObjectMetadata::copy_loaded_attributes(const S3ObjectMetadata& src) {
+  bucket_name = src.bucket_name;
+  object_name = src.object_name;
+  object_key_uri = src.object_key_uri;
+  upload_id = src.upload_id;
+  motr_part_layout_str = src.motr_part_layout_str;
+  motr_oid_str = src.motr_oid_str;
+  layout_id = src.layout_id;
+  pvid_str = src.pvid_str;
+  obj_fragments = src.obj_fragments;
+  obj_parts = src.obj_parts;
+  obj_type = src.obj_type;
+  oid = src.oid;
+  motr_old_oid_str = src.motr_old_oid_str;
+  old_oid = src.old_oid;
+  old_layout_id = src.old_layout_id;
+  motr_old_object_version_id = src.motr_old_object_version_id;
+  part_index_layout = src.part_index_layout;
+
+  system_defined_attribute = src.system_defined_attribute;
+  user_defined_attribute = src.user_defined_attribute;
+  object_tags = src.object_tags;
+  encoded_acl = src.encoded_acl;
+
+  user_name = src.user_name;
+  canonical_id = src.canonical_id;
+  user_id = src.user_id;
+  account_name = src.account_name;
+  account_id = src.account_id;
+  object_version_id = src.object_version_id;
+  rev_epoch_version_id_key = src.rev_epoch_version_id_key;
+}
+
+std::shared_ptr<const S3ObjectMetadata>
+S3ObjectMetadata::create_cache_snapshot() const {
+  std::shared_ptr<S3ObjectMetadata> snapshot(new S3ObjectMetadata(*this));
+  snapshot->copy_loaded_attributes(*this);
+  // Cached value must not keep the request alive
+  snapshot->request.reset();
+  return snapshot;
+}
+
+void S3ObjectMetadata::invalidate_cached_metadata() {
+  S3ObjectMetadataCache* p_cache = S3ObjectMetadataCache::get_instance();
+  if (p_cache) {
+    p_cache->invalidate(object_list_index_layout.oid, object_name);
+  }
+}
+
 void S3ObjectMetadata::load_failed() {
   switch (motr_kv_reader->get_state()) {
     case S3MotrKVSReaderOpState::failed_to_launch:
@@ -614,10 +691,15 @@ void S3ObjectMetadata::save_metadata() {
   // object_list_index_layout should be set before using this method
   assert(non_zero(object_list_index_layout.oid));
 
+  invalidate_cached_metadata();
+
   motr_kv_writer =
       mote_kv_writer_factory->create_motr_kvs_writer(request, s3_motr_api);
   motr_kv_writer->put_keyval(
-      object_list_index_layout, object_name, this->to_json(),
+      object_list_index_layout, object_name,
+      S3Option::get_instance()->is_metadata_binary_encoding_enabled()
+          ? this->to_binary()
+          : this->to_json(),
       std::bind(&S3ObjectMetadata::save_metadata_successful, this),
       std::bind(&S3ObjectMetadata::save_metadata_failed, this));
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
@@ -636,6 +718,8 @@ void S3ObjectMetadata::save_metadata(std::function<void(void)> on_success,
 void S3ObjectMetadata::save_metadata_successful() {
   s3_log(S3_LOG_DEBUG, request_id, "Object metadata saved for Object [%s].\n",
          object_name.c_str());
+  // Loads launched while the entry was being written could cache old value
+  invalidate_cached_metadata();
   state = S3ObjectMetadataState::saved;
   this->handler_on_success();
 }
@@ -643,6 +727,8 @@ void S3ObjectMetadata::save_metadata_successful() {
 void S3ObjectMetadata::save_metadata_failed() {
   s3_log(S3_LOG_ERROR, request_id,
          "Object metadata save failed for Object [%s].\n", object_name.c_str());
+  // The entry might have been written nevertheless
+  invalidate_cached_metadata();
   if (motr_kv_writer->get_state() == S3MotrKVSWriterOpState::failed_to_launch) {
     state = S3ObjectMetadataState::failed_to_launch;
   } else {
@@ -667,6 +753,8 @@ void S3ObjectMetadata::remove_object_metadata() {
   // object_list_index_layout should be set before using this method
   assert(non_zero(object_list_index_layout.oid));
 
+  invalidate_cached_metadata();
+
   motr_kv_writer =
       mote_kv_writer_factory->create_motr_kvs_writer(request, s3_motr_api);
   motr_kv_writer->delete_keyval(
@@ -678,6 +766,7 @@ void S3ObjectMetadata::remove_object_metadata() {
 void S3ObjectMetadata::remove_object_metadata_successful() {
   s3_log(S3_LOG_DEBUG, request_id, "Deleted metadata for Object [%s].\n",
          object_name.c_str());
+  invalidate_cached_metadata();
   if (is_multipart) {
     // In multipart, version entry is not yet created.
     state = S3ObjectMetadataState::deleted;
@@ -691,6 +780,7 @@ void S3ObjectMetadata::remove_object_metadata_failed() {
   s3_log(S3_LOG_DEBUG, request_id,
          "Delete Object metadata failed for Object [%s].\n",
          object_name.c_str());
+  invalidate_cached_metadata();
   if (motr_kv_writer->get_state() == S3MotrKVSWriterOpState::failed_to_launch) {
     state = S3ObjectMetadataState::failed_to_launch;
   } else {
@@ -848,6 +938,9 @@ std::string S3ObjectMetadata::version_entry_to_json() {
  */
 
 int S3ObjectMetadata::from_json(std::string content) {
+  if (S3MetadataDecoder::is_binary(content)) {
+    return from_binary(content);
+  }
   s3_log(S3_LOG_DEBUG, request_id, "Called with content [%s]\n",
          content.c_str());
   Json::Value newroot;
@@ -879,18 +972,7 @@ int S3ObjectMetadata::from_json(std::string content) {
     obj_parts = newroot["PRTS"].asUInt();
     // primary_obj_size = newroot["Size"].asUInt();
   }
-
-  if (obj_fragments != 0 && obj_parts != 0 && (obj_fragments == obj_parts)) {
-    // In case of multipart upload, no. of fragments == no. of parts
-    obj_type = S3ObjectMetadataType::only_parts;
-  } else if (obj_fragments != 0 && obj_parts == 0) {
-    obj_type = S3ObjectMetadataType::only_frgments;
-  } else if (obj_fragments != 0 && obj_parts != 0 &&
-             (obj_fragments > obj_parts)) {
-    // In case of multipart upload with some parts with fragmented object,
-    // no. of fragments > no. of parts
-    obj_type = S3ObjectMetadataType::parts_fragments;
-  }
+  set_object_type();
 
   oid = S3M0Uint128Helper::to_m0_uint128(motr_oid_str);
 
@@ -914,14 +996,7 @@ int S3ObjectMetadata::from_json(std::string content) {
     system_defined_attribute[it.c_str()] =
         newroot["System-Defined"][it].asString().c_str();
   }
-  user_name = system_defined_attribute["Owner-User"];
-  canonical_id = system_defined_attribute["Owner-Canonical-id"];
-  user_id = system_defined_attribute["Owner-User-id"];
-  account_name = system_defined_attribute["Owner-Account"];
-  account_id = system_defined_attribute["Owner-Account-id"];
-  object_version_id = system_defined_attribute["x-amz-version-id"];
-  rev_epoch_version_id_key =
-      S3ObjectVersioingHelper::generate_keyid_from_versionid(object_version_id);
+  set_owner_attributes();
 
   members = newroot["User-Defined"].getMemberNames();
   for (auto it : members) {
@@ -937,6 +1012,230 @@ int S3ObjectMetadata::from_json(std::string content) {
   return 0;
 }
 
+void S3ObjectMetadata::set_object_type() {
+  if (obj_fragments != 0 && obj_parts != 0 && (obj_fragments == obj_parts)) {
+    // In case of multipart upload, no. of fragments == no. of parts
+    obj_type = S3ObjectMetadataType::only_parts;
+  } else if (obj_fragments != 0 && obj_parts == 0) {
+    obj_type = S3ObjectMetadataType::only_frgments;
+  } else if (obj_fragments != 0 && obj_parts != 0 &&
+             (obj_fragments > obj_parts)) {
+    // In case of multipart upload with some parts with fragmented object,
+    // no. of fragments > no. of parts
+    obj_type = S3ObjectMetadataType::parts_fragments;
+  }
+}
+
+void S3ObjectMetadata::set_owner_attributes() {
+  user_name = system_defined_attribute["Owner-User"];
+  canonical_id = system_defined_attribute["Owner-Canonical-id"];
+  user_id = system_defined_attribute["Owner-User-id"];
+  account_name = system_defined_attribute["Owner-Account"];
+  account_id = system_defined_attribute["Owner-Account-id"];
+  object_version_id = system_defined_attribute["x-amz-version-id"];
+  rev_epoch_version_id_key =
+      S3ObjectVersioingHelper::generate_keyid_from_versionid(object_version_id);
+}
+
+// Field tags of binary encoded object metadata, must never be reused
+enum S3ObjectMetadataField : unsigned {
+  OBJ_FIELD_BUCKET_NAME = 1,
+  OBJ_FIELD_OBJECT_NAME = 2,
+  OBJ_FIELD_OBJECT_URI = 3,
+  OBJ_FIELD_LAYOUT_ID = 4,
+  OBJ_FIELD_UPLOAD_ID = 5,
+  OBJ_FIELD_PART_LAYOUT = 6,
+  OBJ_FIELD_OLD_OID = 7,
+  OBJ_FIELD_OLD_LAYOUT_ID = 8,
+  OBJ_FIELD_OLD_VERSION_ID = 9,
+  OBJ_FIELD_OID = 10,
+  OBJ_FIELD_PVID = 11,
+  OBJ_FIELD_FRAGMENTS = 12,
+  OBJ_FIELD_PARTS = 13,
+  OBJ_FIELD_SYSTEM_DEFINED = 14,
+  OBJ_FIELD_USER_DEFINED = 15,
+  OBJ_FIELD_TAGS = 16,
+  OBJ_FIELD_ACL = 17,
+  OBJ_FIELD_CREATE_TIMESTAMP = 18
+};
+
+std::string S3ObjectMetadata::to_binary() {
+  s3_log(S3_LOG_DEBUG, request_id, "Called\n");
+  S3MetadataEncoder encoder(S3MetadataRecordType::object);
+
+  if (s3_di_fi_is_enabled("di_metadata_bcktname_on_write_corrupted")) {
+    encoder.add(OBJ_FIELD_BUCKET_NAME, "@" + bucket_name + "@");
+  } else {
+    encoder.add(OBJ_FIELD_BUCKET_NAME, bucket_name);
+  }
+  if (s3_di_fi_is_enabled("di_metadata_objname_on_write_corrupted")) {
+    encoder.add(OBJ_FIELD_OBJECT_NAME, "@" + object_name + "@");
+  } else {
+    encoder.add(OBJ_FIELD_OBJECT_NAME, object_name);
+  }
+  encoder.add(OBJ_FIELD_OBJECT_URI, object_key_uri);
+  encoder.add_int(OBJ_FIELD_LAYOUT_ID, layout_id);
+
+  // OIDs and layouts are stored as is, not base64 encoded.
+  // Empty field means the string form was empty.
+  if (is_multipart) {
+    encoder.add(OBJ_FIELD_UPLOAD_ID, upload_id);
+    if (motr_part_layout_str.empty()) {
+      encoder.add(OBJ_FIELD_PART_LAYOUT, "");
+    } else {
+      encoder.add_raw(OBJ_FIELD_PART_LAYOUT, part_index_layout);
+    }
+    if (motr_old_oid_str.empty()) {
+      encoder.add(OBJ_FIELD_OLD_OID, "");
+    } else {
+      encoder.add_raw(OBJ_FIELD_OLD_OID, old_oid);
+    }
+    encoder.add_int(OBJ_FIELD_OLD_LAYOUT_ID, old_layout_id);
+    encoder.add(OBJ_FIELD_OLD_VERSION_ID, motr_old_object_version_id);
+  }
+  if (motr_oid_str.empty()) {
+    encoder.add(OBJ_FIELD_OID, "");
+  } else {
+    encoder.add_raw(OBJ_FIELD_OID, oid);
+  }
+  encoder.add(OBJ_FIELD_PVID, pvid_str);
+  encoder.add_uint(OBJ_FIELD_FRAGMENTS, obj_fragments);
+  encoder.add_uint(OBJ_FIELD_PARTS, obj_parts);
+
+  if (s3_di_fi_is_enabled("di_obj_md5_corrupted")) {
+    auto attrs = system_defined_attribute;
+    // MD5 of empty string - md5("")
+    attrs["Content-MD5"] = "d41d8cd98f00b204e9800998ecf8427e";
+    encoder.add_map(OBJ_FIELD_SYSTEM_DEFINED, attrs);
+  } else {
+    encoder.add_map(OBJ_FIELD_SYSTEM_DEFINED, system_defined_attribute);
+  }
+  encoder.add_map(OBJ_FIELD_USER_DEFINED, user_defined_attribute);
+  encoder.add_map(OBJ_FIELD_TAGS, object_tags);
+  encoder.add(OBJ_FIELD_ACL,
+              encoded_acl.empty() ? request->get_default_acl() : encoded_acl);
+
+  S3DateTime current_time;
+  current_time.init_current_time();
+  encoder.add(OBJ_FIELD_CREATE_TIMESTAMP, current_time.get_isoformat_string());
+
+  return std::move(encoder.get_buffer());
+}
+
+int S3ObjectMetadata::from_binary(const std::string& content) {
+  s3_log(S3_LOG_DEBUG, request_id, "Called with binary content, %zu bytes\n",
+         content.size());
+  S3MetadataDecoder decoder(content, S3MetadataRecordType::object);
+  S3MetadataField field;
+  unsigned tag;
+  int64_t int_value;
+  uint64_t uint_value;
+  bool ok = true;
+
+  // Same defaults as for JSON without corresponding members
+  upload_id.clear();
+  motr_part_layout_str.clear();
+  part_index_layout = {};
+  if (is_multipart) {
+    motr_old_oid_str.clear();
+    old_oid = {};
+  }
+  motr_oid_str.clear();
+  oid = {};
+
+  while (ok && decoder.next(tag, field)) {
+    switch (tag) {
+      case OBJ_FIELD_BUCKET_NAME:
+        bucket_name = field.to_string();
+        break;
+      case OBJ_FIELD_OBJECT_NAME:
+        object_name = field.to_string();
+        break;
+      case OBJ_FIELD_OBJECT_URI:
+        object_key_uri = field.to_string();
+        break;
+      case OBJ_FIELD_LAYOUT_ID:
+        ok = field.to_int(int_value);
+        layout_id = static_cast<int>(int_value);
+        break;
+      case OBJ_FIELD_UPLOAD_ID:
+        upload_id = field.to_string();
+        break;
+      case OBJ_FIELD_PART_LAYOUT:
+        if (field.size) {
+          ok = field.copy_to(part_index_layout);
+          motr_part_layout_str =
+              S3M0Uint128Helper::to_string(part_index_layout);
+        }
+        break;
+      case OBJ_FIELD_OLD_OID:
+        if (is_multipart && field.size) {
+          ok = field.copy_to(old_oid);
+          motr_old_oid_str = S3M0Uint128Helper::to_string(old_oid);
+        }
+        break;
+      case OBJ_FIELD_OLD_LAYOUT_ID:
+        if (is_multipart) {
+          ok = field.to_int(int_value);
+          old_layout_id = static_cast<int>(int_value);
+        }
+        break;
+      case OBJ_FIELD_OLD_VERSION_ID:
+        if (is_multipart) {
+          motr_old_object_version_id = field.to_string();
+        }
+        break;
+      case OBJ_FIELD_OID:
+        if (field.size) {
+          ok = field.copy_to(oid);
+          motr_oid_str = S3M0Uint128Helper::to_string(oid);
+        }
+        break;
+      case OBJ_FIELD_PVID:
+        pvid_str = field.to_string();
+        break;
+      case OBJ_FIELD_FRAGMENTS:
+        ok = field.to_uint(uint_value);
+        obj_fragments = static_cast<unsigned>(uint_value);
+        break;
+      case OBJ_FIELD_PARTS:
+        ok = field.to_uint(uint_value);
+        obj_parts = static_cast<unsigned>(uint_value);
+        break;
+      case OBJ_FIELD_SYSTEM_DEFINED:
+        ok = field.to_map(system_defined_attribute);
+        break;
+      case OBJ_FIELD_USER_DEFINED:
+        ok = field.to_map(user_defined_attribute);
+        break;
+      case OBJ_FIELD_TAGS:
+        ok = field.to_map(object_tags);
+        break;
+      case OBJ_FIELD_ACL:
+        encoded_acl = field.to_string();
+        break;
+      default:
+        // Written by newer version or not needed, e.g. create timestamp
+        break;
+    }
+  }
+  if (!ok || !decoder.is_valid() ||
+      s3_di_fi_is_enabled("object_metadata_corrupted")) {
+    s3_log(S3_LOG_ERROR, request_id, "Binary metadata parsing failed\n");
+    return -1;
+  }
+  if (s3_di_fi_is_enabled("di_metadata_bcktname_on_read_corrupted")) {
+    bucket_name = "@" + bucket_name + "@";
+  }
+  if (s3_di_fi_is_enabled("di_metadata_objname_on_read_corrupted")) {
+    object_name = "@" + object_name + "@";
+  }
+  set_object_type();
+  set_owner_attributes();
+
+  return 0;
+}
+
 void S3ObjectMetadata::acl_from_json(std::string acl_json_str) {
   s3_log(S3_LOG_DEBUG, "", "Called\n");
   encoded_acl = acl_json_str;
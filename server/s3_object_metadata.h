@@ -354,9 +354,12 @@ class S3ObjectMetadata : private S3ObjectMetadataCopyable {
 
   // For object metadata in object listing
   std::string to_json();
+  // Compact alternative to to_json(), see s3_metadata_codec.h
+  std::string to_binary();
   // For storing minimal version entry in version listing
   std::string version_entry_to_json();
 
+  // Accepts both JSON and binary encoded metadata.
   // returns 0 on success, -1 on parsing error.
   virtual int from_json(std::string content);
   virtual void setacl(const std::string& input_acl);
@@ -403,6 +406,20 @@ class S3ObjectMetadata : private S3ObjectMetadataCopyable {
   // Validate just read metadata
   bool validate_attrs();
 
+  int from_binary(const std::string& content);
+  // Set attributes which are derived from the loaded ones
+  void set_object_type();
+  void set_owner_attributes();
+
+  // Object metadata cache support.
+  // Copies attributes which are stored in the object list index entry.
+  void copy_loaded_attributes(const S3ObjectMetadata& src);
+  std::shared_ptr<const S3ObjectMetadata> create_cache_snapshot() const;
+  // Drops the object list index entry from the cache, if any
+  void invalidate_cached_metadata();
+  // Taken before reading the entry from the object list index
+  uint64_t cache_generation = 0;
+
  public:
   // Google tests.
   FRIEND_TEST(S3ObjectMetadataTest, ConstructorTest);
@@ -416,6 +433,9 @@ class S3ObjectMetadata : private S3ObjectMetadataCopyable {
   FRIEND_TEST(S3ObjectMetadataTest, AddUserDefinedAttribute);
   FRIEND_TEST(S3ObjectMetadataTest, Load);
   FRIEND_TEST(S3ObjectMetadataTest, LoadSuccessful);
+  FRIEND_TEST(S3ObjectMetadataTest, LoadFromObjectMetadataCache);
+  FRIEND_TEST(S3ObjectMetadataTest, ToBinaryFromBinary);
+  FRIEND_TEST(S3MultipartObjectMetadataTest, ToBinaryFromBinary);
   FRIEND_TEST(S3ObjectMetadataTest, LoadMetadataFail);
   FRIEND_TEST(S3ObjectMetadataTest, LoadSuccessInvalidJson);
   FRIEND_TEST(S3ObjectMetadataTest, LoadSuccessfulInvalidJson);
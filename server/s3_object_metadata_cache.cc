@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <cinttypes>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "s3_log.h"
+#include "s3_object_metadata.h"
+#include "s3_object_metadata_cache.h"
+#include "s3_stats.h"
+
+S3ObjectMetadataCache* S3ObjectMetadataCache::p_instance;
+
+struct S3ObjectMetadataCache::Shard {
+  struct Entry {
+    std::shared_ptr<const S3ObjectMetadata> value;
+    std::chrono::steady_clock::time_point load_time;
+    // Position in 'lru', most recently used at the front
+    std::list<std::string>::iterator lru_pos;
+  };
+  mutable std::mutex lock;
+  std::unordered_map<std::string, Entry> entries;
+  std::list<std::string> lru;
+  uint64_t generation = 0;
+  size_t max_size = 0;
+};
+
+S3ObjectMetadataCache::S3ObjectMetadataCache(size_t max_cache_size,
+                                             unsigned expire_interval_sec,
+                                             unsigned n_shards)
+    : max_cache_size(max_cache_size),
+      expire_interval(std::chrono::seconds(expire_interval_sec)),
+      n_shards(n_shards ? n_shards : 1),
+      shards(new Shard[this->n_shards]) {
+
+  s3_log(S3_LOG_INFO, "",
+         "%s Object metadata cache: max size %zu, expire %u sec, %u shards\n",
+         __func__, max_cache_size, expire_interval_sec, this->n_shards);
+
+  const size_t shard_size = max_cache_size / this->n_shards;
+  for (unsigned i = 0; i < this->n_shards; ++i) {
+    shards[i].max_size = (i < max_cache_size % this->n_shards) ? shard_size + 1
+                                                               : shard_size;
+  }
+  if (!p_instance) {
+    p_instance = this;
+  }
+}
+
+S3ObjectMetadataCache::~S3ObjectMetadataCache() {
+  s3_log(S3_LOG_INFO, "",
+         "%s Object metadata cache: %" PRIu64 " hits, %" PRIu64
+         " misses, %" PRIu64 " expirations, %" PRIu64
+         " invalidations, %" PRIu64 " evictions\n",
+         __func__, counters.hits.load(), counters.misses.load(),
+         counters.expirations.load(), counters.invalidations.load(),
+         counters.evictions.load());
+  if (p_instance == this) {
+    p_instance = nullptr;
+  }
+}
+
+std::string S3ObjectMetadataCache::make_key(const struct m0_uint128& index_oid,
+                                            const std::string& object_name) {
+  std::string key;
+  key.reserve(sizeof(index_oid) + object_name.length());
+  key.append(reinterpret_cast<const char*>(&index_oid), sizeof(index_oid));
+  key.append(object_name);
+  return key;
+}
+
+S3ObjectMetadataCache::Shard& S3ObjectMetadataCache::get_shard(
+    const std::string& key) const {
+  return shards[std::hash<std::string>()(key) % n_shards];
+}
+
+uint64_t S3ObjectMetadataCache::get_generation(
+    const struct m0_uint128& index_oid, const std::string& object_name) const {
+  const Shard& shard = get_shard(make_key(index_oid, object_name));
+  std::lock_guard<std::mutex> guard(shard.lock);
+  return shard.generation;
+}
+
+std::shared_ptr<const S3ObjectMetadata> S3ObjectMetadataCache::get(
+    const struct m0_uint128& index_oid, const std::string& object_name) {
+  const std::string key = make_key(index_oid, object_name);
+  Shard& shard = get_shard(key);
+  std::shared_ptr<const S3ObjectMetadata> value;
+  {
+    std::lock_guard<std::mutex> guard(shard.lock);
+    auto it = shard.entries.find(key);
+
+    if (it != shard.entries.end()) {
+      auto& entry = it->second;
+
+      if (std::chrono::steady_clock::now() - entry.load_time <
+          expire_interval) {
+        shard.lru.splice(shard.lru.begin(), shard.lru, entry.lru_pos);
+        value = entry.value;
+      } else {
+        shard.lru.erase(entry.lru_pos);
+        shard.entries.erase(it);
+        --n_items;
+        ++counters.expirations;
+      }
+    }
+  }
+  if (value) {
+    ++counters.hits;
+    s3_stats_inc("object_metadata_cache_hit_count");
+  } else {
+    ++counters.misses;
+    s3_stats_inc("object_metadata_cache_miss_count");
+  }
+  return value;
+}
+
+bool S3ObjectMetadataCache::put(const struct m0_uint128& index_oid,
+                                const std::string& object_name,
+                                uint64_t generation,
+                                std::shared_ptr<const S3ObjectMetadata> value) {
+  std::string key = make_key(index_oid, object_name);
+  Shard& shard = get_shard(key);
+  std::lock_guard<std::mutex> guard(shard.lock);
+
+  if (shard.generation != generation || !shard.max_size) {
+    return false;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  auto it = shard.entries.find(key);
+
+  if (it != shard.entries.end()) {
+    it->second.value = std::move(value);
+    it->second.load_time = now;
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_pos);
+    return true;
+  }
+  while (shard.entries.size() >= shard.max_size) {
+    shard.entries.erase(shard.lru.back());
+    shard.lru.pop_back();
+    --n_items;
+    ++counters.evictions;
+  }
+  shard.lru.push_front(key);
+  shard.entries.emplace(std::move(key),
+                        Shard::Entry{std::move(value), now, shard.lru.begin()});
+  ++n_items;
+  return true;
+}
+
+void S3ObjectMetadataCache::invalidate(const struct m0_uint128& index_oid,
+                                       const std::string& object_name) {
+  const std::string key = make_key(index_oid, object_name);
+  Shard& shard = get_shard(key);
+  std::lock_guard<std::mutex> guard(shard.lock);
+
+  ++shard.generation;
+  auto it = shard.entries.find(key);
+
+  if (it != shard.entries.end()) {
+    shard.lru.erase(it->second.lru_pos);
+    shard.entries.erase(it);
+    --n_items;
+    ++counters.invalidations;
+  }
+}
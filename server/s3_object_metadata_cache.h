@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_OBJECT_METADATA_CACHE_H__
+#define __S3_SERVER_S3_OBJECT_METADATA_CACHE_H__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "s3_motr_context.h"
+
+class S3ObjectMetadata;
+
+// Process-wide cache of already parsed object metadata, keyed by
+// object list index OID and object name.
+//
+// Values are immutable snapshots, so a hit costs a map lookup and a copy of
+// the snapshot attributes instead of a KVS round trip and JSON parsing.
+// The cache is shared by all reactors; every shard has its own mutex.
+//
+// Writers of the object list index (PUT, DELETE, complete multipart upload)
+// invalidate the key when the KVS operation is launched and again when it
+// completes. Every invalidation bumps the shard generation; a load which
+// started before an invalidation does not insert its (possibly stale) result.
+// Other s3server processes do not invalidate this cache, so entries are
+// dropped after expire_interval_sec regardless of use. Size limit is split
+// evenly among shards, each shard evicts its least recently used entries.
+class S3ObjectMetadataCache {
+
+  static S3ObjectMetadataCache* p_instance;
+
+ public:
+  struct Counters {
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> expirations{0};
+    std::atomic<uint64_t> invalidations{0};
+    std::atomic<uint64_t> evictions{0};
+  };
+
+  S3ObjectMetadataCache(size_t max_cache_size, unsigned expire_interval_sec,
+                        unsigned n_shards = 1);
+
+  S3ObjectMetadataCache(const S3ObjectMetadataCache&) = delete;
+  S3ObjectMetadataCache& operator=(const S3ObjectMetadataCache&) = delete;
+
+  ~S3ObjectMetadataCache();
+
+  // Returns nullptr when the cache is not configured
+  static S3ObjectMetadataCache* get_instance() { return p_instance; }
+
+  // Generation of the shard the key belongs to; should be taken before
+  // the metadata is read from the KVS and passed to put().
+  uint64_t get_generation(const struct m0_uint128& index_oid,
+                          const std::string& object_name) const;
+
+  std::shared_ptr<const S3ObjectMetadata> get(
+      const struct m0_uint128& index_oid, const std::string& object_name);
+
+  // Returns false if the value was not stored because the key was
+  // invalidated after 'generation' had been taken.
+  bool put(const struct m0_uint128& index_oid, const std::string& object_name,
+           uint64_t generation, std::shared_ptr<const S3ObjectMetadata> value);
+
+  void invalidate(const struct m0_uint128& index_oid,
+                  const std::string& object_name);
+
+  size_t size() const { return n_items; }
+  const Counters& get_counters() const { return counters; }
+
+ private:
+  struct Shard;
+
+  static std::string make_key(const struct m0_uint128& index_oid,
+                              const std::string& object_name);
+  Shard& get_shard(const std::string& key) const;
+
+  const size_t max_cache_size;
+  const std::chrono::steady_clock::duration expire_interval;
+  const unsigned n_shards;
+  std::unique_ptr<Shard[]> shards;
+  std::atomic<size_t> n_items{0};
+
+  Counters counters;
+};
+
+#endif  // __S3_SERVER_S3_OBJECT_METADATA_CACHE_H__
@@ -33,6 +33,7 @@ std::map<std::string, int> g_pi_map = {
     {std::string("PI_TYPE_MD5_INC_CONTEXT"), (int)M0_PI_TYPE_MD5_INC_CONTEXT}};
 
 S3Option* S3Option::option_instance = NULL;
+thread_local evbase_t* S3Option::thread_eventbase = NULL;
 
 bool S3Option::load_section(std::string section_name,
                             bool force_override_from_config = false) {
@@ -64,6 +65,18 @@ bool S3Option::load_section(std::string section_name,
           s3_option_node["S3_DAEMON_DO_REDIRECTION"].as<unsigned short>();
       s3_enable_auth_ssl = s3_option_node["S3_ENABLE_AUTH_SSL"].as<bool>();
       s3_reuseport = s3_option_node["S3_REUSEPORT"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_SERVER_REACTOR_COUNT");
+      s3_reactor_count =
+          s3_option_node["S3_SERVER_REACTOR_COUNT"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_HASH_THREAD_COUNT");
+      s3_hash_thread_count =
+          s3_option_node["S3_HASH_THREAD_COUNT"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_COMPLETION_QUEUE_SIZE");
+      s3_completion_queue_size =
+          s3_option_node["S3_COMPLETION_QUEUE_SIZE"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_REQUEST_ARENA_SIZE");
+      s3_request_arena_size =
+          s3_option_node["S3_REQUEST_ARENA_SIZE"].as<unsigned>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_WRITE_DATA_INTEGRITY_CHECK");
       s3_write_data_integrity_check =
           s3_option_node["S3_WRITE_DATA_INTEGRITY_CHECK"].as<bool>();
@@ -190,6 +203,17 @@ bool S3Option::load_section(std::string section_name,
 
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_READ_AHEAD_MULTIPLE");
       read_ahead_multiple = s3_option_node["S3_READ_AHEAD_MULTIPLE"].as<int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_GET_READ_WINDOW_MAX_MULTIPLE");
+      get_read_window_max_multiple =
+          s3_option_node["S3_GET_READ_WINDOW_MAX_MULTIPLE"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_COPY_PIPELINE_DEPTH");
+      copy_pipeline_depth =
+          s3_option_node["S3_COPY_PIPELINE_DEPTH"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_COPY_MAX_PARALLEL_FRAGMENTS");
+      copy_max_parallel_fragments =
+          s3_option_node["S3_COPY_MAX_PARALLEL_FRAGMENTS"].as<unsigned>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_WRITE_BUFFER_MULTIPLE");
       write_buffer_multiple =
           s3_option_node["S3_WRITE_BUFFER_MULTIPLE"].as<int>();
@@ -237,6 +261,18 @@ bool S3Option::load_section(std::string section_name,
       perf_stats_inout_bytes_interval_msec =
           s3_option_node["S3_PERF_STATS_INOUT_BYTES_INTERVAL_MSEC"]
               .as<uint32_t>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_STATS_AGGREGATE");
+      stats_aggregate = s3_option_node["S3_STATS_AGGREGATE"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_STATS_FLUSH_INTERVAL_MSEC");
+      stats_flush_interval_msec =
+          s3_option_node["S3_STATS_FLUSH_INTERVAL_MSEC"].as<uint32_t>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_STATS_PROMETHEUS_IP_ADDR");
+      stats_prometheus_ip_addr =
+          s3_option_node["S3_STATS_PROMETHEUS_IP_ADDR"].as<std::string>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_STATS_PROMETHEUS_PORT");
+      stats_prometheus_port =
+          s3_option_node["S3_STATS_PROMETHEUS_PORT"].as<unsigned short>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_REDIS_SERVER_ADDRESS");
       redis_srv_addr =
           s3_option_node["S3_REDIS_SERVER_ADDRESS"].as<std::string>();
@@ -259,11 +295,55 @@ bool S3Option::load_section(std::string section_name,
           s3_option_node["S3_BUCKET_METADATA_CACHE_EXPIRE_SEC"].as<unsigned>();
       bucket_metadata_cache_refresh_sec =
           s3_option_node["S3_BUCKET_METADATA_CACHE_REFRESH_SEC"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_BUCKET_METADATA_CACHE_NEGATIVE_EXPIRE_SEC");
+      bucket_metadata_cache_negative_expire_sec =
+          s3_option_node["S3_BUCKET_METADATA_CACHE_NEGATIVE_EXPIRE_SEC"]
+              .as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_BUCKET_METADATA_CACHE_SHARDS");
+      bucket_metadata_cache_shards =
+          s3_option_node["S3_BUCKET_METADATA_CACHE_SHARDS"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_OBJECT_METADATA_CACHE_MAX_SIZE");
+      object_metadata_cache_max_size =
+          s3_option_node["S3_OBJECT_METADATA_CACHE_MAX_SIZE"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_OBJECT_METADATA_CACHE_EXPIRE_SEC");
+      object_metadata_cache_expire_sec =
+          s3_option_node["S3_OBJECT_METADATA_CACHE_EXPIRE_SEC"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_OBJECT_METADATA_CACHE_SHARDS");
+      object_metadata_cache_shards =
+          s3_option_node["S3_OBJECT_METADATA_CACHE_SHARDS"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_METADATA_BINARY_ENCODING");
+      metadata_binary_encoding =
+          s3_option_node["S3_METADATA_BINARY_ENCODING"].as<bool>();
     } else if (section_name == "S3_AUTH_CONFIG") {
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_PORT");
       auth_port = s3_option_node["S3_AUTH_PORT"].as<unsigned short>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_IP_ADDR");
       auth_ip_addr = s3_option_node["S3_AUTH_IP_ADDR"].as<std::string>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_CACHE_MAX_SIZE");
+      auth_cache_max_size =
+          s3_option_node["S3_AUTH_CACHE_MAX_SIZE"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_CACHE_EXPIRE_SEC");
+      auth_cache_expire_sec =
+          s3_option_node["S3_AUTH_CACHE_EXPIRE_SEC"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_AUTH_CACHE_AUTHORIZATION_EXPIRE_SEC");
+      auth_cache_authorization_expire_sec =
+          s3_option_node["S3_AUTH_CACHE_AUTHORIZATION_EXPIRE_SEC"]
+              .as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_SIGNING_KEY_SECRET");
+      auth_signing_key_secret =
+          s3_option_node["S3_AUTH_SIGNING_KEY_SECRET"].as<std::string>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_POOL_MAX_CONNECTIONS");
+      auth_pool_max_connections =
+          s3_option_node["S3_AUTH_POOL_MAX_CONNECTIONS"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_POOL_IDLE_TIMEOUT_SEC");
+      auth_pool_idle_timeout_sec =
+          s3_option_node["S3_AUTH_POOL_IDLE_TIMEOUT_SEC"].as<unsigned>();
     } else if (section_name == "S3_MOTR_CONFIG") {
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_LOCAL_ADDR");
       motr_local_addr = s3_option_node["S3_MOTR_LOCAL_ADDR"].as<std::string>();
@@ -358,6 +438,29 @@ bool S3Option::load_section(std::string section_name,
              &motr_read_pool_expandable_count);
       sscanf(motr_read_pool_max_threshold_str.c_str(), "%zu",
              &motr_read_pool_max_threshold);
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_MOTR_READ_MEMPOOL_USE_HUGEPAGES");
+      motr_read_mempool_use_hugepages =
+          s3_option_node["S3_MOTR_READ_MEMPOOL_USE_HUGEPAGES"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_READ_MEMPOOL_PREFAULT");
+      motr_read_mempool_prefault =
+          s3_option_node["S3_MOTR_READ_MEMPOOL_PREFAULT"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_READ_UNIT_BUFFERS");
+      motr_read_unit_buffers =
+          s3_option_node["S3_MOTR_READ_UNIT_BUFFERS"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_KVS_BATCH_WINDOW_US");
+      motr_kvs_batch_window_us =
+          s3_option_node["S3_MOTR_KVS_BATCH_WINDOW_US"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_KVS_BATCH_MAX_KEYS");
+      motr_kvs_batch_max_keys =
+          s3_option_node["S3_MOTR_KVS_BATCH_MAX_KEYS"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_MOTR_MULTI_DELETE_MAX_INFLIGHT");
+      motr_multi_delete_max_inflight =
+          s3_option_node["S3_MOTR_MULTI_DELETE_MAX_INFLIGHT"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_KVS_PREFETCH_MAX_KEYS");
+      motr_kvs_prefetch_max_keys =
+          s3_option_node["S3_MOTR_KVS_PREFETCH_MAX_KEYS"].as<unsigned>();
 
     } else if (section_name == "S3_THIRDPARTY_CONFIG") {
       std::string libevent_pool_initial_size_str;
@@ -497,6 +600,18 @@ bool S3Option::load_section(std::string section_name,
       s3_enable_auth_ssl = s3_option_node["S3_ENABLE_AUTH_SSL"].as<bool>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_REUSEPORT");
       s3_reuseport = s3_option_node["S3_REUSEPORT"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_SERVER_REACTOR_COUNT");
+      s3_reactor_count =
+          s3_option_node["S3_SERVER_REACTOR_COUNT"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_HASH_THREAD_COUNT");
+      s3_hash_thread_count =
+          s3_option_node["S3_HASH_THREAD_COUNT"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_COMPLETION_QUEUE_SIZE");
+      s3_completion_queue_size =
+          s3_option_node["S3_COMPLETION_QUEUE_SIZE"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_REQUEST_ARENA_SIZE");
+      s3_request_arena_size =
+          s3_option_node["S3_REQUEST_ARENA_SIZE"].as<unsigned>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_WRITE_DATA_INTEGRITY_CHECK");
       s3_write_data_integrity_check =
           s3_option_node["S3_WRITE_DATA_INTEGRITY_CHECK"].as<bool>();
@@ -546,6 +661,17 @@ bool S3Option::load_section(std::string section_name,
 
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_READ_AHEAD_MULTIPLE");
       read_ahead_multiple = s3_option_node["S3_READ_AHEAD_MULTIPLE"].as<int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_GET_READ_WINDOW_MAX_MULTIPLE");
+      get_read_window_max_multiple =
+          s3_option_node["S3_GET_READ_WINDOW_MAX_MULTIPLE"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_COPY_PIPELINE_DEPTH");
+      copy_pipeline_depth =
+          s3_option_node["S3_COPY_PIPELINE_DEPTH"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_COPY_MAX_PARALLEL_FRAGMENTS");
+      copy_max_parallel_fragments =
+          s3_option_node["S3_COPY_MAX_PARALLEL_FRAGMENTS"].as<unsigned>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_WRITE_BUFFER_MULTIPLE");
       write_buffer_multiple =
           s3_option_node["S3_WRITE_BUFFER_MULTIPLE"].as<int>();
@@ -621,6 +747,30 @@ bool S3Option::load_section(std::string section_name,
           s3_option_node["S3_BUCKET_METADATA_CACHE_EXPIRE_SEC"].as<unsigned>();
       bucket_metadata_cache_refresh_sec =
           s3_option_node["S3_BUCKET_METADATA_CACHE_REFRESH_SEC"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_BUCKET_METADATA_CACHE_NEGATIVE_EXPIRE_SEC");
+      bucket_metadata_cache_negative_expire_sec =
+          s3_option_node["S3_BUCKET_METADATA_CACHE_NEGATIVE_EXPIRE_SEC"]
+              .as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_BUCKET_METADATA_CACHE_SHARDS");
+      bucket_metadata_cache_shards =
+          s3_option_node["S3_BUCKET_METADATA_CACHE_SHARDS"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_OBJECT_METADATA_CACHE_MAX_SIZE");
+      object_metadata_cache_max_size =
+          s3_option_node["S3_OBJECT_METADATA_CACHE_MAX_SIZE"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_OBJECT_METADATA_CACHE_EXPIRE_SEC");
+      object_metadata_cache_expire_sec =
+          s3_option_node["S3_OBJECT_METADATA_CACHE_EXPIRE_SEC"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_OBJECT_METADATA_CACHE_SHARDS");
+      object_metadata_cache_shards =
+          s3_option_node["S3_OBJECT_METADATA_CACHE_SHARDS"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_METADATA_BINARY_ENCODING");
+      metadata_binary_encoding =
+          s3_option_node["S3_METADATA_BINARY_ENCODING"].as<bool>();
     } else if (section_name == "S3_AUTH_CONFIG") {
       if (!(cmd_opt_flag & S3_OPTION_AUTH_PORT)) {
         S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_PORT");
@@ -630,6 +780,26 @@ bool S3Option::load_section(std::string section_name,
         S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_IP_ADDR");
         auth_ip_addr = s3_option_node["S3_AUTH_IP_ADDR"].as<std::string>();
       }
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_CACHE_MAX_SIZE");
+      auth_cache_max_size =
+          s3_option_node["S3_AUTH_CACHE_MAX_SIZE"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_CACHE_EXPIRE_SEC");
+      auth_cache_expire_sec =
+          s3_option_node["S3_AUTH_CACHE_EXPIRE_SEC"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_AUTH_CACHE_AUTHORIZATION_EXPIRE_SEC");
+      auth_cache_authorization_expire_sec =
+          s3_option_node["S3_AUTH_CACHE_AUTHORIZATION_EXPIRE_SEC"]
+              .as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_SIGNING_KEY_SECRET");
+      auth_signing_key_secret =
+          s3_option_node["S3_AUTH_SIGNING_KEY_SECRET"].as<std::string>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_POOL_MAX_CONNECTIONS");
+      auth_pool_max_connections =
+          s3_option_node["S3_AUTH_POOL_MAX_CONNECTIONS"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_POOL_IDLE_TIMEOUT_SEC");
+      auth_pool_idle_timeout_sec =
+          s3_option_node["S3_AUTH_POOL_IDLE_TIMEOUT_SEC"].as<unsigned>();
     } else if (section_name == "S3_MOTR_CONFIG") {
       if (!(cmd_opt_flag & S3_OPTION_MOTR_LOCAL_ADDR)) {
         S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_LOCAL_ADDR");
@@ -711,6 +881,29 @@ bool S3Option::load_section(std::string section_name,
              &motr_read_pool_expandable_count);
       sscanf(motr_read_pool_max_threshold_str.c_str(), "%zu",
              &motr_read_pool_max_threshold);
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_MOTR_READ_MEMPOOL_USE_HUGEPAGES");
+      motr_read_mempool_use_hugepages =
+          s3_option_node["S3_MOTR_READ_MEMPOOL_USE_HUGEPAGES"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_READ_MEMPOOL_PREFAULT");
+      motr_read_mempool_prefault =
+          s3_option_node["S3_MOTR_READ_MEMPOOL_PREFAULT"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_READ_UNIT_BUFFERS");
+      motr_read_unit_buffers =
+          s3_option_node["S3_MOTR_READ_UNIT_BUFFERS"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_KVS_BATCH_WINDOW_US");
+      motr_kvs_batch_window_us =
+          s3_option_node["S3_MOTR_KVS_BATCH_WINDOW_US"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_KVS_BATCH_MAX_KEYS");
+      motr_kvs_batch_max_keys =
+          s3_option_node["S3_MOTR_KVS_BATCH_MAX_KEYS"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_MOTR_MULTI_DELETE_MAX_INFLIGHT");
+      motr_multi_delete_max_inflight =
+          s3_option_node["S3_MOTR_MULTI_DELETE_MAX_INFLIGHT"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_KVS_PREFETCH_MAX_KEYS");
+      motr_kvs_prefetch_max_keys =
+          s3_option_node["S3_MOTR_KVS_PREFETCH_MAX_KEYS"].as<unsigned>();
 
     } else if (section_name == "S3_THIRDPARTY_CONFIG") {
       std::string libevent_pool_initial_size_str;
@@ -942,6 +1135,20 @@ void S3Option::dump_options() {
          (s3_enable_auth_ssl) ? "true" : "false");
   s3_log(S3_LOG_INFO, "", "S3_REUSEPORT = %s\n",
          (s3_reuseport) ? "true" : "false");
+  s3_log(S3_LOG_INFO, "", "S3_SERVER_REACTOR_COUNT = %u\n", s3_reactor_count);
+  s3_log(S3_LOG_INFO, "", "S3_HASH_THREAD_COUNT = %u\n", s3_hash_thread_count);
+  s3_log(S3_LOG_INFO, "", "S3_COMPLETION_QUEUE_SIZE = %u\n",
+         s3_completion_queue_size);
+  s3_log(S3_LOG_INFO, "", "S3_REQUEST_ARENA_SIZE = %u\n",
+         s3_request_arena_size);
+  s3_log(S3_LOG_INFO, "", "S3_OBJECT_METADATA_CACHE_MAX_SIZE = %u\n",
+         object_metadata_cache_max_size);
+  s3_log(S3_LOG_INFO, "", "S3_OBJECT_METADATA_CACHE_EXPIRE_SEC = %u\n",
+         object_metadata_cache_expire_sec);
+  s3_log(S3_LOG_INFO, "", "S3_OBJECT_METADATA_CACHE_SHARDS = %u\n",
+         object_metadata_cache_shards);
+  s3_log(S3_LOG_INFO, "", "S3_METADATA_BINARY_ENCODING = %s\n",
+         metadata_binary_encoding ? "true" : "false");
   s3_log(S3_LOG_INFO, "", "S3_WRITE_DATA_INTEGRITY_CHECK = %s\n",
          (s3_write_data_integrity_check) ? "true" : "false");
   s3_log(S3_LOG_INFO, "", "S3_READ_DATA_INTEGRITY_CHECK = %s\n",
@@ -977,6 +1184,12 @@ void S3Option::dump_options() {
   s3_log(S3_LOG_INFO, "", "S3_SERVER_SSL_SESSION_TIMEOUT = %d\n",
          s3server_ssl_session_timeout_in_sec);
   s3_log(S3_LOG_INFO, "", "S3_READ_AHEAD_MULTIPLE = %d\n", read_ahead_multiple);
+  s3_log(S3_LOG_INFO, "", "S3_GET_READ_WINDOW_MAX_MULTIPLE = %u\n",
+         get_read_window_max_multiple);
+  s3_log(S3_LOG_INFO, "", "S3_COPY_PIPELINE_DEPTH = %u\n",
+         copy_pipeline_depth);
+  s3_log(S3_LOG_INFO, "", "S3_COPY_MAX_PARALLEL_FRAGMENTS = %u\n",
+         copy_max_parallel_fragments);
   s3_log(S3_LOG_INFO, "", "S3_WRITE_BUFFER_MULTIPLE = %d\n",
          write_buffer_multiple);
   s3_log(S3_LOG_INFO, "", "S3_GET_THROTTLE_TIME_MILLISEC = %d\n",
@@ -991,6 +1204,18 @@ void S3Option::dump_options() {
 
   s3_log(S3_LOG_INFO, "", "S3_AUTH_IP_ADDR = %s\n", auth_ip_addr.c_str());
   s3_log(S3_LOG_INFO, "", "S3_AUTH_PORT = %d\n", auth_port);
+  s3_log(S3_LOG_INFO, "", "S3_AUTH_CACHE_MAX_SIZE = %u\n", auth_cache_max_size);
+  s3_log(S3_LOG_INFO, "", "S3_AUTH_CACHE_EXPIRE_SEC = %u\n",
+         auth_cache_expire_sec);
+  s3_log(S3_LOG_INFO, "", "S3_AUTH_CACHE_AUTHORIZATION_EXPIRE_SEC = %u\n",
+         auth_cache_authorization_expire_sec);
+  // Secret itself is not logged
+  s3_log(S3_LOG_INFO, "", "S3_AUTH_SIGNING_KEY_SECRET is %s\n",
+         auth_signing_key_secret.empty() ? "not set" : "set");
+  s3_log(S3_LOG_INFO, "", "S3_AUTH_POOL_MAX_CONNECTIONS = %u\n",
+         auth_pool_max_connections);
+  s3_log(S3_LOG_INFO, "", "S3_AUTH_POOL_IDLE_TIMEOUT_SEC = %u\n",
+         auth_pool_idle_timeout_sec);
   s3_log(S3_LOG_INFO, "", "S3_version = %s\n", s3_version.c_str());
 
   s3_log(S3_LOG_INFO, "", "S3_MOTR_LOCAL_ADDR = %s\n", motr_local_addr.c_str());
@@ -1068,6 +1293,12 @@ void S3Option::dump_options() {
          FLAGS_fake_motr_deletekv);
   s3_log(S3_LOG_INFO, "", "FLAGS_fake_motr_redis_kvs = %d\n",
          FLAGS_fake_motr_redis_kvs);
+  s3_log(S3_LOG_INFO, "", "FLAGS_fake_motr_obj_store = %d\n",
+         FLAGS_fake_motr_obj_store);
+  s3_log(S3_LOG_INFO, "", "FLAGS_fake_motr_obj_store_dir = %s\n",
+         FLAGS_fake_motr_obj_store_dir.c_str());
+  s3_log(S3_LOG_INFO, "", "FLAGS_fake_motr_latency_us = %d\n",
+         FLAGS_fake_motr_latency_us);
   s3_log(S3_LOG_INFO, "", "FLAGS_disable_auth = %d\n", FLAGS_disable_auth);
 
   s3_log(S3_LOG_INFO, "", "S3_ENABLE_STATS = %s\n",
@@ -1081,6 +1312,14 @@ void S3Option::dump_options() {
   s3_log(S3_LOG_INFO, "",
          "S3_PERF_STATS_INOUT_BYTES_INTERVAL_MSEC = %" PRIu32 "\n",
          perf_stats_inout_bytes_interval_msec);
+  s3_log(S3_LOG_INFO, "", "S3_STATS_AGGREGATE = %s\n",
+         (stats_aggregate ? "true" : "false"));
+  s3_log(S3_LOG_INFO, "", "S3_STATS_FLUSH_INTERVAL_MSEC = %" PRIu32 "\n",
+         stats_flush_interval_msec);
+  s3_log(S3_LOG_INFO, "", "S3_STATS_PROMETHEUS_IP_ADDR = %s\n",
+         stats_prometheus_ip_addr.c_str());
+  s3_log(S3_LOG_INFO, "", "S3_STATS_PROMETHEUS_PORT = %d\n",
+         stats_prometheus_port);
 
   s3_log(S3_LOG_INFO, "", "S3_REDIS_SERVER_PORT = %d\n", (int)redis_srv_port);
   s3_log(S3_LOG_INFO, "", "S3_REDIS_SERVER_ADDRESS = %s\n",
@@ -1097,6 +1336,20 @@ void S3Option::dump_options() {
          motr_read_mempool_zeroed_buffer ? "true" : "false");
   s3_log(S3_LOG_INFO, "", "S3_LIBEVENT_MEMPOOL_ZERO_BUFFER=%s\n",
          libevent_mempool_zeroed_buffer ? "true" : "false");
+  s3_log(S3_LOG_INFO, "", "S3_MOTR_READ_MEMPOOL_USE_HUGEPAGES=%s\n",
+         motr_read_mempool_use_hugepages ? "true" : "false");
+  s3_log(S3_LOG_INFO, "", "S3_MOTR_READ_MEMPOOL_PREFAULT=%s\n",
+         motr_read_mempool_prefault ? "true" : "false");
+  s3_log(S3_LOG_INFO, "", "S3_MOTR_READ_UNIT_BUFFERS=%s\n",
+         motr_read_unit_buffers ? "true" : "false");
+  s3_log(S3_LOG_INFO, "", "S3_MOTR_KVS_BATCH_WINDOW_US=%u\n",
+         motr_kvs_batch_window_us);
+  s3_log(S3_LOG_INFO, "", "S3_MOTR_KVS_BATCH_MAX_KEYS=%u\n",
+         motr_kvs_batch_max_keys);
+  s3_log(S3_LOG_INFO, "", "S3_MOTR_MULTI_DELETE_MAX_INFLIGHT=%u\n",
+         motr_multi_delete_max_inflight);
+  s3_log(S3_LOG_INFO, "", "S3_MOTR_KVS_PREFETCH_MAX_KEYS=%u\n",
+         motr_kvs_prefetch_max_keys);
 
   return;
 }
@@ -1163,6 +1416,30 @@ void S3Option::set_is_s3_shutting_down(bool is_shutting_down) {
 
 unsigned short S3Option::get_auth_port() { return auth_port; }
 
+unsigned S3Option::get_auth_cache_max_size() const {
+  return auth_cache_max_size;
+}
+
+unsigned S3Option::get_auth_cache_expire_sec() const {
+  return auth_cache_expire_sec;
+}
+
+unsigned S3Option::get_auth_cache_authorization_expire_sec() const {
+  return auth_cache_authorization_expire_sec;
+}
+
+const std::string& S3Option::get_auth_signing_key_secret() const {
+  return auth_signing_key_secret;
+}
+
+unsigned S3Option::get_auth_pool_max_connections() const {
+  return auth_pool_max_connections;
+}
+
+unsigned S3Option::get_auth_pool_idle_timeout_sec() const {
+  return auth_pool_idle_timeout_sec;
+}
+
 std::string S3Option::get_s3_version() { return s3_version; }
 
 unsigned short S3Option::get_motr_layout_id() { return motr_layout_id; }
@@ -1281,6 +1558,20 @@ std::string S3Option::get_perf_log_filename() { return perf_log_file; }
 
 int S3Option::get_read_ahead_multiple() { return read_ahead_multiple; }
 
+unsigned S3Option::get_get_read_window_max_multiple() {
+  return get_read_window_max_multiple;
+}
+
+unsigned S3Option::get_copy_pipeline_depth() { return copy_pipeline_depth; }
+
+void S3Option::set_copy_pipeline_depth(unsigned depth) {
+  copy_pipeline_depth = depth;
+}
+
+unsigned S3Option::get_copy_max_parallel_fragments() {
+  return copy_max_parallel_fragments;
+}
+
 int S3Option::get_write_buffer_multiple() { return write_buffer_multiple; }
 
 int S3Option::get_s3_req_throttle_time() { return s3_req_throttle_time; }
@@ -1309,6 +1600,30 @@ unsigned S3Option::get_bucket_metadata_cache_refresh_sec() const {
   return bucket_metadata_cache_refresh_sec;
 }
 
+unsigned S3Option::get_bucket_metadata_cache_negative_expire_sec() const {
+  return bucket_metadata_cache_negative_expire_sec;
+}
+
+unsigned S3Option::get_bucket_metadata_cache_shards() const {
+  return bucket_metadata_cache_shards;
+}
+
+unsigned S3Option::get_object_metadata_cache_max_size() const {
+  return object_metadata_cache_max_size;
+}
+
+unsigned S3Option::get_object_metadata_cache_expire_sec() const {
+  return object_metadata_cache_expire_sec;
+}
+
+unsigned S3Option::get_object_metadata_cache_shards() const {
+  return object_metadata_cache_shards;
+}
+
+bool S3Option::is_metadata_binary_encoding_enabled() const {
+  return metadata_binary_encoding;
+}
+
 std::string S3Option::get_motr_local_addr() { return motr_local_addr; }
 
 std::string S3Option::get_motr_ha_addr() { return motr_ha_addr; }
@@ -1422,6 +1737,18 @@ bool S3Option::is_fake_motr_deletekv() { return FLAGS_fake_motr_deletekv; }
 
 bool S3Option::is_fake_motr_redis_kvs() { return FLAGS_fake_motr_redis_kvs; }
 
+bool S3Option::is_fake_motr_obj_store() {
+  return FLAGS_fake_motr_obj_store || !FLAGS_fake_motr_obj_store_dir.empty();
+}
+
+std::string S3Option::get_fake_motr_obj_store_dir() {
+  return FLAGS_fake_motr_obj_store_dir;
+}
+
+unsigned S3Option::get_fake_motr_latency_us() {
+  return FLAGS_fake_motr_latency_us > 0 ? FLAGS_fake_motr_latency_us : 0;
+}
+
 /* For the moment sync kvs operation for fake kvs is not supported */
 bool S3Option::is_sync_kvs_allowed() {
   return !(FLAGS_fake_motr_redis_kvs || FLAGS_fake_motr_putkv);
@@ -1459,11 +1786,32 @@ uint32_t S3Option::get_perf_stats_inout_bytes_interval_msec() {
   return perf_stats_inout_bytes_interval_msec;
 }
 
+bool S3Option::is_stats_aggregate_enabled() { return stats_aggregate; }
+
+uint32_t S3Option::get_stats_flush_interval_msec() {
+  return stats_flush_interval_msec;
+}
+
+std::string S3Option::get_stats_prometheus_ip_addr() {
+  return stats_prometheus_ip_addr;
+}
+
+unsigned short S3Option::get_stats_prometheus_port() {
+  return stats_prometheus_port;
+}
+
 void S3Option::set_stats_allowlist_filename(const std::string& filename) {
   stats_allowlist_filename = filename;
 }
 
-evbase_t* S3Option::get_eventbase() { return eventbase; }
+void S3Option::set_thread_eventbase(evbase_t* base) {
+  thread_eventbase = base;
+}
+
+evbase_t* S3Option::get_eventbase() {
+  // Work started on an additional reactor must stay on that reactor's loop
+  return thread_eventbase ? thread_eventbase : eventbase;
+}
 
 void S3Option::enable_fault_injection() { FLAGS_fault_injection = true; }
 
@@ -1481,6 +1829,24 @@ bool S3Option::is_s3_reuseport_enabled() { return s3_reuseport; }
 
 bool S3Option::is_motr_http_reuseport_enabled() { return motr_http_reuseport; }
 
+unsigned S3Option::get_s3_reactor_count() const { return s3_reactor_count; }
+
+unsigned S3Option::get_s3_hash_thread_count() const {
+  return s3_hash_thread_count;
+}
+
+unsigned S3Option::get_s3_completion_queue_size() const {
+  return s3_completion_queue_size;
+}
+
+unsigned S3Option::get_s3_request_arena_size() const {
+  return s3_request_arena_size;
+}
+
+void S3Option::set_s3_request_arena_size(unsigned size) {
+  s3_request_arena_size = size;
+}
+
 bool S3Option::is_fi_enabled() { return FLAGS_fault_injection; }
 
 bool S3Option::is_getoid_enabled() { return FLAGS_getoid; }
@@ -1507,6 +1873,44 @@ bool S3Option::get_libevent_mempool_zeroed_buffer() {
   return libevent_mempool_zeroed_buffer;
 }
 
+bool S3Option::get_motr_read_mempool_use_hugepages() {
+  return motr_read_mempool_use_hugepages;
+}
+
+bool S3Option::get_motr_read_mempool_prefault() {
+  return motr_read_mempool_prefault;
+}
+
+bool S3Option::get_motr_read_unit_buffers() { return motr_read_unit_buffers; }
+
+void S3Option::set_motr_read_unit_buffers(bool enable) {
+  motr_read_unit_buffers = enable;
+}
+
+unsigned S3Option::get_motr_kvs_batch_window_us() {
+  return motr_kvs_batch_window_us;
+}
+
+unsigned S3Option::get_motr_kvs_batch_max_keys() {
+  return motr_kvs_batch_max_keys;
+}
+
+unsigned S3Option::get_motr_multi_delete_max_inflight() {
+  return motr_multi_delete_max_inflight;
+}
+
+void S3Option::set_motr_multi_delete_max_inflight(unsigned count) {
+  motr_multi_delete_max_inflight = count;
+}
+
+unsigned S3Option::get_motr_kvs_prefetch_max_keys() {
+  return motr_kvs_prefetch_max_keys;
+}
+
+void S3Option::set_motr_kvs_prefetch_max_keys(unsigned count) {
+  motr_kvs_prefetch_max_keys = count;
+}
+
 unsigned int S3Option::get_motr_first_read_size() {
   return motr_first_obj_read_size;
 }
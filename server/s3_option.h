@@ -96,6 +96,13 @@ class S3Option {
   std::string auth_ip_addr;
   std::string s3_version;
   unsigned short auth_port;
+  unsigned auth_cache_max_size;
+  unsigned auth_cache_expire_sec;
+  unsigned auth_cache_authorization_expire_sec;
+  // Shared with the auth server, sent to be given signing keys
+  std::string auth_signing_key_secret;
+  unsigned auth_pool_max_connections;
+  unsigned auth_pool_idle_timeout_sec;
 
   std::string s3_default_endpoint;
   std::set<std::string> s3_region_endpoints;
@@ -127,6 +134,9 @@ class S3Option {
   int s3server_ssl_session_timeout_in_sec;
 
   int read_ahead_multiple;
+  unsigned get_read_window_max_multiple;
+  unsigned copy_pipeline_depth;
+  unsigned copy_max_parallel_fragments;
   int write_buffer_multiple;
   // When Lib event's write buffer is getting accumulated,
   // Throttle S3 GET request by 's3_req_throttle_time' milliseconds.
@@ -138,6 +148,13 @@ class S3Option {
   bool s3server_ssl_enabled;
   bool s3server_obj_delayed_del_enabled;
   bool s3_reuseport;
+  // Number of libevent loops serving S3 clients in this process
+  unsigned s3_reactor_count;
+  unsigned s3_hash_thread_count;
+  // Slots in the completion queue of each event loop, 0 disables the queue
+  unsigned s3_completion_queue_size;
+  // Bytes of the arena chunk kept for each request, 0 disables arenas
+  unsigned s3_request_arena_size;
   bool s3_write_data_integrity_check;
   int s3_pi_type;
   bool s3_read_data_integrity_check;
@@ -154,6 +171,12 @@ class S3Option {
   unsigned bucket_metadata_cache_max_size;
   unsigned bucket_metadata_cache_expire_sec;
   unsigned bucket_metadata_cache_refresh_sec;
+  unsigned bucket_metadata_cache_negative_expire_sec;
+  unsigned bucket_metadata_cache_shards;
+  unsigned object_metadata_cache_max_size;
+  unsigned object_metadata_cache_expire_sec;
+  unsigned object_metadata_cache_shards;
+  bool metadata_binary_encoding;
 
   bool s3_di_disable_data_corruption_iem;
   bool s3_di_disable_metadata_corruption_iem;
@@ -178,6 +201,13 @@ class S3Option {
 
   bool motr_read_mempool_zeroed_buffer;
   bool libevent_mempool_zeroed_buffer;
+  bool motr_read_mempool_use_hugepages;
+  bool motr_read_mempool_prefault;
+  bool motr_read_unit_buffers;
+  unsigned motr_kvs_batch_window_us;
+  unsigned motr_kvs_batch_max_keys;
+  unsigned motr_multi_delete_max_inflight;
+  unsigned motr_kvs_prefetch_max_keys;
 
   size_t motr_read_pool_initial_buffer_count;
   size_t motr_read_pool_expandable_count;
@@ -206,7 +236,14 @@ class S3Option {
   unsigned short statsd_max_send_retry;
   std::string stats_allowlist_filename;
   uint32_t perf_stats_inout_bytes_interval_msec;
+  bool stats_aggregate;
+  uint32_t stats_flush_interval_msec;
+  std::string stats_prometheus_ip_addr;
+  unsigned short stats_prometheus_port;
   evbase_t* eventbase;
+  // Event base of the reactor owning the calling thread, if it is not the
+  // main one
+  static thread_local evbase_t* thread_eventbase;
 
   static S3Option* option_instance;
   void set_motr_idx_fetch_count(short count);
@@ -222,6 +259,9 @@ class S3Option {
     s3_pidfile = "/var/run/s3server.pid";
 
     read_ahead_multiple = 1;
+    get_read_window_max_multiple = 1;
+    copy_pipeline_depth = 1;
+    copy_max_parallel_fragments = 3;
     write_buffer_multiple = 1;
     // Default: Throttle S3 Get request for 500 milliseconds when there is
     // memory issue
@@ -236,6 +276,15 @@ class S3Option {
     s3server_ssl_enabled = false;
     s3server_obj_delayed_del_enabled = true;
 
+    s3_reactor_count = 1;
+    s3_hash_thread_count = 0;
+    s3_completion_queue_size = 0;
+    s3_request_arena_size = 0;
+    object_metadata_cache_max_size = 0;
+    object_metadata_cache_expire_sec = 1;
+    object_metadata_cache_shards = 16;
+    metadata_binary_encoding = false;
+
     s3_grace_period_sec = 10;  // 10 seconds
     s3_retry_after_sec = 30;   // 30 seconds
     is_s3_shutting_down = false;
@@ -278,6 +327,13 @@ class S3Option {
 
     motr_read_mempool_zeroed_buffer = 0;
     libevent_mempool_zeroed_buffer = 0;
+    motr_read_mempool_use_hugepages = false;
+    motr_read_mempool_prefault = false;
+    motr_read_unit_buffers = false;
+    motr_kvs_batch_window_us = 0;
+    motr_kvs_batch_max_keys = 64;
+    motr_multi_delete_max_inflight = 4;
+    motr_kvs_prefetch_max_keys = 0;
 
     // libevent_pool_buffer_size is used for each item in this
     motr_read_pool_initial_buffer_count = 10;   // 10 buffer
@@ -294,6 +350,11 @@ class S3Option {
 
     auth_ip_addr = FLAGS_authhost;
     auth_port = FLAGS_authport;
+    auth_cache_max_size = 0;
+    auth_cache_expire_sec = 300;
+    auth_cache_authorization_expire_sec = 5;
+    auth_pool_max_connections = 0;
+    auth_pool_idle_timeout_sec = 60;
 
     option_file = "/opt/seagate/cortx/s3/conf/s3config.yaml";
     layout_recommendation_file =
@@ -319,6 +380,10 @@ class S3Option {
     stats_allowlist_filename =
         "/opt/seagate/cortx/s3/conf/s3stats-allowlist.yaml";
     perf_stats_inout_bytes_interval_msec = 1000;
+    stats_aggregate = false;
+    stats_flush_interval_msec = 10000;
+    stats_prometheus_ip_addr = "127.0.0.1";
+    stats_prometheus_port = 0;
 
     redis_srv_addr = "127.0.0.1";
     redis_srv_port = 6397;
@@ -379,6 +444,10 @@ class S3Option {
   int get_s3server_ssl_session_timeout();
 
   int get_read_ahead_multiple();
+  unsigned get_get_read_window_max_multiple();
+  unsigned get_copy_pipeline_depth();
+  void set_copy_pipeline_depth(unsigned depth);
+  unsigned get_copy_max_parallel_fragments();
   int get_write_buffer_multiple();
   int get_s3_req_throttle_time();
 
@@ -392,6 +461,12 @@ class S3Option {
   std::string get_auth_ip_addr();
   std::string get_s3_version();
   unsigned short get_auth_port();
+  unsigned get_auth_cache_max_size() const;
+  unsigned get_auth_cache_expire_sec() const;
+  unsigned get_auth_cache_authorization_expire_sec() const;
+  const std::string& get_auth_signing_key_secret() const;
+  unsigned get_auth_pool_max_connections() const;
+  unsigned get_auth_pool_idle_timeout_sec() const;
   void disable_auth();
   void enable_auth();
   bool is_auth_disabled();
@@ -425,6 +500,11 @@ class S3Option {
 
   bool is_s3_reuseport_enabled();
   bool is_motr_http_reuseport_enabled();
+  unsigned get_s3_reactor_count() const;
+  unsigned get_s3_hash_thread_count() const;
+  unsigned get_s3_completion_queue_size() const;
+  unsigned get_s3_request_arena_size() const;
+  void set_s3_request_arena_size(unsigned size);
   const char* get_iam_cert_file();
   bool is_log_buffering_enabled();
   bool is_murmurhash_oid_enabled();
@@ -436,6 +516,12 @@ class S3Option {
   unsigned get_bucket_metadata_cache_max_size() const;
   unsigned get_bucket_metadata_cache_expire_sec() const;
   unsigned get_bucket_metadata_cache_refresh_sec() const;
+  unsigned get_bucket_metadata_cache_negative_expire_sec() const;
+  unsigned get_bucket_metadata_cache_shards() const;
+  unsigned get_object_metadata_cache_max_size() const;
+  unsigned get_object_metadata_cache_expire_sec() const;
+  unsigned get_object_metadata_cache_shards() const;
+  bool is_metadata_binary_encoding_enabled() const;
 
   std::string get_motr_local_addr();
   std::string get_motr_ha_addr();
@@ -492,11 +578,16 @@ class S3Option {
   bool is_fake_motr_putkv();
   bool is_fake_motr_deletekv();
   bool is_fake_motr_redis_kvs();
+  bool is_fake_motr_obj_store();
+  std::string get_fake_motr_obj_store_dir();
+  unsigned get_fake_motr_latency_us();
 
   /* For the moment sync kvs operation for fake kvs is not supported */
   bool is_sync_kvs_allowed();
 
   void set_eventbase(evbase_t* base);
+  // Binds the calling thread to the event base of its reactor
+  void set_thread_eventbase(evbase_t* base);
   evbase_t* get_eventbase();
 
   std::string get_redis_srv_addr();
@@ -507,6 +598,16 @@ class S3Option {
 
   bool get_motr_read_mempool_zeroed_buffer();
   bool get_libevent_mempool_zeroed_buffer();
+  bool get_motr_read_mempool_use_hugepages();
+  bool get_motr_read_mempool_prefault();
+  bool get_motr_read_unit_buffers();
+  void set_motr_read_unit_buffers(bool enable);
+  unsigned get_motr_kvs_batch_window_us();
+  unsigned get_motr_kvs_batch_max_keys();
+  unsigned get_motr_multi_delete_max_inflight();
+  void set_motr_multi_delete_max_inflight(unsigned count);
+  unsigned get_motr_kvs_prefetch_max_keys();
+  void set_motr_kvs_prefetch_max_keys(unsigned count);
 
   bool is_stats_enabled();
   void set_stats_enable(bool enable);
@@ -515,6 +616,10 @@ class S3Option {
   unsigned short get_statsd_max_send_retry();
   std::string get_stats_allowlist_filename();
   uint32_t get_perf_stats_inout_bytes_interval_msec();
+  bool is_stats_aggregate_enabled();
+  uint32_t get_stats_flush_interval_msec();
+  std::string get_stats_prometheus_ip_addr();
+  unsigned short get_stats_prometheus_port();
   void set_stats_allowlist_filename(const std::string& filename);
 
   // Fault injection Option
@@ -25,11 +25,13 @@
 #include "s3_factory.h"
 #include "s3_iem.h"
 #include "s3_log.h"
+#include "s3_metadata_codec.h"
 #include "s3_motr_kvs_reader.h"
 #include "s3_motr_kvs_writer.h"
 #include "s3_part_metadata.h"
 #include "s3_request_object.h"
 #include "s3_m0_uint128_helper.h"
+#include "s3_option.h"
 
 void S3PartMetadata::initialize(std::string uploadid, int part_num) {
   bucket_name = request->get_bucket_name();
@@ -352,7 +354,10 @@ void S3PartMetadata::save_metadata() {
         mote_kv_writer_factory->create_motr_kvs_writer(request, s3_motr_api);
   }
   motr_kv_writer->put_keyval(
-      part_index_layout, part_number, this->to_json(),
+      part_index_layout, part_number,
+      S3Option::get_instance()->is_metadata_binary_encoding_enabled()
+          ? this->to_binary()
+          : this->to_json(),
       std::bind(&S3PartMetadata::save_metadata_successful, this),
       std::bind(&S3PartMetadata::save_metadata_failed, this));
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
@@ -479,6 +484,9 @@ std::string S3PartMetadata::to_json() {
 }
 
 int S3PartMetadata::from_json(std::string content) {
+  if (S3MetadataDecoder::is_binary(content)) {
+    return from_binary(content);
+  }
   s3_log(S3_LOG_DEBUG, request_id, "\n");
   Json::Value newroot;
   Json::Reader reader;
@@ -517,6 +525,110 @@ int S3PartMetadata::from_json(std::string content) {
   return 0;
 }
 
+// Field tags of binary encoded part metadata, must never be reused
+enum S3PartMetadataField : unsigned {
+  PART_FIELD_BUCKET_NAME = 1,
+  PART_FIELD_OBJECT_NAME = 2,
+  PART_FIELD_UPLOAD_ID = 3,
+  PART_FIELD_PART_NUMBER = 4,
+  PART_FIELD_OID = 5,
+  PART_FIELD_LAYOUT_ID = 6,
+  PART_FIELD_PVID = 7,
+  PART_FIELD_SYSTEM_DEFINED = 8,
+  PART_FIELD_USER_DEFINED = 9
+};
+
+std::string S3PartMetadata::to_binary() {
+  s3_log(S3_LOG_DEBUG, request_id, "\n");
+  S3MetadataEncoder encoder(S3MetadataRecordType::part);
+
+  if (s3_di_fi_is_enabled("di_part_metadata_bcktname_on_write_corrupted")) {
+    encoder.add(PART_FIELD_BUCKET_NAME, "@" + bucket_name + "@");
+  } else {
+    encoder.add(PART_FIELD_BUCKET_NAME, bucket_name);
+  }
+  if (s3_di_fi_is_enabled("di_part_metadata_objname_on_write_corrupted")) {
+    encoder.add(PART_FIELD_OBJECT_NAME, "@" + object_name + "@");
+  } else {
+    encoder.add(PART_FIELD_OBJECT_NAME, object_name);
+  }
+  encoder.add(PART_FIELD_UPLOAD_ID, upload_id);
+  encoder.add(PART_FIELD_PART_NUMBER, part_number);
+  if (motr_oid_str.empty()) {
+    encoder.add(PART_FIELD_OID, "");
+  } else {
+    encoder.add_raw(PART_FIELD_OID, oid);
+  }
+  encoder.add_int(PART_FIELD_LAYOUT_ID, layout_id);
+  encoder.add(PART_FIELD_PVID, pvid_str);
+  encoder.add_map(PART_FIELD_SYSTEM_DEFINED, system_defined_attribute);
+  encoder.add_map(PART_FIELD_USER_DEFINED, user_defined_attribute);
+
+  return std::move(encoder.get_buffer());
+}
+
+int S3PartMetadata::from_binary(const std::string& content) {
+  s3_log(S3_LOG_DEBUG, request_id, "\n");
+  S3MetadataDecoder decoder(content, S3MetadataRecordType::part);
+  S3MetadataField field;
+  unsigned tag;
+  int64_t int_value;
+  bool ok = true;
+
+  motr_oid_str.clear();
+  oid = {};
+
+  while (ok && decoder.next(tag, field)) {
+    switch (tag) {
+      case PART_FIELD_BUCKET_NAME:
+        bucket_name = field.to_string();
+        break;
+      case PART_FIELD_OBJECT_NAME:
+        object_name = field.to_string();
+        break;
+      case PART_FIELD_UPLOAD_ID:
+        upload_id = field.to_string();
+        break;
+      case PART_FIELD_PART_NUMBER:
+        part_number = field.to_string();
+        break;
+      case PART_FIELD_OID:
+        if (field.size) {
+          ok = field.copy_to(oid);
+          motr_oid_str = S3M0Uint128Helper::to_string(oid);
+        }
+        break;
+      case PART_FIELD_LAYOUT_ID:
+        ok = field.to_int(int_value);
+        layout_id = static_cast<int>(int_value);
+        break;
+      case PART_FIELD_PVID:
+        pvid_str = field.to_string();
+        break;
+      case PART_FIELD_SYSTEM_DEFINED:
+        ok = field.to_map(system_defined_attribute);
+        break;
+      case PART_FIELD_USER_DEFINED:
+        ok = field.to_map(user_defined_attribute);
+        break;
+      default:
+        break;
+    }
+  }
+  if (!ok || !decoder.is_valid() ||
+      s3_di_fi_is_enabled("part_metadata_corrupted")) {
+    s3_log(S3_LOG_ERROR, request_id, "Binary metadata parsing failed.\n");
+    return -1;
+  }
+  if (s3_di_fi_is_enabled("di_part_metadata_bcktname_on_read_corrupted")) {
+    bucket_name = "@" + bucket_name + "@";
+  }
+  if (s3_di_fi_is_enabled("di_part_metadata_objname_on_read_corrupted")) {
+    object_name = "@" + object_name + "@";
+  }
+  return 0;
+}
+
 void S3PartMetadata::regenerate_new_indexname() {
   index_name = index_name + salt + std::to_string(collision_attempt_count);
 }
@@ -192,11 +192,15 @@ class S3PartMetadata {
   void set_state(S3PartMetadataState part_state) { state = part_state; }
 
   std::string to_json();
+  // Compact alternative to to_json(), see s3_metadata_codec.h
+  std::string to_binary();
 
   bool validate_on_request();
 
+  // Accepts both JSON and binary encoded metadata.
   // returns 0 on success, -1 on parsing error.
   virtual int from_json(std::string content);
+  int from_binary(const std::string& content);
 
   // virtual destructor.
   virtual ~S3PartMetadata(){};
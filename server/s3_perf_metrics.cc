@@ -18,6 +18,7 @@
  *
  */
 
+#include <cerrno>
 #include <memory>
 #include <string>
 #include <cstdint>
@@ -75,8 +76,62 @@ class S3ThroughputMetricsEvent : public RecurringEventBase {
   void more_bytes_out(int cnt) { out.more_bytes(cnt); }
 };
 
+// Helper class, sends stats aggregated in process to statsd.
+class S3StatsFlushEvent : public RecurringEventBase {
+ public:
+  S3StatsFlushEvent(std::shared_ptr<EventInterface> event_obj_ptr,
+                    evbase_t *evbase_ = nullptr)
+      : RecurringEventBase(std::move(event_obj_ptr), evbase_) {}
+
+  virtual void action_callback(void) noexcept { s3_stats_flush(); }
+};
+
 static std::shared_ptr<EventWrapper> gs_event_obj_ptr;
 static std::shared_ptr<S3ThroughputMetricsEvent> gs_throughput_event;
+static std::shared_ptr<S3StatsFlushEvent> gs_stats_flush_event;
+static evhtp_t *gs_prometheus_htp = nullptr;
+
+// GET /metrics of the Prometheus endpoint
+static void prometheus_metrics_cb(evhtp_request_t *req, void *arg) {
+  if (evhtp_request_get_method(req) != htp_method_GET) {
+    evhtp_send_reply(req, EVHTP_RES_METHNALLOWED);
+    return;
+  }
+  std::string text;
+  if (g_stats_aggregator) {
+    text = g_stats_aggregator->format_prometheus();
+  }
+  evbuffer_add(req->buffer_out, text.c_str(), text.length());
+  evhtp_headers_add_header(
+      req->headers_out,
+      evhtp_header_new("Content-Type", "text/plain; version=0.0.4", 0, 0));
+  evhtp_send_reply(req, EVHTP_RES_OK);
+}
+
+static int start_prometheus_endpoint(evbase_t *evbase) {
+  unsigned short port = g_option_instance->get_stats_prometheus_port();
+  if (!g_stats_aggregator || port == 0) {
+    return 0;
+  }
+  std::string addr = g_option_instance->get_stats_prometheus_ip_addr();
+  gs_prometheus_htp = evhtp_new(evbase, NULL);
+  if (!gs_prometheus_htp) {
+    return -ENOMEM;
+  }
+  evhtp_set_cb(gs_prometheus_htp, "/metrics", prometheus_metrics_cb, NULL);
+  std::string bind_addr =
+      (addr.find(':') == std::string::npos ? "ipv4:" : "ipv6:") + addr;
+  if (evhtp_bind_socket(gs_prometheus_htp, bind_addr.c_str(), port, 128) <
+      0) {
+    int rc = errno ? -errno : -EINVAL;
+    s3_log(S3_LOG_ERROR, "", "Could not bind Prometheus endpoint %s:%d\n",
+           addr.c_str(), port);
+    return rc;
+  }
+  s3_log(S3_LOG_INFO, "", "Serving stats at http://%s:%d/metrics\n",
+         addr.c_str(), port);
+  return 0;
+}
 
 int s3_perf_metrics_init(evbase_t *evbase) {
   int rc;
@@ -112,6 +167,25 @@ int s3_perf_metrics_init(evbase_t *evbase) {
     return rc;
   }
 
+  if (g_stats_aggregator &&
+      S3Option::get_instance()->get_stats_flush_interval_msec() > 0) {
+    gs_stats_flush_event.reset(
+        new S3StatsFlushEvent(gs_event_obj_ptr, evbase));
+    tv.tv_sec =
+        S3Option::get_instance()->get_stats_flush_interval_msec() / 1000;
+    tv.tv_usec =
+        1000 * (S3Option::get_instance()->get_stats_flush_interval_msec() %
+                1000);
+    rc = gs_stats_flush_event->add_evtimer(tv);
+    if (rc != 0) {
+      return rc;
+    }
+  }
+  rc = start_prometheus_endpoint(evbase);
+  if (rc != 0) {
+    return rc;
+  }
+
   call_fini.cancel();
 
   return 0;
@@ -126,6 +200,15 @@ void s3_perf_metrics_fini() {
     gs_throughput_event->del_evtimer();
     gs_throughput_event.reset();
   }
+  if (gs_stats_flush_event) {
+    gs_stats_flush_event->del_evtimer();
+    gs_stats_flush_event.reset();
+  }
+  if (gs_prometheus_htp) {
+    evhtp_unbind_socket(gs_prometheus_htp);
+    evhtp_free(gs_prometheus_htp);
+    gs_prometheus_htp = nullptr;
+  }
   if (gs_event_obj_ptr) {
     gs_event_obj_ptr.reset();
   }
@@ -354,9 +354,9 @@ void S3PostCompleteAction::start_response() {
 void S3PostCompleteAction::get_next_parts_info() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   s3_log(S3_LOG_DEBUG, request_id, "Fetching parts list from KV store\n");
-  if (motr_kv_reader == nullptr) {
-    motr_kv_reader = s3_motr_kvs_reader_factory->create_motr_kvs_reader(
-        request, s3_motr_api);
+  if (motr_kv_cursor == nullptr) {
+    motr_kv_cursor = std::make_shared<S3MotrKVSScanCursor>(
+        request, s3_motr_kvs_reader_factory, s3_motr_api);
   }
   if (response_started) {
     if (mp_completion_send_space_chk_shutdown()) {
@@ -365,7 +365,7 @@ void S3PostCompleteAction::get_next_parts_info() {
       return;
     }
   }
-  motr_kv_reader->next_keyval(
+  motr_kv_cursor->next_keyval(
       multipart_metadata->get_part_index_layout(), last_key, count_we_requested,
       std::bind(&S3PostCompleteAction::get_next_parts_info_successful, this),
       std::bind(&S3PostCompleteAction::get_next_parts_info_failed, this));
@@ -374,8 +374,8 @@ void S3PostCompleteAction::get_next_parts_info() {
 void S3PostCompleteAction::get_next_parts_info_successful() {
   s3_log(S3_LOG_INFO, stripped_request_id,
          "%s Entry with size %d while requested %d\n", __func__,
-         (int)motr_kv_reader->get_key_values().size(), (int)count_we_requested);
-  if (motr_kv_reader->get_key_values().size() > 0) {
+         (int)motr_kv_cursor->get_key_values().size(), (int)count_we_requested);
+  if (motr_kv_cursor->get_key_values().size() > 0) {
     // Do validation of parts
     if (!validate_parts()) {
       s3_log(S3_LOG_DEBUG, "", "validate_parts failed");
@@ -387,9 +387,9 @@ void S3PostCompleteAction::get_next_parts_info_successful() {
     s3_log(S3_LOG_DEBUG, request_id, "aborting multipart");
     next();
   } else {
-    if (motr_kv_reader->get_key_values().size() < count_we_requested) {
+    if (motr_kv_cursor->get_key_values().size() < count_we_requested) {
       // Fetched all parts
-      validated_parts_count += motr_kv_reader->get_key_values().size();
+      validated_parts_count += motr_kv_cursor->get_key_values().size();
       if ((parts.size() != 0) ||
           (validated_parts_count != std::stoul(total_parts))) {
         s3_log(S3_LOG_DEBUG, request_id,
@@ -411,8 +411,8 @@ void S3PostCompleteAction::get_next_parts_info_successful() {
     } else {
       // Continue fetching
       validated_parts_count += count_we_requested;
-      if (!motr_kv_reader->get_key_values().empty()) {
-        last_key = motr_kv_reader->get_key_values().rbegin()->first;
+      if (!motr_kv_cursor->get_key_values().empty()) {
+        last_key = motr_kv_cursor->get_key_values().rbegin()->first;
       }
       s3_log(S3_LOG_DEBUG, request_id, "continue fetching with %s",
              last_key.c_str());
@@ -425,7 +425,7 @@ void S3PostCompleteAction::get_next_parts_info_successful() {
 }
 
 void S3PostCompleteAction::get_next_parts_info_failed() {
-  if (motr_kv_reader->get_state() == S3MotrKVSReaderOpState::missing) {
+  if (motr_kv_cursor->get_state() == S3MotrKVSReaderOpState::missing) {
     // There may not be any records left
     if ((parts.size() != 0) ||
         (validated_parts_count != std::stoul(total_parts))) {
@@ -441,7 +441,7 @@ void S3PostCompleteAction::get_next_parts_info_failed() {
     etag = generate_etag();
     next();
   } else {
-    if (motr_kv_reader->get_state() ==
+    if (motr_kv_cursor->get_state() ==
         S3MotrKVSReaderOpState::failed_to_launch) {
       s3_log(S3_LOG_ERROR, request_id,
              "Parts metadata next keyval operation failed due to pre launch "
@@ -474,7 +474,7 @@ bool S3PostCompleteAction::validate_parts() {
         request, multipart_metadata->get_part_index_layout(), upload_id, 0);
   }
   const auto& part_index_layout = multipart_metadata->get_part_index_layout();
-  const auto& parts_batch_from_kvs = motr_kv_reader->get_key_values();
+  const auto& parts_batch_from_kvs = motr_kv_cursor->get_key_values();
 
   for (auto part_kv = parts.begin(); part_kv != parts.end();) {
     auto store_kv = parts_batch_from_kvs.find(part_kv->first);
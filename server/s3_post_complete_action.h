@@ -26,6 +26,7 @@
 #include <memory>
 
 #include "s3_object_action_base.h"
+#include "s3_motr_kvs_scan_cursor.h"
 #include "s3_motr_writer.h"
 #include "s3_factory.h"
 #include "s3_part_metadata.h"
@@ -55,7 +56,7 @@ class S3PostCompleteAction : public S3ObjectAction {
   std::shared_ptr<S3MotrKVSWriterFactory> mote_kv_writer_factory;
   std::shared_ptr<S3ObjectMetadata> multipart_metadata;
   std::shared_ptr<S3PartMetadata> part_metadata;
-  std::shared_ptr<S3MotrKVSReader> motr_kv_reader;
+  std::shared_ptr<S3MotrKVSScanCursor> motr_kv_cursor;
   std::shared_ptr<MotrAPI> s3_motr_api;
   std::shared_ptr<S3MotrWiter> motr_writer;
   std::shared_ptr<S3MotrKVSWriter> motr_kv_writer;
@@ -19,6 +19,7 @@
  */
 
 #include "s3_post_to_main_loop.h"
+#include "s3_completion_queue.h"
 #include "s3_option.h"
 
 void S3PostToMainLoop::operator()(user_event_on_main_loop callback,
@@ -27,12 +28,24 @@ void S3PostToMainLoop::operator()(user_event_on_main_loop callback,
   struct event *ev_user = NULL;
   struct user_event_context *user_context =
       (struct user_event_context *)context;
-  struct event_base *base = S3Option::get_instance()->get_eventbase();
+  struct event_base *base = user_context->evbase
+                                ? user_context->evbase
+                                : S3Option::get_instance()->get_eventbase();
 
   if (base == NULL) {
     s3_log(S3_LOG_ERROR, request_id, "ERROR: event base is NULL\n");
     return;
   }
+  S3CompletionQueue *queue = S3CompletionQueue::find(base);
+  if (queue) {
+    // No event of its own to free
+    user_context->user_event = NULL;
+    if (queue->post(callback, user_context)) {
+      s3_log(S3_LOG_DEBUG, request_id, "%s Exit", __func__);
+      return;
+    }
+    s3_log(S3_LOG_DEBUG, request_id, "Completion queue is full\n");
+  }
   s3_log(S3_LOG_DEBUG, request_id, "Raise event to switch to main thread.\n");
 
   ev_user = event_new(base, -1, EV_WRITE | EV_READ | EV_TIMEOUT, callback,
@@ -32,6 +32,8 @@
 struct user_event_context {
   void *app_ctx;
   void *user_event;
+  // Loop of the reactor that started the operation; NULL means main loop.
+  struct event_base *evbase;
 };
 
 extern "C" typedef void (*user_event_on_main_loop)(evutil_socket_t,
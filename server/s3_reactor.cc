@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <cerrno>
+
+#include "s3_reactor.h"
+#include "s3_log.h"
+#include "s3_option.h"
+
+thread_local S3Reactor *S3Reactor::current = nullptr;
+
+S3Reactor::S3Reactor(unsigned index, StartHook on_start, StopHook on_stop)
+    : index(index), on_start(std::move(on_start)), on_stop(std::move(on_stop)) {
+  s3_log(S3_LOG_DEBUG, "", "%s Ctor\n", __func__);
+}
+
+S3Reactor::~S3Reactor() {
+  s3_log(S3_LOG_DEBUG, "", "%s\n", __func__);
+  stop();
+  if (evbase) {
+    event_base_free(evbase);
+    evbase = nullptr;
+  }
+}
+
+void *S3Reactor::run(void *arg) {
+  S3Reactor *reactor = (S3Reactor *)arg;
+  current = reactor;
+  S3Option::get_instance()->set_thread_eventbase(reactor->evbase);
+
+  int rc = reactor->on_start ? reactor->on_start(reactor) : 0;
+  {
+    std::lock_guard<std::mutex> lock(reactor->start_lock);
+    reactor->start_rc = rc;
+    reactor->start_done = true;
+  }
+  reactor->start_cond.notify_one();
+
+  if (rc == 0) {
+    s3_log(S3_LOG_INFO, "", "Reactor %u: event loop started\n",
+           reactor->index);
+    rc = event_base_loop(reactor->evbase, EVLOOP_NO_EXIT_ON_EMPTY);
+    if (rc != 0) {
+      s3_log(S3_LOG_ERROR, "",
+             "Reactor %u: event loop exited due to unhandled exception in "
+             "libevent's backend\n",
+             reactor->index);
+    }
+    if (reactor->on_stop) {
+      reactor->on_stop(reactor);
+    }
+    s3_log(S3_LOG_INFO, "", "Reactor %u: event loop stopped\n",
+           reactor->index);
+  }
+  S3Option::get_instance()->set_thread_eventbase(NULL);
+  current = nullptr;
+  return NULL;
+}
+
+int S3Reactor::start() {
+  s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
+  if (running) {
+    return EEXIST;
+  }
+  if (!evbase) {
+    evbase = event_base_new();
+    if (!evbase) {
+      s3_log(S3_LOG_ERROR, "", "Reactor %u: event_base_new failed\n", index);
+      return ENOMEM;
+    }
+  }
+  start_done = false;
+  int rc = pthread_create(&thread, NULL, &S3Reactor::run, this);
+  if (rc != 0) {
+    s3_log(S3_LOG_ERROR, "", "Reactor %u: failed to create thread, rc = %d\n",
+           index, rc);
+    return rc;
+  }
+  {
+    std::unique_lock<std::mutex> lock(start_lock);
+    start_cond.wait(lock, [this] { return start_done; });
+    rc = start_rc;
+  }
+  if (rc != 0) {
+    s3_log(S3_LOG_ERROR, "", "Reactor %u: start hook failed, rc = %d\n",
+           index, rc);
+    pthread_join(thread, NULL);
+    return rc;
+  }
+  running = true;
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+  return 0;
+}
+
+void S3Reactor::stop() {
+  if (!running) {
+    return;
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
+  event_base_loopexit(evbase, NULL);
+  pthread_join(thread, NULL);
+  running = false;
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
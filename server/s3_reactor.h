@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_REACTOR_H__
+#define __S3_SERVER_S3_REACTOR_H__
+
+#include <pthread.h>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+#include <evhtp.h>
+
+// A reactor is an event loop running on its own thread. The main thread runs
+// reactor 0 (global_evbase_handle); additional reactors are started when
+// S3_SERVER_REACTOR_COUNT > 1, each with its own listeners bound to the same
+// port with SO_REUSEPORT, so the kernel spreads connections among them.
+//
+// Everything a request touches on its way (timers, auth client, motr
+// completions) is scheduled on S3Option::get_eventbase(), which returns the
+// event base of the calling reactor.
+class S3Reactor {
+ public:
+  // Hooks are called on the reactor thread: on_start before the loop is run
+  // (non zero return value aborts the start), on_stop after it exits.
+  typedef std::function<int(S3Reactor *)> StartHook;
+  typedef std::function<void(S3Reactor *)> StopHook;
+
+ private:
+  unsigned index;
+  evbase_t *evbase = nullptr;
+  pthread_t thread;
+  bool running = false;
+
+  StartHook on_start;
+  StopHook on_stop;
+
+  // Start handshake with the thread calling start()
+  std::mutex start_lock;
+  std::condition_variable start_cond;
+  bool start_done = false;
+  int start_rc = 0;
+
+  static thread_local S3Reactor *current;
+
+  static void *run(void *arg);
+
+ public:
+  S3Reactor(unsigned index, StartHook on_start = nullptr,
+            StopHook on_stop = nullptr);
+  ~S3Reactor();
+
+  // Creates the event base and the thread, returns after on_start hook has
+  // completed. Returns 0 on success.
+  int start();
+  // Breaks the loop and joins the thread. Safe to call from any other thread.
+  void stop();
+
+  unsigned get_index() const { return index; }
+  evbase_t *get_evbase() const { return evbase; }
+  bool is_running() const { return running; }
+
+  // Reactor owning the calling thread, nullptr on the main thread.
+  static S3Reactor *get_current() { return current; }
+};
+
+#endif
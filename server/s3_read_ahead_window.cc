@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "s3_read_ahead_window.h"
+
+// Client is considered to keep up if less than this part of the last read is
+// still in the output buffer when the next read completes.
+#define S3_READ_AHEAD_DRAINED_FRACTION 4
+
+S3ReadAheadWindow::S3ReadAheadWindow(size_t initial_blocks, size_t max_blocks)
+    : min_blocks(1), max_blocks(max_blocks), blocks(initial_blocks) {
+  if (this->max_blocks < min_blocks) {
+    this->max_blocks = min_blocks;
+  }
+  if (blocks < min_blocks) {
+    blocks = min_blocks;
+  } else if (blocks > this->max_blocks) {
+    blocks = this->max_blocks;
+  }
+}
+
+void S3ReadAheadWindow::on_read_complete(size_t bytes_read,
+                                         size_t bytes_outstanding,
+                                         bool f_memory_available) {
+  ++reads_count;
+  if (blocks > max_blocks_used) {
+    max_blocks_used = blocks;
+  }
+  if (bytes_outstanding > bytes_read) {
+    shrink();
+  } else if (bytes_outstanding <= bytes_read / S3_READ_AHEAD_DRAINED_FRACTION &&
+             f_memory_available) {
+    grow();
+  }
+}
+
+void S3ReadAheadWindow::on_throttled() {
+  ++throttle_count;
+  shrink();
+}
+
+void S3ReadAheadWindow::grow() {
+  if (blocks < max_blocks) {
+    blocks = (blocks * 2 < max_blocks) ? blocks * 2 : max_blocks;
+    ++grow_count;
+  }
+}
+
+void S3ReadAheadWindow::shrink() {
+  if (blocks > min_blocks) {
+    blocks = (blocks / 2 > min_blocks) ? blocks / 2 : min_blocks;
+    ++shrink_count;
+  }
+}
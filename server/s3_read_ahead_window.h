@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_READ_AHEAD_WINDOW_H__
+#define __S3_SERVER_S3_READ_AHEAD_WINDOW_H__
+
+#include <cstddef>
+
+// Number of Motr units a GET request reads per operation, adapted to how fast
+// the client drains the response.
+//
+// After every completed read the caller reports how many bytes of earlier
+// reads are still waiting in the connection's output buffer:
+// - nothing (or almost nothing) left: the client is waiting for Motr, so the
+//   window is doubled, as long as the memory pool has room for it;
+// - more than the last read left: the client is slower than Motr, so the
+//   window is halved and the request holds less memory.
+// A throttled read (output buffer or memory pool limits hit) halves it too.
+
+class S3ReadAheadWindow {
+  size_t min_blocks;
+  size_t max_blocks;
+  size_t blocks;
+
+  // Per request statistics
+  size_t reads_count = 0;
+  size_t grow_count = 0;
+  size_t shrink_count = 0;
+  size_t throttle_count = 0;
+  size_t max_blocks_used = 0;
+
+ public:
+  S3ReadAheadWindow(size_t initial_blocks, size_t max_blocks);
+
+  size_t get_blocks() const { return blocks; }
+  size_t get_max_blocks() const { return max_blocks; }
+
+  // Called when 'bytes_read' were read and are about to be sent to client,
+  // while 'bytes_outstanding' of previous reads are not yet written to the
+  // client socket. 'f_memory_available' tells whether the memory pool can
+  // take a bigger window.
+  void on_read_complete(size_t bytes_read, size_t bytes_outstanding,
+                        bool f_memory_available);
+  void on_throttled();
+
+  size_t get_reads_count() const { return reads_count; }
+  size_t get_grow_count() const { return grow_count; }
+  size_t get_shrink_count() const { return shrink_count; }
+  size_t get_throttle_count() const { return throttle_count; }
+  size_t get_max_blocks_used() const { return max_blocks_used; }
+
+ private:
+  void grow();
+  void shrink();
+};
+
+#endif  // __S3_SERVER_S3_READ_AHEAD_WINDOW_H__
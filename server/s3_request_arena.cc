@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <new>
+#include <vector>
+
+#include "s3_option.h"
+#include "s3_request_arena.h"
+
+// Idle arenas kept by one thread, beyond that released arenas are freed
+static const size_t MAX_POOLED_ARENAS = 256;
+
+// Arenas are given back by the thread dropping the last reference, which is
+// normally the loop that served the request, so every thread has its own
+// pool and no lock is taken.
+struct S3RequestArenaPool {
+  std::vector<S3RequestArena *> arenas;
+
+  S3RequestArenaPool() { arenas.reserve(MAX_POOLED_ARENAS); }
+  ~S3RequestArenaPool() {
+    for (S3RequestArena *arena : arenas) {
+      delete arena;
+    }
+  }
+};
+
+static thread_local S3RequestArenaPool arena_pool;
+
+S3RequestArena::S3RequestArena(size_t chunk_size)
+    : first_chunk(nullptr),
+      extra_chunks(nullptr),
+      cur(nullptr),
+      end(nullptr),
+      chunk_size(chunk_size),
+      ref_count(0),
+      allocation_count(0),
+      heap_chunk_count(0),
+      bytes_allocated(0) {}
+
+S3RequestArena::~S3RequestArena() {
+  reset();
+  free(first_chunk);
+}
+
+S3RequestArena *S3RequestArena::acquire() {
+  size_t chunk_size = S3Option::get_instance()->get_s3_request_arena_size();
+  if (chunk_size == 0) {
+    return nullptr;
+  }
+  S3RequestArena *arena = nullptr;
+  if (!arena_pool.arenas.empty()) {
+    arena = arena_pool.arenas.back();
+    arena_pool.arenas.pop_back();
+    if (arena->chunk_size != chunk_size) {
+      delete arena;
+      arena = nullptr;
+    }
+  }
+  if (!arena) {
+    arena = new S3RequestArena(chunk_size);
+  }
+  arena->ref_count.store(1, std::memory_order_relaxed);
+  return arena;
+}
+
+void S3RequestArena::release() {
+  if (ref_count.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+  reset();
+  if (arena_pool.arenas.size() < MAX_POOLED_ARENAS) {
+    arena_pool.arenas.push_back(this);
+  } else {
+    delete this;
+  }
+}
+
+void S3RequestArena::reset() {
+  while (extra_chunks) {
+    Chunk *next = extra_chunks->next;
+    free(extra_chunks);
+    extra_chunks = next;
+  }
+  if (first_chunk) {
+    cur = (char *)(first_chunk + 1);
+    end = (char *)first_chunk + first_chunk->size;
+  }
+  allocation_count = 0;
+  heap_chunk_count = 0;
+  bytes_allocated = 0;
+}
+
+void *S3RequestArena::allocate_from_new_chunk(size_t size, size_t alignment) {
+  size_t needed = sizeof(Chunk) + size + alignment;
+  // Objects too big for a chunk get one of their own, the current chunk
+  // keeps serving the small ones. Only the first chunk is kept for the next
+  // request.
+  bool dedicated = needed > chunk_size;
+  size_t new_size = dedicated ? needed : chunk_size;
+  Chunk *chunk = (Chunk *)malloc(new_size);
+  if (!chunk) {
+    throw std::bad_alloc();
+  }
+  chunk->size = new_size;
+  if (!first_chunk && !dedicated) {
+    chunk->next = nullptr;
+    first_chunk = chunk;
+  } else {
+    chunk->next = extra_chunks;
+    extra_chunks = chunk;
+  }
+  ++heap_chunk_count;
+
+  char *p = (char *)((((uintptr_t)(chunk + 1)) + alignment - 1) &
+                     ~(alignment - 1));
+  if (!dedicated) {
+    cur = p + size;
+    end = (char *)chunk + new_size;
+  }
+  return p;
+}
+
+size_t S3RequestArena::get_pooled_count() { return arena_pool.arenas.size(); }
+
+void S3RequestArena::clear_pool() {
+  for (S3RequestArena *arena : arena_pool.arenas) {
+    delete arena;
+  }
+  arena_pool.arenas.clear();
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_REQUEST_ARENA_H__
+#define __S3_SERVER_S3_REQUEST_ARENA_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+// Monotonic memory of one request. Objects living as long as the request
+// (API handler, action, its task lists, KVS readers) are carved out of
+// chunks instead of being malloc'ed one by one; nothing is freed until the
+// request and every object allocated from the arena are gone. The arena is
+// then reset and kept in a pool of the thread for the next request, so the
+// chunk is reused rather than returned to malloc.
+//
+// Allocations are made on the loop serving the request. References are
+// counted atomically and may be dropped on any thread.
+class S3RequestArena {
+  struct Chunk {
+    Chunk *next;
+    size_t size;
+  };
+
+  // Chunk of chunk_size kept across requests, and chunks added to serve
+  // this request which are freed on reset
+  Chunk *first_chunk;
+  Chunk *extra_chunks;
+  char *cur;
+  char *end;
+  size_t chunk_size;
+
+  std::atomic<unsigned> ref_count;
+
+  unsigned allocation_count;
+  unsigned heap_chunk_count;
+  size_t bytes_allocated;
+
+  explicit S3RequestArena(size_t chunk_size);
+  ~S3RequestArena();
+
+  void reset();
+  void *allocate_from_new_chunk(size_t size, size_t alignment);
+
+  friend struct S3RequestArenaPool;
+
+ public:
+  S3RequestArena(const S3RequestArena &) = delete;
+  S3RequestArena &operator=(const S3RequestArena &) = delete;
+
+  // Arena of a new request, holding one reference. Returns nullptr when
+  // S3_REQUEST_ARENA_SIZE is 0.
+  static S3RequestArena *acquire();
+
+  void add_ref() { ref_count.fetch_add(1, std::memory_order_relaxed); }
+  // Last reference gives the arena back to the pool of the calling thread
+  void release();
+
+  void *allocate(size_t size, size_t alignment) {
+    ++allocation_count;
+    bytes_allocated += size;
+    if (cur) {
+      char *p = (char *)(((uintptr_t)cur + alignment - 1) & ~(alignment - 1));
+      if (p <= end && size <= (size_t)(end - p)) {
+        cur = p + size;
+        return p;
+      }
+    }
+    return allocate_from_new_chunk(size, alignment);
+  }
+
+  unsigned get_allocation_count() const { return allocation_count; }
+  // Chunks malloc'ed while serving the request, 0 when it fit the pool
+  unsigned get_heap_chunk_count() const { return heap_chunk_count; }
+  size_t get_bytes_allocated() const { return bytes_allocated; }
+
+  // Arenas waiting in the pool of the calling thread
+  static size_t get_pooled_count();
+  // Frees the arenas pooled by the calling thread
+  static void clear_pool();
+};
+
+// STL allocator drawing from a request arena; deallocate() is a no-op.
+// With no arena it falls back to the heap, so containers and objects of
+// requests without one behave as before.
+template <class T>
+class S3ArenaAllocator {
+  template <class U>
+  friend class S3ArenaAllocator;
+
+  S3RequestArena *arena;
+
+ public:
+  typedef T value_type;
+  typedef std::true_type propagate_on_container_move_assignment;
+
+  explicit S3ArenaAllocator(S3RequestArena *arena = nullptr) : arena(arena) {
+    if (arena) {
+      arena->add_ref();
+    }
+  }
+  S3ArenaAllocator(const S3ArenaAllocator &other)
+      : S3ArenaAllocator(other.arena) {}
+  template <class U>
+  S3ArenaAllocator(const S3ArenaAllocator<U> &other)
+      : S3ArenaAllocator(other.arena) {}
+  ~S3ArenaAllocator() {
+    if (arena) {
+      arena->release();
+    }
+  }
+
+  S3ArenaAllocator &operator=(const S3ArenaAllocator &other) {
+    S3ArenaAllocator tmp(other);
+    std::swap(arena, tmp.arena);
+    return *this;
+  }
+
+  T *allocate(size_t n) {
+    if (arena) {
+      return (T *)arena->allocate(n * sizeof(T), alignof(T));
+    }
+    return (T *)::operator new(n * sizeof(T));
+  }
+
+  void deallocate(T *p, size_t) {
+    if (!arena) {
+      ::operator delete(p);
+    }
+  }
+
+  S3RequestArena *get_arena() const { return arena; }
+
+  template <class U>
+  bool operator==(const S3ArenaAllocator<U> &other) const {
+    return arena == other.arena;
+  }
+  template <class U>
+  bool operator!=(const S3ArenaAllocator<U> &other) const {
+    return arena != other.arena;
+  }
+};
+
+// std::make_shared() of a request scoped object, object and its control
+// block are allocated from the arena if there is one
+template <class T, class... Args>
+std::shared_ptr<T> s3_arena_make_shared(S3RequestArena *arena,
+                                        Args &&... args) {
+  if (arena) {
+    return std::allocate_shared<T>(S3ArenaAllocator<T>(arena),
+                                   std::forward<Args>(args)...);
+  }
+  return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+#endif
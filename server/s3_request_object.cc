@@ -55,6 +55,7 @@ S3RequestObject::S3RequestObject(
 
 S3RequestObject::~S3RequestObject() {
   s3_log(S3_LOG_DEBUG, request_id, "%s\n", __func__);
+  log_api_stats();
   populate_and_log_audit_info();
 }
 
@@ -125,6 +126,47 @@ void S3RequestObject::set_default_acl(const std::string& acl) {
 
 const std::string& S3RequestObject::get_default_acl() { return default_acl; }
 
+void S3RequestObject::log_api_stats() {
+  if (!g_stats_aggregator) {
+    return;
+  }
+  const char* http_entry = get_http_verb_str(http_verb());
+  std::string s3_operation_str =
+      operation_code_to_audit_str(get_operation_code());
+  std::string api = std::string(http_entry ? http_entry : "UNKNOWN") + "_" +
+                    api_type_to_str(get_api_type());
+  if (s3_operation_str != "NONE" && s3_operation_str != "UNKNOWN") {
+    api += "_" + s3_operation_str;
+  }
+  std::string labels = "api=\"" + api + "\"";
+
+  auto request_time_ns = request_timer.elapsed_time_in_nanosec();
+  if (request_time_ns >= 0) {
+    g_stats_aggregator->timing("api_request_time", request_time_ns / 1000,
+                               labels);
+  }
+  for (int phase = 0; phase < (int)S3RequestPhase::count; ++phase) {
+    if (phase_time_us[phase]) {
+      g_stats_aggregator->timing(
+          "api_phase_time", phase_time_us[phase],
+          labels + ",phase=\"" +
+              s3_request_phase_to_str((S3RequestPhase)phase) + "\"");
+    }
+  }
+  g_stats_aggregator->count(
+      "api_request_count", 1,
+      labels + ",status=\"" + std::to_string(http_status / 100) + "xx\"");
+  // Divided by api_request_count, allocations per request the API made from
+  // its arena and the mallocs the arena needed for them
+  S3RequestArena* arena = get_arena();
+  if (arena) {
+    g_stats_aggregator->count("api_arena_allocations",
+                              arena->get_allocation_count(), labels);
+    g_stats_aggregator->count("api_arena_heap_chunks",
+                              arena->get_heap_chunk_count(), labels);
+  }
+}
+
 void S3RequestObject::populate_and_log_audit_info() {
   s3_log(S3_LOG_DEBUG, request_id, "%s Entry", __func__);
   if (S3Option::get_instance()->get_audit_logger_policy() == "disabled") {
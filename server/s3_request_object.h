@@ -77,6 +77,8 @@ class S3RequestObject : public RequestObject {
   void set_operation_code(S3OperationCode operation_code);
   virtual S3OperationCode get_operation_code();
   virtual void populate_and_log_audit_info();
+  // Request time, phase times and status per API, to aggregated stats
+  void log_api_stats();
   virtual void set_response_started_by_action(bool response_started) {
     response_started_by_action = response_started;
   }
@@ -34,13 +34,15 @@ void S3ServiceAPIHandler::create_action() {
       switch (request->http_verb()) {
         case S3HttpVerb::GET:
           request->set_action_str("ListAllMyBuckets");
-          action = std::make_shared<S3GetServiceAction>(request);
+          action = s3_arena_make_shared<S3GetServiceAction>(
+              request->get_arena(), request);
           s3_stats_inc("get_service_request_count");
           break;
         case S3HttpVerb::HEAD:
           request->set_action_str("HeadService");
           request->set_head_service();
-          action = std::make_shared<S3HeadServiceAction>(request);
+          action = s3_arena_make_shared<S3HeadServiceAction>(
+              request->get_arena(), request);
           s3_stats_inc("health_check_request_count");
           break;
         default:
@@ -19,8 +19,8 @@
  */
 
 #include "s3_service_list_response.h"
-#include "s3_common_utilities.h"
 #include "s3_log.h"
+#include "s3_xml_writer.h"
 
 S3ServiceListResponse::S3ServiceListResponse() {
   s3_log(S3_LOG_DEBUG, "", "%s Ctor\n", __func__);
@@ -40,29 +40,29 @@ void S3ServiceListResponse::add_bucket(
   bucket_list.push_back(bucket);
 }
 
-// clang-format off
 std::string& S3ServiceListResponse::get_xml() {
-  response_xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
-  response_xml +=
+  response_xml.clear();
+  S3XmlWriter xml(response_xml);
+  // Fixed part and about 128 bytes per bucket
+  xml.reserve(512 + bucket_list.size() * 128);
+
+  xml.add_raw("<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
+  xml.add_raw(
       "<ListAllMyBucketsResult "
-      "xmlns=\"http://s3.amazonaws.com/doc/2006-03-01\">";
-  response_xml += "<Owner>";
-  response_xml += S3CommonUtilities::format_xml_string("ID", owner_id);
-  response_xml +=
-      S3CommonUtilities::format_xml_string("DisplayName", owner_name);
-  response_xml += "</Owner>";
-  response_xml += "<Buckets>";
+      "xmlns=\"http://s3.amazonaws.com/doc/2006-03-01\">");
+  xml.open_element("Owner");
+  xml.add_element("ID", owner_id);
+  xml.add_element("DisplayName", owner_name);
+  xml.close_element("Owner");
+  xml.open_element("Buckets");
   for (auto&& bucket : bucket_list) {
-    response_xml += "<Bucket>";
-    response_xml +=
-        S3CommonUtilities::format_xml_string("Name", bucket->get_bucket_name());
-    response_xml += S3CommonUtilities::format_xml_string(
-        "CreationDate", bucket->get_creation_time());
-    response_xml += "</Bucket>";
+    xml.open_element("Bucket");
+    xml.add_element("Name", bucket->get_bucket_name());
+    xml.add_element("CreationDate", bucket->get_creation_time());
+    xml.close_element("Bucket");
   }
-  response_xml += "</Buckets>";
-  response_xml += "</ListAllMyBucketsResult>";
+  xml.close_element("Buckets");
+  xml.add_raw("</ListAllMyBucketsResult>");
 
   return response_xml;
 }
-// clang-format on
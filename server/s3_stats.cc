@@ -88,6 +88,34 @@ int S3Stats::count_unique(const std::string& key, const std::string& value,
   return form_and_send_msg(key, "s", value, retry, 1.0);
 }
 
+int S3Stats::send_batch(
+    const std::vector<std::pair<std::string, std::string>>& msgs, int retry) {
+  // Stays below the usual MTU, as StatsD reads one datagram at a time
+  const size_t max_datagram_size = 1432;
+  std::string datagram;
+  int rc = 0;
+  for (const auto& msg : msgs) {
+    if (!is_allowed_to_publish(msg.first)) {
+      continue;
+    }
+    if (!datagram.empty() &&
+        datagram.size() + 1 + msg.second.size() > max_datagram_size) {
+      if (send(datagram, retry) != 0) {
+        rc = -1;
+      }
+      datagram.clear();
+    }
+    if (!datagram.empty()) {
+      datagram += '\n';
+    }
+    datagram += msg.second;
+  }
+  if (!datagram.empty() && send(datagram, retry) != 0) {
+    rc = -1;
+  }
+  return rc;
+}
+
 int S3Stats::load_allowlist() {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
   std::string allowlist_filename =
@@ -184,6 +212,7 @@ int S3Stats::send(const std::string& msg, int retry) {
   } else if (retry < 0) {
     retry = 0;
   }
+  std::lock_guard<std::mutex> lock(send_lock);
   while (1) {
     if (socket_obj->sendto(sock, msg.c_str(), msg.length(), 0,
                            (struct sockaddr*)&server, sizeof(server)) == -1) {
@@ -249,23 +278,39 @@ int s3_stats_init() {
   if (!g_stats_instance) {
     g_stats_instance = S3Stats::get_instance();
   }
-  if (g_stats_instance) {
-    return 0;
-  } else {
+  if (!g_stats_instance) {
     return -1;
   }
+  if (g_option_instance->is_stats_aggregate_enabled() && !g_stats_aggregator) {
+    g_stats_aggregator = new S3StatsAggregator();
+  }
+  return 0;
 }
 
 void s3_stats_fini() {
   if (!g_option_instance->is_stats_enabled()) {
     return;
   }
+  if (g_stats_aggregator) {
+    s3_stats_flush();
+    delete g_stats_aggregator;
+    g_stats_aggregator = NULL;
+  }
   if (g_stats_instance) {
     S3Stats::delete_instance();
     g_stats_instance = NULL;
   }
 }
 
+void s3_stats_flush() {
+  if (!g_stats_aggregator || !g_stats_instance) {
+    return;
+  }
+  std::vector<std::pair<std::string, std::string>> msgs;
+  g_stats_aggregator->collect_statsd(msgs);
+  g_stats_instance->send_batch(msgs);
+}
+
 int s3_stats_timing(const std::string& key, size_t value, int retry,
                     float sample_rate) {
 
@@ -277,5 +322,9 @@ int s3_stats_timing(const std::string& key, size_t value, int retry,
     errno = EINVAL;
     return -1;
   }
+  if (g_stats_aggregator) {
+    g_stats_aggregator->timing(key, value * 1000);
+    return 0;
+  }
   return g_stats_instance->timing(key, value, retry, sample_rate);
 }
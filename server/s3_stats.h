@@ -27,10 +27,12 @@
 #include <math.h>
 #include <limits>
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include "s3_log.h"
 #include "s3_option.h"
+#include "s3_stats_aggregator.h"
 #include "socket_wrapper.h"
 
 class S3Stats {
@@ -56,6 +58,11 @@ class S3Stats {
   int count_unique(const std::string& key, const std::string& value,
                    int retry = 1);
 
+  // Send (metric name, message) pairs of allowed metrics, as many messages
+  // per datagram as fit
+  int send_batch(const std::vector<std::pair<std::string, std::string>>& msgs,
+                 int retry = 1);
+
  private:
   S3Stats(const std::string& host_addr, const unsigned short port_num,
           SocketInterface* socket_obj_ptr = NULL)
@@ -107,6 +114,8 @@ class S3Stats {
   int sock;
   struct sockaddr_in server;
   std::unique_ptr<SocketInterface> socket_obj;
+  // Metrics are sent from every reactor
+  std::mutex send_lock;
 
   // metrics allowlist
   std::unordered_set<std::string> metrics_allowlist;
@@ -115,20 +124,28 @@ class S3Stats {
   FRIEND_TEST(S3StatsTest, Allowlist);
   FRIEND_TEST(S3StatsTest, S3StatsSendMustSucceedIfSocketSendToSucceeds);
   FRIEND_TEST(S3StatsTest, S3StatsSendMustRetryAndFailIfRetriesFail);
+  FRIEND_TEST(S3StatsTest, SendBatchPacksAllowedMessages);
 };
 
 extern S3Option* g_option_instance;
 extern S3Stats* g_stats_instance;
 
 // Utility Wrappers for StatsD
+// With S3_STATS_AGGREGATE the wrappers record into g_stats_aggregator, which
+// is flushed to StatsD by s3_stats_flush() and served in Prometheus format.
 int s3_stats_init();
 void s3_stats_fini();
+void s3_stats_flush();
 
 static inline int s3_stats_inc(const std::string& key, int retry = 1,
                                float sample_rate = 1.0) {
   if (!g_option_instance->is_stats_enabled()) {
     return 0;
   }
+  if (g_stats_aggregator) {
+    g_stats_aggregator->count(key, 1);
+    return 0;
+  }
   return g_stats_instance->count(key, 1, retry, sample_rate);
 }
 
@@ -137,6 +154,10 @@ static inline int s3_stats_dec(const std::string& key, int retry = 1,
   if (!g_option_instance->is_stats_enabled()) {
     return 0;
   }
+  if (g_stats_aggregator) {
+    g_stats_aggregator->count(key, -1);
+    return 0;
+  }
   return g_stats_instance->count(key, -1, retry, sample_rate);
 }
 
@@ -145,17 +166,33 @@ static inline int s3_stats_count(const std::string& key, int64_t value,
   if (!g_option_instance->is_stats_enabled()) {
     return 0;
   }
+  if (g_stats_aggregator) {
+    g_stats_aggregator->count(key, value);
+    return 0;
+  }
   return g_stats_instance->count(key, value, retry, sample_rate);
 }
 
 int s3_stats_timing(const std::string& key, size_t value, int retry = 1,
                     float sample_rate = 1.0);
 
+// Time in us, only kept when stats are aggregated
+static inline void s3_stats_timing_us(const std::string& key, uint64_t value,
+                                      const std::string& labels = "") {
+  if (g_stats_aggregator) {
+    g_stats_aggregator->timing(key, value, labels);
+  }
+}
+
 static inline int s3_stats_set_gauge(const std::string& key, int value,
                                      int retry = 1) {
   if (!g_option_instance->is_stats_enabled()) {
     return 0;
   }
+  if (g_stats_aggregator) {
+    g_stats_aggregator->set_gauge(key, value);
+    return 0;
+  }
   return g_stats_instance->set_gauge(key, value, retry);
 }
 
@@ -164,6 +201,10 @@ static inline int s3_stats_update_gauge(const std::string& key, int value,
   if (!g_option_instance->is_stats_enabled()) {
     return 0;
   }
+  if (g_stats_aggregator) {
+    g_stats_aggregator->update_gauge(key, value);
+    return 0;
+  }
   return g_stats_instance->update_gauge(key, value, retry);
 }
 
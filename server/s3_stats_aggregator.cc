@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "s3_stats_aggregator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <functional>
+
+#include "s3_log.h"
+
+S3StatsAggregator* g_stats_aggregator = NULL;
+
+const unsigned S3StatsHistogram::MAX_VALUE_BITS;
+const unsigned S3StatsHistogram::SUB_BUCKET_BITS;
+const unsigned S3StatsHistogram::SUB_BUCKET_COUNT;
+const unsigned S3StatsHistogram::BUCKET_COUNT;
+const size_t S3StatsAggregator::TABLE_SIZE;
+
+const char* s3_request_phase_to_str(S3RequestPhase phase) {
+  switch (phase) {
+    case S3RequestPhase::auth:
+      return "auth";
+    case S3RequestPhase::bucket_metadata:
+      return "bucket_metadata";
+    case S3RequestPhase::object_metadata:
+      return "object_metadata";
+    case S3RequestPhase::data_io:
+      return "data_io";
+    default:
+      return "unknown";
+  }
+}
+
+S3StatsHistogram::S3StatsHistogram() : count(0), sum(0) {
+  for (auto& bucket : buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+unsigned S3StatsHistogram::get_bucket_index(uint64_t value) {
+  if (value < SUB_BUCKET_COUNT) {
+    return (unsigned)value;
+  }
+  if (value >> MAX_VALUE_BITS) {
+    return BUCKET_COUNT - 1;
+  }
+  unsigned msb = 63 - __builtin_clzll(value);
+  unsigned shift = msb - SUB_BUCKET_BITS;
+  // Octave of the value, then its top bits below the leading one
+  return (shift + 1) * SUB_BUCKET_COUNT +
+         (unsigned)(value >> shift) - SUB_BUCKET_COUNT;
+}
+
+uint64_t S3StatsHistogram::get_bucket_upper(unsigned index) {
+  if (index < SUB_BUCKET_COUNT) {
+    return index;
+  }
+  unsigned shift = index / SUB_BUCKET_COUNT - 1;
+  uint64_t sub_bucket = index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void S3StatsHistogram::record(uint64_t value) {
+  buckets[get_bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+  count.fetch_add(1, std::memory_order_relaxed);
+  sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+void S3StatsHistogram::snapshot(std::vector<uint64_t>& counts) const {
+  counts.resize(BUCKET_COUNT);
+  for (unsigned i = 0; i < BUCKET_COUNT; ++i) {
+    counts[i] = buckets[i].load(std::memory_order_relaxed);
+  }
+}
+
+uint64_t S3StatsHistogram::get_value_at_percentile(
+    const std::vector<uint64_t>& counts, double percentile) {
+  uint64_t total = 0;
+  for (auto n : counts) {
+    total += n;
+  }
+  if (!total) {
+    return 0;
+  }
+  uint64_t rank = (uint64_t)(percentile / 100 * total + 0.5);
+  rank = std::max<uint64_t>(std::min(rank, total), 1);
+  uint64_t seen = 0;
+  for (unsigned i = 0; i < counts.size(); ++i) {
+    seen += counts[i];
+    if (seen >= rank) {
+      return get_bucket_upper(i);
+    }
+  }
+  return get_bucket_upper(BUCKET_COUNT - 1);
+}
+
+S3StatsMetric::S3StatsMetric(const std::string& name, const std::string& labels,
+                             S3StatsMetricType type)
+    : name(name), labels(labels), type(type), value(0) {
+  if (type == S3StatsMetricType::timing) {
+    histogram.reset(new S3StatsHistogram());
+  }
+}
+
+S3StatsAggregator::S3StatsAggregator()
+    : table(new std::atomic<S3StatsMetric*>[TABLE_SIZE]),
+      table_full_logged(false) {
+  for (size_t i = 0; i < TABLE_SIZE; ++i) {
+    table[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+S3StatsAggregator::~S3StatsAggregator() {
+  for (size_t i = 0; i < TABLE_SIZE; ++i) {
+    delete table[i].load(std::memory_order_relaxed);
+  }
+}
+
+S3StatsMetric* S3StatsAggregator::get_metric(const std::string& name,
+                                             const std::string& labels,
+                                             S3StatsMetricType type) {
+  size_t hash = std::hash<std::string>()(name) * 31 +
+                std::hash<std::string>()(labels) + (size_t)type;
+  std::unique_ptr<S3StatsMetric> new_metric;
+  for (size_t probe = 0; probe < TABLE_SIZE; ++probe) {
+    std::atomic<S3StatsMetric*>& slot = table[(hash + probe) % TABLE_SIZE];
+    S3StatsMetric* metric = slot.load(std::memory_order_acquire);
+    if (!metric) {
+      if (!new_metric) {
+        new_metric.reset(new S3StatsMetric(name, labels, type));
+      }
+      if (slot.compare_exchange_strong(metric, new_metric.get(),
+                                       std::memory_order_acq_rel)) {
+        return new_metric.release();
+      }
+      // Another thread took the slot, metric is what it put there
+    }
+    if (metric->type == type && metric->name == name &&
+        metric->labels == labels) {
+      return metric;
+    }
+  }
+  if (!table_full_logged.exchange(true)) {
+    s3_log(S3_LOG_ERROR, "",
+           "Stats table is full, metric %s and later new ones are dropped\n",
+           name.c_str());
+  }
+  return nullptr;
+}
+
+void S3StatsAggregator::count(const std::string& name, int64_t value,
+                              const std::string& labels) {
+  S3StatsMetric* metric = get_metric(name, labels, S3StatsMetricType::counter);
+  if (metric) {
+    metric->value.fetch_add(value, std::memory_order_relaxed);
+  }
+}
+
+void S3StatsAggregator::set_gauge(const std::string& name, int64_t value,
+                                  const std::string& labels) {
+  S3StatsMetric* metric = get_metric(name, labels, S3StatsMetricType::gauge);
+  if (metric) {
+    metric->value.store(value, std::memory_order_relaxed);
+  }
+}
+
+void S3StatsAggregator::update_gauge(const std::string& name, int64_t value,
+                                     const std::string& labels) {
+  S3StatsMetric* metric = get_metric(name, labels, S3StatsMetricType::gauge);
+  if (metric) {
+    metric->value.fetch_add(value, std::memory_order_relaxed);
+  }
+}
+
+void S3StatsAggregator::timing(const std::string& name, uint64_t time_us,
+                               const std::string& labels) {
+  S3StatsMetric* metric = get_metric(name, labels, S3StatsMetricType::timing);
+  if (metric) {
+    metric->histogram->record(time_us);
+  }
+}
+
+std::vector<S3StatsMetric*> S3StatsAggregator::get_metrics_sorted() const {
+  std::vector<S3StatsMetric*> metrics;
+  for (size_t i = 0; i < TABLE_SIZE; ++i) {
+    S3StatsMetric* metric = table[i].load(std::memory_order_acquire);
+    if (metric) {
+      metrics.push_back(metric);
+    }
+  }
+  // Series of one metric name must be listed together
+  std::sort(metrics.begin(), metrics.end(),
+            [](const S3StatsMetric* a, const S3StatsMetric* b) {
+    if (a->name != b->name) {
+      return a->name < b->name;
+    }
+    if (a->type != b->type) {
+      return a->type < b->type;
+    }
+    return a->labels < b->labels;
+  });
+  return metrics;
+}
+
+static std::string prometheus_name(const std::string& name) {
+  std::string out = "s3server_" + name;
+  for (auto& ch : out) {
+    if (!isalnum((unsigned char)ch) && ch != '_' && ch != ':') {
+      ch = '_';
+    }
+  }
+  return out;
+}
+
+static std::string prometheus_labels(const std::string& labels,
+                                     const std::string& extra = "") {
+  if (labels.empty() && extra.empty()) {
+    return "";
+  }
+  if (labels.empty() || extra.empty()) {
+    return "{" + labels + extra + "}";
+  }
+  return "{" + labels + "," + extra + "}";
+}
+
+std::string S3StatsAggregator::format_prometheus() const {
+  std::string out;
+  char buf[64];
+  std::string last_type_line;
+  std::vector<uint64_t> counts;
+
+  for (const S3StatsMetric* metric : get_metrics_sorted()) {
+    std::string name = prometheus_name(metric->name);
+    const char* type = "counter";
+    if (metric->type == S3StatsMetricType::gauge) {
+      type = "gauge";
+    } else if (metric->type == S3StatsMetricType::timing) {
+      type = "histogram";
+      name += "_seconds";
+    }
+    std::string type_line = "# TYPE " + name + " " + type + "\n";
+    if (type_line != last_type_line) {
+      out += type_line;
+      last_type_line = type_line;
+    }
+
+    if (metric->type != S3StatsMetricType::timing) {
+      snprintf(buf, sizeof(buf), " %" PRId64 "\n",
+               metric->value.load(std::memory_order_relaxed));
+      out += name + prometheus_labels(metric->labels) + buf;
+      continue;
+    }
+
+    // Buckets of the histogram summed up per power of two, up to the
+    // highest one in use. Values are whole microseconds, so the highest
+    // value of a bucket is its inclusive "le" bound.
+    metric->histogram->snapshot(counts);
+    unsigned last = 0;
+    for (unsigned i = 0; i < counts.size(); ++i) {
+      if (counts[i]) {
+        last = i;
+      }
+    }
+    uint64_t cumulative = 0;
+    for (unsigned i = 0; i < counts.size(); ++i) {
+      cumulative += counts[i];
+      if (i % S3StatsHistogram::SUB_BUCKET_COUNT !=
+          S3StatsHistogram::SUB_BUCKET_COUNT - 1) {
+        continue;
+      }
+      // Last bucket also holds larger values, only +Inf bounds it
+      if (i == S3StatsHistogram::BUCKET_COUNT - 1) {
+        break;
+      }
+      snprintf(buf, sizeof(buf), "le=\"%g\"",
+               S3StatsHistogram::get_bucket_upper(i) / 1e6);
+      out += name + "_bucket" + prometheus_labels(metric->labels, buf);
+      out += " " + std::to_string(cumulative) + "\n";
+      if (i >= last) {
+        break;
+      }
+    }
+    uint64_t total = metric->histogram->get_count();
+    out += name + "_bucket" +
+           prometheus_labels(metric->labels, "le=\"+Inf\"") + " " +
+           std::to_string(std::max(total, cumulative)) + "\n";
+    snprintf(buf, sizeof(buf), " %.6f\n", metric->histogram->get_sum() / 1e6);
+    out += name + "_sum" + prometheus_labels(metric->labels) + buf;
+    out += name + "_count" + prometheus_labels(metric->labels) + " " +
+           std::to_string(std::max(total, cumulative)) + "\n";
+  }
+  return out;
+}
+
+// StatsD name of a labelled metric: values of its labels appended
+static std::string statsd_key(const S3StatsMetric* metric) {
+  std::string key = metric->name;
+  size_t pos = 0;
+  while ((pos = metric->labels.find('"', pos)) != std::string::npos) {
+    size_t end = metric->labels.find('"', pos + 1);
+    if (end == std::string::npos) {
+      break;
+    }
+    key += "_" + metric->labels.substr(pos + 1, end - pos - 1);
+    pos = end + 1;
+  }
+  return key;
+}
+
+void S3StatsAggregator::collect_statsd(
+    std::vector<std::pair<std::string, std::string>>& msgs) {
+  static const std::pair<const char*, double> percentiles[] = {
+      {"_p50", 50}, {"_p90", 90}, {"_p99", 99}, {"_p999", 99.9}};
+  char buf[64];
+  std::vector<uint64_t> counts;
+
+  for (S3StatsMetric* metric : get_metrics_sorted()) {
+    std::string key = statsd_key(metric);
+    if (metric->type != S3StatsMetricType::timing) {
+      int64_t value = metric->value.load(std::memory_order_relaxed);
+      if (value == metric->flushed_value) {
+        continue;
+      }
+      if (metric->type == S3StatsMetricType::counter) {
+        snprintf(buf, sizeof(buf), ":%" PRId64 "|c",
+                 value - metric->flushed_value);
+      } else {
+        // A signed StatsD gauge would be taken as a change
+        snprintf(buf, sizeof(buf), ":%" PRId64 "|g",
+                 std::max<int64_t>(value, 0));
+      }
+      msgs.emplace_back(metric->name, key + buf);
+      metric->flushed_value = value;
+      continue;
+    }
+
+    metric->histogram->snapshot(counts);
+    metric->flushed_counts.resize(counts.size());
+    uint64_t total = 0;
+    unsigned last = 0;
+    for (unsigned i = 0; i < counts.size(); ++i) {
+      uint64_t now = counts[i];
+      counts[i] -= metric->flushed_counts[i];
+      metric->flushed_counts[i] = now;
+      total += counts[i];
+      if (counts[i]) {
+        last = i;
+      }
+    }
+    if (!total) {
+      continue;
+    }
+    msgs.emplace_back(metric->name,
+                      key + "_count:" + std::to_string(total) + "|c");
+    for (const auto& percentile : percentiles) {
+      snprintf(buf, sizeof(buf), ":%.3f|g",
+               S3StatsHistogram::get_value_at_percentile(counts,
+                                                         percentile.second) /
+                   1000.0);
+      msgs.emplace_back(metric->name, key + percentile.first + buf);
+    }
+    snprintf(buf, sizeof(buf), "_max:%.3f|g",
+             S3StatsHistogram::get_bucket_upper(last) / 1000.0);
+    msgs.emplace_back(metric->name, key + buf);
+  }
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_STATS_AGGREGATOR_H__
+#define __S3_SERVER_S3_STATS_AGGREGATOR_H__
+
+#include <gtest/gtest_prod.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Phases of a request whose time is reported per API
+enum class S3RequestPhase {
+  auth,
+  bucket_metadata,
+  object_metadata,
+  data_io,
+  count
+};
+
+const char* s3_request_phase_to_str(S3RequestPhase phase);
+
+// Latency histogram over microseconds, 8 buckets per power of two, so
+// percentiles are within 12.5% of the recorded values. Updated with atomics
+// from any thread.
+class S3StatsHistogram {
+ public:
+  // Values up to 2^40 us (12 days), larger ones land in the last bucket
+  static const unsigned MAX_VALUE_BITS = 40;
+  static const unsigned SUB_BUCKET_BITS = 3;
+  static const unsigned SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+  static const unsigned BUCKET_COUNT =
+      (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+  S3StatsHistogram();
+
+  void record(uint64_t value);
+
+  uint64_t get_count() const { return count.load(std::memory_order_relaxed); }
+  uint64_t get_sum() const { return sum.load(std::memory_order_relaxed); }
+  void snapshot(std::vector<uint64_t>& counts) const;
+
+  static unsigned get_bucket_index(uint64_t value);
+  // Highest value of the bucket
+  static uint64_t get_bucket_upper(unsigned index);
+  static uint64_t get_value_at_percentile(const std::vector<uint64_t>& counts,
+                                          double percentile);
+
+ private:
+  std::atomic<uint64_t> buckets[BUCKET_COUNT];
+  std::atomic<uint64_t> count;
+  std::atomic<uint64_t> sum;
+};
+
+enum class S3StatsMetricType {
+  counter,
+  gauge,
+  timing
+};
+
+struct S3StatsMetric {
+  S3StatsMetric(const std::string& name, const std::string& labels,
+                S3StatsMetricType type);
+
+  const std::string name;
+  // Prometheus labels, e.g. api="PUT_OBJECT",phase="auth"
+  const std::string labels;
+  const S3StatsMetricType type;
+  std::atomic<int64_t> value;
+  std::unique_ptr<S3StatsHistogram> histogram;
+
+  // What the previous StatsD flush saw, used by the flushing thread only
+  int64_t flushed_value = 0;
+  std::vector<uint64_t> flushed_counts;
+};
+
+// In-process aggregation of stats. Metrics are looked up by name in a fixed
+// open addressing table and updated with atomics, so recording takes no lock
+// and no syscall. Metrics are never removed while the aggregator lives.
+class S3StatsAggregator {
+ public:
+  static const size_t TABLE_SIZE = 4096;
+
+  S3StatsAggregator();
+  ~S3StatsAggregator();
+
+  S3StatsAggregator(const S3StatsAggregator&) = delete;
+  S3StatsAggregator& operator=(const S3StatsAggregator&) = delete;
+
+  void count(const std::string& name, int64_t value,
+             const std::string& labels = "");
+  void set_gauge(const std::string& name, int64_t value,
+                 const std::string& labels = "");
+  void update_gauge(const std::string& name, int64_t value,
+                    const std::string& labels = "");
+  void timing(const std::string& name, uint64_t time_us,
+              const std::string& labels = "");
+
+  // All metrics in Prometheus text format, counters and histograms are
+  // totals since start
+  std::string format_prometheus() const;
+
+  // StatsD messages for what changed since the previous call, as pairs of
+  // metric name and message: counter deltas, gauges, and count, p50, p90,
+  // p99, p99.9 and max in ms of the timings recorded since then.
+  void collect_statsd(std::vector<std::pair<std::string, std::string>>& msgs);
+
+ private:
+  S3StatsMetric* get_metric(const std::string& name, const std::string& labels,
+                            S3StatsMetricType type);
+  std::vector<S3StatsMetric*> get_metrics_sorted() const;
+
+  std::unique_ptr<std::atomic<S3StatsMetric*>[]> table;
+  std::atomic<bool> table_full_logged;
+
+  FRIEND_TEST(S3StatsAggregatorTest, TableFullDropsNewMetrics);
+};
+
+extern S3StatsAggregator* g_stats_aggregator;
+
+#endif  // __S3_SERVER_S3_STATS_AGGREGATOR_H__
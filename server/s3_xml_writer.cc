@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <cstring>
+
+#include "s3_xml_writer.h"
+
+void S3XmlWriter::open_element(const char* tag) {
+  out += '<';
+  out.append(tag);
+  out += '>';
+}
+
+void S3XmlWriter::close_element(const char* tag) {
+  out.append("</", 2);
+  out.append(tag);
+  out += '>';
+}
+
+void S3XmlWriter::add_element(const char* tag, const std::string& value,
+                              bool append_quotes) {
+  // Escaping stops at NUL as with C strings
+  if (value.empty() || value[0] == '\0') {
+    out += '<';
+    out.append(tag);
+    out.append("/>", 2);
+    return;
+  }
+  open_element(tag);
+  if (append_quotes) {
+    out += '"';
+  }
+  append_escaped(out, value);
+  if (append_quotes) {
+    out += '"';
+  }
+  close_element(tag);
+}
+
+void S3XmlWriter::append_escaped(std::string& xml, const std::string& value) {
+  const char* p = value.c_str();
+
+  for (;;) {
+    // Copy the longest run without special characters at once,
+    // it ends at a special character or NUL
+    const size_t run_length = ::strcspn(p, "<>&\"\r");
+    xml.append(p, run_length);
+    p += run_length;
+    if (*p == '\0') {
+      break;
+    }
+    switch (*p) {
+      case '<':
+        xml.append("&lt;", 4);
+        break;
+      case '>':
+        xml.append("&gt;", 4);
+        break;
+      case '&':
+        xml.append("&amp;", 5);
+        break;
+      case '"':
+        xml.append("&quot;", 6);
+        break;
+      default:
+        xml.append("&#13;", 5);
+    }
+    ++p;
+  }
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_XML_WRITER_H__
+#define __S3_SERVER_S3_XML_WRITER_H__
+
+#include <string>
+
+// Appends XML to a string in a single pass.  Element values are escaped the
+// same way as xmlEncodeSpecialChars() does, directly into the output,
+// without a temporary string per element.
+class S3XmlWriter {
+  std::string& out;
+
+ public:
+  // Output is appended to 'xml', reserve its capacity up front with
+  // reserve() when the size of the document can be estimated.
+  explicit S3XmlWriter(std::string& xml) : out(xml) {}
+
+  void reserve(size_t size) { out.reserve(out.size() + size); }
+
+  // Text which doesn't need escaping, such as the XML declaration
+  void add_raw(const char* text) { out.append(text); }
+  // <tag>
+  void open_element(const char* tag);
+  // </tag>
+  void close_element(const char* tag);
+  // <tag>escaped value</tag>, or <tag/> for an empty value.
+  // With 'append_quotes' the escaped value is put in double quotes (ETag).
+  void add_element(const char* tag, const std::string& value,
+                   bool append_quotes = false);
+  // Appends escaped 'value' to the current element
+  void add_text(const std::string& value) { append_escaped(out, value); }
+
+  // Escapes <, >, &, " and CR of 'value' into 'xml'
+  static void append_escaped(std::string& xml, const std::string& value);
+};
+
+#endif
@@ -32,14 +32,20 @@
 #include "evhtp_wrapper.h"
 #include "fid/fid.h"
 #include "murmur3_hash.h"
+#include "s3_auth_cache.h"
+#include "s3_auth_connection_pool.h"
 #include "s3_bucket_metadata_cache.h"
+#include "s3_object_metadata_cache.h"
 #include "s3_motr_layout.h"
 #include "s3_common_utilities.h"
+#include "s3_completion_queue.h"
 #include "s3_daemonize_server.h"
 #include "s3_error_codes.h"
 #include "s3_fi_common.h"
+#include "s3_hash_thread_pool.h"
 #include "s3_log.h"
 #include "s3_mem_pool_manager.h"
+#include "s3_motr_kvs_batcher.h"
 #include "s3_option.h"
 #include "s3_perf_logger.h"
 #include "s3_request_object.h"
@@ -49,11 +55,13 @@
 #include "s3_uri_to_motr_oid.h"
 #include "s3_audit_info.h"
 #include "s3_audit_info_logger.h"
+#include "s3_fake_motr_obj_store.h"
 #include "s3_fake_motr_redis_kvs.h"
 #include "s3_motr_wrapper.h"
 #include "s3_m0_uint128_helper.h"
 #include "s3_perf_metrics.h"
 #include "s3_iem.h"
+#include "s3_reactor.h"
 
 #define FOUR_KB 4096
 // 32MB
@@ -667,13 +675,16 @@ void log_resource_limits() {
 
 evhtp_t *create_evhtp_handle(evbase_t *evbase_handle, Router *router,
                              void *arg) {
-  evhtp_t *htp = evhtp_new(global_evbase_handle, NULL);
+  evhtp_t *htp = evhtp_new(evbase_handle, NULL);
+  // Listeners of all reactors share the S3 port
+  bool reuseport = g_option_instance->is_s3_reuseport_enabled() ||
+                   g_option_instance->get_s3_reactor_count() > 1;
 #if defined SO_REUSEPORT
-  if (g_option_instance->is_s3_reuseport_enabled()) {
+  if (reuseport) {
     htp->enable_reuseport = 1;
   }
 #else
-  if (g_option_instance->is_s3_reuseport_enabled()) {
+  if (reuseport) {
     s3_log(
         S3_LOG_ERROR, "",
         "Option --reuseport is true however OS Doesn't support SO_REUSEPORT\n");
@@ -696,7 +707,7 @@ evhtp_t *create_evhtp_handle(evbase_t *evbase_handle, Router *router,
 
 evhtp_t *create_evhtp_handle_for_motr(evbase_t *evbase_handle,
                                       Router *motr_router, void *arg) {
-  evhtp_t *htp = evhtp_new(global_evbase_handle, NULL);
+  evhtp_t *htp = evhtp_new(evbase_handle, NULL);
 #if defined SO_REUSEPORT
   if (g_option_instance->is_motr_http_reuseport_enabled()) {
     htp->enable_reuseport = 1;
@@ -731,6 +742,120 @@ void free_evhtp_handle(evhtp_t *htp) {
   }
 }
 
+// S3 listeners, bucket metadata cache, auth connection pool, KVS batcher and
+// completion queue of an additional reactor.
+// Owned by main thread and released after motr teardown.
+struct S3ReactorContext {
+  evhtp_t *htp_ipv4 = NULL;
+  evhtp_t *htp_ipv6 = NULL;
+  std::unique_ptr<S3BucketMetadataCache> bucket_metadata_cache;
+  std::unique_ptr<S3AuthConnectionPool> auth_connection_pool;
+  std::unique_ptr<S3MotrKVSBatcher> kvs_batcher;
+  std::unique_ptr<S3CompletionQueue> completion_queue;
+
+  ~S3ReactorContext() {
+    free_evhtp_handle(htp_ipv4);
+    free_evhtp_handle(htp_ipv6);
+  }
+};
+
+static int start_reactor_listener(evbase_t *evbase, Router *s3_router,
+                                  const std::string &bind_addr,
+                                  uint16_t bind_port, evhtp_t **htp) {
+  *htp = create_evhtp_handle(evbase, s3_router, NULL);
+  if (*htp == NULL) {
+    return EINVAL;
+  }
+  if (g_option_instance->is_s3server_ssl_enabled() && !init_ssl(*htp)) {
+    s3_log(S3_LOG_ERROR, "", "SSL initialization failed for %s\n",
+           bind_addr.c_str());
+    return EINVAL;
+  }
+  if (evhtp_bind_socket(*htp, bind_addr.c_str(), bind_port, 1024) < 0) {
+    int err = errno;
+    s3_log(S3_LOG_ERROR, "", "Could not bind socket %s:%d: %s\n",
+           bind_addr.c_str(), bind_port, strerror(err));
+    return err ? err : EINVAL;
+  }
+  return 0;
+}
+
+// With prefaulting, every reactor allocates its share of the initial Motr
+// read buffers on its own thread, so that first touch places them on the
+// NUMA node of the reactor
+static int get_motr_read_pool_initial_buffer_count_per_reactor() {
+  const size_t reactor_count = g_option_instance->get_s3_reactor_count();
+  return (g_option_instance->get_motr_read_pool_initial_buffer_count() +
+          reactor_count - 1) /
+         reactor_count;
+}
+
+// Called on the reactor thread before its event loop starts
+int init_s3_reactor(S3Reactor *reactor, Router *s3_router,
+                    S3ReactorContext *ctx) {
+  evbase_t *evbase = reactor->get_evbase();
+  uint16_t bind_port = g_option_instance->get_s3_bind_port();
+  std::string ipv4_bind_addr = g_option_instance->get_ipv4_bind_addr();
+  std::string ipv6_bind_addr = g_option_instance->get_ipv6_bind_addr();
+  int rc;
+
+  s3_log(S3_LOG_INFO, "", "Starting S3 listeners of reactor %u on port %d\n",
+         reactor->get_index(), bind_port);
+  if (!ipv4_bind_addr.empty()) {
+    rc = start_reactor_listener(evbase, s3_router, "ipv4:" + ipv4_bind_addr,
+                                bind_port, &ctx->htp_ipv4);
+    if (rc != 0) {
+      return rc;
+    }
+  }
+  if (!ipv6_bind_addr.empty()) {
+    rc = start_reactor_listener(evbase, s3_router, "ipv6:" + ipv6_bind_addr,
+                                bind_port, &ctx->htp_ipv6);
+    if (rc != 0) {
+      return rc;
+    }
+  }
+  // Fetch waiters of a cache item are resumed on the loop that owns the
+  // cache, so every reactor has its own. Changes made on one reactor
+  // invalidate the entry in the caches of the others.
+  ctx->bucket_metadata_cache.reset(new S3BucketMetadataCache(
+      g_option_instance->get_bucket_metadata_cache_max_size(),
+      g_option_instance->get_bucket_metadata_cache_expire_sec(),
+      g_option_instance->get_bucket_metadata_cache_refresh_sec(),
+      g_option_instance->get_bucket_metadata_cache_negative_expire_sec(),
+      g_option_instance->get_bucket_metadata_cache_shards()));
+
+  // Pooled connections are bound to the event base of the reactor
+  if (g_option_instance->get_auth_pool_max_connections() > 0 &&
+      !g_option_instance->is_auth_disabled()) {
+    ctx->auth_connection_pool.reset(new S3AuthConnectionPool(
+        evbase, g_option_instance->get_auth_pool_max_connections(),
+        g_option_instance->get_auth_pool_idle_timeout_sec()));
+  }
+
+  // Batched KV ops complete on the loop of the reactor
+  if (g_option_instance->get_motr_kvs_batch_window_us() > 0) {
+    ctx->kvs_batcher.reset(new S3MotrKVSBatcher(
+        evbase, g_option_instance->get_motr_kvs_batch_window_us(),
+        g_option_instance->get_motr_kvs_batch_max_keys()));
+  }
+
+  // Motr completions of requests served by the reactor
+  if (g_option_instance->get_s3_completion_queue_size() > 0) {
+    ctx->completion_queue.reset(new S3CompletionQueue(
+        evbase, g_option_instance->get_s3_completion_queue_size(),
+        S3CompletionQueue::DEFAULT_MAX_BATCH));
+  }
+
+  // Pool falls back to allocation on demand, if the reactor's share of
+  // buffers doesn't fit
+  if (g_option_instance->get_motr_read_mempool_prefault()) {
+    S3MempoolManager::get_instance()->reserve_for_thread(
+        get_motr_read_pool_initial_buffer_count_per_reactor());
+  }
+  return 0;
+}
+
 int main(int argc, char **argv) {
   int rc = 0;
   pthread_t tid;
@@ -793,6 +918,12 @@ int main(int argc, char **argv) {
         MIN_RESERVE_SIZE);
   }
 
+  const unsigned reactor_count = g_option_instance->get_s3_reactor_count();
+  if (reactor_count == 0) {
+    s3_log(S3_LOG_FATAL, "",
+           "S3_SERVER_REACTOR_COUNT in s3config.yaml cannot be 0");
+  }
+
   S3MotrLayoutMap::get_instance()->load_layout_recommendations(
       g_option_instance->get_layout_recommendation_file());
 
@@ -808,6 +939,10 @@ int main(int argc, char **argv) {
   if (g_option_instance->get_libevent_mempool_zeroed_buffer()) {
     libevent_mempool_flags = libevent_mempool_flags | ZEROED_BUFFER;
   }
+  if (reactor_count > 1) {
+    libevent_mempool_flags =
+        libevent_mempool_flags | ENABLE_LOCKING | ENABLE_THREAD_CACHE;
+  }
 
   // Call this function at starting as we need to make use of our own
   // memory allocation/deallocation functions
@@ -936,12 +1071,26 @@ int main(int argc, char **argv) {
   if (g_option_instance->get_motr_read_mempool_zeroed_buffer()) {
     motr_read_mempool_flags = motr_read_mempool_flags | ZEROED_BUFFER;
   }
+  if (g_option_instance->get_motr_read_mempool_use_hugepages()) {
+    motr_read_mempool_flags = motr_read_mempool_flags | USE_HUGEPAGES;
+  }
+  if (g_option_instance->get_motr_read_mempool_prefault()) {
+    motr_read_mempool_flags = motr_read_mempool_flags | PREFAULT_MEMORY;
+  }
+  if (reactor_count > 1) {
+    motr_read_mempool_flags =
+        motr_read_mempool_flags | ENABLE_LOCKING | ENABLE_THREAD_CACHE;
+  }
 
   // Create memory pool for motr read operations.
+  // With prefaulting, initial buffers are allocated by the reactors, see
+  // init_s3_reactor(). Main thread runs reactor 0.
   rc = S3MempoolManager::create_pool(
       g_option_instance->get_motr_read_pool_max_threshold(),
       g_option_instance->get_motr_unit_sizes_for_mem_pool(),
-      g_option_instance->get_motr_read_pool_initial_buffer_count(),
+      g_option_instance->get_motr_read_mempool_prefault()
+          ? 0
+          : g_option_instance->get_motr_read_pool_initial_buffer_count(),
       g_option_instance->get_motr_read_pool_expandable_count(),
       motr_read_mempool_flags);
 
@@ -952,6 +1101,10 @@ int main(int argc, char **argv) {
     s3_log(S3_LOG_FATAL, "",
            "Memory pool creation for motr read buffers failed!\n");
   }
+  if (g_option_instance->get_motr_read_mempool_prefault()) {
+    S3MempoolManager::get_instance()->reserve_for_thread(
+        get_motr_read_pool_initial_buffer_count_per_reactor());
+  }
 
   log_resource_limits();
 
@@ -1233,7 +1386,86 @@ int main(int argc, char **argv) {
       new S3BucketMetadataCache(
           g_option_instance->get_bucket_metadata_cache_max_size(),
           g_option_instance->get_bucket_metadata_cache_expire_sec(),
-          g_option_instance->get_bucket_metadata_cache_refresh_sec()));
+          g_option_instance->get_bucket_metadata_cache_refresh_sec(),
+          g_option_instance->get_bucket_metadata_cache_negative_expire_sec(),
+          g_option_instance->get_bucket_metadata_cache_shards()));
+
+  // Shared by all reactors
+  std::unique_ptr<S3ObjectMetadataCache> sptr_object_metadata_cache;
+  if (g_option_instance->get_object_metadata_cache_max_size() > 0) {
+    sptr_object_metadata_cache.reset(new S3ObjectMetadataCache(
+        g_option_instance->get_object_metadata_cache_max_size(),
+        g_option_instance->get_object_metadata_cache_expire_sec(),
+        g_option_instance->get_object_metadata_cache_shards()));
+  }
+
+  // Shared by all reactors. Without the secret the auth server does not
+  // hand out signing keys, and so nothing is authenticated from the cache.
+  std::unique_ptr<S3AuthCache> sptr_auth_cache;
+  if (g_option_instance->get_auth_cache_max_size() > 0 &&
+      !g_option_instance->get_auth_signing_key_secret().empty() &&
+      !g_option_instance->is_auth_disabled()) {
+    sptr_auth_cache.reset(new S3AuthCache(
+        g_option_instance->get_auth_cache_max_size(),
+        g_option_instance->get_auth_cache_expire_sec(),
+        g_option_instance->get_auth_cache_authorization_expire_sec()));
+  }
+
+  // Checksums of written data, shared by all reactors
+  std::unique_ptr<S3HashThreadPool> sptr_hash_thread_pool;
+  if (g_option_instance->get_s3_hash_thread_count() > 0) {
+    sptr_hash_thread_pool.reset(
+        new S3HashThreadPool(g_option_instance->get_s3_hash_thread_count()));
+  }
+
+  // Auth server connections of reactor 0
+  std::unique_ptr<S3AuthConnectionPool> sptr_auth_connection_pool;
+  if (g_option_instance->get_auth_pool_max_connections() > 0 &&
+      !g_option_instance->is_auth_disabled()) {
+    sptr_auth_connection_pool.reset(new S3AuthConnectionPool(
+        global_evbase_handle,
+        g_option_instance->get_auth_pool_max_connections(),
+        g_option_instance->get_auth_pool_idle_timeout_sec()));
+  }
+
+  // KV puts and deletes of reactor 0 coalesced across requests
+  std::unique_ptr<S3MotrKVSBatcher> sptr_kvs_batcher;
+  if (g_option_instance->get_motr_kvs_batch_window_us() > 0) {
+    sptr_kvs_batcher.reset(new S3MotrKVSBatcher(
+        global_evbase_handle, g_option_instance->get_motr_kvs_batch_window_us(),
+        g_option_instance->get_motr_kvs_batch_max_keys()));
+  }
+
+  // Created before the reactors start, they all use it
+  if (g_option_instance->is_fake_motr_obj_store()) {
+    S3FakeMotrObjStore::instance();
+  }
+
+  // Callbacks posted to reactor 0 from other threads
+  std::unique_ptr<S3CompletionQueue> sptr_completion_queue;
+  if (g_option_instance->get_s3_completion_queue_size() > 0) {
+    sptr_completion_queue.reset(new S3CompletionQueue(
+        global_evbase_handle, g_option_instance->get_s3_completion_queue_size(),
+        S3CompletionQueue::DEFAULT_MAX_BATCH));
+  }
+
+  // Main thread runs reactor 0, start the others
+  std::vector<std::unique_ptr<S3ReactorContext>> reactor_contexts;
+  std::vector<std::unique_ptr<S3Reactor>> reactors;
+  for (unsigned i = 1; i < reactor_count; ++i) {
+    S3ReactorContext *ctx = new S3ReactorContext();
+    reactor_contexts.emplace_back(ctx);
+    reactors.emplace_back(
+        new S3Reactor(i, [s3_router, ctx](S3Reactor *reactor) {
+          return init_s3_reactor(reactor, s3_router, ctx);
+        }));
+    rc = reactors.back()->start();
+    if (rc != 0) {
+      s3daemon.delete_pidfile();
+      s3_log(S3_LOG_FATAL, "", "Could not start reactor %u: %s\n", i,
+             strerror(rc));
+    }
+  }
 
   // new flag in Libevent 2.1
   // EVLOOP_NO_EXIT_ON_EMPTY tells event_base_loop()
@@ -1248,15 +1480,28 @@ int main(int argc, char **argv) {
            "backend\n");
   }
 
+  // No new motr operations must be launched once teardown begins
+  for (auto &reactor : reactors) {
+    reactor->stop();
+  }
+
   shutdown_motr_teardown_called = 1;
   global_motr_teardown();
   s3_perf_metrics_fini();
   pthread_join(global_tid_indexop, NULL);
   pthread_join(global_tid_objop, NULL);
   S3FakeMotrRedisKvs::destroy_instance();
+  S3FakeMotrObjStore::destroy_instance();
   free_evhtp_handle(htp_ipv4);
   free_evhtp_handle(htp_ipv6);
   free_evhtp_handle(htp_motr);
+  // Listeners must go before event bases of their reactors
+  reactor_contexts.clear();
+  reactors.clear();
+  // Before SSL context of auth connections and the event base are freed
+  sptr_auth_connection_pool.reset();
+  sptr_kvs_batcher.reset();
+  sptr_completion_queue.reset();
 
   fini_auth_ssl();
 
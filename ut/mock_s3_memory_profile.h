@@ -32,6 +32,8 @@ class MockS3MemoryProfile : public S3MemoryProfile {
   MockS3MemoryProfile() : S3MemoryProfile() {}
   MOCK_METHOD1(we_have_enough_memory_for_put_obj, bool(int layout_id));
   MOCK_METHOD0(free_memory_in_pool_above_threshold_limits, bool());
+  MOCK_METHOD2(we_have_enough_memory_for_get_read,
+               bool(size_t unit_size, size_t read_size));
 };
 
 #endif
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+
+#include "s3_auth_connection_pool.h"
+
+// Hands out connections which are never connected anywhere
+class FakeS3AuthConnectionPool : public S3AuthConnectionPool {
+ public:
+  unsigned created = 0;
+  unsigned freed = 0;
+  bool f_fail_create = false;
+
+  FakeS3AuthConnectionPool(evbase_t *evbase, unsigned max_connections,
+                           unsigned idle_timeout_sec = 0)
+      : S3AuthConnectionPool(evbase, max_connections, idle_timeout_sec) {}
+
+  ~FakeS3AuthConnectionPool() { close_all_connections(); }
+
+ protected:
+  evhtp_connection_t *create_connection() override {
+    if (f_fail_create) {
+      return nullptr;
+    }
+    ++created;
+    return (evhtp_connection_t *)calloc(1, sizeof(evhtp_connection_t));
+  }
+  void free_connection(evhtp_connection_t *conn) override {
+    ++freed;
+    free(conn);
+  }
+  void watch_connection(evhtp_connection_t *) override {}
+};
+
+class S3AuthConnectionPoolTest : public testing::Test {
+ protected:
+  S3AuthConnectionPoolTest() { evbase = event_base_new(); }
+  ~S3AuthConnectionPoolTest() { event_base_free(evbase); }
+
+  // Released connections are made idle by the event loop
+  void run_loop() { event_base_loop(evbase, EVLOOP_NONBLOCK); }
+
+  S3AuthConnectionPool::ReadyCallback save_to(evhtp_connection_t **conn,
+                                              bool *f_called = nullptr) {
+    return [conn, f_called](evhtp_connection_t *ready_conn) {
+      *conn = ready_conn;
+      if (f_called) {
+        *f_called = true;
+      }
+    };
+  }
+
+  evbase_t *evbase;
+  const int owner1 = 0, owner2 = 0;
+};
+
+TEST_F(S3AuthConnectionPoolTest, ReusesIdleConnection) {
+  FakeS3AuthConnectionPool pool(evbase, 4);
+  evhtp_connection_t *conn1 = nullptr, *conn2 = nullptr;
+
+  pool.acquire(&owner1, save_to(&conn1));
+  ASSERT_TRUE(conn1 != nullptr);
+  EXPECT_EQ(1u, pool.get_busy_count());
+
+  pool.release(conn1);
+  run_loop();
+  EXPECT_EQ(0u, pool.get_busy_count());
+
+  pool.acquire(&owner1, save_to(&conn2));
+  EXPECT_EQ(conn1, conn2);
+  EXPECT_EQ(1u, pool.created);
+  EXPECT_EQ(1u, pool.get_connection_count());
+}
+
+TEST_F(S3AuthConnectionPoolTest, QueuesRequestsWhenPoolIsFull) {
+  FakeS3AuthConnectionPool pool(evbase, 1);
+  evhtp_connection_t *conn1 = nullptr, *conn2 = nullptr;
+  bool f_called = false;
+
+  pool.acquire(&owner1, save_to(&conn1));
+  pool.acquire(&owner2, save_to(&conn2, &f_called));
+  EXPECT_FALSE(f_called);
+  EXPECT_EQ(1u, pool.get_waiter_count());
+
+  // Not handed out from within the callback releasing it
+  pool.release(conn1);
+  EXPECT_FALSE(f_called);
+
+  run_loop();
+  EXPECT_TRUE(f_called);
+  EXPECT_EQ(conn1, conn2);
+  EXPECT_EQ(0u, pool.get_waiter_count());
+  EXPECT_EQ(1u, pool.get_busy_count());
+  EXPECT_EQ(1u, pool.created);
+}
+
+TEST_F(S3AuthConnectionPoolTest, CancelDropsWaiters) {
+  FakeS3AuthConnectionPool pool(evbase, 1);
+  evhtp_connection_t *conn1 = nullptr, *conn2 = nullptr;
+  bool f_called = false;
+
+  pool.acquire(&owner1, save_to(&conn1));
+  pool.acquire(&owner2, save_to(&conn2, &f_called));
+  pool.cancel(&owner2);
+  EXPECT_EQ(0u, pool.get_waiter_count());
+
+  pool.release(conn1);
+  run_loop();
+  EXPECT_FALSE(f_called);
+  EXPECT_EQ(0u, pool.get_busy_count());
+}
+
+TEST_F(S3AuthConnectionPoolTest, ClosesNotReusableConnection) {
+  FakeS3AuthConnectionPool pool(evbase, 2);
+  evhtp_connection_t *conn = nullptr;
+
+  pool.acquire(&owner1, save_to(&conn));
+  pool.release(conn, false);
+
+  EXPECT_EQ(1u, pool.freed);
+  EXPECT_EQ(0u, pool.get_connection_count());
+}
+
+TEST_F(S3AuthConnectionPoolTest, FailedConnectionClosesIdleOnes) {
+  FakeS3AuthConnectionPool pool(evbase, 3);
+  evhtp_connection_t *conn1 = nullptr, *conn2 = nullptr, *conn3 = nullptr;
+
+  pool.acquire(&owner1, save_to(&conn1));
+  pool.acquire(&owner1, save_to(&conn2));
+  pool.acquire(&owner1, save_to(&conn3));
+  EXPECT_EQ(3u, pool.created);
+
+  pool.release(conn1);
+  pool.release(conn2);
+  run_loop();
+
+  // conn3 is freed by libevhtp
+  pool.forget(conn3);
+  free(conn3);
+
+  EXPECT_EQ(2u, pool.freed);
+  EXPECT_EQ(0u, pool.get_connection_count());
+}
+
+TEST_F(S3AuthConnectionPoolTest, ReportsConnectionFailureFromLoop) {
+  FakeS3AuthConnectionPool pool(evbase, 1);
+  evhtp_connection_t *conn = nullptr;
+  bool f_called = false;
+
+  pool.f_fail_create = true;
+  pool.acquire(&owner1, save_to(&conn, &f_called));
+  EXPECT_FALSE(f_called);
+
+  run_loop();
+  EXPECT_TRUE(f_called);
+  EXPECT_EQ(nullptr, conn);
+  EXPECT_EQ(0u, pool.get_waiter_count());
+}
+
+TEST_F(S3AuthConnectionPoolTest, ClosesIdleConnections) {
+  FakeS3AuthConnectionPool pool(evbase, 2, 10);
+  evhtp_connection_t *conn1 = nullptr, *conn2 = nullptr;
+
+  pool.acquire(&owner1, save_to(&conn1));
+  pool.acquire(&owner1, save_to(&conn2));
+  pool.release(conn1);
+  pool.release(conn2);
+  run_loop();
+
+  pool.connections[0].idle_since -= 20;
+  S3AuthConnectionPool::idle_timer_cb(-1, EV_TIMEOUT, &pool);
+
+  EXPECT_EQ(1u, pool.freed);
+  EXPECT_EQ(1u, pool.get_connection_count());
+}
@@ -139,6 +139,8 @@ class S3BucketMetadataCacheTest : public testing::Test {
 #define MAX_CACHE_SIZE 2
 #define EXPIRE_SEC 2
 #define REFRESH_SEC 1
+#define NEGATIVE_EXPIRE_SEC 1
+#define N_SHARDS 4
 
 S3BucketMetadataCacheTest::S3BucketMetadataCacheTest() {
 
@@ -158,6 +160,7 @@ S3BucketMetadataCacheTest::S3BucketMetadataCacheTest() {
 
   ptr_bucket_metadata_cache.reset(
       new S3BucketMetadataCache(MAX_CACHE_SIZE, EXPIRE_SEC, REFRESH_SEC,
+                                NEGATIVE_EXPIRE_SEC, N_SHARDS,
                                 ptr_motr_bucket_metadata_factory));
 }
 
@@ -177,16 +180,16 @@ std::unique_ptr<S3BucketMetadataProxy> S3BucketMetadataCacheTest::create_proxy(
 }
 
 size_t S3BucketMetadataCacheTest::get_cache_size() const {
-  return S3BucketMetadataCache::get_instance()->items.size();
+  return S3BucketMetadataCache::get_instance()->size();
 }
 
 S3BucketMetadataCacheTest::CurrentOp S3BucketMetadataCacheTest::get_current_op(
     const std::string& bucket_name) const {
 
-  auto it = S3BucketMetadataCache::get_instance()->items.find(bucket_name);
-  assert(it != S3BucketMetadataCache::get_instance()->items.end());
+  auto* p_item = S3BucketMetadataCache::get_instance()->find_item(bucket_name);
+  assert(p_item);
 
-  return it->second->current_op;
+  return p_item->current_op;
 }
 
 // ************************************************************************* //
@@ -397,3 +400,192 @@ TEST_F(S3BucketMetadataCacheTest, CacheSize) {
   }
   EXPECT_EQ(get_cache_size(), MAX_CACHE_SIZE);
 }
+
+TEST_F(S3BucketMetadataCacheTest, NegativeCaching) {
+  ASSERT_EQ(get_cache_size(), 0);
+  std::string bucket_name = "seagatebucket";
+
+  auto ptr_metadata_proxy_1 = create_proxy(bucket_name);
+  ptr_metadata_proxy_1->load(success_handler, failed_handler);
+
+  ASSERT_TRUE(p_s3_bucket_metadata_v1_test);
+  p_s3_bucket_metadata_v1_test->done(S3BucketMetadataState::missing);
+
+  EXPECT_TRUE(f_fail);
+  f_fail = false;
+  EXPECT_EQ(ptr_metadata_proxy_1->get_state(), S3BucketMetadataState::missing);
+
+  // "Not found" is returned from the cache, Motr isn't asked again
+  auto ptr_metadata_proxy_2 = create_proxy(bucket_name);
+  ptr_metadata_proxy_2->load(success_handler, failed_handler);
+
+  EXPECT_FALSE(p_s3_bucket_metadata_v1_test);
+  EXPECT_EQ(S3BucketMetadataV1Mock::n_called, 1);
+  EXPECT_TRUE(f_fail);
+  f_fail = false;
+  EXPECT_EQ(ptr_metadata_proxy_2->get_state(), S3BucketMetadataState::missing);
+  EXPECT_EQ(S3BucketMetadataCache::get_instance()->get_counters().negative_hits,
+            1);
+
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(NEGATIVE_EXPIRE_SEC * 1000 + 10));
+
+  // Negative entry has expired, the bucket has been created meanwhile
+  auto ptr_metadata_proxy_3 = create_proxy(bucket_name);
+  ptr_metadata_proxy_3->load(success_handler, failed_handler);
+
+  ASSERT_TRUE(p_s3_bucket_metadata_v1_test);
+  EXPECT_EQ(S3BucketMetadataV1Mock::n_called, 2);
+  p_s3_bucket_metadata_v1_test->done(S3BucketMetadataState::present);
+
+  EXPECT_TRUE(f_success);
+  f_success = false;
+  EXPECT_EQ(ptr_metadata_proxy_3->get_state(), S3BucketMetadataState::present);
+}
+
+TEST_F(S3BucketMetadataCacheTest, RefreshAhead) {
+  ASSERT_EQ(get_cache_size(), 0);
+  std::string bucket_name = "seagatebucket";
+
+  auto ptr_metadata_proxy_1 = create_proxy(bucket_name);
+  ptr_metadata_proxy_1->load(success_handler, failed_handler);
+
+  ASSERT_TRUE(p_s3_bucket_metadata_v1_test);
+  p_s3_bucket_metadata_v1_test->done(S3BucketMetadataState::present);
+  EXPECT_TRUE(f_success);
+  f_success = false;
+  S3BucketMetadataV1Mock::n_called = 0;
+
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(REFRESH_SEC * 1000 + 10));
+
+  // The request is served at once, reload is launched in background
+  auto ptr_metadata_proxy_2 = create_proxy(bucket_name);
+  ptr_metadata_proxy_2->load(success_handler, failed_handler);
+
+  EXPECT_TRUE(f_success);
+  f_success = false;
+  EXPECT_EQ(ptr_metadata_proxy_2->get_state(), S3BucketMetadataState::present);
+  ASSERT_TRUE(p_s3_bucket_metadata_v1_test);
+  EXPECT_EQ(S3BucketMetadataV1Mock::n_called, 1);
+  EXPECT_EQ(get_current_op(bucket_name), CurrentOp::fetching);
+
+  // Only one reload at a time
+  auto ptr_metadata_proxy_3 = create_proxy(bucket_name);
+  ptr_metadata_proxy_3->load(success_handler, failed_handler);
+
+  EXPECT_TRUE(f_success);
+  f_success = false;
+  EXPECT_EQ(S3BucketMetadataV1Mock::n_called, 1);
+
+  p_s3_bucket_metadata_v1_test->done(S3BucketMetadataState::present);
+
+  EXPECT_FALSE(p_s3_bucket_metadata_v1_test);
+  EXPECT_FALSE(f_success);
+  EXPECT_FALSE(f_fail);
+  EXPECT_EQ(get_current_op(bucket_name), CurrentOp::none);
+
+  const auto& counters = S3BucketMetadataCache::get_instance()->get_counters();
+  EXPECT_EQ(counters.refreshes, 1);
+  EXPECT_EQ(counters.hits, 2);
+  EXPECT_EQ(counters.misses, 1);
+}
+
+TEST_F(S3BucketMetadataCacheTest, InvalidateIdleEntry) {
+  ASSERT_EQ(get_cache_size(), 0);
+  std::string bucket_name = "seagatebucket";
+
+  auto ptr_metadata_proxy_1 = create_proxy(bucket_name);
+  ptr_metadata_proxy_1->load(success_handler, failed_handler);
+
+  ASSERT_TRUE(p_s3_bucket_metadata_v1_test);
+  p_s3_bucket_metadata_v1_test->done(S3BucketMetadataState::present);
+  EXPECT_TRUE(f_success);
+  f_success = false;
+  EXPECT_EQ(get_cache_size(), 1);
+
+  // Another reactor has changed the bucket
+  S3BucketMetadataCache::get_instance()->invalidate(bucket_name);
+  EXPECT_EQ(get_cache_size(), 0);
+
+  // Unknown names are ignored
+  S3BucketMetadataCache::get_instance()->invalidate("unknownbucket");
+
+  auto ptr_metadata_proxy_2 = create_proxy(bucket_name);
+  ptr_metadata_proxy_2->load(success_handler, failed_handler);
+
+  ASSERT_TRUE(p_s3_bucket_metadata_v1_test);
+  EXPECT_EQ(S3BucketMetadataV1Mock::n_called, 2);
+  p_s3_bucket_metadata_v1_test->done(S3BucketMetadataState::present);
+  EXPECT_TRUE(f_success);
+}
+
+TEST_F(S3BucketMetadataCacheTest, InvalidateBusyEntry) {
+  ASSERT_EQ(get_cache_size(), 0);
+  std::string bucket_name = "seagatebucket";
+
+  auto ptr_metadata_proxy_1 = create_proxy(bucket_name);
+  ptr_metadata_proxy_1->load(success_handler, failed_handler);
+
+  ASSERT_TRUE(p_s3_bucket_metadata_v1_test);
+  EXPECT_EQ(get_current_op(bucket_name), CurrentOp::fetching);
+
+  // The load was launched before the change on another reactor
+  S3BucketMetadataCache::get_instance()->invalidate(bucket_name);
+  EXPECT_EQ(get_cache_size(), 1);
+
+  p_s3_bucket_metadata_v1_test->done(S3BucketMetadataState::present);
+  EXPECT_TRUE(f_success);
+  f_success = false;
+
+  // Its result isn't served from the cache
+  auto ptr_metadata_proxy_2 = create_proxy(bucket_name);
+  ptr_metadata_proxy_2->load(success_handler, failed_handler);
+
+  ASSERT_TRUE(p_s3_bucket_metadata_v1_test);
+  EXPECT_EQ(S3BucketMetadataV1Mock::n_called, 2);
+  p_s3_bucket_metadata_v1_test->done(S3BucketMetadataState::present);
+  EXPECT_TRUE(f_success);
+  f_success = false;
+
+  // The fresh result is
+  auto ptr_metadata_proxy_3 = create_proxy(bucket_name);
+  ptr_metadata_proxy_3->load(success_handler, failed_handler);
+
+  EXPECT_FALSE(p_s3_bucket_metadata_v1_test);
+  EXPECT_EQ(S3BucketMetadataV1Mock::n_called, 2);
+  EXPECT_TRUE(f_success);
+}
+
+TEST_F(S3BucketMetadataCacheTest, FetchAfterInvalidateWaitsForNewLoad) {
+  ASSERT_EQ(get_cache_size(), 0);
+  std::string bucket_name = "seagatebucket";
+
+  auto ptr_metadata_proxy_1 = create_proxy(bucket_name);
+  ptr_metadata_proxy_1->load(success_handler, failed_handler);
+
+  ASSERT_TRUE(p_s3_bucket_metadata_v1_test);
+  EXPECT_EQ(get_current_op(bucket_name), CurrentOp::fetching);
+
+  // Another reactor changes the bucket while the load is in flight
+  S3BucketMetadataCache::get_instance()->invalidate(bucket_name);
+
+  auto ptr_metadata_proxy_2 = create_proxy(bucket_name);
+  ptr_metadata_proxy_2->load(success_handler, failed_handler);
+  EXPECT_EQ(S3BucketMetadataV1Mock::n_called, 1);
+
+  // The old load may have read the value before the change, it is served
+  // only to the request queued before the invalidation
+  p_s3_bucket_metadata_v1_test->done(S3BucketMetadataState::present);
+
+  EXPECT_EQ(ptr_metadata_proxy_1->get_state(), S3BucketMetadataState::present);
+  EXPECT_EQ(ptr_metadata_proxy_2->get_state(), S3BucketMetadataState::empty);
+  ASSERT_TRUE(p_s3_bucket_metadata_v1_test);
+  EXPECT_EQ(S3BucketMetadataV1Mock::n_called, 2);
+  EXPECT_EQ(get_current_op(bucket_name), CurrentOp::fetching);
+
+  p_s3_bucket_metadata_v1_test->done(S3BucketMetadataState::missing);
+
+  EXPECT_FALSE(p_s3_bucket_metadata_v1_test);
+  EXPECT_EQ(ptr_metadata_proxy_2->get_state(), S3BucketMetadataState::missing);
+}
@@ -825,6 +825,31 @@ TEST_F(S3BucketMetadataV1Test, FromJson) {
   EXPECT_OID_NE(zero_oid, action_under_test->multipart_index_layout.oid);
 }
 
+TEST_F(S3BucketMetadataV1Test, ToBinaryFromBinary) {
+  action_under_test->object_list_index_layout = {{0x1111, 0x2222}};
+  action_under_test->multipart_index_layout = {{0x3333, 0x4444}};
+  action_under_test->bucket_policy = "{\"Version\":\"2012-10-17\"}";
+  action_under_test->bucket_tags["tag"] = "val";
+  action_under_test->system_defined_attribute["Owner-User"] = "tester";
+
+  std::string binary = action_under_test->to_binary();
+  EXPECT_LT(binary.size(), action_under_test->to_json().size());
+
+  action_under_test->bucket_policy.clear();
+  action_under_test->bucket_tags.clear();
+  action_under_test->object_list_index_layout = {};
+  action_under_test->multipart_index_layout = {};
+
+  EXPECT_EQ(0, action_under_test->from_json(binary));
+  EXPECT_STREQ("seagatebucket", action_under_test->bucket_name.c_str());
+  EXPECT_STREQ("tester", action_under_test->user_name.c_str());
+  EXPECT_STREQ("{\"Version\":\"2012-10-17\"}",
+               action_under_test->bucket_policy.c_str());
+  EXPECT_STREQ("val", action_under_test->bucket_tags["tag"].c_str());
+  EXPECT_EQ(0x1111u, action_under_test->object_list_index_layout.oid.u_hi);
+  EXPECT_EQ(0x4444u, action_under_test->multipart_index_layout.oid.u_lo);
+}
+
 TEST_F(S3BucketMetadataV1Test, GetEncodedBucketAcl) {
   std::string json_str = "{\"ACL\":\"PD94bg==\"}";
 
@@ -18,6 +18,11 @@
  *
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
 #include "s3_chunk_payload_parser.h"
 #include "gtest/gtest.h"
 #include "s3_option.h"
@@ -56,6 +61,67 @@ class S3ChunkPayloadParserTest : public testing::Test {
     return (const char*)evbuffer_pullup(buf, evbuffer_get_length(buf));
   }
 
+  // Returns aws-chunked encoding of 'content', chunk signatures are
+  // fake ones, see chunk_signature()
+  static std::string encode_chunked(const std::string& content,
+                                    size_t chunk_size) {
+    std::string payload;
+    size_t pos = 0;
+    unsigned chunk_num = 0;
+
+    for (;;) {
+      const size_t len = std::min(chunk_size, content.length() - pos);
+      char sz_size[32];
+      snprintf(sz_size, sizeof(sz_size), "%zx", len);
+
+      payload += sz_size;
+      payload += ";chunk-signature=";
+      payload += chunk_signature(chunk_num++);
+      payload += "\r\n";
+      payload.append(content, pos, len);
+      payload += "\r\n";
+      pos += len;
+
+      if (!len) {
+        break;
+      }
+    }
+
+    return payload;
+  }
+
+  static std::string chunk_signature(unsigned chunk_num) {
+    std::string signature(64, 'a' + chunk_num % 6);
+    signature[0] = '0' + chunk_num % 10;
+    return signature;
+  }
+
+  static std::string hex_sha256(const std::string& data) {
+    S3sha256 hash_ctx;
+    hash_ctx.Update(data.c_str(), data.length());
+    hash_ctx.Finalize();
+    return hash_ctx.get_hex_hash();
+  }
+
+  // Feeds 'payload' to the parser by 'piece_size' bytes, returns chunk data
+  std::string parse_by_pieces(const std::string& payload, size_t piece_size) {
+    std::string content;
+
+    for (size_t pos = 0; pos < payload.length(); pos += piece_size) {
+      evbuf_t* buf = get_evbuf_t_with_data(payload.substr(pos, piece_size));
+
+      for (evbuf_t* ready_buf : parser->run(buf)) {
+        const size_t len = evbuffer_get_length(ready_buf);
+        content.append(get_datap_4_evbuf_t(ready_buf), len);
+        evbuffer_free(ready_buf);
+      }
+      if (ChunkParserState::c_error == parser->get_state()) {
+        break;
+      }
+    }
+    return content;
+  }
+
   // Declares the variables your tests want to use.
   S3ChunkPayloadParser* parser;
   std::string nfourk_buffer;
@@ -143,3 +209,96 @@ TEST_F(S3ChunkPayloadParserTest, AddToSpareBufferNotEqualToStdSpareSize2) {
   EXPECT_EQ(nfourk_buffer.length() - 10,
             evbuffer_get_length(parser->spare_buffers.front()));
 }
+
+TEST_F(S3ChunkPayloadParserTest, RunSplitAtAnyOffset) {
+  std::string content;
+  for (size_t i = 0; i < 3 * nfourk_buffer.length() + 100; ++i) {
+    content += (char)('A' + i % 26);
+  }
+  const size_t chunk_size = 10000;
+  const std::string payload = encode_chunked(content, chunk_size);
+  static const size_t piece_sizes[] = {1, 2, 7, 17, 100, 4096, 16384};
+
+  for (size_t piece_size : piece_sizes) {
+    delete parser;
+    parser = new S3ChunkPayloadParser();
+    parser->setup_content_length(content.length());
+
+    EXPECT_EQ(content, parse_by_pieces(payload, piece_size)) << piece_size;
+    EXPECT_EQ(ChunkParserState::c_start, parser->get_state());
+
+    for (unsigned chunk_num = 0; chunk_num <= content.length() / chunk_size;
+         ++chunk_num) {
+      ASSERT_TRUE(parser->is_chunk_detail_ready());
+      S3ChunkDetail detail = parser->pop_chunk_detail();
+
+      const std::string chunk_data =
+          content.substr(chunk_num * chunk_size, chunk_size);
+      EXPECT_EQ(chunk_data.length(), detail.get_size());
+      EXPECT_EQ(chunk_signature(chunk_num), detail.get_signature());
+      EXPECT_EQ(hex_sha256(chunk_data), detail.get_payload_hash());
+    }
+    // Last chunk of size 0
+    ASSERT_TRUE(parser->is_chunk_detail_ready());
+    S3ChunkDetail detail = parser->pop_chunk_detail();
+    EXPECT_EQ(0, detail.get_size());
+    EXPECT_EQ(hex_sha256(""), detail.get_payload_hash());
+
+    EXPECT_FALSE(parser->is_chunk_detail_ready());
+  }
+}
+
+TEST_F(S3ChunkPayloadParserTest, RunInvalidFormat) {
+  static const char* const payloads[] = {
+      "4;chunk-signatur=abc\r\nABCD\r\n",
+      "4;chunk-signature=abc\r\nABCDE\r\n",
+      "4;chunk-signature=abc\r\nABCD\r\r"};
+
+  for (const char* payload : payloads) {
+    delete parser;
+    parser = new S3ChunkPayloadParser();
+    parser->setup_content_length(4);
+
+    parse_by_pieces(payload, 3);
+    EXPECT_EQ(ChunkParserState::c_error, parser->get_state()) << payload;
+  }
+}
+
+// Parsing throughput of aws-chunked payload received in libevent pool
+// sized buffers, SHA256 of chunk data included. It's a benchmark, run with
+// --gtest_also_run_disabled_tests.
+TEST_F(S3ChunkPayloadParserTest, DISABLED_RunThroughput) {
+  static const size_t chunk_sizes[] = {8 * 1024, 64 * 1024, 1024 * 1024};
+  const size_t content_length = 32 * 1024 * 1024;
+  const size_t buf_size = nfourk_buffer.length();
+  const std::string content(content_length, 'A');
+
+  printf("%12s %12s\n", "chunk size", "GB/sec");
+  for (size_t chunk_size : chunk_sizes) {
+    const std::string payload = encode_chunked(content, chunk_size);
+    std::vector<evbuf_t*> bufs;
+
+    for (size_t pos = 0; pos < payload.length(); pos += buf_size) {
+      bufs.push_back(get_evbuf_t_with_data(payload.substr(pos, buf_size)));
+    }
+    delete parser;
+    parser = new S3ChunkPayloadParser();
+    parser->setup_content_length(content_length);
+
+    size_t parsed_length = 0;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (evbuf_t* buf : bufs) {
+      for (evbuf_t* ready_buf : parser->run(buf)) {
+        parsed_length += evbuffer_get_length(ready_buf);
+        evbuffer_free(ready_buf);
+      }
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(content_length, parsed_length);
+    printf("%12zu %12.2f\n", chunk_size,
+           payload.length() / elapsed.count() / 1e9);
+  }
+}
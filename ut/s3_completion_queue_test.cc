@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <event2/thread.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "s3_completion_queue.h"
+
+// Callback posted by the tests, records the order it ran in
+struct TestCompletion {
+  std::vector<int> *ran;
+  int id;
+};
+
+static void test_completion_cb(evutil_socket_t, short, void *user_data) {
+  TestCompletion *completion = (TestCompletion *)user_data;
+  completion->ran->push_back(completion->id);
+}
+
+// Posted through S3PostToMainLoop, frees its context like Motr callbacks
+static void test_user_event_cb(evutil_socket_t, short, void *user_data) {
+  struct user_event_context *user_context =
+      (struct user_event_context *)user_data;
+  ++*(unsigned *)user_context->app_ctx;
+  if (user_context->user_event) {
+    event_free((struct event *)user_context->user_event);
+  }
+  free(user_data);
+}
+
+class S3CompletionQueueTest : public testing::Test {
+ protected:
+  S3CompletionQueueTest() {
+    // Producer threads wake the loop up
+    evthread_use_pthreads();
+    evbase = event_base_new();
+  }
+  ~S3CompletionQueueTest() { event_base_free(evbase); }
+
+  // Runs the loop until 'count' callbacks ran or timeout
+  void run_loop_until(const std::vector<int> &ran, size_t count) {
+    auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (ran.size() < count && std::chrono::steady_clock::now() < deadline) {
+      event_base_loop(evbase, EVLOOP_NONBLOCK);
+    }
+  }
+
+  evbase_t *evbase;
+};
+
+TEST_F(S3CompletionQueueTest, CapacityIsPowerOfTwo) {
+  S3CompletionQueue queue(evbase, 1000, 16);
+  EXPECT_EQ(1024u, queue.get_capacity());
+  S3CompletionQueue small_queue(evbase, 0, 16);
+  EXPECT_EQ(2u, small_queue.get_capacity());
+}
+
+TEST_F(S3CompletionQueueTest, FindReturnsQueueOfLoop) {
+  evbase_t *other_evbase = event_base_new();
+  EXPECT_TRUE(S3CompletionQueue::find(evbase) == nullptr);
+  {
+    S3CompletionQueue queue(evbase, 16, 16);
+    EXPECT_EQ(&queue, S3CompletionQueue::find(evbase));
+    EXPECT_TRUE(S3CompletionQueue::find(other_evbase) == nullptr);
+  }
+  EXPECT_TRUE(S3CompletionQueue::find(evbase) == nullptr);
+  event_base_free(other_evbase);
+}
+
+TEST_F(S3CompletionQueueTest, PostedCallbacksRunInOrder) {
+  S3CompletionQueue queue(evbase, 64, 64);
+  std::vector<int> ran;
+  std::vector<TestCompletion> completions;
+  for (int i = 0; i < 10; ++i) {
+    completions.push_back({&ran, i});
+  }
+  for (auto &completion : completions) {
+    EXPECT_TRUE(queue.post(test_completion_cb, &completion));
+  }
+  EXPECT_TRUE(ran.empty());
+
+  run_loop_until(ran, 10);
+
+  ASSERT_EQ(10u, ran.size());
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(i, ran[i]);
+  }
+}
+
+TEST_F(S3CompletionQueueTest, DrainRunsUpToMaxBatch) {
+  S3CompletionQueue queue(evbase, 64, 4);
+  std::vector<int> ran;
+  std::vector<TestCompletion> completions;
+  for (int i = 0; i < 10; ++i) {
+    completions.push_back({&ran, i});
+  }
+  for (auto &completion : completions) {
+    queue.post(test_completion_cb, &completion);
+  }
+
+  EXPECT_EQ(4u, queue.drain());
+  EXPECT_EQ(4u, ran.size());
+
+  // The rest is drained by the loop
+  run_loop_until(ran, 10);
+  EXPECT_EQ(10u, ran.size());
+  EXPECT_EQ(0u, queue.drain());
+}
+
+TEST_F(S3CompletionQueueTest, PostFailsWhenFull) {
+  S3CompletionQueue queue(evbase, 4, 4);
+  std::vector<int> ran;
+  std::vector<TestCompletion> completions;
+  for (int i = 0; i < 5; ++i) {
+    completions.push_back({&ran, i});
+  }
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.post(test_completion_cb, &completions[i]));
+  }
+  EXPECT_FALSE(queue.post(test_completion_cb, &completions[4]));
+
+  EXPECT_EQ(4u, queue.drain());
+  EXPECT_TRUE(queue.post(test_completion_cb, &completions[4]));
+  EXPECT_EQ(1u, queue.drain());
+  EXPECT_EQ(5u, ran.size());
+}
+
+TEST_F(S3CompletionQueueTest, ConcurrentProducers) {
+  const int threads = 4, per_thread = 1000;
+  S3CompletionQueue queue(evbase, threads * per_thread, 64);
+  std::vector<int> ran;
+  std::vector<TestCompletion> completions;
+  for (int i = 0; i < threads * per_thread; ++i) {
+    completions.push_back({&ran, i});
+  }
+
+  std::vector<std::thread> producers;
+  for (int t = 0; t < threads; ++t) {
+    producers.emplace_back([&queue, &completions, t]() {
+      for (int i = t * per_thread; i < (t + 1) * per_thread; ++i) {
+        queue.post(test_completion_cb, &completions[i]);
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  run_loop_until(ran, threads * per_thread);
+
+  ASSERT_EQ((size_t)threads * per_thread, ran.size());
+  // Callbacks of each producer run in the order it posted them
+  std::vector<int> last(threads, -1);
+  for (int id : ran) {
+    EXPECT_LT(last[id / per_thread], id);
+    last[id / per_thread] = id;
+  }
+}
+
+TEST_F(S3CompletionQueueTest, PostToMainLoopUsesQueueUntilFull) {
+  S3CompletionQueue queue(evbase, 2, 2);
+  unsigned done = 0;
+  for (int i = 0; i < 3; ++i) {
+    struct user_event_context *user_ctx = (struct user_event_context *)calloc(
+        1, sizeof(struct user_event_context));
+    user_ctx->app_ctx = &done;
+    user_ctx->evbase = evbase;
+    S3PostToMainLoop((void *)user_ctx)(test_user_event_cb);
+  }
+
+  // Third one got an event of its own
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (done < 3 && std::chrono::steady_clock::now() < deadline) {
+    event_base_loop(evbase, EVLOOP_NONBLOCK);
+  }
+  EXPECT_EQ(3u, done);
+}
@@ -271,8 +271,9 @@ TEST_F(S3DeleteBucketActionTest, FetchMultipartObjectsMultipartPresent) {
       bucket_meta_factory->mock_bucket_metadata;
   action_under_test->bucket_metadata->set_multipart_index_layout(index_layout);
 
-  action_under_test->motr_kv_reader =
-      motr_kvs_reader_factory->mock_motr_kvs_reader;
+  action_under_test->multipart_kv_cursor =
+      std::make_shared<S3MotrKVSScanCursor>(
+          ptr_mock_request, motr_kvs_reader_factory, ptr_mock_s3_motr_api);
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               next_keyval(_, _, _, _, _, _)).Times(1);
   action_under_test->fetch_multipart_objects();
@@ -310,8 +311,9 @@ TEST_F(S3DeleteBucketActionTest, FetchMultipartObjectSuccess) {
       bucket_meta_factory->mock_bucket_metadata;
   action_under_test->bucket_metadata->set_multipart_index_layout(index_layout);
 
-  action_under_test->motr_kv_reader =
-      motr_kvs_reader_factory->mock_motr_kvs_reader;
+  action_under_test->multipart_kv_cursor =
+      std::make_shared<S3MotrKVSScanCursor>(
+          ptr_mock_request, motr_kvs_reader_factory, ptr_mock_s3_motr_api);
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               get_key_values())
       .Times(1)
@@ -337,8 +339,9 @@ TEST_F(S3DeleteBucketActionTest, FetchMultipartObjectSuccessIllegalJson) {
       bucket_meta_factory->mock_bucket_metadata;
   action_under_test->bucket_metadata->set_multipart_index_layout(index_layout);
 
-  action_under_test->motr_kv_reader =
-      motr_kvs_reader_factory->mock_motr_kvs_reader;
+  action_under_test->multipart_kv_cursor =
+      std::make_shared<S3MotrKVSScanCursor>(
+          ptr_mock_request, motr_kvs_reader_factory, ptr_mock_s3_motr_api);
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               get_key_values())
       .Times(1)
@@ -373,8 +376,9 @@ TEST_F(S3DeleteBucketActionTest,
   action_under_test->bucket_metadata =
       bucket_meta_factory->mock_bucket_metadata;
 
-  action_under_test->motr_kv_reader =
-      motr_kvs_reader_factory->mock_motr_kvs_reader;
+  action_under_test->multipart_kv_cursor =
+      std::make_shared<S3MotrKVSScanCursor>(
+          ptr_mock_request, motr_kvs_reader_factory, ptr_mock_s3_motr_api);
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               get_key_values())
       .Times(1)
@@ -395,8 +399,9 @@ TEST_F(S3DeleteBucketActionTest, FetchMultipartObjectSuccessNoMultipart) {
   std::map<std::string, std::pair<int, std::string>> mymap;
   action_under_test->bucket_metadata =
       bucket_meta_factory->mock_bucket_metadata;
-  action_under_test->motr_kv_reader =
-      motr_kvs_reader_factory->mock_motr_kvs_reader;
+  action_under_test->multipart_kv_cursor =
+      std::make_shared<S3MotrKVSScanCursor>(
+          ptr_mock_request, motr_kvs_reader_factory, ptr_mock_s3_motr_api);
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               get_key_values())
       .Times(1)
@@ -316,6 +316,7 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
               get_keyval(_, keys, _, _)).Times(AtLeast(1));
   action_under_test->fetch_objects_info();
   EXPECT_EQ(2, action_under_test->delete_index_in_req);
+  EXPECT_EQ(1, action_under_test->lanes_in_flight);
 }
 
 TEST_F(S3DeleteMultipleObjectsActionTest, FetchObjectInfoFailed) {
@@ -328,7 +329,9 @@ TEST_F(S3DeleteMultipleObjectsActionTest, FetchObjectInfoFailed) {
   EXPECT_CALL(*mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
   EXPECT_CALL(*mock_request, send_response(S3HttpFailed500, _)).Times(1);
   EXPECT_CALL(*mock_request, resume(_)).Times(1);
-  action_under_test->fetch_objects_info_failed();
+  auto lane = action_under_test->create_lane();
+  action_under_test->lanes_in_flight = 1;
+  action_under_test->fetch_objects_info_failed(lane);
 
   EXPECT_STREQ("InternalError", action_under_test->get_s3_error_code().c_str());
 }
@@ -351,7 +354,9 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
                          S3DeleteMultipleObjectsActionTest::func_callback_one,
                          this);
   action_under_test->validate_request_body(SAMPLE_DELETE_REQUEST);
-  action_under_test->keys_to_delete.push_back("SampleDocument1.txt");
+  auto lane = action_under_test->create_lane();
+  action_under_test->lanes_in_flight = 1;
+  lane->keys_to_delete.push_back("SampleDocument1.txt");
   action_under_test->delete_index_in_req = 1;
 
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader), get_state())
@@ -359,7 +364,8 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
       .WillOnce(Return(S3MotrKVSReaderOpState::missing));
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               get_keyval(_, missing_key, _, _)).Times(AtLeast(1));
-  action_under_test->fetch_objects_info_failed();
+  action_under_test->fetch_objects_info_failed(lane);
+  EXPECT_EQ(1, action_under_test->lanes_in_flight);
 }
 
 TEST_F(S3DeleteMultipleObjectsActionTest,
@@ -376,8 +382,10 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
                          S3DeleteMultipleObjectsActionTest::func_callback_one,
                          this);
   action_under_test->validate_request_body(SAMPLE_DELETE_REQUEST);
-  action_under_test->keys_to_delete.push_back("SampleDocument1.txt");
-  action_under_test->keys_to_delete.push_back("SampleDocument1.txt");
+  auto lane = action_under_test->create_lane();
+  action_under_test->lanes_in_flight = 1;
+  lane->keys_to_delete.push_back("SampleDocument1.txt");
+  lane->keys_to_delete.push_back("SampleDocument1.txt");
   action_under_test->delete_index_in_req = 2;
 
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader), get_state())
@@ -387,7 +395,7 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
   EXPECT_CALL(*mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
   EXPECT_CALL(*mock_request, send_response(S3HttpSuccess200, _)).Times(1);
   EXPECT_CALL(*mock_request, resume(_)).Times(1);
-  action_under_test->fetch_objects_info_failed();
+  action_under_test->fetch_objects_info_failed(lane);
 }
 
 TEST_F(S3DeleteMultipleObjectsActionTest,
@@ -412,13 +420,9 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
       .Times(AtLeast(1))
       .WillRepeatedly(ReturnRef(index_layout));
 
-  // mock kv reader/writer
-  action_under_test->motr_kv_reader =
-      action_under_test->motr_kvs_reader_factory->create_motr_kvs_reader(
-          mock_request);
-  action_under_test->motr_kv_writer =
-      action_under_test->motr_kvs_writer_factory->create_motr_kvs_writer(
-          mock_request);
+  // lane with mock kv reader/writer
+  auto lane = action_under_test->create_lane();
+  action_under_test->lanes_in_flight = 1;
 
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               get_key_values()).WillRepeatedly(ReturnRef(result_keys_values));
@@ -444,9 +448,9 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
   std::string sdrf = "<Delete><Object><Key>objname</Key></Object></Delete>";
   action_under_test->delete_request.initialize(mock_request, sdrf);
 
-  action_under_test->fetch_objects_info_successful();
+  action_under_test->fetch_objects_info_successful(lane);
 
-  EXPECT_EQ(1, action_under_test->objects_metadata.size());
+  EXPECT_EQ(1, lane->objects_metadata.size());
   EXPECT_EQ(2, action_under_test->delete_objects_response.get_success_count());
   EXPECT_EQ(0, action_under_test->delete_objects_response.get_failure_count());
 }
@@ -471,13 +475,9 @@ TEST_F(S3DeleteMultipleObjectsActionTest, FetchObjectsInfoSuccessful) {
       .Times(AtLeast(1))
       .WillRepeatedly(ReturnRef(index_layout));
 
-  // mock kv reader/writer
-  action_under_test->motr_kv_reader =
-      action_under_test->motr_kvs_reader_factory->create_motr_kvs_reader(
-          mock_request);
-  action_under_test->motr_kv_writer =
-      action_under_test->motr_kvs_writer_factory->create_motr_kvs_writer(
-          mock_request);
+  // lane with mock kv reader/writer
+  auto lane = action_under_test->create_lane();
+  action_under_test->lanes_in_flight = 1;
 
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               get_key_values()).WillRepeatedly(ReturnRef(result_keys_values));
@@ -503,9 +503,9 @@ TEST_F(S3DeleteMultipleObjectsActionTest, FetchObjectsInfoSuccessful) {
   std::string sdrf = "<Delete><Object><Key>objname</Key></Object></Delete>";
   action_under_test->delete_request.initialize(mock_request, sdrf);
 
-  action_under_test->fetch_objects_info_successful();
+  action_under_test->fetch_objects_info_successful(lane);
 
-  EXPECT_EQ(3, action_under_test->objects_metadata.size());
+  EXPECT_EQ(3, lane->objects_metadata.size());
 }
 
 TEST_F(S3DeleteMultipleObjectsActionTest,
@@ -525,13 +525,9 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
   bucket_meta_factory->mock_bucket_metadata
       ->set_objects_version_list_index_layout(index_layout);
 
-  // mock kv reader/writer
-  action_under_test->motr_kv_reader =
-      action_under_test->motr_kvs_reader_factory->create_motr_kvs_reader(
-          mock_request);
-  action_under_test->motr_kv_writer =
-      action_under_test->motr_kvs_writer_factory->create_motr_kvs_writer(
-          mock_request);
+  // lane with mock kv reader/writer
+  auto lane = action_under_test->create_lane();
+  action_under_test->lanes_in_flight = 1;
 
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               get_key_values()).WillRepeatedly(ReturnRef(result_keys_values));
@@ -546,10 +542,10 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
       .Times(AtLeast(1));
   EXPECT_CALL(*mock_request, resume(_)).Times(1);
 
-  action_under_test->fetch_objects_info_successful();
+  action_under_test->fetch_objects_info_successful(lane);
 
   EXPECT_EQ(0, action_under_test->oids_to_delete.size());
-  EXPECT_EQ(0, action_under_test->objects_metadata.size());
+  EXPECT_EQ(0, lane->objects_metadata.size());
   EXPECT_EQ(0, action_under_test->delete_objects_response.get_success_count());
   EXPECT_EQ(3, action_under_test->delete_objects_response.get_failure_count());
 }
@@ -558,11 +554,14 @@ TEST_F(S3DeleteMultipleObjectsActionTest, DeleteObjectMetadata) {
   EXPECT_CALL(*(motr_kvs_writer_factory->mock_motr_kvs_writer),
               delete_keyval(_, _, _, _)).Times(1);
 
-  action_under_test->delete_objects_metadata();
+  auto lane = action_under_test->create_lane();
+  action_under_test->delete_objects_metadata(lane);
 }
 
 TEST_F(S3DeleteMultipleObjectsActionTest, DeleteObjectMetadataSucceeded) {
-  action_under_test->objects_metadata.push_back(
+  auto lane = action_under_test->create_lane();
+  action_under_test->lanes_in_flight = 1;
+  lane->objects_metadata.push_back(
       object_meta_factory->create_object_metadata_obj(mock_request));
 
   action_under_test->oids_to_delete.push_back(oid);
@@ -570,8 +569,12 @@ TEST_F(S3DeleteMultipleObjectsActionTest, DeleteObjectMetadataSucceeded) {
       .WillRepeatedly(Return(oid));
   EXPECT_CALL(*(object_meta_factory->mock_object_metadata), get_object_name())
       .WillOnce(Return("objname"));
+  // Last lane is done, so the response goes out
+  EXPECT_CALL(*mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*mock_request, send_response(S3HttpSuccess200, _)).Times(1);
+  EXPECT_CALL(*mock_request, resume(_)).Times(1);
 
-  action_under_test->delete_extended_metadata_successful();
+  action_under_test->delete_extended_metadata_successful(lane);
 
   EXPECT_TRUE(action_under_test->at_least_one_delete_successful);
   EXPECT_EQ(1, action_under_test->delete_objects_response.get_success_count());
@@ -579,6 +582,8 @@ TEST_F(S3DeleteMultipleObjectsActionTest, DeleteObjectMetadataSucceeded) {
 }
 
 TEST_F(S3DeleteMultipleObjectsActionTest, DeleteObjectMetadataFailedToLaunch) {
+  auto lane = action_under_test->create_lane();
+  action_under_test->lanes_in_flight = 1;
   EXPECT_CALL(*(motr_kvs_writer_factory->mock_motr_kvs_writer), get_state())
       .Times(1)
       .WillRepeatedly(Return(S3MotrKVSWriterOpState::failed));
@@ -586,7 +591,7 @@ TEST_F(S3DeleteMultipleObjectsActionTest, DeleteObjectMetadataFailedToLaunch) {
   EXPECT_CALL(*mock_request, send_response(500, _)).Times(AtLeast(1));
   EXPECT_CALL(*mock_request, resume(_)).Times(1);
 
-  action_under_test->delete_objects_metadata_failed();
+  action_under_test->delete_objects_metadata_failed(lane);
 
   EXPECT_FALSE(action_under_test->at_least_one_delete_successful);
   EXPECT_EQ(0, action_under_test->delete_objects_response.get_success_count());
@@ -595,9 +600,11 @@ TEST_F(S3DeleteMultipleObjectsActionTest, DeleteObjectMetadataFailedToLaunch) {
 
 TEST_F(S3DeleteMultipleObjectsActionTest,
        DeleteObjectMetadataFailedWithMissing) {
-  action_under_test->objects_metadata.push_back(
+  auto lane = action_under_test->create_lane();
+  action_under_test->lanes_in_flight = 1;
+  lane->objects_metadata.push_back(
       object_meta_factory->create_object_metadata_obj(mock_request));
-  action_under_test->objects_metadata.push_back(
+  lane->objects_metadata.push_back(
       object_meta_factory->create_object_metadata_obj(mock_request));
 
   EXPECT_CALL(*(motr_kvs_writer_factory->mock_motr_kvs_writer),
@@ -614,7 +621,7 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
   EXPECT_CALL(*(object_meta_factory->mock_object_metadata), get_object_name())
       .WillRepeatedly(Return("objname"));
 
-  action_under_test->delete_objects_metadata_failed();
+  action_under_test->delete_objects_metadata_failed(lane);
 
   EXPECT_TRUE(action_under_test->at_least_one_delete_successful);
   EXPECT_EQ(2, action_under_test->delete_objects_response.get_success_count());
@@ -623,9 +630,11 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
 
 TEST_F(S3DeleteMultipleObjectsActionTest,
        DeleteObjectMetadataFailedWithErrors) {
-  action_under_test->objects_metadata.push_back(
+  auto lane = action_under_test->create_lane();
+  action_under_test->lanes_in_flight = 1;
+  lane->objects_metadata.push_back(
       object_meta_factory->create_object_metadata_obj(mock_request));
-  action_under_test->objects_metadata.push_back(
+  lane->objects_metadata.push_back(
       object_meta_factory->create_object_metadata_obj(mock_request));
 
   EXPECT_CALL(*(motr_kvs_writer_factory->mock_motr_kvs_writer),
@@ -642,7 +651,7 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
   EXPECT_CALL(*(object_meta_factory->mock_object_metadata), get_object_name())
       .WillRepeatedly(Return("objname"));
 
-  action_under_test->delete_objects_metadata_failed();
+  action_under_test->delete_objects_metadata_failed(lane);
 
   EXPECT_STREQ("InternalError", action_under_test->get_s3_error_code().c_str());
   EXPECT_FALSE(action_under_test->at_least_one_delete_successful);
@@ -676,9 +685,11 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
       .Times(1)
       .WillRepeatedly(Return(S3MotrKVSWriterOpState::failed));
 
-  action_under_test->objects_metadata.push_back(
+  auto lane = action_under_test->create_lane();
+  action_under_test->lanes_in_flight = 1;
+  lane->objects_metadata.push_back(
       object_meta_factory->create_object_metadata_obj(mock_request));
-  action_under_test->objects_metadata.push_back(
+  lane->objects_metadata.push_back(
       object_meta_factory->create_object_metadata_obj(mock_request));
 
   EXPECT_CALL(*(motr_kvs_writer_factory->mock_motr_kvs_writer),
@@ -689,7 +700,7 @@ TEST_F(S3DeleteMultipleObjectsActionTest,
       .WillRepeatedly(Return("objname"));
 
   action_under_test->delete_index_in_req = -1;  // simulate
-  action_under_test->delete_objects_metadata_failed();
+  action_under_test->delete_objects_metadata_failed(lane);
 
   EXPECT_TRUE(action_under_test->at_least_one_delete_successful);
   EXPECT_EQ(2, action_under_test->delete_objects_response.get_success_count());
@@ -803,8 +814,8 @@ TEST_F(S3DeleteMultipleObjectsActionTest, CleanupOnMetadataSavedTest2) {
 }
 
 TEST_F(S3DeleteMultipleObjectsResponseBodyTest, ConstructorTest) {
-  EXPECT_EQ(0, action_under_test->success.size());
-  EXPECT_EQ(0, action_under_test->error.size());
+  EXPECT_EQ(0, action_under_test->success_count);
+  EXPECT_EQ(0, action_under_test->error_count);
 }
 
 TEST_F(S3DeleteMultipleObjectsResponseBodyTest, AtleastOneFailedQuietModeOn) {
@@ -879,3 +890,77 @@ TEST_F(S3DeleteMultipleObjectsActionTest, DelayedDeleteMultipleObjects) {
 
   action_under_test->cleanup();
 }
+
+TEST_F(S3DeleteMultipleObjectsActionTest, FetchObjectInfoStartsLanes) {
+  S3Option *option_instance = S3Option::get_instance();
+  int fetch_count = option_instance->get_motr_idx_fetch_count();
+  unsigned max_inflight = option_instance->get_motr_multi_delete_max_inflight();
+  option_instance->set_motr_idx_fetch_count(1);
+  option_instance->set_motr_multi_delete_max_inflight(2);
+  CREATE_BUCKET_METADATA;
+
+  EXPECT_CALL(*(bucket_meta_factory->mock_bucket_metadata),
+              get_object_list_index_layout())
+      .WillRepeatedly(ReturnRef(index_layout));
+  std::string sdrf =
+      "<Delete><Object><Key>obj1</Key></Object>"
+      "<Object><Key>obj2</Key></Object>"
+      "<Object><Key>obj3</Key></Object></Delete>";
+  action_under_test->delete_request.initialize(mock_request, sdrf);
+
+  // Two batches of one key in flight, the third waits for a free lane
+  EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
+              get_keyval(_, _, _, _)).Times(2);
+  action_under_test->fetch_objects_info();
+
+  EXPECT_EQ(2, action_under_test->lanes.size());
+  EXPECT_EQ(2, action_under_test->lanes_in_flight);
+  EXPECT_EQ(2, action_under_test->delete_index_in_req);
+  EXPECT_EQ(1, action_under_test->lanes[1]->keys_to_delete.size());
+
+  option_instance->set_motr_idx_fetch_count(fetch_count);
+  option_instance->set_motr_multi_delete_max_inflight(max_inflight);
+}
+
+TEST_F(S3DeleteMultipleObjectsActionTest, LaneBatchDoneRespondsAfterLastLane) {
+  auto lane1 = action_under_test->create_lane();
+  auto lane2 = action_under_test->create_lane();
+  action_under_test->lanes_in_flight = 2;
+  action_under_test->delete_objects_response.add_success("obj1");
+
+  EXPECT_CALL(*mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*mock_request, send_response(S3HttpSuccess200, _)).Times(1);
+  EXPECT_CALL(*mock_request, resume(_)).Times(1);
+
+  action_under_test->lane_batch_done(lane1);
+  EXPECT_EQ(1, action_under_test->lanes_in_flight);
+  action_under_test->lane_batch_done(lane2);
+  EXPECT_EQ(0, action_under_test->lanes_in_flight);
+}
+
+TEST_F(S3DeleteMultipleObjectsActionTest, LaneBatchDoneStopsOnErrorAndDrains) {
+  std::string sdrf =
+      "<Delete><Object><Key>obj1</Key></Object>"
+      "<Object><Key>obj2</Key></Object>"
+      "<Object><Key>obj3</Key></Object></Delete>";
+  action_under_test->delete_request.initialize(mock_request, sdrf);
+  auto lane1 = action_under_test->create_lane();
+  auto lane2 = action_under_test->create_lane();
+  action_under_test->lanes_in_flight = 2;
+  action_under_test->delete_index_in_req = 2;
+
+  // No more batches are started once a lane failed
+  EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
+              get_keyval(_, _, _, _)).Times(0);
+  EXPECT_CALL(*mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*mock_request, send_response(S3HttpFailed500, _)).Times(1);
+  EXPECT_CALL(*mock_request, resume(_)).Times(1);
+
+  action_under_test->set_lane_error("InternalError");
+  action_under_test->lane_batch_done(lane1);
+  EXPECT_EQ(1, action_under_test->lanes_in_flight);
+  action_under_test->set_lane_error("ServiceUnavailable");
+  action_under_test->lane_batch_done(lane2);
+
+  EXPECT_STREQ("InternalError", action_under_test->get_s3_error_code().c_str());
+}
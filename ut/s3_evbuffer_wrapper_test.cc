@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "s3_evbuffer_wrapper.h"
+#include "s3_mem_pool_manager.h"
+
+// Unit size of motr read pool in s3config-test.yaml
+#define TEST_UNIT_SIZE 16384
+
+class S3EvbufferTest : public testing::Test {
+ protected:
+  S3MempoolManager *pool_manager;
+  size_t free_space_before;
+
+  void SetUp() {
+    pool_manager = S3MempoolManager::get_instance();
+    free_space_before = pool_manager->get_free_space_for(TEST_UNIT_SIZE);
+  }
+
+  size_t used_pool_space() {
+    return free_space_before -
+           pool_manager->get_free_space_for(TEST_UNIT_SIZE);
+  }
+};
+
+TEST_F(S3EvbufferTest, PoolBuffersAreUnitSized) {
+  ASSERT_TRUE(pool_manager->has_pool_for_unit_size(TEST_UNIT_SIZE));
+  {
+    S3Evbuffer evbuf("test-req", 3 * TEST_UNIT_SIZE, TEST_UNIT_SIZE, true);
+    ASSERT_EQ(0, evbuf.init());
+
+    EXPECT_EQ(3u, evbuf.get_nvecs());
+    EXPECT_EQ(3u * TEST_UNIT_SIZE, evbuf.get_evbuff_length());
+    EXPECT_EQ(3u * TEST_UNIT_SIZE, used_pool_space());
+  }
+  // Freeing the evbuffer returns buffers to the pool
+  EXPECT_EQ(0u, used_pool_space());
+}
+
+TEST_F(S3EvbufferTest, PoolBuffersReleasedAfterSendingPart) {
+  S3Evbuffer evbuf("test-req", 2 * TEST_UNIT_SIZE, TEST_UNIT_SIZE, true);
+  ASSERT_EQ(0, evbuf.init());
+
+  // Range read: skip the start and send a part of the rest
+  EXPECT_EQ(0, evbuf.drain_data(100));
+  evbuf.read_drain_data_from_buffer(TEST_UNIT_SIZE);
+  EXPECT_EQ((size_t)TEST_UNIT_SIZE, evbuf.get_evbuff_length());
+
+  struct evbuffer *p_evbuf = evbuf.release_ownership();
+  EXPECT_EQ((size_t)TEST_UNIT_SIZE, used_pool_space());
+  evbuffer_free(p_evbuf);
+  EXPECT_EQ(0u, used_pool_space());
+}
+
+TEST_F(S3EvbufferTest, NoPoolBuffersForUnknownUnitSize) {
+  EXPECT_FALSE(pool_manager->has_pool_for_unit_size(3 * TEST_UNIT_SIZE));
+  EXPECT_FALSE(S3Evbuffer::can_use_pool_buffers(3 * TEST_UNIT_SIZE));
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "s3_fake_motr_obj_store.h"
+
+// Extents and buffers of one object op
+class FakeObjOp {
+ public:
+  std::vector<std::string> bufs;
+  std::vector<void *> buf_ptrs;
+  std::vector<m0_bcount_t> counts;
+  std::vector<m0_bindex_t> offsets;
+  struct m0_bufvec data;
+  struct m0_indexvec ext;
+
+  FakeObjOp(const std::vector<std::pair<m0_bindex_t, std::string>> &parts) {
+    for (const auto &part : parts) {
+      offsets.push_back(part.first);
+      bufs.push_back(part.second);
+      counts.push_back(part.second.size());
+    }
+    for (auto &buf : bufs) {
+      buf_ptrs.push_back(&buf[0]);
+    }
+    data.ov_vec.v_nr = bufs.size();
+    data.ov_vec.v_count = counts.data();
+    data.ov_buf = buf_ptrs.data();
+    ext.iv_vec.v_nr = bufs.size();
+    ext.iv_vec.v_count = counts.data();
+    ext.iv_index = offsets.data();
+  }
+};
+
+class S3FakeMotrObjStoreTest : public testing::Test {
+ protected:
+  S3FakeMotrObjStoreTest() {
+    store.reset(new S3FakeMotrObjStore());
+    oid = {0x1234, 0x5678};
+  }
+
+  std::unique_ptr<S3FakeMotrObjStore> store;
+  struct m0_uint128 oid;
+};
+
+// Same store, objects kept as files of a temporary directory
+class S3FakeMotrObjStoreFileTest : public S3FakeMotrObjStoreTest {
+ protected:
+  S3FakeMotrObjStoreFileTest() {
+    char tmpl[] = "/tmp/s3_fake_obj_store_XXXXXX";
+    dir = mkdtemp(tmpl);
+    store.reset(new S3FakeMotrObjStore(dir));
+  }
+
+  ~S3FakeMotrObjStoreFileTest() {
+    store->obj_delete(oid);
+    rmdir(dir.c_str());
+  }
+
+  std::string dir;
+};
+
+TEST_F(S3FakeMotrObjStoreTest, CreateOpenDelete) {
+  EXPECT_EQ(-ENOENT, store->obj_open(oid));
+  EXPECT_EQ(0, store->obj_create(oid));
+  EXPECT_EQ(-EEXIST, store->obj_create(oid));
+  EXPECT_EQ(0, store->obj_open(oid));
+  EXPECT_EQ(0, store->obj_delete(oid));
+  EXPECT_EQ(-ENOENT, store->obj_open(oid));
+  EXPECT_EQ(-ENOENT, store->obj_delete(oid));
+}
+
+TEST_F(S3FakeMotrObjStoreTest, ReadsBackWrittenData) {
+  ASSERT_EQ(0, store->obj_create(oid));
+  FakeObjOp write_op({{0, "abcd"}, {4, "efgh"}});
+  EXPECT_EQ(0, store->obj_write(oid, write_op.ext, write_op.data));
+
+  FakeObjOp read_op({{2, "...."}, {6, ".."}});
+  EXPECT_EQ(0, store->obj_read(oid, read_op.ext, read_op.data));
+  EXPECT_EQ("cdef", read_op.bufs[0]);
+  EXPECT_EQ("gh", read_op.bufs[1]);
+}
+
+TEST_F(S3FakeMotrObjStoreTest, OverwritesData) {
+  ASSERT_EQ(0, store->obj_create(oid));
+  FakeObjOp write_op({{0, "abcdefgh"}});
+  EXPECT_EQ(0, store->obj_write(oid, write_op.ext, write_op.data));
+  FakeObjOp overwrite_op({{2, "XY"}});
+  EXPECT_EQ(0, store->obj_write(oid, overwrite_op.ext, overwrite_op.data));
+
+  FakeObjOp read_op({{0, "........"}});
+  EXPECT_EQ(0, store->obj_read(oid, read_op.ext, read_op.data));
+  EXPECT_EQ("abXYefgh", read_op.bufs[0]);
+}
+
+TEST_F(S3FakeMotrObjStoreTest, HolesAndTailReadAsZeros) {
+  ASSERT_EQ(0, store->obj_create(oid));
+  FakeObjOp write_op({{4, "ab"}});
+  EXPECT_EQ(0, store->obj_write(oid, write_op.ext, write_op.data));
+
+  FakeObjOp read_op({{0, "........"}, {16, "...."}});
+  EXPECT_EQ(0, store->obj_read(oid, read_op.ext, read_op.data));
+  EXPECT_EQ(std::string("\0\0\0\0ab\0\0", 8), read_op.bufs[0]);
+  EXPECT_EQ(std::string(4, '\0'), read_op.bufs[1]);
+}
+
+TEST_F(S3FakeMotrObjStoreTest, MissingObjectFailsIo) {
+  FakeObjOp op({{0, "abcd"}});
+  EXPECT_EQ(-ENOENT, store->obj_write(oid, op.ext, op.data));
+  EXPECT_EQ(-ENOENT, store->obj_read(oid, op.ext, op.data));
+}
+
+TEST_F(S3FakeMotrObjStoreFileTest, CreateOpenDelete) {
+  EXPECT_TRUE(store->is_file_backed());
+  EXPECT_EQ(-ENOENT, store->obj_open(oid));
+  EXPECT_EQ(0, store->obj_create(oid));
+  EXPECT_EQ(-EEXIST, store->obj_create(oid));
+  EXPECT_EQ(0, store->obj_open(oid));
+  EXPECT_EQ(0, store->obj_delete(oid));
+  EXPECT_EQ(-ENOENT, store->obj_delete(oid));
+}
+
+TEST_F(S3FakeMotrObjStoreFileTest, ReadsBackWrittenData) {
+  ASSERT_EQ(0, store->obj_create(oid));
+  FakeObjOp write_op({{0, "abcd"}, {6, "gh"}});
+  EXPECT_EQ(0, store->obj_write(oid, write_op.ext, write_op.data));
+
+  FakeObjOp read_op({{2, "......"}, {8, "...."}});
+  EXPECT_EQ(0, store->obj_read(oid, read_op.ext, read_op.data));
+  EXPECT_EQ(std::string("cd\0\0gh", 6), read_op.bufs[0]);
+  EXPECT_EQ(std::string(4, '\0'), read_op.bufs[1]);
+}
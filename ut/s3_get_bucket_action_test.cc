@@ -41,11 +41,12 @@ using ::testing::InSequence;
             ->create_bucket_metadata_obj(request_mock); \
   } while (0)
 
-#define CREATE_KVS_READER_OBJ                                         \
-  do {                                                                \
-    action_under_test_ptr->motr_kv_reader =                           \
-        action_under_test_ptr->s3_motr_kvs_reader_factory             \
-            ->create_motr_kvs_reader(request_mock, s3_motr_api_mock); \
+#define CREATE_KVS_READER_OBJ                                                \
+  do {                                                                       \
+    action_under_test_ptr->motr_kv_cursor =                                  \
+        std::make_shared<S3MotrKVSScanCursor>(                               \
+            request_mock, action_under_test_ptr->s3_motr_kvs_reader_factory, \
+            s3_motr_api_mock);                                               \
   } while (0)
 
 #define SET_NEXT_OBJ_SUCCESSFUL_EXPECTATIONS                                  \
@@ -408,6 +409,41 @@ TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessfulDelimiterLastKey) {
   EXPECT_EQ("test/\xff", action_under_test_ptr->last_key);
 }
 
+// Keys rolled into a common prefix are skipped within the fetched batch,
+// without another key enumeration.
+TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessfulDelimiterSkipsInBatch) {
+  CREATE_BUCKET_METADATA_OBJ;
+  CREATE_KVS_READER_OBJ;
+
+  action_under_test_ptr->request_delimiter.assign("/");
+  result_keys_values.insert(
+      std::make_pair("a/key1", std::make_pair(10, "keyval")));
+  result_keys_values.insert(
+      std::make_pair("a/key2", std::make_pair(10, "keyval")));
+  result_keys_values.insert(std::make_pair("b", std::make_pair(10, "keyval")));
+  result_keys_values.insert(
+      std::make_pair("c/key1", std::make_pair(10, "keyval")));
+  result_keys_values.insert(
+      std::make_pair("c/key2", std::make_pair(10, "keyval")));
+  result_keys_values.insert(std::make_pair("d", std::make_pair(10, "keyval")));
+
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata), get_object_name())
+      .WillOnce(Return("b"))
+      .WillOnce(Return("d"));
+  EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
+              next_keyval(_, _, _, _, _, _)).Times(0);
+  OBJ_METADATA_EXPECTATIONS;
+  SET_NEXT_OBJ_SUCCESSFUL_EXPECTATIONS;
+
+  action_under_test_ptr->max_record_count =
+      S3Option::get_instance()->get_motr_idx_fetch_count();
+
+  action_under_test_ptr->get_next_objects_successful();
+  EXPECT_EQ(2, action_under_test_ptr->object_list->size());
+  EXPECT_EQ(2, action_under_test_ptr->object_list->common_prefixes_size());
+  EXPECT_EQ("d", action_under_test_ptr->last_key);
+}
+
 // Prefix in multi-component object names
 TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessfulMultiComponentKey) {
   CREATE_BUCKET_METADATA_OBJ;
@@ -435,12 +471,7 @@ TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessfulMultiComponentKey) {
       std::make_pair("cquux/thud", std::make_pair(0, "keyval")));
   result_keys_values.insert(
       std::make_pair("cquux/bla", std::make_pair(0, "keyval")));
-  // last_key:= boo/\xff
-  std::map<std::string, std::pair<int, std::string>> result_next_keys_values;
-  result_next_keys_values.insert(
-      std::make_pair("cquux/thud", std::make_pair(0, "keyval")));
-  result_next_keys_values.insert(
-      std::make_pair("cquux/bla", std::make_pair(0, "keyval")));
+  // Keys of "boo/" are skipped within the batch, "cquux/" fills max_keys
   // last_key:= cquux/\xff
   std::map<std::string, std::pair<int, std::string>>
       result_next_keys_values_empty;
@@ -452,8 +483,6 @@ TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessfulMultiComponentKey) {
     InSequence s;
     EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
                 get_key_values()).WillOnce(ReturnRef(result_keys_values));
-    EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
-                get_key_values()).WillOnce(ReturnRef(result_next_keys_values));
     EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
                 get_key_values())
         .WillOnce(ReturnRef(result_next_keys_values_empty));
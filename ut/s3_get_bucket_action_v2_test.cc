@@ -40,11 +40,12 @@ using ::testing::_;
             ->create_bucket_metadata_obj(request_mock); \
   } while (0)
 
-#define CREATE_KVS_READER_OBJ                                         \
-  do {                                                                \
-    action_under_test_ptr->motr_kv_reader =                           \
-        action_under_test_ptr->s3_motr_kvs_reader_factory             \
-            ->create_motr_kvs_reader(request_mock, s3_motr_api_mock); \
+#define CREATE_KVS_READER_OBJ                                                \
+  do {                                                                       \
+    action_under_test_ptr->motr_kv_cursor =                                  \
+        std::make_shared<S3MotrKVSScanCursor>(                               \
+            request_mock, action_under_test_ptr->s3_motr_kvs_reader_factory, \
+            s3_motr_api_mock);                                               \
   } while (0)
 
 #define CREATE_ACTION_UNDER_TEST_OBJ                                     \
@@ -40,11 +40,12 @@ using ::testing::_;
             ->create_bucket_metadata_obj(request_mock); \
   } while (0)
 
-#define CREATE_KVS_READER_OBJ                                         \
-  do {                                                                \
-    action_under_test_ptr->motr_kv_reader =                           \
-        action_under_test_ptr->s3_motr_kvs_reader_factory             \
-            ->create_motr_kvs_reader(request_mock, s3_motr_api_mock); \
+#define CREATE_KVS_READER_OBJ                                                \
+  do {                                                                       \
+    action_under_test_ptr->motr_kv_cursor =                                  \
+        std::make_shared<S3MotrKVSScanCursor>(                               \
+            request_mock, action_under_test_ptr->s3_motr_kvs_reader_factory, \
+            s3_motr_api_mock);                                               \
   } while (0)
 
 #define CREATE_ACTION_UNDER_TEST_OBJ                                       \
@@ -372,6 +373,45 @@ TEST_F(S3GetMultipartBucketActionTest,
       2, action_under_test_ptr->multipart_object_list.common_prefixes_size());
 }
 
+// Fetched batch is full and ends within a common prefix,
+// next key enumeration starts past the common prefix.
+TEST_F(S3GetMultipartBucketActionTest,
+       GetNextObjectsSuccessfulDelimiterSeeksPastPrefix) {
+  CREATE_BUCKET_METADATA_OBJ;
+  CREATE_KVS_READER_OBJ;
+  action_under_test_ptr->bucket_metadata->set_multipart_index_layout(
+      {object_list_indx_oid});
+
+  action_under_test_ptr->request_delimiter.assign("/");
+  action_under_test_ptr->request_prefix.assign("");
+
+  result_keys_values.insert(
+      std::make_pair("dir/key0", std::make_pair(0, "keyval")));
+  result_keys_values.insert(
+      std::make_pair("dir/key1", std::make_pair(0, "keyval")));
+
+  int fetch_count = S3Option::get_instance()->get_motr_idx_fetch_count();
+  S3Option::get_instance()->set_motr_idx_fetch_count(2);
+
+  OBJ_METADATA_EXPECTATIONS;
+  EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
+              get_key_values()).WillRepeatedly(ReturnRef(result_keys_values));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata), from_json(_))
+      .WillRepeatedly(Return(0));
+  EXPECT_CALL(*(bucket_meta_factory->mock_bucket_metadata), get_state())
+      .WillRepeatedly(Return(S3BucketMetadataState::present));
+  EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
+              next_keyval(_, std::string("dir/\xff"), 2, _, _, _)).Times(1);
+
+  action_under_test_ptr->get_next_objects_successful();
+  S3Option::get_instance()->set_motr_idx_fetch_count(fetch_count);
+
+  EXPECT_EQ(0, action_under_test_ptr->multipart_object_list.size());
+  EXPECT_EQ(
+      1, action_under_test_ptr->multipart_object_list.common_prefixes_size());
+  EXPECT_TRUE(action_under_test_ptr->seek_key.empty());
+}
+
 TEST_F(S3GetMultipartBucketActionTest, SendResponseToClientServiceUnavailable) {
   CREATE_BUCKET_METADATA_OBJ;
 
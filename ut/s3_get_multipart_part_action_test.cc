@@ -371,8 +371,6 @@ TEST_F(S3GetMultipartPartActionTest, GetNextObjectsMultipartPresent) {
       object_mp_meta_factory->mock_object_mp_metadata;
   EXPECT_CALL(*(object_mp_meta_factory->mock_object_mp_metadata), get_state())
       .WillRepeatedly(Return(S3ObjectMetadataState::present));
-  action_under_test->motr_kv_reader =
-      motr_kvs_reader_factory->mock_motr_kvs_reader;
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               next_keyval(_, _, _, _, _, _)).Times(1);
   action_under_test->get_next_objects();
@@ -428,8 +426,8 @@ TEST_F(S3GetMultipartPartActionTest,
           1, "{\"Bucket-Name\":\"seagate_bucket\",\"Object-Name\":\"2\"}")));
   action_under_test->object_multipart_metadata =
       object_mp_meta_factory->mock_object_mp_metadata;
-  action_under_test->motr_kv_reader =
-      motr_kvs_reader_factory->mock_motr_kvs_reader;
+  action_under_test->motr_kv_cursor = std::make_shared<S3MotrKVSScanCursor>(
+      ptr_mock_request, motr_kvs_reader_factory, ptr_mock_s3_motr_api);
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               get_key_values())
       .Times(1)
@@ -468,8 +466,8 @@ TEST_F(S3GetMultipartPartActionTest, GetNextObjectsSuccessfulListNotTruncated) {
       std::make_pair(
           1, "{\"Bucket-Name\":\"seagate_bucket\",\"Object-Name\":\"2\"}")));
 
-  action_under_test->motr_kv_reader =
-      motr_kvs_reader_factory->mock_motr_kvs_reader;
+  action_under_test->motr_kv_cursor = std::make_shared<S3MotrKVSScanCursor>(
+      ptr_mock_request, motr_kvs_reader_factory, ptr_mock_s3_motr_api);
   action_under_test->object_multipart_metadata =
       object_mp_meta_factory->mock_object_mp_metadata;
 
@@ -513,8 +511,8 @@ TEST_F(S3GetMultipartPartActionTest, GetNextObjectsSuccessfulGetMoreObjects) {
       "2",
       std::make_pair(
           1, "{\"Bucket-Name\":\"seagate_bucket\",\"Object-Name\":\"2\"}")));
-  action_under_test->motr_kv_reader =
-      motr_kvs_reader_factory->mock_motr_kvs_reader;
+  action_under_test->motr_kv_cursor = std::make_shared<S3MotrKVSScanCursor>(
+      ptr_mock_request, motr_kvs_reader_factory, ptr_mock_s3_motr_api);
   action_under_test->object_multipart_metadata =
       object_mp_meta_factory->mock_object_mp_metadata;
 
@@ -534,8 +532,6 @@ TEST_F(S3GetMultipartPartActionTest, GetNextObjectsSuccessfulGetMoreObjects) {
   EXPECT_CALL(*(object_mp_meta_factory->mock_object_mp_metadata), get_state())
       .WillRepeatedly(Return(S3ObjectMetadataState::present));
 
-  action_under_test->motr_kv_reader =
-      motr_kvs_reader_factory->mock_motr_kvs_reader;
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               next_keyval(_, _, _, _, _, _)).Times(1);
 
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <event2/thread.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "s3_hash_thread_pool.h"
+#include "s3_option.h"
+
+class S3HashThreadPoolTest : public testing::Test {
+ protected:
+  S3HashThreadPoolTest() {
+    // Completions are posted to the loop from hash threads
+    evthread_use_pthreads();
+    evbase = event_base_new();
+    S3Option::get_instance()->set_eventbase(evbase);
+  }
+  ~S3HashThreadPoolTest() {
+    S3Option::get_instance()->set_eventbase(nullptr);
+    event_base_free(evbase);
+  }
+
+  // Runs the loop until 'count' completions are called or timeout
+  void run_loop_until(const unsigned &done, unsigned count) {
+    auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    struct timeval tick = {0, 1000};
+    while (done < count && std::chrono::steady_clock::now() < deadline) {
+      event_base_loopexit(evbase, &tick);
+      event_base_dispatch(evbase);
+    }
+  }
+
+  evbase_t *evbase;
+};
+
+TEST_F(S3HashThreadPoolTest, InstanceIsSet) {
+  EXPECT_TRUE(S3HashThreadPool::get_instance() == nullptr);
+  {
+    S3HashThreadPool pool(2);
+    EXPECT_EQ(&pool, S3HashThreadPool::get_instance());
+    EXPECT_EQ(2u, pool.get_thread_count());
+  }
+  EXPECT_TRUE(S3HashThreadPool::get_instance() == nullptr);
+}
+
+TEST_F(S3HashThreadPoolTest, QueueRunsTasksInOrder) {
+  S3HashThreadPool pool(4);
+  S3HashQueue queue(&pool);
+  std::vector<int> worked, completed;
+  unsigned done = 0;
+  const std::thread::id loop_thread = std::this_thread::get_id();
+  bool f_completed_on_loop = true;
+
+  for (int i = 0; i < 100; ++i) {
+    queue.submit([&worked, i]() { worked.push_back(i); },
+                 [&, i]() {
+      completed.push_back(i);
+      f_completed_on_loop &= std::this_thread::get_id() == loop_thread;
+      ++done;
+    });
+  }
+  run_loop_until(done, 100);
+
+  ASSERT_EQ(100u, done);
+  EXPECT_TRUE(f_completed_on_loop);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, worked[i]);
+    EXPECT_EQ(i, completed[i]);
+  }
+}
+
+TEST_F(S3HashThreadPoolTest, QueuesRunInParallel) {
+  S3HashThreadPool pool(2);
+  S3HashQueue queue1(&pool), queue2(&pool);
+  std::atomic<bool> f_started1{false}, f_started2{false};
+  unsigned done = 0;
+
+  // Each task waits for the other one, so they can't be run one by one
+  auto wait_for = [](std::atomic<bool> &started, std::atomic<bool> &other) {
+    started = true;
+    auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!other && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+  };
+  queue1.submit([&]() { wait_for(f_started1, f_started2); },
+                [&done]() { ++done; });
+  queue2.submit([&]() { wait_for(f_started2, f_started1); },
+                [&done]() { ++done; });
+  run_loop_until(done, 2);
+
+  EXPECT_EQ(2u, done);
+  EXPECT_TRUE(f_started1);
+  EXPECT_TRUE(f_started2);
+}
+
+TEST_F(S3HashThreadPoolTest, DestroyedQueueDropsCompletions) {
+  S3HashThreadPool pool(1);
+  std::atomic<unsigned> worked{0};
+  unsigned done = 0, other_done = 0;
+  {
+    S3HashQueue queue(&pool);
+    for (int i = 0; i < 10; ++i) {
+      queue.submit([&worked]() {
+                     std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                     ++worked;
+                   },
+                   [&done]() { ++done; });
+    }
+  }
+  unsigned worked_before_destroy = worked;
+
+  // Loop gets posted completions of the destroyed queue, if any
+  S3HashQueue other_queue(&pool);
+  other_queue.submit([]() {}, [&other_done]() { ++other_done; });
+  run_loop_until(other_done, 1);
+
+  EXPECT_EQ(1u, other_done);
+  EXPECT_EQ(0u, done);
+  EXPECT_EQ(worked_before_destroy, worked);
+  EXPECT_GT(10u, worked_before_destroy);
+}
+
+TEST_F(S3HashThreadPoolTest, DestroyedQueueCancelsRunningTask) {
+  S3HashThreadPool pool(1);
+  std::atomic<bool> f_started{false}, f_cancelled{false};
+
+  EXPECT_FALSE(S3HashQueue::is_current_task_cancelled());
+  {
+    S3HashQueue queue(&pool);
+    queue.submit([&]() {
+                   EXPECT_FALSE(S3HashQueue::is_current_task_cancelled());
+                   f_started = true;
+                   // Stands for a long digest checking for cancellation
+                   auto deadline = std::chrono::steady_clock::now() +
+                                   std::chrono::seconds(10);
+                   while (!S3HashQueue::is_current_task_cancelled() &&
+                          std::chrono::steady_clock::now() < deadline) {
+                     std::this_thread::yield();
+                   }
+                   f_cancelled = S3HashQueue::is_current_task_cancelled();
+                 },
+                 []() {});
+    while (!f_started) {
+      std::this_thread::yield();
+    }
+  }
+  EXPECT_TRUE(f_cancelled);
+}
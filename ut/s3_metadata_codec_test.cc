@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "mock_s3_request_object.h"
+#include "s3_metadata_codec.h"
+#include "s3_object_metadata.h"
+
+using ::testing::ReturnRef;
+
+TEST(S3MetadataCodecTest, EncodeDecode) {
+  const std::map<std::string, std::string> attrs = {
+      {"Content-Length", "1024"}, {"key", ""}, {std::string(300, 'k'), "v"}};
+
+  S3MetadataEncoder encoder(S3MetadataRecordType::object);
+  encoder.add(1, "name");
+  encoder.add_int(2, -5);
+  encoder.add_uint(3, 300);
+  encoder.add_map(4, attrs);
+  const std::string buffer = encoder.get_buffer();
+
+  EXPECT_TRUE(S3MetadataDecoder::is_binary(buffer));
+
+  S3MetadataDecoder decoder(buffer, S3MetadataRecordType::object);
+  S3MetadataField field;
+  unsigned tag;
+  int64_t int_value;
+  uint64_t uint_value;
+  std::map<std::string, std::string> map_value;
+
+  ASSERT_TRUE(decoder.next(tag, field));
+  EXPECT_EQ(1u, tag);
+  EXPECT_EQ("name", field.to_string());
+  ASSERT_TRUE(decoder.next(tag, field));
+  EXPECT_EQ(2u, tag);
+  EXPECT_TRUE(field.to_int(int_value));
+  EXPECT_EQ(-5, int_value);
+  ASSERT_TRUE(decoder.next(tag, field));
+  EXPECT_EQ(3u, tag);
+  EXPECT_TRUE(field.to_uint(uint_value));
+  EXPECT_EQ(300u, uint_value);
+  ASSERT_TRUE(decoder.next(tag, field));
+  EXPECT_EQ(4u, tag);
+  EXPECT_TRUE(field.to_map(map_value));
+  EXPECT_EQ(attrs, map_value);
+
+  EXPECT_FALSE(decoder.next(tag, field));
+  EXPECT_TRUE(decoder.is_valid());
+}
+
+TEST(S3MetadataCodecTest, JsonIsNotBinary) {
+  EXPECT_FALSE(S3MetadataDecoder::is_binary("{\"Bucket-Name\":\"bucket\"}"));
+  EXPECT_FALSE(S3MetadataDecoder::is_binary(""));
+}
+
+TEST(S3MetadataCodecTest, WrongRecordTypeIsRejected) {
+  S3MetadataEncoder encoder(S3MetadataRecordType::part);
+  encoder.add(1, "name");
+
+  S3MetadataDecoder decoder(encoder.get_buffer(),
+                            S3MetadataRecordType::bucket);
+  EXPECT_FALSE(decoder.is_valid());
+}
+
+TEST(S3MetadataCodecTest, TruncatedRecordIsRejected) {
+  S3MetadataEncoder encoder(S3MetadataRecordType::object);
+  encoder.add(1, "name");
+  std::string buffer = encoder.get_buffer();
+  buffer.resize(buffer.size() - 1);
+
+  S3MetadataDecoder decoder(buffer, S3MetadataRecordType::object);
+  S3MetadataField field;
+  unsigned tag;
+
+  EXPECT_FALSE(decoder.next(tag, field));
+  EXPECT_FALSE(decoder.is_valid());
+}
+
+// Compares encoding/decoding cost and size of object metadata in JSON and
+// binary formats. Disabled by default, run with
+//   s3ut --gtest_also_run_disabled_tests
+//   --gtest_filter='S3MetadataEncodingBenchmark.*'
+TEST(S3MetadataEncodingBenchmark, DISABLED_ObjectMetadataJsonVsBinary) {
+  const unsigned iterations = 100000;
+  std::string bucket_name = "seagatebucket";
+  std::string object_name = "dir1/dir2/objectname.jpg";
+
+  auto ptr_mock_request =
+      std::make_shared<MockS3RequestObject>(nullptr, new EvhtpWrapper());
+  EXPECT_CALL(*ptr_mock_request, get_bucket_name())
+      .WillRepeatedly(ReturnRef(bucket_name));
+  EXPECT_CALL(*ptr_mock_request, get_object_name())
+      .WillRepeatedly(ReturnRef(object_name));
+
+  S3ObjectMetadata metadata(ptr_mock_request);
+  metadata.set_oid({0x7ff8d0e3b1a24c1bULL, 0x9a5c44e0ffc31d02ULL});
+  metadata.set_layout_id(9);
+  metadata.set_content_length("4096");
+  metadata.set_md5("d41d8cd98f00b204e9800998ecf8427e");
+  metadata.set_content_type("image/jpeg");
+  metadata.add_user_defined_attribute("x-amz-meta-origin", "cdn-edge-17");
+  metadata.setacl(
+      "PD94bWwgdmVyc2lvbj0iMS4wIiBlbmNvZGluZz0iVVRGLTgiIHN0YW5kYWxvbmU9Im5v"
+      "Ij8+PEFjY2Vzc0NvbnRyb2xQb2xpY3k+PE93bmVyPjxJRD4xPC9JRD48L093bmVyPjwv"
+      "QWNjZXNzQ29udHJvbFBvbGljeT4=");
+
+  const std::string json = metadata.to_json();
+  const std::string binary = metadata.to_binary();
+  S3ObjectMetadata decoded(ptr_mock_request);
+
+  using Clock = std::chrono::steady_clock;
+  auto measure = [&](const std::function<void()> &op) {
+    const auto start = Clock::now();
+    for (unsigned i = 0; i < iterations; ++i) {
+      op();
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               Clock::now() - start).count() / iterations;
+  };
+  const auto json_encode_ns = measure([&] { metadata.to_json(); });
+  const auto binary_encode_ns = measure([&] { metadata.to_binary(); });
+  const auto json_decode_ns = measure([&] { decoded.from_json(json); });
+  const auto binary_decode_ns = measure([&] { decoded.from_json(binary); });
+
+  std::cout << "format  size(bytes)  encode(ns)  decode(ns)\n"
+            << "json    " << json.size() << "  " << json_encode_ns << "  "
+            << json_decode_ns << "\n"
+            << "binary  " << binary.size() << "  " << binary_encode_ns << "  "
+            << binary_decode_ns << "\n";
+
+  EXPECT_LT(binary.size(), json.size());
+}
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <functional>
+
+#include "s3_callback_test_helpers.h"
+#include "s3_motr_kvs_batcher.h"
+#include "s3_ut_common.h"
+
+#include "mock_s3_motr_kvs_writer.h"
+#include "mock_s3_motr_wrapper.h"
+#include "mock_s3_request_object.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+static void dummy_request_cb(evhtp_request_t *req, void *arg) {}
+
+// Index op of a batch, completed by the test
+struct FakeBatchOp {
+  struct s3_motr_idx_layout idx_lo;
+  bool is_delete = false;
+  std::vector<std::string> keys;
+  std::map<std::string, std::string> kv_list;
+  std::function<void(void)> on_success;
+  std::function<void(void)> on_failed;
+  int op_rc = 0;
+  std::vector<int> key_rcs;
+};
+
+class FakeS3MotrKVSBatcher : public S3MotrKVSBatcher {
+ public:
+  std::vector<std::shared_ptr<FakeBatchOp>> ops;
+
+  FakeS3MotrKVSBatcher(evbase_t *evbase, unsigned window_us,
+                       unsigned max_keys)
+      : S3MotrKVSBatcher(evbase, window_us, max_keys) {}
+
+ protected:
+  S3MotrKVSWriter *create_writer(std::shared_ptr<RequestObject> req,
+                                 std::shared_ptr<MotrAPI> motr_api) override {
+    auto writer = new NiceMock<MockS3MotrKVSWriter>(req, motr_api);
+    writer->disable_batching();
+    std::shared_ptr<FakeBatchOp> op = std::make_shared<FakeBatchOp>();
+    ops.push_back(op);
+    ON_CALL(*writer, put_keyval(_, _, _, _, _))
+        .WillByDefault(Invoke([op](
+            const struct s3_motr_idx_layout &idx_lo,
+            const std::map<std::string, std::string> &kv_list,
+            std::function<void(void)> on_success,
+            std::function<void(void)> on_failed,
+            S3MotrKVSWriter::CallbackType) {
+          op->idx_lo = idx_lo;
+          op->kv_list = kv_list;
+          for (const auto &kv : kv_list) {
+            op->keys.push_back(kv.first);
+          }
+          op->on_success = on_success;
+          op->on_failed = on_failed;
+        }));
+    ON_CALL(*writer, delete_keyval(_, _, _, _))
+        .WillByDefault(Invoke([op](const struct s3_motr_idx_layout &idx_lo,
+                                   const std::vector<std::string> &keys,
+                                   std::function<void(void)> on_success,
+                                   std::function<void(void)> on_failed) {
+          op->idx_lo = idx_lo;
+          op->is_delete = true;
+          op->keys = keys;
+          op->on_success = on_success;
+          op->on_failed = on_failed;
+        }));
+    ON_CALL(*writer, get_op_ret_code_for(_))
+        .WillByDefault(Invoke([op](int) { return op->op_rc; }));
+    ON_CALL(*writer, get_op_ret_code_for_del_kv(_))
+        .WillByDefault(Invoke([op](int i) {
+          return op->key_rcs.empty() ? 0 : op->key_rcs[i];
+        }));
+    return writer;
+  }
+};
+
+// Outcome seen by one caller of the batcher
+struct BatchedResult {
+  bool called = false;
+  bool success = false;
+  int op_rc = 0;
+  std::vector<int> key_rcs;
+
+  S3MotrKVSBatcher::DoneCallback callback() {
+    return [this](bool op_success, int rc, const std::vector<int> &rcs) {
+      called = true;
+      success = op_success;
+      op_rc = rc;
+      key_rcs = rcs;
+    };
+  }
+};
+
+class S3MotrKVSBatcherTest : public testing::Test {
+ protected:
+  S3MotrKVSBatcherTest() {
+    evbase = event_base_new();
+    req = evhtp_request_new(dummy_request_cb, evbase);
+    EvhtpWrapper *evhtp_obj_ptr = new EvhtpWrapper();
+    ptr_mock_request =
+        std::make_shared<MockS3RequestObject>(req, evhtp_obj_ptr);
+    ptr_mock_s3motr = std::make_shared<MockS3Motr>();
+    idx_lo1.oid = {0xffff, 0xfff1f};
+    idx_lo2.oid = {0xffff, 0xfff2f};
+  }
+
+  ~S3MotrKVSBatcherTest() { event_base_free(evbase); }
+
+  // Window timer and freeing of done batches run on the event loop
+  void run_loop() { event_base_loop(evbase, EVLOOP_NONBLOCK); }
+
+  evbase_t *evbase;
+  evhtp_request_t *req;
+  std::shared_ptr<MockS3RequestObject> ptr_mock_request;
+  std::shared_ptr<MockS3Motr> ptr_mock_s3motr;
+  struct s3_motr_idx_layout idx_lo1 = {};
+  struct s3_motr_idx_layout idx_lo2 = {};
+};
+
+TEST_F(S3MotrKVSBatcherTest, CoalescesPutsToSameIndex) {
+  FakeS3MotrKVSBatcher batcher(evbase, 1000000, 64);
+  BatchedResult result1, result2;
+
+  batcher.put_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1,
+                     {{"key1", "val1"}}, result1.callback());
+  batcher.put_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1,
+                     {{"key2", "val2"}, {"key3", "val3"}}, result2.callback());
+  EXPECT_EQ(1u, batcher.get_pending_batch_count());
+  EXPECT_TRUE(batcher.ops.empty());
+
+  batcher.flush();
+  ASSERT_EQ(1u, batcher.ops.size());
+  EXPECT_EQ(0u, batcher.get_pending_batch_count());
+  EXPECT_EQ(1u, batcher.get_in_flight_batch_count());
+  EXPECT_FALSE(batcher.ops[0]->is_delete);
+  EXPECT_EQ(3u, batcher.ops[0]->kv_list.size());
+  EXPECT_EQ("val2", batcher.ops[0]->kv_list["key2"]);
+
+  batcher.ops[0]->on_success();
+  EXPECT_TRUE(result1.called);
+  EXPECT_TRUE(result1.success);
+  EXPECT_EQ(1u, result1.key_rcs.size());
+  EXPECT_TRUE(result2.called);
+  EXPECT_TRUE(result2.success);
+  EXPECT_EQ(2u, result2.key_rcs.size());
+  EXPECT_EQ(0u, batcher.get_in_flight_batch_count());
+  run_loop();
+}
+
+TEST_F(S3MotrKVSBatcherTest, KeepsIndicesApart) {
+  FakeS3MotrKVSBatcher batcher(evbase, 1000000, 64);
+  BatchedResult result1, result2;
+
+  batcher.put_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1,
+                     {{"key1", "val1"}}, result1.callback());
+  batcher.put_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo2,
+                     {{"key1", "val1"}}, result2.callback());
+  EXPECT_EQ(2u, batcher.get_pending_batch_count());
+
+  batcher.flush();
+  ASSERT_EQ(2u, batcher.ops.size());
+  batcher.ops[0]->on_success();
+  batcher.ops[1]->on_success();
+  EXPECT_TRUE(result1.success);
+  EXPECT_TRUE(result2.success);
+  run_loop();
+}
+
+TEST_F(S3MotrKVSBatcherTest, LaunchesFullBatch) {
+  FakeS3MotrKVSBatcher batcher(evbase, 1000000, 3);
+  BatchedResult result1, result2;
+
+  batcher.put_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1,
+                     {{"key1", "val1"}, {"key2", "val2"}}, result1.callback());
+  EXPECT_TRUE(batcher.ops.empty());
+  batcher.put_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1,
+                     {{"key3", "val3"}}, result2.callback());
+  ASSERT_EQ(1u, batcher.ops.size());
+  EXPECT_EQ(3u, batcher.ops[0]->kv_list.size());
+  EXPECT_EQ(0u, batcher.get_pending_batch_count());
+  batcher.ops[0]->on_success();
+  run_loop();
+}
+
+TEST_F(S3MotrKVSBatcherTest, LaunchesWhenWindowExpires) {
+  FakeS3MotrKVSBatcher batcher(evbase, 1, 64);
+  BatchedResult result;
+
+  batcher.put_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1,
+                     {{"key1", "val1"}}, result.callback());
+  EXPECT_TRUE(batcher.ops.empty());
+  event_base_loop(evbase, EVLOOP_ONCE);
+  ASSERT_EQ(1u, batcher.ops.size());
+  batcher.ops[0]->on_success();
+  EXPECT_TRUE(result.success);
+  run_loop();
+}
+
+TEST_F(S3MotrKVSBatcherTest, SameKeyStartsNewBatch) {
+  FakeS3MotrKVSBatcher batcher(evbase, 1000000, 64);
+  BatchedResult result1, result2;
+
+  batcher.put_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1,
+                     {{"key1", "val1"}}, result1.callback());
+  batcher.put_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1,
+                     {{"key1", "val2"}}, result2.callback());
+  ASSERT_EQ(1u, batcher.ops.size());
+  EXPECT_EQ("val1", batcher.ops[0]->kv_list["key1"]);
+  EXPECT_EQ(1u, batcher.get_pending_batch_count());
+
+  batcher.flush();
+  ASSERT_EQ(2u, batcher.ops.size());
+  EXPECT_EQ("val2", batcher.ops[1]->kv_list["key1"]);
+  batcher.ops[0]->on_success();
+  batcher.ops[1]->on_success();
+  run_loop();
+}
+
+TEST_F(S3MotrKVSBatcherTest, DeleteLaunchesPendingPutOfIndex) {
+  FakeS3MotrKVSBatcher batcher(evbase, 1000000, 64);
+  BatchedResult result1, result2;
+
+  batcher.put_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1,
+                     {{"key1", "val1"}}, result1.callback());
+  batcher.delete_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1, {"key1"},
+                        result2.callback());
+  ASSERT_EQ(1u, batcher.ops.size());
+  EXPECT_FALSE(batcher.ops[0]->is_delete);
+
+  batcher.flush();
+  ASSERT_EQ(2u, batcher.ops.size());
+  EXPECT_TRUE(batcher.ops[1]->is_delete);
+  batcher.ops[0]->on_success();
+  batcher.ops[1]->on_success();
+  EXPECT_TRUE(result1.success);
+  EXPECT_TRUE(result2.success);
+  run_loop();
+}
+
+TEST_F(S3MotrKVSBatcherTest, DeleteReturnsCodesOfCallerKeys) {
+  FakeS3MotrKVSBatcher batcher(evbase, 1000000, 64);
+  BatchedResult result1, result2;
+
+  batcher.delete_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1,
+                        {"key3", "key1"}, result1.callback());
+  batcher.delete_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1, {"key2"},
+                        result2.callback());
+  batcher.flush();
+  ASSERT_EQ(1u, batcher.ops.size());
+  std::vector<std::string> keys = {"key1", "key2", "key3"};
+  EXPECT_EQ(keys, batcher.ops[0]->keys);
+
+  // key2 is missing, the rest is deleted
+  batcher.ops[0]->op_rc = -ENOENT;
+  batcher.ops[0]->key_rcs = {0, -ENOENT, 0};
+  batcher.ops[0]->on_failed();
+
+  EXPECT_TRUE(result1.called);
+  EXPECT_TRUE(result1.success);
+  std::vector<int> rcs1 = {0, 0};
+  EXPECT_EQ(rcs1, result1.key_rcs);
+  EXPECT_TRUE(result2.called);
+  EXPECT_FALSE(result2.success);
+  EXPECT_EQ(-ENOENT, result2.op_rc);
+  std::vector<int> rcs2 = {-ENOENT};
+  EXPECT_EQ(rcs2, result2.key_rcs);
+  run_loop();
+}
+
+TEST_F(S3MotrKVSBatcherTest, OpFailureFailsAllCallers) {
+  FakeS3MotrKVSBatcher batcher(evbase, 1000000, 64);
+  BatchedResult result1, result2;
+
+  batcher.put_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1,
+                     {{"key1", "val1"}}, result1.callback());
+  batcher.put_keyval(ptr_mock_request, ptr_mock_s3motr, idx_lo1,
+                     {{"key2", "val2"}}, result2.callback());
+  batcher.flush();
+  ASSERT_EQ(1u, batcher.ops.size());
+  batcher.ops[0]->op_rc = -ETIMEDOUT;
+  batcher.ops[0]->on_failed();
+
+  EXPECT_FALSE(result1.success);
+  EXPECT_EQ(-ETIMEDOUT, result1.op_rc);
+  EXPECT_FALSE(result2.success);
+  EXPECT_EQ(-ETIMEDOUT, result2.op_rc);
+  run_loop();
+}
+
+TEST_F(S3MotrKVSBatcherTest, WriterPutGoesThroughBatcher) {
+  FakeS3MotrKVSBatcher batcher(evbase, 1000000, 64);
+  S3CallBack callback1, callback2;
+  S3MotrKVSWriter writer1(ptr_mock_request, ptr_mock_s3motr);
+  S3MotrKVSWriter writer2(ptr_mock_request, ptr_mock_s3motr);
+
+  writer1.put_keyval(idx_lo1, "key1", "val1",
+                     std::bind(&S3CallBack::on_success, &callback1),
+                     std::bind(&S3CallBack::on_failed, &callback1));
+  writer2.put_keyval(idx_lo1, "key2", "val2",
+                     std::bind(&S3CallBack::on_success, &callback2),
+                     std::bind(&S3CallBack::on_failed, &callback2));
+  EXPECT_EQ(1u, batcher.get_pending_batch_count());
+
+  batcher.flush();
+  ASSERT_EQ(1u, batcher.ops.size());
+  batcher.ops[0]->on_success();
+  EXPECT_TRUE(callback1.success_called);
+  EXPECT_TRUE(callback2.success_called);
+  EXPECT_EQ(S3MotrKVSWriterOpState::created, writer1.get_state());
+  EXPECT_EQ(S3MotrKVSWriterOpState::created, writer2.get_state());
+  run_loop();
+}
+
+TEST_F(S3MotrKVSBatcherTest, WriterDeleteReportsMissingKey) {
+  FakeS3MotrKVSBatcher batcher(evbase, 1000000, 64);
+  S3CallBack callback1, callback2;
+  S3MotrKVSWriter writer1(ptr_mock_request, ptr_mock_s3motr);
+  S3MotrKVSWriter writer2(ptr_mock_request, ptr_mock_s3motr);
+
+  writer1.delete_keyval(idx_lo1, {"key1"},
+                        std::bind(&S3CallBack::on_success, &callback1),
+                        std::bind(&S3CallBack::on_failed, &callback1));
+  writer2.delete_keyval(idx_lo1, {"key2"},
+                        std::bind(&S3CallBack::on_success, &callback2),
+                        std::bind(&S3CallBack::on_failed, &callback2));
+  batcher.flush();
+  ASSERT_EQ(1u, batcher.ops.size());
+  batcher.ops[0]->op_rc = -ENOENT;
+  batcher.ops[0]->key_rcs = {0, -ENOENT};
+  batcher.ops[0]->on_failed();
+
+  EXPECT_TRUE(callback1.success_called);
+  EXPECT_EQ(S3MotrKVSWriterOpState::deleted, writer1.get_state());
+  EXPECT_TRUE(callback2.fail_called);
+  EXPECT_EQ(S3MotrKVSWriterOpState::missing, writer2.get_state());
+  EXPECT_EQ(-ENOENT, writer2.get_op_ret_code_for_del_kv(0));
+  run_loop();
+}
+
+TEST_F(S3MotrKVSBatcherTest, WriterWithoutBatcherIsUnchanged) {
+  EXPECT_TRUE(S3MotrKVSBatcher::get_instance() == nullptr);
+  {
+    FakeS3MotrKVSBatcher batcher(evbase, 1000000, 64);
+    EXPECT_EQ(&batcher, S3MotrKVSBatcher::get_instance());
+  }
+  EXPECT_TRUE(S3MotrKVSBatcher::get_instance() == nullptr);
+}
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <functional>
+
+#include "s3_factory.h"
+#include "s3_motr_kvs_scan_cursor.h"
+#include "s3_option.h"
+#include "s3_ut_common.h"
+
+#include "mock_s3_motr_kvs_reader.h"
+#include "mock_s3_motr_wrapper.h"
+#include "mock_s3_request_object.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::ReturnRef;
+
+typedef std::map<std::string, std::pair<int, std::string>> KeyValues;
+
+// next_keyval() of a reader, completed by the test
+struct FakeNextKeyval {
+  std::string key;
+  size_t nr_kvp = 0;
+  unsigned int flag = 0;
+  std::function<void(void)> on_success;
+  std::function<void(void)> on_failed;
+};
+
+// Reader whose results and state are set by the test
+struct FakeReader {
+  std::shared_ptr<NiceMock<MockS3MotrKVSReader>> reader;
+  std::vector<FakeNextKeyval> ops;
+  KeyValues key_values;
+  S3MotrKVSReaderOpState state = S3MotrKVSReaderOpState::start;
+
+  void complete(const KeyValues &kvps) {
+    key_values = kvps;
+    state = S3MotrKVSReaderOpState::present;
+    auto on_success = ops.back().on_success;
+    on_success();
+  }
+
+  void fail(S3MotrKVSReaderOpState op_state) {
+    key_values.clear();
+    state = op_state;
+    auto on_failed = ops.back().on_failed;
+    on_failed();
+  }
+};
+
+class FakeS3MotrKVSReaderFactory : public S3MotrKVSReaderFactory {
+ public:
+  std::vector<std::shared_ptr<FakeReader>> readers;
+
+  std::shared_ptr<S3MotrKVSReader> create_motr_kvs_reader(
+      std::shared_ptr<RequestObject> req,
+      std::shared_ptr<MotrAPI> s3_motr_api = nullptr) override {
+    auto fake = std::make_shared<FakeReader>();
+    fake->reader =
+        std::make_shared<NiceMock<MockS3MotrKVSReader>>(req, s3_motr_api);
+    FakeReader *fake_ptr = fake.get();
+    ON_CALL(*fake->reader, next_keyval(_, _, _, _, _, _))
+        .WillByDefault(Invoke([fake_ptr](
+            const struct s3_motr_idx_layout &idx_lo, const std::string &key,
+            size_t nr_kvp, std::function<void(void)> on_success,
+            std::function<void(void)> on_failed, unsigned int flag) {
+          FakeNextKeyval op;
+          op.key = key;
+          op.nr_kvp = nr_kvp;
+          op.flag = flag;
+          op.on_success = on_success;
+          op.on_failed = on_failed;
+          fake_ptr->ops.push_back(op);
+        }));
+    ON_CALL(*fake->reader, get_key_values())
+        .WillByDefault(ReturnRef(fake->key_values));
+    ON_CALL(*fake->reader, get_state()).WillByDefault(Invoke([fake_ptr]() {
+      return fake_ptr->state;
+    }));
+    readers.push_back(fake);
+    return fake->reader;
+  }
+};
+
+// Pages seen by the owner of the cursor
+struct PageResult {
+  int success_count = 0;
+  int failed_count = 0;
+  KeyValues last_page;
+
+  std::function<void(void)> on_success(
+      std::shared_ptr<S3MotrKVSScanCursor> &cursor) {
+    return [this, &cursor]() {
+      success_count++;
+      last_page = cursor->get_key_values();
+    };
+  }
+  std::function<void(void)> on_failed() {
+    return [this]() { failed_count++; };
+  }
+};
+
+static KeyValues make_page(std::initializer_list<std::string> keys) {
+  KeyValues kvps;
+  for (const auto &key : keys) {
+    kvps[key] = std::make_pair(0, "{}");
+  }
+  return kvps;
+}
+
+class S3MotrKVSScanCursorTest : public testing::Test {
+ protected:
+  S3MotrKVSScanCursorTest() {
+    evhtp_request_t *req = NULL;
+    EvhtpInterface *evhtp_obj_ptr = new EvhtpWrapper();
+    ptr_mock_request =
+        std::make_shared<MockS3RequestObject>(req, evhtp_obj_ptr);
+    ptr_mock_s3_motr_api = std::make_shared<MockS3Motr>();
+    reader_factory = std::make_shared<FakeS3MotrKVSReaderFactory>();
+    idx_lo.oid = {0xffff, 0xfff1f};
+
+    old_prefetch_max_keys =
+        S3Option::get_instance()->get_motr_kvs_prefetch_max_keys();
+    S3Option::get_instance()->set_motr_kvs_prefetch_max_keys(1000);
+  }
+
+  ~S3MotrKVSScanCursorTest() {
+    S3Option::get_instance()->set_motr_kvs_prefetch_max_keys(
+        old_prefetch_max_keys);
+  }
+
+  void create_cursor() {
+    cursor = std::make_shared<S3MotrKVSScanCursor>(
+        ptr_mock_request, reader_factory, ptr_mock_s3_motr_api);
+  }
+
+  void next_page(const std::string &key, size_t nr_kvp) {
+    cursor->next_keyval(idx_lo, key, nr_kvp, result.on_success(cursor),
+                        result.on_failed());
+  }
+
+  FakeReader &reader(size_t i) { return *reader_factory->readers.at(i); }
+
+  std::shared_ptr<MockS3RequestObject> ptr_mock_request;
+  std::shared_ptr<MockS3Motr> ptr_mock_s3_motr_api;
+  std::shared_ptr<FakeS3MotrKVSReaderFactory> reader_factory;
+  std::shared_ptr<S3MotrKVSScanCursor> cursor;
+  struct s3_motr_idx_layout idx_lo = {};
+  PageResult result;
+  unsigned old_prefetch_max_keys;
+};
+
+TEST_F(S3MotrKVSScanCursorTest, PrefetchesNextPage) {
+  create_cursor();
+  next_page("", 2);
+  ASSERT_EQ(1, reader(0).ops.size());
+  EXPECT_EQ("", reader(0).ops[0].key);
+
+  reader(0).complete(make_page({"a", "b"}));
+  EXPECT_EQ(1, result.success_count);
+  EXPECT_EQ(make_page({"a", "b"}), result.last_page);
+  // Next page is on its way before the caller asked for it
+  ASSERT_EQ(2, reader_factory->readers.size());
+  ASSERT_EQ(1, reader(1).ops.size());
+  EXPECT_EQ("b", reader(1).ops[0].key);
+  EXPECT_EQ(2, reader(1).ops[0].nr_kvp);
+  EXPECT_EQ(M0_OIF_EXCLUDE_START_KEY, reader(1).ops[0].flag);
+
+  reader(1).complete(make_page({"c", "d"}));
+  EXPECT_EQ(1, result.success_count);
+
+  next_page("b", 2);
+  EXPECT_EQ(2, result.success_count);
+  EXPECT_EQ(make_page({"c", "d"}), result.last_page);
+  EXPECT_EQ(make_page({"c", "d"}), cursor->get_key_values());
+  // Reader of the first page fetches the one after
+  EXPECT_EQ(1, reader(1).ops.size());
+  ASSERT_EQ(2, reader(0).ops.size());
+  EXPECT_EQ("d", reader(0).ops[1].key);
+}
+
+TEST_F(S3MotrKVSScanCursorTest, WaitsForPageInFlight) {
+  create_cursor();
+  next_page("", 2);
+  reader(0).complete(make_page({"a", "b"}));
+
+  next_page("b", 2);
+  EXPECT_EQ(1, result.success_count);
+  EXPECT_EQ(1, reader(0).ops.size());
+  EXPECT_EQ(1, reader(1).ops.size());
+
+  reader(1).complete(make_page({"c"}));
+  EXPECT_EQ(2, result.success_count);
+  EXPECT_EQ(make_page({"c"}), result.last_page);
+  EXPECT_EQ(S3MotrKVSReaderOpState::present, cursor->get_state());
+  // Short page ends the scan, nothing more is fetched
+  EXPECT_EQ(1, reader(0).ops.size());
+}
+
+TEST_F(S3MotrKVSScanCursorTest, DropsPrefetchOnSeek) {
+  create_cursor();
+  next_page("", 2);
+  reader(0).complete(make_page({"a/1", "a/2"}));
+
+  next_page("a/\xff", 2);
+  ASSERT_EQ(2, reader(0).ops.size());
+  EXPECT_EQ("a/\xff", reader(0).ops[1].key);
+
+  // Page fetched ahead is no one's any more
+  reader(1).complete(make_page({"a/3", "a/4"}));
+  EXPECT_EQ(1, result.success_count);
+
+  reader(0).complete(make_page({"b"}));
+  EXPECT_EQ(2, result.success_count);
+  EXPECT_EQ(make_page({"b"}), result.last_page);
+}
+
+TEST_F(S3MotrKVSScanCursorTest, NoPrefetchAfterShortPage) {
+  create_cursor();
+  next_page("", 2);
+  reader(0).complete(make_page({"a"}));
+  EXPECT_EQ(1, result.success_count);
+  EXPECT_EQ(1, reader_factory->readers.size());
+}
+
+TEST_F(S3MotrKVSScanCursorTest, NoPrefetchAbovePageCap) {
+  S3Option::get_instance()->set_motr_kvs_prefetch_max_keys(1);
+  create_cursor();
+  next_page("", 2);
+  reader(0).complete(make_page({"a", "b"}));
+  EXPECT_EQ(1, result.success_count);
+  EXPECT_EQ(1, reader_factory->readers.size());
+
+  next_page("b", 2);
+  EXPECT_EQ(2, reader(0).ops.size());
+}
+
+TEST_F(S3MotrKVSScanCursorTest, NoPrefetchPastKeyBudget) {
+  create_cursor();
+  // The caller stops after three keys
+  cursor->set_key_budget(3);
+  next_page("", 2);
+  reader(0).complete(make_page({"a", "b"}));
+  EXPECT_EQ(1, result.success_count);
+  ASSERT_EQ(2, reader_factory->readers.size());
+  EXPECT_EQ(1, reader(1).ops.size());
+
+  reader(1).complete(make_page({"c", "d"}));
+  cursor->set_key_budget(1);
+  next_page("b", 2);
+  EXPECT_EQ(2, result.success_count);
+  EXPECT_EQ(make_page({"c", "d"}), result.last_page);
+  // The page handed out covers what is left of the budget
+  EXPECT_EQ(1, reader(0).ops.size());
+  EXPECT_EQ(1, reader(1).ops.size());
+}
+
+TEST_F(S3MotrKVSScanCursorTest, PrefetchMissingIsDelivered) {
+  create_cursor();
+  next_page("", 2);
+  reader(0).complete(make_page({"a", "b"}));
+  reader(1).fail(S3MotrKVSReaderOpState::missing);
+
+  next_page("b", 2);
+  EXPECT_EQ(1, result.failed_count);
+  EXPECT_EQ(S3MotrKVSReaderOpState::missing, cursor->get_state());
+  EXPECT_EQ(1, reader(0).ops.size());
+}
+
+TEST_F(S3MotrKVSScanCursorTest, PrefetchFailureFetchesAgain) {
+  create_cursor();
+  next_page("", 2);
+  reader(0).complete(make_page({"a", "b"}));
+  next_page("b", 2);
+
+  reader(1).fail(S3MotrKVSReaderOpState::failed);
+  EXPECT_EQ(0, result.failed_count);
+  ASSERT_EQ(2, reader(0).ops.size());
+  EXPECT_EQ("b", reader(0).ops[1].key);
+
+  reader(0).complete(make_page({"c"}));
+  EXPECT_EQ(2, result.success_count);
+  EXPECT_EQ(make_page({"c"}), result.last_page);
+}
+
+TEST_F(S3MotrKVSScanCursorTest, DestroyWithPrefetchInFlight) {
+  create_cursor();
+  next_page("", 2);
+  reader(0).complete(make_page({"a", "b"}));
+  cursor.reset();
+
+  reader(1).complete(make_page({"c", "d"}));
+  EXPECT_EQ(1, result.success_count);
+  EXPECT_EQ(0, result.failed_count);
+}
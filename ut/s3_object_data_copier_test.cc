@@ -24,15 +24,19 @@
 
 #include "mock_s3_factory.h"
 #include "mock_s3_probable_delete_record.h"
+#include "s3_mem_pool_manager.h"
+#include "s3_motr_rw_common.h"
 #include "s3_object_data_copier.h"
 #include "s3_m0_uint128_helper.h"
 #include "s3_ut_common.h"
 #include "s3_test_utils.h"
 
 using ::testing::AtLeast;
+using ::testing::DoAll;
 using ::testing::Eq;
 using ::testing::Invoke;
 using ::testing::ReturnRef;
+using ::testing::SaveArg;
 
 class S3ObjectDataCopierTest : public testing::Test {
  protected:
@@ -57,6 +61,10 @@ class S3ObjectDataCopierTest : public testing::Test {
  public:
   void on_success_cb();
   void on_failed_cb();
+  // Marks slot as reading chunk
+  void set_read_in_progress(size_t slot_index, size_t chunk_index);
+  // Puts a read chunk in line for writing
+  void add_chunk_read(size_t chunk_index);
 };
 
 void S3ObjectDataCopierTest::on_success_cb() { f_success = true; }
@@ -67,6 +75,31 @@ bool fn_false_cb() { return false; }
 
 bool fn_true_cb() { return true; }
 
+static int s3_test_motr_obj_op(struct m0_obj *obj, enum m0_obj_opcode opcode,
+                               struct m0_indexvec *ext, struct m0_bufvec *data,
+                               struct m0_bufvec *attr, uint64_t mask,
+                               uint32_t flags, struct m0_op **op) {
+  *op = (struct m0_op *)calloc(1, sizeof(struct m0_op));
+  return 0;
+}
+
+// Completes the read at once
+static void s3_test_motr_op_launch(uint64_t, struct m0_op **op, uint32_t nr,
+                                   MotrOpType type) {
+  struct s3_motr_context_obj *ctx =
+      (struct s3_motr_context_obj *)op[0]->op_datum;
+
+  S3MotrReaderContext *app_ctx =
+      (S3MotrReaderContext *)ctx->application_context;
+  struct s3_motr_op_context *op_ctx = app_ctx->get_motr_op_ctx();
+  for (int i = 0; i < (int)nr; i++) {
+    struct m0_op *test_motr_op = op[i];
+    s3_motr_op_stable(test_motr_op);
+    free(test_motr_op);
+  }
+  op_ctx->op_count = 0;
+}
+
 S3ObjectDataCopierTest::S3ObjectDataCopierTest()
     : ptr_mock_s3_motr_api(std::make_shared<MockS3Motr>()),
       f_success(false),
@@ -93,8 +126,6 @@ void S3ObjectDataCopierTest::SetUp() {
       ptr_mock_request, ptr_mock_motr_writer_factory->mock_motr_writer,
       ptr_mock_motr_reader_factory, ptr_mock_s3_motr_api));
 
-  entity_under_test->motr_reader =
-      ptr_mock_motr_reader_factory->mock_motr_reader;
   entity_under_test->on_success =
       std::bind(&S3ObjectDataCopierTest::on_success_cb, this);
   entity_under_test->on_failure =
@@ -103,25 +134,59 @@ void S3ObjectDataCopierTest::SetUp() {
       S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(1);
   entity_under_test->check_shutdown_and_rollback = &fn_false_cb;
 
-  entity_under_test->bytes_left_to_read = 1024;
+  // One chunk copied with one reader
+  entity_under_test->object_size = 1024;
+  entity_under_test->chunk_size = entity_under_test->motr_unit_size;
+  entity_under_test->chunks_total = 1;
+  entity_under_test->next_chunk_to_read = 0;
+  entity_under_test->next_chunk_to_write = 0;
+  entity_under_test->reads_in_progress = 0;
+  entity_under_test->pipeline_depth = 1;
+  entity_under_test->read_slots.resize(1);
+  entity_under_test->read_slots[0].motr_reader =
+      ptr_mock_motr_reader_factory->mock_motr_reader;
   entity_under_test->copy_failed = false;
-  entity_under_test->read_in_progress = false;
   entity_under_test->write_in_progress = false;
 
   f_success = false;
   f_failed = false;
 }
 
+void S3ObjectDataCopierTest::set_read_in_progress(size_t slot_index,
+                                                  size_t chunk_index) {
+  if (entity_under_test->read_slots.size() <= slot_index) {
+    entity_under_test->read_slots.resize(slot_index + 1);
+  }
+  auto &slot = entity_under_test->read_slots[slot_index];
+  slot.motr_reader = ptr_mock_motr_reader_factory->mock_motr_reader;
+  slot.chunk_index = chunk_index;
+  slot.read_in_progress = true;
+  ++entity_under_test->reads_in_progress;
+  if (entity_under_test->next_chunk_to_read <= chunk_index) {
+    entity_under_test->next_chunk_to_read = chunk_index + 1;
+  }
+}
+
+void S3ObjectDataCopierTest::add_chunk_read(size_t chunk_index) {
+  auto &chunk = entity_under_test->chunks_read[chunk_index];
+  chunk.data_blocks.emplace_back(nullptr, 0);
+  chunk.p_evbuffer = evbuffer_new();
+}
+
 TEST_F(S3ObjectDataCopierTest, ReadDataBlockStarted) {
 
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              set_last_index(0)).Times(1);
   EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
               read_object_data(_, _, _))
       .Times(1)
       .WillOnce(Return(true));
 
-  entity_under_test->read_data_block();
+  entity_under_test->read_data_block(0);
 
-  EXPECT_TRUE(entity_under_test->read_in_progress);
+  EXPECT_TRUE(entity_under_test->read_slots[0].read_in_progress);
+  EXPECT_EQ(1, entity_under_test->reads_in_progress);
+  EXPECT_EQ(1, entity_under_test->next_chunk_to_read);
 }
 
 TEST_F(S3ObjectDataCopierTest, ReadDataBlockFailedToStart) {
@@ -135,37 +200,40 @@ TEST_F(S3ObjectDataCopierTest, ReadDataBlockFailedToStart) {
       .Times(1)
       .WillOnce(Return(S3MotrReaderOpState::failed_to_launch));
 
-  entity_under_test->read_data_block();
+  entity_under_test->read_data_block(0);
 
-  EXPECT_FALSE(entity_under_test->read_in_progress);
+  EXPECT_FALSE(entity_under_test->read_slots[0].read_in_progress);
+  EXPECT_EQ(0, entity_under_test->reads_in_progress);
   EXPECT_TRUE(entity_under_test->copy_failed);
   EXPECT_FALSE(entity_under_test->get_s3_error().empty());
 }
 
 TEST_F(S3ObjectDataCopierTest, ReadDataBlockSuccessWhileShuttingDown) {
 
-  entity_under_test->read_in_progress = true;
+  set_read_in_progress(0, 0);
   entity_under_test->check_shutdown_and_rollback = &fn_true_cb;
 
-  entity_under_test->read_data_block_success();
+  entity_under_test->read_data_block_success(0);
 
-  EXPECT_FALSE(entity_under_test->read_in_progress);
+  EXPECT_FALSE(entity_under_test->read_slots[0].read_in_progress);
+  EXPECT_FALSE(f_success);
+  EXPECT_FALSE(f_failed);
 }
 
 TEST_F(S3ObjectDataCopierTest, ReadDataBlockSuccessCopyFailed) {
 
-  entity_under_test->read_in_progress = true;
+  set_read_in_progress(0, 0);
   entity_under_test->copy_failed = true;
   entity_under_test->set_s3_error("InternalError");
 
-  entity_under_test->read_data_block_success();
+  entity_under_test->read_data_block_success(0);
 
-  EXPECT_FALSE(entity_under_test->read_in_progress);
+  EXPECT_FALSE(entity_under_test->read_slots[0].read_in_progress);
   EXPECT_TRUE(f_failed);
 }
 
 TEST_F(S3ObjectDataCopierTest, ReadDataBlockSuccessShouldStartWrite) {
-  entity_under_test->read_in_progress = true;
+  set_read_in_progress(0, 0);
 
   S3BufferSequence data_blocks_read;
   data_blocks_read.emplace_back(nullptr, entity_under_test->size_of_ev_buffer);
@@ -185,21 +253,23 @@ TEST_F(S3ObjectDataCopierTest, ReadDataBlockSuccessShouldStartWrite) {
       .Times(1)
       .WillOnce(Return(p_evbuffer));
 
-  entity_under_test->read_data_block_success();
+  entity_under_test->read_data_block_success(0);
 
   EXPECT_TRUE(entity_under_test->write_in_progress);
+  EXPECT_TRUE(entity_under_test->chunks_read.empty());
+  EXPECT_EQ(1, entity_under_test->next_chunk_to_write);
 }
 
 TEST_F(S3ObjectDataCopierTest, ReadDataBlockFailed) {
 
-  entity_under_test->read_in_progress = true;
+  set_read_in_progress(0, 0);
 
   EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader, get_state())
       .Times(1);
 
-  entity_under_test->read_data_block_failed();
+  entity_under_test->read_data_block_failed(0);
 
-  EXPECT_FALSE(entity_under_test->read_in_progress);
+  EXPECT_FALSE(entity_under_test->read_slots[0].read_in_progress);
   EXPECT_TRUE(entity_under_test->copy_failed);
   EXPECT_FALSE(entity_under_test->get_s3_error().empty());
   EXPECT_TRUE(f_failed);
@@ -214,8 +284,7 @@ TEST_F(S3ObjectDataCopierTest, SetS3CopyFailed) {
 
 TEST_F(S3ObjectDataCopierTest, WriteObjectStarted) {
 
-  entity_under_test->data_blocks_read.emplace_back(nullptr, 0);
-  entity_under_test->p_evbuffer_read = evbuffer_new();
+  add_chunk_read(0);
 
   EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
               write_content(_, _, _, _)).Times(1);
@@ -226,7 +295,7 @@ TEST_F(S3ObjectDataCopierTest, WriteObjectStarted) {
   entity_under_test->write_data_block();
 
   EXPECT_TRUE(entity_under_test->write_in_progress);
-  EXPECT_TRUE(entity_under_test->data_blocks_read.empty());
+  EXPECT_TRUE(entity_under_test->chunks_read.empty());
 }
 
 TEST_F(S3ObjectDataCopierTest, WriteObjectFailedShouldUndoMarkProgress) {
@@ -272,9 +341,12 @@ TEST_F(S3ObjectDataCopierTest, WriteObjectSuccessfulWhileShuttingDown) {
 
 TEST_F(S3ObjectDataCopierTest, WriteObjectSuccessfulShouldRestartWritingData) {
 
+  // Chunk 0 is being written, chunk 1 has been read
+  entity_under_test->chunks_total = 2;
+  entity_under_test->next_chunk_to_read = 2;
+  entity_under_test->next_chunk_to_write = 1;
   entity_under_test->write_in_progress = true;
-  entity_under_test->data_blocks_read.emplace_back(nullptr, 0);
-  entity_under_test->p_evbuffer_read = evbuffer_new();
+  add_chunk_read(1);
   entity_under_test->p_evbuffer_write = evbuffer_new();
 
   EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
@@ -286,13 +358,15 @@ TEST_F(S3ObjectDataCopierTest, WriteObjectSuccessfulShouldRestartWritingData) {
   entity_under_test->write_data_block_success();
 
   EXPECT_TRUE(entity_under_test->write_in_progress);
+  EXPECT_EQ(2, entity_under_test->next_chunk_to_write);
 }
 
 TEST_F(S3ObjectDataCopierTest,
        WriteObjectSuccessfulDoNextStepWhenAllIsWritten) {
 
   entity_under_test->write_in_progress = true;
-  entity_under_test->bytes_left_to_read = 0;
+  entity_under_test->next_chunk_to_read = 1;
+  entity_under_test->next_chunk_to_write = 1;
   entity_under_test->p_evbuffer_write = evbuffer_new();
 
   entity_under_test->write_data_block_success();
@@ -300,3 +374,146 @@ TEST_F(S3ObjectDataCopierTest,
   EXPECT_FALSE(entity_under_test->write_in_progress);
   EXPECT_TRUE(f_success);
 }
+
+TEST_F(S3ObjectDataCopierTest, ReadsAheadUpToPipelineDepth) {
+
+  entity_under_test->chunks_total = 5;
+  entity_under_test->object_size = 5 * entity_under_test->chunk_size;
+  entity_under_test->pipeline_depth = 3;
+  entity_under_test->read_slots.resize(3);
+  for (auto &slot : entity_under_test->read_slots) {
+    slot.motr_reader = ptr_mock_motr_reader_factory->mock_motr_reader;
+  }
+
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              read_object_data(_, _, _))
+      .Times(3)
+      .WillRepeatedly(Return(true));
+
+  entity_under_test->pump();
+
+  EXPECT_EQ(3, entity_under_test->reads_in_progress);
+  EXPECT_EQ(3, entity_under_test->next_chunk_to_read);
+  EXPECT_EQ(2, entity_under_test->read_slots[2].chunk_index);
+  EXPECT_FALSE(f_success);
+  EXPECT_FALSE(f_failed);
+}
+
+TEST_F(S3ObjectDataCopierTest, OutOfOrderReadWaitsForEarlierChunk) {
+
+  entity_under_test->chunks_total = 2;
+  entity_under_test->pipeline_depth = 2;
+  set_read_in_progress(0, 0);
+  set_read_in_progress(1, 1);
+
+  S3BufferSequence data_blocks_read;
+  data_blocks_read.emplace_back(nullptr, entity_under_test->size_of_ev_buffer);
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              extract_blocks_read())
+      .Times(1)
+      .WillOnce(Return(data_blocks_read));
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              get_evbuffer_ownership())
+      .Times(1)
+      .WillOnce(Return(evbuffer_new()));
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
+              write_content(_, _, _, _)).Times(0);
+
+  entity_under_test->read_data_block_success(1);
+
+  EXPECT_FALSE(entity_under_test->write_in_progress);
+  EXPECT_EQ(1, entity_under_test->chunks_read.count(1));
+  EXPECT_EQ(1, entity_under_test->reads_in_progress);
+}
+
+TEST_F(S3ObjectDataCopierTest, ReadFailureWaitsForWriteInFlight) {
+
+  entity_under_test->chunks_total = 2;
+  entity_under_test->next_chunk_to_write = 1;
+  entity_under_test->write_in_progress = true;
+  entity_under_test->p_evbuffer_write = evbuffer_new();
+  set_read_in_progress(0, 1);
+
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader, get_state())
+      .Times(1)
+      .WillOnce(Return(S3MotrReaderOpState::failed));
+
+  entity_under_test->read_data_block_failed(0);
+
+  EXPECT_TRUE(entity_under_test->copy_failed);
+  EXPECT_FALSE(f_failed);
+
+  entity_under_test->write_data_block_success();
+
+  EXPECT_TRUE(f_failed);
+  EXPECT_FALSE(f_success);
+}
+
+// Unit buffers are for GET only, the copier writes blocks of
+// S3_LIBEVENT_POOL_BUFFER_SIZE even when the motr read pool has a pool for
+// the unit size of the source object.
+TEST_F(S3ObjectDataCopierTest, ReadWithUnitBuffersEnabled) {
+  S3Option *option = S3Option::get_instance();
+  const size_t unit_size = entity_under_test->motr_unit_size;
+  ASSERT_NE(unit_size, entity_under_test->size_of_ev_buffer);
+
+  std::vector<int> unit_sizes = option->get_motr_unit_sizes_for_mem_pool();
+  unit_sizes.push_back(unit_size);
+  S3MempoolManager::destroy_instance();
+  ASSERT_EQ(0, S3MempoolManager::create_pool(
+                   option->get_motr_read_pool_max_threshold(), unit_sizes,
+                   option->get_motr_read_pool_initial_buffer_count(),
+                   option->get_motr_read_pool_expandable_count(),
+                   CREATE_ALIGNED_MEMORY));
+  option->set_motr_read_unit_buffers(true);
+  ASSERT_TRUE(S3Evbuffer::can_use_pool_buffers(unit_size));
+
+  // Reader as the copier creates it, reading from an opened object
+  auto motr_reader = std::make_shared<S3MotrReader>(
+      ptr_mock_request, oid, 1, m0_fid{}, ptr_mock_s3_motr_api);
+  motr_reader->obj_ctx = (struct s3_motr_obj_context *)calloc(
+      1, sizeof(struct s3_motr_obj_context));
+  motr_reader->obj_ctx->objs =
+      (struct m0_obj *)calloc(1, sizeof(struct m0_obj));
+  motr_reader->obj_ctx->obj_count = 1;
+  motr_reader->obj_ctx->n_initialized_contexts = 1;
+  motr_reader->is_object_opened = true;
+  entity_under_test->read_slots[0].motr_reader = motr_reader;
+
+  EXPECT_CALL(*ptr_mock_s3_motr_api, motr_obj_op(_, _, _, _, _, _, _, _))
+      .WillOnce(Invoke(s3_test_motr_obj_op));
+  EXPECT_CALL(*ptr_mock_s3_motr_api, motr_obj_fini(_)).Times(1);
+  EXPECT_CALL(*ptr_mock_s3_motr_api, motr_op_setup(_, _, _)).Times(1);
+  EXPECT_CALL(*ptr_mock_s3_motr_api, motr_op_launch(_, _, _, _))
+      .WillRepeatedly(Invoke(s3_test_motr_op_launch));
+
+  S3BufferSequence data_blocks_written;
+  size_t block_size_written = 0;
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
+              write_content(_, _, _, _))
+      .Times(1)
+      .WillOnce(DoAll(SaveArg<2>(&data_blocks_written),
+                      SaveArg<3>(&block_size_written)));
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer, get_state())
+      .Times(1);
+
+  entity_under_test->read_data_block(0);
+
+  EXPECT_TRUE(entity_under_test->write_in_progress);
+  EXPECT_EQ(entity_under_test->size_of_ev_buffer, block_size_written);
+  ASSERT_FALSE(data_blocks_written.empty());
+  for (const auto &block : data_blocks_written) {
+    EXPECT_EQ(block_size_written, block.second);
+  }
+
+  // Buffers read are freed before the pools are
+  entity_under_test.reset();
+  motr_reader.reset();
+  option->set_motr_read_unit_buffers(false);
+  S3MempoolManager::destroy_instance();
+  S3MempoolManager::create_pool(
+      option->get_motr_read_pool_max_threshold(),
+      option->get_motr_unit_sizes_for_mem_pool(),
+      option->get_motr_read_pool_initial_buffer_count(),
+      option->get_motr_read_pool_expandable_count(), CREATE_ALIGNED_MEMORY);
+}
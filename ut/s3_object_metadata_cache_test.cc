@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "mock_s3_request_object.h"
+#include "s3_object_metadata.h"
+#include "s3_object_metadata_cache.h"
+
+using ::testing::ReturnRef;
+
+class S3ObjectMetadataCacheTest : public testing::Test {
+ protected:
+  S3ObjectMetadataCacheTest()
+      : bucket_name("seagate_bucket"), index_oid({0xffff, 0xffff}) {
+    evhtp_request_t *req = NULL;
+    EvhtpInterface *evhtp_obj_ptr = new EvhtpWrapper();
+
+    ptr_mock_request =
+        std::make_shared<MockS3RequestObject>(req, evhtp_obj_ptr);
+    EXPECT_CALL(*ptr_mock_request, get_bucket_name())
+        .WillRepeatedly(ReturnRef(bucket_name));
+  }
+
+  std::shared_ptr<const S3ObjectMetadata> create_metadata(
+      const std::string &object_name) {
+    return std::make_shared<S3ObjectMetadata>(ptr_mock_request, bucket_name,
+                                              object_name);
+  }
+
+  std::shared_ptr<MockS3RequestObject> ptr_mock_request;
+  std::string bucket_name;
+  struct m0_uint128 index_oid;
+};
+
+TEST_F(S3ObjectMetadataCacheTest, GetReturnsStoredValue) {
+  S3ObjectMetadataCache cache(10, 60, 4);
+  auto p_value = create_metadata("obj");
+
+  EXPECT_FALSE(cache.get(index_oid, "obj"));
+  EXPECT_TRUE(cache.put(index_oid, "obj", cache.get_generation(index_oid, "obj"),
+                        p_value));
+  EXPECT_EQ(p_value, cache.get(index_oid, "obj"));
+  EXPECT_EQ(1u, cache.size());
+
+  // Same name in other bucket index is another key
+  const struct m0_uint128 other_index_oid = {0xffff, 0xfff0};
+  EXPECT_FALSE(cache.get(other_index_oid, "obj"));
+  EXPECT_FALSE(cache.get(index_oid, "obj1"));
+
+  EXPECT_EQ(1u, cache.get_counters().hits.load());
+  EXPECT_EQ(3u, cache.get_counters().misses.load());
+}
+
+TEST_F(S3ObjectMetadataCacheTest, InvalidateRemovesEntry) {
+  S3ObjectMetadataCache cache(10, 60, 4);
+
+  cache.put(index_oid, "obj", cache.get_generation(index_oid, "obj"),
+            create_metadata("obj"));
+  cache.invalidate(index_oid, "obj");
+
+  EXPECT_FALSE(cache.get(index_oid, "obj"));
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(1u, cache.get_counters().invalidations.load());
+}
+
+TEST_F(S3ObjectMetadataCacheTest, LoadRacingWithUpdateIsNotCached) {
+  S3ObjectMetadataCache cache(10, 60, 4);
+
+  // Load started, then the object was overwritten before load completed
+  const uint64_t generation = cache.get_generation(index_oid, "obj");
+  cache.invalidate(index_oid, "obj");
+
+  EXPECT_FALSE(cache.put(index_oid, "obj", generation, create_metadata("obj")));
+  EXPECT_FALSE(cache.get(index_oid, "obj"));
+}
+
+TEST_F(S3ObjectMetadataCacheTest, ExpiredEntryIsNotReturned) {
+  S3ObjectMetadataCache cache(10, 0);
+
+  cache.put(index_oid, "obj", cache.get_generation(index_oid, "obj"),
+            create_metadata("obj"));
+
+  EXPECT_FALSE(cache.get(index_oid, "obj"));
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(1u, cache.get_counters().expirations.load());
+}
+
+TEST_F(S3ObjectMetadataCacheTest, LeastRecentlyUsedIsEvicted) {
+  S3ObjectMetadataCache cache(2, 60);
+
+  for (const char *name : {"obj1", "obj2"}) {
+    cache.put(index_oid, name, cache.get_generation(index_oid, name),
+              create_metadata(name));
+  }
+  EXPECT_TRUE(cache.get(index_oid, "obj1"));
+
+  cache.put(index_oid, "obj3", cache.get_generation(index_oid, "obj3"),
+            create_metadata("obj3"));
+
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_TRUE(cache.get(index_oid, "obj1"));
+  EXPECT_FALSE(cache.get(index_oid, "obj2"));
+  EXPECT_TRUE(cache.get(index_oid, "obj3"));
+  EXPECT_EQ(1u, cache.get_counters().evictions.load());
+}
+
+TEST_F(S3ObjectMetadataCacheTest, SingleInstance) {
+  EXPECT_EQ(nullptr, S3ObjectMetadataCache::get_instance());
+  {
+    S3ObjectMetadataCache cache(10, 60);
+    EXPECT_EQ(&cache, S3ObjectMetadataCache::get_instance());
+  }
+  EXPECT_EQ(nullptr, S3ObjectMetadataCache::get_instance());
+}
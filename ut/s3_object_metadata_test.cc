@@ -26,7 +26,9 @@
 #include "mock_s3_request_object.h"
 #include "s3_callback_test_helpers.h"
 #include "s3_common.h"
+#include "s3_m0_uint128_helper.h"
 #include "s3_object_metadata.h"
+#include "s3_object_metadata_cache.h"
 #include "s3_test_utils.h"
 #include "s3_ut_common.h"
 
@@ -357,6 +359,52 @@ TEST_F(S3ObjectMetadataTest, LoadSuccessful) {
   EXPECT_TRUE(s3objectmetadata_callbackobj.success_called);
 }
 
+TEST_F(S3ObjectMetadataTest, LoadFromObjectMetadataCache) {
+  S3ObjectMetadataCache object_metadata_cache(10, 60);
+
+  metadata_obj_under_test_with_oid->motr_kv_reader =
+      motr_kvs_reader_factory->mock_motr_kvs_reader;
+  metadata_obj_under_test_with_oid->handler_on_success =
+      std::bind(&S3CallBack::on_success, &s3objectmetadata_callbackobj);
+
+  std::string s_retval =
+      "{\"Bucket-Name\":\"seagate_bucket\",\"Object-Name\":\"objectname\","
+      "\"User-Defined\":{\"x-amz-meta-key\":\"value\"}}";
+  EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader), get_value())
+      .WillRepeatedly(ReturnRef(s_retval));
+  metadata_obj_under_test_with_oid->requested_bucket_name = "seagate_bucket";
+  metadata_obj_under_test_with_oid->requested_object_name = "objectname";
+
+  metadata_obj_under_test_with_oid->load_successful();
+  EXPECT_TRUE(s3objectmetadata_callbackobj.success_called);
+  EXPECT_EQ(1u, object_metadata_cache.size());
+
+  // Second load is served from the cache, KVS is not read
+  EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
+              get_keyval(_, _, _, _)).Times(0);
+  S3CallBack cached_load_callback;
+  S3ObjectMetadata cached_metadata(ptr_mock_request, false, "",
+                                   motr_kvs_reader_factory,
+                                   motr_kvs_writer_factory,
+                                   ptr_mock_s3_motr_api);
+  cached_metadata.set_object_list_index_layout(object_list_index_layout);
+  cached_metadata.load(
+      std::bind(&S3CallBack::on_success, &cached_load_callback),
+      std::bind(&S3CallBack::on_failed, &cached_load_callback));
+
+  EXPECT_TRUE(cached_load_callback.success_called);
+  EXPECT_EQ(S3ObjectMetadataState::present, cached_metadata.get_state());
+  EXPECT_EQ("value",
+            cached_metadata.user_defined_attribute["x-amz-meta-key"]);
+  EXPECT_EQ(1u, object_metadata_cache.get_counters().hits.load());
+
+  // Update of the object drops the cached entry
+  EXPECT_CALL(*(motr_kvs_writer_factory->mock_motr_kvs_writer),
+              put_keyval(_, _, _, _, _, _)).Times(1);
+  cached_metadata.save_metadata();
+  EXPECT_EQ(0u, object_metadata_cache.size());
+}
+
 TEST_F(S3ObjectMetadataTest, LoadMetadataFail) {
   const std::string file = "3kfile@@corrupted";
   EXPECT_CALL(*ptr_mock_request, get_object_name())
@@ -655,6 +703,59 @@ TEST_F(S3MultipartObjectMetadataTest, FromJson) {
   EXPECT_STREQ("123-456", metadata_obj_under_test->motr_old_oid_str.c_str());
 }
 
+TEST_F(S3ObjectMetadataTest, ToBinaryFromBinary) {
+  const struct m0_uint128 oid = {0x1234, 0x5678};
+  metadata_obj_under_test->set_oid(oid);
+  metadata_obj_under_test->set_layout_id(9);
+  metadata_obj_under_test->set_content_length("1024");
+  metadata_obj_under_test->add_user_defined_attribute("x-amz-meta-key",
+                                                      "value");
+  metadata_obj_under_test->set_tags({{"tag", "val"}});
+  metadata_obj_under_test->setacl("PD94bg==");
+
+  std::string binary = metadata_obj_under_test->to_binary();
+  EXPECT_LT(binary.size(), metadata_obj_under_test->to_json().size());
+
+  S3ObjectMetadata decoded(ptr_mock_request, false, "",
+                           motr_kvs_reader_factory, motr_kvs_writer_factory,
+                           ptr_mock_s3_motr_api);
+  EXPECT_EQ(0, decoded.from_json(binary));
+  EXPECT_EQ("seagate_bucket", decoded.bucket_name);
+  EXPECT_EQ("objectname", decoded.object_name);
+  EXPECT_OID_EQ(oid, decoded.oid);
+  EXPECT_EQ(metadata_obj_under_test->motr_oid_str, decoded.motr_oid_str);
+  EXPECT_EQ(9, decoded.layout_id);
+  EXPECT_EQ("1024", decoded.system_defined_attribute["Content-Length"]);
+  EXPECT_EQ("value", decoded.user_defined_attribute["x-amz-meta-key"]);
+  EXPECT_EQ("val", decoded.object_tags["tag"]);
+  EXPECT_EQ("PD94bg==", decoded.encoded_acl);
+  EXPECT_EQ("s3user", decoded.user_name);
+  EXPECT_EQ("s3acc-id", decoded.account_id);
+  EXPECT_TRUE(decoded.motr_part_layout_str.empty());
+
+  // Truncated value must be rejected
+  binary.resize(binary.size() - 1);
+  EXPECT_EQ(-1, decoded.from_json(binary));
+}
+
+TEST_F(S3MultipartObjectMetadataTest, ToBinaryFromBinary) {
+  const struct m0_uint128 old_oid = {0x1111, 0x2222};
+  metadata_obj_under_test->set_old_oid(old_oid);
+  metadata_obj_under_test->set_old_layout_id(3);
+  metadata_obj_under_test->set_old_version_id("old_version");
+
+  std::string binary = metadata_obj_under_test->to_binary();
+
+  EXPECT_EQ(0, metadata_obj_under_test->from_json(binary));
+  EXPECT_OID_EQ(old_oid, metadata_obj_under_test->old_oid);
+  EXPECT_EQ(S3M0Uint128Helper::to_string(old_oid),
+            metadata_obj_under_test->motr_old_oid_str);
+  EXPECT_EQ(3, metadata_obj_under_test->old_layout_id);
+  EXPECT_EQ("old_version",
+            metadata_obj_under_test->motr_old_object_version_id);
+  EXPECT_EQ("1234-1234", metadata_obj_under_test->upload_id);
+}
+
 TEST_F(S3ObjectMetadataTest, GetEncodedBucketAcl) {
   std::string json_str =
       "{\"ACL\":\"PD94bg==\",\"Bucket-Name\":\"seagate_bucket\"}";
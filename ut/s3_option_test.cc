@@ -131,6 +131,10 @@ TEST_F(S3OptionsTest, GetOptionsfromFile) {
   EXPECT_TRUE(instance->is_s3server_addb_dump_enabled());
   EXPECT_EQ("s3stats-allowlist-test.yaml",
             instance->get_stats_allowlist_filename());
+  EXPECT_FALSE(instance->is_stats_aggregate_enabled());
+  EXPECT_EQ(10000u, instance->get_stats_flush_interval_msec());
+  EXPECT_EQ("127.0.0.1", instance->get_stats_prometheus_ip_addr());
+  EXPECT_EQ(0, instance->get_stats_prometheus_port());
 }
 
 TEST_F(S3OptionsTest, TestOverrideOptions) {
@@ -250,6 +254,9 @@ TEST_F(S3OptionsTest, LoadS3SectionFromFile) {
   EXPECT_EQ("s3stats-allowlist-test.yaml",
             instance->get_stats_allowlist_filename());
   EXPECT_TRUE(instance->is_s3server_addb_dump_enabled());
+  EXPECT_EQ(1u, instance->get_get_read_window_max_multiple());
+  EXPECT_EQ(4u, instance->get_copy_pipeline_depth());
+  EXPECT_EQ(3u, instance->get_copy_max_parallel_fragments());
 
   // These will come with default values.
   EXPECT_EQ(std::string("localhost@tcp:12345:33:100"),
@@ -264,6 +271,12 @@ TEST_F(S3OptionsTest, LoadS3SectionFromFile) {
   EXPECT_FALSE(instance->get_motr_is_oostore());
   EXPECT_FALSE(instance->get_motr_is_read_verify());
   EXPECT_FALSE(instance->is_s3_reuseport_enabled());
+  EXPECT_EQ(1u, instance->get_s3_reactor_count());
+  EXPECT_EQ(0u, instance->get_s3_hash_thread_count());
+  EXPECT_EQ(16384u, instance->get_s3_completion_queue_size());
+  EXPECT_EQ(16384u, instance->get_s3_request_arena_size());
+  EXPECT_EQ(0u, instance->get_object_metadata_cache_max_size());
+  EXPECT_EQ(1u, instance->get_object_metadata_cache_expire_sec());
 }
 
 TEST_F(S3OptionsTest, LoadSelectiveS3SectionFromFile) {
@@ -313,6 +326,12 @@ TEST_F(S3OptionsTest, LoadAuthSectionFromFile) {
 
   EXPECT_EQ(std::string("10.10.1.2"), instance->get_auth_ip_addr());
   EXPECT_EQ(8095, instance->get_auth_port());
+  EXPECT_EQ(0u, instance->get_auth_cache_max_size());
+  EXPECT_EQ(300u, instance->get_auth_cache_expire_sec());
+  EXPECT_EQ(5u, instance->get_auth_cache_authorization_expire_sec());
+  EXPECT_EQ("", instance->get_auth_signing_key_secret());
+  EXPECT_EQ(0u, instance->get_auth_pool_max_connections());
+  EXPECT_EQ(60u, instance->get_auth_pool_idle_timeout_sec());
 
   // Others should not be loaded
   EXPECT_EQ(std::string("/var/log/cortx/s3"), instance->get_log_dir());
@@ -379,6 +398,13 @@ TEST_F(S3OptionsTest, LoadMotrSectionFromFile) {
   EXPECT_EQ(1, instance->get_motr_idx_service_id());
   EXPECT_TRUE(instance->get_motr_is_oostore());
   EXPECT_FALSE(instance->get_motr_is_read_verify());
+  EXPECT_FALSE(instance->get_motr_read_mempool_use_hugepages());
+  EXPECT_FALSE(instance->get_motr_read_mempool_prefault());
+  EXPECT_FALSE(instance->get_motr_read_unit_buffers());
+  EXPECT_EQ(0u, instance->get_motr_kvs_batch_window_us());
+  EXPECT_EQ(64u, instance->get_motr_kvs_batch_max_keys());
+  EXPECT_EQ(4u, instance->get_motr_multi_delete_max_inflight());
+  EXPECT_EQ(1000u, instance->get_motr_kvs_prefetch_max_keys());
 
   // Others should not be loaded
   EXPECT_EQ(std::string("/var/log/cortx/s3"), instance->get_log_dir());
@@ -514,6 +514,31 @@ TEST_F(S3PartMetadataTest, FromJsonSuccess) {
   EXPECT_EQ(0, metadata_under_test->from_json(json_str));
 }
 
+TEST_F(S3PartMetadataTest, ToBinaryFromBinary) {
+  const struct m0_uint128 oid = {0x1234, 0x5678};
+  metadata_under_test->set_oid(oid);
+  metadata_under_test->set_layout_id(9);
+  metadata_under_test->set_pvid_str("pvid");
+  metadata_under_test->set_content_length("1024");
+  metadata_under_test->add_user_defined_attribute("x-amz-meta-key", "value");
+
+  std::string binary = metadata_under_test->to_binary();
+  EXPECT_LT(binary.size(), metadata_under_test->to_json().size());
+
+  S3PartMetadata decoded(ptr_mock_request, "", 0, motr_kvs_reader_factory,
+                         motr_kvs_writer_factory);
+  EXPECT_EQ(0, decoded.from_json(binary));
+  EXPECT_EQ("objname", decoded.get_object_name());
+  EXPECT_EQ("uploadid", decoded.get_upload_id());
+  EXPECT_EQ("1", decoded.get_part_number());
+  EXPECT_OID_EQ(oid, decoded.get_oid());
+  EXPECT_EQ(metadata_under_test->get_oid_str(), decoded.get_oid_str());
+  EXPECT_EQ(9, decoded.get_layout_id());
+  EXPECT_EQ("pvid", decoded.get_pvid_str());
+  EXPECT_EQ(1024u, decoded.get_content_length());
+  EXPECT_EQ("value", decoded.get_user_defined_attribute("x-amz-meta-key"));
+}
+
 TEST_F(S3PartMetadataTest, FromJsonFailure) {
   std::string json_str = "This is invalid Json String";
   EXPECT_EQ(-1, metadata_under_test->from_json(json_str));
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "s3_option.h"
+#include "s3_reactor.h"
+
+class S3ReactorTest : public testing::Test {
+ protected:
+  pthread_t loop_thread;
+  S3Reactor *loop_reactor = nullptr;
+  evbase_t *loop_evbase = nullptr;
+  bool stop_hook_called = false;
+
+  // Leaves the loop right after it starts, so the test does not depend on
+  // the event base being notifiable from other threads.
+  static void exit_loop_cb(evutil_socket_t, short, void *arg) {
+    S3ReactorTest *test = (S3ReactorTest *)arg;
+    test->loop_thread = pthread_self();
+    test->loop_reactor = S3Reactor::get_current();
+    test->loop_evbase = S3Option::get_instance()->get_eventbase();
+    event_base_loopexit(test->loop_reactor->get_evbase(), NULL);
+  }
+};
+
+TEST_F(S3ReactorTest, StartRunsLoopOnOwnThread) {
+  S3Reactor reactor(
+      1,
+      [this](S3Reactor *r) {
+        struct timeval tv = {0, 0};
+        return event_base_once(r->get_evbase(), -1, EV_TIMEOUT,
+                               S3ReactorTest::exit_loop_cb, this, &tv);
+      },
+      [this](S3Reactor *) { stop_hook_called = true; });
+
+  EXPECT_EQ(0, reactor.start());
+  EXPECT_TRUE(reactor.is_running());
+  reactor.stop();
+  EXPECT_FALSE(reactor.is_running());
+
+  EXPECT_FALSE(pthread_equal(loop_thread, pthread_self()));
+  EXPECT_EQ(&reactor, loop_reactor);
+  EXPECT_EQ(reactor.get_evbase(), loop_evbase);
+  EXPECT_TRUE(stop_hook_called);
+  // The calling thread is not bound to the reactor
+  EXPECT_EQ(nullptr, S3Reactor::get_current());
+  EXPECT_NE(reactor.get_evbase(), S3Option::get_instance()->get_eventbase());
+}
+
+TEST_F(S3ReactorTest, StartHookFailureAbortsStart) {
+  S3Reactor reactor(1, [](S3Reactor *) { return EINVAL; },
+                    [this](S3Reactor *) { stop_hook_called = true; });
+
+  EXPECT_EQ(EINVAL, reactor.start());
+  EXPECT_FALSE(reactor.is_running());
+  EXPECT_FALSE(stop_hook_called);
+}
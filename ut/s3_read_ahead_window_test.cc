@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include "s3_read_ahead_window.h"
+
+#define MiB (1024 * 1024)
+
+TEST(S3ReadAheadWindowTest, InitialWindowIsClamped) {
+  EXPECT_EQ(4u, S3ReadAheadWindow(4, 16).get_blocks());
+  EXPECT_EQ(2u, S3ReadAheadWindow(4, 2).get_blocks());
+  EXPECT_EQ(1u, S3ReadAheadWindow(0, 0).get_blocks());
+}
+
+TEST(S3ReadAheadWindowTest, GrowsUpToMaxWhileClientKeepsUp) {
+  S3ReadAheadWindow window(2, 16);
+
+  window.on_read_complete(2 * MiB, 0, true);
+  EXPECT_EQ(4u, window.get_blocks());
+  window.on_read_complete(4 * MiB, MiB, true);
+  EXPECT_EQ(8u, window.get_blocks());
+  window.on_read_complete(8 * MiB, 0, true);
+  window.on_read_complete(16 * MiB, 0, true);
+  EXPECT_EQ(16u, window.get_blocks());
+
+  EXPECT_EQ(4u, window.get_reads_count());
+  EXPECT_EQ(3u, window.get_grow_count());
+  EXPECT_EQ(0u, window.get_shrink_count());
+  EXPECT_EQ(16u, window.get_max_blocks_used());
+}
+
+TEST(S3ReadAheadWindowTest, DoesNotGrowWithoutMemory) {
+  S3ReadAheadWindow window(2, 16);
+
+  window.on_read_complete(2 * MiB, 0, false);
+  EXPECT_EQ(2u, window.get_blocks());
+  EXPECT_EQ(0u, window.get_grow_count());
+}
+
+TEST(S3ReadAheadWindowTest, KeepsWindowWhenClientIsBehindALittle) {
+  S3ReadAheadWindow window(4, 16);
+
+  window.on_read_complete(4 * MiB, 2 * MiB, true);
+  window.on_read_complete(4 * MiB, 4 * MiB, true);
+  EXPECT_EQ(4u, window.get_blocks());
+}
+
+TEST(S3ReadAheadWindowTest, ShrinksForSlowClient) {
+  S3ReadAheadWindow window(8, 16);
+
+  window.on_read_complete(8 * MiB, 9 * MiB, true);
+  EXPECT_EQ(4u, window.get_blocks());
+  window.on_read_complete(4 * MiB, 12 * MiB, true);
+  window.on_read_complete(2 * MiB, 12 * MiB, true);
+  window.on_read_complete(MiB, 12 * MiB, true);
+  EXPECT_EQ(1u, window.get_blocks());
+
+  EXPECT_EQ(3u, window.get_shrink_count());
+  EXPECT_EQ(8u, window.get_max_blocks_used());
+}
+
+TEST(S3ReadAheadWindowTest, ShrinksWhenThrottled) {
+  S3ReadAheadWindow window(16, 16);
+
+  window.on_throttled();
+  EXPECT_EQ(8u, window.get_blocks());
+  EXPECT_EQ(1u, window.get_throttle_count());
+  EXPECT_EQ(1u, window.get_shrink_count());
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "s3_api_handler.h"
+#include "s3_get_object_action.h"
+#include "s3_option.h"
+#include "s3_put_object_action.h"
+#include "s3_request_arena.h"
+
+#include "mock_s3_async_buffer_opt_container.h"
+#include "mock_s3_request_object.h"
+
+using ::testing::Return;
+using ::testing::ReturnRef;
+using ::testing::_;
+
+// malloc() and calloc() of the whole test binary go through these, so
+// operator new, std::string and C code are all seen. Only the calling
+// thread is counted, and only between start and stop.
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t nmemb, size_t size);
+
+static thread_local bool count_mallocs = false;
+static thread_local size_t malloc_count = 0;
+
+extern "C" void *malloc(size_t size) __THROW {
+  if (count_mallocs) {
+    ++malloc_count;
+  }
+  return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t nmemb, size_t size) __THROW {
+  if (count_mallocs) {
+    ++malloc_count;
+  }
+  return __libc_calloc(nmemb, size);
+}
+
+static void start_counting_mallocs() {
+  malloc_count = 0;
+  count_mallocs = true;
+}
+
+static size_t stop_counting_mallocs() {
+  count_mallocs = false;
+  return malloc_count;
+}
+
+class S3RequestArenaMallocTest : public testing::Test {
+ protected:
+  S3RequestArenaMallocTest() {
+    S3Option::get_instance()->disable_auth();
+    saved_arena_size = S3Option::get_instance()->get_s3_request_arena_size();
+    bucket_name = "seagatebucket";
+    object_name = "objname";
+    input_headers["Authorization"] = "1";
+    async_buffer_factory =
+        std::make_shared<MockS3AsyncBufferOptContainerFactory>(
+            S3Option::get_instance()->get_libevent_pool_buffer_size());
+    factory.reset(new S3APIHandlerFactory());
+  }
+  ~S3RequestArenaMallocTest() {
+    S3RequestArena::clear_pool();
+    S3Option::get_instance()->set_s3_request_arena_size(saved_arena_size);
+  }
+
+  // Mallocs made while the handler and action of an object request are
+  // created. The first request pays for one time setup and for the arena
+  // chunk, which later requests take from the pool, so the second one is
+  // measured.
+  size_t count_request_mallocs(unsigned arena_size, S3HttpVerb verb) {
+    S3Option::get_instance()->set_s3_request_arena_size(arena_size);
+    S3RequestArena::clear_pool();
+    create_request(verb);
+    return create_request(verb);
+  }
+
+  size_t create_request(S3HttpVerb verb) {
+    std::shared_ptr<MockS3RequestObject> mock_request =
+        std::make_shared<MockS3RequestObject>(NULL, new EvhtpWrapper(),
+                                              async_buffer_factory);
+    EXPECT_CALL(*mock_request, get_bucket_name())
+        .WillRepeatedly(ReturnRef(bucket_name));
+    EXPECT_CALL(*mock_request, get_object_name())
+        .WillRepeatedly(ReturnRef(object_name));
+    EXPECT_CALL(*mock_request, get_in_headers_copy())
+        .WillRepeatedly(ReturnRef(input_headers));
+    EXPECT_CALL(*mock_request, http_verb()).WillRepeatedly(Return(verb));
+    EXPECT_CALL(*mock_request, get_header_value(_))
+        .WillRepeatedly(Return(""));
+    EXPECT_CALL(*mock_request, get_data_length()).WillRepeatedly(Return(0));
+
+    start_counting_mallocs();
+    std::shared_ptr<S3APIHandler> handler = factory->create_api_handler(
+        S3ApiType::object, mock_request, S3OperationCode::none);
+    size_t count = stop_counting_mallocs();
+
+    EXPECT_TRUE(handler != nullptr);
+    return count;
+  }
+
+  void expect_fewer_mallocs(const char *api, S3HttpVerb verb) {
+    size_t heap_count = count_request_mallocs(0, verb);
+    size_t arena_count = count_request_mallocs(16384, verb);
+    std::cout << api << " mallocs: " << heap_count << " without arena, "
+              << arena_count << " with arena\n";
+    // Handler, action and its task lists at least come from the arena
+    EXPECT_LE(arena_count + 3, heap_count);
+  }
+
+  unsigned saved_arena_size;
+  std::string bucket_name, object_name;
+  std::map<std::string, std::string> input_headers;
+  std::shared_ptr<MockS3AsyncBufferOptContainerFactory> async_buffer_factory;
+  std::unique_ptr<S3APIHandlerFactory> factory;
+};
+
+TEST_F(S3RequestArenaMallocTest, GetObjectRequest) {
+  expect_fewer_mallocs("GetObject", S3HttpVerb::GET);
+}
+
+TEST_F(S3RequestArenaMallocTest, PutObjectRequest) {
+  S3Option::get_instance()->enable_murmurhash_oid();
+  expect_fewer_mallocs("PutObject", S3HttpVerb::PUT);
+  S3Option::get_instance()->disable_murmurhash_oid();
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "s3_option.h"
+#include "s3_request_arena.h"
+
+struct ArenaTestObject {
+  int value;
+  explicit ArenaTestObject(int value) : value(value) {}
+};
+
+class S3RequestArenaTest : public testing::Test {
+ protected:
+  S3RequestArenaTest() {
+    saved_arena_size = S3Option::get_instance()->get_s3_request_arena_size();
+    S3Option::get_instance()->set_s3_request_arena_size(4096);
+    S3RequestArena::clear_pool();
+  }
+  ~S3RequestArenaTest() {
+    S3RequestArena::clear_pool();
+    S3Option::get_instance()->set_s3_request_arena_size(saved_arena_size);
+  }
+
+  unsigned saved_arena_size;
+};
+
+TEST_F(S3RequestArenaTest, DisabledWhenSizeIsZero) {
+  S3Option::get_instance()->set_s3_request_arena_size(0);
+  EXPECT_TRUE(S3RequestArena::acquire() == nullptr);
+}
+
+TEST_F(S3RequestArenaTest, AllocationsAreAlignedAndCounted) {
+  S3RequestArena *arena = S3RequestArena::acquire();
+  ASSERT_TRUE(arena != nullptr);
+
+  void *p1 = arena->allocate(1, 1);
+  void *p8 = arena->allocate(8, 8);
+  void *p16 = arena->allocate(16, 16);
+  EXPECT_TRUE(p1 != nullptr);
+  EXPECT_EQ(0u, (uintptr_t)p8 % 8);
+  EXPECT_EQ(0u, (uintptr_t)p16 % 16);
+  EXPECT_NE(p1, p8);
+  EXPECT_EQ(3u, arena->get_allocation_count());
+  EXPECT_EQ(25u, arena->get_bytes_allocated());
+  EXPECT_EQ(1u, arena->get_heap_chunk_count());
+
+  arena->release();
+  EXPECT_EQ(1u, S3RequestArena::get_pooled_count());
+}
+
+TEST_F(S3RequestArenaTest, PooledArenaReusesChunk) {
+  S3RequestArena *arena = S3RequestArena::acquire();
+  void *first = arena->allocate(100, 8);
+  arena->release();
+
+  S3RequestArena *next_arena = S3RequestArena::acquire();
+  EXPECT_EQ(arena, next_arena);
+  EXPECT_EQ(0u, S3RequestArena::get_pooled_count());
+  EXPECT_EQ(0u, next_arena->get_allocation_count());
+  EXPECT_EQ(first, next_arena->allocate(100, 8));
+  EXPECT_EQ(0u, next_arena->get_heap_chunk_count());
+  next_arena->release();
+}
+
+TEST_F(S3RequestArenaTest, ChunkOverflowAndLargeAllocations) {
+  S3RequestArena *arena = S3RequestArena::acquire();
+  char *small = (char *)arena->allocate(64, 8);
+  char *large = (char *)arena->allocate(10000, 8);
+  memset(large, 0xab, 10000);
+  // Small allocations still come from the first chunk
+  char *next_small = (char *)arena->allocate(64, 8);
+  EXPECT_EQ(small + 64, next_small);
+  EXPECT_EQ(2u, arena->get_heap_chunk_count());
+
+  for (int i = 0; i < 100; ++i) {
+    memset(arena->allocate(64, 8), 0xcd, 64);
+  }
+  EXPECT_EQ(3u, arena->get_heap_chunk_count());
+  arena->release();
+
+  // Only the first chunk is kept
+  arena = S3RequestArena::acquire();
+  for (int i = 0; i < 50; ++i) {
+    arena->allocate(64, 8);
+  }
+  EXPECT_EQ(0u, arena->get_heap_chunk_count());
+  arena->release();
+}
+
+TEST_F(S3RequestArenaTest, ContainerKeepsArenaAfterRequest) {
+  S3RequestArena *arena = S3RequestArena::acquire();
+  {
+    S3ArenaAllocator<int> allocator(arena);
+    std::vector<int, S3ArenaAllocator<int>> values(allocator);
+    for (int i = 0; i < 100; ++i) {
+      values.push_back(i);
+    }
+    EXPECT_LT(0u, arena->get_allocation_count());
+
+    // Request is gone, the vector still uses the arena
+    arena->release();
+    EXPECT_EQ(0u, S3RequestArena::get_pooled_count());
+    values.push_back(100);
+    EXPECT_EQ(100, values[100]);
+  }
+  EXPECT_EQ(1u, S3RequestArena::get_pooled_count());
+}
+
+TEST_F(S3RequestArenaTest, MakeSharedAllocatesFromArena) {
+  S3RequestArena *arena = S3RequestArena::acquire();
+  std::shared_ptr<ArenaTestObject> object =
+      s3_arena_make_shared<ArenaTestObject>(arena, 42);
+  EXPECT_EQ(42, object->value);
+  EXPECT_EQ(1u, arena->get_allocation_count());
+
+  // Control block, and so the arena, lives as long as weak references
+  std::weak_ptr<ArenaTestObject> weak_object = object;
+  object.reset();
+  arena->release();
+  EXPECT_EQ(0u, S3RequestArena::get_pooled_count());
+  EXPECT_TRUE(weak_object.expired());
+  weak_object.reset();
+  EXPECT_EQ(1u, S3RequestArena::get_pooled_count());
+}
+
+TEST_F(S3RequestArenaTest, NoArenaUsesHeap) {
+  std::shared_ptr<ArenaTestObject> object =
+      s3_arena_make_shared<ArenaTestObject>(nullptr, 7);
+  EXPECT_EQ(7, object->value);
+
+  std::vector<int, S3ArenaAllocator<int>> values;
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(i);
+  }
+  EXPECT_EQ(99, values[99]);
+  EXPECT_EQ(0u, S3RequestArena::get_pooled_count());
+}
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "s3_stats_aggregator.h"
+
+class S3StatsAggregatorTest : public testing::Test {
+ protected:
+  S3StatsAggregator aggregator;
+  std::vector<std::pair<std::string, std::string>> msgs;
+
+  std::vector<std::string> collect() {
+    msgs.clear();
+    aggregator.collect_statsd(msgs);
+    std::vector<std::string> lines;
+    for (const auto& msg : msgs) {
+      lines.push_back(msg.second);
+    }
+    return lines;
+  }
+
+  bool has_line(const std::string& text, const std::string& line) {
+    return text.find(line + "\n") != std::string::npos;
+  }
+};
+
+TEST_F(S3StatsAggregatorTest, BucketIndexAndBounds) {
+  for (uint64_t value = 0; value < 8; ++value) {
+    EXPECT_EQ(value, S3StatsHistogram::get_bucket_index(value));
+    EXPECT_EQ(value, S3StatsHistogram::get_bucket_upper(value));
+  }
+  EXPECT_EQ(8u, S3StatsHistogram::get_bucket_index(8));
+  EXPECT_EQ(15u, S3StatsHistogram::get_bucket_index(15));
+  EXPECT_EQ(16u, S3StatsHistogram::get_bucket_index(16));
+  EXPECT_EQ(16u, S3StatsHistogram::get_bucket_index(17));
+  EXPECT_EQ(17u, S3StatsHistogram::get_bucket_upper(16));
+  EXPECT_EQ(S3StatsHistogram::BUCKET_COUNT - 1,
+            S3StatsHistogram::get_bucket_index(UINT64_MAX));
+
+  // Every value is in a bucket whose bounds hold it, within 12.5%
+  for (uint64_t value = 1; value < (1ULL << 40); value = value * 3 + 1) {
+    unsigned index = S3StatsHistogram::get_bucket_index(value);
+    uint64_t upper = S3StatsHistogram::get_bucket_upper(index);
+    EXPECT_LE(value, upper);
+    EXPECT_LE(upper - value, value / 8);
+    if (index > 0) {
+      EXPECT_GT(value, S3StatsHistogram::get_bucket_upper(index - 1));
+    }
+  }
+}
+
+TEST_F(S3StatsAggregatorTest, Percentiles) {
+  S3StatsHistogram histogram;
+  for (uint64_t value = 1; value <= 10000; ++value) {
+    histogram.record(value);
+  }
+  EXPECT_EQ(10000u, histogram.get_count());
+  EXPECT_EQ(50005000u, histogram.get_sum());
+
+  std::vector<uint64_t> counts;
+  histogram.snapshot(counts);
+  uint64_t p50 = S3StatsHistogram::get_value_at_percentile(counts, 50);
+  uint64_t p99 = S3StatsHistogram::get_value_at_percentile(counts, 99);
+  EXPECT_GE(p50, 5000u);
+  EXPECT_LE(p50, 5000u * 9 / 8);
+  EXPECT_GE(p99, 9900u);
+  EXPECT_LE(p99, 9900u * 9 / 8);
+  EXPECT_EQ(0u, S3StatsHistogram::get_value_at_percentile(
+                    std::vector<uint64_t>(counts.size()), 50));
+}
+
+TEST_F(S3StatsAggregatorTest, StatsdCountersAndGauges) {
+  aggregator.count("internal_error_count", 2);
+  aggregator.count("internal_error_count", 3);
+  aggregator.set_gauge("auth_pool_busy_connections", 4);
+  aggregator.update_gauge("auth_pool_busy_connections", -1);
+
+  std::vector<std::string> lines = collect();
+  ASSERT_EQ(2u, lines.size());
+  EXPECT_EQ("auth_pool_busy_connections:3|g", lines[0]);
+  EXPECT_EQ("internal_error_count:5|c", lines[1]);
+  EXPECT_EQ("internal_error_count", msgs[1].first);
+
+  // Only changes are sent again
+  EXPECT_TRUE(collect().empty());
+  aggregator.count("internal_error_count", 1);
+  lines = collect();
+  ASSERT_EQ(1u, lines.size());
+  EXPECT_EQ("internal_error_count:1|c", lines[0]);
+}
+
+TEST_F(S3StatsAggregatorTest, StatsdTimingsPerInterval) {
+  for (int i = 0; i < 100; ++i) {
+    aggregator.timing("api_request_time", 1000, "api=\"GET_OBJECT\"");
+  }
+  std::vector<std::string> lines = collect();
+  ASSERT_EQ(6u, lines.size());
+  EXPECT_EQ("api_request_time_GET_OBJECT_count:100|c", lines[0]);
+  EXPECT_EQ("api_request_time_GET_OBJECT_p50:1.023|g", lines[1]);
+  EXPECT_EQ("api_request_time_GET_OBJECT_max:1.023|g", lines[5]);
+  EXPECT_EQ("api_request_time", msgs[0].first);
+
+  // Percentiles are of the values recorded since the previous flush
+  EXPECT_TRUE(collect().empty());
+  aggregator.timing("api_request_time", 5, "api=\"GET_OBJECT\"");
+  lines = collect();
+  ASSERT_EQ(6u, lines.size());
+  EXPECT_EQ("api_request_time_GET_OBJECT_count:1|c", lines[0]);
+  EXPECT_EQ("api_request_time_GET_OBJECT_p99:0.005|g", lines[3]);
+}
+
+TEST_F(S3StatsAggregatorTest, PrometheusBucketBoundsAreInclusive) {
+  aggregator.timing("api_request_time", 15, "api=\"GET_OBJECT\"");
+  aggregator.timing("api_request_time", 16, "api=\"GET_OBJECT\"");
+  // Larger than any bucket, counted under +Inf only
+  aggregator.timing("api_request_time", 1ULL << 41, "api=\"GET_OBJECT\"");
+
+  std::string text = aggregator.format_prometheus();
+  std::string prefix =
+      "s3server_api_request_time_seconds_bucket{api=\"GET_OBJECT\",";
+  EXPECT_TRUE(has_line(text, prefix + "le=\"1.5e-05\"} 1"));
+  EXPECT_TRUE(has_line(text, prefix + "le=\"3.1e-05\"} 2"));
+  EXPECT_TRUE(has_line(text, prefix + "le=\"+Inf\"} 3"));
+  uint64_t last_upper = S3StatsHistogram::get_bucket_upper(
+      S3StatsHistogram::BUCKET_COUNT - 1);
+  char bound[64];
+  snprintf(bound, sizeof(bound), "le=\"%g\"", last_upper / 1e6);
+  EXPECT_EQ(std::string::npos, text.find(bound));
+}
+
+TEST_F(S3StatsAggregatorTest, PrometheusFormat) {
+  aggregator.count("api_request_count", 2,
+                   "api=\"PUT_OBJECT\",status=\"2xx\"");
+  aggregator.count("api_request_count", 1,
+                   "api=\"GET_OBJECT\",status=\"4xx\"");
+  aggregator.set_gauge("auth_pool_busy_connections", 7);
+  aggregator.timing("api_phase_time", 3, "api=\"PUT_OBJECT\",phase=\"auth\"");
+  aggregator.timing("api_phase_time", 20, "api=\"PUT_OBJECT\",phase=\"auth\"");
+
+  std::string text = aggregator.format_prometheus();
+  EXPECT_TRUE(has_line(text, "# TYPE s3server_api_request_count counter"));
+  EXPECT_TRUE(has_line(
+      text,
+      "s3server_api_request_count{api=\"GET_OBJECT\",status=\"4xx\"} 1"));
+  EXPECT_TRUE(has_line(
+      text,
+      "s3server_api_request_count{api=\"PUT_OBJECT\",status=\"2xx\"} 2"));
+  // One TYPE line per metric name
+  EXPECT_EQ(text.find("# TYPE s3server_api_request_count"),
+            text.rfind("# TYPE s3server_api_request_count"));
+  EXPECT_TRUE(has_line(text, "# TYPE s3server_auth_pool_busy_connections "
+                             "gauge"));
+  EXPECT_TRUE(has_line(text, "s3server_auth_pool_busy_connections 7"));
+
+  EXPECT_TRUE(
+      has_line(text, "# TYPE s3server_api_phase_time_seconds histogram"));
+  std::string series = "api=\"PUT_OBJECT\",phase=\"auth\"";
+  EXPECT_TRUE(has_line(text, "s3server_api_phase_time_seconds_bucket{" +
+                                 series + ",le=\"7e-06\"} 1"));
+  EXPECT_TRUE(has_line(text, "s3server_api_phase_time_seconds_bucket{" +
+                                 series + ",le=\"1.5e-05\"} 1"));
+  EXPECT_TRUE(has_line(text, "s3server_api_phase_time_seconds_bucket{" +
+                                 series + ",le=\"3.1e-05\"} 2"));
+  EXPECT_TRUE(has_line(text, "s3server_api_phase_time_seconds_bucket{" +
+                                 series + ",le=\"+Inf\"} 2"));
+  EXPECT_EQ(std::string::npos, text.find("le=\"6.3e-05\""));
+  EXPECT_TRUE(has_line(
+      text, "s3server_api_phase_time_seconds_sum{" + series + "} 0.000023"));
+  EXPECT_TRUE(has_line(
+      text, "s3server_api_phase_time_seconds_count{" + series + "} 2"));
+}
+
+TEST_F(S3StatsAggregatorTest, ConcurrentUpdates) {
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([this]() {
+      for (int i = 0; i < 10000; ++i) {
+        aggregator.count("internal_error_count", 1);
+        aggregator.timing("total_request_time", i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  std::vector<std::string> lines = collect();
+  EXPECT_NE(lines.end(), std::find(lines.begin(), lines.end(),
+                                   "internal_error_count:40000|c"));
+  EXPECT_NE(lines.end(), std::find(lines.begin(), lines.end(),
+                                   "total_request_time_count:40000|c"));
+}
+
+TEST_F(S3StatsAggregatorTest, TableFullDropsNewMetrics) {
+  for (size_t i = 0; i < S3StatsAggregator::TABLE_SIZE; ++i) {
+    aggregator.count("metric_" + std::to_string(i), 1);
+  }
+  aggregator.count("one_too_many", 1);
+  aggregator.count("metric_0", 1);
+
+  std::vector<std::string> lines = collect();
+  EXPECT_EQ(S3StatsAggregator::TABLE_SIZE, lines.size());
+  EXPECT_NE(lines.end(),
+            std::find(lines.begin(), lines.end(), "metric_0:2|c"));
+  EXPECT_EQ(nullptr, aggregator.get_metric("one_too_many", "",
+                                           S3StatsMetricType::counter));
+}
@@ -281,3 +281,20 @@ TEST_F(S3StatsTest, S3StatsCountUniqueCallMustNotFailForValidSocketCalls) {
   // again calls send.
   EXPECT_NE(s3_stats_under_test->count_unique("internal_error_count", "1"), -1);
 }
+
+TEST_F(S3StatsTest, SendBatchPacksAllowedMessages) {
+  // Allowed messages go in one datagram, others are dropped
+  EXPECT_CALL(*mock_socket, sendto(_, _, 56, _, _, _)).WillOnce(Return(56));
+  EXPECT_EQ(0, s3_stats_under_test->send_batch(
+                   {{"total_request_time", "total_request_time_count:3|c"},
+                    {"xyz", "xyz:1|c"},
+                    {"uri_to_motr_oid", "uri_to_motr_oid_p50:1.000|g"}}));
+
+  // 49 messages of 28 bytes fit a datagram
+  std::vector<std::pair<std::string, std::string>> msgs(
+      100, {"total_request_time", "total_request_time_count:3|c"});
+  EXPECT_CALL(*mock_socket, sendto(_, _, _, _, _, _))
+      .Times(3)
+      .WillRepeatedly(Return(1));
+  EXPECT_EQ(0, s3_stats_under_test->send_batch(msgs));
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <libxml/parser.h>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "s3_xml_writer.h"
+
+// Reference escaping of libxml2 which the writer replaces
+static std::string libxml_escaped(const std::string& value) {
+  xmlChar* output = xmlEncodeSpecialChars(NULL, BAD_CAST value.c_str());
+  std::string data;
+  if (output) {
+    data = reinterpret_cast<char*>(output);
+    xmlFree(output);
+  }
+  return data;
+}
+
+TEST(S3XmlWriterTest, EscapesAsLibxml) {
+  const char* values[] = {"",           "plain key",   "a<b>c&d\"e\r\nf'g",
+                          "<<&&\"\"\r\r", "\xe2\x82\xac&", "&amp;",
+                          "tail<"};
+  for (const char* value : values) {
+    std::string xml;
+    S3XmlWriter::append_escaped(xml, value);
+    EXPECT_EQ(libxml_escaped(value), xml) << value;
+  }
+}
+
+TEST(S3XmlWriterTest, AddElement) {
+  std::string xml;
+  S3XmlWriter writer(xml);
+  writer.add_element("Key", "dir/a&b");
+  writer.add_element("ETag", "abcd", true);
+  writer.add_element("Prefix", "");
+  writer.add_element("ETag", "", true);
+
+  EXPECT_EQ(
+      "<Key>dir/a&amp;b</Key><ETag>\"abcd\"</ETag><Prefix/><ETag/>", xml);
+}
+
+TEST(S3XmlWriterTest, NestedElementsAppend) {
+  std::string xml = "<?xml?>";
+  S3XmlWriter writer(xml);
+  writer.reserve(64);
+  writer.open_element("Owner");
+  writer.add_element("ID", "1");
+  writer.close_element("Owner");
+  writer.add_raw("<Key>");
+  writer.add_text("x>y");
+  writer.add_raw("</Key>");
+
+  EXPECT_EQ("<?xml?><Owner><ID>1</ID></Owner><Key>x&gt;y</Key>", xml);
+}